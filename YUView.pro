@@ -15,3 +15,18 @@ UNITTESTS {
   YUViewUnitTest.depends = Googletest
   YUViewUnitTest.depends = YUViewLib
 }
+
+BENCHMARKS {
+  SUBDIRS += YUViewBenchmark
+  YUViewBenchmark.subdir = YUViewBenchmark
+  YUViewBenchmark.depends = YUViewLib
+
+  !UNITTESTS {
+    SUBDIRS += Googletest
+    Googletest.subdir = submodules/googletest-qmake
+  }
+
+  SUBDIRS += YUViewMicroBenchmark
+  YUViewMicroBenchmark.subdir = YUViewMicroBenchmark
+  YUViewMicroBenchmark.depends = Googletest YUViewLib
+}
@@ -0,0 +1,35 @@
+QT += core gui widgets opengl xml concurrent network
+
+TARGET = YUViewBenchmark
+TEMPLATE = app
+
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG -= debug_and_release
+CONFIG += c++17
+
+SOURCES += $$files(src/*.cpp, false)
+HEADERS += $$files(src/*.h, false)
+
+INCLUDEPATH += $$top_srcdir/YUViewLib/src
+# The generated ui_*.h headers of the library (included by the video handlers)
+INCLUDEPATH += $$top_builddir/YUViewLib
+LIBS += -L$$top_builddir/YUViewLib -lYUViewLib
+
+win32-msvc* {
+    PRE_TARGETDEPS += $$top_builddir/YUViewLib/YUViewLib.lib
+} else {
+    PRE_TARGETDEPS += $$top_builddir/YUViewLib/libYUViewLib.a
+}
+
+win32 {
+    LIBS += -lpsapi
+    DEFINES += NOMINMAX
+}
+
+SVNN = $$system("git describe --tags")
+isEmpty(SVNN) {
+    SVNN = 0
+}
+VERSTR = '\\"$${SVNN}\\"'
+DEFINES += YUVIEW_VERSION=$${VERSTR}
@@ -0,0 +1,155 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+*   <https://github.com/IENT/YUView>
+*   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   In addition, as a special exception, the copyright holders give
+*   permission to link the code of portions of this program with the
+*   OpenSSL library under certain conditions as described in each
+*   individual source file, and distribute linked combinations including
+*   the two.
+*   
+*   You must obey the GNU General Public License in all respects for all
+*   of the code used other than OpenSSL. If you modify file(s) with this
+*   exception, you may extend this exception to your version of the
+*   file(s), but you are not obligated to do so. If you do not wish to do
+*   so, delete this exception statement from your version. If you delete
+*   this exception statement from all source files in the program, then
+*   also delete it here.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "BenchmarkReport.h"
+
+#ifdef Q_OS_WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace benchmark
+{
+
+namespace
+{
+
+double toMilliseconds(Clock::duration duration)
+{
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// The percentile of the sorted values using the nearest rank method
+Clock::duration getPercentile(const std::vector<Clock::duration> &sortedValues, double percentile)
+{
+  const auto rank  = size_t(std::ceil(percentile / 100.0 * double(sortedValues.size())));
+  const auto index = std::clamp(rank, size_t(1), sortedValues.size()) - 1;
+  return sortedValues.at(index);
+}
+
+QJsonObject createLatencyObject(const std::vector<Clock::duration> &frameLatencies)
+{
+  QJsonObject latency;
+  if (frameLatencies.empty())
+    return latency;
+
+  auto sortedLatencies = frameLatencies;
+  std::sort(sortedLatencies.begin(), sortedLatencies.end());
+
+  const auto sum =
+      std::accumulate(sortedLatencies.begin(), sortedLatencies.end(), Clock::duration::zero());
+
+  latency["min"]  = toMilliseconds(sortedLatencies.front());
+  latency["mean"] = toMilliseconds(sum) / double(sortedLatencies.size());
+  latency["p50"]  = toMilliseconds(getPercentile(sortedLatencies, 50));
+  latency["p90"]  = toMilliseconds(getPercentile(sortedLatencies, 90));
+  latency["p99"]  = toMilliseconds(getPercentile(sortedLatencies, 99));
+  latency["max"]  = toMilliseconds(sortedLatencies.back());
+  return latency;
+}
+
+} // namespace
+
+std::optional<uint64_t> getPeakResidentSetSize()
+{
+#ifdef Q_OS_WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return uint64_t(counters.PeakWorkingSetSize);
+  return {};
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return {};
+#ifdef Q_OS_MAC
+  // On macOS, the value is in bytes. On linux in kilobytes.
+  return uint64_t(usage.ru_maxrss);
+#else
+  return uint64_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+QJsonObject createReport(const Settings &settings, const Result &result, Clock::duration wallTime)
+{
+  QJsonObject report;
+  report["version"] = YUVIEW_VERSION;
+  report["stage"]   = QString::fromStdString(std::string(StageMapper.getName(settings.stage)));
+  report["file"]    = QString::fromStdString(settings.filePath.string());
+  if (settings.stage == Stage::Decode)
+  {
+    const auto decoderName = decoder::DecoderEngineMapper.getName(settings.decoderEngine);
+    report["decoder"]      = QString::fromStdString(std::string(decoderName));
+  }
+  report["requestedFrames"] = int(settings.nrFrames);
+  report["warmupFrames"]    = int(settings.nrWarmupFrames);
+  report["frames"]          = int(result.frameLatencies.size());
+
+  QJsonObject info;
+  for (const auto &[key, value] : result.info)
+    info[QString::fromStdString(key)] = QString::fromStdString(value);
+  report["info"] = info;
+
+  const auto measuredDuration = std::accumulate(
+      result.frameLatencies.begin(), result.frameLatencies.end(), Clock::duration::zero());
+  const auto measuredSeconds = std::chrono::duration<double>(measuredDuration).count();
+
+  QJsonObject throughput;
+  if (measuredSeconds > 0)
+  {
+    throughput["framesPerSecond"] = double(result.frameLatencies.size()) / measuredSeconds;
+    if (result.nrBytes > 0)
+      throughput["megabytesPerSecond"] = double(result.nrBytes) / 1e6 / measuredSeconds;
+  }
+  report["throughput"]      = throughput;
+  report["latencyMs"]       = createLatencyObject(result.frameLatencies);
+  report["bytes"]           = double(result.nrBytes);
+  report["measuredSeconds"] = measuredSeconds;
+  report["wallTimeSeconds"] = std::chrono::duration<double>(wallTime).count();
+
+  if (const auto peakRSS = getPeakResidentSetSize())
+    report["peakRSSBytes"] = double(*peakRSS);
+
+  if (!result.error.empty())
+    report["error"] = QString::fromStdString(result.error);
+
+  return report;
+}
+
+} // namespace benchmark
@@ -0,0 +1,456 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+*   <https://github.com/IENT/YUView>
+*   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   In addition, as a special exception, the copyright holders give
+*   permission to link the code of portions of this program with the
+*   OpenSSL library under certain conditions as described in each
+*   individual source file, and distribute linked combinations including
+*   the two.
+*   
+*   You must obey the GNU General Public License in all respects for all
+*   of the code used other than OpenSSL. If you modify file(s) with this
+*   exception, you may extend this exception to your version of the
+*   file(s), but you are not obligated to do so. If you do not wish to do
+*   so, delete this exception statement from your version. If you delete
+*   this exception statement from all source files in the program, then
+*   also delete it here.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "BenchmarkStages.h"
+
+#include <decoder/decoderFFmpeg.h>
+#include <decoder/decoderHM.h>
+#include <decoder/decoderLibde265.h>
+#include <decoder/decoderVTM.h>
+#include <decoder/decoderVVDec.h>
+#include <filesource/FileSource.h>
+#include <filesource/FileSourceAnnexBFile.h>
+#include <filesource/GuessFormatFromName.h>
+#include <parser/AVC/ParserAnnexBAVC.h>
+#include <parser/HEVC/ParserAnnexBHEVC.h>
+#include <parser/VVC/ParserAnnexBVVC.h>
+#include <statistics/StatisticsFileCSV.h>
+#include <statistics/StatisticsFileVTMBMS.h>
+#include <video/yuv/PixelFormatYUVGuess.h>
+#include <video/yuv/videoHandlerYUV.h>
+
+#include <QFileInfo>
+#include <QImage>
+
+#include <atomic>
+#include <stdexcept>
+
+namespace benchmark
+{
+
+namespace
+{
+
+using decoder::DecoderEngine;
+using decoder::DecoderState;
+
+// Records the time between two frames as the latency of a frame. The first nrWarmupFrames frames
+// are processed but not recorded.
+class FrameTimer
+{
+public:
+  FrameTimer(Result &result, unsigned nrWarmupFrames)
+      : result(result), nrWarmupFrames(nrWarmupFrames)
+  {
+  }
+
+  void restart() { this->lastTime = Clock::now(); }
+
+  // Record the time since the last call of restart() or frameDone() for one frame
+  void frameDone(uint64_t nrBytes)
+  {
+    const auto now = Clock::now();
+    if (this->nrFrames >= this->nrWarmupFrames)
+    {
+      this->result.frameLatencies.push_back(now - this->lastTime);
+      this->result.nrBytes += nrBytes;
+    }
+    this->nrFrames++;
+    this->lastTime = now;
+  }
+
+  unsigned getNrFrames() const { return this->nrFrames; }
+
+private:
+  Result           &result;
+  unsigned          nrWarmupFrames{};
+  unsigned          nrFrames{};
+  Clock::time_point lastTime{Clock::now()};
+};
+
+std::string getFilePathString(const Settings &settings)
+{
+  return settings.filePath.string();
+}
+
+struct RawYUVFile
+{
+  FileSource                 file;
+  Size                       frameSize;
+  video::yuv::PixelFormatYUV pixelFormat;
+  int64_t                    bytesPerFrame{};
+  int64_t                    nrFrames{};
+
+  // Read the frame. The frame index wraps around at the end of the file.
+  void readFrame(unsigned frameIndex, QByteArray &frameData)
+  {
+    const auto startPos = int64_t(frameIndex % this->nrFrames) * this->bytesPerFrame;
+    if (this->file.readBytes(frameData, startPos, this->bytesPerFrame) != this->bytesPerFrame)
+      throw std::runtime_error("Error reading frame " + std::to_string(frameIndex));
+  }
+};
+
+void openRawYUVFile(const Settings &settings, RawYUVFile &rawFile, Result &result)
+{
+  if (!rawFile.file.openFile(settings.filePath))
+    throw std::runtime_error("Error opening file " + getFilePathString(settings));
+
+  const auto fileInfo = QFileInfo(QString::fromStdString(settings.filePath.string()));
+  const auto fileSize = rawFile.file.getFileSize().value_or(0);
+
+  // The same guessing that is done when a raw file is opened in YUView
+  const auto formatFromName = guessFormatFromFilename(fileInfo);
+  rawFile.frameSize = settings.frameSize.isValid() ? settings.frameSize : formatFromName.frameSize;
+  if (settings.pixelFormat)
+    rawFile.pixelFormat = *settings.pixelFormat;
+  else
+    rawFile.pixelFormat = video::yuv::guessFormatFromSizeAndName(
+        rawFile.frameSize,
+        formatFromName.bitDepth,
+        formatFromName.packed ? video::DataLayout::Packed : video::DataLayout::Planar,
+        fileSize,
+        fileInfo);
+
+  if (!rawFile.frameSize.isValid() || !rawFile.pixelFormat.isValid())
+    throw std::runtime_error("The format of the raw file could not be guessed from the file name. "
+                             "Please specify it with --size and --format.");
+
+  rawFile.bytesPerFrame = rawFile.pixelFormat.bytesPerFrame(rawFile.frameSize);
+  rawFile.nrFrames      = rawFile.bytesPerFrame > 0 ? fileSize / rawFile.bytesPerFrame : 0;
+  if (rawFile.nrFrames == 0)
+    throw std::runtime_error("The file does not contain a single frame in the given format");
+
+  result.info.push_back({"frameSize",
+                         std::to_string(rawFile.frameSize.width) + "x" +
+                             std::to_string(rawFile.frameSize.height)});
+  result.info.push_back({"pixelFormat", rawFile.pixelFormat.getName()});
+  result.info.push_back({"framesInFile", std::to_string(rawFile.nrFrames)});
+}
+
+Result runRawRead(const Settings &settings)
+{
+  Result     result;
+  RawYUVFile rawFile;
+  openRawYUVFile(settings, rawFile, result);
+
+  QByteArray frameData;
+  FrameTimer timer(result, settings.nrWarmupFrames);
+  for (unsigned frameIndex = 0; frameIndex < settings.nrWarmupFrames + settings.nrFrames;
+       frameIndex++)
+  {
+    timer.restart();
+    rawFile.readFrame(frameIndex, frameData);
+    timer.frameDone(uint64_t(frameData.size()));
+  }
+  return result;
+}
+
+Result runConvertYUV(const Settings &settings)
+{
+  Result     result;
+  RawYUVFile rawFile;
+  openRawYUVFile(settings, rawFile, result);
+
+  std::string whyNot;
+  if (!rawFile.pixelFormat.canConvertToRGB(rawFile.frameSize, &whyNot))
+    throw std::runtime_error("The format can not be converted to RGB: " + whyNot);
+
+  // The default conversion settings of the videoHandlerYUV
+  using video::yuv::Component;
+  using video::yuv::MathParameters;
+  video::yuv::ConversionSettings conversionSettings;
+  conversionSettings.mathParameters[Component::Luma]   = MathParameters(1, 125, false);
+  conversionSettings.mathParameters[Component::Chroma] = MathParameters(1, 128, false);
+
+  // Like the interactive loading path, the conversion of a frame is split over all cores
+  QByteArray frameData;
+  QImage     image;
+  FrameTimer timer(result, settings.nrWarmupFrames);
+  for (unsigned frameIndex = 0; frameIndex < settings.nrWarmupFrames + settings.nrFrames;
+       frameIndex++)
+  {
+    rawFile.readFrame(frameIndex, frameData);
+    timer.restart();
+    video::yuv::convertYUVToImage(
+        frameData, image, rawFile.pixelFormat, rawFile.frameSize, conversionSettings, true);
+    timer.frameDone(uint64_t(frameData.size()));
+  }
+  return result;
+}
+
+InputFormat getAnnexBFormatFromExtension(const Settings &settings)
+{
+  const auto ext = QFileInfo(QString::fromStdString(settings.filePath.string())).suffix();
+  if (ext == "hevc" || ext == "h265" || ext == "265")
+    return InputFormat::AnnexBHEVC;
+  if (ext == "vvc" || ext == "h266" || ext == "266")
+    return InputFormat::AnnexBVVC;
+  if (ext == "avc" || ext == "h264" || ext == "264")
+    return InputFormat::AnnexBAVC;
+  throw std::runtime_error("Only raw AnnexB files (hevc/h265/265, vvc/h266/266, avc/h264/264) are "
+                           "supported");
+}
+
+std::unique_ptr<parser::ParserAnnexB> createAnnexBParser(const Settings   &settings,
+                                                         const InputFormat inputFormat)
+{
+  std::unique_ptr<parser::ParserAnnexB> parser;
+  if (inputFormat == InputFormat::AnnexBHEVC)
+    parser = std::make_unique<parser::ParserAnnexBHEVC>();
+  else if (inputFormat == InputFormat::AnnexBVVC)
+    parser = std::make_unique<parser::ParserAnnexBVVC>();
+  else
+    parser = std::make_unique<parser::ParserAnnexBAVC>();
+  parser->setUseIndexCache(settings.useIndexCache);
+  return parser;
+}
+
+std::unique_ptr<decoder::decoderBase> createDecoder(const Settings       &settings,
+                                                    const InputFormat     inputFormat,
+                                                    parser::ParserAnnexB *parser)
+{
+  const auto engine = settings.decoderEngine;
+  if ((inputFormat == InputFormat::AnnexBHEVC && !vectorContains(decoder::DecodersHEVC, engine)) ||
+      (inputFormat == InputFormat::AnnexBVVC && !vectorContains(decoder::DecodersVVC, engine)) ||
+      (inputFormat == InputFormat::AnnexBAVC && engine != DecoderEngine::FFMpeg))
+    throw std::runtime_error("The decoder " +
+                             std::string(decoder::DecoderEngineMapper.getName(engine)) +
+                             " can not decode " +
+                             std::string(InputFormatMapper.getName(inputFormat)));
+
+  if (engine == DecoderEngine::Libde265)
+    return std::make_unique<decoder::decoderLibde265>(0);
+  if (engine == DecoderEngine::HM)
+    return std::make_unique<decoder::decoderHM>(0);
+  if (engine == DecoderEngine::VTM)
+    return std::make_unique<decoder::decoderVTM>(0);
+  if (engine == DecoderEngine::VVDec)
+    return std::make_unique<decoder::decoderVVDec>(0);
+
+  // FFmpeg is fed with whole frames from the index of the parser
+  FFmpeg::AVCodecIDWrapper codec;
+  if (inputFormat == InputFormat::AnnexBHEVC)
+    codec.setTypeHEVC();
+  else
+    codec.setTypeAVC();
+
+  auto lock = parser->lockIndex();
+  return std::make_unique<decoder::decoderFFmpeg>(codec,
+                                                  parser->getSequenceSizeSamples(),
+                                                  parser->getExtradata(),
+                                                  parser->getPixelFormat(),
+                                                  parser->getProfileLevel(),
+                                                  parser->getSampleAspectRatio());
+}
+
+Result runDecode(const Settings &settings)
+{
+  const auto inputFormat = getAnnexBFormatFromExtension(settings);
+
+  FileSourceAnnexBFile file(settings.filePath);
+  if (!file.isOk())
+    throw std::runtime_error("Error opening file " + getFilePathString(settings));
+
+  // Only the FFmpeg decoder needs the index. Indexing is not part of the measurement.
+  std::unique_ptr<parser::ParserAnnexB> parser;
+  if (settings.decoderEngine == DecoderEngine::FFMpeg)
+  {
+    parser = createAnnexBParser(settings, inputFormat);
+    FileSourceAnnexBFile indexingFile(settings.filePath);
+    std::atomic_bool     breakIndexing{false};
+    parser->indexAnnexBFile(indexingFile, breakIndexing);
+  }
+
+  auto dec = createDecoder(settings, inputFormat, parser.get());
+  if (dec->errorInDecoder())
+    throw std::runtime_error("Error creating the decoder: " +
+                             dec->decoderErrorString().toStdString());
+
+  Result result;
+  result.info.push_back({"decoder", dec->getDecoderName().toStdString()});
+
+  // The latency of a frame is the time from the previous frame until the decoder returned the
+  // frame. This includes pushing the data which is required for the frame.
+  FrameTimer                    timer(result, settings.nrWarmupFrames);
+  bool                          repushData              = false;
+  parser::FrameIndexCodingOrder frameCounterCodingOrder = 0;
+  const auto                    nrFramesToDecode = settings.nrWarmupFrames + settings.nrFrames;
+  timer.restart();
+  while (timer.getNrFrames() < nrFramesToDecode)
+  {
+    while (dec->state() == DecoderState::NeedsMoreData)
+    {
+      if (parser)
+      {
+        QByteArray data;
+        if (frameCounterCodingOrder < parser->getNumberPOCs())
+        {
+          if (auto frameStartEndFilePos = parser->getFrameStartEndPos(frameCounterCodingOrder))
+            data = file.getFrameData(*frameStartEndFilePos);
+        }
+        if (dec->pushData(data))
+          frameCounterCodingOrder++;
+        else if (dec->state() != DecoderState::RetrieveFrames)
+          break;
+      }
+      else
+      {
+        auto data  = file.getNextNALUnit(repushData);
+        repushData = !dec->pushData(data);
+      }
+    }
+
+    if (dec->state() == DecoderState::RetrieveFrames && dec->decodeNextFrame())
+    {
+      const auto frameData = dec->getRawFrameData();
+      timer.frameDone(uint64_t(frameData.size()));
+    }
+
+    if (dec->state() != DecoderState::NeedsMoreData &&
+        dec->state() != DecoderState::RetrieveFrames)
+      break;
+  }
+
+  if (dec->errorInDecoder())
+    result.error = dec->decoderErrorString().toStdString();
+
+  const auto frameSize = dec->getFrameSize();
+  result.info.push_back(
+      {"frameSize", std::to_string(frameSize.width) + "x" + std::to_string(frameSize.height)});
+  if (dec->getRawFormat() == video::RawFormat::YUV)
+    result.info.push_back({"pixelFormat", dec->getPixelFormatYUV().getName()});
+  return result;
+}
+
+Result runParseAnnexB(const Settings &settings)
+{
+  const auto inputFormat = getAnnexBFormatFromExtension(settings);
+
+  FileSourceAnnexBFile file(settings.filePath);
+  if (!file.isOk())
+    throw std::runtime_error("Error opening file " + getFilePathString(settings));
+
+  auto parser = createAnnexBParser(settings, inputFormat);
+
+  // Indexing can be continued. So we index one more frame with every call.
+  Result           result;
+  std::atomic_bool breakIndexing{false};
+  FrameTimer       timer(result, settings.nrWarmupFrames);
+  const auto       nrFramesToParse = settings.nrWarmupFrames + settings.nrFrames;
+  while (timer.getNrFrames() < nrFramesToParse)
+  {
+    timer.restart();
+    const auto endOfFile = parser->indexAnnexBFile(file, breakIndexing, timer.getNrFrames() + 1);
+    if (parser->getNumberPOCs() <= timer.getNrFrames())
+      break;
+    timer.frameDone(0);
+    if (endOfFile)
+      break;
+  }
+
+  // The file is read in big blocks. So the number of parsed bytes is taken from the index.
+  for (auto frameIndex = settings.nrWarmupFrames; frameIndex < timer.getNrFrames(); frameIndex++)
+  {
+    if (const auto startEndPos = parser->getFrameStartEndPos(frameIndex))
+      result.nrBytes += startEndPos->second - startEndPos->first;
+  }
+
+  const auto frameSize = parser->getSequenceSizeSamples();
+  result.info.push_back(
+      {"frameSize", std::to_string(frameSize.width) + "x" + std::to_string(frameSize.height)});
+  result.info.push_back({"pixelFormat", parser->getPixelFormat().getName()});
+  return result;
+}
+
+Result runLoadStatistics(const Settings &settings)
+{
+  const auto fileName = QString::fromStdString(settings.filePath.string());
+  const auto suffix   = QFileInfo(fileName).suffix();
+
+  stats::StatisticsData                      statisticsData;
+  std::unique_ptr<stats::StatisticsFileBase> file;
+  if (suffix == "csv")
+    file = std::make_unique<stats::StatisticsFileCSV>(fileName, statisticsData);
+  else if (suffix == "vtmbmsstats")
+    file = std::make_unique<stats::StatisticsFileVTMBMS>(fileName, statisticsData);
+  else
+    throw std::runtime_error("Only statistics files (csv, vtmbmsstats) are supported");
+  if (!*file)
+    throw std::runtime_error("Error opening statistics file " + getFilePathString(settings));
+
+  // Indexing the file is not part of the measurement
+  std::atomic_bool breakIndexing{false};
+  file->readFrameAndTypePositionsFromFile(breakIndexing);
+
+  // Load all types and not only the ones that are rendered by default
+  for (auto &statsType : statisticsData.getStatisticsTypes())
+    statsType.render = true;
+
+  Result result;
+  result.info.push_back({"nrTypes", std::to_string(statisticsData.getStatisticsTypes().size())});
+  result.info.push_back({"maxPOC", std::to_string(file->getMaxPoc())});
+
+  FrameTimer timer(result, settings.nrWarmupFrames);
+  const auto nrFramesToLoad = settings.nrWarmupFrames + settings.nrFrames;
+  for (int poc = 0; poc <= file->getMaxPoc() && timer.getNrFrames() < nrFramesToLoad; poc++)
+  {
+    timer.restart();
+    statisticsData.setFrameIndex(poc);
+    for (const auto typeID : statisticsData.getTypesThatNeedLoading(poc))
+      file->loadStatisticData(statisticsData, poc, typeID);
+    timer.frameDone(0);
+  }
+  return result;
+}
+
+} // namespace
+
+Result runStage(const Settings &settings)
+{
+  switch (settings.stage)
+  {
+  case Stage::RawRead:
+    return runRawRead(settings);
+  case Stage::Decode:
+    return runDecode(settings);
+  case Stage::ConvertYUV:
+    return runConvertYUV(settings);
+  case Stage::ParseAnnexB:
+    return runParseAnnexB(settings);
+  case Stage::LoadStatistics:
+    return runLoadStatistics(settings);
+  }
+  throw std::runtime_error("Unknown stage");
+}
+
+} // namespace benchmark
@@ -0,0 +1,98 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+*   <https://github.com/IENT/YUView>
+*   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   In addition, as a special exception, the copyright holders give
+*   permission to link the code of portions of this program with the
+*   OpenSSL library under certain conditions as described in each
+*   individual source file, and distribute linked combinations including
+*   the two.
+*   
+*   You must obey the GNU General Public License in all respects for all
+*   of the code used other than OpenSSL. If you modify file(s) with this
+*   exception, you may extend this exception to your version of the
+*   file(s), but you are not obligated to do so. If you do not wish to do
+*   so, delete this exception statement from your version. If you delete
+*   this exception statement from all source files in the program, then
+*   also delete it here.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <common/EnumMapper.h>
+#include <common/Typedef.h>
+#include <decoder/decoderBase.h>
+#include <video/yuv/PixelFormatYUV.h>
+
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace benchmark
+{
+
+// The stages of the processing pipeline that can be measured
+enum class Stage
+{
+  RawRead,       // Read raw YUV frames from a file
+  Decode,        // Decode an AnnexB bitstream (HEVC, VVC or AVC) with a decoder engine
+  ConvertYUV,    // Convert raw YUV frames to RGB (the conversion only, the file is read untimed)
+  ParseAnnexB,   // Index an AnnexB bitstream (parameter sets and slice headers) frame by frame
+  LoadStatistics // Load all statistics types of a statistics file (CSV or VTM BMS) frame by frame
+};
+
+constexpr EnumMapper<Stage, 5> StageMapper(std::make_pair(Stage::RawRead, "read"sv),
+                                           std::make_pair(Stage::Decode, "decode"sv),
+                                           std::make_pair(Stage::ConvertYUV, "convert"sv),
+                                           std::make_pair(Stage::ParseAnnexB, "parse"sv),
+                                           std::make_pair(Stage::LoadStatistics, "stats"sv));
+
+struct Settings
+{
+  std::filesystem::path  filePath;
+  Stage                  stage{Stage::RawRead};
+  unsigned               nrFrames{100};
+  unsigned               nrWarmupFrames{};
+  decoder::DecoderEngine decoderEngine{decoder::DecoderEngine::Libde265};
+  // For raw YUV files. If not set, the format is guessed from the file name.
+  Size                                      frameSize{};
+  std::optional<video::yuv::PixelFormatYUV> pixelFormat;
+  // If not set, the file index cache is bypassed so that a stage never measures a cached index.
+  bool useIndexCache{};
+};
+
+using Clock = std::chrono::steady_clock;
+
+// The measurement of one stage. Every measured frame adds one latency value. Stages that can not
+// provide the requested number of frames (e.g. because the bitstream ends) stop early.
+struct Result
+{
+  std::vector<Clock::duration> frameLatencies;
+  uint64_t                     nrBytes{};
+  // Stage specific information like the detected format or the decoder name
+  std::vector<std::pair<std::string, std::string>> info;
+  // Set if the stage stopped because of an error after it started measuring
+  std::string error;
+};
+
+// Run the stage for the configured number of frames. Throws std::runtime_error if the stage can not
+// be run with the given settings (e.g. the file can not be opened or the format is unknown).
+Result runStage(const Settings &settings);
+
+} // namespace benchmark
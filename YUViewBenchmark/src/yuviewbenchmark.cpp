@@ -0,0 +1,189 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+*   <https://github.com/IENT/YUView>
+*   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   In addition, as a special exception, the copyright holders give
+*   permission to link the code of portions of this program with the
+*   OpenSSL library under certain conditions as described in each
+*   individual source file, and distribute linked combinations including
+*   the two.
+*   
+*   You must obey the GNU General Public License in all respects for all
+*   of the code used other than OpenSSL. If you modify file(s) with this
+*   exception, you may extend this exception to your version of the
+*   file(s), but you are not obligated to do so. If you do not wish to do
+*   so, delete this exception statement from your version. If you delete
+*   this exception statement from all source files in the program, then
+*   also delete it here.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "BenchmarkReport.h"
+#include "BenchmarkStages.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonDocument>
+
+#include <iostream>
+
+namespace
+{
+
+template <typename T, std::size_t N> QString getNamesList(const EnumMapper<T, N> &mapper)
+{
+  QStringList names;
+  for (const auto name : mapper.getNames())
+    names.append(QString::fromStdString(std::string(name)));
+  return names.join(", ");
+}
+
+std::optional<Size> parseSize(const QString &sizeString)
+{
+  const auto values = sizeString.split('x');
+  if (values.size() != 2)
+    return {};
+  bool       okWidth{}, okHeight{};
+  const auto width  = values[0].toUInt(&okWidth);
+  const auto height = values[1].toUInt(&okHeight);
+  if (!okWidth || !okHeight)
+    return {};
+  return Size(width, height);
+}
+
+int exitWithError(const QString &error)
+{
+  std::cerr << error.toStdString() << "\n";
+  return 1;
+}
+
+} // namespace
+
+// A headless benchmark that runs one stage of the processing pipeline (reading, decoding,
+// conversion, parsing or loading of statistics) for a number of frames and writes the throughput,
+// latencies and the peak memory usage as JSON. No display is required.
+int main(int argc, char *argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  // Use the settings of YUView (e.g. the paths to the decoder libraries)
+  QCoreApplication::setApplicationName("YUView");
+  QCoreApplication::setOrganizationName("Institut für Nachrichtentechnik, RWTH Aachen University");
+  QCoreApplication::setOrganizationDomain("ient.rwth-aachen.de");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Measure the performance of a processing stage of YUView.");
+  parser.addHelpOption();
+  parser.addPositionalArgument("file", "The input file");
+  const QCommandLineOption stageOption(
+      "stage", "The stage to measure (" + getNamesList(benchmark::StageMapper) + ").", "stage");
+  const QCommandLineOption framesOption(
+      "frames", "The number of frames to measure (default 100).", "frames", "100");
+  const QCommandLineOption warmupOption(
+      "warmup", "The number of frames to process before measuring (default 0).", "frames", "0");
+  const QCommandLineOption decoderOption(
+      "decoder",
+      "The decoder for the decode stage (" + getNamesList(decoder::DecoderEngineMapper) + ").",
+      "decoder",
+      "Libde265");
+  const QCommandLineOption sizeOption(
+      "size", "The frame size of a raw file (e.g. 1920x1080).", "size");
+  const QCommandLineOption formatOption(
+      "format",
+      "The YUV pixel format of a raw file (e.g. \"YUV 4:2:0 8-bit\").",
+      "format");
+  const QCommandLineOption indexCacheOption(
+      "use-index-cache", "Use the file index cache instead of always indexing files.");
+  const QCommandLineOption outputOption(
+      "output", "Write the JSON report to this file instead of stdout.", "file");
+  parser.addOptions({stageOption,
+                     framesOption,
+                     warmupOption,
+                     decoderOption,
+                     sizeOption,
+                     formatOption,
+                     indexCacheOption,
+                     outputOption});
+  parser.process(app);
+
+  const auto positionalArguments = parser.positionalArguments();
+  if (positionalArguments.size() != 1)
+    return exitWithError("Please specify exactly one input file.");
+
+  benchmark::Settings settings;
+  settings.filePath = std::filesystem::path(positionalArguments[0].toStdString());
+
+  const auto stage = benchmark::StageMapper.getValueCaseInsensitive(
+      parser.value(stageOption).toStdString());
+  if (!stage)
+    return exitWithError("Please specify a stage (" + getNamesList(benchmark::StageMapper) + ").");
+  settings.stage = *stage;
+
+  bool ok{};
+  settings.nrFrames = parser.value(framesOption).toUInt(&ok);
+  if (!ok || settings.nrFrames == 0)
+    return exitWithError("Invalid number of frames.");
+  settings.nrWarmupFrames = parser.value(warmupOption).toUInt(&ok);
+  if (!ok)
+    return exitWithError("Invalid number of warmup frames.");
+
+  const auto decoderEngine = decoder::DecoderEngineMapper.getValueCaseInsensitive(
+      parser.value(decoderOption).toStdString());
+  if (!decoderEngine || *decoderEngine == decoder::DecoderEngine::Invalid)
+    return exitWithError("Unknown decoder " + parser.value(decoderOption));
+  settings.decoderEngine = *decoderEngine;
+
+  if (parser.isSet(sizeOption))
+  {
+    const auto frameSize = parseSize(parser.value(sizeOption));
+    if (!frameSize)
+      return exitWithError("Invalid frame size " + parser.value(sizeOption));
+    settings.frameSize = *frameSize;
+  }
+  if (parser.isSet(formatOption))
+  {
+    const auto pixelFormat = video::yuv::PixelFormatYUV(parser.value(formatOption).toStdString());
+    if (!pixelFormat.isValid())
+      return exitWithError("Invalid pixel format " + parser.value(formatOption));
+    settings.pixelFormat = pixelFormat;
+  }
+  settings.useIndexCache = parser.isSet(indexCacheOption);
+
+  QJsonObject report;
+  try
+  {
+    const auto start  = benchmark::Clock::now();
+    const auto result = benchmark::runStage(settings);
+    report = benchmark::createReport(settings, result, benchmark::Clock::now() - start);
+  }
+  catch (const std::exception &e)
+  {
+    return exitWithError(QString("Error running the benchmark: ") + e.what());
+  }
+
+  const auto json = QJsonDocument(report).toJson();
+  if (parser.isSet(outputOption))
+  {
+    QFile outputFile(parser.value(outputOption));
+    if (!outputFile.open(QIODevice::WriteOnly) || outputFile.write(json) != json.size())
+      return exitWithError("Error writing the report to " + parser.value(outputOption));
+  }
+  else
+    std::cout << json.toStdString();
+
+  return report.contains("error") ? 1 : 0;
+}
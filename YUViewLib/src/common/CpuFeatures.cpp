@@ -0,0 +1,99 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CpuFeatures.h"
+
+#include <algorithm>
+#include <atomic>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace functions
+{
+
+namespace
+{
+
+std::atomic<InstructionSet> maxInstructionSet{InstructionSet::AVX2};
+
+InstructionSet detectInstructionSet()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return InstructionSet::AVX2;
+  if (__builtin_cpu_supports("sse4.1"))
+    return InstructionSet::SSE4_1;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  int info[4];
+  __cpuid(info, 0);
+  const auto maxLeaf = info[0];
+  if (maxLeaf < 1)
+    return InstructionSet::Scalar;
+
+  __cpuid(info, 1);
+  const bool sse41   = (info[2] & (1 << 19)) != 0;
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const bool avx     = (info[2] & (1 << 28)) != 0;
+
+  if (maxLeaf >= 7 && osxsave && avx)
+  {
+    // The OS must save the YMM registers on a context switch
+    const auto xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    const bool avx2 = (info[1] & (1 << 5)) != 0;
+    if (avx2 && (xcr0 & 0x6) == 0x6)
+      return InstructionSet::AVX2;
+  }
+  if (sse41)
+    return InstructionSet::SSE4_1;
+#endif
+  return InstructionSet::Scalar;
+}
+
+} // namespace
+
+InstructionSet getSupportedInstructionSet()
+{
+  static const auto instructionSet = detectInstructionSet();
+  return std::min(instructionSet, maxInstructionSet.load(std::memory_order_relaxed));
+}
+
+void setMaxInstructionSet(InstructionSet instructionSet)
+{
+  maxInstructionSet.store(instructionSet, std::memory_order_relaxed);
+}
+
+} // namespace functions
@@ -0,0 +1,62 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/EnumMapper.h>
+
+namespace functions
+{
+
+// The vector instruction sets that YUView has specialized kernels for. The order matters: a higher
+// value implies support for all lower ones.
+enum class InstructionSet
+{
+  Scalar,
+  SSE4_1,
+  AVX2
+};
+
+constexpr EnumMapper<InstructionSet, 3>
+    InstructionSetMapper(std::make_pair(InstructionSet::Scalar, "Scalar"sv),
+                         std::make_pair(InstructionSet::SSE4_1, "SSE4.1"sv),
+                         std::make_pair(InstructionSet::AVX2, "AVX2"sv));
+
+// Detect the best instruction set that is supported by the CPU (and the OS) we are running on. The
+// detection is only performed once. This function is thread safe and inexpensive to call.
+InstructionSet getSupportedInstructionSet();
+
+// Do not use instruction sets above the given one, even if the CPU supports them. This is used to
+// compare the vectorized code paths with the scalar ones. By default, there is no limit.
+void setMaxInstructionSet(InstructionSet instructionSet);
+
+} // namespace functions
@@ -45,7 +45,9 @@
 #include <charconv>
 #include <string_view>
 
+#include <QFile>
 #include <QThread>
+#include <QThreadPool>
 
 namespace functions
 {
@@ -59,6 +61,16 @@ unsigned int getOptimalThreadCount()
     return 1;
 }
 
+QThreadPool *getSharedThreadPool()
+{
+  static QThreadPool *threadPool = []() {
+    auto pool = new QThreadPool();
+    pool->setMaxThreadCount(int(getOptimalThreadCount()));
+    return pool;
+  }();
+  return threadPool;
+}
+
 unsigned int systemMemorySizeInMB()
 {
   static unsigned int memorySizeInMB;
@@ -163,6 +175,24 @@ QStringList toQStringList(const std::vector<std::string> &stringVec)
   return list;
 }
 
+std::filesystem::path toFilesystemPath(const QString &path)
+{
+#ifdef Q_OS_WIN32
+  return std::filesystem::path(path.toStdWString());
+#else
+  return std::filesystem::path(QFile::encodeName(path).toStdString());
+#endif
+}
+
+QString toQString(const std::filesystem::path &path)
+{
+#ifdef Q_OS_WIN32
+  return QString::fromStdWString(path.wstring());
+#else
+  return QFile::decodeName(path.c_str());
+#endif
+}
+
 std::string toLower(const std::string_view str)
 {
   std::string lowercaseStr(str);
@@ -34,9 +34,12 @@
 
 #include <common/Typedef.h>
 
+#include <filesystem>
 #include <istream>
 #include <optional>
 
+class QThreadPool;
+
 namespace functions
 {
 
@@ -44,6 +47,11 @@ namespace functions
 // so that one thread is "reserved" for the main GUI. I don't know if this is optimal.
 unsigned int getOptimalThreadCount();
 
+// A thread pool that is shared by all tasks which split up one job (e.g. the conversion of one
+// frame) to run on multiple cores. It has getOptimalThreadCount() threads. Only use it for short
+// tasks that do not block.
+QThreadPool *getSharedThreadPool();
+
 // Returns the size of system memory in megabytes.
 // This function is thread safe and inexpensive to call.
 unsigned int systemMemorySizeInMB();
@@ -65,6 +73,11 @@ QString formatDataSize(double size, bool isBits = false);
 
 QStringList toQStringList(const std::vector<std::string> &stringVec);
 
+// Convert between QString and std::filesystem::path without losing non-ASCII characters. On
+// Windows, a path that is constructed from a std::string is not interpreted as UTF-8.
+std::filesystem::path toFilesystemPath(const QString &path);
+QString               toQString(const std::filesystem::path &path);
+
 template <size_t N>
 QStringList toQStringList(const std::array<std::string_view, N> &stringArray)
 {
@@ -116,6 +116,11 @@ public:
   video::yuv::PixelFormatYUV getPixelFormatYUV() const { return this->formatYUV; }
   video::rgb::PixelFormatRGB getRGBPixelFormat() const { return this->formatRGB; }
   Size                       getFrameSize() const { return this->frameSize; }
+  // Get the current frame as a view onto the picture buffers of the decoder. This avoids copying
+  // the frame into one array like getRawFrameData does. The default implementation returns an
+  // empty view. Then (or if the decoder can not provide a view for the current frame) use
+  // getRawFrameData.
+  virtual video::RawFrameView getRawFrameView() { return {}; }
   // Push data to the decoder (until no more data is needed)
   // In order to make the interface generic, the pushData function accepts data only without start
   // codes
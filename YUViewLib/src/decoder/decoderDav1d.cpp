@@ -37,6 +37,7 @@
 #include <QSettings>
 #include <cassert>
 #include <cstring>
+#include <memory>
 
 #include <common/Functions.h>
 #include <common/Typedef.h>
@@ -134,6 +135,7 @@ decoderDav1d::decoderDav1d(int signalID, bool cachingDecoder) : decoderBaseSingl
 
 decoderDav1d::~decoderDav1d()
 {
+  this->releaseCurrentPicture();
   if (decoder != nullptr)
   {
     // Free the decoder
@@ -149,6 +151,7 @@ void decoderDav1d::resetDecoder()
   if (!decoder)
     return setError("Resetting the decoder failed. No decoder allocated.");
 
+  this->releaseCurrentPicture();
   this->lib.dav1d_close(&decoder);
   if (decoder != nullptr)
     DEBUG_DAV1D(
@@ -200,6 +203,8 @@ void decoderDav1d::resolveLibraryFunctionPointers()
     return;
   if (!resolve(this->lib.dav1d_flush, "dav1d_flush"))
     return;
+  // Without this, the pictures can not be released and are not provided as a view.
+  resolve(this->lib.dav1d_picture_unref, "dav1d_picture_unref", true);
 
   if (!resolve(this->lib.dav1d_data_create, "dav1d_data_create"))
     return;
@@ -309,7 +314,7 @@ bool decoderDav1d::decodeFrame()
   if (decoder == nullptr)
     return false;
 
-  curPicture.clear();
+  this->releaseCurrentPicture();
 
   int res = this->lib.dav1d_get_picture(decoder, curPicture.getPicture());
   if (res >= 0)
@@ -385,6 +390,64 @@ QByteArray decoderDav1d::getRawFrameData()
   return currentOutputBuffer;
 }
 
+video::RawFrameView decoderDav1d::getRawFrameView()
+{
+  // The statistics are retrieved when the frame is copied (getRawFrameData). Prediction and
+  // pre-filter data are only valid while the decoder works on the picture.
+  if (decoderState != DecoderState::RetrieveFrames || this->decodeSignal != 0 ||
+      this->statisticsEnabled() || this->lib.dav1d_picture_unref == nullptr)
+    return {};
+
+  const auto size = curPicture.getFrameSize();
+  if (!size.isValid() || curPicture.getData(0) == nullptr)
+    return {};
+
+  if (this->currentFrameView.isEmpty())
+  {
+    // Same layout as in copyImgToByteArray
+    const auto   layout           = curPicture.getSubsampling();
+    const auto   nrPlanes         = (layout == Subsampling::YUV_400) ? 1 : 3;
+    const size_t nrBytesPerSample = (curPicture.getBitDepth() > 8) ? 2 : 1;
+
+    std::vector<video::RawFrameView::Plane> planes;
+    for (int c = 0; c < nrPlanes; c++)
+    {
+      auto width  = size.width;
+      auto height = size.height;
+      if (c != 0)
+      {
+        if (layout == Subsampling::YUV_420 || layout == Subsampling::YUV_422)
+          width /= 2;
+        if (layout == Subsampling::YUV_420)
+          height /= 2;
+      }
+      const auto stride = (c == 0) ? curPicture.getStride(0) : curPicture.getStride(1);
+      planes.push_back({curPicture.getData(c), size_t(stride), width * nrBytesPerSample, height});
+    }
+
+    // The view takes over our reference to the picture
+    auto unref   = this->lib.dav1d_picture_unref;
+    auto picture = std::shared_ptr<Dav1dPicture>(new Dav1dPicture(*curPicture.getPicture()),
+                                                 [unref](Dav1dPicture *p) {
+                                                   unref(p);
+                                                   delete p;
+                                                 });
+    this->currentFrameView = video::RawFrameView(planes, picture);
+    DEBUG_DAV1D("decoderDav1d::getRawFrameView handed picture over to a view");
+  }
+
+  return this->currentFrameView;
+}
+
+void decoderDav1d::releaseCurrentPicture()
+{
+  if (!this->currentFrameView.isEmpty())
+    this->currentFrameView = {};
+  else if (this->lib.dav1d_picture_unref != nullptr && curPicture.getData(0) != nullptr)
+    this->lib.dav1d_picture_unref(curPicture.getPicture());
+  curPicture.clear();
+}
+
 bool decoderDav1d::pushData(QByteArray &data)
 {
   if (decoderState != DecoderState::NeedsMoreData)
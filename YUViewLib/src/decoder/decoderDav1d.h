@@ -53,6 +53,7 @@ struct LibraryFunctionsDav1d
   int (*dav1d_get_picture)(Dav1dContext *, Dav1dPicture *){};
   void (*dav1d_close)(Dav1dContext **){};
   void (*dav1d_flush)(Dav1dContext *){};
+  void (*dav1d_picture_unref)(Dav1dPicture *){};
 
   uint8_t *(*dav1d_data_create)(Dav1dData *data, size_t sz){};
 
@@ -92,7 +93,7 @@ public:
   Dav1dFrameHeader *   getFrameHeader() const { return curPicture.frame_hdr; }
 
 private:
-  Dav1dPicture curPicture;
+  Dav1dPicture curPicture{};
   bool         internalsSupported{false};
 };
 
@@ -122,9 +123,10 @@ public:
   void        setDecodeSignal(int signalID, bool &decoderResetNeeded) override;
 
   // Decoding / pushing data
-  bool       decodeNextFrame() override;
-  QByteArray getRawFrameData() override;
-  bool       pushData(QByteArray &data) override;
+  bool                decodeNextFrame() override;
+  QByteArray          getRawFrameData() override;
+  video::RawFrameView getRawFrameView() override;
+  bool                pushData(QByteArray &data) override;
 
   // Check if the given library file is an existing libde265 decoder that we can use.
   static bool checkLibraryFile(QString libFilePath, QString &error);
@@ -168,6 +170,12 @@ private:
 
   Dav1dPictureWrapper curPicture;
 
+  // Release the reference to curPicture unless it was handed over to currentFrameView.
+  void releaseCurrentPicture();
+
+  // If a view onto curPicture was requested, the view owns the reference to the picture.
+  video::RawFrameView currentFrameView;
+
   // We buffer the current image as a QByteArray so you can call getYUVFrameData as often as
   // necessary without invoking the copy operation from the libde265 buffer to the QByteArray again.
 #if SSE_CONVERSION
@@ -123,7 +123,8 @@ decoderFFmpeg::decoderFFmpeg(FFmpeg::AVCodecParametersWrapper codecpar, bool cac
 
 decoderFFmpeg::~decoderFFmpeg()
 {
-  if (this->frame)
+  // A frame that is in a view is freed with the last copy of the view
+  if (this->frame && this->currentFrameView.isEmpty())
     this->ff.freeFrame(this->frame);
   if (this->raw_pkt)
     this->ff.freePacket(this->raw_pkt);
@@ -175,6 +176,42 @@ QByteArray decoderFFmpeg::getRawFrameData()
   return this->currentOutputBuffer;
 }
 
+video::RawFrameView decoderFFmpeg::getRawFrameView()
+{
+  // The statistics are retrieved when the frame is copied (getRawFrameData). Only planar YUV
+  // frames are provided as a view.
+  if (this->decoderState != DecoderState::RetrieveFrames || !this->frame ||
+      this->rawFormat != video::RawFormat::YUV || this->statisticsEnabled() ||
+      !this->getPixelFormatYUV().isPlanar() || this->getPixelFormatYUV().isUVInterleaved())
+    return {};
+
+  if (this->currentFrameView.isEmpty())
+  {
+    // Same layout as in copyCurImageToBuffer
+    const auto pixFmt           = this->getPixelFormatYUV();
+    const auto nrBytesPerSample = pixFmt.getBitsPerSample() <= 8 ? 1u : 2u;
+
+    std::vector<video::RawFrameView::Plane> planes;
+    for (unsigned plane = 0; plane < pixFmt.getNrPlanes(); plane++)
+    {
+      const auto component =
+          (plane == 0) ? video::yuv::Component::Luma : video::yuv::Component::Chroma;
+      const auto widthInBytes =
+          this->frameSize.width / pixFmt.getSubsamplingHor(component) * nrBytesPerSample;
+      const auto height = this->frameSize.height / pixFmt.getSubsamplingVer(component);
+      planes.push_back({this->frame.getData(plane),
+                        size_t(this->frame.getLineSize(plane)),
+                        widthInBytes,
+                        height});
+    }
+
+    DEBUG_FFMPEG("decoderFFmpeg::getRawFrameView Hand the frame over to a view");
+    this->currentFrameView = video::RawFrameView(planes, this->ff.shareFrame(this->frame));
+  }
+
+  return this->currentFrameView;
+}
+
 void decoderFFmpeg::copyCurImageToBuffer()
 {
   if (!frame)
@@ -389,6 +426,16 @@ bool decoderFFmpeg::pushAVPacket(FFmpeg::AVPacketWrapper &pkt)
 
 bool decoderFFmpeg::decodeFrame()
 {
+  if (!this->currentFrameView.isEmpty())
+  {
+    // The last frame is owned by a view which may still be in use (e.g. in the cache). Decode
+    // into a new frame.
+    this->currentFrameView = {};
+    this->frame            = this->ff.allocateFrame();
+    if (!this->frame)
+      return this->setErrorB(QStringLiteral("Could not allocate frame (av_frame_alloc)."));
+  }
+
   // Try to retrive a next frame from the decoder (don't copy it yet).
   auto retRecieve = this->ff.getFrameFromDecoder(decCtx, this->frame);
   if (retRecieve == 0)
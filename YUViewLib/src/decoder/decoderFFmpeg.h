@@ -57,8 +57,9 @@ public:
   void resetDecoder() override;
 
   // Decoding / pushing data
-  bool       decodeNextFrame() override;
-  QByteArray getRawFrameData() override;
+  bool                decodeNextFrame() override;
+  QByteArray          getRawFrameData() override;
+  video::RawFrameView getRawFrameView() override;
 
   // Push an AVPacket or raw data. When this returns false, pushing the given packet failed.
   // Probably the decoder switched to DecoderState::RetrieveFrames. Don't forget to push the given
@@ -96,6 +97,10 @@ protected:
   void
   copyCurImageToBuffer(); // Copy the raw data from the de265_image source *src to the byte array
 
+  // The view onto the current frame (if one was requested). The view owns the frame. So when the
+  // next frame is decoded, a new frame has to be allocated.
+  video::RawFrameView currentFrameView;
+
   // At the end of the file, when no more data is available, we will swith to flushing. After all
   // remaining frames were decoding, we will not request more data but switch to
   // DecoderState::EndOfBitstream.
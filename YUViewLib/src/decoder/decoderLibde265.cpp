@@ -411,6 +411,37 @@ QByteArray decoderLibde265::getRawFrameData()
   return this->currentOutputBuffer;
 }
 
+video::RawFrameView decoderLibde265::getRawFrameView()
+{
+  if (this->curImage == nullptr || this->decoderState != DecoderState::RetrieveFrames ||
+      this->decodeSignal != 0 || this->statisticsEnabled())
+    return {};
+
+  // The image belongs to the decoder and is only valid until the next frame is decoded. So this
+  // is a borrowed view which is copied if it is kept.
+  const auto nrPlanes =
+      (this->lib.de265_get_chroma_format(this->curImage) == de265_chroma_mono) ? 1 : 3;
+  std::vector<video::RawFrameView::Plane> planes;
+  for (int c = 0; c < nrPlanes; c++)
+  {
+    const auto width            = this->lib.de265_get_image_width(this->curImage, c);
+    const auto height           = this->lib.de265_get_image_height(this->curImage, c);
+    const auto bitsPerPixel     = this->lib.de265_get_bits_per_pixel(this->curImage, c);
+    const auto nrBytesPerSample = (bitsPerPixel > 8) ? 2 : 1;
+
+    int  stride = 0;
+    auto data   = this->lib.de265_get_image_plane(this->curImage, c, &stride);
+    if (data == nullptr || width <= 0 || height <= 0 || stride <= 0)
+      return {};
+    planes.push_back({data,
+                      size_t(stride),
+                      size_t(width * nrBytesPerSample),
+                      functions::clipToUnsigned(height)});
+  }
+
+  return video::RawFrameView(planes);
+}
+
 bool decoderLibde265::pushData(QByteArray &data)
 {
   if (this->decoderState != DecoderState::NeedsMoreData)
@@ -108,9 +108,10 @@ public:
   void setDecodeSignal(int signalID, bool &decoderResetNeeded) override;
 
   // Decoding / pushing data
-  bool       decodeNextFrame() override;
-  QByteArray getRawFrameData() override;
-  bool       pushData(QByteArray &data) override;
+  bool                decodeNextFrame() override;
+  QByteArray          getRawFrameData() override;
+  video::RawFrameView getRawFrameView() override;
+  bool                pushData(QByteArray &data) override;
 
   // Statistics
   void fillStatisticList(stats::StatisticsData &statisticsData) const override;
@@ -33,6 +33,8 @@
 #include "FFmpegLibraryFunctions.h"
 #include <QDir>
 
+#include <vector>
+
 namespace FFmpeg
 {
 
@@ -175,6 +177,32 @@ bool bindLibraryFunctions(QLibrary &                                  lib,
   return resolveFunction(lib, functions.swresample_version, "swresample_version", log);
 }
 
+// Keeps the given libraries loaded until it is destroyed
+class LibrariesReference
+{
+public:
+  LibrariesReference(const std::vector<const QLibrary *> &loadedLibraries)
+  {
+    for (const auto library : loadedLibraries)
+    {
+      if (!library->isLoaded())
+        continue;
+      // Loading a library that is already loaded only increases its reference count
+      auto reference = std::make_unique<QLibrary>(library->fileName());
+      if (reference->load())
+        this->libraries.push_back(std::move(reference));
+    }
+  }
+  ~LibrariesReference()
+  {
+    for (auto &library : this->libraries)
+      library->unload();
+  }
+
+private:
+  std::vector<std::unique_ptr<QLibrary>> libraries;
+};
+
 } // namespace
 
 FFmpegLibraryFunctions::~FFmpegLibraryFunctions()
@@ -314,12 +342,21 @@ void FFmpegLibraryFunctions::addLibNamesToList(QString         libName,
 void FFmpegLibraryFunctions::unloadAllLibraries()
 {
   this->log("Unloading all loaded libraries");
+  this->librariesReference.reset();
   this->libAvutil.unload();
   this->libSwresample.unload();
   this->libAvcodec.unload();
   this->libAvformat.unload();
 }
 
+std::shared_ptr<const void> FFmpegLibraryFunctions::getLibrariesReference()
+{
+  if (!this->librariesReference)
+    this->librariesReference = std::make_shared<LibrariesReference>(std::vector<const QLibrary *>(
+        {&this->libAvutil, &this->libSwresample, &this->libAvcodec, &this->libAvformat}));
+  return this->librariesReference;
+}
+
 QStringList FFmpegLibraryFunctions::getLibPaths() const
 {
   QStringList libPaths;
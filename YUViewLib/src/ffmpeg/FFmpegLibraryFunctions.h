@@ -36,6 +36,8 @@
 #include <QLibrary>
 #include <common/Typedef.h>
 
+#include <memory>
+
 namespace FFmpeg
 {
 
@@ -55,6 +57,11 @@ public:
 
   QStringList getLibPaths() const;
 
+  // Get a reference that keeps the loaded libraries loaded until the last copy of it is destroyed
+  // (even if this object is destroyed before). Everything that was allocated by the libraries and
+  // may outlive this object (like a decoded frame that is still in use) must hold one.
+  std::shared_ptr<const void> getLibrariesReference();
+
   struct AvFormatFunctions
   {
     std::function<void()> av_register_all;
@@ -137,6 +144,8 @@ private:
   QLibrary libSwresample;
   QLibrary libAvcodec;
   QLibrary libAvformat;
+
+  std::shared_ptr<const void> librariesReference;
 };
 
 } // namespace FFmpeg
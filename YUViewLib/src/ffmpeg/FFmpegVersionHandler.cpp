@@ -637,6 +637,15 @@ void FFmpegVersionHandler::freeFrame(AVFrameWrapper &frame)
   frame.clear();
 }
 
+std::shared_ptr<AVFrame> FFmpegVersionHandler::shareFrame(AVFrameWrapper &frame)
+{
+  auto freeFrame = this->lib.avutil.av_frame_free;
+  auto libraries = this->lib.getLibrariesReference();
+  // The libraries are captured so that they are not unloaded before the frame is freed
+  return std::shared_ptr<AVFrame>(
+      frame.getFrame(), [freeFrame, libraries](AVFrame *framePtr) { freeFrame(&framePtr); });
+}
+
 AVPacketWrapper FFmpegVersionHandler::allocatePacket()
 {
   auto rawPacket = this->lib.avcodec.av_packet_alloc();
@@ -74,6 +74,11 @@ public:
   void            unrefPacket(AVPacketWrapper &packet);
   void            freePacket(AVPacketWrapper &packet);
 
+  // Get a shared pointer that owns the frame and frees it when the last copy is destroyed. The
+  // libraries stay loaded for as long as the frame exists. Do not free the frame in any other way
+  // afterwards.
+  std::shared_ptr<AVFrame> shareFrame(AVFrameWrapper &frame);
+
   bool configureDecoder(AVCodecContextWrapper &decCtx, AVCodecParametersWrapper &codecpar);
 
   // Push a packet to the given decoder using avcodec_send_packet
@@ -0,0 +1,132 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "DataSourceMemoryMappedFile.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace filesource
+{
+
+DataSourceMemoryMappedFile::DataSourceMemoryMappedFile(const std::filesystem::path &filePath)
+{
+  this->file.setFileName(QString::fromStdString(filePath.string()));
+  if (!this->file.open(QIODevice::ReadOnly))
+    return;
+
+  // Mapping an empty file fails. We treat this like any other file that can not be mapped.
+  const auto size = this->file.size();
+  if (size <= 0)
+    return;
+
+  if (const auto data = this->file.map(0, size))
+  {
+    this->mappedData = data;
+    this->mappedSize = size;
+    this->path       = filePath;
+  }
+}
+
+std::vector<InfoItem> DataSourceMemoryMappedFile::getInfoList() const
+{
+  if (!this->isOk())
+    return {};
+
+  std::vector<InfoItem> infoList;
+  infoList.push_back(
+      InfoItem({"File Path", this->path.string(), "The absolute path of the local file"}));
+  infoList.push_back(InfoItem({"File Size", std::to_string(this->mappedSize)}));
+  infoList.push_back(InfoItem({"Memory Mapped", "Yes"}));
+
+  return infoList;
+}
+
+bool DataSourceMemoryMappedFile::atEnd() const
+{
+  return this->isOk() && this->filePosition >= this->mappedSize;
+}
+
+bool DataSourceMemoryMappedFile::isOk() const
+{
+  return this->mappedData != nullptr;
+}
+
+std::int64_t DataSourceMemoryMappedFile::position() const
+{
+  return this->filePosition;
+}
+
+bool DataSourceMemoryMappedFile::seek(const std::int64_t pos)
+{
+  if (!this->isOk() || pos < 0 || pos > this->mappedSize)
+    return false;
+
+  this->filePosition = pos;
+  return true;
+}
+
+std::int64_t DataSourceMemoryMappedFile::read(ByteVector &buffer, const std::int64_t nrBytes)
+{
+  if (!this->isOk() || nrBytes <= 0)
+    return 0;
+
+  const auto bytesRead = std::min(nrBytes, this->mappedSize - this->filePosition);
+  buffer.resize(static_cast<size_t>(bytesRead));
+  std::memcpy(buffer.data(), this->mappedData + this->filePosition, static_cast<size_t>(bytesRead));
+
+  this->filePosition += bytesRead;
+  return bytesRead;
+}
+
+std::optional<std::int64_t> DataSourceMemoryMappedFile::fileSize() const
+{
+  if (!this->isOk())
+    return {};
+  return this->mappedSize;
+}
+
+std::filesystem::path DataSourceMemoryMappedFile::filePath() const
+{
+  return this->path;
+}
+
+const unsigned char *DataSourceMemoryMappedFile::getMappedData(const std::int64_t startPos,
+                                                               const std::int64_t nrBytes) const
+{
+  if (!this->isOk() || startPos < 0 || nrBytes < 0 || startPos + nrBytes > this->mappedSize)
+    return nullptr;
+  return this->mappedData + startPos;
+}
+
+} // namespace filesource
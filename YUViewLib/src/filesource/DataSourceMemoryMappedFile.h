@@ -0,0 +1,82 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "IDataSource.h"
+
+#include <QFile>
+
+#include <filesystem>
+
+namespace filesource
+{
+
+/* A local file that is mapped into memory. Besides the IDataSource interface (which reads from the
+ * current position like DataSourceLocalFile), it provides direct access to the mapped file content.
+ * This access has no internal state, so it can be used from multiple threads at the same time
+ * without locking and without copying the data. If the file can not be mapped (e.g. because it is
+ * too big for the address space), isOk() returns false and the caller should fall back to buffered
+ * reading.
+ */
+class DataSourceMemoryMappedFile : public IDataSource
+{
+public:
+  DataSourceMemoryMappedFile(const std::filesystem::path &filePath);
+
+  [[nodiscard]] std::vector<InfoItem> getInfoList() const override;
+  [[nodiscard]] bool                  atEnd() const override;
+  [[nodiscard]] bool                  isOk() const override;
+  [[nodiscard]] std::int64_t          position() const override;
+
+  [[nodiscard]] bool         seek(const std::int64_t pos) override;
+  [[nodiscard]] std::int64_t read(ByteVector &buffer, const std::int64_t nrBytes) override;
+
+  [[nodiscard]] std::optional<std::int64_t> fileSize() const;
+  [[nodiscard]] std::filesystem::path       filePath() const;
+
+  // Get a pointer to the mapped data of the given byte range. Returns nullptr if the range is not
+  // completely within the file. The pointer is valid as long as this object exists.
+  [[nodiscard]] const unsigned char *getMappedData(const std::int64_t startPos,
+                                                   const std::int64_t nrBytes) const;
+
+protected:
+  std::filesystem::path path{};
+
+  QFile                file{};
+  const unsigned char *mappedData{};
+  std::int64_t         mappedSize{};
+  std::int64_t         filePosition{};
+};
+
+} // namespace filesource
@@ -0,0 +1,242 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FileIndexCache.h"
+
+#include <common/Functions.h>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+#define FILEINDEXCACHE_DEBUG_OUTPUT 0
+#if FILEINDEXCACHE_DEBUG_OUTPUT && !NDEBUG
+#include <QDebug>
+#define DEBUG_INDEXCACHE(msg) qDebug() << msg
+#else
+#define DEBUG_INDEXCACHE(msg) ((void)0)
+#endif
+
+namespace filesource
+{
+
+namespace
+{
+
+// "YUVi" - Identifies our index files
+constexpr quint32 INDEX_FILE_MAGIC = 0x59555669;
+// The version of the index file header. The content of the index is versioned by the index type.
+constexpr quint32 INDEX_FILE_VERSION = 1;
+// Use a fixed stream version so that index files don't depend on the Qt version
+constexpr auto STREAM_VERSION = QDataStream::Qt_5_12;
+
+struct SourceFileProperties
+{
+  QString absolutePath;
+  qint64  size{};
+  qint64  lastModified{};
+};
+
+std::optional<SourceFileProperties> getSourceFileProperties(const std::filesystem::path &filePath)
+{
+  QFileInfo fileInfo(functions::toQString(filePath));
+  if (!fileInfo.exists() || !fileInfo.isFile())
+    return {};
+
+  SourceFileProperties properties;
+  properties.absolutePath = fileInfo.absoluteFilePath();
+  properties.size         = fileInfo.size();
+  properties.lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+  return properties;
+}
+
+} // namespace
+
+FileIndexCache::FileIndexCache(const std::filesystem::path &filePath,
+                               const std::string           &indexType)
+    : filePath(filePath), indexType(indexType)
+{
+}
+
+bool FileIndexCache::read(const std::function<bool(QDataStream &)> &readIndex) const
+{
+  const auto sourceProperties = getSourceFileProperties(this->filePath);
+  if (!sourceProperties)
+    return false;
+
+  QFile indexFile(functions::toQString(this->getIndexFilePath()));
+  if (!indexFile.open(QIODevice::ReadOnly))
+    return false;
+
+  QDataStream stream(&indexFile);
+  stream.setVersion(STREAM_VERSION);
+
+  quint32 magic{};
+  quint32 version{};
+  QString indexType;
+  QString absolutePath;
+  qint64  size{};
+  qint64  lastModified{};
+  stream >> magic >> version >> indexType >> absolutePath >> size >> lastModified;
+
+  if (stream.status() != QDataStream::Ok || magic != INDEX_FILE_MAGIC ||
+      version != INDEX_FILE_VERSION || indexType.toStdString() != this->indexType ||
+      absolutePath != sourceProperties->absolutePath || size != sourceProperties->size ||
+      lastModified != sourceProperties->lastModified)
+  {
+    DEBUG_INDEXCACHE("FileIndexCache::read Index for " << sourceProperties->absolutePath
+                                                       << " is outdated");
+    return false;
+  }
+
+  if (!readIndex(stream) || stream.status() != QDataStream::Ok)
+  {
+    DEBUG_INDEXCACHE("FileIndexCache::read Error reading index for "
+                     << sourceProperties->absolutePath);
+    return false;
+  }
+
+  // The modification time of the index file is the time of its last use
+  std::error_code error;
+  std::filesystem::last_write_time(
+      this->getIndexFilePath(), std::filesystem::file_time_type::clock::now(), error);
+
+  DEBUG_INDEXCACHE("FileIndexCache::read Read index for " << sourceProperties->absolutePath);
+  return true;
+}
+
+bool FileIndexCache::write(const std::function<void(QDataStream &)> &writeIndex) const
+{
+  const auto sourceProperties = getSourceFileProperties(this->filePath);
+  if (!sourceProperties)
+    return false;
+
+  const auto cacheDirectory = functions::toQString(getCacheDirectory());
+  if (!QDir().mkpath(cacheDirectory))
+    return false;
+
+  // QSaveFile only replaces an existing index once everything was written. So there are never
+  // partially written index files (even if multiple instances write at the same time).
+  QSaveFile indexFile(functions::toQString(this->getIndexFilePath()));
+  if (!indexFile.open(QIODevice::WriteOnly))
+    return false;
+
+  QDataStream stream(&indexFile);
+  stream.setVersion(STREAM_VERSION);
+  stream << INDEX_FILE_MAGIC << INDEX_FILE_VERSION << QString::fromStdString(this->indexType)
+         << sourceProperties->absolutePath << sourceProperties->size
+         << sourceProperties->lastModified;
+  writeIndex(stream);
+
+  if (stream.status() != QDataStream::Ok)
+  {
+    indexFile.cancelWriting();
+    return false;
+  }
+
+  if (!indexFile.commit())
+    return false;
+
+  DEBUG_INDEXCACHE("FileIndexCache::write Wrote index for " << sourceProperties->absolutePath);
+  removeLeastRecentlyUsed(MAX_CACHE_SIZE, this->getIndexFilePath());
+  return true;
+}
+
+std::filesystem::path FileIndexCache::getIndexFilePath() const
+{
+  auto absolutePath = QFileInfo(functions::toQString(this->filePath)).absoluteFilePath();
+  auto key          = absolutePath + "|" + QString::fromStdString(this->indexType);
+  auto hash         = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex();
+  return getCacheDirectory() / (hash.toStdString() + ".idx");
+}
+
+std::filesystem::path FileIndexCache::getCacheDirectory()
+{
+  const auto cacheLocation = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  return functions::toFilesystemPath(cacheLocation) / "index";
+}
+
+void FileIndexCache::removeLeastRecentlyUsed(std::uintmax_t               maxCacheSize,
+                                             const std::filesystem::path &keepFile)
+{
+  struct IndexFile
+  {
+    std::filesystem::path           path;
+    std::uintmax_t                  size{};
+    std::filesystem::file_time_type lastUsed{};
+  };
+
+  // Other instances may add or remove index files at the same time. So all errors are ignored.
+  std::error_code        error;
+  std::vector<IndexFile> indexFiles;
+  std::uintmax_t         cacheSize{};
+  for (const auto &entry : std::filesystem::directory_iterator(getCacheDirectory(), error))
+  {
+    if (!entry.is_regular_file(error) || entry.path().extension() != ".idx")
+      continue;
+    IndexFile indexFile;
+    indexFile.path     = entry.path();
+    indexFile.size     = entry.file_size(error);
+    indexFile.lastUsed = entry.last_write_time(error);
+    cacheSize += indexFile.size;
+    indexFiles.push_back(indexFile);
+  }
+
+  if (cacheSize <= maxCacheSize)
+    return;
+
+  std::sort(indexFiles.begin(),
+            indexFiles.end(),
+            [](const IndexFile &a, const IndexFile &b) { return a.lastUsed < b.lastUsed; });
+
+  for (const auto &indexFile : indexFiles)
+  {
+    if (cacheSize <= maxCacheSize)
+      break;
+    if (indexFile.path == keepFile)
+      continue;
+    DEBUG_INDEXCACHE("FileIndexCache::removeLeastRecentlyUsed Removing "
+                     << functions::toQString(indexFile.path));
+    if (std::filesystem::remove(indexFile.path, error))
+      cacheSize -= indexFile.size;
+  }
+}
+
+} // namespace filesource
@@ -0,0 +1,84 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QDataStream>
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+
+namespace filesource
+{
+
+/* A persistent cache for the index that is built when a file is opened (e.g. the positions of all
+ * frames in a bitstream or of all POCs in a statistics file). Building the index requires reading
+ * the whole file which can take very long for big files.
+ * The index is stored in a file in the cache directory. It is identified by the absolute path of
+ * the source file and the type of the index. It is only used if the size and the modification time
+ * of the source file did not change since the index was written. The content of the index is up to
+ * the user. If the format of an index changes, the user must use a new indexType.
+ * The total size of the cache directory is limited. When an index is written, the index files
+ * that were used least recently (by their modification time, which is updated on every read) are
+ * removed until the cache fits into MAX_CACHE_SIZE again.
+ */
+class FileIndexCache
+{
+public:
+  FileIndexCache(const std::filesystem::path &filePath, const std::string &indexType);
+
+  // Read the index. If a valid index exists, readIndex is called with a stream to read the index
+  // from. It must return false if the content is invalid. Returns true if the index was read.
+  bool read(const std::function<bool(QDataStream &)> &readIndex) const;
+  // Write the index. writeIndex must write the index to the given stream.
+  bool write(const std::function<void(QDataStream &)> &writeIndex) const;
+
+  // The path of the file where the index is stored
+  [[nodiscard]] std::filesystem::path getIndexFilePath() const;
+
+  [[nodiscard]] static std::filesystem::path getCacheDirectory();
+
+  // Remove the least recently used index files until the total size of all index files is at most
+  // maxCacheSize bytes. The index file that is given in keepFile is never removed.
+  static void removeLeastRecentlyUsed(std::uintmax_t               maxCacheSize,
+                                      const std::filesystem::path &keepFile = {});
+
+  static constexpr std::uintmax_t MAX_CACHE_SIZE = 64 * 1024 * 1024;
+
+private:
+  std::filesystem::path filePath;
+  std::string           indexType;
+};
+
+} // namespace filesource
@@ -101,6 +101,14 @@ int64_t FileSource::readBytes(QByteArray &targetBuffer, int64_t startPos, int64_
   if (targetBuffer.size() < nrBytes)
     targetBuffer.resize(nrBytes);
 
+  return this->readBytes(targetBuffer.data(), startPos, nrBytes);
+}
+
+int64_t FileSource::readBytes(char *targetBuffer, int64_t startPos, int64_t nrBytes)
+{
+  if (!this->isOk())
+    return 0;
+
 #if FILESOURCE_DEBUG_SIMULATESLOWLOADING && !NDEBUG
   QThread::msleep(50);
 #endif
@@ -108,7 +116,7 @@ int64_t FileSource::readBytes(QByteArray &targetBuffer, int64_t startPos, int64_
   // lock the seek and read function
   QMutexLocker locker(&this->readMutex);
   this->srcFile.seek(startPos);
-  return this->srcFile.read(targetBuffer.data(), nrBytes);
+  return this->srcFile.read(targetBuffer, nrBytes);
 }
 
 std::vector<InfoItem> FileSource::getFileInfoList() const
@@ -93,6 +93,8 @@ public:
   // Read the given number of bytes starting at startPos into the QByteArray out
   // Resize the QByteArray if necessary. Return how many bytes were read.
   int64_t readBytes(QByteArray &targetBuffer, int64_t startPos, int64_t nrBytes);
+  // Read into the given buffer which must hold at least nrBytes
+  int64_t readBytes(char *targetBuffer, int64_t startPos, int64_t nrBytes);
 #if SSE_CONVERSION
   void readBytes(byteArrayAligned &data, int64_t startPos, int64_t nrBytes);
 #endif
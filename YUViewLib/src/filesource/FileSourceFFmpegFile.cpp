@@ -37,7 +37,9 @@
 #include <fstream>
 
 #include <common/Formatting.h>
+#include <common/Functions.h>
 #include <ffmpeg/AVCodecContextWrapper.h>
+#include <filesource/FileIndexCache.h>
 #include <parser/AV1/obu_header.h>
 #include <parser/common/SubByteReaderLogging.h>
 
@@ -436,8 +438,12 @@ bool FileSourceFFmpegFile::openFile(const QString        &filePath,
   }
   else if (parseFile)
   {
-    if (!this->scanBitstream(mainWindow))
-      return false;
+    if (!this->readIndexFromCache())
+    {
+      if (!this->scanBitstream(mainWindow))
+        return false;
+      this->writeIndexToCache();
+    }
 
     this->seekFileToBeginning();
   }
@@ -479,6 +485,14 @@ std::pair<int64_t, size_t> FileSourceFFmpegFile::getClosestSeekableFrameBefore(i
   return {bestSeekDTS, seekToFrameIdx};
 }
 
+std::vector<int> FileSourceFFmpegFile::getKeyFrameIndices() const
+{
+  std::vector<int> keyFrameIndices;
+  for (const auto &pic : this->keyFrameList)
+    keyFrameIndices.push_back(int(pic.frame));
+  return keyFrameIndices;
+}
+
 bool FileSourceFFmpegFile::scanBitstream(QWidget *mainWindow)
 {
   if (!this->isFileOpened)
@@ -533,6 +547,59 @@ bool FileSourceFFmpegFile::scanBitstream(QWidget *mainWindow)
   return !progress->wasCanceled();
 }
 
+// The index consists of the number of frames and the list of key frames. Increase the version
+// if this changes.
+#define FFMPEG_INDEX_TYPE "FFmpegKeyFrames-v1"
+
+bool FileSourceFFmpegFile::readIndexFromCache()
+{
+  filesource::FileIndexCache cache(functions::toFilesystemPath(this->fullFilePath),
+                                   FFMPEG_INDEX_TYPE);
+  return cache.read(
+      [this](QDataStream &stream)
+      {
+        quint64 nrFrames{};
+        quint32 nrKeyFrames{};
+        stream >> nrFrames >> nrKeyFrames;
+        if (stream.status() != QDataStream::Ok || nrKeyFrames == 0)
+          return false;
+
+        QList<pictureIdx> keyFrames;
+        for (quint32 i = 0; i < nrKeyFrames; i++)
+        {
+          quint64 frame{};
+          qint64  dts{};
+          stream >> frame >> dts;
+          keyFrames.append(pictureIdx(size_t(frame), dts));
+        }
+        if (stream.status() != QDataStream::Ok)
+          return false;
+
+        DEBUG_FFMPEG("FileSourceFFmpegFile::readIndexFromCache: Found %d frames and %d keyframes.",
+                     int(nrFrames),
+                     int(nrKeyFrames));
+        this->nrFrames     = size_t(nrFrames);
+        this->keyFrameList = keyFrames;
+        return true;
+      });
+}
+
+void FileSourceFFmpegFile::writeIndexToCache() const
+{
+  if (this->keyFrameList.isEmpty())
+    return;
+
+  filesource::FileIndexCache cache(functions::toFilesystemPath(this->fullFilePath),
+                                   FFMPEG_INDEX_TYPE);
+  cache.write(
+      [this](QDataStream &stream)
+      {
+        stream << quint64(this->nrFrames) << quint32(this->keyFrameList.size());
+        for (const auto &pic : this->keyFrameList)
+          stream << quint64(pic.frame) << qint64(pic.dts);
+      });
+}
+
 void FileSourceFFmpegFile::openFileAndFindVideoStream(QString fileName)
 {
   this->isFileOpened = false;
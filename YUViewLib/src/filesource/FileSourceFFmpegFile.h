@@ -123,6 +123,8 @@ public:
   // the given frameIdx where we can start decoding
   // Return: POC and frame index
   std::pair<int64_t, size_t> getClosestSeekableFrameBefore(int frameIdx) const;
+  // Get the frame indices of all key frames
+  std::vector<int> getKeyFrameIndices() const;
 
   QStringList getFFmpegLoadingLog() const { return ff.getLog(); }
 
@@ -182,6 +184,11 @@ protected:
   bool   scanBitstream(QWidget *mainWindow);
   size_t nrFrames{0};
 
+  // The result of scanBitstream is saved in the FileIndexCache. If the file did not change, the
+  // index is read from there instead of scanning the bitstream again.
+  bool readIndexFromCache();
+  void writeIndexToCache() const;
+
   // Private struct for navigation. We index frames by frame number and FFMpeg uses the pts.
   // This connects both values.
   struct pictureIdx
@@ -223,8 +223,6 @@ ParserAnnexBAVC::parseAndAddNALUnit(int
   std::shared_ptr<TreeItem> nalRoot;
   if (parent)
     nalRoot = parent->createChildItem();
-  else if (packetModel->rootItem)
-    nalRoot = packetModel->rootItem->createChildItem();
 
   if (nalRoot)
     ParserAnnexB::logNALSize(data, nalRoot, nalStartEndPosFile);
@@ -241,12 +239,14 @@ ParserAnnexBAVC::parseAndAddNALUnit(int
   try
   {
     nalAVC->header.parse(reader);
+    parseResult.nalUnitType = int(nalAVC->header.nalUnitTypeID);
 
     if (nalAVC->header.nal_unit_type == NalType::SPS)
     {
       specificDescription = " SPS";
       auto newSPS         = std::make_shared<seq_parameter_set_rbsp>();
       newSPS->parse(reader);
+      parseResult.isParameterSet = true;
 
       this->activeParameterSets.spsMap[newSPS->seqParameterSetData.seq_parameter_set_id] = newSPS;
 
@@ -278,6 +278,7 @@ ParserAnnexBAVC::parseAndAddNALUnit(int
       specificDescription = " PPS";
       auto newPPS         = std::make_shared<pic_parameter_set_rbsp>();
       newPPS->parse(reader, this->activeParameterSets.spsMap);
+      parseResult.isParameterSet = true;
 
       this->activeParameterSets.ppsMap[newPPS->pic_parameter_set_id] = newPPS;
 
@@ -388,7 +389,7 @@ ParserAnnexBAVC::parseAndAddNALUnit(int
       specificDescription     = " Slice Partition C";
       parseResult.nalTypeName = "Slice-PartC ";
     }
-    else if (nalAVC->header.nal_unit_type == NalType::SEI)
+    else if (!this->headersOnly && nalAVC->header.nal_unit_type == NalType::SEI)
     {
       specificDescription = " SEI";
       auto newSEI         = std::make_shared<sei_rbsp>();
@@ -576,18 +577,16 @@ ParserAnnexBAVC::parseAndAddNALUnit(int
     this->currentAUSliceTypes[currentSliceType]++;
   }
 
+  parseResult.description = "NAL " + std::to_string(nalAVC->nalIdx) + ": " +
+                            std::to_string(nalAVC->header.nalUnitTypeID) + specificDescription;
   if (nalRoot)
-  {
-    auto name = "NAL " + std::to_string(nalAVC->nalIdx) + ": " +
-                std::to_string(nalAVC->header.nalUnitTypeID) + specificDescription;
-    nalRoot->setProperties(name);
-  }
+    nalRoot->setProperties(parseResult.description);
 
   parseResult.success = true;
   return parseResult;
 }
 
-std::optional<ParserAnnexB::SeekData> ParserAnnexBAVC::getSeekData(int iFrameNr)
+std::optional<ParserAnnexB::SeekData> ParserAnnexBAVC::collectSeekData(int iFrameNr)
 {
   if (iFrameNr >= int(this->getNumberPOCs()) || iFrameNr < 0)
     return {};
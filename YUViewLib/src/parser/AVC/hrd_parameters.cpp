@@ -33,7 +33,6 @@
 #include "hrd_parameters.h"
 
 #include <common/Typedef.h>
-#include <parser/common/Functions.h>
 
 namespace parser::avc
 
@@ -51,21 +50,21 @@ void hrd_parameters::parse(reader::SubByteReaderLogging &reader)
   {
     auto val_max = 4294967294u; // 2^32-2
     this->bit_rate_value_minus1.push_back(reader.readUEV(
-        formatArray("bit_rate_value_minus1", SchedSelIdx), Options().withCheckRange({0, val_max})));
+        "bit_rate_value_minus1", {SchedSelIdx}, Options().withCheckRange({0, val_max})));
     this->cpb_size_value_minus1.push_back(reader.readUEV(
-        formatArray("cpb_size_value_minus1", SchedSelIdx), Options().withCheckRange({0, val_max})));
-    this->cbr_flag.push_back(reader.readFlag(formatArray("cbr_flag", SchedSelIdx)));
+        "cpb_size_value_minus1", {SchedSelIdx}, Options().withCheckRange({0, val_max})));
+    this->cbr_flag.push_back(reader.readFlag("cbr_flag", {SchedSelIdx}));
     {
       auto value = (this->bit_rate_value_minus1[SchedSelIdx] + 1) *
                    (uint64_t(1) << (6 + this->bit_rate_scale));
       this->BitRate.push_back(value);
-      reader.logCalculatedValue(formatArray("BitRate", SchedSelIdx), this->BitRate[SchedSelIdx]);
+      reader.logCalculatedValue("BitRate", {SchedSelIdx}, this->BitRate[SchedSelIdx]);
     }
     {
       auto value =
           (this->cpb_size_value_minus1[SchedSelIdx] + 1) * (uint64_t(1) << (4 + cpb_size_scale));
       this->CpbSize.push_back(value);
-      reader.logCalculatedValue(formatArray("CpbSize", SchedSelIdx), this->CpbSize[SchedSelIdx]);
+      reader.logCalculatedValue("CpbSize", {SchedSelIdx}, this->CpbSize[SchedSelIdx]);
     }
   }
   this->initial_cpb_removal_delay_length_minus1 =
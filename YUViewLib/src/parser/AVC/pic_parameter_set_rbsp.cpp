@@ -32,8 +32,6 @@
 
 #include "pic_parameter_set_rbsp.h"
 
-#include <parser/common/Functions.h>
-
 #include "Typedef.h"
 #include "seq_parameter_set_rbsp.h"
 
@@ -70,14 +68,14 @@ void pic_parameter_set_rbsp::parse(reader::SubByteReaderLogging &reader, SPSMap
     if (this->slice_group_map_type == 0)
     {
       for (unsigned iGroup = 0; iGroup <= this->num_slice_groups_minus1; iGroup++)
-        this->run_length_minus1[iGroup] = reader.readUEV(formatArray("run_length_minus1", iGroup));
+        this->run_length_minus1[iGroup] = reader.readUEV("run_length_minus1", {iGroup});
     }
     else if (this->slice_group_map_type == 2)
     {
       for (unsigned iGroup = 0; iGroup < this->num_slice_groups_minus1; iGroup++)
       {
-        this->top_left[iGroup]     = reader.readUEV(formatArray("top_left", iGroup));
-        this->bottom_right[iGroup] = reader.readUEV(formatArray("bottom_right", iGroup));
+        this->top_left[iGroup]     = reader.readUEV("top_left", {iGroup});
+        this->bottom_right[iGroup] = reader.readUEV("bottom_right", {iGroup});
       }
     }
     else if (this->slice_group_map_type == 3 || this->slice_group_map_type == 4 ||
@@ -94,7 +92,7 @@ void pic_parameter_set_rbsp::parse(reader::SubByteReaderLogging &reader, SPSMap
       for (unsigned i = 0; i <= this->pic_size_in_map_units_minus1; i++)
       {
         auto nrBits = std::ceil(std::log2(this->num_slice_groups_minus1 + 1));
-        this->slice_group_id.push_back(reader.readBits(formatArray("slice_group_id", i), nrBits));
+        this->slice_group_id.push_back(reader.readBits("slice_group_id", {i}, nrBits));
       }
     }
   }
@@ -128,7 +126,7 @@ void pic_parameter_set_rbsp::parse(reader::SubByteReaderLogging &reader, SPSMap
            i++)
       {
         this->pic_scaling_list_present_flag[i] =
-            reader.readFlag(formatArray("pic_scaling_list_present_flag", i));
+            reader.readFlag("pic_scaling_list_present_flag", {i});
         if (this->pic_scaling_list_present_flag[i])
         {
           if (i < 6)
@@ -34,8 +34,6 @@
 
 #include <common/Typedef.h>
 
-#include <parser/common/Functions.h>
-
 namespace parser::avc
 
 {
@@ -58,8 +56,8 @@ void pred_weight_table::parse(reader::SubByteReaderLogging &reader,
     luma_weight_l0_flag_list.push_back(luma_weight_l0_flag);
     if (luma_weight_l0_flag)
     {
-      this->luma_weight_l0.push_back(reader.readSEV(formatArray("luma_weight_l0", i)));
-      this->luma_offset_l0.push_back(reader.readSEV(formatArray("luma_offset_l0", i)));
+      this->luma_weight_l0.push_back(reader.readSEV("luma_weight_l0", {i}));
+      this->luma_offset_l0.push_back(reader.readSEV("luma_offset_l0", {i}));
     }
     if (ChromaArrayType != 0)
     {
@@ -69,10 +67,8 @@ void pred_weight_table::parse(reader::SubByteReaderLogging &reader,
       {
         for (unsigned j = 0; j < 2; j++)
         {
-          this->chroma_weight_l0[j].push_back(
-              reader.readSEV(formatArray("chroma_weight_l0", j, i)));
-          this->chroma_offset_l0[j].push_back(
-              reader.readSEV(formatArray("chroma_offset_l0", j, i)));
+          this->chroma_weight_l0[j].push_back(reader.readSEV("chroma_weight_l0", {j, i}));
+          this->chroma_offset_l0[j].push_back(reader.readSEV("chroma_offset_l0", {j, i}));
         }
       }
     }
@@ -85,8 +81,8 @@ void pred_weight_table::parse(reader::SubByteReaderLogging &reader,
       luma_weight_l1_flag_list.push_back(luma_weight_l1_flag);
       if (luma_weight_l1_flag)
       {
-        this->luma_weight_l1.push_back(reader.readSEV(formatArray("luma_weight_l1", i)));
-        this->luma_offset_l1.push_back(reader.readSEV(formatArray("luma_offset_l1", i)));
+        this->luma_weight_l1.push_back(reader.readSEV("luma_weight_l1", {i}));
+        this->luma_offset_l1.push_back(reader.readSEV("luma_offset_l1", {i}));
       }
       if (ChromaArrayType != 0)
       {
@@ -96,10 +92,8 @@ void pred_weight_table::parse(reader::SubByteReaderLogging &reader,
         {
           for (unsigned j = 0; j < 2; j++)
           {
-            this->chroma_weight_l1[i].push_back(
-                reader.readSEV(formatArray("chroma_weight_l1", j, i)));
-            this->chroma_offset_l1[i].push_back(
-                reader.readSEV(formatArray("chroma_offset_l1", j, i)));
+            this->chroma_weight_l1[i].push_back(reader.readSEV("chroma_weight_l1", {j, i}));
+            this->chroma_offset_l1[i].push_back(reader.readSEV("chroma_offset_l1", {j, i}));
           }
         }
       }
@@ -32,8 +32,6 @@
 
 #include "seq_parameter_set_data.h"
 
-#include <parser/common/Functions.h>
-
 #include "Typedef.h"
 
 namespace parser::avc
@@ -88,11 +86,11 @@ void seq_parameter_set_data::parse(reader::SubByteReaderLogging &reader)
     this->seq_scaling_matrix_present_flag = reader.readFlag("seq_scaling_matrix_present_flag");
     if (this->seq_scaling_matrix_present_flag)
     {
-      const auto nrMatrixEntries = ((this->chroma_format_idc != 3) ? 8 : 12);
-      for (int i = 0; i < nrMatrixEntries; i++)
+      const auto nrMatrixEntries = ((this->chroma_format_idc != 3) ? 8u : 12u);
+      for (unsigned i = 0; i < nrMatrixEntries; i++)
       {
         this->seq_scaling_list_present_flag[i] =
-            reader.readFlag(formatArray("seq_scaling_list_present_flag", i));
+            reader.readFlag("seq_scaling_list_present_flag", {i});
         if (this->seq_scaling_list_present_flag[i])
         {
           if (i < 6)
@@ -129,7 +127,7 @@ void seq_parameter_set_data::parse(reader::SubByteReaderLogging &reader)
     this->num_ref_frames_in_pic_order_cnt_cycle =
         reader.readUEV("num_ref_frames_in_pic_order_cnt_cycle");
     for (unsigned int i = 0; i < this->num_ref_frames_in_pic_order_cnt_cycle; i++)
-      this->offset_for_ref_frame[i] = reader.readSEV(formatArray("offset_for_ref_frame", i));
+      this->offset_for_ref_frame[i] = reader.readSEV("offset_for_ref_frame", {i});
   }
 
   this->max_num_ref_frames = reader.readUEV("max_num_ref_frames");
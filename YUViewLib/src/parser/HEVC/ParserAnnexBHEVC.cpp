@@ -157,7 +157,7 @@ video::yuv::PixelFormatYUV ParserAnnexBHEVC::getPixelFormat() const
   return {};
 }
 
-std::optional<ParserAnnexB::SeekData> ParserAnnexBHEVC::getSeekData(int iFrameNr)
+std::optional<ParserAnnexB::SeekData> ParserAnnexBHEVC::collectSeekData(int iFrameNr)
 {
   if (iFrameNr >= int(this->getNumberPOCs()) || iFrameNr < 0)
     return {};
@@ -324,8 +324,6 @@ ParserAnnexBHEVC::parseAndAddNALUnit(int
   std::shared_ptr<TreeItem> nalRoot;
   if (parent)
     nalRoot = parent->createChildItem();
-  else if (packetModel->rootItem)
-    nalRoot = packetModel->rootItem->createChildItem();
 
   if (nalRoot)
     ParserAnnexB::logNALSize(data, nalRoot, nalStartEndPosFile);
@@ -342,11 +340,13 @@ ParserAnnexBHEVC::parseAndAddNALUnit(int
   {
     nalHEVC->header.parse(reader);
     specificDescription << " " << NalTypeMapper.getName(nalHEVC->header.nal_unit_type);
+    parseResult.nalUnitType = int(nalHEVC->header.nalUnitTypeID);
 
     if (nalHEVC->header.nal_unit_type == NalType::VPS_NUT)
     {
       auto newVPS = std::make_shared<video_parameter_set_rbsp>();
       newVPS->parse(reader);
+      parseResult.isParameterSet = true;
 
       this->activeParameterSets.vpsMap[newVPS->vps_video_parameter_set_id] = newVPS;
 
@@ -364,6 +364,7 @@ ParserAnnexBHEVC::parseAndAddNALUnit(int
     {
       auto newSPS = std::make_shared<seq_parameter_set_rbsp>();
       newSPS->parse(reader, nalHEVC->header);
+      parseResult.isParameterSet = true;
 
       this->activeParameterSets.spsMap[newSPS->sps_seq_parameter_set_id] = newSPS;
 
@@ -381,6 +382,7 @@ ParserAnnexBHEVC::parseAndAddNALUnit(int
     {
       auto newPPS = std::make_shared<pic_parameter_set_rbsp>();
       newPPS->parse(reader);
+      parseResult.isParameterSet = true;
 
       this->activeParameterSets.ppsMap[newPPS->pps_pic_parameter_set_id] = newPPS;
 
@@ -422,7 +424,10 @@ ParserAnnexBHEVC::parseAndAddNALUnit(int
       first_slice_segment_in_pic_flag =
           newSlice->sliceSegmentHeader.first_slice_segment_in_pic_flag;
       if (first_slice_segment_in_pic_flag)
+      {
         this->lastFirstSliceSegmentInPic = newSlice;
+        parseResult.isStartOfPicture     = true;
+      }
 
       isRandomAccessSkip = false;
       if (firstPOCRandomAccess == INT_MAX)
@@ -524,8 +529,8 @@ ParserAnnexBHEVC::parseAndAddNALUnit(int
                  << this->maxPOCCount << (nalHEVC->header.isIRAP() ? " - IRAP" : "")
                  << (newSlice->sliceSegmentHeader.NoRaslOutputFlag ? "" : " - RASL"));
     }
-    else if (nalHEVC->header.nal_unit_type == NalType::PREFIX_SEI_NUT ||
-             nalHEVC->header.nal_unit_type == NalType::SUFFIX_SEI_NUT)
+    else if (!this->headersOnly && (nalHEVC->header.nal_unit_type == NalType::PREFIX_SEI_NUT ||
+                                    nalHEVC->header.nal_unit_type == NalType::SUFFIX_SEI_NUT))
     {
       auto newSEI = std::make_shared<sei_rbsp>();
       newSEI->parse(reader,
@@ -653,12 +658,11 @@ ParserAnnexBHEVC::parseAndAddNALUnit(int
     this->currentAUSliceTypes[currentSliceType]++;
   }
 
+  parseResult.description = "NAL " + std::to_string(nalHEVC->nalIdx) + ": " +
+                            std::to_string(nalHEVC->header.nalUnitTypeID) +
+                            specificDescription.str();
   if (nalRoot)
-  {
-    auto name = "NAL " + std::to_string(nalHEVC->nalIdx) + ": " +
-                std::to_string(nalHEVC->header.nalUnitTypeID) + specificDescription.str();
-    nalRoot->setProperties(name);
-  }
+    nalRoot->setProperties(parseResult.description);
 
   parseResult.success = true;
   return parseResult;
@@ -72,7 +72,7 @@ public:
   Size                       getSequenceSizeSamples() const override;
   video::yuv::PixelFormatYUV getPixelFormat() const override;
 
-  std::optional<SeekData> getSeekData(int iFrameNr) override;
+  std::optional<SeekData> collectSeekData(int iFrameNr) override;
   QByteArray              getExtradata() override;
   IntPair                 getProfileLevel() override;
   Ratio                   getSampleAspectRatio() override;
@@ -84,6 +84,11 @@ public:
                                  std::shared_ptr<TreeItem> parent             = nullptr) override;
 
 protected:
+  std::unique_ptr<ParserAnnexB> createParserForReparsing() const override
+  {
+    return std::make_unique<ParserAnnexBHEVC>();
+  }
+
   // ----- Some nested classes that are only used in the scope of this file handler class
 
   // The PicOrderCntMsb may be reset to zero for IDR frames. In order to count the global POC, we
@@ -32,8 +32,6 @@
 
 #include "pic_parameter_set_rbsp.h"
 
-#include <parser/common/Functions.h>
-
 namespace parser::hevc
 {
 
@@ -79,9 +77,9 @@ void pic_parameter_set_rbsp::parse(SubByteReaderLogging &reader)
     if (!this->uniform_spacing_flag)
     {
       for (unsigned i = 0; i < this->num_tile_columns_minus1; i++)
-        this->column_width_minus1.push_back(reader.readUEV(formatArray("column_width_minus1", i)));
+        this->column_width_minus1.push_back(reader.readUEV("column_width_minus1", {i}));
       for (unsigned i = 0; i < this->num_tile_rows_minus1; i++)
-        this->row_height_minus1.push_back(reader.readUEV(formatArray("row_height_minus1", i)));
+        this->row_height_minus1.push_back(reader.readUEV("row_height_minus1", {i}));
     }
     this->loop_filter_across_tiles_enabled_flag =
         reader.readFlag("loop_filter_across_tiles_enabled_flag");
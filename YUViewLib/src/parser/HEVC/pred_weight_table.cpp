@@ -32,7 +32,6 @@
 
 #include "pred_weight_table.h"
 
-#include <parser/common/Functions.h>
 #include "seq_parameter_set_rbsp.h"
 #include "slice_segment_header.h"
 
@@ -51,51 +50,44 @@ void pred_weight_table::parse(SubByteReaderLogging &                  reader,
   if (sps->ChromaArrayType != 0)
     this->delta_chroma_log2_weight_denom = reader.readSEV("delta_chroma_log2_weight_denom");
   for (unsigned i = 0; i <= slice->num_ref_idx_l0_active_minus1; i++)
-    this->luma_weight_l0_flag.push_back(reader.readFlag(formatArray("luma_weight_l0_flag", i)));
+    this->luma_weight_l0_flag.push_back(reader.readFlag("luma_weight_l0_flag", {i}));
   if (sps->ChromaArrayType != 0)
     for (unsigned i = 0; i <= slice->num_ref_idx_l0_active_minus1; i++)
-      this->chroma_weight_l0_flag.push_back(
-          reader.readFlag(formatArray("chroma_weight_l0_flag", i)));
+      this->chroma_weight_l0_flag.push_back(reader.readFlag("chroma_weight_l0_flag", {i}));
   for (unsigned i = 0; i <= slice->num_ref_idx_l0_active_minus1; i++)
   {
     if (this->luma_weight_l0_flag[i])
     {
-      this->delta_luma_weight_l0.push_back(reader.readSEV(formatArray("delta_luma_weight_l0", i)));
-      this->luma_offset_l0.push_back(reader.readSEV(formatArray("luma_offset_l0", i)));
+      this->delta_luma_weight_l0.push_back(reader.readSEV("delta_luma_weight_l0", {i}));
+      this->luma_offset_l0.push_back(reader.readSEV("luma_offset_l0", {i}));
     }
     if (this->chroma_weight_l0_flag[i])
       for (unsigned j = 0; j < 2; j++)
       {
-        this->delta_chroma_weight_l0.push_back(
-            reader.readSEV(formatArray("delta_chroma_weight_l0", j)));
-        this->delta_chroma_offset_l0.push_back(
-            reader.readSEV(formatArray("delta_chroma_offset_l0", j)));
+        this->delta_chroma_weight_l0.push_back(reader.readSEV("delta_chroma_weight_l0", {j}));
+        this->delta_chroma_offset_l0.push_back(reader.readSEV("delta_chroma_offset_l0", {j}));
       }
   }
 
   if (slice->slice_type == SliceType::B)
   {
     for (unsigned i = 0; i <= slice->num_ref_idx_l1_active_minus1; i++)
-      this->luma_weight_l1_flag.push_back(reader.readFlag(formatArray("luma_weight_l1_flag", i)));
+      this->luma_weight_l1_flag.push_back(reader.readFlag("luma_weight_l1_flag", {i}));
     if (sps->ChromaArrayType != 0)
       for (unsigned i = 0; i <= slice->num_ref_idx_l1_active_minus1; i++)
-        this->chroma_weight_l1_flag.push_back(
-            reader.readFlag(formatArray("chroma_weight_l1_flag", i)));
+        this->chroma_weight_l1_flag.push_back(reader.readFlag("chroma_weight_l1_flag", {i}));
     for (unsigned i = 0; i <= slice->num_ref_idx_l1_active_minus1; i++)
     {
       if (luma_weight_l1_flag[i])
       {
-        this->delta_luma_weight_l1.push_back(
-            reader.readSEV(formatArray("delta_luma_weight_l1", i)));
-        this->luma_offset_l1.push_back(reader.readSEV(formatArray("luma_offset_l1", i)));
+        this->delta_luma_weight_l1.push_back(reader.readSEV("delta_luma_weight_l1", {i}));
+        this->luma_offset_l1.push_back(reader.readSEV("luma_offset_l1", {i}));
       }
       if (chroma_weight_l1_flag[i])
         for (unsigned j = 0; j < 2; j++)
         {
-          this->delta_chroma_weight_l1.push_back(
-              reader.readSEV(formatArray("delta_chroma_weight_l1", j)));
-          this->delta_chroma_offset_l1.push_back(
-              reader.readSEV(formatArray("delta_chroma_offset_l1", j)));
+          this->delta_chroma_weight_l1.push_back(reader.readSEV("delta_chroma_weight_l1", {j}));
+          this->delta_chroma_offset_l1.push_back(reader.readSEV("delta_chroma_offset_l1", {j}));
         }
     }
   }
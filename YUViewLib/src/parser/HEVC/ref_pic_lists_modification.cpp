@@ -32,7 +32,6 @@
 
 #include "ref_pic_lists_modification.h"
 
-#include <parser/common/Functions.h>
 #include "slice_segment_header.h"
 
 #include <cmath>
@@ -54,7 +53,7 @@ void ref_pic_lists_modification::parse(SubByteReaderLogging &      reader,
   if (this->ref_pic_list_modification_flag_l0)
   {
     for (unsigned int i = 0; i <= slice->num_ref_idx_l0_active_minus1; i++)
-      this->list_entry_l0.push_back(reader.readBits(formatArray("list_entry_l0", i), nrBits));
+      this->list_entry_l0.push_back(reader.readBits("list_entry_l0", {i}, nrBits));
   }
 
   if (slice->slice_type == SliceType::B)
@@ -62,7 +61,7 @@ void ref_pic_lists_modification::parse(SubByteReaderLogging &      reader,
     this->ref_pic_list_modification_flag_l1 = reader.readFlag("ref_pic_list_modification_flag_l1");
     if (ref_pic_list_modification_flag_l1)
       for (unsigned int i = 0; i <= slice->num_ref_idx_l1_active_minus1; i++)
-        this->list_entry_l1.push_back(reader.readBits(formatArray("list_entry_l1", i), nrBits));
+        this->list_entry_l1.push_back(reader.readBits("list_entry_l1", {i}, nrBits));
   }
 }
 
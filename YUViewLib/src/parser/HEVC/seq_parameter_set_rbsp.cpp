@@ -32,8 +32,6 @@
 
 #include "seq_parameter_set_rbsp.h"
 
-#include <parser/common/Functions.h>
-
 #include <cmath>
 
 namespace parser::hevc
@@ -112,11 +110,10 @@ void seq_parameter_set_rbsp::parse(SubByteReaderLogging & reader,
          i++)
     {
       this->sps_max_dec_pic_buffering_minus1.push_back(
-          reader.readUEV(formatArray("sps_max_dec_pic_buffering_minus1", i)));
-      this->sps_max_num_reorder_pics.push_back(
-          reader.readUEV(formatArray("sps_max_num_reorder_pics", i)));
+          reader.readUEV("sps_max_dec_pic_buffering_minus1", {i}));
+      this->sps_max_num_reorder_pics.push_back(reader.readUEV("sps_max_num_reorder_pics", {i}));
       this->sps_max_latency_increase_plus1.push_back(
-          reader.readUEV(formatArray("sps_max_latency_increase_plus1", i)));
+          reader.readUEV("sps_max_latency_increase_plus1", {i}));
     }
   }
 
@@ -173,9 +170,9 @@ void seq_parameter_set_rbsp::parse(SubByteReaderLogging & reader,
     {
       auto nrBits = this->log2_max_pic_order_cnt_lsb_minus4 + 4;
       this->lt_ref_pic_poc_lsb_sps.push_back(
-          reader.readBits(formatArray("lt_ref_pic_poc_lsb_sps", i), nrBits));
+          reader.readBits("lt_ref_pic_poc_lsb_sps", {i}, nrBits));
       this->used_by_curr_pic_lt_sps_flag.push_back(
-          reader.readFlag(formatArray("used_by_curr_pic_lt_sps_flag", i)));
+          reader.readFlag("used_by_curr_pic_lt_sps_flag", {i}));
     }
   }
 
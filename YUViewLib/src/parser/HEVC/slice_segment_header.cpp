@@ -36,7 +36,6 @@
 #include "pic_parameter_set_rbsp.h"
 #include "seq_parameter_set_rbsp.h"
 #include "slice_segment_layer_rbsp.h"
-#include <parser/common/Functions.h>
 
 #include <cmath>
 
@@ -109,7 +108,7 @@ void slice_segment_header::parse(SubByteReaderLogging & reader,
       this->cross_layer_bla_flag = reader.readFlag("cross_layer_bla_flag");
     }
     for (; i < pps->num_extra_slice_header_bits; i++)
-      this->slice_reserved_flag.push_back(reader.readFlag(formatArray("slice_reserved_flag", i)));
+      this->slice_reserved_flag.push_back(reader.readFlag("slice_reserved_flag", {i}));
 
     auto sliceTypeIdx = reader.readUEV(
         "slice_type",
@@ -158,7 +157,7 @@ void slice_segment_header::parse(SubByteReaderLogging & reader,
             if (sps->num_long_term_ref_pics_sps > 1)
             {
               auto nrBits         = std::ceil(std::log2(sps->num_long_term_ref_pics_sps));
-              this->lt_idx_sps[i] = reader.readBits(formatArray("lt_idx_sps", i), nrBits);
+              this->lt_idx_sps[i] = reader.readBits("lt_idx_sps", {i}, nrBits);
             }
 
             this->UsedByCurrPicLt.push_back(
@@ -167,18 +166,15 @@ void slice_segment_header::parse(SubByteReaderLogging & reader,
           else
           {
             auto nrBits         = sps->log2_max_pic_order_cnt_lsb_minus4 + 4;
-            this->poc_lsb_lt[i] = reader.readBits(formatArray("poc_lsb_lt", i), nrBits);
-            this->used_by_curr_pic_lt_flag[i] =
-                reader.readFlag(formatArray("used_by_curr_pic_lt_flag", i));
+            this->poc_lsb_lt[i] = reader.readBits("poc_lsb_lt", {i}, nrBits);
+            this->used_by_curr_pic_lt_flag[i] = reader.readFlag("used_by_curr_pic_lt_flag", {i});
 
             this->UsedByCurrPicLt.push_back(this->used_by_curr_pic_lt_flag[i]);
           }
 
-          this->delta_poc_msb_present_flag[i] =
-              reader.readFlag(formatArray("delta_poc_msb_present_flag", i));
+          this->delta_poc_msb_present_flag[i] = reader.readFlag("delta_poc_msb_present_flag", {i});
           if (delta_poc_msb_present_flag[i])
-            this->delta_poc_msb_cycle_lt[i] =
-                reader.readUEV(formatArray("delta_poc_msb_cycle_lt", i));
+            this->delta_poc_msb_cycle_lt[i] = reader.readUEV("delta_poc_msb_cycle_lt", {i});
         }
       }
       if (sps->sps_temporal_mvp_enabled_flag)
@@ -285,7 +281,7 @@ void slice_segment_header::parse(SubByteReaderLogging & reader,
       {
         auto nrBits = offset_len_minus1 + 1;
         this->entry_point_offset_minus1.push_back(
-            reader.readBits(formatArray("entry_point_offset_minus1", i), nrBits));
+            reader.readBits("entry_point_offset_minus1", {i}, nrBits));
       }
     }
   }
@@ -296,7 +292,7 @@ void slice_segment_header::parse(SubByteReaderLogging & reader,
         reader.readUEV("slice_segment_header_extension_length");
     for (unsigned i = 0; i < this->slice_segment_header_extension_length; i++)
       this->slice_segment_header_extension_data_byte.push_back(
-          reader.readBits(formatArray("slice_segment_header_extension_data_byte", i), 8));
+          reader.readBits("slice_segment_header_extension_data_byte", {i}, 8));
   }
 
   // End of the slice header - byte_alignment()
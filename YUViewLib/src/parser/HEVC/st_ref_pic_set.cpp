@@ -32,7 +32,6 @@
 
 #include "st_ref_pic_set.h"
 
-#include <parser/common/Functions.h>
 #include "slice_segment_header.h"
 
 namespace parser::hevc
@@ -74,9 +73,9 @@ void st_ref_pic_set::parse(SubByteReaderLogging &reader, unsigned stRpsIdx, unsi
 
     for(unsigned j=0; j<=NumDeltaPocs[RefRpsIdx]; j++)
     {
-      this->used_by_curr_pic_flag.push_back(reader.readFlag(formatArray("used_by_curr_pic_flag", j)));
+      this->used_by_curr_pic_flag.push_back(reader.readFlag("used_by_curr_pic_flag", {j}));
       if(!this->used_by_curr_pic_flag.back())
-        this->use_delta_flag.push_back(reader.readFlag(formatArray("use_delta_flag", j)));
+        this->use_delta_flag.push_back(reader.readFlag("use_delta_flag", {j}));
       else
         this->use_delta_flag.push_back(true);
     }
@@ -89,14 +88,14 @@ void st_ref_pic_set::parse(SubByteReaderLogging &reader, unsigned stRpsIdx, unsi
       if(dPoc < 0 && this->use_delta_flag[NumNegativePics[RefRpsIdx] + j]) 
       { 
         DeltaPocS0[stRpsIdx][i] = dPoc;
-        reader.logArbitrary(formatArray("DeltaPocS0", stRpsIdx, i), std::to_string(dPoc));
+        reader.logCalculatedValue("DeltaPocS0", {stRpsIdx, i}, dPoc);
         UsedByCurrPicS0[stRpsIdx][i++] = this->used_by_curr_pic_flag[NumNegativePics[RefRpsIdx] + j];
       }
     }
     if(deltaRps < 0 && this->use_delta_flag[NumDeltaPocs[RefRpsIdx]])
     { 
       DeltaPocS0[stRpsIdx][i] = deltaRps;
-      reader.logArbitrary(formatArray("DeltaPocS0", stRpsIdx, i), std::to_string(deltaRps));
+      reader.logCalculatedValue("DeltaPocS0", {stRpsIdx, i}, deltaRps);
       UsedByCurrPicS0[stRpsIdx][i++] = this->used_by_curr_pic_flag[NumDeltaPocs[RefRpsIdx]];
     }
     for(unsigned int j=0; j<NumNegativePics[RefRpsIdx]; j++)
@@ -105,12 +104,12 @@ void st_ref_pic_set::parse(SubByteReaderLogging &reader, unsigned stRpsIdx, unsi
       if(dPoc < 0 && this->use_delta_flag[j])
       { 
         DeltaPocS0[stRpsIdx][i] = dPoc;
-        reader.logArbitrary(formatArray("DeltaPocS0", stRpsIdx, i), std::to_string(dPoc));
+        reader.logCalculatedValue("DeltaPocS0", {stRpsIdx, i}, dPoc);
         UsedByCurrPicS0[stRpsIdx][i++] = this->used_by_curr_pic_flag[j];
       } 
     } 
     NumNegativePics[stRpsIdx] = i;
-    reader.logCalculatedValue(formatArray("NumNegativePics", stRpsIdx), i);
+    reader.logCalculatedValue("NumNegativePics", {stRpsIdx}, i);
 
     // Derive NumPositivePics Rec. ITU-T H.265 v3 (04/2015) (7-60)
     i = 0;
@@ -120,14 +119,14 @@ void st_ref_pic_set::parse(SubByteReaderLogging &reader, unsigned stRpsIdx, unsi
       if(dPoc > 0 && this->use_delta_flag[j])
       { 
         DeltaPocS1[stRpsIdx][i] = dPoc;
-        reader.logArbitrary(formatArray("DeltaPocS1", stRpsIdx, i), std::to_string(dPoc));
+        reader.logCalculatedValue("DeltaPocS1", {stRpsIdx, i}, dPoc);
         UsedByCurrPicS1[stRpsIdx][i++] = this->used_by_curr_pic_flag[j];
       }
     }
     if(deltaRps > 0 && this->use_delta_flag[NumDeltaPocs[RefRpsIdx]])
     {
       DeltaPocS1[stRpsIdx][i] = deltaRps;
-      reader.logArbitrary(formatArray("DeltaPocS1", stRpsIdx, i), std::to_string(deltaRps));
+      reader.logCalculatedValue("DeltaPocS1", {stRpsIdx, i}, deltaRps);
       UsedByCurrPicS1[stRpsIdx][i++] = this->used_by_curr_pic_flag[NumDeltaPocs[RefRpsIdx]];
     }
     for(unsigned j=0; j<NumPositivePics[RefRpsIdx]; j++)
@@ -136,12 +135,12 @@ void st_ref_pic_set::parse(SubByteReaderLogging &reader, unsigned stRpsIdx, unsi
       if(dPoc > 0 && this->use_delta_flag[NumNegativePics[RefRpsIdx] + j])
       { 
         DeltaPocS1[stRpsIdx][i] = dPoc;
-        reader.logArbitrary(formatArray("DeltaPocS1", stRpsIdx, i), std::to_string(dPoc));
+        reader.logCalculatedValue("DeltaPocS1", {stRpsIdx, i}, dPoc);
         UsedByCurrPicS1[stRpsIdx][i++] = this->used_by_curr_pic_flag[NumNegativePics[RefRpsIdx] + j] ;
       }
     }
     NumPositivePics[stRpsIdx] = i;
-    reader.logCalculatedValue(formatArray("NumPositivePics", stRpsIdx), i);
+    reader.logCalculatedValue("NumPositivePics", {stRpsIdx}, i);
   }
   else
   {
@@ -149,36 +148,36 @@ void st_ref_pic_set::parse(SubByteReaderLogging &reader, unsigned stRpsIdx, unsi
     this->num_positive_pics = reader.readUEV("num_positive_pics");
     for(unsigned i = 0; i < num_negative_pics; i++)
     {
-      this->delta_poc_s0_minus1.push_back(reader.readUEV(formatArray("delta_poc_s0_minus1", i)));
-      this->used_by_curr_pic_s0_flag.push_back(reader.readFlag(formatArray("used_by_curr_pic_s0_flag", i)));
+      this->delta_poc_s0_minus1.push_back(reader.readUEV("delta_poc_s0_minus1", {i}));
+      this->used_by_curr_pic_s0_flag.push_back(reader.readFlag("used_by_curr_pic_s0_flag", {i}));
 
       if (i==0)
         DeltaPocS0[stRpsIdx][i] = -(int(this->delta_poc_s0_minus1.back()) + 1); // (7-65)
       else
         DeltaPocS0[stRpsIdx][i] = DeltaPocS0[stRpsIdx][i-1] - (this->delta_poc_s0_minus1.back() + 1); // (7-67)
-      reader.logArbitrary(formatArray("DeltaPocS0", stRpsIdx, i), std::to_string(DeltaPocS0[stRpsIdx][i]));
+      reader.logCalculatedValue("DeltaPocS0", {stRpsIdx, i}, DeltaPocS0[stRpsIdx][i]);
       UsedByCurrPicS0[stRpsIdx][i] = used_by_curr_pic_s0_flag[i];
-      reader.logArbitrary(formatArray("UsedByCurrPicS0", stRpsIdx, i), std::to_string(UsedByCurrPicS0[stRpsIdx][i]));
+      reader.logCalculatedValue("UsedByCurrPicS0", {stRpsIdx, i}, UsedByCurrPicS0[stRpsIdx][i]);
       
     }
     for(unsigned i = 0; i < num_positive_pics; i++)
     {
-      this->delta_poc_s1_minus1.push_back(reader.readUEV(formatArray("delta_poc_s1_minus1", i)));
-      this->used_by_curr_pic_s1_flag.push_back(reader.readFlag(formatArray("used_by_curr_pic_s1_flag", i)));
+      this->delta_poc_s1_minus1.push_back(reader.readUEV("delta_poc_s1_minus1", {i}));
+      this->used_by_curr_pic_s1_flag.push_back(reader.readFlag("used_by_curr_pic_s1_flag", {i}));
 
       if (i==0)
         DeltaPocS1[stRpsIdx][i] = this->delta_poc_s1_minus1.back() + 1; // (7-66)
       else
         DeltaPocS1[stRpsIdx][i] = DeltaPocS1[stRpsIdx][i-1] + (this->delta_poc_s1_minus1.back() + 1); // (7-68)
-      reader.logArbitrary(formatArray("DeltaPocS1", stRpsIdx, i), std::to_string(DeltaPocS1[stRpsIdx][i]));
+      reader.logCalculatedValue("DeltaPocS1", {stRpsIdx, i}, DeltaPocS1[stRpsIdx][i]);
       UsedByCurrPicS1[stRpsIdx][i] = used_by_curr_pic_s1_flag[i];
-      reader.logArbitrary(formatArray("UsedByCurrPicS1", stRpsIdx, i), std::to_string(UsedByCurrPicS1[stRpsIdx][i]));
+      reader.logCalculatedValue("UsedByCurrPicS1", {stRpsIdx, i}, UsedByCurrPicS1[stRpsIdx][i]);
     }
 
     NumNegativePics[stRpsIdx] = num_negative_pics;
     NumPositivePics[stRpsIdx] = num_positive_pics;
-    reader.logArbitrary(formatArray("NumNegativePics", stRpsIdx), std::to_string(num_negative_pics));
-    reader.logArbitrary(formatArray("NumPositivePics", stRpsIdx), std::to_string(num_positive_pics));
+    reader.logCalculatedValue("NumNegativePics", {stRpsIdx}, num_negative_pics);
+    reader.logCalculatedValue("NumPositivePics", {stRpsIdx}, num_positive_pics);
   }
 
   NumDeltaPocs[stRpsIdx] = NumNegativePics[stRpsIdx] + NumPositivePics[stRpsIdx]; // (7-69)
@@ -90,8 +90,6 @@ ParserAnnexBMpeg2::parseAndAddNALUnit(int
   std::shared_ptr<TreeItem> nalRoot;
   if (parent)
     nalRoot = parent->createChildItem();
-  else if (packetModel->rootItem)
-    nalRoot = packetModel->rootItem->createChildItem();
 
   reader::SubByteReaderLogging reader(data, nalRoot, "", readOffset);
 
@@ -101,6 +99,7 @@ ParserAnnexBMpeg2::parseAndAddNALUnit(int
   // Create a nal_unit and read the header
   NalUnitMpeg2 nal_mpeg2(nalID, nalStartEndPosFile);
   nal_mpeg2.header.parse(reader);
+  parseResult.nalUnitType = int(nal_mpeg2.header.start_code_value);
 
   bool        currentSliceIntra = false;
   std::string currentSliceType;
@@ -231,12 +230,11 @@ ParserAnnexBMpeg2::parseAndAddNALUnit(int
     this->currentAUSliceCounts[currentSliceType]++;
   }
 
+  parseResult.description = "NAL " + std::to_string(nal_mpeg2.nalIdx) + ": " +
+                            nalTypeCoding.getMeaning(nal_mpeg2.header.nal_unit_type) +
+                            specificDescription;
   if (nalRoot)
-  {
-    auto name = "NAL " + std::to_string(nal_mpeg2.nalIdx) + ": " +
-                nalTypeCoding.getMeaning(nal_mpeg2.header.nal_unit_type) + specificDescription;
-    nalRoot->setProperties(name);
-  }
+    nalRoot->setProperties(parseResult.description);
 
   parseResult.success = true;
   return parseResult;
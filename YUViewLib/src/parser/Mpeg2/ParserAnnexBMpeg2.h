@@ -65,7 +65,7 @@ public:
                                  std::shared_ptr<TreeItem> parent             = {}) override;
 
   // TODO: Reading from raw mpeg2 streams not supported (yet? Is this even defined / possible?)
-  virtual std::optional<SeekData> getSeekData(int iFrameNr) override
+  virtual std::optional<SeekData> collectSeekData(int iFrameNr) override
   {
     (void)iFrameNr;
     return {};
@@ -74,6 +74,12 @@ public:
   IntPair    getProfileLevel() override;
   Ratio      getSampleAspectRatio() override;
 
+protected:
+  std::unique_ptr<ParserAnnexB> createParserForReparsing() const override
+  {
+    return std::make_unique<ParserAnnexBMpeg2>();
+  }
+
 private:
   // We will keep a pointer to the first sequence extension to be able to retrive some data
   std::shared_ptr<mpeg2::sequence_extension> firstSequenceExtension;
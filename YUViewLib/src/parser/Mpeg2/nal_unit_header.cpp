@@ -37,29 +37,52 @@ namespace parser::mpeg2
 
 using namespace parser::reader;
 
-void nal_unit_header::parse(SubByteReaderLogging &reader)
+namespace
 {
-  SubByteReaderLoggingSubLevel subLevel(reader, "header_code()");
 
+// The meanings are only needed when the start code is logged. So they are not put into a map
+// for every start code that is read.
+std::string getStartCodeValueMeaning(int64_t value)
+{
+  if (value == 0)
+    return "picture_start_code";
+  // 01 through AF
+  if (value >= 0x01 && value < 0xaf)
+    return "slice_start_code - slice " + std::to_string(value);
+  switch (value)
   {
-    Options opt;
-    opt.meaningMap[0] = "picture_start_code";
-    // 01 through AF
-    for (int i = 0x01; i < 0xaf; i++)
-      opt.meaningMap[i] = "slice_start_code - slice " + std::to_string(i);
-    opt.meaningMap[176] = "reserved";
-    opt.meaningMap[177] = "reserved";
-    opt.meaningMap[178] = "user_data_start_code";
-    opt.meaningMap[179] = "sequence_header_code";
-    opt.meaningMap[180] = "sequence_error_code";
-    opt.meaningMap[181] = "extension_start_code";
-    opt.meaningMap[182] = "reserved";
-    opt.meaningMap[183] = "sequence_end_code";
-    opt.meaningMap[184] = "group_start_code";
-    opt.meaningMap[185] = "system start codes";
-
-    this->start_code_value = reader.readBits("start_code_value", 8, opt);
+  case 176:
+  case 177:
+    return "reserved";
+  case 178:
+    return "user_data_start_code";
+  case 179:
+    return "sequence_header_code";
+  case 180:
+    return "sequence_error_code";
+  case 181:
+    return "extension_start_code";
+  case 182:
+    return "reserved";
+  case 183:
+    return "sequence_end_code";
+  case 184:
+    return "group_start_code";
+  case 185:
+    return "system start codes";
+  default:
+    return {};
   }
+}
+
+} // namespace
+
+void nal_unit_header::parse(SubByteReaderLogging &reader)
+{
+  SubByteReaderLoggingSubLevel subLevel(reader, "header_code()");
+
+  this->start_code_value = reader.readBits(
+      "start_code_value", 8, Options().withMeaningFunction(getStartCodeValueMeaning));
 
   if (this->start_code_value == 0)
     this->nal_unit_type = NalType::PICTURE;
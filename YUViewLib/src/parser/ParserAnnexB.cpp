@@ -33,10 +33,12 @@
 #include "ParserAnnexB.h"
 
 #include <common/Formatting.h>
+#include <filesource/FileIndexCache.h>
 #include <parser/common/SubByteReaderLogging.h>
 
 #include <QElapsedTimer>
 #include <QProgressDialog>
+#include <algorithm>
 #include <assert.h>
 
 #define PARSERANNEXB_DEBUG_OUTPUT 0
@@ -50,6 +52,32 @@
 namespace parser
 {
 
+namespace
+{
+
+void writeByteVector(QDataStream &stream, const ByteVector &data)
+{
+  stream << quint32(data.size());
+  stream.writeRawData(reinterpret_cast<const char *>(data.data()), int(data.size()));
+}
+
+ByteVector readByteVector(QDataStream &stream)
+{
+  quint32 size{};
+  stream >> size;
+  if (stream.status() != QDataStream::Ok || size > (1u << 24))
+  {
+    stream.setStatus(QDataStream::ReadCorruptData);
+    return {};
+  }
+  ByteVector data(size);
+  if (stream.readRawData(reinterpret_cast<char *>(data.data()), int(size)) != int(size))
+    stream.setStatus(QDataStream::ReadPastEnd);
+  return data;
+}
+
+} // namespace
+
 std::string ParserAnnexB::getShortStreamDescription(const int) const
 {
   std::ostringstream info;
@@ -105,6 +133,7 @@ void ParserAnnexB::logNALSize(const ByteVector         &data,
 auto ParserAnnexB::getClosestSeekPoint(FrameIndexDisplayOrder targetFrame,
                                        FrameIndexDisplayOrder currentFrame) -> SeekPointInfo
 {
+  std::lock_guard<std::recursive_mutex> lock(this->indexMutex);
   if (targetFrame >= this->frameListCodingOrder.size())
     return {};
 
@@ -115,7 +144,7 @@ auto ParserAnnexB::getClosestSeekPoint(FrameIndexDisplayOrder targetFrame,
   auto bestSeekFrame = this->frameListCodingOrder.begin();
   for (auto it = this->frameListCodingOrder.begin(); it != this->frameListCodingOrder.end(); it++)
   {
-    if (it->randomAccessPoint && it->poc < frameTarget.poc)
+    if (it->randomAccessPoint && it->poc <= frameTarget.poc)
       bestSeekFrame = it;
     if (it->poc == frameTarget.poc)
       break;
@@ -141,8 +170,33 @@ auto ParserAnnexB::getClosestSeekPoint(FrameIndexDisplayOrder targetFrame,
   return seekPointInfo;
 }
 
+std::vector<FrameIndexDisplayOrder> ParserAnnexB::getRandomAccessPoints()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->indexMutex);
+  this->updateFrameListDisplayOrder();
+
+  std::vector<FrameIndexDisplayOrder> randomAccessPoints;
+  for (unsigned i = 0; i < this->frameListDisplayOder.size(); i++)
+    if (this->frameListDisplayOder[i].randomAccessPoint)
+      randomAccessPoints.push_back(i);
+  return randomAccessPoints;
+}
+
+std::optional<ParserAnnexB::SeekData> ParserAnnexB::getSeekData(int iFrameNr)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->indexMutex);
+  if (this->seekDataFromIndexCache.empty())
+    return this->collectSeekData(iFrameNr);
+
+  auto it = this->seekDataFromIndexCache.find(iFrameNr);
+  if (it == this->seekDataFromIndexCache.end())
+    return {};
+  return it->second;
+}
+
 std::optional<pairUint64> ParserAnnexB::getFrameStartEndPos(FrameIndexCodingOrder idx)
 {
+  std::lock_guard<std::recursive_mutex> lock(this->indexMutex);
   if (idx >= this->frameListCodingOrder.size())
     return {};
   this->updateFrameListDisplayOrder();
@@ -187,12 +241,13 @@ bool ParserAnnexB::parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file,
     if (this->streamInfo.file_size > 0)
       progressPercentValue = functions::clip((int)(pos * 100 / this->streamInfo.file_size), 0, 100);
 
+    auto nalData = reader::SubByteReaderLogging::convertToByteVector(
+        file->getNextNALUnit(false, &nalStartEndPosFile));
+
+    ParseResult parsingResult;
     try
     {
-      auto nalData = reader::SubByteReaderLogging::convertToByteVector(
-          file->getNextNALUnit(false, &nalStartEndPosFile));
-      auto parsingResult =
-          this->parseAndAddNALUnit(nalID, nalData, {}, nalStartEndPosFile, nullptr);
+      parsingResult = this->parseAndAddNALUnit(nalID, nalData, {}, nalStartEndPosFile, nullptr);
       if (!parsingResult.success)
       {
         DEBUG_ANNEXB("ParserAnnexB::parseAndAddNALUnit Error parsing NAL " << nalID);
@@ -204,17 +259,23 @@ bool ParserAnnexB::parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file,
     }
     catch (const std::exception &exc)
     {
-      (void)exc;
       // Reading a NAL unit failed at some point.
       // This is not too bad. Just don't use this NAL unit and continue with the next one.
       DEBUG_ANNEXB("ParserAnnexB::parseAndAddNALUnit Exception thrown parsing NAL "
                    << nalID << " - " << exc.what());
+      parsingResult             = {};
+      parsingResult.description = "NAL " + std::to_string(nalID) + ": ERROR " + exc.what();
     }
     catch (...)
     {
       DEBUG_ANNEXB("ParserAnnexB::parseAndAddNALUnit Exception thrown parsing NAL " << nalID);
+      parsingResult             = {};
+      parsingResult.description = "NAL " + std::to_string(nalID) + ": ERROR";
     }
 
+    if (this->packetModel->rootItem)
+      this->addNALUnitToPacketModel(nalID, nalData, nalStartEndPosFile, parsingResult);
+
     nalID++;
 
     if (progressDialog)
@@ -284,9 +345,359 @@ bool ParserAnnexB::runParsingOfFile(const std::filesystem::path &compressedFileP
 {
   DEBUG_ANNEXB("playlistItemCompressedVideo::runParsingOfFile");
   auto file = std::make_unique<FileSourceAnnexBFile>(compressedFilePath);
+  this->packetModel->setReparseFunction(
+      [this, compressedFilePath](size_t nalID, const PacketItemModel::Packet &packet)
+      { return this->reparseNALUnit(compressedFilePath, nalID, packet); });
   return this->parseAnnexBFile(file);
 }
 
+bool ParserAnnexB::indexAnnexBFile(FileSourceAnnexBFile &file,
+                                   std::atomic_bool     &breakIndexing,
+                                   std::optional<size_t> stopAfterNrFrames)
+{
+  DEBUG_ANNEXB("ParserAnnexB::indexAnnexBFile");
+
+  const auto filePath = std::filesystem::path(file.getAbsoluteFilePath());
+  {
+    auto lock = this->lockIndex();
+    if (this->useIndexCache && this->streamInfo.nrNalUnits == 0 &&
+        this->readIndexFromCache(filePath))
+      return true;
+
+    this->streamInfo.file_size = file.getFileSize().value_or(0);
+    this->streamInfo.parsing   = true;
+    this->headersOnly          = true;
+  }
+
+  pairUint64 nalStartEndPosFile;
+  while (!file.atEnd())
+  {
+    if (breakIndexing.load() ||
+        (stopAfterNrFrames && this->getNumberPOCs() >= *stopAfterNrFrames))
+    {
+      DEBUG_ANNEXB("ParserAnnexB::indexAnnexBFile Indexing stopped after "
+                   << this->getNumberPOCs() << " POCs");
+      auto lock         = this->lockIndex();
+      this->headersOnly = false;
+      return false;
+    }
+
+    if (this->streamInfo.file_size > 0)
+      this->progressPercentValue =
+          functions::clip(int(file.pos() * 100 / this->streamInfo.file_size), 0, 100);
+
+    // Reading from the file is done without holding the lock. Only the parsing (which adds to the
+    // index) must be locked.
+    auto nalData = reader::SubByteReaderLogging::convertToByteVector(
+        file.getNextNALUnit(false, &nalStartEndPosFile));
+
+    auto lock = this->lockIndex();
+    try
+    {
+      const auto nalID = int(this->streamInfo.nrNalUnits++);
+      if (!this->parseAndAddNALUnit(nalID, nalData, {}, nalStartEndPosFile, nullptr).success)
+        DEBUG_ANNEXB("ParserAnnexB::indexAnnexBFile Error parsing NAL " << nalID);
+    }
+    catch (...)
+    {
+      // Reading a NAL unit failed at some point.
+      // This is not too bad. Just don't use this NAL unit and continue with the next one.
+      DEBUG_ANNEXB("ParserAnnexB::indexAnnexBFile Exception thrown parsing NAL");
+    }
+  }
+
+  auto lock = this->lockIndex();
+  try
+  {
+    this->parseAndAddNALUnit(-1, {}, {}, {});
+  }
+  catch (...)
+  {
+    DEBUG_ANNEXB("ParserAnnexB::indexAnnexBFile Error finalizing parsing. This should not happen.");
+  }
+
+  DEBUG_ANNEXB("ParserAnnexB::indexAnnexBFile Indexing done. Found "
+               << this->frameListCodingOrder.size() << " POCs");
+
+  this->headersOnly          = false;
+  this->progressPercentValue = 100;
+  this->streamInfo.parsing   = false;
+  this->streamInfo.nrFrames  = unsigned(this->frameListCodingOrder.size());
+
+  if (this->useIndexCache)
+    this->writeIndexToCache(filePath);
+  return true;
+}
+
+void ParserAnnexB::addNALUnitToPacketModel(int                nalID,
+                                           const ByteVector  &data,
+                                           pairUint64         nalStartEndPosFile,
+                                           const ParseResult &parseResult)
+{
+  if (parseResult.isParameterSet || parseResult.isStartOfPicture)
+  {
+    std::lock_guard<std::mutex> lock(this->reparsingMutex);
+    if (parseResult.isParameterSet)
+      this->parameterSetsForReparsing.push_back({size_t(nalID), data});
+    if (parseResult.isStartOfPicture)
+      this->pictureStartsForReparsing.push_back(
+          {size_t(nalID), nalStartEndPosFile.first, uint32_t(data.size())});
+  }
+
+  PacketItemModel::Packet packet;
+  packet.fileOffset = nalStartEndPosFile.first;
+  packet.size       = uint32_t(data.size());
+  packet.type       = parseResult.nalUnitType;
+  packet.error      = !parseResult.success;
+  packet.summary    = parseResult.description;
+  this->packetModel->addPacket(std::move(packet));
+}
+
+std::shared_ptr<TreeItem> ParserAnnexB::reparseNALUnit(const std::filesystem::path   &filePath,
+                                                       size_t                         nalID,
+                                                       const PacketItemModel::Packet &packet)
+{
+  DEBUG_ANNEXB("ParserAnnexB::reparseNALUnit NAL " << nalID);
+
+  FileSource file;
+  if (!file.openFile(filePath))
+    return {};
+
+  auto readNALUnit = [&file](uint64_t fileOffset, uint32_t size) -> std::optional<ByteVector>
+  {
+    QByteArray data;
+    if (file.readBytes(data, int64_t(fileOffset), int64_t(size)) != int64_t(size))
+      return {};
+    return reader::SubByteReaderLogging::convertToByteVector(data);
+  };
+
+  auto nalData = readNALUnit(packet.fileOffset, packet.size);
+  if (!nalData)
+    return {};
+
+  auto parser = this->createParserForReparsing();
+
+  auto parseWithoutItems = [&parser](size_t id, const ByteVector &data)
+  {
+    try
+    {
+      parser->parseAndAddNALUnit(int(id), data, {}, {}, nullptr);
+    }
+    catch (...)
+    {
+      DEBUG_ANNEXB("ParserAnnexB::reparseNALUnit Error parsing NAL " << id);
+    }
+  };
+
+  parser->headersOnly = true;
+  {
+    std::lock_guard<std::mutex> lock(this->reparsingMutex);
+
+    // The start of the picture that the NAL belongs to (if it is not the start itself)
+    const auto &starts     = this->pictureStartsForReparsing;
+    const auto  isBeforeID = [](const PictureStart &start, size_t id) { return start.nalID < id; };
+    const auto  it         = std::lower_bound(starts.begin(), starts.end(), nalID, isBeforeID);
+    std::optional<PictureStart> pictureStart;
+    if (it != starts.begin() && (it == starts.end() || it->nalID != nalID))
+      pictureStart = *std::prev(it);
+
+    for (const auto &[parameterSetNalID, parameterSet] : this->parameterSetsForReparsing)
+    {
+      if (parameterSetNalID >= nalID)
+        break;
+      if (pictureStart && pictureStart->nalID < parameterSetNalID)
+      {
+        if (auto pictureStartData = readNALUnit(pictureStart->fileOffset, pictureStart->size))
+          parseWithoutItems(pictureStart->nalID, *pictureStartData);
+        pictureStart.reset();
+      }
+      parseWithoutItems(parameterSetNalID, parameterSet);
+    }
+    if (pictureStart)
+    {
+      if (auto pictureStartData = readNALUnit(pictureStart->fileOffset, pictureStart->size))
+        parseWithoutItems(pictureStart->nalID, *pictureStartData);
+    }
+  }
+  parser->headersOnly = false;
+
+  auto root = std::make_shared<TreeItem>();
+  try
+  {
+    const auto nalStartEndPosFile =
+        pairUint64(packet.fileOffset, packet.fileOffset + uint64_t(packet.size));
+    parser->parseAndAddNALUnit(int(nalID), *nalData, {}, nalStartEndPosFile, root);
+  }
+  catch (...)
+  {
+    // The items that were parsed until the error are still shown
+    DEBUG_ANNEXB("ParserAnnexB::reparseNALUnit Exception thrown parsing NAL " << nalID);
+  }
+  return root->getChild(0);
+}
+
+std::string ParserAnnexB::getIndexCacheType() const
+{
+  // The parsed content depends on the codec. Increase the version if the format of the index
+  // changes.
+  return std::string("AnnexB-") + this->metaObject()->className() + "-v1";
+}
+
+bool ParserAnnexB::readIndexFromCache(const std::filesystem::path &filePath)
+{
+  filesource::FileIndexCache cache(filePath, this->getIndexCacheType());
+  return cache.read(
+      [this](QDataStream &stream)
+      {
+        quint32 nrNalUnits{};
+        bool    hasFirstRandomAccessPOC{};
+        qint32  firstRandomAccessPOC{};
+        quint32 nrFrames{};
+        stream >> nrNalUnits >> hasFirstRandomAccessPOC >> firstRandomAccessPOC >> nrFrames;
+
+        vector<AnnexBFrame> frameList;
+        for (quint32 i = 0; i < nrFrames && stream.status() == QDataStream::Ok; i++)
+        {
+          AnnexBFrame frame;
+          qint32      poc{};
+          bool        hasFilePos{};
+          quint64     startPos{};
+          quint64     endPos{};
+          quint32     layerID{};
+          stream >> poc >> hasFilePos >> startPos >> endPos >> frame.randomAccessPoint >> layerID;
+          frame.poc     = poc;
+          frame.layerID = layerID;
+          if (hasFilePos)
+            frame.fileStartEndPos = pairUint64(startPos, endPos);
+          frameList.push_back(frame);
+        }
+
+        quint32 nrParameterSets{};
+        stream >> nrParameterSets;
+        std::vector<ByteVector> parameterSets;
+        for (quint32 i = 0; i < nrParameterSets && stream.status() == QDataStream::Ok; i++)
+          parameterSets.push_back(readByteVector(stream));
+
+        quint32 nrSeekPoints{};
+        stream >> nrSeekPoints;
+        std::map<int, SeekData> seekDataMap;
+        for (quint32 i = 0; i < nrSeekPoints && stream.status() == QDataStream::Ok; i++)
+        {
+          qint32   frameIdx{};
+          bool     hasFilePos{};
+          quint64  filePos{};
+          quint32  nrSeekParameterSets{};
+          SeekData seekData;
+          stream >> frameIdx >> hasFilePos >> filePos >> nrSeekParameterSets;
+          if (hasFilePos)
+            seekData.filePos = filePos;
+          for (quint32 j = 0; j < nrSeekParameterSets && stream.status() == QDataStream::Ok; j++)
+          {
+            quint32 parameterSetIdx{};
+            stream >> parameterSetIdx;
+            if (parameterSetIdx >= parameterSets.size())
+              return false;
+            seekData.parameterSets.push_back(parameterSets[parameterSetIdx]);
+          }
+          seekDataMap[frameIdx] = seekData;
+        }
+
+        if (stream.status() != QDataStream::Ok || frameList.empty() || seekDataMap.empty())
+          return false;
+
+        // The properties of the stream (size, format, ...) come from the parameter sets. So these
+        // must be parsed again.
+        this->headersOnly = true;
+        int nalID         = 0;
+        for (const auto &parameterSet : parameterSets)
+        {
+          try
+          {
+            this->parseAndAddNALUnit(nalID++, parameterSet, {}, {}, nullptr);
+          }
+          catch (...)
+          {
+            DEBUG_ANNEXB("ParserAnnexB::readIndexFromCache Error parsing parameter set");
+          }
+        }
+        this->headersOnly = false;
+
+        if (hasFirstRandomAccessPOC)
+          this->pocOfFirstRandomAccessFrame = firstRandomAccessPOC;
+        this->frameListCodingOrder = std::move(frameList);
+        this->frameListDisplayOder.clear();
+        this->seekDataFromIndexCache = std::move(seekDataMap);
+
+        this->progressPercentValue  = 100;
+        this->streamInfo.parsing    = false;
+        this->streamInfo.nrNalUnits = nrNalUnits;
+        this->streamInfo.nrFrames   = unsigned(this->frameListCodingOrder.size());
+
+        DEBUG_ANNEXB("ParserAnnexB::readIndexFromCache Read " << this->frameListCodingOrder.size()
+                                                              << " POCs from the index cache");
+        return true;
+      });
+}
+
+void ParserAnnexB::writeIndexToCache(const std::filesystem::path &filePath)
+{
+  // The seek data of all random access points. Parameter sets are usually repeated for every
+  // random access point so each unique parameter set is only saved once.
+  using ParameterSetIndices = std::vector<quint32>;
+  std::vector<ByteVector>                                               parameterSets;
+  std::vector<std::pair<int, std::pair<SeekData, ParameterSetIndices>>> seekPoints;
+  for (const auto frameIdx : this->getRandomAccessPoints())
+  {
+    const auto seekData = this->collectSeekData(int(frameIdx));
+    if (!seekData)
+      continue;
+
+    ParameterSetIndices parameterSetIndices;
+    for (const auto &parameterSet : seekData->parameterSets)
+    {
+      auto it = std::find(parameterSets.begin(), parameterSets.end(), parameterSet);
+      if (it == parameterSets.end())
+        it = parameterSets.insert(parameterSets.end(), parameterSet);
+      parameterSetIndices.push_back(quint32(std::distance(parameterSets.begin(), it)));
+    }
+    seekPoints.push_back({int(frameIdx), {*seekData, parameterSetIndices}});
+  }
+
+  if (this->frameListCodingOrder.empty() || seekPoints.empty())
+    return;
+
+  filesource::FileIndexCache cache(filePath, this->getIndexCacheType());
+  cache.write(
+      [&](QDataStream &stream)
+      {
+        stream << quint32(this->streamInfo.nrNalUnits)
+               << this->pocOfFirstRandomAccessFrame.has_value()
+               << qint32(this->pocOfFirstRandomAccessFrame.value_or(0))
+               << quint32(this->frameListCodingOrder.size());
+        for (const auto &frame : this->frameListCodingOrder)
+        {
+          const auto filePos = frame.fileStartEndPos.value_or(pairUint64(0, 0));
+          stream << qint32(frame.poc) << frame.fileStartEndPos.has_value()
+                 << quint64(filePos.first) << quint64(filePos.second) << frame.randomAccessPoint
+                 << quint32(frame.layerID);
+        }
+
+        stream << quint32(parameterSets.size());
+        for (const auto &parameterSet : parameterSets)
+          writeByteVector(stream, parameterSet);
+
+        stream << quint32(seekPoints.size());
+        for (const auto &[frameIdx, seekPoint] : seekPoints)
+        {
+          const auto &[seekData, parameterSetIndices] = seekPoint;
+          stream << qint32(frameIdx) << seekData.filePos.has_value()
+                 << quint64(seekData.filePos.value_or(0)) << quint32(parameterSetIndices.size());
+          for (const auto parameterSetIdx : parameterSetIndices)
+            stream << parameterSetIdx;
+        }
+      });
+}
+
 vector<QTreeWidgetItem *> ParserAnnexB::createTreeItemsFromStreamInfo() const
 {
   vector<QTreeWidgetItem *> infoList;
@@ -312,6 +723,7 @@ vector<QTreeWidgetItem *> ParserAnnexB::createTreeItemsFromStreamInfo() const
 
 int ParserAnnexB::getFramePOC(FrameIndexDisplayOrder frameIdx)
 {
+  std::lock_guard<std::recursive_mutex> lock(this->indexMutex);
   this->updateFrameListDisplayOrder();
   return this->frameListDisplayOder[frameIdx].poc;
 }
@@ -35,6 +35,9 @@
 #include <QList>
 #include <QTreeWidgetItem>
 
+#include <atomic>
+#include <map>
+#include <mutex>
 #include <optional>
 #include <set>
 
@@ -62,7 +65,11 @@ public:
   virtual ~ParserAnnexB() {};
 
   // How many POC's have been found in the file
-  size_t getNumberPOCs() const { return this->frameListCodingOrder.size(); }
+  size_t getNumberPOCs() const
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->indexMutex);
+    return this->frameListCodingOrder.size();
+  }
 
   // Clear all knowledge about the bitstream.
   void clearData();
@@ -87,6 +94,13 @@ public:
     bool                                          success{false};
     std::optional<std::string>                    nalTypeName;
     std::optional<BitratePlotModel::BitrateEntry> bitrateEntry;
+    // The full description of the NAL (e.g. "NAL 5: 1 TRAIL_R POC 4") and its type
+    std::string description;
+    int         nalUnitType{-1};
+    // Parameter sets are needed to parse all following NAL units. The NAL unit that starts a
+    // picture (e.g. a picture header) may be needed to parse the other NAL units of the picture.
+    bool isParameterSet{false};
+    bool isStartOfPicture{false};
   };
   virtual ParseResult parseAndAddNALUnit(int                                           nalID,
                                          const ByteVector                             &data,
@@ -107,7 +121,7 @@ public:
     std::vector<ByteVector> parameterSets;
     std::optional<uint64_t> filePos;
   };
-  virtual std::optional<SeekData> getSeekData(int iFrameNr) = 0;
+  std::optional<SeekData> getSeekData(int iFrameNr);
 
   // Look through the random access points and find the closest one before (or equal)
   // the given frameIdx where we can start decoding
@@ -120,6 +134,9 @@ public:
   auto getClosestSeekPoint(FrameIndexDisplayOrder targetFrame,
                            FrameIndexDisplayOrder currentFrame) -> SeekPointInfo;
 
+  // Get the indices (in display order) of all random access points
+  std::vector<FrameIndexDisplayOrder> getRandomAccessPoints();
+
   // Get the parameters sets as extradata. The format of this depends on the underlying codec.
   virtual QByteArray getExtradata() = 0;
   // Get some other properties of the bitstream in order to configure the FFMpegDecoder
@@ -133,6 +150,31 @@ public:
   // Called from the bitstream analyzer. This function can run in a background process.
   bool runParsingOfFile(const std::filesystem::path &compressedFilePath) override;
 
+  // Build the index of the frames in the file (POCs, file positions and random access points).
+  // Only the NAL headers, parameter sets and slice headers are parsed for this. Indexing stops at
+  // the end of the file, when breakIndexing is set or when stopAfterNrFrames frames were indexed.
+  // It can be continued by calling this again with the same file. Returns true if the end of the
+  // file was reached.
+  // This can run in a background thread while the index is already used. The index functions
+  // above lock the index themselves. All other functions must be called with lockIndex() held.
+  bool indexAnnexBFile(FileSourceAnnexBFile  &file,
+                       std::atomic_bool      &breakIndexing,
+                       std::optional<size_t>  stopAfterNrFrames = {});
+  bool isIndexing() const
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->indexMutex);
+    return this->streamInfo.parsing;
+  }
+
+  [[nodiscard]] std::unique_lock<std::recursive_mutex> lockIndex() const
+  {
+    return std::unique_lock<std::recursive_mutex>(this->indexMutex);
+  }
+
+  // By default, indexAnnexBFile reads the index from the FileIndexCache (if there is one) and
+  // writes it to the cache when done. Disable this to always index the file (e.g. to measure it).
+  void setUseIndexCache(bool useCache) { this->useIndexCache = useCache; }
+
 protected:
   struct AnnexBFrame
   {
@@ -169,6 +211,16 @@ protected:
   StreamInfo                streamInfo{};
   vector<QTreeWidgetItem *> createTreeItemsFromStreamInfo() const;
 
+  // Set while building the frame index. Only what is needed for the index is parsed then (NAL
+  // headers, parameter sets and slice headers). All other NAL units (e.g. SEI) are skipped.
+  bool headersOnly{false};
+
+  // Get the seek data for the given frame from the parsed NAL units (parameter sets and slices)
+  virtual std::optional<SeekData> collectSeekData(int iFrameNr) = 0;
+
+  // Create a new (empty) parser of the same type which is used to reparse single NAL units
+  virtual std::unique_ptr<ParserAnnexB> createParserForReparsing() const = 0;
+
   int getFramePOC(FrameIndexDisplayOrder frameIdx);
 
 private:
@@ -180,6 +232,41 @@ private:
   // needed.
   vector<AnnexBFrame> frameListDisplayOder;
   void                updateFrameListDisplayOrder();
+
+  mutable std::recursive_mutex indexMutex;
+
+  // The frame index of indexAnnexBFile is saved in the FileIndexCache. When it is read from the
+  // cache, only the parameter sets are parsed and the seek data for all random access points is
+  // taken from the cache.
+  bool                    readIndexFromCache(const std::filesystem::path &filePath);
+  void                    writeIndexToCache(const std::filesystem::path &filePath);
+  std::string             getIndexCacheType() const;
+  std::map<int, SeekData> seekDataFromIndexCache;
+  bool                    useIndexCache{true};
+
+  // In the bitstream analysis, only a short description of every NAL unit is added to the packet
+  // model. The items of a NAL unit are created by parsing it again (with a new parser) when it is
+  // expanded. All parameter sets and the start of the picture before the NAL unit are parsed first
+  // so that all values which are read from the bitstream are correct. Values which are derived
+  // from the previous pictures (e.g. the POC) may differ and are only correct in the description
+  // of the NAL unit.
+  void addNALUnitToPacketModel(int                nalID,
+                               const ByteVector  &data,
+                               pairUint64         nalStartEndPosFile,
+                               const ParseResult &parseResult);
+  std::shared_ptr<TreeItem> reparseNALUnit(const std::filesystem::path   &filePath,
+                                           size_t                         nalID,
+                                           const PacketItemModel::Packet &packet);
+
+  struct PictureStart
+  {
+    size_t   nalID{};
+    uint64_t fileOffset{};
+    uint32_t size{};
+  };
+  std::mutex                                 reparsingMutex;
+  std::vector<std::pair<size_t, ByteVector>> parameterSetsForReparsing;
+  std::vector<PictureStart>                  pictureStartsForReparsing;
 };
 
 } // namespace parser
\ No newline at end of file
@@ -152,7 +152,7 @@ video::yuv::PixelFormatYUV ParserAnnexBVVC::getPixelFormat() const
   return {};
 }
 
-std::optional<ParserAnnexB::SeekData> ParserAnnexBVVC::getSeekData(int iFrameNr)
+std::optional<ParserAnnexB::SeekData> ParserAnnexBVVC::collectSeekData(int iFrameNr)
 {
   if (iFrameNr >= int(this->getNumberPOCs()) || iFrameNr < 0)
     return {};
@@ -305,8 +305,6 @@ ParserAnnexBVVC::parseAndAddNALUnit(int
   std::shared_ptr<TreeItem> nalRoot;
   if (parent)
     nalRoot = parent->createChildItem();
-  else if (packetModel->rootItem)
-    nalRoot = packetModel->rootItem->createChildItem();
 
   if (nalRoot)
     ParserAnnexB::logNALSize(data, nalRoot, nalStartEndPosFile);
@@ -322,6 +320,7 @@ ParserAnnexBVVC::parseAndAddNALUnit(int
 
     auto nalType = nalVVC->header.nal_unit_type;
     specificDescription << " " << NalTypeMapper.getName(nalType);
+    parseResult.nalUnitType = int(nalVVC->header.nalUnitTypeID);
 
     if (updatedParsingState.NoOutputBeforeRecoveryFlag.count(nalVVC->header.nuh_layer_id) == 0)
       updatedParsingState.NoOutputBeforeRecoveryFlag[nalVVC->header.nuh_layer_id] = true;
@@ -330,6 +329,7 @@ ParserAnnexBVVC::parseAndAddNALUnit(int
     {
       auto newVPS = std::make_shared<video_parameter_set_rbsp>();
       newVPS->parse(reader);
+      parseResult.isParameterSet = true;
 
       this->activeParameterSets.vpsMap[newVPS->vps_video_parameter_set_id] = newVPS;
 
@@ -343,6 +343,7 @@ ParserAnnexBVVC::parseAndAddNALUnit(int
     {
       auto newSPS = std::make_shared<seq_parameter_set_rbsp>();
       newSPS->parse(reader);
+      parseResult.isParameterSet = true;
 
       this->activeParameterSets.spsMap[newSPS->sps_seq_parameter_set_id] = newSPS;
 
@@ -356,6 +357,7 @@ ParserAnnexBVVC::parseAndAddNALUnit(int
     {
       auto newPPS = std::make_shared<pic_parameter_set_rbsp>();
       newPPS->parse(reader, this->activeParameterSets.spsMap);
+      parseResult.isParameterSet = true;
 
       this->activeParameterSets.ppsMap[newPPS->pps_pic_parameter_set_id] = newPPS;
 
@@ -369,6 +371,7 @@ ParserAnnexBVVC::parseAndAddNALUnit(int
     {
       auto newAPS = std::make_shared<adaptation_parameter_set_rbsp>();
       newAPS->parse(reader);
+      parseResult.isParameterSet = true;
 
       auto apsType = APSParamTypeMapper.indexOf(newAPS->aps_params_type);
       this->activeParameterSets.apsMap[{apsType, newAPS->aps_adaptation_parameter_set_id}] = newAPS;
@@ -412,6 +415,7 @@ ParserAnnexBVVC::parseAndAddNALUnit(int
         updatedParsingState.prevTid0Pic[nalVVC->header.nuh_layer_id] = pictureHeader;
 
       specificDescription << " POC " << pictureHeader->PicOrderCntVal;
+      parseResult.isStartOfPicture = true;
 
       nalVVC->rbsp = newPictureHeader;
     }
@@ -429,6 +433,7 @@ ParserAnnexBVVC::parseAndAddNALUnit(int
       updatedParsingState.currentSlice = newSliceLayer;
       if (newSliceLayer->slice_header_instance.picture_header_structure_instance)
       {
+        parseResult.isStartOfPicture = true;
         newSliceLayer->slice_header_instance.picture_header_structure_instance
             ->calculatePictureOrderCount(
                 reader,
@@ -520,7 +525,8 @@ ParserAnnexBVVC::parseAndAddNALUnit(int
       newOPI->parse(reader);
       nalVVC->rbsp = newOPI;
     }
-    else if (nalType == NalType::SUFFIX_SEI_NUT || nalType == NalType::PREFIX_APS_NUT)
+    else if (!this->headersOnly &&
+             (nalType == NalType::SUFFIX_SEI_NUT || nalType == NalType::PREFIX_APS_NUT))
     {
       auto newSEI = std::make_shared<sei_message>();
       newSEI->parse(reader,
@@ -574,12 +580,11 @@ ParserAnnexBVVC::parseAndAddNALUnit(int
   this->parsingState = updatedParsingState;
   this->parsingState.currentAU.sizeBytes += data.size();
 
+  parseResult.description = "NAL " + std::to_string(nalVVC->nalIdx) + ": " +
+                            std::to_string(nalVVC->header.nalUnitTypeID) +
+                            specificDescription.str();
   if (nalRoot)
-  {
-    auto name = "NAL " + std::to_string(nalVVC->nalIdx) + ": " +
-                std::to_string(nalVVC->header.nalUnitTypeID) + specificDescription.str();
-    nalRoot->setProperties(name);
-  }
+    nalRoot->setProperties(parseResult.description);
 
   return parseResult;
 }
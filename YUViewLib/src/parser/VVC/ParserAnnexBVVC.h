@@ -91,7 +91,7 @@ public:
   Size                       getSequenceSizeSamples() const override;
   video::yuv::PixelFormatYUV getPixelFormat() const override;
 
-  virtual std::optional<SeekData> getSeekData(int iFrameNr) override;
+  virtual std::optional<SeekData> collectSeekData(int iFrameNr) override;
   QByteArray                      getExtradata() override;
   IntPair                         getProfileLevel() override;
   Ratio                           getSampleAspectRatio() override;
@@ -103,6 +103,11 @@ public:
                                  std::shared_ptr<TreeItem> parent             = {}) override;
 
 protected:
+  std::unique_ptr<ParserAnnexB> createParserForReparsing() const override
+  {
+    return std::make_unique<ParserAnnexBVVC>();
+  }
+
   // The PicOrderCntMsb may be reset to zero for IDR frames. In order to count the global POC, we
   // store the maximum POC.
   uint64_t maxPOCCount{0};
@@ -32,7 +32,6 @@
 
 #include "ref_pic_list_struct.h"
 
-#include <parser/common/Functions.h>
 #include "seq_parameter_set_rbsp.h"
 
 namespace parser::vvc
@@ -46,8 +45,7 @@ void ref_pic_list_struct::parse(SubByteReaderLogging &                  reader,
                                 std::shared_ptr<seq_parameter_set_rbsp> sps)
 {
   assert(sps != nullptr);
-  SubByteReaderLoggingSubLevel subLevel(reader,
-                                        formatArray("ref_pic_list_struct", listIdx, rplsIdx));
+  SubByteReaderLoggingSubLevel subLevel(reader, "ref_pic_list_struct", {listIdx, rplsIdx});
 
   this->num_ref_entries = reader.readUEV("num_ref_entries");
   if (sps->sps_long_term_ref_pics_flag && rplsIdx < sps->sps_num_ref_pic_lists[listIdx] &&
@@ -60,18 +58,17 @@ void ref_pic_list_struct::parse(SubByteReaderLogging &                  reader,
   {
     if (sps->sps_inter_layer_prediction_enabled_flag)
     {
-      this->inter_layer_ref_pic_flag[i] =
-          reader.readFlag(formatArray("inter_layer_ref_pic_flag", i));
+      this->inter_layer_ref_pic_flag[i] = reader.readFlag("inter_layer_ref_pic_flag", {i});
     }
     if (!this->inter_layer_ref_pic_flag[i])
     {
       if (sps->sps_long_term_ref_pics_flag)
       {
-        this->st_ref_pic_flag[i] = reader.readFlag(formatArray("st_ref_pic_flag", i));
+        this->st_ref_pic_flag[i] = reader.readFlag("st_ref_pic_flag", {i});
       }
       if (this->getStRefPicFlag(i))
       {
-        this->abs_delta_poc_st[i] = reader.readUEV(formatArray("abs_delta_poc_st", i));
+        this->abs_delta_poc_st[i] = reader.readUEV("abs_delta_poc_st", {i});
 
         // (149)
         if ((sps->sps_weighted_pred_flag || sps->sps_weighted_bipred_flag) && i != 0)
@@ -81,18 +78,18 @@ void ref_pic_list_struct::parse(SubByteReaderLogging &                  reader,
 
         if (this->AbsDeltaPocSt[i])
         {
-          this->strp_entry_sign_flag[i] = reader.readFlag(formatArray("strp_entry_sign_flag", i));
+          this->strp_entry_sign_flag[i] = reader.readFlag("strp_entry_sign_flag", {i});
         }
       }
       else if (!this->ltrp_in_header_flag)
       {
         auto numBits               = sps->sps_log2_max_pic_order_cnt_lsb_minus4 + 4;
-        this->rpls_poc_lsb_lt[j++] = reader.readBits(formatArray("rpls_poc_lsb_lt", i), numBits);
+        this->rpls_poc_lsb_lt[j++] = reader.readBits("rpls_poc_lsb_lt", {i}, numBits);
       }
     }
     else
     {
-      this->ilrp_idx[i] = reader.readUEV(formatArray("ilrp_idx", i));
+      this->ilrp_idx[i] = reader.readUEV("ilrp_idx", {i});
     }
   }
 
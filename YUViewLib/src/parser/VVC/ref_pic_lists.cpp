@@ -32,7 +32,6 @@
 
 #include "ref_pic_lists.h"
 
-#include <parser/common/Functions.h>
 #include "pic_parameter_set_rbsp.h"
 #include "seq_parameter_set_rbsp.h"
 
@@ -54,7 +53,7 @@ void ref_pic_lists::parse(SubByteReaderLogging &                  reader,
     this->delta_poc_msb_cycle_present_flag.push_back({});
     if (sps->sps_num_ref_pic_lists[i] > 0 && (i == 0 || (i == 1 && pps->pps_rpl1_idx_present_flag)))
     {
-      this->rpl_sps_flag[i] = reader.readFlag(formatArray("rpl_sps_flag", i));
+      this->rpl_sps_flag[i] = reader.readFlag("rpl_sps_flag", {i});
     }
     else
     {
@@ -74,7 +73,7 @@ void ref_pic_lists::parse(SubByteReaderLogging &                  reader,
           (i == 0 || (i == 1 && pps->pps_rpl1_idx_present_flag)))
       {
         auto nrBits      = std::ceil(std::log2(sps->sps_num_ref_pic_lists[i]));
-        this->rpl_idx[i] = reader.readBits(formatArray("rpl_idx", i), nrBits);
+        this->rpl_idx[i] = reader.readBits("rpl_idx", {i}, nrBits);
       }
       else if (i == 1 && !pps->pps_rpl1_idx_present_flag)
       {
@@ -87,7 +86,7 @@ void ref_pic_lists::parse(SubByteReaderLogging &                  reader,
     }
 
     this->RplsIdx[i] = this->rpl_sps_flag[i] ? this->rpl_idx[i] : sps->sps_num_ref_pic_lists[i];
-    reader.logCalculatedValue(formatArray("RplsIdx", i), this->RplsIdx[i]);
+    reader.logCalculatedValue("RplsIdx", {i}, this->RplsIdx[i]);
 
     auto rpl = this->getActiveRefPixList(sps, i);
 
@@ -96,14 +95,13 @@ void ref_pic_lists::parse(SubByteReaderLogging &                  reader,
       if (rpl.ltrp_in_header_flag)
       {
         auto nrBits      = sps->sps_log2_max_pic_order_cnt_lsb_minus4 + 4;
-        this->poc_lsb_lt = reader.readBits(formatArray("poc_lsb_lt", i), nrBits);
+        this->poc_lsb_lt = reader.readBits("poc_lsb_lt", {i}, nrBits);
       }
       this->delta_poc_msb_cycle_present_flag[i].push_back(
-          reader.readFlag(formatArray("delta_poc_msb_cycle_present_flag", i)));
+          reader.readFlag("delta_poc_msb_cycle_present_flag", {i}));
       if (this->delta_poc_msb_cycle_present_flag[i][j])
       {
-        this->delta_poc_msb_cycle_lt[i][j] =
-            reader.readUEV(formatArray("delta_poc_msb_cycle_lt", i, j));
+        this->delta_poc_msb_cycle_lt[i][j] = reader.readUEV("delta_poc_msb_cycle_lt", {i, j});
       }
     }
   }
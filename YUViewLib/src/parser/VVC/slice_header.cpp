@@ -34,7 +34,6 @@
 
 #include "pic_parameter_set_rbsp.h"
 #include "seq_parameter_set_rbsp.h"
-#include <parser/common/Functions.h>
 
 #include <cmath>
 
@@ -108,7 +107,7 @@ void slice_header::parse(SubByteReaderLogging                     &reader,
   }
   for (unsigned i = 0; i < sps->NumExtraShBits; i++)
   {
-    this->sh_extra_bit.push_back(reader.readFlag(formatArray("sh_extra_bit", i)));
+    this->sh_extra_bit.push_back(reader.readFlag("sh_extra_bit", {i}));
   }
   if (!pps->pps_rect_slice_flag && pps->NumTilesInPic - sh_slice_address > 1)
   {
@@ -146,8 +145,7 @@ void slice_header::parse(SubByteReaderLogging                     &reader,
       this->sh_num_alf_aps_ids_luma = reader.readBits("sh_num_alf_aps_ids_luma", 3);
       for (unsigned i = 0; i < sh_num_alf_aps_ids_luma; i++)
       {
-        this->sh_alf_aps_id_luma.push_back(
-            reader.readBits(formatArray("sh_alf_aps_id_luma", i), 3));
+        this->sh_alf_aps_id_luma.push_back(reader.readBits("sh_alf_aps_id_luma", {i}, 3));
       }
       if (sps->sps_chroma_format_idc != 0)
       {
@@ -206,7 +204,7 @@ void slice_header::parse(SubByteReaderLogging                     &reader,
         if (this->ref_pic_lists_instance->getActiveRefPixList(sps, i).num_ref_entries > 1)
         {
           this->sh_num_ref_idx_active_minus1[i] =
-              reader.readUEV(formatArray("sh_num_ref_idx_active_minus1", i));
+              reader.readUEV("sh_num_ref_idx_active_minus1", {i});
         }
       }
     }
@@ -333,7 +331,7 @@ void slice_header::parse(SubByteReaderLogging                     &reader,
     for (unsigned i = 0; i < this->sh_slice_header_extension_length; i++)
     {
       this->sh_slice_header_extension_data_byte.push_back(
-          reader.readBits(formatArray("sh_slice_header_extension_data_byte", i), 8));
+          reader.readBits("sh_slice_header_extension_data_byte", {i}, 8));
     }
   }
 
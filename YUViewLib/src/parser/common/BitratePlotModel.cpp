@@ -43,6 +43,14 @@
 
 #include <common/Functions.h>
 
+namespace
+{
+
+// The average plot averages over this many bitrate points before and after the point
+constexpr unsigned AVERAGE_RANGE = 10;
+
+} // namespace
+
 unsigned BitratePlotModel::getNrStreams() const
 {
   return this->dataPerStream.size();
@@ -75,30 +83,7 @@ PlotModel::Point
 BitratePlotModel::getPlotPoint(unsigned streamIndex, unsigned plotIndex, unsigned pointIndex) const
 {
   QMutexLocker locker(&this->dataMutex);
-
-  if (!this->dataPerStream.contains(streamIndex))
-    return {};
-
-  if (pointIndex < unsigned(this->dataPerStream[streamIndex].size()))
-  {
-    PlotModel::Point point;
-    if (this->sortMode == SortMode::DECODE_ORDER)
-      point.x = this->dataPerStream[streamIndex][pointIndex].dts;
-    else
-      point.x = this->dataPerStream[streamIndex][pointIndex].pts;
-    point.intra = this->dataPerStream[streamIndex][pointIndex].keyframe;
-
-    const auto isAveragePlot = (plotIndex == 1);
-    if (isAveragePlot)
-      point.y = this->calculateAverageValue(streamIndex, pointIndex);
-    else
-      point.y = this->dataPerStream[streamIndex][pointIndex].bitrate;
-    point.width = this->dataPerStream[streamIndex][pointIndex].duration;
-
-    return point;
-  }
-
-  return {};
+  return this->getPlotPointUnlocked(streamIndex, plotIndex, pointIndex);
 }
 
 QString
@@ -174,6 +159,18 @@ QString BitratePlotModel::formatValue(Axis axis, double value) const
     return functions::formatDataSize(value, false);
 }
 
+std::optional<std::vector<PlotModel::DecimatedPoint>> BitratePlotModel::getDecimatedPoints(
+    unsigned streamIndex, unsigned plotIndex, Range<double> xRange, unsigned maxNrPoints) const
+{
+  QMutexLocker locker(&this->dataMutex);
+
+  const auto it = this->decimationPerStream.constFind(streamIndex);
+  if (it == this->decimationPerStream.constEnd() || plotIndex >= it->size())
+    return {};
+
+  return it->at(plotIndex).getDecimatedPoints(xRange, maxNrPoints);
+}
+
 void BitratePlotModel::addBitratePoint(int streamIndex, BitrateEntry &entry)
 {
   QMutexLocker locker(&this->dataMutex);
@@ -216,14 +213,17 @@ void BitratePlotModel::addBitratePoint(int streamIndex, BitrateEntry &entry)
     if (currentSortMode == SortMode::DECODE_ORDER)
       return a.dts < b.dts;
     else
-      return b.pts < a.pts;
+      return a.pts < b.pts;
   };
 
   auto insertIterator = std::upper_bound(this->dataPerStream[streamIndex].begin(),
                                          this->dataPerStream[streamIndex].end(),
                                          entry,
                                          compareFunctionLessThen);
+  const auto insertIndex =
+      unsigned(std::distance(this->dataPerStream[streamIndex].begin(), insertIterator));
   this->dataPerStream[streamIndex].insert(insertIterator, entry);
+  this->updateDecimation(streamIndex, insertIndex);
   this->eventSubsampler.postEvent();
   if (newStream)
     emit nrStreamsChanged();
@@ -248,17 +248,63 @@ void BitratePlotModel::setBitrateSortingIndex(int index)
   QMutexLocker locker(&this->dataMutex);
   for (auto &list : this->dataPerStream)
     std::sort(list.begin(), list.end(), compareFunctionLessThen);
+  for (const auto streamIndex : this->dataPerStream.keys())
+    this->updateDecimation(streamIndex, 0);
+}
+
+PlotModel::Point BitratePlotModel::getPlotPointUnlocked(unsigned streamIndex,
+                                                        unsigned plotIndex,
+                                                        unsigned pointIndex) const
+{
+  const auto it = this->dataPerStream.constFind(streamIndex);
+  if (it == this->dataPerStream.constEnd() || pointIndex >= unsigned(it->size()))
+    return {};
+
+  const auto &entry = it->at(pointIndex);
+
+  PlotModel::Point point;
+  if (this->sortMode == SortMode::DECODE_ORDER)
+    point.x = entry.dts;
+  else
+    point.x = entry.pts;
+  point.intra = entry.keyframe;
+
+  const auto isAveragePlot = (plotIndex == 1);
+  if (isAveragePlot)
+    point.y = this->calculateAverageValue(streamIndex, pointIndex);
+  else
+    point.y = entry.bitrate;
+  point.width = entry.duration;
+
+  return point;
 }
 
 unsigned int BitratePlotModel::calculateAverageValue(unsigned streamIndex,
                                                      unsigned pointIndex) const
 {
-  const unsigned int averageRange   = 10;
-  unsigned           averageBitrate = 0;
-  const unsigned     start          = std::max(unsigned(0), pointIndex - averageRange);
-  const unsigned     end =
-      std::min(pointIndex + averageRange, unsigned(this->dataPerStream[streamIndex].size()));
+  const auto &list           = *this->dataPerStream.constFind(streamIndex);
+  unsigned    averageBitrate = 0;
+  const auto  start          = (pointIndex > AVERAGE_RANGE) ? pointIndex - AVERAGE_RANGE : 0u;
+  const auto  end            = std::min(pointIndex + AVERAGE_RANGE, unsigned(list.size()));
   for (unsigned i = start; i < end; i++)
-    averageBitrate += unsigned(this->dataPerStream[streamIndex][i].bitrate);
+    averageBitrate += unsigned(list[i].bitrate);
   return averageBitrate / (end - start);
 }
+
+void BitratePlotModel::updateDecimation(unsigned streamIndex, unsigned firstChangedPoint)
+{
+  const auto nrPoints    = unsigned(this->dataPerStream[streamIndex].size());
+  auto      &decimations = this->decimationPerStream[streamIndex];
+
+  // A new point changes the average of all points that have it in their averaging window
+  const auto firstChangedAverage =
+      (firstChangedPoint > AVERAGE_RANGE) ? firstChangedPoint - AVERAGE_RANGE : 0u;
+  const unsigned firstChangedPointPerPlot[] = {firstChangedPoint, firstChangedAverage};
+
+  for (unsigned plotIndex = 0; plotIndex < decimations.size(); plotIndex++)
+  {
+    auto getPoint = [this, streamIndex, plotIndex](unsigned pointIndex)
+    { return this->getPlotPointUnlocked(streamIndex, plotIndex, pointIndex); };
+    decimations[plotIndex].update(nrPoints, firstChangedPointPerPlot[plotIndex], getPoint);
+  }
+}
@@ -37,8 +37,11 @@
 #include <QString>
 
 #include <common/Typedef.h>
+#include <ui/views/PlotDecimation.h>
 #include <ui/views/PlotModel.h>
 
+#include <array>
+
 class BitratePlotModel : public PlotModel
 {
 public:
@@ -56,6 +59,10 @@ public:
   Range<double>           getYRange() const override { return yMaxStreamRange; }
   QString                 getItemInfoText(int index);
 
+  std::optional<std::vector<PlotModel::DecimatedPoint>> getDecimatedPoints(
+      unsigned streamIndex, unsigned plotIndex, Range<double> xRange, unsigned maxNrPoints) const
+      override;
+
   struct BitrateEntry
   {
     int     dts{0};
@@ -80,7 +87,14 @@ private:
   QMap<unsigned int, QList<BitrateEntry>> dataPerStream;
   mutable QMutex                          dataMutex;
 
-  unsigned int calculateAverageValue(unsigned streamIndex, unsigned pointIndex) const;
+  // One decimation pyramid for the bitrate plot and one for the average plot of each stream
+  QMap<unsigned int, std::array<PlotDecimation, 2>> decimationPerStream;
+
+  PlotModel::Point getPlotPointUnlocked(unsigned streamIndex,
+                                        unsigned plotIndex,
+                                        unsigned pointIndex) const;
+  unsigned int     calculateAverageValue(unsigned streamIndex, unsigned pointIndex) const;
+  void             updateDecimation(unsigned streamIndex, unsigned firstChangedPoint);
 
   Range<int>                     rangeDts;
   Range<int>                     rangePts;
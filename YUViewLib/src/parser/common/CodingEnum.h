@@ -58,7 +58,16 @@ public:
 
   CodingEnum() = default;
   CodingEnum(const EntryVector &entryVector, const T unknown)
-      : entryVector(entryVector), unknown(unknown){};
+      : entryVector(entryVector), unknown(unknown)
+  {
+    for (const auto &entry : this->entryVector)
+    {
+      if (entry.meaning.empty())
+        this->meaningMap[int(entry.code)] = entry.name;
+      else
+        this->meaningMap[int(entry.code)] = entry.meaning;
+    }
+  }
 
   T getValue(unsigned code) const
   {
@@ -76,18 +85,7 @@ public:
     return {};
   }
 
-  std::map<int, std::string> getMeaningMap() const
-  {
-    std::map<int, std::string> m;
-    for (const auto &entry : this->entryVector)
-    {
-      if (entry.meaning.empty())
-        m[int(entry.code)] = entry.name;
-      else
-        m[int(entry.code)] = entry.meaning;
-    }
-    return m;
-  }
+  const std::map<int, std::string> &getMeaningMap() const { return this->meaningMap; }
 
   std::string getMeaning(T value) const
   {
@@ -98,8 +96,9 @@ public:
   }
 
 private:
-  EntryVector entryVector;
-  T           unknown;
+  EntryVector                entryVector;
+  T                          unknown;
+  std::map<int, std::string> meaningMap;
 };
 
 } // namespace parser
@@ -83,19 +83,8 @@ PlotModel::Point HRDPlotModel::getPlotPoint(unsigned streamIndex, unsigned, unsi
   if (streamIndex > 0)
     return {};
 
-  if (pointIndex == 0)
-    return {0, 0, 0, false};
-
   QMutexLocker locker(&this->dataMutex);
-
-  if (pointIndex > unsigned(this->data.size()))
-    return {};
-
-  PlotModel::Point point;
-  point.x = this->data[pointIndex - 1].time_offset_end;
-  point.y = this->data[pointIndex - 1].cbp_fullness_end;
-  
-  return point;
+  return this->getPlotPointUnlocked(pointIndex);
 }
 
 QString HRDPlotModel::getPointInfo(unsigned streamIndex, unsigned, unsigned pointIndex) const
@@ -161,6 +150,16 @@ QString HRDPlotModel::formatValue(Axis axis, double value) const
     return functions::formatDataSize(value, false);
 }
 
+std::optional<std::vector<PlotModel::DecimatedPoint>> HRDPlotModel::getDecimatedPoints(
+    unsigned streamIndex, unsigned, Range<double> xRange, unsigned maxNrPoints) const
+{
+  if (streamIndex > 0)
+    return {};
+
+  QMutexLocker locker(&this->dataMutex);
+  return this->decimation.getDecimatedPoints(xRange, maxNrPoints);
+}
+
 void HRDPlotModel::addHRDEntry(HRDPlotModel::HRDEntry &entry)
 {
   QMutexLocker locker(&this->dataMutex);
@@ -178,6 +177,13 @@ void HRDPlotModel::addHRDEntry(HRDPlotModel::HRDEntry &entry)
   if (entry.cbp_fullness_start < this->bufferLevelLimits.min)
     this->bufferLevelLimits.min = entry.cbp_fullness_start;
 
+  // The first point of the plot is the empty buffer at time 0 before the first entry
+  const auto nrPoints = unsigned(this->data.size() + 1);
+  this->decimation.update(nrPoints,
+                          nrPoints - 1,
+                          [this](unsigned pointIndex)
+                          { return this->getPlotPointUnlocked(pointIndex); });
+
   DEBUG_PLOT("HRDPlotModel::addHRDEntry time_offset_end " << entry.time_offset_end << " cbp_fullness_end " << entry.cbp_fullness_end);
 
   this->eventSubsampler.postEvent();
@@ -198,3 +204,18 @@ void HRDPlotModel::setCPBBufferSize(int size)
     this->eventSubsampler.postEvent();
   }
 }
+
+PlotModel::Point HRDPlotModel::getPlotPointUnlocked(unsigned pointIndex) const
+{
+  if (pointIndex == 0)
+    return {0, 0, 0, false};
+
+  if (pointIndex > unsigned(this->data.size()))
+    return {};
+
+  PlotModel::Point point;
+  point.x = this->data[pointIndex - 1].time_offset_end;
+  point.y = this->data[pointIndex - 1].cbp_fullness_end;
+
+  return point;
+}
@@ -37,6 +37,7 @@
 #include <QString>
 
 #include <common/Typedef.h>
+#include <ui/views/PlotDecimation.h>
 #include <ui/views/PlotModel.h>
 
 class HRDPlotModel : public PlotModel
@@ -56,6 +57,10 @@ public:
   Range<double>           getYRange() const override { return getStreamParameter(0).yRange; }
   QString                 getItemInfoText(int index);
 
+  std::optional<std::vector<PlotModel::DecimatedPoint>> getDecimatedPoints(
+      unsigned streamIndex, unsigned plotIndex, Range<double> xRange, unsigned maxNrPoints) const
+      override;
+
   struct HRDEntry
   {
     // There are two types of entries.
@@ -83,6 +88,9 @@ public:
 private:
   QList<HRDEntry> data;
   mutable QMutex  dataMutex;
+  PlotDecimation  decimation;
+
+  PlotModel::Point getPlotPointUnlocked(unsigned pointIndex) const;
 
   int        cpb_buffer_size{0};
   double     time_offset_max{0};
@@ -64,6 +64,15 @@ auto streamIndexColors = std::vector<Color>({Color("#90caf9"),   // blue (200)
                                              Color("#6d4c41"),   // brown (600)
                                              Color("#7cb342")}); // light green (600)
 
+namespace
+{
+
+// The number of expanded packets for which the items are kept. Creating the items of a packet again
+// requires reparsing it.
+constexpr size_t MAX_NR_EXPANDED_PACKETS = 64;
+
+} // namespace
+
 PacketItemModel::PacketItemModel(QObject *parent) : QAbstractItemModel(parent)
 {
 }
@@ -88,6 +97,30 @@ QVariant PacketItemModel::data(const QModelIndex &index, int role) const
   if (!index.isValid())
     return {};
 
+  if (auto packetIndex = this->getPacketIndex(index))
+  {
+    const auto packet = this->getPacket(*packetIndex);
+    if (!packet)
+      return {};
+    if (role == Qt::ForegroundRole)
+      return QVariant(packet->error ? QBrush(QColor(255, 0, 0)) : QBrush());
+    if (role == Qt::BackgroundRole)
+    {
+      if (!useColorCoding || packet->streamIndex < 0)
+        return QVariant(QBrush());
+      return QVariant(QBrush(functionsGui::toQColor(
+          streamIndexColors.at(packet->streamIndex % streamIndexColors.size()))));
+    }
+    if ((role == Qt::DisplayRole || role == Qt::ToolTipRole) && index.column() == 0)
+    {
+      auto name = QString::fromStdString(packet->summary);
+      if (!showVideoOnly && packet->streamIndex >= 0)
+        name = QString("Stream %1 - ").arg(packet->streamIndex) + name;
+      return QVariant(name);
+    }
+    return {};
+  }
+
   auto item = static_cast<TreeItem *>(index.internalPointer());
   if (role == Qt::ForegroundRole)
   {
@@ -120,12 +153,19 @@ QModelIndex PacketItemModel::index(int row, int column, const QModelIndex &paren
   if (!hasIndex(row, column, parent))
     return {};
 
+  // The first level items of packets have no item. They are identified by a null pointer.
+  const auto nrRootChildren = this->rootItem ? this->rootItem->getNrChildItems() : size_t(0);
+  if (!parent.isValid() && size_t(row) >= nrRootChildren)
+    return this->createIndex(row, column, nullptr);
+
   auto parentItem = this->rootItem.get();
-  if (parent.isValid())
+  if (auto packetIndex = this->getPacketIndex(parent))
+    parentItem = this->getExpandedPacketItem(*packetIndex);
+  else if (parent.isValid())
     parentItem = static_cast<TreeItem *>(parent.internalPointer());
 
-  Q_ASSERT_X(
-      parentItem != nullptr, Q_FUNC_INFO, "pointer to parent is null. This must never happen");
+  if (parentItem == nullptr)
+    return {};
 
   auto childItem = parentItem->getChild(row);
   if (childItem)
@@ -138,12 +178,23 @@ QModelIndex PacketItemModel::parent(const QModelIndex &index) const
   if (!index.isValid())
     return {};
 
-  auto childItem  = static_cast<TreeItem *>(index.internalPointer());
+  auto childItem = static_cast<TreeItem *>(index.internalPointer());
+  if (childItem == nullptr)
+    return {};
   auto parentItem = childItem->getParentItem().lock();
 
   if (parentItem == this->rootItem)
     return {};
 
+  for (const auto &expandedPacket : this->expandedPackets)
+  {
+    if (expandedPacket.item == parentItem)
+    {
+      const auto nrRootChildren = this->rootItem ? this->rootItem->getNrChildItems() : size_t(0);
+      return this->createIndex(int(nrRootChildren + expandedPacket.packetIndex), 0, nullptr);
+    }
+  }
+
   // Get the row of the item in the list of children of the parent item
   int row = 0;
   if (parentItem)
@@ -166,15 +217,128 @@ int PacketItemModel::rowCount(const QModelIndex &parent) const
 
   if (!parent.isValid())
     return this->nrShowChildItems;
+  if (auto packetIndex = this->getPacketIndex(parent))
+  {
+    auto item = this->getExpandedPacketItem(*packetIndex);
+    return (item == nullptr) ? 0 : int(item->getNrChildItems());
+  }
   auto p = static_cast<TreeItem *>(parent.internalPointer());
   return (p == nullptr) ? 0 : int(p->getNrChildItems());
 }
 
+bool PacketItemModel::hasChildren(const QModelIndex &parent) const
+{
+  if (this->getPacketIndex(parent))
+    return bool(this->reparseFunction);
+  return this->rowCount(parent) > 0;
+}
+
+bool PacketItemModel::canFetchMore(const QModelIndex &parent) const
+{
+  auto packetIndex = this->getPacketIndex(parent);
+  return packetIndex && this->reparseFunction &&
+         this->getExpandedPacketItem(*packetIndex) == nullptr;
+}
+
+void PacketItemModel::fetchMore(const QModelIndex &parent)
+{
+  if (!this->canFetchMore(parent))
+    return;
+
+  const auto packetIndex = *this->getPacketIndex(parent);
+  const auto packet      = this->getPacket(packetIndex);
+  if (!packet)
+    return;
+
+  auto item = this->reparseFunction(packetIndex, *packet);
+  if (!item)
+    // Remember that there is nothing to show so that we don't try to reparse this again
+    item = std::make_shared<TreeItem>();
+
+  // Drop the items of the packets that were not used for the longest time
+  const auto nrRootChildren = this->rootItem ? this->rootItem->getNrChildItems() : size_t(0);
+  while (this->expandedPackets.size() >= MAX_NR_EXPANDED_PACKETS)
+  {
+    const auto leastRecentlyUsed = std::prev(this->expandedPackets.end());
+    const auto nrRemovedItems    = int(leastRecentlyUsed->item->getNrChildItems());
+    if (nrRemovedItems > 0)
+      this->beginRemoveRows(this->index(int(nrRootChildren + leastRecentlyUsed->packetIndex), 0),
+                            0,
+                            nrRemovedItems - 1);
+    this->expandedPackets.erase(leastRecentlyUsed);
+    if (nrRemovedItems > 0)
+      this->endRemoveRows();
+  }
+
+  const auto nrItems = int(item->getNrChildItems());
+  if (nrItems > 0)
+    this->beginInsertRows(parent, 0, nrItems - 1);
+  this->expandedPackets.push_front({packetIndex, item});
+  if (nrItems > 0)
+    this->endInsertRows();
+}
+
+void PacketItemModel::addPacket(Packet &&packet)
+{
+  std::lock_guard<std::mutex> lock(this->packetsMutex);
+  this->packets.push_back(std::move(packet));
+}
+
+void PacketItemModel::setReparseFunction(ReparseFunction function)
+{
+  this->reparseFunction = std::move(function);
+}
+
+int PacketItemModel::getStreamIndex(const QModelIndex &index) const
+{
+  if (auto packetIndex = this->getPacketIndex(index))
+  {
+    const auto packet = this->getPacket(*packetIndex);
+    return packet ? packet->streamIndex : -1;
+  }
+  auto item = static_cast<TreeItem *>(index.internalPointer());
+  return (item == nullptr) ? -1 : item->getStreamIndex();
+}
+
 size_t PacketItemModel::getNumberFirstLevelChildren() const
 {
+  size_t nrChildren{};
   if (this->rootItem)
-    return rootItem->getNrChildItems();
-  return {};
+    nrChildren += rootItem->getNrChildItems();
+  std::lock_guard<std::mutex> lock(this->packetsMutex);
+  return nrChildren + this->packets.size();
+}
+
+std::optional<size_t> PacketItemModel::getPacketIndex(const QModelIndex &index) const
+{
+  if (!index.isValid() || index.internalPointer() != nullptr)
+    return {};
+  const auto nrRootChildren = this->rootItem ? this->rootItem->getNrChildItems() : size_t(0);
+  if (size_t(index.row()) < nrRootChildren)
+    return {};
+  return size_t(index.row()) - nrRootChildren;
+}
+
+std::optional<PacketItemModel::Packet> PacketItemModel::getPacket(size_t packetIndex) const
+{
+  std::lock_guard<std::mutex> lock(this->packetsMutex);
+  if (packetIndex >= this->packets.size())
+    return {};
+  return this->packets[packetIndex];
+}
+
+TreeItem *PacketItemModel::getExpandedPacketItem(size_t packetIndex) const
+{
+  for (auto it = this->expandedPackets.begin(); it != this->expandedPackets.end(); it++)
+  {
+    if (it->packetIndex == packetIndex)
+    {
+      // Mark as most recently used
+      this->expandedPackets.splice(this->expandedPackets.begin(), this->expandedPackets, it);
+      return it->item.get();
+    }
+  }
+  return nullptr;
 }
 
 void PacketItemModel::updateNumberModelItems()
@@ -225,30 +389,19 @@ bool FilterByStreamIndexProxyModel::filterAcceptsRow(int row, const QModelIndex
     return true;
   }
 
-  TreeItem *parentItem;
-  if (!sourceParent.isValid())
+  auto p = static_cast<PacketItemModel *>(sourceModel());
+  if (p == nullptr)
   {
-    // Get the root item
-    auto s = sourceModel();
-    auto p = static_cast<PacketItemModel *>(s);
-    if (p == nullptr)
-    {
-      DEBUG_FILTER("FilterByStreamIndexProxyModel::filterAcceptsRow Unable to get root item");
-      return false;
-    }
-    parentItem = p->rootItem.get();
+    DEBUG_FILTER("FilterByStreamIndexProxyModel::filterAcceptsRow Unable to get source model");
+    return false;
   }
-  else
-    parentItem = static_cast<TreeItem *>(sourceParent.internalPointer());
-  Q_ASSERT_X(
-      parentItem != nullptr, Q_FUNC_INFO, "pointer to parent is null. This must never happen");
 
-  auto childItem = parentItem->getChild(row);
-  if (childItem != nullptr)
+  auto childIndex = p->index(row, 0, sourceParent);
+  if (childIndex.isValid())
   {
-    DEBUG_FILTER("FilterByStreamIndexProxyModel::filterAcceptsRow item %d",
-                 childItem->getStreamIndex());
-    return childItem->getStreamIndex() == streamIndex || childItem->getStreamIndex() == -1;
+    const auto childStreamIndex = p->getStreamIndex(childIndex);
+    DEBUG_FILTER("FilterByStreamIndexProxyModel::filterAcceptsRow item %d", childStreamIndex);
+    return childStreamIndex == streamIndex || childStreamIndex == -1;
   }
 
   DEBUG_FILTER("FilterByStreamIndexProxyModel::filterAcceptsRow item null -> reject");
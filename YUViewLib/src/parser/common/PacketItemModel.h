@@ -35,6 +35,11 @@
 #include <QAbstractItemModel>
 #include <QSortFilterProxyModel>
 
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+
 #include "TreeItem.h"
 
 // The item model which is used to display packets from the bitstream. This can be AVPackets or other units from the bitstream (NAL units e.g.)
@@ -53,10 +58,35 @@ public:
   virtual QModelIndex parent(const QModelIndex &index) const override;
   virtual int rowCount(const QModelIndex &parent = QModelIndex()) const override;
   virtual int columnCount(const QModelIndex &parent = QModelIndex()) const override { (void)parent; return 5; }
+  virtual bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+  virtual bool canFetchMore(const QModelIndex &parent) const override;
+  virtual void fetchMore(const QModelIndex &parent) override;
 
   // The root of the tree
   std::shared_ptr<TreeItem> rootItem;
 
+  // Instead of creating all items of a packet while parsing (as children of the rootItem), a
+  // parser can only add a compact description of the packet. The items of the packet are then
+  // created by reparsing the packet when it is expanded in the view. Only the items of the last
+  // expanded packets are kept. A model should either use the rootItem or packets.
+  struct Packet
+  {
+    uint64_t    fileOffset{};
+    uint32_t    size{};
+    int         type{-1};
+    int         streamIndex{-1};
+    bool        error{};
+    std::string summary;
+  };
+  using ReparseFunction =
+      std::function<std::shared_ptr<TreeItem>(size_t packetIndex, const Packet &packet)>;
+
+  // This can be called from the background parser
+  void addPacket(Packet &&packet);
+  void setReparseFunction(ReparseFunction function);
+
+  int getStreamIndex(const QModelIndex &index) const;
+
   void setUseColorCoding(bool colorCoding);
   void setShowVideoStreamOnly(bool showVideoOnly);
 
@@ -69,6 +99,23 @@ private:
 
   size_t getNumberFirstLevelChildren() const;
 
+  // Get the index into the packets if the index is a first level packet item
+  std::optional<size_t> getPacketIndex(const QModelIndex &index) const;
+  std::optional<Packet> getPacket(size_t packetIndex) const;
+
+  mutable std::mutex  packetsMutex;
+  std::vector<Packet> packets;
+  ReparseFunction     reparseFunction;
+
+  // The items of the packets that were expanded, the most recently used first
+  struct ExpandedPacket
+  {
+    size_t                    packetIndex{};
+    std::shared_ptr<TreeItem> item;
+  };
+  mutable std::list<ExpandedPacket> expandedPackets;
+  TreeItem                         *getExpandedPacketItem(size_t packetIndex) const;
+
   bool useColorCoding { true };
   bool showVideoOnly  { false };
 };
@@ -33,285 +33,335 @@
 
 #include "SubByteReader.h"
 
-#include <bitset>
 #include <cassert>
+#include <cstring>
 #include <stdexcept>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <stdlib.h>
+#endif
+
 namespace parser
 {
 
-SubByteReader::SubByteReader(const ByteVector &inArr, size_t inArrOffset)
-    : byteVector(inArr), posInBufferBytes(inArrOffset), initialPosInBuffer(inArrOffset){};
+namespace
+{
 
-std::tuple<uint64_t, std::string> SubByteReader::readBits(size_t nrBits)
+// Number of leading zero bits. The value must not be 0.
+unsigned countLeadingZeros(uint64_t value)
 {
-  uint64_t out        = 0;
-  auto     nrBitsRead = nrBits;
+  assert(value != 0);
+#if defined(__GNUC__)
+  return unsigned(__builtin_clzll(value));
+#elif defined(_MSC_VER) && defined(_M_X64)
+  unsigned long index;
+  _BitScanReverse64(&index, value);
+  return 63u - unsigned(index);
+#else
+  unsigned zeros = 0;
+  while ((value & (uint64_t(1) << 63)) == 0)
+  {
+    value <<= 1;
+    zeros++;
+  }
+  return zeros;
+#endif
+}
 
-  // The return unsigned int is of depth 64 bits
-  if (nrBits > 64)
-    throw std::logic_error("Trying to read more than 64 bits at once from the bitstream.");
-  if (nrBits == 0)
-    return {0, ""};
+// Convert 8 bytes that were copied from memory as they are to a value with the first byte in the
+// most significant bits
+uint64_t loadBigEndian(uint64_t value)
+{
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  return value;
+#elif defined(__GNUC__)
+  return __builtin_bswap64(value);
+#elif defined(_MSC_VER)
+  return _byteswap_uint64(value);
+#else
+  uint64_t      result = 0;
+  unsigned char bytes[8];
+  std::memcpy(bytes, &value, 8);
+  for (unsigned i = 0; i < 8; i++)
+    result = (result << 8) | bytes[i];
+  return result;
+#endif
+}
 
-  while (nrBits > 0)
+// Copy the data from the offset on and remove all emulation prevention bytes (0x000003 -> 0x0000).
+// Only the zero bytes are checked byte by byte. The runs of non zero data in between are found
+// with memchr and copied at once.
+void removeEmulationPrevention(const ByteVector &   input,
+                               size_t               offset,
+                               ByteVector &         rbspData,
+                               std::vector<size_t> &removedBytePositions)
+{
+  rbspData.clear();
+  removedBytePositions.clear();
+  if (offset >= input.size())
+    return;
+
+  rbspData.reserve(input.size() - offset);
+
+  const auto begin       = input.data();
+  const auto end         = begin + input.size();
+  auto       pos         = begin + offset;
+  unsigned   nrZeroBytes = 0;
+  while (pos < end)
   {
-    if (this->posInBufferBits == 8 && nrBits != 0)
+    if (nrZeroBytes == 2 && *pos == 3)
     {
-      // We read all bits we could from the current byte but we need more. Go to
-      // the next byte.
-      if (!this->gotoNextByte())
-        // We are at the end of the buffer but we need to read more. Error.
-        throw std::logic_error("Error while reading annexB file. Trying to "
-                               "read over buffer boundary.");
+      removedBytePositions.push_back(rbspData.size());
+      nrZeroBytes = 0;
+      pos++;
+      continue;
     }
 
-    // How many bits can be gotton from the current byte?
-    auto curBitsLeft = 8 - this->posInBufferBits;
-
-    size_t readBits; // Nr of bits to read
-    size_t offset;   // Offset for reading from the right
-    if (nrBits >= curBitsLeft)
+    if (*pos == 0)
     {
-      // Read "curBitsLeft" bits
-      readBits = curBitsLeft;
-      offset   = 0;
-    }
-    else
-    {
-      // Read "nrBits" bits
-      assert(nrBits < 8 && nrBits < curBitsLeft);
-      readBits = nrBits;
-      offset   = curBitsLeft - nrBits;
+      rbspData.push_back(0);
+      nrZeroBytes++;
+      pos++;
+      continue;
     }
 
-    // Shift output value so that the new bits fit
-    out = out << readBits;
+    // Copy everything up to the next zero byte at once
+    auto nextZero = static_cast<const unsigned char *>(std::memchr(pos, 0, size_t(end - pos)));
+    if (nextZero == nullptr)
+      nextZero = end;
+    rbspData.insert(rbspData.end(), pos, nextZero);
+    nrZeroBytes = 0;
+    pos         = nextZero;
+  }
+}
 
-    char c   = this->byteVector[this->posInBufferBytes];
-    c        = c >> offset;
-    int mask = ((1 << readBits) - 1);
+} // namespace
+
+SubByteReader::SubByteReader(const ByteVector &inArr, size_t inArrOffset)
+{
+  removeEmulationPrevention(inArr, inArrOffset, this->rbspData, this->removedBytePositions);
+}
 
-    // Write bits to output
-    out += (c & mask);
+uint64_t SubByteReader::peekBits64() const
+{
+  const auto bytePos   = this->posInRBSPBits / 8;
+  const auto bitOffset = this->posInRBSPBits % 8;
+  const auto size      = this->rbspData.size();
+  const auto data      = this->rbspData.data();
 
-    // Update counters
-    nrBits -= readBits;
-    this->posInBufferBits += readBits;
+  uint64_t window = 0;
+  if (bytePos + 8 <= size)
+  {
+    std::memcpy(&window, data + bytePos, 8);
+    window = loadBigEndian(window);
   }
-
-  std::string bitsRead;
-  assert(nrBitsRead > 0);
-  for (auto i = nrBitsRead; i > 0; i--)
+  else
   {
-    if (out & (uint64_t(1) << (i - 1)))
-      bitsRead.push_back('1');
-    else
-      bitsRead.push_back('0');
+    for (unsigned i = 0; i < 8; i++)
+      window = (window << 8) | (bytePos + i < size ? data[bytePos + i] : 0u);
   }
 
-  return {out, bitsRead};
+  if (bitOffset > 0)
+  {
+    window <<= bitOffset;
+    if (bytePos + 8 < size)
+      window |= uint64_t(data[bytePos + 8] >> (8 - bitOffset));
+  }
+  return window;
 }
 
-std::tuple<ByteVector, std::string> SubByteReader::readBytes(size_t nrBytes)
+size_t SubByteReader::nrBitsLeft() const
 {
-  if (this->posInBufferBits != 0 && this->posInBufferBits != 8)
-    throw std::logic_error("When reading bytes from the bitstream, it must be byte aligned.");
+  return this->rbspData.size() * 8 - this->posInRBSPBits;
+}
 
-  if (this->posInBufferBits == 8)
-    if (!this->gotoNextByte())
-      // We are at the end of the buffer but we need to read more. Error.
-      throw std::logic_error("Error while reading annexB file. Trying to read "
-                             "over buffer boundary.");
+uint64_t SubByteReader::readBits(size_t nrBits)
+{
+  // The return unsigned int is of depth 64 bits
+  if (nrBits > 64)
+    throw std::logic_error("Trying to read more than 64 bits at once from the bitstream.");
+  if (nrBits == 0)
+    return 0;
+  if (nrBits > this->nrBitsLeft())
+    throw std::logic_error("Error while reading annexB file. Trying to "
+                           "read over buffer boundary.");
 
-  ByteVector  retVector;
-  std::string code;
-  for (unsigned i = 0; i < nrBytes; i++)
-  {
-    auto c = this->byteVector[this->posInBufferBytes];
-    retVector.push_back(c);
-    code += std::bitset<8>(c).to_string();
+  const auto value = this->peekBits64() >> (64 - nrBits);
+  this->posInRBSPBits += nrBits;
+  return value;
+}
 
-    if (!this->gotoNextByte())
-    {
-      if (i < nrBytes - 1)
-        throw std::logic_error("Error while reading annexB file. Trying to "
-                               "read over buffer boundary.");
-    }
-  }
+ByteVector SubByteReader::readBytes(size_t nrBytes)
+{
+  if (!this->byte_aligned())
+    throw std::logic_error("When reading bytes from the bitstream, it must be byte aligned.");
+  if (nrBytes * 8 > this->nrBitsLeft())
+    throw std::logic_error("Error while reading annexB file. Trying to read "
+                           "over buffer boundary.");
 
-  return {retVector, code};
+  const auto begin = this->rbspData.begin() + this->posInRBSPBits / 8;
+  this->posInRBSPBits += nrBytes * 8;
+  return ByteVector(begin, begin + nrBytes);
 }
 
-std::tuple<uint64_t, std::string> SubByteReader::readUE_V()
+uint64_t SubByteReader::readUE_V()
 {
-  std::string coding;
+  const auto window = this->peekBits64();
+  if (window == 0)
   {
-    auto [firstBit, firstBitCoding] = this->readBits(1);
-    if (firstBit == 1)
-      return {0, firstBitCoding};
-    coding += firstBitCoding;
+    if (this->nrBitsLeft() < 64)
+      throw std::logic_error("Error while reading annexB file. Trying to "
+                             "read over buffer boundary.");
+    throw std::logic_error("Exp-Golomb code with more than 63 leading zeros.");
   }
 
   // Get the length of the golomb
-  unsigned golLength = 0;
-  while (true)
+  const auto golLength  = countLeadingZeros(window);
+  const auto codeLength = size_t(2 * golLength + 1);
+  if (codeLength > this->nrBitsLeft())
+    throw std::logic_error("Error while reading annexB file. Trying to "
+                           "read over buffer boundary.");
+
+  if (codeLength <= 64)
   {
-    auto [readBit, readCoding] = this->readBits(1);
-    coding += readCoding;
-    golLength++;
-    if (readBit == 1)
-      break;
+    // The entire code is in the window. Exponential part
+    this->posInRBSPBits += codeLength;
+    return (window >> (64 - codeLength)) - 1;
   }
 
-  auto [golBits, golCoding] = this->readBits(golLength);
-  coding += golCoding;
-  // Exponential part
-  auto val = golBits + (uint64_t(1) << golLength) - 1;
-
-  return {val, coding};
+  this->posInRBSPBits += golLength + 1;
+  const auto golBits = this->readBits(golLength);
+  return golBits + (uint64_t(1) << golLength) - 1;
 }
 
-std::tuple<int64_t, std::string> SubByteReader::readSE_V()
+int64_t SubByteReader::readSE_V()
 {
-  auto [val, coding] = this->readUE_V();
+  const auto val = this->readUE_V();
   if (val % 2 == 0)
-    return {-int64_t((val + 1) / 2), coding};
+    return -int64_t((val + 1) / 2);
   else
-    return {int64_t((val + 1) / 2), coding};
+    return int64_t((val + 1) / 2);
 }
 
-std::tuple<uint64_t, std::string> SubByteReader::readLEB128()
+uint64_t SubByteReader::readLEB128()
 {
   // We will read full bytes (up to 8)
   // The highest bit indicates if we need to read another bit. The rest of the
   // bits is added to the counter (shifted accordingly) See the AV1 reading
   // specification
-  uint64_t    value = 0;
-  std::string coding;
+  uint64_t value = 0;
   for (unsigned i = 0; i < 8; i++)
   {
-    auto [leb128_byte, leb128_byte_coding] = this->readBits(8);
-    coding += leb128_byte_coding;
+    const auto leb128_byte = this->readBits(8);
     value |= ((leb128_byte & 0x7f) << (i * 7));
     if (!(leb128_byte & 0x80))
       break;
   }
-  return {value, coding};
+  return value;
 }
 
-std::tuple<uint64_t, std::string> SubByteReader::readUVLC()
+uint64_t SubByteReader::readUVLC()
 {
-  auto        leadingZeros = 0u;
-  std::string coding;
+  const auto window = this->peekBits64();
+  if (window == 0 && this->nrBitsLeft() < 64)
+    throw std::logic_error("Error while reading annexB file. Trying to "
+                           "read over buffer boundary.");
 
-  while (1)
+  const auto leadingZeros = (window == 0) ? 64u : countLeadingZeros(window);
+  if (leadingZeros >= 32)
   {
-    auto [done, done_coding] = this->readBits(1);
-    coding += done_coding;
-    if (done > 0)
-      break;
-    leadingZeros++;
+    // Skip the zeros and the terminating one
+    if (leadingZeros + 1 > this->nrBitsLeft())
+      throw std::logic_error("Error while reading annexB file. Trying to "
+                             "read over buffer boundary.");
+    if (leadingZeros == 64)
+    {
+      this->posInRBSPBits += 64;
+      while (this->readBits(1) == 0)
+        ;
+    }
+    else
+      this->posInRBSPBits += leadingZeros + 1;
+    return ((uint64_t)1 << 32) - 1;
   }
 
-  if (leadingZeros >= 32)
-    return {((uint64_t)1 << 32) - 1, coding};
-  auto [value, value_coding] = this->readBits(leadingZeros);
-  coding += value_coding;
-
-  return {value + ((uint64_t)1 << leadingZeros) - 1, coding};
+  this->posInRBSPBits += leadingZeros + 1;
+  const auto value = this->readBits(leadingZeros);
+  return value + ((uint64_t)1 << leadingZeros) - 1;
 }
 
-std::tuple<uint64_t, std::string> SubByteReader::readNS(uint64_t maxVal)
+uint64_t SubByteReader::readNS(uint64_t maxVal)
 {
   if (maxVal == 0)
-    return {};
+    return 0;
 
   // FloorLog2
-  uint64_t floorVal;
-  {
-    auto     x = maxVal;
-    unsigned s = 0;
-    while (x != 0)
-    {
-      x = x >> 1;
-      s++;
-    }
-    floorVal = s - 1;
-  }
+  const uint64_t floorVal = 63u - countLeadingZeros(maxVal);
 
   auto w = floorVal + 1;
   auto m = (uint64_t(1) << w) - maxVal;
 
-  auto [v, coding] = this->readBits(w - 1);
+  auto v = this->readBits(w - 1);
   if (v < m)
-    return {v, coding};
+    return v;
 
-  auto [extra_bit, extra_bit_coding] = this->readBits(1);
-  return {(v << 1) - m + extra_bit, coding + extra_bit_coding};
+  auto extra_bit = this->readBits(1);
+  return (v << 1) - m + extra_bit;
 }
 
-std::tuple<int64_t, std::string> SubByteReader::readSU(unsigned nrBits)
+int64_t SubByteReader::readSU(unsigned nrBits)
 {
-  auto [value, coding] = readBits(nrBits);
-  int signMask         = 1 << (nrBits - 1);
+  auto value    = this->readBits(nrBits);
+  int  signMask = 1 << (nrBits - 1);
   if (value & signMask)
+    return int64_t(value) - 2 * signMask;
+  return int64_t(value);
+}
+
+std::string SubByteReader::getCodeSince(size_t startPosInRBSPBits) const
+{
+  assert(startPosInRBSPBits <= this->posInRBSPBits);
+
+  std::string code;
+  code.reserve(this->posInRBSPBits - startPosInRBSPBits);
+  for (auto pos = startPosInRBSPBits; pos < this->posInRBSPBits; pos++)
   {
-    auto subValue = int64_t(value) - 2 * signMask;
-    return {subValue, coding};
+    const auto byte = this->rbspData[pos / 8];
+    code.push_back((byte & (0x80 >> (pos % 8))) ? '1' : '0');
   }
-  return {int64_t(value), coding};
+  return code;
 }
 
 /* Is there more data? There is no more data if the next bit is the terminating
  * bit and all following bits are 0. */
 bool SubByteReader::more_rbsp_data() const
 {
-  auto posBytes            = this->posInBufferBytes;
-  auto posBits             = this->posInBufferBits;
-  auto terminatingBitFound = false;
-  if (posBits == 8)
-  {
-    posBytes++;
-    posBits = 0;
-  }
-  else if (posBits != 0)
-  {
-    // Check the remainder of the current byte
-    unsigned char c = this->byteVector[posBytes];
-    if (c & (1 << (7 - posBits)))
-      terminatingBitFound = true;
-    else
-      return true;
-    posBits++;
-    while (posBits != 8)
-    {
-      if (c & (1 << (7 - posBits)))
-        // Only zeroes should follow
-        return true;
-      posBits++;
-    }
-    posBytes++;
-  }
-  while (posBytes < (unsigned int)this->byteVector.size())
-  {
-    unsigned char c = this->byteVector[posBytes];
-    if (terminatingBitFound && c != 0)
-      return true;
-    else if (!terminatingBitFound && (c == 128))
-      terminatingBitFound = true;
-    else if (c != 0)
-      return true;
-    posBytes++;
-  }
-  if (!terminatingBitFound)
+  // Search the last bit that is set from the back
+  auto lastByte = this->rbspData.size();
+  while (lastByte > 0 && this->rbspData[lastByte - 1] == 0)
+    lastByte--;
+  if (lastByte == 0)
     return true;
-  return false;
+
+  const auto c                = this->rbspData[lastByte - 1];
+  auto       trailingZeroBits = 0u;
+  while ((c & (1 << trailingZeroBits)) == 0)
+    trailingZeroBits++;
+  const auto terminatingBitPos = lastByte * 8 - 1 - trailingZeroBits;
+
+  // Zero bytes in front of the terminating bit are skipped if we are byte aligned
+  auto pos = this->posInRBSPBits;
+  if (pos % 8 == 0)
+    while (pos / 8 < lastByte - 1 && this->rbspData[pos / 8] == 0)
+      pos += 8;
+
+  return pos != terminatingBitPos;
 }
 
 bool SubByteReader::byte_aligned() const
 {
-  return (this->posInBufferBits == 0 || this->posInBufferBits == 8);
+  return (this->posInRBSPBits % 8) == 0;
 }
 
 /* Is there more data? If the current position in the sei_payload() syntax
@@ -329,90 +379,94 @@ bool SubByteReader::payload_extension_present() const
 
 bool SubByteReader::canReadBits(unsigned nrBits) const
 {
-  if (this->posInBufferBytes == this->byteVector.size())
+  if (this->nrBitsLeft() == 0)
     return false;
+  return nrBits <= this->nrBitsLeft();
+}
 
-  assert(this->posInBufferBits <= 8);
-  const auto curBitsLeft = 8 - this->posInBufferBits;
-  assert(this->byteVector.size() > this->posInBufferBytes);
-  const auto entireBytesLeft  = this->byteVector.size() - this->posInBufferBytes - 1;
-  const auto nrBitsLeftToRead = curBitsLeft + entireBytesLeft * 8;
+size_t SubByteReader::posInInputBytes(size_t *bitsInCurrentByte) const
+{
+  // A byte that was read completely is still the current byte (with 8 bits read). Emulation
+  // prevention bytes are counted once the byte behind them is reached.
+  auto bytePos = this->posInRBSPBits / 8;
+  auto bitPos  = this->posInRBSPBits % 8;
+  if (bitPos == 0 && bytePos > 0)
+  {
+    bytePos--;
+    bitPos = 8;
+  }
 
-  return nrBits <= nrBitsLeftToRead;
+  const auto nrRemovedBefore = std::upper_bound(this->removedBytePositions.begin(),
+                                                this->removedBytePositions.end(),
+                                                bytePos) -
+                               this->removedBytePositions.begin();
+  if (bitsInCurrentByte != nullptr)
+    *bitsInCurrentByte = bitPos;
+  return bytePos + size_t(nrRemovedBefore);
 }
 
 size_t SubByteReader::nrBitsRead() const
 {
-  return (this->posInBufferBytes - this->initialPosInBuffer) * 8 + this->posInBufferBits;
+  size_t     bitsInCurrentByte;
+  const auto bytePos = this->posInInputBytes(&bitsInCurrentByte);
+  return bytePos * 8 + bitsInCurrentByte;
 }
 
 size_t SubByteReader::nrBytesRead() const
 {
-  return this->posInBufferBytes - this->initialPosInBuffer + (this->posInBufferBits != 0 ? 1 : 0);
+  size_t     bitsInCurrentByte;
+  const auto bytePos = this->posInInputBytes(&bitsInCurrentByte);
+  return bytePos + (bitsInCurrentByte != 0 ? 1 : 0);
 }
 
 size_t SubByteReader::nrBytesLeft() const
 {
-  if (this->byteVector.size() <= this->posInBufferBytes)
+  const auto inputSize = this->rbspData.size() + this->removedBytePositions.size();
+  const auto bytePos   = this->posInInputBytes(nullptr);
+  if (inputSize <= bytePos)
     return 0;
-  return this->byteVector.size() - this->posInBufferBytes - 1;
+  return inputSize - bytePos - 1;
 }
 
 ByteVector SubByteReader::peekBytes(unsigned nrBytes) const
 {
-  if (this->posInBufferBits != 0 && this->posInBufferBits != 8)
+  if (!this->byte_aligned())
     throw std::logic_error("When peeking bytes from the bitstream, it must be byte aligned.");
 
-  auto pos = this->posInBufferBytes;
-  if (this->posInBufferBits == 8)
-    pos++;
-
-  if (pos + nrBytes > this->byteVector.size())
+  const auto pos = this->posInRBSPBits / 8;
+  if (pos + nrBytes > this->rbspData.size())
     throw std::logic_error("Not enough data in the input to peek that far");
 
-  return ByteVector(this->byteVector.begin() + pos, this->byteVector.begin() + pos + nrBytes);
+  return ByteVector(this->rbspData.begin() + pos, this->rbspData.begin() + pos + nrBytes);
 }
 
-bool SubByteReader::gotoNextByte()
+void SubByteReader::disableEmulationPrevention()
 {
-  // Before we go to the neyt byte, check if the last (current) byte is a zero
-  // byte.
-  if (this->posInBufferBytes >= unsigned(this->byteVector.size()))
-    throw std::out_of_range("Reading out of bounds");
-  if (this->byteVector[this->posInBufferBytes] == (char)0)
-    this->numEmuPrevZeroBytes++;
-
-  // Skip the remaining sub-byte-bits
-  this->posInBufferBits = 0;
-  // Advance pointer
-  this->posInBufferBytes++;
-
-  if (this->posInBufferBytes >= (unsigned int)this->byteVector.size())
-    // The next byte is outside of the current buffer. Error.
-    return false;
-
-  if (this->skipEmulationPrevention)
+  if (this->removedBytePositions.empty())
+    return;
+
+  // Insert the removed bytes again (they are always 3) and move the position accordingly
+  const auto curBytePos = this->posInRBSPBits / 8;
+  ByteVector input;
+  input.reserve(this->rbspData.size() + this->removedBytePositions.size());
+  auto   removed        = this->removedBytePositions.begin();
+  size_t insertedBefore = 0;
+  for (size_t i = 0; i <= this->rbspData.size(); i++)
   {
-    if (this->numEmuPrevZeroBytes == 2 && this->byteVector[this->posInBufferBytes] == (char)3)
+    while (removed != this->removedBytePositions.end() && *removed == i)
     {
-      // The current byte is an emulation prevention 3 byte. Skip it.
-      this->posInBufferBytes++; // Skip byte
-
-      if (this->posInBufferBytes >= (unsigned int)this->byteVector.size())
-      {
-        // The next byte is outside of the current buffer. Error
-        return false;
-      }
-
-      // Reset counter
-      this->numEmuPrevZeroBytes = 0;
+      input.push_back(3);
+      if (i <= curBytePos)
+        insertedBefore++;
+      removed++;
     }
-    else if (this->byteVector[this->posInBufferBytes] != (char)0)
-      // No zero byte. No emulation prevention 3 byte
-      this->numEmuPrevZeroBytes = 0;
+    if (i < this->rbspData.size())
+      input.push_back(this->rbspData[i]);
   }
 
-  return true;
+  this->rbspData = std::move(input);
+  this->posInRBSPBits += insertedBefore * 8;
+  this->removedBytePositions.clear();
 }
 
-} // namespace parser
\ No newline at end of file
+} // namespace parser
@@ -35,6 +35,7 @@
 #include <algorithm>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include <common/Typedef.h>
 
@@ -44,6 +45,11 @@ namespace parser
 /* This class provides the ability to read a byte array bit wise. Reading of ue(v) symbols is also
  * supported. This class can "read out" the emulation prevention bytes. This is enabled by default
  * but can be disabled if needed.
+ *
+ * The emulation prevention bytes are removed in one pass when the reader is created so that the
+ * reading functions can work on the plain RBSP data. Bits are read through a 64 bit window and the
+ * reading functions only return values. The code string (the read bits as '0'/'1') can be
+ * obtained afterwards using getCodeSince() if it is needed for logging.
  */
 class SubByteReader
 {
@@ -57,37 +63,46 @@ public:
   [[nodiscard]] bool payload_extension_present() const;
   [[nodiscard]] bool canReadBits(unsigned nrBits) const;
 
+  // These positions are counted in the input data (including emulation prevention bytes)
   [[nodiscard]] size_t nrBitsRead() const;
   [[nodiscard]] size_t nrBytesRead() const;
   [[nodiscard]] size_t nrBytesLeft() const;
 
   [[nodiscard]] ByteVector peekBytes(unsigned nrBytes) const;
 
-  void disableEmulationPrevention() { skipEmulationPrevention = false; }
+  // Put the removed emulation prevention bytes back so that all following data is read as is.
+  void disableEmulationPrevention();
 
 protected:
-  std::tuple<uint64_t, std::string>   readBits(size_t nrBits);
-  std::tuple<ByteVector, std::string> readBytes(size_t nrBytes);
-
-  std::tuple<uint64_t, std::string> readUE_V();
-  std::tuple<int64_t, std::string>  readSE_V();
-  std::tuple<uint64_t, std::string> readLEB128();
-  std::tuple<uint64_t, std::string> readUVLC();
-  std::tuple<uint64_t, std::string> readNS(uint64_t maxVal);
-  std::tuple<int64_t, std::string>  readSU(unsigned nrBits);
-
-  ByteVector byteVector;
-
-  bool skipEmulationPrevention{true};
-
-  // Move to the next byte and look for an emulation prevention 3 byte. Remove it (skip it) if
-  // found. This function is just used by the internal reading functions.
-  bool gotoNextByte();
-
-  size_t posInBufferBytes{0};    // The byte position in the buffer
-  size_t posInBufferBits{0};     // The sub byte (bit) position in the buffer (0...7)
-  size_t numEmuPrevZeroBytes{0}; // The number of emulation prevention three bytes that were found
-  size_t initialPosInBuffer{0};  // The position that was given when creating the sub reader
+  uint64_t   readBits(size_t nrBits);
+  ByteVector readBytes(size_t nrBytes);
+
+  uint64_t readUE_V();
+  int64_t  readSE_V();
+  uint64_t readLEB128();
+  uint64_t readUVLC();
+  uint64_t readNS(uint64_t maxVal);
+  int64_t  readSU(unsigned nrBits);
+
+  // The bit position in the RBSP data and the bits read since then as a string of '0' and '1'
+  [[nodiscard]] size_t      getPosInRBSPBits() const { return this->posInRBSPBits; }
+  [[nodiscard]] std::string getCodeSince(size_t startPosInRBSPBits) const;
+
+private:
+  // Get the next 64 bits from the current position (MSB first). Bits behind the end of the data
+  // are 0.
+  [[nodiscard]] uint64_t peekBits64() const;
+  [[nodiscard]] size_t   nrBitsLeft() const;
+  // The position of the current byte in the input data (in the same way as it was counted before
+  // the emulation prevention bytes were removed up front).
+  [[nodiscard]] size_t posInInputBytes(size_t *bitsInCurrentByte) const;
+
+  ByteVector rbspData;
+  size_t     posInRBSPBits{0};
+
+  // For every removed emulation prevention byte the position in rbspData where it was removed. The
+  // list is sorted. It is used to count positions in the original input data.
+  std::vector<size_t> removedBytePositions;
 };
 
-} // namespace parser
\ No newline at end of file
+} // namespace parser
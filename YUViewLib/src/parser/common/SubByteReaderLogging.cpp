@@ -50,42 +50,38 @@ template <typename T> std::string formatCoding(const std::string formatName, T v
   return stringStream.str();
 }
 
-void checkAndLog(std::shared_ptr<TreeItem> item,
-                 const std::string &       formatName,
-                 const std::string &       symbolName,
-                 const Options &           options,
-                 int64_t                   value,
-                 const std::string &       code)
-{
-  CheckResult checkResult;
-  for (auto &check : options.checkList)
-  {
-    checkResult = check->checkValue(value);
-    if (!checkResult)
-      break;
-  }
+void checkAndLog(const std::shared_ptr<TreeItem> &item,
+                 std::string_view                 formatName,
+                 std::string_view                 symbolName,
+                 const Options &                  options,
+                 int64_t                          value,
+                 const std::string &              code)
+{
+  const auto checkResult = options.runChecks(value);
 
   if (item && !options.loggingDisabled)
   {
-    std::string meaning = options.meaningString;
-    if (options.meaningMap.count(int64_t(value)) > 0)
-      meaning = options.meaningMap.at(value);
+    auto meaning = options.getMeaning(value);
 
     const bool isError = !checkResult;
     if (isError)
       meaning += " " + checkResult.errorMessage;
-    item->createChildItem(
-        symbolName, value, formatCoding(formatName, code.size()), code, meaning, isError);
+    item->createChildItem(std::string(symbolName),
+                          value,
+                          formatCoding(std::string(formatName), code.size()),
+                          code,
+                          meaning,
+                          isError);
   }
   if (!checkResult && checkResult.checkLevel == CheckLevel::Error)
     throw std::logic_error(checkResult.errorMessage);
 }
 
-void checkAndLog(std::shared_ptr<TreeItem> item,
-                 const std::string &       byteName,
-                 const Options &           options,
-                 ByteVector                value,
-                 const std::string &       code)
+void checkAndLog(const std::shared_ptr<TreeItem> &item,
+                 std::string_view                 byteName,
+                 const Options &                  options,
+                 const ByteVector &               value,
+                 const std::string &              code)
 {
   // There are no range checks for ByteVectors. Also the meaningMap does nothing.
   if (item && !options.loggingDisabled)
@@ -93,6 +89,7 @@ void checkAndLog(std::shared_ptr<TreeItem> item,
     if (code.size() != value.size() * 8)
       throw std::logic_error("Nr bytes and size of code does not match.");
 
+    const auto meaning = options.getMeaning(-1);
     for (size_t i = 0; i < value.size(); i++)
     {
       auto              c = value.at(i);
@@ -100,15 +97,24 @@ void checkAndLog(std::shared_ptr<TreeItem> item,
       valueStream << "0x" << std::setfill('0') << std::setw(2) << std::hex << unsigned(c) << " ("
                   << c << ")";
       auto byteCode = code.substr(i * 8, 8);
-      item->createChildItem(byteName + (value.size() > 1 ? "[" + std::to_string(i) + "]" : ""),
+      item->createChildItem(std::string(byteName) +
+                                (value.size() > 1 ? "[" + std::to_string(i) + "]" : ""),
                             valueStream.str(),
                             formatCoding("u(8)", code.size()),
                             byteCode,
-                            options.meaningString);
+                            meaning);
     }
   }
 }
 
+std::string formatArrayName(std::string_view symbolName, std::initializer_list<unsigned> indices)
+{
+  std::string name(symbolName);
+  for (const auto index : indices)
+    name += "[" + std::to_string(index) + "]";
+  return name;
+}
+
 } // namespace
 
 ByteVector SubByteReaderLogging::convertToByteVector(QByteArray data)
@@ -160,21 +166,34 @@ SubByteReaderLogging::SubByteReaderLogging(const ByteVector &        inArr,
   }
 }
 
-void SubByteReaderLogging::addLogSubLevel(const std::string &name)
+bool SubByteReaderLogging::isLogged(const Options &options) const
+{
+  return this->currentTreeLevel && !options.loggingDisabled;
+}
+
+std::string SubByteReaderLogging::getCode(size_t startPosInRBSPBits, const Options &options) const
+{
+  // Building the code strings is only needed if the symbol is actually logged
+  if (!this->isLogged(options))
+    return {};
+  return this->getCodeSince(startPosInRBSPBits);
+}
+
+void SubByteReaderLogging::addLogSubLevel(std::string_view name)
 {
   if (!this->currentTreeLevel)
     return;
   assert(!name.empty());
   this->itemHierarchy.push(this->currentTreeLevel);
-  this->currentTreeLevel = this->itemHierarchy.top()->createChildItem(name);
+  this->currentTreeLevel = this->itemHierarchy.top()->createChildItem(std::string(name));
 }
 
-void SubByteReaderLogging::updateCurrentLevelName(const std::string &name)
+void SubByteReaderLogging::updateCurrentLevelName(std::string_view name)
 {
   if (!this->currentTreeLevel)
     return;
   assert(!name.empty());
-  this->currentTreeLevel->setName(name);
+  this->currentTreeLevel->setName(std::string(name));
 }
 
 void SubByteReaderLogging::removeLogSubLevel()
@@ -185,118 +204,136 @@ void SubByteReaderLogging::removeLogSubLevel()
   this->itemHierarchy.pop();
 }
 
-uint64_t SubByteReaderLogging::readBits(const std::string &symbolName,
-                                        size_t             numBits,
-                                        const Options &    options)
+uint64_t SubByteReaderLogging::readBits(std::string_view symbolName,
+                                        size_t           numBits,
+                                        const Options &  options)
 {
   try
   {
-    auto [value, code] = SubByteReader::readBits(numBits);
+    const auto startPos = this->getPosInRBSPBits();
+    const auto value    = SubByteReader::readBits(numBits);
+    const auto code     = this->getCode(startPos, options);
     checkAndLog(this->currentTreeLevel, "u(v)", symbolName, options, value, code);
     return value;
   }
   catch (const std::exception &ex)
   {
-    this->logExceptionAndThrowError(ex, std::to_string(numBits) + " bit symbol " + symbolName);
+    this->logExceptionAndThrowError(ex,
+                                    std::to_string(numBits) + " bit symbol " +
+                                        std::string(symbolName));
   }
 }
 
-bool SubByteReaderLogging::readFlag(const std::string &symbolName, const Options &options)
+bool SubByteReaderLogging::readFlag(std::string_view symbolName, const Options &options)
 {
   try
   {
-    auto [value, code] = SubByteReader::readBits(1);
+    const auto startPos = this->getPosInRBSPBits();
+    const auto value    = SubByteReader::readBits(1);
+    const auto code     = this->getCode(startPos, options);
     checkAndLog(this->currentTreeLevel, "u(1)", symbolName, options, value, code);
     return (value != 0);
   }
   catch (const std::exception &ex)
   {
-    this->logExceptionAndThrowError(ex, "flag " + symbolName);
+    this->logExceptionAndThrowError(ex, "flag " + std::string(symbolName));
   }
 }
 
-uint64_t SubByteReaderLogging::readUEV(const std::string &symbolName, const Options &options)
+uint64_t SubByteReaderLogging::readUEV(std::string_view symbolName, const Options &options)
 {
   try
   {
-    auto [value, code] = SubByteReader::readUE_V();
+    const auto startPos = this->getPosInRBSPBits();
+    const auto value    = SubByteReader::readUE_V();
+    const auto code     = this->getCode(startPos, options);
     checkAndLog(this->currentTreeLevel, "ue(v)", symbolName, options, value, code);
     return value;
   }
   catch (const std::exception &ex)
   {
-    this->logExceptionAndThrowError(ex, "UEV symbol " + symbolName);
+    this->logExceptionAndThrowError(ex, "UEV symbol " + std::string(symbolName));
   }
 }
 
-int64_t SubByteReaderLogging::readSEV(const std::string &symbolName, const Options &options)
+int64_t SubByteReaderLogging::readSEV(std::string_view symbolName, const Options &options)
 {
   try
   {
-    auto [value, code] = SubByteReader::readSE_V();
+    const auto startPos = this->getPosInRBSPBits();
+    const auto value    = SubByteReader::readSE_V();
+    const auto code     = this->getCode(startPos, options);
     checkAndLog(this->currentTreeLevel, "se(v)", symbolName, options, value, code);
     return value;
   }
   catch (const std::exception &ex)
   {
-    this->logExceptionAndThrowError(ex, "SEV symbol " + symbolName);
+    this->logExceptionAndThrowError(ex, "SEV symbol " + std::string(symbolName));
   }
 }
 
-uint64_t SubByteReaderLogging::readLEB128(const std::string &symbolName, const Options &options)
+uint64_t SubByteReaderLogging::readLEB128(std::string_view symbolName, const Options &options)
 {
   try
   {
-    auto [value, code] = SubByteReader::readLEB128();
+    const auto startPos = this->getPosInRBSPBits();
+    const auto value    = SubByteReader::readLEB128();
+    const auto code     = this->getCode(startPos, options);
     checkAndLog(this->currentTreeLevel, "leb128(v)", symbolName, options, value, code);
     return value;
   }
   catch (const std::exception &ex)
   {
-    this->logExceptionAndThrowError(ex, "LEB128 symbol " + symbolName);
+    this->logExceptionAndThrowError(ex, "LEB128 symbol " + std::string(symbolName));
   }
 }
 
 uint64_t
-SubByteReaderLogging::readNS(const std::string &symbolName, uint64_t maxVal, const Options &options)
+SubByteReaderLogging::readNS(std::string_view symbolName, uint64_t maxVal, const Options &options)
 {
   try
   {
-    auto [value, code] = SubByteReader::readNS(maxVal);
+    const auto startPos = this->getPosInRBSPBits();
+    const auto value    = SubByteReader::readNS(maxVal);
+    const auto code     = this->getCode(startPos, options);
     checkAndLog(this->currentTreeLevel, "ns(n)", symbolName, options, value, code);
     return value;
   }
   catch (const std::exception &ex)
   {
-    this->logExceptionAndThrowError(ex, "ns symbol " + symbolName);
+    this->logExceptionAndThrowError(ex, "ns symbol " + std::string(symbolName));
   }
 }
 
 int64_t
-SubByteReaderLogging::readSU(const std::string &symbolName, unsigned nrBits, const Options &options)
+SubByteReaderLogging::readSU(std::string_view symbolName, unsigned nrBits, const Options &options)
 {
   try
   {
-    auto [value, code] = SubByteReader::readSU(nrBits);
+    const auto startPos = this->getPosInRBSPBits();
+    const auto value    = SubByteReader::readSU(nrBits);
+    const auto code     = this->getCode(startPos, options);
     checkAndLog(this->currentTreeLevel, "su(n)", symbolName, options, value, code);
     return value;
   }
   catch (const std::exception &ex)
   {
-    this->logExceptionAndThrowError(ex, "su symbol " + symbolName);
+    this->logExceptionAndThrowError(ex, "su symbol " + std::string(symbolName));
   }
 }
 
-ByteVector SubByteReaderLogging::readBytes(const std::string &symbolName,
-                                           size_t             nrBytes,
-                                           const Options &    options)
+ByteVector SubByteReaderLogging::readBytes(std::string_view symbolName,
+                                           size_t           nrBytes,
+                                           const Options &  options)
 {
   try
   {
     if (!this->byte_aligned())
       throw std::logic_error("Trying to read bytes while not byte aligned.");
 
-    auto [value, code] = SubByteReader::readBytes(nrBytes);
+    const auto startPos = this->getPosInRBSPBits();
+    const auto value    = SubByteReader::readBytes(nrBytes);
+    const auto code     = this->getCode(startPos, options);
     checkAndLog(this->currentTreeLevel, symbolName, options, value, code);
     return value;
   }
@@ -306,13 +343,61 @@ ByteVector SubByteReaderLogging::readBytes(const std::string &symbolName,
   }
 }
 
-void SubByteReaderLogging::logCalculatedValue(const std::string &symbolName,
-                                              int64_t            value,
-                                              const Options &    options)
+void SubByteReaderLogging::logCalculatedValue(std::string_view symbolName,
+                                              int64_t          value,
+                                              const Options &  options)
 {
   checkAndLog(this->currentTreeLevel, "Calc", symbolName, options, value, "");
 }
 
+uint64_t SubByteReaderLogging::readBits(std::string_view                symbolName,
+                                        std::initializer_list<unsigned> indices,
+                                        size_t                          numBits,
+                                        const Options                  &options)
+{
+  if (!this->isLogged(options))
+    return this->readBits(symbolName, numBits, options);
+  return this->readBits(formatArrayName(symbolName, indices), numBits, options);
+}
+
+bool SubByteReaderLogging::readFlag(std::string_view                symbolName,
+                                    std::initializer_list<unsigned> indices,
+                                    const Options                  &options)
+{
+  if (!this->isLogged(options))
+    return this->readFlag(symbolName, options);
+  return this->readFlag(formatArrayName(symbolName, indices), options);
+}
+
+uint64_t SubByteReaderLogging::readUEV(std::string_view                symbolName,
+                                       std::initializer_list<unsigned> indices,
+                                       const Options                  &options)
+{
+  if (!this->isLogged(options))
+    return this->readUEV(symbolName, options);
+  return this->readUEV(formatArrayName(symbolName, indices), options);
+}
+
+int64_t SubByteReaderLogging::readSEV(std::string_view                symbolName,
+                                      std::initializer_list<unsigned> indices,
+                                      const Options                  &options)
+{
+  if (!this->isLogged(options))
+    return this->readSEV(symbolName, options);
+  return this->readSEV(formatArrayName(symbolName, indices), options);
+}
+
+void SubByteReaderLogging::logCalculatedValue(std::string_view                symbolName,
+                                              std::initializer_list<unsigned> indices,
+                                              int64_t                         value,
+                                              const Options                  &options)
+{
+  if (!this->isLogged(options))
+    this->logCalculatedValue(symbolName, value, options);
+  else
+    this->logCalculatedValue(formatArrayName(symbolName, indices), value, options);
+}
+
 void SubByteReaderLogging::logArbitrary(const std::string &symbolName,
                                         const std::string &value,
                                         const std::string &coding,
@@ -347,19 +432,28 @@ void SubByteReaderLogging::logExceptionAndThrowError(const std::exception &ex,
 }
 
 SubByteReaderLoggingSubLevel::SubByteReaderLoggingSubLevel(SubByteReaderLogging &reader,
-                                                           std::string           name)
+                                                           std::string_view      name)
 {
   reader.addLogSubLevel(name);
   this->r = &reader;
 }
 
+SubByteReaderLoggingSubLevel::SubByteReaderLoggingSubLevel(SubByteReaderLogging           &reader,
+                                                           std::string_view                name,
+                                                           std::initializer_list<unsigned> indices)
+{
+  if (reader.currentTreeLevel)
+    reader.addLogSubLevel(formatArrayName(name, indices));
+  this->r = &reader;
+}
+
 SubByteReaderLoggingSubLevel::~SubByteReaderLoggingSubLevel()
 {
   if (this->r != nullptr)
     this->r->removeLogSubLevel();
 }
 
-void SubByteReaderLoggingSubLevel::updateSubLevelName(const std::string &name)
+void SubByteReaderLoggingSubLevel::updateSubLevelName(std::string_view name)
 {
   if (this->r != nullptr)
     this->r->updateCurrentLevelName(name);
@@ -38,9 +38,12 @@
 #include "SubByteReaderLoggingOptions.h"
 #include "TreeItem.h"
 
+#include <initializer_list>
 #include <map>
 #include <optional>
 #include <stack>
+#include <string_view>
+#include <vector>
 
 namespace parser::reader
 {
@@ -50,7 +53,9 @@ typedef std::string (*meaning_callback_function)(unsigned int);
 class SubByteReaderLoggingSubLevel;
 
 // This is a wrapper around the sub_byte_reader that adds the functionality to log the read symbold
-// to TreeItems
+// to TreeItems. If no TreeItem is given (e.g. when opening a file, seeking or building the frame
+// index), nothing is logged and reading a symbol does not allocate anything. The symbol names are
+// only turned into strings, and the meanings and codes are only resolved, when they are logged.
 class SubByteReaderLogging : public SubByteReader
 {
 public:
@@ -68,18 +73,45 @@ public:
   static ByteVector convertToByteVector(QByteArray data);
   static QByteArray convertToQByteArray(ByteVector data);
 
-  uint64_t readBits(const std::string &symbolName, size_t numBits, const Options &options = {});
-  bool     readFlag(const std::string &symbolName, const Options &options = {});
-  uint64_t readUEV(const std::string &symbolName, const Options &options = {});
-  int64_t  readSEV(const std::string &symbolName, const Options &options = {});
-  uint64_t readLEB128(const std::string &symbolName, const Options &options = {});
-  uint64_t readNS(const std::string &symbolName, uint64_t maxVal, const Options &options = {});
-  int64_t  readSU(const std::string &symbolName, unsigned nrBits, const Options &options = {});
-
-  ByteVector readBytes(const std::string &symbolName, size_t nrBytes, const Options &options = {});
-
-  void
-  logCalculatedValue(const std::string &symbolName, int64_t value, const Options &options = {});
+  uint64_t
+  readBits(std::string_view symbolName, size_t numBits, const Options &options = NO_OPTIONS);
+  bool     readFlag(std::string_view symbolName, const Options &options = NO_OPTIONS);
+  uint64_t readUEV(std::string_view symbolName, const Options &options = NO_OPTIONS);
+  int64_t  readSEV(std::string_view symbolName, const Options &options = NO_OPTIONS);
+  uint64_t readLEB128(std::string_view symbolName, const Options &options = NO_OPTIONS);
+  uint64_t
+  readNS(std::string_view symbolName, uint64_t maxVal, const Options &options = NO_OPTIONS);
+  int64_t
+  readSU(std::string_view symbolName, unsigned nrBits, const Options &options = NO_OPTIONS);
+
+  ByteVector
+  readBytes(std::string_view symbolName, size_t nrBytes, const Options &options = NO_OPTIONS);
+
+  void logCalculatedValue(std::string_view symbolName,
+                          int64_t          value,
+                          const Options   &options = NO_OPTIONS);
+
+  // Read a symbol that is an element of an array (e.g. readFlag("cbr_flag", {i}) for cbr_flag[i]).
+  // The name with the indices is only formatted if the symbol is logged. These are for the arrays
+  // in the parameter sets and slice headers, where formatting the names for every element was a
+  // large part of the parsing time without logging.
+  uint64_t readBits(std::string_view                symbolName,
+                    std::initializer_list<unsigned> indices,
+                    size_t                          numBits,
+                    const Options                  &options = NO_OPTIONS);
+  bool     readFlag(std::string_view                symbolName,
+                    std::initializer_list<unsigned> indices,
+                    const Options                  &options = NO_OPTIONS);
+  uint64_t readUEV(std::string_view                symbolName,
+                   std::initializer_list<unsigned> indices,
+                   const Options                  &options = NO_OPTIONS);
+  int64_t  readSEV(std::string_view                symbolName,
+                   std::initializer_list<unsigned> indices,
+                   const Options                  &options = NO_OPTIONS);
+  void     logCalculatedValue(std::string_view                symbolName,
+                              std::initializer_list<unsigned> indices,
+                              int64_t                         value,
+                              const Options                  &options = NO_OPTIONS);
   void logArbitrary(const std::string &symbolName,
                     const std::string &value   = {},
                     const std::string &coding  = {},
@@ -93,15 +125,19 @@ public:
 
 private:
   friend class SubByteReaderLoggingSubLevel;
-  void addLogSubLevel(const std::string &name);
-  void updateCurrentLevelName(const std::string &name);
+  void addLogSubLevel(std::string_view name);
+  void updateCurrentLevelName(std::string_view name);
   void removeLogSubLevel();
 
+  [[nodiscard]] bool        isLogged(const Options &options) const;
+  [[nodiscard]] std::string getCode(size_t startPosInRBSPBits, const Options &options) const;
+
   void logExceptionAndThrowError [[noreturn]] (const std::exception &ex, const std::string &when);
 
-  std::stack<std::shared_ptr<TreeItem>> itemHierarchy;
-  std::shared_ptr<TreeItem>             currentTreeLevel{};
-  std::shared_ptr<TreeItem>             stashedTreeItem{};
+  // A vector (unlike the default deque) does not allocate anything until something is logged
+  std::stack<std::shared_ptr<TreeItem>, std::vector<std::shared_ptr<TreeItem>>> itemHierarchy;
+  std::shared_ptr<TreeItem>                                                     currentTreeLevel{};
+  std::shared_ptr<TreeItem>                                                     stashedTreeItem{};
 };
 
 // A simple wrapper for SubByteReaderLogging->addLogSubLevel /
@@ -110,10 +146,15 @@ class SubByteReaderLoggingSubLevel
 {
 public:
   SubByteReaderLoggingSubLevel() = default;
-  SubByteReaderLoggingSubLevel(SubByteReaderLogging &reader, std::string name);
+  SubByteReaderLoggingSubLevel(SubByteReaderLogging &reader, std::string_view name);
+  // The name of the sub level is the name with the indices (e.g. "ref_pic_list_struct[0][1]"). It
+  // is only formatted if something is logged.
+  SubByteReaderLoggingSubLevel(SubByteReaderLogging           &reader,
+                               std::string_view                name,
+                               std::initializer_list<unsigned> indices);
   ~SubByteReaderLoggingSubLevel();
 
-  void updateSubLevelName(const std::string &name);
+  void updateSubLevelName(std::string_view name);
 
 private:
   SubByteReaderLogging *r{};
@@ -32,149 +32,89 @@
 
 #include "SubByteReaderLoggingOptions.h"
 
+#include <stdexcept>
+
 namespace parser::reader
 {
 
 namespace
 {
 
-struct CheckEqualTo : Check
-{
-public:
-  CheckEqualTo() = delete;
-  CheckEqualTo(int64_t value, std::string errorIfFail, CheckLevel checkLevel)
-      : Check(errorIfFail, checkLevel), value(value)
-  {
-  }
-  CheckResult checkValue(int64_t value) const override;
-
-private:
-  int64_t value;
-};
-
-struct CheckGreater : Check
+std::string inclusiveText(bool inclusive)
 {
-public:
-  CheckGreater() = delete;
-  CheckGreater(int64_t value, bool inclusive, std::string errorIfFail, CheckLevel checkLevel)
-      : Check(errorIfFail, checkLevel), value(value), inclusive(inclusive)
-  {
-  }
-  CheckResult checkValue(int64_t value) const override;
-
-private:
-  int64_t value;
-  bool    inclusive;
-};
-
-struct CheckSmaller : Check
-{
-public:
-  CheckSmaller() = delete;
-  CheckSmaller(int64_t value, bool inclusive, std::string errorIfFail, CheckLevel checkLevel)
-      : Check(errorIfFail, checkLevel), value(value), inclusive(inclusive)
-  {
-  }
-  CheckResult checkValue(int64_t value) const override;
-
-private:
-  int64_t value;
-  bool    inclusive;
-};
-
-struct CheckRange : Check
-{
-public:
-  CheckRange() = delete;
-  CheckRange(Range<int64_t> range, bool inclusive, std::string errorIfFail, CheckLevel checkLevel)
-      : Check(errorIfFail, checkLevel), range(range), inclusive(inclusive)
-  {
-  }
-  CheckResult checkValue(int64_t value) const override;
-
-private:
-  Range<int64_t> range;
-  bool           inclusive;
-};
+  return inclusive ? " inclusive." : " exclusive.";
+}
 
 } // namespace
 
-CheckResult CheckEqualTo::checkValue(int64_t value) const
+CheckResult Check::checkValue(int64_t value) const
 {
-  if (value != this->value)
+  bool        checkFailed = false;
+  std::string defaultError;
+  switch (this->type)
   {
-    if (!this->errorIfFail.empty())
-      return CheckResult({this->errorIfFail, this->checkLevel});
-    return CheckResult(
-        {"Value should be equal to " + std::to_string(this->value), this->checkLevel});
+  case Type::EqualTo:
+    checkFailed = (value != this->range.min);
+    if (checkFailed)
+      defaultError = "Value should be equal to " + std::to_string(this->range.min);
+    break;
+  case Type::Greater:
+    checkFailed = (this->inclusive && value < this->range.min) ||
+                  (!this->inclusive && value <= this->range.min);
+    if (checkFailed)
+      defaultError = "Value should be greater then " + std::to_string(this->range.min) +
+                     inclusiveText(this->inclusive);
+    break;
+  case Type::Smaller:
+    checkFailed = (this->inclusive && value > this->range.min) ||
+                  (!this->inclusive && value >= this->range.min);
+    if (checkFailed)
+      defaultError = "Value should be smaller then " + std::to_string(this->range.min) +
+                     inclusiveText(this->inclusive);
+    break;
+  case Type::Range:
+    checkFailed = (this->inclusive && (value < this->range.min || value > this->range.max)) ||
+                  (!this->inclusive && (value <= this->range.min || value >= this->range.max));
+    if (checkFailed)
+      defaultError = "Value should be in the range of " + std::to_string(this->range.min) +
+                     " to " + std::to_string(this->range.max) + inclusiveText(this->inclusive);
+    break;
   }
-  return {};
-}
 
-CheckResult CheckGreater::checkValue(int64_t value) const
-{
-  auto checkFailed =
-      (this->inclusive && value < this->value) || (!this->inclusive && value <= this->value);
-  if (checkFailed)
-  {
-    if (!this->errorIfFail.empty())
-      return CheckResult({this->errorIfFail, this->checkLevel});
-    return CheckResult({"Value should be greater then " + std::to_string(this->value) +
-                            (this->inclusive ? " inclusive." : " exclusive."),
-                        this->checkLevel});
-  }
-  return {};
+  if (!checkFailed)
+    return {};
+  if (!this->errorIfFail.empty())
+    return CheckResult({this->errorIfFail, this->checkLevel});
+  return CheckResult({defaultError, this->checkLevel});
 }
 
-CheckResult CheckSmaller::checkValue(int64_t value) const
+Options &&Options::withMeaning(std::string_view meaningString)
 {
-  auto checkFailed =
-      (this->inclusive && value > this->value) || (!this->inclusive && value >= this->value);
-  if (checkFailed)
-  {
-    if (!this->errorIfFail.empty())
-      return CheckResult({this->errorIfFail, this->checkLevel});
-    return CheckResult({"Value should be smaller then " + std::to_string(this->value) +
-                            (this->inclusive ? " inclusive." : " exclusive."),
-                        this->checkLevel});
-  }
-  return {};
+  this->meaningString = meaningString;
+  return std::move(*this);
 }
 
-CheckResult CheckRange::checkValue(int64_t value) const
+Options &&Options::withMeaningMap(const MeaningMap &meaningMap)
 {
-  auto checkFailed = (this->inclusive && (value < this->range.min || value > this->range.max)) ||
-                     (!this->inclusive && (value <= this->range.min || value >= this->range.max));
-  if (checkFailed)
-  {
-    if (!this->errorIfFail.empty())
-      return CheckResult({this->errorIfFail, this->checkLevel});
-    return CheckResult({"Value should be in the range of " + std::to_string(this->range.min) +
-                            " to " + std::to_string(this->range.max) +
-                            (this->inclusive ? " inclusive." : " exclusive."),
-                        this->checkLevel});
-  }
-  return {};
+  this->meaningMapReference = &meaningMap;
+  return std::move(*this);
 }
 
-Options &&Options::withMeaning(const std::string &meaningString)
+Options &&Options::withMeaningMap(std::initializer_list<std::pair<int, const char *>> map)
 {
-  this->meaningString = meaningString;
+  this->meaningList = map;
   return std::move(*this);
 }
 
-Options &&Options::withMeaningMap(const MeaningMap &meaningMap)
+Options &&Options::withMeaningVector(const std::vector<std::string> &meaningVector)
 {
-  this->meaningMap = meaningMap;
+  this->meaningVectorReference = &meaningVector;
   return std::move(*this);
 }
 
-Options &&Options::withMeaningVector(const std::vector<std::string> &meaningVector)
+Options &&Options::withMeaningVector(std::initializer_list<const char *> meaningVector)
 {
-  // This is just a conveniance function. We still save the data in the map starting with an index
-  // of 0
-  for (unsigned i = 0; i < meaningVector.size(); i++)
-    this->meaningMap[i] = meaningVector[i];
+  this->meaningVector = meaningVector;
   return std::move(*this);
 }
 
@@ -188,14 +128,12 @@ Options &&Options::withCheckEqualTo(int64_t            value,
                                     const std::string &errorIfFail,
                                     const CheckLevel   checkLevel)
 {
-  this->checkList.emplace_back(std::make_unique<CheckEqualTo>(value, errorIfFail, checkLevel));
-  return std::move(*this);
+  return this->addCheck({Check::Type::EqualTo, {value, 0}, true, errorIfFail, checkLevel});
 }
 
 Options &&Options::withCheckEqualTo(int64_t value, const CheckLevel checkLevel)
 {
-  this->checkList.emplace_back(std::make_unique<CheckEqualTo>(value, "", checkLevel));
-  return std::move(*this);
+  return this->addCheck({Check::Type::EqualTo, {value, 0}, true, {}, checkLevel});
 }
 
 Options &&Options::withCheckGreater(int64_t            value,
@@ -203,9 +141,7 @@ Options &&Options::withCheckGreater(int64_t            value,
                                     const std::string &errorIfFail,
                                     const CheckLevel   checkLevel)
 {
-  this->checkList.emplace_back(
-      std::make_unique<CheckGreater>(value, inclusive, errorIfFail, checkLevel));
-  return std::move(*this);
+  return this->addCheck({Check::Type::Greater, {value, 0}, inclusive, errorIfFail, checkLevel});
 }
 
 Options &&Options::withCheckSmaller(int64_t            value,
@@ -213,9 +149,7 @@ Options &&Options::withCheckSmaller(int64_t            value,
                                     const std::string &errorIfFail,
                                     const CheckLevel   checkLevel)
 {
-  this->checkList.emplace_back(
-      std::make_unique<CheckSmaller>(value, inclusive, errorIfFail, checkLevel));
-  return std::move(*this);
+  return this->addCheck({Check::Type::Smaller, {value, 0}, inclusive, errorIfFail, checkLevel});
 }
 
 Options &&Options::withCheckRange(Range<int64_t>     range,
@@ -223,9 +157,7 @@ Options &&Options::withCheckRange(Range<int64_t>     range,
                                   const std::string &errorIfFail,
                                   const CheckLevel   checkLevel)
 {
-  this->checkList.emplace_back(
-      std::make_unique<CheckRange>(range, inclusive, errorIfFail, checkLevel));
-  return std::move(*this);
+  return this->addCheck({Check::Type::Range, range, inclusive, errorIfFail, checkLevel});
 }
 
 Options &&Options::withLoggingDisabled()
@@ -234,4 +166,42 @@ Options &&Options::withLoggingDisabled()
   return std::move(*this);
 }
 
-} // namespace parser::reader
\ No newline at end of file
+Options &&Options::addCheck(Check &&check)
+{
+  if (this->nrChecks >= MAX_NR_CHECKS)
+    throw std::logic_error("Too many checks for one symbol.");
+  this->checks[this->nrChecks++] = std::move(check);
+  return std::move(*this);
+}
+
+CheckResult Options::runChecks(int64_t value) const
+{
+  for (size_t i = 0; i < this->nrChecks; i++)
+  {
+    auto checkResult = this->checks[i].checkValue(value);
+    if (!checkResult)
+      return checkResult;
+  }
+  return {};
+}
+
+std::string Options::getMeaning(int64_t value) const
+{
+  if (this->meaningMap.count(int(value)) > 0)
+    return this->meaningMap.at(int(value));
+  if (this->meaningMapReference != nullptr && this->meaningMapReference->count(int(value)) > 0)
+    return this->meaningMapReference->at(int(value));
+  for (const auto &entry : this->meaningList)
+    if (entry.first == value)
+      return entry.second;
+  if (this->meaningVectorReference != nullptr && value >= 0 &&
+      size_t(value) < this->meaningVectorReference->size())
+    return this->meaningVectorReference->at(size_t(value));
+  if (value >= 0 && size_t(value) < this->meaningVector.size())
+    return *(this->meaningVector.begin() + value);
+  if (this->meaningFunction)
+    return this->meaningFunction(value);
+  return std::string(this->meaningString);
+}
+
+} // namespace parser::reader
@@ -34,9 +34,11 @@
 
 #include <common/Typedef.h>
 
+#include <array>
 #include <functional>
-#include <memory>
-#include <optional>
+#include <initializer_list>
+#include <map>
+#include <string_view>
 
 namespace parser::reader
 {
@@ -56,27 +58,43 @@ struct CheckResult
   CheckLevel  checkLevel{CheckLevel::Error};
 };
 
-class Check
+// A check is a plain value so that adding a check to the options does not allocate anything.
+struct Check
 {
-public:
-  Check() = default;
-  Check(std::string errorIfFail, CheckLevel checkLevel)
-      : errorIfFail(errorIfFail), checkLevel(checkLevel){};
-  virtual ~Check() = default;
+  enum class Type
+  {
+    EqualTo,
+    Greater,
+    Smaller,
+    Range
+  };
 
-  virtual CheckResult checkValue(int64_t value) const = 0;
+  CheckResult checkValue(int64_t value) const;
 
-  std::string errorIfFail;
-  CheckLevel  checkLevel{CheckLevel::Error};
+  Type           type{Type::EqualTo};
+  Range<int64_t> range{}; // For all checks except Range, only min is used
+  bool           inclusive{true};
+  std::string    errorIfFail;
+  CheckLevel     checkLevel{CheckLevel::Error};
 };
 
+/* The options for reading one symbol. When reading without logging (e.g. while opening a file or
+ * seeking), only the checks are evaluated. So the meanings are not copied into the options but
+ * only referenced and resolved when the symbol is actually logged. The referenced data must live
+ * until the symbol was read. This is the case for temporaries in the expression that reads the
+ * symbol. If options with meanings are kept in a variable, use the meaningMap member.
+ */
 struct Options
 {
+  static constexpr size_t MAX_NR_CHECKS = 2;
+
   Options() = default;
 
-  [[nodiscard]] Options &&withMeaning(const std::string &meaningString);
+  [[nodiscard]] Options &&withMeaning(std::string_view meaningString);
   [[nodiscard]] Options &&withMeaningMap(const MeaningMap &meaningMap);
+  [[nodiscard]] Options &&withMeaningMap(std::initializer_list<std::pair<int, const char *>> map);
   [[nodiscard]] Options &&withMeaningVector(const std::vector<std::string> &meaningVector);
+  [[nodiscard]] Options &&withMeaningVector(std::initializer_list<const char *> meaningVector);
   [[nodiscard]] Options &&
   withMeaningFunction(const std::function<std::string(int64_t)> &meaningFunction);
   [[nodiscard]] Options &&withCheckEqualTo(int64_t            value,
@@ -97,11 +115,29 @@ struct Options
                                          const CheckLevel   checkLevel  = CheckLevel::Error);
   [[nodiscard]] Options &&withLoggingDisabled();
 
-  std::string                         meaningString;
-  std::map<int, std::string>          meaningMap;
-  std::function<std::string(int64_t)> meaningFunction;
-  std::vector<std::unique_ptr<Check>> checkList;
-  bool                                loggingDisabled{false};
+  // Run all checks. Returns the first failing check (or an empty result).
+  [[nodiscard]] CheckResult runChecks(int64_t value) const;
+  // Resolve the meaning of the value from the given meaning sources
+  [[nodiscard]] std::string getMeaning(int64_t value) const;
+
+  MeaningMap meaningMap;
+  bool       loggingDisabled{false};
+
+private:
+  Options &&addCheck(Check &&check);
+
+  std::string_view                                    meaningString;
+  const MeaningMap *                                  meaningMapReference{};
+  std::initializer_list<std::pair<int, const char *>> meaningList;
+  const std::vector<std::string> *                    meaningVectorReference{};
+  std::initializer_list<const char *>                 meaningVector;
+  std::function<std::string(int64_t)>                 meaningFunction;
+
+  std::array<Check, MAX_NR_CHECKS> checks;
+  size_t                           nrChecks{0};
 };
 
-} // namespace parser::reader
\ No newline at end of file
+// Used as the default for symbols without options so that no options have to be created
+inline const Options NO_OPTIONS{};
+
+} // namespace parser::reader
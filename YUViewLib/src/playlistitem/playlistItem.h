@@ -48,8 +48,9 @@
 
 namespace video
 {
+class CacheStatistics;
 class FrameHandler;
-}
+} // namespace video
 
 class playlistItem : public QObject, public QTreeWidgetItem
 {
@@ -214,6 +215,12 @@ public:
   // Is there a limit on the number of threads that can cache from this item at the same time? (-1 =
   // no limit)
   virtual int cachingThreadLimit() { return -1; }
+  // Get the frames where caching can be started independently (e.g. the random access points of a
+  // compressed stream that is cached with multiple decoders). The cache splits the frames to cache
+  // at these positions into segments. Different segments are cached in parallel but the frames
+  // within a segment are always cached one after another in order. The default (empty) does not
+  // split the frames.
+  virtual std::vector<int> getCachingSegmentStarts() const { return {}; }
   // Tag the item as "to be deleted"
   void tagItemForDeletion() { itemTaggedForDeletion = true; }
   // Cache the given frame. This function is thread save. So multiple instances of this function can
@@ -228,6 +235,8 @@ public:
   // Remove the frame with the given index from the cache.
   virtual void removeFrameFromCache(int) {}
   virtual void removeAllFramesFromCache() {};
+  // The statistics on how well caching works for this item (nullptr if the item is not cached)
+  virtual video::CacheStatistics *getCacheStatistics() { return nullptr; }
 
   // ----- Detection of source/file change events -----
 
@@ -35,7 +35,9 @@
 #include <QInputDialog>
 #include <QPlainTextEdit>
 #include <QThread>
+#include <QtConcurrent>
 
+#include <algorithm>
 #include <inttypes.h>
 
 #include <common/Formatting.h>
@@ -91,6 +93,26 @@ enum class Codec
   Other
 };
 
+// Hand the current frame of the decoder to the video handler. If the decoder supports it, this is
+// a view onto its picture buffers so that the frame is not copied.
+void setRawFrameFromDecoder(video::videoHandler &video, decoder::decoderBase &dec, int frameIdx)
+{
+  video.rawFrameView = dec.getRawFrameView();
+  if (video.rawFrameView.isEmpty())
+    video.rawData = dec.getRawFrameData();
+  else
+    video.rawData.clear();
+  video.rawData_frameIndex = frameIdx;
+}
+
+video::RawFrameView getRawFrameFromDecoder(decoder::decoderBase &dec)
+{
+  auto rawFrame = dec.getRawFrameView();
+  if (rawFrame.isEmpty())
+    return video::RawFrameView(dec.getRawFrameData());
+  return rawFrame;
+}
+
 } // namespace
 
 // When decoding, it can make sense to seek forward to another random access point.
@@ -100,6 +122,17 @@ enum class Codec
 // by lower than this threshold, we will not seek.
 #define FORWARD_SEEK_THRESHOLD 5
 
+// The maximum number of caching decoders. Every caching decoder opens the file and allocates a
+// decoder (with its own picture buffers) so we don't want too many of them.
+#define MAX_NR_CACHING_DECODERS 8
+
+// When opening a raw annexB file, this many frames are indexed right away. The rest of the file is
+// indexed in the background.
+#define INITIAL_NR_INDEXED_FRAMES 64
+// While the index is still being built, the last indexed frames are not used yet. Decoding them
+// might require data from frames (in coding order) which are not in the index yet.
+#define INDEXING_REORDER_MARGIN 16
+
 playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compressedFilePath,
                                                          int            displayComponent,
                                                          InputFormat    input,
@@ -144,9 +177,8 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
     // Open file
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo Open annexB file");
     const auto filePath = std::filesystem::path(compressedFilePath.toStdString());
-    this->inputFileAnnexBLoading = std::make_unique<FileSourceAnnexBFile>(filePath);
-    if (this->cachingEnabled)
-      this->inputFileAnnexBCaching = std::make_unique<FileSourceAnnexBFile>(filePath);
+    this->loadingContext.inputFileAnnexB = std::make_unique<FileSourceAnnexBFile>(filePath);
+    this->indexingFile                   = std::make_unique<FileSourceAnnexBFile>(filePath);
     // inputFormatType a parser
     if (this->inputFormat == InputFormat::AnnexBHEVC)
     {
@@ -169,9 +201,12 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
       codec = Codec::Other;
     }
 
+    // Only index the beginning of the file for now. This is enough to get the properties of the
+    // stream. The rest of the file is indexed in the background once the item is set up.
     DEBUG_COMPRESSED(
-        "playlistItemCompressedVideo::playlistItemCompressedVideo Start parsing of file");
-    this->inputFileAnnexBParser->parseAnnexBFile(this->inputFileAnnexBLoading, mainWindow);
+        "playlistItemCompressedVideo::playlistItemCompressedVideo Start indexing of file");
+    this->inputFileAnnexBParser->indexAnnexBFile(
+        *this->indexingFile, this->breakIndexingAtomic, INITIAL_NR_INDEXED_FRAMES);
 
     // Get the frame size and the pixel format
     frameSize = this->inputFileAnnexBParser->getSequenceSizeSamples();
@@ -184,7 +219,7 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
     this->prop.frameRate = this->inputFileAnnexBParser->getFramerate();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo framerate "
                      << this->prop.frameRate);
-    this->prop.startEndRange = indexRange(0, int(this->inputFileAnnexBParser->getNumberPOCs() - 1));
+    this->prop.startEndRange = this->getIndexedFrameRange();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo startEndRange (0,"
                      << this->inputFileAnnexBParser->getNumberPOCs() << ")");
     this->prop.sampleAspectRatio = this->inputFileAnnexBParser->getSampleAspectRatio();
@@ -197,42 +232,42 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
     // Try ffmpeg to open the file
     DEBUG_COMPRESSED(
         "playlistItemCompressedVideo::playlistItemCompressedVideo Open file using ffmpeg");
-    this->inputFileFFmpegLoading = std::make_unique<FileSourceFFmpegFile>();
-    if (!this->inputFileFFmpegLoading->openFile(compressedFilePath, mainWindow))
+    this->loadingContext.inputFileFFmpeg = std::make_unique<FileSourceFFmpegFile>();
+    if (!this->loadingContext.inputFileFFmpeg->openFile(compressedFilePath, mainWindow))
     {
       this->setError("Error opening file using libavcodec.");
       return;
     }
     // Is this file RGB or YUV?
-    this->rawFormat = this->inputFileFFmpegLoading->getRawFormat();
+    this->rawFormat = this->loadingContext.inputFileFFmpeg->getRawFormat();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo Raw format "
                      << (this->rawFormat == video::RawFormat::YUV   ? "YUV"
                          : this->rawFormat == video::RawFormat::RGB ? "RGB"
                                                                     : "Unknown"));
     if (this->rawFormat == video::RawFormat::YUV)
-      formatYuv = this->inputFileFFmpegLoading->getPixelFormatYUV();
+      formatYuv = this->loadingContext.inputFileFFmpeg->getPixelFormatYUV();
     else if (this->rawFormat == video::RawFormat::RGB)
-      formatRgb = this->inputFileFFmpegLoading->getPixelFormatRGB();
+      formatRgb = this->loadingContext.inputFileFFmpeg->getPixelFormatRGB();
     else
     {
       this->setError("Unknown raw format.");
       return;
     }
-    frameSize = this->inputFileFFmpegLoading->getSequenceSizeSamples();
+    frameSize = this->loadingContext.inputFileFFmpeg->getSequenceSizeSamples();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo Frame size "
                      << frameSize.width << "x" << frameSize.height);
-    this->prop.frameRate = this->inputFileFFmpegLoading->getFramerate();
+    this->prop.frameRate = this->loadingContext.inputFileFFmpeg->getFramerate();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo framerate "
                      << this->prop.frameRate);
-    this->prop.startEndRange = this->inputFileFFmpegLoading->getDecodableFrameLimits();
+    this->prop.startEndRange = this->loadingContext.inputFileFFmpeg->getDecodableFrameLimits();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo startEndRange ("
                      << this->prop.startEndRange.first << "x" << this->prop.startEndRange.second
                      << ")");
-    this->ffmpegCodec = inputFileFFmpegLoading->getVideoStreamCodecID();
+    this->ffmpegCodec = this->loadingContext.inputFileFFmpeg->getVideoStreamCodecID();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo ffmpeg codec "
                      << this->ffmpegCodec.getCodecName());
     this->prop.sampleAspectRatio =
-        this->inputFileFFmpegLoading->getVideoCodecPar().getSampleAspectRatio();
+        this->loadingContext.inputFileFFmpeg->getVideoCodecPar().getSampleAspectRatio();
     DEBUG_COMPRESSED(
         "playlistItemCompressedVideo::playlistItemCompressedVideo sample aspect ratio ("
         << this->prop.sampleAspectRatio.num << "x" << this->prop.sampleAspectRatio.den << ")");
@@ -243,19 +278,12 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
     if (this->ffmpegCodec.isAV1())
       codec = Codec::AV1;
 
-    if (this->cachingEnabled)
-    {
-      // Open the file again for caching
-      this->inputFileFFmpegCaching = std::make_unique<FileSourceFFmpegFile>();
-      if (!this->inputFileFFmpegCaching->openFile(
-              compressedFilePath, mainWindow, this->inputFileFFmpegLoading.get()))
-      {
-        this->setError("Error opening file a second time using libavcodec for caching.");
-        return;
-      }
-    }
+    this->cachingSegmentStarts = this->loadingContext.inputFileFFmpeg->getKeyFrameIndices();
   }
 
+  if (this->cachingEnabled && !this->openCachingContexts(compressedFilePath))
+    return;
+
   // Check/set properties
   if (!frameSize.isValid())
   {
@@ -352,8 +380,8 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
   if (this->rawFormat == video::RawFormat::YUV)
   {
     auto yuvVideo = this->getYUVVideo();
-    yuvVideo->showPixelValuesAsDiff =
-        loadingDecoder->isSignalDifference(loadingDecoder->getDecodeSignal());
+    yuvVideo->showPixelValuesAsDiff = this->loadingContext.decoder->isSignalDifference(
+        this->loadingContext.decoder->getDecodeSignal());
   }
 
   // Fill the list of statistics that we can provide
@@ -366,12 +394,12 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
     // No frames to decode
     return;
 
-  // Seek both decoders to the start of the bitstream (this will also push the parameter sets /
+  // Seek all decoders to the start of the bitstream (this will also push the parameter sets /
   // extradata to the decoder)
   DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo Seek decoders to 0");
-  this->seekToPosition(0, 0, false);
-  if (this->cachingEnabled)
-    this->seekToPosition(0, 0, true);
+  this->seekToPosition(this->loadingContext, 0, 0);
+  for (auto &context : this->cachingContexts)
+    this->seekToPosition(*context, 0, 0);
 
   // Connect signals for requesting data and statistics
   this->connect(video.get(),
@@ -383,6 +411,61 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
                 &stats::StatisticUIHandler::updateItem,
                 this,
                 &playlistItemCompressedVideo::updateStatSource);
+
+  if (this->inputFileAnnexBParser && this->inputFileAnnexBParser->isIndexing())
+    this->startBackgroundIndexing();
+}
+
+playlistItemCompressedVideo::~playlistItemCompressedVideo()
+{
+  if (this->indexingFuture.isRunning())
+  {
+    // signal to background thread that we want to cancel the indexing
+    this->breakIndexingAtomic.store(true);
+    this->indexingFuture.waitForFinished();
+  }
+}
+
+void playlistItemCompressedVideo::startBackgroundIndexing()
+{
+  DEBUG_COMPRESSED("playlistItemCompressedVideo::startBackgroundIndexing");
+  this->indexingTimer.start(1000, this);
+  this->indexingFuture = QtConcurrent::run(
+      [this]()
+      {
+        this->inputFileAnnexBParser->indexAnnexBFile(*this->indexingFile,
+                                                     this->breakIndexingAtomic);
+      });
+}
+
+indexRange playlistItemCompressedVideo::getIndexedFrameRange() const
+{
+  const auto nrFrames = int(this->inputFileAnnexBParser->getNumberPOCs());
+  if (this->inputFileAnnexBParser->isIndexing())
+    return indexRange(
+        0, std::max(nrFrames - 1 - INDEXING_REORDER_MARGIN, std::min(nrFrames - 1, 0)));
+  return indexRange(0, nrFrames - 1);
+}
+
+// This timer event is called regularly while the background indexing is running.
+void playlistItemCompressedVideo::timerEvent(QTimerEvent *event)
+{
+  if (event->timerId() != this->indexingTimer.timerId())
+    return playlistItemWithVideo::timerEvent(event);
+
+  if (!this->indexingFuture.isRunning())
+  {
+    this->indexingTimer.stop();
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::timerEvent Background indexing done.");
+  }
+
+  const auto newRange = this->getIndexedFrameRange();
+  if (newRange != this->prop.startEndRange)
+  {
+    this->prop.startEndRange = newRange;
+    // There are new frames that the cache can consider now
+    emit SignalItemChanged(false, RECACHE_UPDATE);
+  }
 }
 
 void playlistItemCompressedVideo::savePlaylist(QDomElement &root, const QDir &playlistDir) const
@@ -403,14 +486,16 @@ void playlistItemCompressedVideo::savePlaylist(QDomElement &root, const QDir &pl
   d.appendProperiteChild("absolutePath", fileURL.toString());
   d.appendProperiteChild("relativePath", relativePath);
   d.appendProperiteChild("displayComponent",
-                         QString::number(loadingDecoder ? loadingDecoder->getDecodeSignal() : -1));
+                         QString::number(this->loadingContext.decoder
+                                             ? this->loadingContext.decoder->getDecodeSignal()
+                                             : -1));
 
   d.appendProperiteChild("inputFormat", InputFormatMapper.getName(this->inputFormat));
   d.appendProperiteChild("decoder", DecoderEngineMapper.getName(this->decoderEngine));
 
   if (this->video)
     this->video->savePlaylist(d);
-  if (this->loadingDecoder && loadingDecoder->statisticsSupported())
+  if (this->loadingContext.decoder && this->loadingContext.decoder->statisticsSupported())
   {
     auto newChild = YUViewDomElement(d.ownerDocument().createElement("StatisticsData"));
     this->statisticsData.savePlaylist(newChild);
@@ -471,9 +556,14 @@ InfoData playlistItemCompressedVideo::getInfo() const
   // info.items.append(loadingDecoder->getFileInfoList());
 
   info.items.append(InfoItem("Reader", InputFormatMapper.getName(this->inputFormat)));
-  if (this->inputFileFFmpegLoading)
+  if (this->inputFileAnnexBParser && this->inputFileAnnexBParser->isIndexing())
+    info.items.append(InfoItem(
+        "Indexing"sv,
+        std::to_string(this->inputFileAnnexBParser->getParsingProgressPercent()) + "%",
+        "The file is indexed in the background. More frames become available while this runs."));
+  if (this->loadingContext.inputFileFFmpeg)
   {
-    auto libraryPaths = this->inputFileFFmpegLoading->getLibraryPaths();
+    auto libraryPaths = this->loadingContext.inputFileFFmpeg->getLibraryPaths();
     if (libraryPaths.length() % 3 == 0)
     {
       for (int i = 0; i < libraryPaths.length() / 3; i++)
@@ -493,21 +583,25 @@ InfoData playlistItemCompressedVideo::getInfo() const
         InfoItem("Num POCs", std::to_string(nrFrames), "The number of pictures in the stream."));
     if (this->decodingEnabled)
     {
-      auto l = loadingDecoder->getLibraryPaths();
+      auto l = this->loadingContext.decoder->getLibraryPaths();
       if (l.length() % 3 == 0)
       {
         for (int i = 0; i < l.length() / 3; i++)
           info.items.append(InfoItem(
               l[i * 3].toStdString(), l[i * 3 + 1].toStdString(), l[i * 3 + 2].toStdString()));
       }
-      info.items.append(InfoItem("Decoder", this->loadingDecoder->getDecoderName().toStdString()));
-      info.items.append(InfoItem("Decoder", this->loadingDecoder->getCodecName().toStdString()));
+      const auto dec = this->loadingContext.decoder.get();
+      info.items.append(InfoItem("Decoder", dec->getDecoderName().toStdString()));
+      info.items.append(InfoItem("Decoder", dec->getCodecName().toStdString()));
+      info.items.append(InfoItem("Caching Decoders"sv,
+                                 std::to_string(this->cachingContexts.size()),
+                                 "The number of decoders that cache frames in parallel."));
       info.items.append(InfoItem("Statistics"sv,
-                                 this->loadingDecoder->statisticsSupported() ? "Yes" : "No",
+                                 dec->statisticsSupported() ? "Yes" : "No",
                                  "Is the decoder able to provide internals (statistics)?"));
       info.items.append(
           InfoItem("Stat Parsing"sv,
-                   this->loadingDecoder->statisticsEnabled() ? "Yes" : "No",
+                   dec->statisticsEnabled() ? "Yes" : "No",
                    "Are the statistics of the sequence currently extracted from the stream?"));
     }
   }
@@ -536,9 +630,9 @@ void playlistItemCompressedVideo::infoListButtonPressed(int buttonID)
     uiDialog.ffmpegLogEdit->setPlainText(logFFmpegString);
 
     // Get the loading log
-    if (this->inputFileFFmpegLoading)
+    if (this->loadingContext.inputFileFFmpeg)
     {
-      auto    logLoading = this->inputFileFFmpegLoading->getFFmpegLoadingLog();
+      auto    logLoading = this->loadingContext.inputFileFFmpeg->getFFmpegLoadingLog();
       QString logLoadingString;
       for (const auto &l : logLoading)
         logLoadingString.append(l + "\n");
@@ -555,8 +649,8 @@ ItemLoadingState playlistItemCompressedVideo::needsLoading(int frameIdx, bool lo
     return ItemLoadingState::LoadingNotNeeded;
 
   auto videoState = this->video->needsLoading(frameIdx, loadRawData);
-  if (videoState == ItemLoadingState::LoadingNeeded && this->decodingNotPossibleAfter >= 0 &&
-      frameIdx >= this->decodingNotPossibleAfter && frameIdx >= this->currentFrameIdx[0])
+  if (videoState == ItemLoadingState::LoadingNeeded && this->isDecodingNotPossible(frameIdx) &&
+      frameIdx >= this->loadingContext.currentFrameIdx)
     // The decoder can not decode this frame.
     return ItemLoadingState::LoadingNotNeeded;
   if (videoState == ItemLoadingState::LoadingNeeded ||
@@ -571,7 +665,7 @@ void playlistItemCompressedVideo::drawItem(QPainter *painter,
                                            bool      drawRawData)
 {
   const auto range = this->properties().startEndRange;
-  if (this->decodingNotPossibleAfter >= 0 && frameIdx >= this->decodingNotPossibleAfter)
+  if (this->isDecodingNotPossible(frameIdx))
   {
     this->infoText = "Decoding of the frame not possible:\n";
     this->infoText +=
@@ -583,7 +677,7 @@ void playlistItemCompressedVideo::drawItem(QPainter *painter,
   {
     playlistItem::drawItem(painter, -1, zoomFactor, drawRawData);
   }
-  else if (!this->loadingDecoder)
+  else if (!this->loadingContext.decoder)
   {
     this->infoText = "No decoder allocated.\n";
     playlistItem::drawItem(painter, -1, zoomFactor, drawRawData);
@@ -597,35 +691,77 @@ void playlistItemCompressedVideo::drawItem(QPainter *painter,
 
 void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
 {
-  if (caching && !this->cachingEnabled)
+  if (caching)
+  {
+    // The videoHandler requested a frame for caching. Caching is normally performed in cacheFrame
+    // where the decoded frame is directly handed to the cache of the videoHandler.
+    if (!this->cachingEnabled || this->cachingContexts.empty())
+      return;
+    auto &context = this->acquireCachingContext(frameIdx);
+    if (this->decodeFrame(context, frameIdx))
+      setRawFrameFromDecoder(*this->video, *context.decoder, frameIdx);
+    this->releaseCachingContext(context);
     return;
-  if (!caching && this->loadingDecoder->state() == decoder::DecoderState::Error)
+  }
+
+  DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData " << frameIdx);
+
+  const auto dec = this->loadingContext.decoder.get();
+  if (this->decodeFrame(this->loadingContext, frameIdx))
+  {
+    if (dec->statisticsEnabled())
+      this->statisticsData.setFrameIndex(frameIdx);
+    setRawFrameFromDecoder(*this->video, *dec, frameIdx);
+  }
+
+  if (this->isDecodingNotPossible(frameIdx))
+  {
+    // Just set the frame number of the buffer to the current frame so that it will trigger a
+    // reload when the frame number changes.
+    this->video->rawData_frameIndex = frameIdx;
+  }
+  else if (dec->state() == decoder::DecoderState::Error)
+  {
+    this->infoText = "There was an error in the decoder: \n";
+    this->infoText += dec->decoderErrorString();
+    this->infoText += "\n";
+
+    this->decodingEnabled = false;
+  }
+}
+
+bool playlistItemCompressedVideo::isDecodingNotPossible(int frameIdx) const
+{
+  const int notPossibleAfter = this->loadingContext.decodingNotPossibleAfter;
+  return notPossibleAfter >= 0 && frameIdx >= notPossibleAfter;
+}
+
+bool playlistItemCompressedVideo::decodeFrame(DecodingContext &context, int frameIdx)
+{
+  const auto dec = context.decoder.get();
+  if (dec->state() == decoder::DecoderState::Error)
   {
-    if (frameIdx < this->currentFrameIdx[0])
+    if (frameIdx < context.currentFrameIdx)
     {
-      // There was an error in the loading decoder but we will seek backwards so maybe this will
+      // There was an error in the decoder but we will seek backwards so maybe this will
       // work again
     }
     else
-      return;
+      return false;
   }
-  if (caching && this->cachingDecoder->state() == decoder::DecoderState::Error)
-    return;
-
-  DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData " << frameIdx
-                                                               << (caching ? " caching" : ""));
 
   if (frameIdx > this->properties().startEndRange.second || frameIdx < 0)
   {
-    DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData Invalid frame index");
-    return;
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame Invalid frame index");
+    return false;
   }
 
-  // Get the right decoder
-  const auto dec         = caching ? this->cachingDecoder.get() : this->loadingDecoder.get();
-  const auto curFrameIdx = caching ? this->currentFrameIdx[1] : this->currentFrameIdx[0];
+  // This includes seeking and reading the bitstream
+  video::ScopedLatencyTimer decodeTimer(&this->video->cacheStatistics,
+                                        video::LoadingStage::Decode);
 
   // Should we seek?
+  const auto curFrameIdx = context.currentFrameIdx;
   if (curFrameIdx == -1 || frameIdx < curFrameIdx ||
       frameIdx > curFrameIdx + FORWARD_SEEK_THRESHOLD)
   {
@@ -645,12 +781,8 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
     }
     else
     {
-      if (caching)
-        std::tie(seekToDTS, seekToFrame) =
-            this->inputFileFFmpegCaching->getClosestSeekableFrameBefore(frameIdx);
-      else
-        std::tie(seekToDTS, seekToFrame) =
-            this->inputFileFFmpegLoading->getClosestSeekableFrameBefore(frameIdx);
+      std::tie(seekToDTS, seekToFrame) =
+          context.inputFileFFmpeg->getClosestSeekableFrameBefore(frameIdx);
 
       // The distance in the display order unfortunately does not tell us
       // too much about the number of frames that must be decoded to seek
@@ -662,45 +794,41 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
     if (seek)
     {
       // Seek and update the frame counters. The seekToPosition function will update the
-      // currentFrameIdx[] indices
-      this->readAnnexBFrameCounterCodingOrder = int(seekToFrame);
-      DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData seeking to frame "
+      // currentFrameIdx of the context.
+      context.readAnnexBFrameCounterCodingOrder = int(seekToFrame);
+      DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame seeking to frame "
                        << seekToFrame << " PTS " << seekToDTS << " AnnexBCnt "
-                       << this->readAnnexBFrameCounterCodingOrder);
-      this->seekToPosition(this->readAnnexBFrameCounterCodingOrder, seekToDTS, caching);
+                       << context.readAnnexBFrameCounterCodingOrder);
+      this->seekToPosition(context, context.readAnnexBFrameCounterCodingOrder, seekToDTS);
     }
   }
 
   // Decode until we get the right frame from the decoder
-  bool rightFrame =
-      caching ? this->currentFrameIdx[1] == frameIdx : this->currentFrameIdx[0] == frameIdx;
+  bool rightFrame = context.currentFrameIdx == frameIdx;
   while (!rightFrame)
   {
     while (dec->state() == decoder::DecoderState::NeedsMoreData)
     {
-      DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData decoder needs more data");
+      DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame decoder needs more data");
       if (isInputFormatTypeFFmpeg(this->inputFormat) &&
           this->decoderEngine == DecoderEngine::FFMpeg)
       {
         // In this scenario, we can read and push AVPackets
         // from the FFmpeg file and pass them to the FFmpeg decoder directly.
-        auto pkt   = caching ? this->inputFileFFmpegCaching->getNextPacket(repushData)
-                             : this->inputFileFFmpegLoading->getNextPacket(repushData);
-        repushData = false;
+        auto pkt           = context.inputFileFFmpeg->getNextPacket(context.repushData);
+        context.repushData = false;
         if (pkt)
-          DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData retrieved packet PTS "
+          DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame retrieved packet PTS "
                            << pkt.getPTS());
         else
-          DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData retrieved empty packet");
-        auto ffmpegDec =
-            (caching ? dynamic_cast<decoder::decoderFFmpeg *>(this->cachingDecoder.get())
-                     : dynamic_cast<decoder::decoderFFmpeg *>(this->loadingDecoder.get()));
+          DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame retrieved empty packet");
+        auto ffmpegDec = dynamic_cast<decoder::decoderFFmpeg *>(dec);
         if (!ffmpegDec->pushAVPacket(pkt))
         {
           if (ffmpegDec->state() != decoder::DecoderState::RetrieveFrames)
             // The decoder did not switch to decoding frame mode. Error.
-            return;
-          this->repushData = true;
+            return false;
+          context.repushData = true;
         }
       }
       else if (isInputFormatTypeAnnexB(this->inputFormat) &&
@@ -708,39 +836,37 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
       {
         // We are reading from a raw annexB file and use ffmpeg for decoding
         QByteArray data;
-        if (this->readAnnexBFrameCounterCodingOrder >= 0 &&
-            unsigned(this->readAnnexBFrameCounterCodingOrder) >=
+        if (context.readAnnexBFrameCounterCodingOrder >= 0 &&
+            unsigned(context.readAnnexBFrameCounterCodingOrder) >=
                 this->inputFileAnnexBParser->getNumberPOCs())
         {
-          DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData EOF");
+          DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame EOF");
         }
         else
         {
           // Get the data of the next frame (which might be multiple NAL units)
           auto frameStartEndFilePos = this->inputFileAnnexBParser->getFrameStartEndPos(
-              this->readAnnexBFrameCounterCodingOrder);
+              context.readAnnexBFrameCounterCodingOrder);
           Q_ASSERT_X(frameStartEndFilePos,
-                     "playlistItemCompressedVideo::loadRawData",
+                     "playlistItemCompressedVideo::decodeFrame",
                      "frameStartEndFilePos could not be retrieved. This should always work for a "
                      "raw AnnexB file.");
 
-          data = caching ? this->inputFileAnnexBCaching->getFrameData(*frameStartEndFilePos)
-                         : this->inputFileAnnexBLoading->getFrameData(*frameStartEndFilePos);
-          DEBUG_COMPRESSED(
-              "playlistItemCompressedVideo::loadRawData retrieved frame data from file "
-              "- AnnexBCnt "
-              << this->readAnnexBFrameCounterCodingOrder << " startEnd "
-              << frameStartEndFilePos->first << "-" << frameStartEndFilePos->second << " - size "
-              << data.size());
+          data = context.inputFileAnnexB->getFrameData(*frameStartEndFilePos);
+          DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame retrieved frame data from "
+                           "file - AnnexBCnt "
+                           << context.readAnnexBFrameCounterCodingOrder << " startEnd "
+                           << frameStartEndFilePos->first << "-" << frameStartEndFilePos->second
+                           << " - size " << data.size());
         }
 
         if (!dec->pushData(data))
         {
           if (dec->state() != decoder::DecoderState::RetrieveFrames)
           {
-            DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData The decoder did not switch "
+            DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame The decoder did not switch "
                              "to decoding frame mode. Error.");
-            this->decodingNotPossibleAfter = frameIdx;
+            context.decodingNotPossibleAfter = frameIdx;
             break;
           }
           // Pushing the data failed because the ffmpeg decoder wants us to read frames first.
@@ -748,28 +874,26 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
           // again.
         }
         else
-          this->readAnnexBFrameCounterCodingOrder++;
+          context.readAnnexBFrameCounterCodingOrder++;
       }
       else if (isInputFormatTypeAnnexB(this->inputFormat) &&
                this->decoderEngine != DecoderEngine::FFMpeg)
       {
-        auto data = caching ? this->inputFileAnnexBCaching->getNextNALUnit(repushData)
-                            : this->inputFileAnnexBLoading->getNextNALUnit(repushData);
+        auto data = context.inputFileAnnexB->getNextNALUnit(context.repushData);
         DEBUG_COMPRESSED(
-            "playlistItemCompressedVideo::loadRawData retrieved nal unit from file - size "
+            "playlistItemCompressedVideo::decodeFrame retrieved nal unit from file - size "
             << data.size());
-        this->repushData = !dec->pushData(data);
+        context.repushData = !dec->pushData(data);
       }
       else if (isInputFormatTypeFFmpeg(this->inputFormat) &&
                this->decoderEngine != DecoderEngine::FFMpeg)
       {
         // Get the next unit (NAL or OBU) form ffmepg and push it to the decoder
-        auto data = caching ? this->inputFileFFmpegCaching->getNextUnit(repushData)
-                            : this->inputFileFFmpegLoading->getNextUnit(repushData);
+        auto data = context.inputFileFFmpeg->getNextUnit(context.repushData);
         DEBUG_COMPRESSED(
-            "playlistItemCompressedVideo::loadRawData retrieved nal unit from file - size "
+            "playlistItemCompressedVideo::decodeFrame retrieved nal unit from file - size "
             << data.size());
-        this->repushData = !dec->pushData(data);
+        context.repushData = !dec->pushData(data);
       }
       else
         assert(false);
@@ -779,64 +903,43 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
     {
       if (dec->decodeNextFrame())
       {
-        if (caching)
-          this->currentFrameIdx[1]++;
-        else
-          this->currentFrameIdx[0]++;
-
-        DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData decoded frame "
-                         << (caching ? this->currentFrameIdx[1] : this->currentFrameIdx[0]));
-        rightFrame =
-            caching ? this->currentFrameIdx[1] == frameIdx : this->currentFrameIdx[0] == frameIdx;
-        if (rightFrame)
-        {
-          if (dec->statisticsEnabled())
-            this->statisticsData.setFrameIndex(frameIdx);
-          this->video->rawData            = dec->getRawFrameData();
-          this->video->rawData_frameIndex = frameIdx;
-        }
+        context.currentFrameIdx++;
+        DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame decoded frame "
+                         << context.currentFrameIdx);
+        rightFrame = context.currentFrameIdx == frameIdx;
       }
     }
 
     if (dec->state() != decoder::DecoderState::NeedsMoreData &&
         dec->state() != decoder::DecoderState::RetrieveFrames)
     {
-      DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData decoder neither needs more data "
+      DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame decoder neither needs more data "
                        "nor can decode frames");
-      this->decodingNotPossibleAfter = frameIdx;
+      context.decodingNotPossibleAfter = frameIdx;
       break;
     }
   }
 
-  if (this->decodingNotPossibleAfter >= 0 && frameIdx >= this->decodingNotPossibleAfter)
+  if (context.decodingNotPossibleAfter >= 0 && frameIdx >= context.decodingNotPossibleAfter)
   {
     // The specified frame (which is thoretically in the bitstream) can not be decoded.
     // Maybe the bitstream was cut at a position that it was not supposed to be cut at.
-    if (caching)
-      this->currentFrameIdx[1] = frameIdx;
-    else
-      this->currentFrameIdx[0] = frameIdx;
-    // Just set the frame number of the buffer to the current frame so that it will trigger a
-    // reload when the frame number changes.
-    this->video->rawData_frameIndex = frameIdx;
+    context.currentFrameIdx = frameIdx;
+    return false;
   }
-  else if (this->loadingDecoder->state() == decoder::DecoderState::Error)
-  {
-    this->infoText = "There was an error in the decoder: \n";
-    this->infoText += this->loadingDecoder->decoderErrorString();
-    this->infoText += "\n";
 
-    this->decodingEnabled = false;
-  }
+  return rightFrame;
 }
 
-void playlistItemCompressedVideo::seekToPosition(int seekToFrame, int64_t seekToDTS, bool caching)
+void playlistItemCompressedVideo::seekToPosition(DecodingContext &context,
+                                                 int              seekToFrame,
+                                                 int64_t          seekToDTS)
 {
   // Do the seek
-  auto dec = caching ? this->cachingDecoder.get() : this->loadingDecoder.get();
+  auto dec = context.decoder.get();
   dec->resetDecoder();
-  this->repushData               = false;
-  this->decodingNotPossibleAfter = -1;
+  context.repushData               = false;
+  context.decodingNotPossibleAfter = -1;
 
   // Retrieval of the raw metadata is only required if the the reader or the decoder is not ffmpeg
   const bool bothFFmpeg =
@@ -865,22 +968,15 @@ void playlistItemCompressedVideo::seekToPosition(int seekToFrame, int64_t seekTo
     }
     DEBUG_COMPRESSED("playlistItemCompressedVideo::seekToPosition seeking annexB file to filePos "
                      << filePos);
-    if (caching)
-      this->inputFileAnnexBCaching->seek(filePos);
-    else
-      this->inputFileAnnexBLoading->seek(filePos);
+    context.inputFileAnnexB->seek(filePos);
   }
   else
   {
     if (!bothFFmpeg)
-      parametersets = caching ? this->inputFileFFmpegCaching->getParameterSets()
-                              : this->inputFileFFmpegLoading->getParameterSets();
+      parametersets = context.inputFileFFmpeg->getParameterSets();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::seekToPosition seeking ffmpeg file to pts "
                      << seekToDTS);
-    if (caching)
-      this->inputFileFFmpegCaching->seekToDTS(seekToDTS);
-    else
-      this->inputFileFFmpegLoading->seekToDTS(seekToDTS);
+    context.inputFileFFmpeg->seekToDTS(seekToDTS);
   }
 
   // In case of using ffmpeg for decoding, we don't need to push the parameter sets (the
@@ -898,10 +994,7 @@ void playlistItemCompressedVideo::seekToPosition(int seekToFrame, int64_t seekTo
         return;
       }
   }
-  if (caching)
-    this->currentFrameIdx[1] = seekToFrame - 1;
-  else
-    this->currentFrameIdx[0] = seekToFrame - 1;
+  context.currentFrameIdx = seekToFrame - 1;
 }
 
 void playlistItemCompressedVideo::createPropertiesWidget()
@@ -937,10 +1030,10 @@ void playlistItemCompressedVideo::createPropertiesWidget()
       6, this->statisticsUIHandler.createStatisticsHandlerControls(), 1);
 
   // Set the components that we can display
-  if (loadingDecoder)
+  if (this->loadingContext.decoder)
   {
-    ui.comboBoxDisplaySignal->addItems(loadingDecoder->getSignalNames());
-    ui.comboBoxDisplaySignal->setCurrentIndex(loadingDecoder->getDecodeSignal());
+    ui.comboBoxDisplaySignal->addItems(this->loadingContext.decoder->getSignalNames());
+    ui.comboBoxDisplaySignal->setCurrentIndex(this->loadingContext.decoder->getDecodeSignal());
   }
   // Add decoders we can use
   for (auto e : possibleDecoders)
@@ -963,136 +1056,165 @@ void playlistItemCompressedVideo::createPropertiesWidget()
 bool playlistItemCompressedVideo::allocateDecoder(int displayComponent)
 {
   // Reset (existing) decoders
-  this->loadingDecoder.reset();
-  this->cachingDecoder.reset();
+  this->loadingContext.decoder.reset();
+  for (auto &context : this->cachingContexts)
+    context->decoder.reset();
 
-  if (this->decoderEngine == DecoderEngine::Libde265)
-  {
-    DEBUG_COMPRESSED(
-        "playlistItemCompressedVideo::allocateDecoder Initializing interactive libde265 decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderLibde265>(displayComponent);
-    if (this->cachingEnabled)
-    {
-      DEBUG_COMPRESSED(
-          "playlistItemCompressedVideo::allocateDecoder Initializing caching libde265 decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderLibde265>(displayComponent, true);
-    }
-  }
-  else if (this->decoderEngine == DecoderEngine::HM)
-  {
-    DEBUG_COMPRESSED(
-        "playlistItemCompressedVideo::allocateDecoder Initializing interactive HM decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderHM>(displayComponent);
-    if (this->cachingEnabled)
-    {
-      DEBUG_COMPRESSED(
-          "playlistItemCompressedVideo::allocateDecoder caching interactive HM decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderHM>(displayComponent, true);
-    }
-  }
-  else if (this->decoderEngine == DecoderEngine::VTM)
-  {
-    DEBUG_COMPRESSED(
-        "playlistItemCompressedVideo::allocateDecoder Initializing interactive VTM decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderVTM>(displayComponent);
-    if (this->cachingEnabled)
-    {
-      DEBUG_COMPRESSED(
-          "playlistItemCompressedVideo::allocateDecoder caching interactive VTM decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderVTM>(displayComponent, true);
-    }
-  }
-  else if (this->decoderEngine == DecoderEngine::VVDec)
+  DEBUG_COMPRESSED("playlistItemCompressedVideo::allocateDecoder Initializing interactive "
+                   << QString::fromStdString(DecoderEngineMapper.getName(this->decoderEngine))
+                   << " decoder");
+  this->loadingContext.decoder = this->createDecoder(this->loadingContext, displayComponent, false);
+  if (!this->loadingContext.decoder)
   {
-    DEBUG_COMPRESSED(
-        "playlistItemCompressedVideo::allocateDecoder Initializing interactive VVDec decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderVVDec>(displayComponent);
-    if (this->cachingEnabled)
-    {
-      DEBUG_COMPRESSED(
-          "playlistItemCompressedVideo::allocateDecoder caching interactive VVDec decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderVVDec>(displayComponent, true);
-    }
+    this->infoText        = "No valid decoder was selected.";
+    this->decodingEnabled = false;
+    return false;
   }
-  else if (this->decoderEngine == DecoderEngine::Dav1d)
+
+  DEBUG_COMPRESSED("playlistItemCompressedVideo::allocateDecoder Initializing "
+                   << this->cachingContexts.size() << " caching decoders");
+  for (auto &context : this->cachingContexts)
+    context->decoder = this->createDecoder(*context, displayComponent, true);
+
+  this->decodingEnabled = this->loadingContext.decoder->state() != decoder::DecoderState::Error;
+  if (!decodingEnabled)
   {
-    DEBUG_COMPRESSED(
-        "playlistItemCompressedVideo::allocateDecoder Initializing interactive dav1d decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderDav1d>(displayComponent);
-    if (this->cachingEnabled)
-    {
-      DEBUG_COMPRESSED(
-          "playlistItemCompressedVideo::allocateDecoder caching interactive dav1d decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderDav1d>(displayComponent, true);
-    }
+    this->infoText = "There was an error allocating the new decoder: \n";
+    this->infoText += this->loadingContext.decoder->decoderErrorString();
+    this->infoText += "\n";
+    return false;
   }
-  else if (this->decoderEngine == DecoderEngine::FFMpeg)
+
+  return true;
+}
+
+std::unique_ptr<decoder::decoderBase> playlistItemCompressedVideo::createDecoder(
+    const DecodingContext &context, int displayComponent, bool cachingDecoder)
+{
+  if (this->decoderEngine == DecoderEngine::Libde265)
+    return std::make_unique<decoder::decoderLibde265>(displayComponent, cachingDecoder);
+  if (this->decoderEngine == DecoderEngine::HM)
+    return std::make_unique<decoder::decoderHM>(displayComponent, cachingDecoder);
+  if (this->decoderEngine == DecoderEngine::VTM)
+    return std::make_unique<decoder::decoderVTM>(displayComponent, cachingDecoder);
+  if (this->decoderEngine == DecoderEngine::VVDec)
+    return std::make_unique<decoder::decoderVVDec>(displayComponent, cachingDecoder);
+  if (this->decoderEngine == DecoderEngine::Dav1d)
+    return std::make_unique<decoder::decoderDav1d>(displayComponent, cachingDecoder);
+  if (this->decoderEngine == DecoderEngine::FFMpeg)
   {
     if (isInputFormatTypeAnnexB(this->inputFormat))
     {
+      auto lock         = this->inputFileAnnexBParser->lockIndex();
       auto frameSize    = this->inputFileAnnexBParser->getSequenceSizeSamples();
       auto extradata    = this->inputFileAnnexBParser->getExtradata();
       auto fmt          = this->inputFileAnnexBParser->getPixelFormat();
       auto profileLevel = this->inputFileAnnexBParser->getProfileLevel();
       auto ratio        = this->inputFileAnnexBParser->getSampleAspectRatio();
 
-      DEBUG_COMPRESSED("playlistItemCompressedVideo::allocateDecoder Initializing interactive "
-                       "ffmpeg decoder from raw anexB stream. frameSize "
+      DEBUG_COMPRESSED("playlistItemCompressedVideo::createDecoder Initializing ffmpeg decoder "
+                       "from raw anexB stream. frameSize "
                        << frameSize.width << "x" << frameSize.height << " extradata length "
                        << extradata.length() << " PixelFormatYUV "
                        << QString::fromStdString(fmt.getName()) << " profile/level "
                        << profileLevel.first << "/" << profileLevel.second << ", aspect raio "
                        << ratio.num << "/" << ratio.den);
-      this->loadingDecoder = std::make_unique<decoder::decoderFFmpeg>(
-          ffmpegCodec, frameSize, extradata, fmt, profileLevel, ratio);
-      if (this->cachingEnabled)
-      {
-        DEBUG_COMPRESSED("playlistItemCompressedVideo::allocateDecoder Initializing caching ffmpeg "
-                         "decoder from raw anexB stream. Same settings.");
-        this->cachingDecoder = std::make_unique<decoder::decoderFFmpeg>(
-            ffmpegCodec, frameSize, extradata, fmt, profileLevel, ratio, true);
-      }
+      return std::make_unique<decoder::decoderFFmpeg>(
+          ffmpegCodec, frameSize, extradata, fmt, profileLevel, ratio, cachingDecoder);
+    }
+
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::createDecoder Initializing ffmpeg decoder "
+                     "using ffmpeg as parser");
+    return std::make_unique<decoder::decoderFFmpeg>(context.inputFileFFmpeg->getVideoCodecPar(),
+                                                    cachingDecoder);
+  }
+  return {};
+}
+
+bool playlistItemCompressedVideo::openCachingContexts(const QString &compressedFilePath)
+{
+  // Every caching decoder can decode a different part of the stream (between two random access
+  // points) in parallel. But decoders are memory hungry and most decoders use multiple threads
+  // themselves so we only use about one caching decoder for every second core.
+  // If we already know all the segments, there is no need for more contexts than segments.
+  auto nrContexts = std::clamp(QThread::idealThreadCount() / 2, 1, MAX_NR_CACHING_DECODERS);
+  if (!this->cachingSegmentStarts.empty())
+    nrContexts = std::min(nrContexts, int(this->cachingSegmentStarts.size()));
+  const auto mainWindow = MainWindow::getMainWindow();
+
+  DEBUG_COMPRESSED("playlistItemCompressedVideo::openCachingContexts Opening file "
+                   << nrContexts << " times for caching");
+  for (int i = 0; i < nrContexts; i++)
+  {
+    auto context = std::make_unique<DecodingContext>();
+    if (isInputFormatTypeAnnexB(this->inputFormat))
+    {
+      const auto filePath     = std::filesystem::path(compressedFilePath.toStdString());
+      context->inputFileAnnexB = std::make_unique<FileSourceAnnexBFile>(filePath);
     }
     else
     {
-      DEBUG_COMPRESSED("playlistItemCompressedVideo::allocateDecoder Initializing interactive "
-                       "ffmpeg decoder using ffmpeg as parser");
-      this->loadingDecoder = std::make_unique<decoder::decoderFFmpeg>(
-          this->inputFileFFmpegLoading->getVideoCodecPar());
-      if (this->cachingEnabled)
+      context->inputFileFFmpeg = std::make_unique<FileSourceFFmpegFile>();
+      if (!context->inputFileFFmpeg->openFile(
+              compressedFilePath, mainWindow, this->loadingContext.inputFileFFmpeg.get()))
       {
-        DEBUG_COMPRESSED("playlistItemCompressedVideo::allocateDecoder Initializing caching ffmpeg "
-                         "decoder using ffmpeg as parser");
-        this->cachingDecoder = std::make_unique<decoder::decoderFFmpeg>(
-            this->inputFileFFmpegCaching->getVideoCodecPar());
+        this->setError("Error opening file a second time using libavcodec for caching.");
+        return false;
       }
     }
+    this->cachingContexts.push_back(std::move(context));
   }
-  else
-  {
-    this->infoText        = "No valid decoder was selected.";
-    this->decodingEnabled = false;
-    return false;
-  }
+  return true;
+}
 
-  this->decodingEnabled = this->loadingDecoder->state() != decoder::DecoderState::Error;
-  if (!decodingEnabled)
+playlistItemCompressedVideo::DecodingContext &
+playlistItemCompressedVideo::acquireCachingContext(int frameIdx)
+{
+  QMutexLocker locker(&this->cachingMutex);
+  while (true)
   {
-    this->infoText = "There was an error allocating the new decoder: \n";
-    this->infoText += loadingDecoder->decoderErrorString();
-    this->infoText += "\n";
-    return false;
+    // Prefer the idle context that is closest before the requested frame. If we are lucky, it just
+    // has to decode the next frame. If no context is before the frame, we take any idle one.
+    DecodingContext *bestContext = nullptr;
+    for (auto &context : this->cachingContexts)
+    {
+      if (context->inUse)
+        continue;
+      if (bestContext == nullptr)
+      {
+        bestContext = context.get();
+        continue;
+      }
+      const auto isBefore     = context->currentFrameIdx < frameIdx;
+      const auto bestIsBefore = bestContext->currentFrameIdx < frameIdx;
+      if ((isBefore && !bestIsBefore) ||
+          (isBefore && context->currentFrameIdx > bestContext->currentFrameIdx))
+        bestContext = context.get();
+    }
+
+    if (bestContext != nullptr)
+    {
+      bestContext->inUse = true;
+      return *bestContext;
+    }
+
+    this->cachingContextReleased.wait(&this->cachingMutex);
   }
+}
 
-  return true;
+void playlistItemCompressedVideo::releaseCachingContext(DecodingContext &context)
+{
+  QMutexLocker locker(&this->cachingMutex);
+  context.inUse = false;
+  this->cachingContextReleased.wakeOne();
 }
 
 void playlistItemCompressedVideo::fillStatisticList()
 {
-  if (!this->loadingDecoder || !this->loadingDecoder->statisticsSupported())
+  if (!this->loadingContext.decoder || !this->loadingContext.decoder->statisticsSupported())
     return;
 
-  this->loadingDecoder->fillStatisticList(this->statisticsData);
+  this->loadingContext.decoder->fillStatisticList(this->statisticsData);
 }
 
 void playlistItemCompressedVideo::loadStatistics(int frameIdx)
@@ -1100,25 +1222,25 @@ void playlistItemCompressedVideo::loadStatistics(int frameIdx)
   DEBUG_COMPRESSED("playlistItemCompressedVideo::loadStatisticToCache Request statistics for frame "
                    << frameIdx);
 
-  if (!this->loadingDecoder->statisticsSupported())
+  if (!this->loadingContext.decoder->statisticsSupported())
     return;
-  if (!this->loadingDecoder->statisticsEnabled())
+  if (!this->loadingContext.decoder->statisticsEnabled())
   {
     // We have to enable collecting of statistics in the decoder. By default (for speed reasons)
     // this is off. Enabeling works like this: Enable collection, reset the decoder and decode the
     // current frame again. Statisitcs are always retrieved for the loading decoder.
-    this->loadingDecoder->enableStatisticsRetrieval(&this->statisticsData);
+    this->loadingContext.decoder->enableStatisticsRetrieval(&this->statisticsData);
     DEBUG_COMPRESSED("playlistItemCompressedVideo::loadStatistics Enable loading of stats frame "
                      << frameIdx);
 
     // Reload the current frame (force a seek and decode operation)
-    int frameToLoad          = this->currentFrameIdx[0];
-    this->currentFrameIdx[0] = -1;
+    int frameToLoad          = this->loadingContext.currentFrameIdx;
+    this->loadingContext.currentFrameIdx = -1;
     this->loadRawData(frameToLoad, false);
 
     // The statistics should now be loaded
   }
-  else if (frameIdx != this->currentFrameIdx[0])
+  else if (frameIdx != this->loadingContext.currentFrameIdx)
   {
     // If the requested frame is not currently decoded, decode it.
     // This can happen if the picture was gotten from the cache.
@@ -1134,7 +1256,8 @@ ValuePairListSets playlistItemCompressedVideo::getPixelValues(const QPoint &pixe
   ValuePairListSets newSet;
 
   newSet.append("YUV", this->video->getPixelValues(pixelPos, frameIdx));
-  if (this->loadingDecoder->statisticsSupported() && this->loadingDecoder->statisticsEnabled())
+  const auto dec = this->loadingContext.decoder.get();
+  if (dec->statisticsSupported() && dec->statisticsEnabled())
     newSet.append("Stats", this->statisticsData.getValuesAt(pixelPos));
 
   return newSet;
@@ -1222,13 +1345,27 @@ void playlistItemCompressedVideo::reloadItemSource()
 
 void playlistItemCompressedVideo::cacheFrame(int frameIdx, bool testMode)
 {
-  if (!this->cachingEnabled)
+  if (!this->cachingEnabled || this->cachingContexts.empty())
     return;
 
-  // Cache a certain frame. This is always called in a separate thread.
-  this->cachingMutex.lock();
-  this->video->cacheFrame(frameIdx, testMode);
-  this->cachingMutex.unlock();
+  // Cache a certain frame. This is always called in a separate thread. Decode the frame in one of
+  // the caching contexts and put the raw data directly into the cache of the video handler.
+  auto &context = this->acquireCachingContext(frameIdx);
+  if (this->decodeFrame(context, frameIdx) && !testMode)
+    this->video->cacheRawFrame(frameIdx, getRawFrameFromDecoder(*context.decoder));
+  this->releaseCachingContext(context);
+}
+
+std::vector<int> playlistItemCompressedVideo::getCachingSegmentStarts() const
+{
+  if (!this->inputFileAnnexBParser)
+    return this->cachingSegmentStarts;
+
+  // The index of annexB files might still grow so we always get the current list
+  std::vector<int> segmentStarts;
+  for (const auto frameIdx : this->inputFileAnnexBParser->getRandomAccessPoints())
+    segmentStarts.push_back(int(frameIdx));
+  return segmentStarts;
 }
 
 void playlistItemCompressedVideo::loadFrame(int  frameIdx,
@@ -1285,26 +1422,34 @@ void playlistItemCompressedVideo::loadFrame(int  frameIdx,
 
 void playlistItemCompressedVideo::displaySignalComboBoxChanged(int idx)
 {
-  if (this->loadingDecoder && idx != this->loadingDecoder->getDecodeSignal())
+  if (this->loadingContext.decoder && idx != this->loadingContext.decoder->getDecodeSignal())
   {
     bool resetDecoder = false;
-    this->loadingDecoder->setDecodeSignal(idx, resetDecoder);
-    this->cachingDecoder->setDecodeSignal(idx, resetDecoder);
+    bool resetCachingDecoder = false;
+    this->loadingContext.decoder->setDecodeSignal(idx, resetDecoder);
+    for (auto &context : this->cachingContexts)
+      context->decoder->setDecodeSignal(idx, resetCachingDecoder);
 
     if (resetDecoder)
     {
-      this->loadingDecoder->resetDecoder();
-      this->cachingDecoder->resetDecoder();
-
-      // Reset the decoded frame indices so that decoding of the current frame is triggered
-      this->currentFrameIdx[0] = -1;
-      this->currentFrameIdx[1] = -1;
+      this->loadingContext.decoder->resetDecoder();
+      // Reset the decoded frame index so that decoding of the current frame is triggered
+      this->loadingContext.currentFrameIdx = -1;
+    }
+    if (resetCachingDecoder)
+    {
+      QMutexLocker locker(&this->cachingMutex);
+      for (auto &context : this->cachingContexts)
+      {
+        context->decoder->resetDecoder();
+        context->currentFrameIdx = -1;
+      }
     }
 
     // A different display signal was chosen. Invalidate the cache and signal that we will need a
     // redraw.
     auto yuvVideo = dynamic_cast<video::yuv::videoHandlerYUV *>(this->video.get());
-    yuvVideo->showPixelValuesAsDiff = this->loadingDecoder->isSignalDifference(idx);
+    yuvVideo->showPixelValuesAsDiff = this->loadingContext.decoder->isSignalDifference(idx);
     yuvVideo->invalidateAllBuffers();
 
     emit SignalItemChanged(true, RECACHE_CLEAR);
@@ -1323,23 +1468,26 @@ void playlistItemCompressedVideo::decoderComboxBoxChanged(int idx)
     // A different display signal was chosen. Invalidate the cache and signal that we will need a
     // redraw.
     auto yuvVideo = dynamic_cast<video::yuv::videoHandlerYUV *>(this->video.get());
-    if (this->loadingDecoder)
-      yuvVideo->showPixelValuesAsDiff = this->loadingDecoder->isSignalDifference(idx);
+    if (this->loadingContext.decoder)
+      yuvVideo->showPixelValuesAsDiff = this->loadingContext.decoder->isSignalDifference(idx);
     yuvVideo->invalidateAllBuffers();
 
     // Reset the decoded frame indices so that decoding of the current frame is triggered
-    this->currentFrameIdx[0] = -1;
-    this->currentFrameIdx[1] = -1;
-
-    this->decodingNotPossibleAfter = -1;
+    this->loadingContext.currentFrameIdx          = -1;
+    this->loadingContext.decodingNotPossibleAfter = -1;
+    for (auto &context : this->cachingContexts)
+    {
+      context->currentFrameIdx          = -1;
+      context->decodingNotPossibleAfter = -1;
+    }
 
     // Update the list of display signals
-    if (this->loadingDecoder)
+    if (this->loadingContext.decoder)
     {
       QSignalBlocker block(ui.comboBoxDisplaySignal);
       ui.comboBoxDisplaySignal->clear();
-      ui.comboBoxDisplaySignal->addItems(this->loadingDecoder->getSignalNames());
-      ui.comboBoxDisplaySignal->setCurrentIndex(this->loadingDecoder->getDecodeSignal());
+      ui.comboBoxDisplaySignal->addItems(this->loadingContext.decoder->getSignalNames());
+      ui.comboBoxDisplaySignal->setCurrentIndex(this->loadingContext.decoder->getDecodeSignal());
     }
 
     // Update the statistics list with what the new decoder can provide
@@ -32,6 +32,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+
+#include <QBasicTimer>
+#include <QFuture>
+#include <QWaitCondition>
+
 #include <common/Typedef.h>
 #include <decoder/decoderBase.h>
 #include <filesource/FileSourceFFmpegFile.h>
@@ -62,6 +69,7 @@ public:
                               int                    displayComponent = 0,
                               InputFormat            input            = InputFormat::Invalid,
                               decoder::DecoderEngine decoder = decoder::DecoderEngine::Invalid);
+  virtual ~playlistItemCompressedVideo();
 
   // Save the compressed file element to the given XML structure.
   virtual void savePlaylist(QDomElement &root, const QDir &playlistDir) const override;
@@ -105,26 +113,58 @@ public:
   virtual bool isLoading() const override { return isFrameLoading; }
   virtual bool isLoadingDoubleBuffer() const override { return isFrameLoadingDoubleBuffer; }
 
-  // Cache the frame with the given index.
-  // For all compressed items, a mutex must be locked when caching a frame (only one frame can be
-  // cached at a time because we only have one decoder).
+  // Cache the frame with the given index. The frame is decoded by one of the caching decoders. We
+  // pick the one that can get to the frame with the least effort (ideally by just decoding the
+  // next frame). If all caching decoders are busy, this blocks until one is free.
   void cacheFrame(int idx, bool testMode) override;
 
-  // We only have one caching decoder so it is better if only one thread caches frames from this
-  // item. This way, the frames will always be cached in the right order and no unnecessary decoding
-  // is performed.
-  virtual int cachingThreadLimit() override { return 1; }
+  // Every caching decoder can be used by one thread at a time. The random access points are where
+  // the caching decoders can start decoding independently. So each caching thread works on its own
+  // part of the stream and within that part, the frames are cached in order.
+  virtual int cachingThreadLimit() override
+  {
+    return std::max(int(this->cachingContexts.size()), 1);
+  }
+  virtual std::vector<int> getCachingSegmentStarts() const override;
 
   InputFormat getInputFormat() const { return this->inputFormat; }
 
 protected:
   virtual void createPropertiesWidget() override;
 
-  // We allocate two decoder: One for loading images in the foreground and one for caching in the
-  // background. This is better if random access and linear decoding (caching) is performed at the
-  // same time.
-  std::unique_ptr<decoder::decoderBase> loadingDecoder;
-  std::unique_ptr<decoder::decoderBase> cachingDecoder;
+  // Everything that is needed to decode frames: The decoder, the input file and the current
+  // position in the file. There is one context for loading images in the foreground and multiple
+  // contexts for caching in the background. This is better if random access and linear decoding
+  // (caching) is performed at the same time and it allows caching different parts of the stream in
+  // parallel.
+  struct DecodingContext
+  {
+    std::unique_ptr<decoder::decoderBase> decoder;
+    // Depending on the input format, one of these is used. Raw annexB files also need the parser
+    // (inputFileAnnexBParser), which is shared by all contexts.
+    std::unique_ptr<FileSourceAnnexBFile> inputFileAnnexB;
+    std::unique_ptr<FileSourceFFmpegFile> inputFileFFmpeg;
+    // The index of the frame that the decoder returned last
+    int currentFrameIdx{-1};
+    // When reading annex B data using the FileSourceAnnexBFile::getFrameData function, we need to
+    // count how many frames we already read.
+    int readAnnexBFrameCounterCodingOrder{-1};
+    // For certain decoders (FFmpeg or HM), pushing data may fail. The decoder may or may not switch
+    // to retrieveing mode. In this case, we must re-push the packet for which pushing failed.
+    bool repushData{};
+    // Is a caching thread currently decoding with this context? (Protected by cachingMutex)
+    bool inUse{};
+    // If the bitstream is invalid (for example it was cut at a position that it should not be cut
+    // at), the decoder might be unable to decode some of the frames at the end of the sequence.
+    // This is only reset when the context seeks. For the loading context, it is also read from
+    // the main thread.
+    std::atomic_int decodingNotPossibleAfter{-1};
+  };
+  DecodingContext                               loadingContext;
+  std::vector<std::unique_ptr<DecodingContext>> cachingContexts;
+  // The key frames of FFmpeg files where a caching decoder can start decoding. For raw annexB
+  // files, the random access points are taken from the (growing) index instead.
+  std::vector<int> cachingSegmentStarts;
 
   // When opening the file, we will fill this list with the possible decoders
   std::vector<decoder::DecoderEngine> possibleDecoders;
@@ -132,35 +172,46 @@ protected:
   decoder::DecoderEngine decoderEngine{decoder::DecoderEngine::Invalid};
   // Delete existing decoders and allocate decoders for the type "decoderEngineType"
   bool allocateDecoder(int displayComponent = 0);
+  std::unique_ptr<decoder::decoderBase>
+  createDecoder(const DecodingContext &context, int displayComponent, bool cachingDecoder);
 
   // In order to parse raw annexB files, we need a file reader (that can read NAL units)
-  // and a parser that can understand what the NAL units mean. We open the file source twice (once
-  // for interactive loading, once for the background caching). The parser is only needed once and
-  // can be used for both loading and caching tasks.
-  std::unique_ptr<FileSourceAnnexBFile> inputFileAnnexBLoading;
-  std::unique_ptr<FileSourceAnnexBFile> inputFileAnnexBCaching;
+  // and a parser that can understand what the NAL units mean. Every decoding context opens the file
+  // itself. The parser is only needed once and can be used for both loading and caching tasks.
   std::unique_ptr<parser::ParserAnnexB> inputFileAnnexBParser;
-  // When reading annex B data using the FileSourceAnnexBFile::getFrameData function, we need to
-  // count how many frames we already read.
-  int readAnnexBFrameCounterCodingOrder{-1};
+
+  // The frame index of raw annexB files is built in the background. The item can already be used
+  // while this is running. The indexing uses its own file source.
+  std::unique_ptr<FileSourceAnnexBFile> indexingFile;
+  QFuture<void>                         indexingFuture;
+  std::atomic_bool                      breakIndexingAtomic{false};
+  void                                  startBackgroundIndexing();
+  // The range of frames from the index that can be used right now
+  indexRange getIndexedFrameRange() const;
+
+  // A timer is used to frequently update the number of frames while indexing (every second)
+  QBasicTimer  indexingTimer;
+  virtual void timerEvent(QTimerEvent *event) override;
 
   // Which type is the input?
   InputFormat              inputFormat;
   FFmpeg::AVCodecIDWrapper ffmpegCodec;
 
-  // For FFMpeg files we don't need a reader to parse them. But if the container contains a
-  // supported format, we can read the NAL units from the compressed file.
-  std::unique_ptr<FileSourceFFmpegFile> inputFileFFmpegLoading;
-  std::unique_ptr<FileSourceFFmpegFile> inputFileFFmpegCaching;
-
   // Is the loadFrame function currently loading?
   bool isFrameLoading{};
   bool isFrameLoadingDoubleBuffer{};
 
-  // Only cache one frame at a time. Caching should also always be done in display order of the
-  // frames.
-  // TODO: Could we somehow make shure that caching is always performed in display order?
-  QMutex cachingMutex;
+  // Protects the selection of a caching context. If all caching contexts are in use, a caching
+  // thread waits for cachingContextReleased.
+  QMutex         cachingMutex;
+  QWaitCondition cachingContextReleased;
+
+  // Open the input file once for every caching context. This must be done after the file was
+  // opened for loading (the FFmpeg file can then reuse the loaded libraries).
+  bool openCachingContexts(const QString &compressedFilePath);
+  // Get a caching context for decoding the given frame and mark it as used.
+  DecodingContext &acquireCachingContext(int frameIdx);
+  void             releaseCachingContext(DecodingContext &context);
 
   stats::StatisticUIHandler statisticsUIHandler;
   stats::StatisticsData     statisticsData;
@@ -170,16 +221,13 @@ protected:
 
   SafeUi<Ui::playlistItemCompressedFile_Widget> ui;
 
-  // The current frame index of the decoders (interactive/caching)
-  int currentFrameIdx[2]{-1, -1};
-
-  // Seek the input file to the given position, reset the decoder and prepare it to start decoding
-  // from the given position.
-  void seekToPosition(int seekToFrame, int64_t seekToDTS, bool caching);
+  // Seek the input file of the context to the given position, reset the decoder and prepare it to
+  // start decoding from the given position.
+  void seekToPosition(DecodingContext &context, int seekToFrame, int64_t seekToDTS);
 
-  // For certain decoders (FFmpeg or HM), pushing data may fail. The decoder may or may not switch
-  // to retrieveing mode. In this case, we must re-push the packet for which pushing failed.
-  bool repushData{};
+  // Decode the given frame using the given context. Returns true if the frame was decoded. Its raw
+  // data can then be retrieved from the decoder of the context.
+  bool decodeFrame(DecodingContext &context, int frameIdx);
 
   // Besides the normal stats (error / no error) this item might be able to parse the file but not
   // to decode it.
@@ -190,9 +238,8 @@ protected:
   }
   bool decodingEnabled{};
 
-  // If the bitstream is invalid (for example it was cut at a position that it should not be cut
-  // at), we might be unable to decode some of the frames at the end of the sequence.
-  int decodingNotPossibleAfter{-1};
+  // Can the loading context not decode the given frame because the bitstream is invalid?
+  bool isDecodingNotPossible(int frameIdx) const;
 
 private slots:
   // Load the raw (YUV or RGN) data for the given frame index from file. This slot is called by the
@@ -32,9 +32,21 @@
 
 #include "playlistItemDifference.h"
 
+#include <QComboBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QGroupBox>
+#include <QMessageBox>
 #include <QPainter>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QSettings>
+#include <QtConcurrent>
 
 #include <common/FunctionsGui.h>
+#include <ui/views/PlotViewWidget.h>
+
+#include <cmath>
 
 // Activate this if you want to know when which difference is loaded
 #define PLAYLISTITEMDIFFERENCE_DEBUG_LOADING 0
@@ -60,6 +72,7 @@ playlistItemDifference::playlistItemDifference() : playlistItemContainer("Differ
   this->maxItemCount   = 2;
   this->frameLimitsMax = false;
   this->infoText       = DIFFERENCE_INFO_TEXT;
+  this->cachingEnabled = true;
 
   connect(&difference,
           &video::videoHandlerDifference::signalHandlerChanged,
@@ -67,6 +80,11 @@ playlistItemDifference::playlistItemDifference() : playlistItemContainer("Differ
           &playlistItemDifference::SignalItemChanged);
 }
 
+playlistItemDifference::~playlistItemDifference()
+{
+  this->abortObjectiveMetricsCalculation();
+}
+
 /* For a difference item, the info list is just a list of the names of the
  * child elements.
  */
@@ -89,6 +107,20 @@ InfoData playlistItemDifference::getInfo() const
     info.items.append(p);
   }
 
+  // Report the mean of the objective metrics over all frames (if they were calculated)
+  if (auto mean = difference.getObjectiveMetricsPlotModel()->getMeanMetrics())
+  {
+    auto formatPSNR = [](const double psnr) {
+      return std::isinf(psnr) ? std::string("identical") : std::to_string(psnr) + " dB";
+    };
+    info.items.append(InfoItem("Mean PSNR Y", formatPSNR(mean->psnr[0])));
+    info.items.append(InfoItem("Mean PSNR U", formatPSNR(mean->psnr[1])));
+    info.items.append(InfoItem("Mean PSNR V", formatPSNR(mean->psnr[2])));
+    info.items.append(InfoItem("Mean PSNR YUV", formatPSNR(mean->weightedPSNR)));
+    info.items.append(InfoItem("Mean SSIM Y", std::to_string(mean->ssim)));
+    info.items.append(InfoItem("Mean MS-SSIM Y", std::to_string(mean->msssim)));
+  }
+
   return info;
 }
 
@@ -167,10 +199,168 @@ void playlistItemDifference::createPropertiesWidget()
   vAllLaout->addLayout(difference.createFrameHandlerControls(true));
   vAllLaout->addWidget(line.release());
   vAllLaout->addLayout(difference.createDifferenceHandlerControls());
+  vAllLaout->addWidget(this->createObjectiveMetricsControls());
 
   vAllLaout->insertStretch(-1, 1); // Push controls up
 }
 
+QWidget *playlistItemDifference::createObjectiveMetricsControls()
+{
+  auto groupBox = new QGroupBox("Objective metrics (all frames)");
+  groupBox->setToolTip("Calculate the PSNR, SSIM and MS-SSIM of all frames of the two items");
+  auto layout = new QVBoxLayout(groupBox);
+
+  auto &controls           = this->objectiveMetricsControls;
+  controls.calculateButton = new QPushButton();
+  controls.exportButton    = new QPushButton("Export CSV");
+  auto buttonLayout        = new QHBoxLayout();
+  buttonLayout->addWidget(controls.calculateButton);
+  buttonLayout->addWidget(controls.exportButton);
+  layout->addLayout(buttonLayout);
+
+  controls.metricComboBox = new QComboBox();
+  for (const auto &name : video::ObjectiveMetricMapper.getNames())
+    controls.metricComboBox->addItem(QString::fromStdString(std::string(name)));
+  controls.metricComboBox->setCurrentIndex(int(video::ObjectiveMetricMapper.indexOf(
+      this->difference.getObjectiveMetricsPlotModel()->getShownMetric())));
+  layout->addWidget(controls.metricComboBox);
+
+  controls.progressBar = new QProgressBar();
+  layout->addWidget(controls.progressBar);
+
+  controls.plotView = new PlotViewWidget();
+  controls.plotView->setMinimumHeight(200);
+  controls.plotView->setModel(this->difference.getObjectiveMetricsPlotModel());
+  layout->addWidget(controls.plotView);
+
+  connect(controls.calculateButton,
+          &QPushButton::clicked,
+          this,
+          &playlistItemDifference::onCalculateObjectiveMetricsClicked);
+  connect(controls.exportButton,
+          &QPushButton::clicked,
+          this,
+          &playlistItemDifference::onExportObjectiveMetricsClicked);
+  connect(controls.metricComboBox,
+          QOverload<int>::of(&QComboBox::currentIndexChanged),
+          this,
+          &playlistItemDifference::onShownObjectiveMetricChanged);
+
+  this->updateObjectiveMetricsControls();
+  return groupBox;
+}
+
+void playlistItemDifference::updateObjectiveMetricsControls()
+{
+  auto &controls = this->objectiveMetricsControls;
+  if (!controls.calculateButton)
+    return;
+
+  const auto isRunning = this->objectiveMetricsFuture.isRunning();
+  const auto nrFrames  = this->difference.getObjectiveMetricsPlotModel()->getNrFrames();
+  const auto nrFramesInRange =
+      std::max(this->objectiveMetricsRange.second - this->objectiveMetricsRange.first + 1, 0);
+
+  const auto canCalculate = (childCount() == 2 && this->difference.inputsValid());
+
+  controls.calculateButton->setText(isRunning ? "Abort" : "Calculate");
+  controls.calculateButton->setEnabled(isRunning || canCalculate);
+  controls.exportButton->setEnabled(!isRunning && nrFrames > 0);
+  controls.progressBar->setRange(0, std::max(nrFramesInRange, 1));
+  controls.progressBar->setValue(std::min(int(nrFrames), nrFramesInRange));
+
+  if (!this->objectiveMetricsError.empty())
+    controls.progressBar->setToolTip(QString::fromStdString(this->objectiveMetricsError));
+  else
+    controls.progressBar->setToolTip({});
+}
+
+void playlistItemDifference::onCalculateObjectiveMetricsClicked()
+{
+  if (this->objectiveMetricsFuture.isRunning())
+  {
+    this->abortObjectiveMetricsCalculation();
+    this->updateObjectiveMetricsControls();
+    return;
+  }
+
+  if (childCount() != 2 || !this->difference.inputsValid())
+    return;
+
+  this->difference.getObjectiveMetricsPlotModel()->clear();
+  this->objectiveMetricsRange = this->properties().startEndRange;
+  this->objectiveMetricsError.clear();
+  this->abortObjectiveMetrics.store(false);
+
+  this->objectiveMetricsFuture = QtConcurrent::run([this, range = this->objectiveMetricsRange]() {
+    std::string errorMessage;
+    this->difference.calculateObjectiveMetrics(range, this->abortObjectiveMetrics, errorMessage);
+    return errorMessage;
+  });
+  this->objectiveMetricsTimer.start(500, this);
+  this->updateObjectiveMetricsControls();
+}
+
+void playlistItemDifference::onExportObjectiveMetricsClicked()
+{
+  QSettings settings;
+  auto      filename = QFileDialog::getSaveFileName(nullptr,
+                                               "Export Objective Metrics",
+                                               settings.value("LastMetricsExportPath").toString(),
+                                               "CSV Files (*.csv)");
+  if (filename.isEmpty())
+    return;
+  if (!filename.endsWith(".csv", Qt::CaseInsensitive))
+    filename += ".csv";
+
+  settings.setValue("LastMetricsExportPath", filename.section('/', 0, -2));
+
+  QFile file(filename);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+  {
+    QMessageBox::warning(nullptr, "Export Objective Metrics", "Opening the output file failed.");
+    return;
+  }
+  const auto csv = this->difference.getObjectiveMetricsPlotModel()->getCSV();
+  file.write(csv.data(), qint64(csv.size()));
+}
+
+void playlistItemDifference::onShownObjectiveMetricChanged(int index)
+{
+  if (auto metric = video::ObjectiveMetricMapper.at(size_t(index)))
+    this->difference.getObjectiveMetricsPlotModel()->setShownMetric(*metric);
+}
+
+void playlistItemDifference::abortObjectiveMetricsCalculation()
+{
+  if (this->objectiveMetricsFuture.isRunning())
+  {
+    this->abortObjectiveMetrics.store(true);
+    this->objectiveMetricsFuture.waitForFinished();
+  }
+}
+
+void playlistItemDifference::timerEvent(QTimerEvent *event)
+{
+  if (event->timerId() != this->objectiveMetricsTimer.timerId())
+    return playlistItemContainer::timerEvent(event);
+
+  if (!this->objectiveMetricsFuture.isRunning())
+  {
+    this->objectiveMetricsTimer.stop();
+    this->objectiveMetricsError = this->objectiveMetricsFuture.result();
+    if (!this->objectiveMetricsError.empty() && !this->abortObjectiveMetrics.load())
+      QMessageBox::warning(nullptr,
+                           "Objective Metrics",
+                           QString::fromStdString(this->objectiveMetricsError));
+
+    // Update the mean values in the info panel
+    emit SignalItemChanged(false, RECACHE_NONE);
+  }
+
+  this->updateObjectiveMetricsControls();
+}
+
 void playlistItemDifference::savePlaylist(QDomElement &root, const QDir &playlistDir) const
 {
   YUViewDomElement d = root.ownerDocument().createElement("playlistItemDifference");
@@ -270,7 +460,15 @@ bool playlistItemDifference::isLoadingDoubleBuffer() const
 void playlistItemDifference::childChanged(bool redraw, recacheIndicator recache)
 {
   // One of the child items changed and needs to redraw. This means that the difference is out of
-  // date and has to be recalculated.
-  difference.invalidateAllBuffers();
+  // date and has to be recalculated. The cached difference frames are only cleared if the cache of
+  // the child is cleared (this is passed on to the video cache below).
+  difference.inputChanged(recache);
+
+  // If the frames of a child changed, the objective metrics calculation uses outdated frames
+  if (recache != RECACHE_NONE)
+  {
+    this->abortObjectiveMetricsCalculation();
+    this->updateObjectiveMetricsControls();
+  }
   playlistItemContainer::childChanged(redraw, recache);
 }
\ No newline at end of file
@@ -35,12 +35,24 @@
 #include "playlistItemContainer.h"
 #include "video/videoHandlerDifference.h"
 
+#include <QBasicTimer>
+#include <QFuture>
+#include <QPointer>
+
+#include <atomic>
+
+class PlotViewWidget;
+class QComboBox;
+class QProgressBar;
+class QPushButton;
+
 class playlistItemDifference : public playlistItemContainer
 {
   Q_OBJECT
 
 public:
   playlistItemDifference();
+  virtual ~playlistItemDifference();
 
   virtual InfoData getInfo() const override;
   virtual QSize    getSize() const override;
@@ -60,6 +72,33 @@ public:
   virtual bool isLoading() const override;
   virtual bool isLoadingDoubleBuffer() const override;
 
+  // -- Caching
+  // The difference frames can be cached in the background if the difference is calculated from
+  // two YUV items.
+  virtual bool isCachable() const override
+  {
+    return playlistItem::isCachable() && childCount() == 2 && difference.isCachingSupported();
+  }
+  virtual void cacheFrame(int frameIdx, bool testMode) override
+  {
+    if (this->isCachable())
+      difference.cacheFrame(frameIdx, testMode);
+  }
+  virtual QList<int> getCachedFrames() const override { return difference.getCachedFrames(); }
+  virtual int        getNumberCachedFrames() const override
+  {
+    return difference.getNumberCachedFrames();
+  }
+  virtual unsigned int getCachingFrameSize() const override
+  {
+    return difference.getCachingFrameSize();
+  }
+  virtual void removeFrameFromCache(int frameIdx) override
+  {
+    difference.removeFrameFromCache(frameIdx);
+  }
+  virtual void removeAllFramesFromCache() override { difference.removeAllFrameFromCache(); }
+
   // Overload from playlistItem. Save the playlist item to playlist.
   virtual void savePlaylist(QDomElement &root, const QDir &playlistDir) const override;
   // Create a new playlistItemDifference from the playlist file entry. Return nullptr if parsing
@@ -75,13 +114,44 @@ public:
 protected slots:
   virtual void childChanged(bool redraw, recacheIndicator recache) override;
 
+private slots:
+  void onCalculateObjectiveMetricsClicked();
+  void onExportObjectiveMetricsClicked();
+  void onShownObjectiveMetricChanged(int index);
+
 private:
   // Overload from playlistItem. Create a properties widget custom to the playlistItemDifference
   // and set propertiesWidget to point to it.
   virtual void createPropertiesWidget() override;
 
+  QWidget *createObjectiveMetricsControls();
+  void     updateObjectiveMetricsControls();
+
   video::videoHandlerDifference difference;
 
   bool isDifferenceLoading{};
   bool isDifferenceLoadingToDoubleBuffer{};
+
+  // The objective metrics of all frames are calculated in the background. A timer is used to update
+  // the progress while the calculation is running. The result of the future is the error message
+  // (empty if there was no error). It is only copied to objectiveMetricsError in the main thread
+  // once the calculation finished.
+  void abortObjectiveMetricsCalculation();
+  void timerEvent(QTimerEvent *event) override;
+
+  QFuture<std::string> objectiveMetricsFuture;
+  std::atomic_bool     abortObjectiveMetrics{};
+  QBasicTimer          objectiveMetricsTimer;
+  indexRange           objectiveMetricsRange;
+  std::string          objectiveMetricsError;
+
+  struct ObjectiveMetricsControls
+  {
+    QPointer<QPushButton>    calculateButton;
+    QPointer<QPushButton>    exportButton;
+    QPointer<QComboBox>      metricComboBox;
+    QPointer<QProgressBar>   progressBar;
+    QPointer<PlotViewWidget> plotView;
+  };
+  ObjectiveMetricsControls objectiveMetricsControls;
 };
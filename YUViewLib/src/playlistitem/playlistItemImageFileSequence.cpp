@@ -288,6 +288,7 @@ void playlistItemImageFileSequence::slotFrameRequest(int frameIdx, bool)
     return;
 
   // Load the given frame
+  video::ScopedLatencyTimer readTimer(&video->cacheStatistics, video::LoadingStage::Read);
   video->requestedFrame     = QImage(imageFiles[frameIdx]);
   video->requestedFrame_idx = frameIdx;
 }
@@ -40,6 +40,7 @@
 #include <common/FunctionsGui.h>
 #include <filesource/GuessFormatFromName.h>
 #include <handler/ItemMemoryHandler.h>
+#include <video/FrameBufferPool.h>
 
 // Activate this if you want to know when which buffer is loaded/converted to image and so on.
 #define PLAYLISTITEMRAWFILE_DEBUG_LOADING 0
@@ -90,6 +91,8 @@ playlistItemRawFile::playlistItemRawFile(const QString &rawFilePath,
     return;
   }
 
+  this->openMappedFile();
+
   Size frameSize;
   if (qFrameSize.width() > 0 && qFrameSize.height() > 0)
     frameSize = Size(qFrameSize.width(), qFrameSize.height());
@@ -156,6 +159,12 @@ playlistItemRawFile::playlistItemRawFile(const QString &rawFilePath,
           this,
           &playlistItemRawFile::loadRawData,
           Qt::DirectConnection);
+  if (this->rawFormat == video::RawFormat::YUV)
+    connect(this->getYUVVideo(),
+            &video::yuv::videoHandlerYUV::signalRequestRawDataRanges,
+            this,
+            &playlistItemRawFile::loadRawDataRanges,
+            Qt::DirectConnection);
 
   // Connect the basic signals from the video
   playlistItemWithVideo::connectVideo();
@@ -536,29 +545,103 @@ playlistItemRawFile *playlistItemRawFile::newplaylistItemRawFile(const YUViewDom
   return newFile;
 }
 
-void playlistItemRawFile::loadRawData(int frameIdx)
+void playlistItemRawFile::loadRawData(int frameIdx, bool caching)
 {
   if (!this->video->isFormatValid())
     return;
 
-  auto nrBytes = this->video->getBytesPerFrame();
+  video::ScopedLatencyTimer readTimer(&this->video->cacheStatistics, video::LoadingStage::Read);
+  auto                      nrBytes = this->video->getBytesPerFrame();
 
   // Load the raw data for the given frameIdx from file and set it in the video
-  int64_t fileStartPos;
-  if (this->isY4MFile)
-    fileStartPos = this->y4mFrameIndices.at(frameIdx);
-  else
-    fileStartPos = frameIdx * nrBytes;
+  const auto fileStartPos = this->getFrameStartPos(frameIdx);
 
   DEBUG_RAWFILE("playlistItemRawFile::loadRawData Start loading frame " << frameIdx << " bytes "
                                                                         << int(nrBytes));
-  if (this->dataSource.readBytes(this->video->rawData, fileStartPos, nrBytes) < nrBytes)
-    return; // Error
+  this->video->rawFrameView = {};
+  this->video->rawData.clear();
+  if (this->mappedFile && !caching)
+  {
+    // No copy. The view points directly into the mapped file and keeps the mapping alive for as
+    // long as the frame is used. This is only done for the frame that is drawn. A cached frame must
+    // be resident in memory and an access to the mapping of a file that was truncated in the
+    // meantime fails with SIGBUS. For cached frames, the read below fails at load time instead.
+    if (const auto data = this->mappedFile->getMappedData(fileStartPos, nrBytes))
+      this->video->rawFrameView = video::RawFrameView(data, size_t(nrBytes), this->mappedFile);
+    else
+      DEBUG_RAWFILE("playlistItemRawFile::loadRawData Frame not in mapped file. Reading it.");
+  }
+  if (this->video->rawFrameView.isEmpty())
+  {
+    // Read into a buffer from the pool. When the frame is evicted from the cache, the buffer goes
+    // back into the pool and is reused for the next frame.
+    auto buffer = video::FrameBufferPool::shared().allocate(size_t(nrBytes));
+    if (this->dataSource.readBytes(reinterpret_cast<char *>(buffer.get()), fileStartPos, nrBytes) <
+        nrBytes)
+      return; // Error
+    this->video->rawFrameView = video::RawFrameView(buffer.get(), size_t(nrBytes), buffer);
+  }
   this->video->rawData_frameIndex = frameIdx;
 
   DEBUG_RAWFILE("playlistItemRawFile::loadRawData Frame " << frameIdx << " loaded");
 }
 
+void playlistItemRawFile::loadRawDataRanges(int                                     frameIdx,
+                                            const std::vector<video::yuv::ByteRange> &ranges)
+{
+  if (!this->video->isFormatValid())
+    return;
+
+  video::ScopedLatencyTimer readTimer(&this->video->cacheStatistics, video::LoadingStage::Read);
+  const auto                fileStartPos = this->getFrameStartPos(frameIdx);
+
+  DEBUG_RAWFILE("playlistItemRawFile::loadRawDataRanges Start loading frame " << frameIdx);
+  auto &rawData                  = this->video->rawData;
+  this->video->rawData_frameIndex = -1;
+  this->video->rawFrameView       = {};
+  rawData.clear();
+  QByteArray rangeData;
+  for (const auto &range : ranges)
+  {
+    if (this->mappedFile)
+    {
+      if (const auto data =
+              this->mappedFile->getMappedData(fileStartPos + range.offset, range.size))
+      {
+        rawData.append(reinterpret_cast<const char *>(data), int(range.size));
+        continue;
+      }
+      DEBUG_RAWFILE("playlistItemRawFile::loadRawDataRanges Range not in mapped file. Reading it.");
+    }
+    if (this->dataSource.readBytes(rangeData, fileStartPos + range.offset, range.size) < range.size)
+      return; // Error
+    rawData.append(rangeData);
+  }
+  this->video->rawData_frameIndex = frameIdx;
+
+  DEBUG_RAWFILE("playlistItemRawFile::loadRawDataRanges Frame " << frameIdx << " loaded");
+}
+
+int64_t playlistItemRawFile::getFrameStartPos(int frameIdx) const
+{
+  if (this->isY4MFile)
+    return this->y4mFrameIndices.at(frameIdx);
+  return frameIdx * this->video->getBytesPerFrame();
+}
+
+void playlistItemRawFile::openMappedFile()
+{
+  // Frames that still point into the previous mapping keep it alive until they are dropped
+  this->mappedFile.reset();
+
+  auto newMappedFile = std::make_shared<filesource::DataSourceMemoryMappedFile>(
+      std::filesystem::path(this->dataSource.getAbsoluteFilePath()));
+  if (newMappedFile->isOk())
+    this->mappedFile = std::move(newMappedFile);
+  else
+    DEBUG_RAWFILE("playlistItemRawFile::openMappedFile Mapping failed. Using buffered reading.");
+}
+
 void playlistItemRawFile::slotVideoPropertiesChanged()
 {
   DEBUG_RAWFILE("playlistItemRawFile::slotVideoPropertiesChanged");
@@ -600,6 +683,7 @@ void playlistItemRawFile::reloadItemSource()
     return;
 
   this->video->invalidateAllBuffers();
+  this->openMappedFile();
   this->updateStartEndRange();
 
   // Emit that the item needs redrawing and the cache changed.
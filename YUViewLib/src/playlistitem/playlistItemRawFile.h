@@ -33,6 +33,7 @@
 #pragma once
 
 #include <common/Typedef.h>
+#include <filesource/DataSourceMemoryMappedFile.h>
 #include <filesource/FileSource.h>
 
 #include <QFuture>
@@ -88,8 +89,11 @@ public:
 
 private slots:
   // Load the raw data for the given frame index from file. This slot is called by the videoHandler
-  // if the frame that is requested to be drawn has not been loaded yet.
-  void loadRawData(int frameIdx);
+  // if the frame that is requested to be drawn (or cached) has not been loaded yet.
+  void loadRawData(int frameIdx, bool caching);
+  // Load only the given byte ranges of the frame. This is used if only a small part of a very large
+  // frame is visible.
+  void loadRawDataRanges(int frameIdx, const std::vector<video::yuv::ByteRange> &ranges);
 
   void slotVideoPropertiesChanged();
 
@@ -104,9 +108,18 @@ private:
   virtual void createPropertiesWidget() override;
 
   int getNumberFrames() const;
+  int64_t getFrameStartPos(int frameIdx) const;
 
   FileSource dataSource;
 
+  // If the file can be mapped into memory, the frames that are loaded for drawing are passed to the
+  // video handler directly from the mapped file (without reading or copying). Otherwise, and for
+  // the frames that are cached, they are read from dataSource. Every frame view holds a reference
+  // to the mapping, so if the file is reloaded, the previous mapping is released once the video
+  // handler dropped all frames that point into it.
+  void                                                    openMappedFile();
+  std::shared_ptr<filesource::DataSourceMemoryMappedFile> mappedFile;
+
   void updateStartEndRange() override;
 
   // A y4m file is a raw YUV file but it adds a header (which has information about the YUV format)
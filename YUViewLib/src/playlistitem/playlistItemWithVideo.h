@@ -93,6 +93,10 @@ public:
     if (video)
       video->removeAllFrameFromCache();
   }
+  virtual video::CacheStatistics *getCacheStatistics() override
+  {
+    return video ? &video->cacheStatistics : nullptr;
+  }
   // This item is cachable, if caching is enabled and if the raw format is valid (can be cached).
   virtual bool isCachable() const override
   {
@@ -32,6 +32,9 @@
 
 #include "FrameTypeData.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 namespace stats
 {
 
@@ -64,6 +67,8 @@ void FrameTypeData::addBlockVector(
   vec.point[0] = Point(vecX, vecY);
   vec.isLine   = false;
   vectorData.push_back(vec);
+
+  this->updateMaxAbsVectorValue(vecX, vecY);
 }
 
 void FrameTypeData::addBlockAffineTF(unsigned short x,
@@ -86,6 +91,10 @@ void FrameTypeData::addBlockAffineTF(unsigned short x,
   affineTF.point[1] = Point(vecX1, vecY1);
   affineTF.point[2] = Point(vecX2, vecY2);
   affineTFData.push_back(affineTF);
+
+  this->updateMaxAbsVectorValue(vecX0, vecY0);
+  this->updateMaxAbsVectorValue(vecX1, vecY1);
+  this->updateMaxAbsVectorValue(vecX2, vecY2);
 }
 
 void FrameTypeData::addLine(unsigned short x,
@@ -106,6 +115,9 @@ void FrameTypeData::addLine(unsigned short x,
   vec.point[1] = Point(x2, y2);
   vec.isLine   = true;
   vectorData.push_back(vec);
+
+  this->maxAbsLinePoint =
+      std::max({this->maxAbsLinePoint, std::abs(x1), std::abs(y1), std::abs(x2), std::abs(y2)});
 }
 
 void FrameTypeData::addPolygonValue(const Polygon &points, int val)
@@ -129,6 +141,29 @@ void FrameTypeData::addPolygonVector(const Polygon &points, int vecX, int vecY)
   vec.corners = points;
   vec.point   = Point(vecX, vecY);
   polygonVectorData.push_back(vec);
+
+  this->updateMaxAbsVectorValue(vecX, vecY);
+}
+
+void FrameTypeData::updateMaxAbsVectorValue(int vecX, int vecY)
+{
+  this->maxAbsVectorValue = std::max({this->maxAbsVectorValue, std::abs(vecX), std::abs(vecY)});
+}
+
+SampleRect FrameTypeData::getBounds(const Polygon &corners)
+{
+  if (corners.empty())
+    return {};
+
+  SampleRect bounds{corners[0].x, corners[0].y, corners[0].x + 1, corners[0].y + 1};
+  for (const auto &corner : corners)
+  {
+    bounds.left   = std::min(bounds.left, corner.x);
+    bounds.top    = std::min(bounds.top, corner.y);
+    bounds.right  = std::max(bounds.right, corner.x + 1);
+    bounds.bottom = std::max(bounds.bottom, corner.y + 1);
+  }
+  return bounds;
 }
 
 } // namespace stats
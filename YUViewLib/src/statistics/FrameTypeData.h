@@ -32,6 +32,8 @@
 
 #pragma once
 
+#include "SpatialIndex.h"
+
 #include <common/Typedef.h>
 
 namespace stats
@@ -144,6 +146,35 @@ public:
   void addPolygonVector(const Polygon &points, int vecX, int vecY);
   void addPolygonValue(const Polygon &points, int val);
 
+  // Call the function for every item which overlaps the given area (in samples). The spatial index
+  // of the items is built on the first call after items were added. The items are not reported in
+  // the order in which they were added.
+  template <typename Function>
+  void forEachValueIn(const SampleRect &area, Function function) const
+  {
+    forEachItemIn(this->valueData, this->valueIndex, area, function);
+  }
+  template <typename Function>
+  void forEachVectorIn(const SampleRect &area, Function function) const
+  {
+    forEachItemIn(this->vectorData, this->vectorIndex, area, function);
+  }
+  template <typename Function>
+  void forEachAffineTFIn(const SampleRect &area, Function function) const
+  {
+    forEachItemIn(this->affineTFData, this->affineTFIndex, area, function);
+  }
+  template <typename Function>
+  void forEachPolygonValueIn(const SampleRect &area, Function function) const
+  {
+    forEachItemIn(this->polygonValueData, this->polygonValueIndex, area, function);
+  }
+  template <typename Function>
+  void forEachPolygonVectorIn(const SampleRect &area, Function function) const
+  {
+    forEachItemIn(this->polygonVectorData, this->polygonVectorIndex, area, function);
+  }
+
   std::vector<StatsItemValue>         valueData;
   std::vector<StatsItemVector>        vectorData;
   std::vector<StatsItemAffineTF>      affineTFData;
@@ -153,6 +184,46 @@ public:
   // What is the size (area) of the biggest block)? This is needed for scaling the blocks according
   // to their size.
   unsigned maxBlockSize;
+
+  // The maximum absolute value of all vector components (block, affine and polygon vectors) and of
+  // all line points. Vectors and lines can reach outside of their block. When looking for the
+  // vectors in an area, the area must be extended by this.
+  int maxAbsVectorValue{};
+  int maxAbsLinePoint{};
+
+private:
+  void updateMaxAbsVectorValue(int vecX, int vecY);
+
+  template <typename Item, typename Function>
+  static void forEachItemIn(const std::vector<Item> &items,
+                            SpatialIndex            &index,
+                            const SampleRect        &area,
+                            Function                &function)
+  {
+    if (!index.isBuiltFor(items.size()))
+      index.build(items.size(), [&items](size_t i) { return getBounds(items[i]); });
+    index.forEachItemIn(
+        area,
+        [&items](size_t i) { return getBounds(items[i]); },
+        [&items, &function](size_t i) { function(items[i]); });
+  }
+
+  template <typename BlockItem> static SampleRect getBounds(const BlockItem &item)
+  {
+    return {item.pos[0], item.pos[1], item.pos[0] + item.size[0], item.pos[1] + item.size[1]};
+  }
+  static SampleRect getBounds(const Polygon &corners);
+  static SampleRect getBounds(const StatsItemPolygonValue &item) { return getBounds(item.corners); }
+  static SampleRect getBounds(const StatsItemPolygonVector &item)
+  {
+    return getBounds(item.corners);
+  }
+
+  mutable SpatialIndex valueIndex;
+  mutable SpatialIndex vectorIndex;
+  mutable SpatialIndex affineTFIndex;
+  mutable SpatialIndex polygonValueIndex;
+  mutable SpatialIndex polygonVectorIndex;
 };
 
 } // namespace stats
@@ -0,0 +1,210 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace stats
+{
+
+// A rectangle in samples. The right and bottom border are exclusive.
+struct SampleRect
+{
+  int left{};
+  int top{};
+  int right{};
+  int bottom{};
+
+  bool isEmpty() const { return this->right <= this->left || this->bottom <= this->top; }
+  bool intersects(const SampleRect &other) const
+  {
+    return this->left < other.right && other.left < this->right && this->top < other.bottom &&
+           other.top < this->bottom;
+  }
+};
+
+/* A uniform grid over a list of items (e.g. all value blocks of a FrameTypeData). Each cell of the
+ * grid holds the indices of all items which overlap the cell. This way only the items in a certain
+ * area (e.g. the visible part of the frame) have to be touched for painting or looking up values.
+ * The index does not hold the items itself. The bounds of an item are retrieved from the
+ * getBounds function which is called with the index of the item.
+ */
+class SpatialIndex
+{
+public:
+  bool isBuiltFor(size_t nrItems) const { return this->built && this->nrItems == nrItems; }
+
+  template <typename GetBounds> void build(size_t nrItems, GetBounds getBounds)
+  {
+    this->built   = true;
+    this->nrItems = nrItems;
+    this->cellStart.clear();
+    this->cellItems.clear();
+    this->nrCellsX = 0;
+    this->nrCellsY = 0;
+    if (nrItems == 0)
+      return;
+
+    auto bounds = normalized(getBounds(0));
+    for (size_t i = 1; i < nrItems; i++)
+    {
+      const auto itemBounds = normalized(getBounds(i));
+      bounds.left           = std::min(bounds.left, itemBounds.left);
+      bounds.top            = std::min(bounds.top, itemBounds.top);
+      bounds.right          = std::max(bounds.right, itemBounds.right);
+      bounds.bottom         = std::max(bounds.bottom, itemBounds.bottom);
+    }
+    this->originX  = bounds.left;
+    this->originY  = bounds.top;
+    this->nrCellsX = ((bounds.right - bounds.left - 1) >> CELL_SIZE_LOG2) + 1;
+    this->nrCellsY = ((bounds.bottom - bounds.top - 1) >> CELL_SIZE_LOG2) + 1;
+
+    // Count the items per cell first so that all indices can be saved in one flat vector.
+    this->cellStart.assign(size_t(this->nrCellsX) * size_t(this->nrCellsY) + 1, 0);
+    for (size_t i = 0; i < nrItems; i++)
+    {
+      const auto cells = *this->getCellRange(normalized(getBounds(i)));
+      for (int y = cells.y0; y <= cells.y1; y++)
+        for (int x = cells.x0; x <= cells.x1; x++)
+          this->cellStart[this->getCellIndex(x, y) + 1]++;
+    }
+    for (size_t c = 1; c < this->cellStart.size(); c++)
+      this->cellStart[c] += this->cellStart[c - 1];
+
+    this->cellItems.resize(this->cellStart.back());
+    std::vector<uint32_t> cellFillPos(this->cellStart.begin(), this->cellStart.end() - 1);
+    for (size_t i = 0; i < nrItems; i++)
+    {
+      const auto cells = *this->getCellRange(normalized(getBounds(i)));
+      for (int y = cells.y0; y <= cells.y1; y++)
+        for (int x = cells.x0; x <= cells.x1; x++)
+          this->cellItems[cellFillPos[this->getCellIndex(x, y)]++] = uint32_t(i);
+    }
+  }
+
+  // Call the function with the index of every item which overlaps the area. Every item is only
+  // reported once. The items are reported cell by cell and not in the order of their indices.
+  template <typename GetBounds, typename Function>
+  void forEachItemIn(const SampleRect &area, GetBounds getBounds, Function function) const
+  {
+    if (!this->built || this->cellItems.empty() || area.isEmpty())
+      return;
+
+    const auto areaCells = this->getCellRange(area);
+    if (!areaCells)
+      return;
+
+    for (int y = areaCells->y0; y <= areaCells->y1; y++)
+    {
+      for (int x = areaCells->x0; x <= areaCells->x1; x++)
+      {
+        const auto cellIndex = this->getCellIndex(x, y);
+        for (auto i = this->cellStart[cellIndex]; i < this->cellStart[cellIndex + 1]; i++)
+        {
+          const auto itemIndex  = this->cellItems[i];
+          const auto itemBounds = normalized(getBounds(itemIndex));
+          if (!itemBounds.intersects(area))
+            continue;
+
+          // An item that covers multiple cells is only reported in the first of its cells which
+          // is within the area.
+          const auto itemCells = *this->getCellRange(itemBounds);
+          if (std::max(itemCells.x0, areaCells->x0) != x ||
+              std::max(itemCells.y0, areaCells->y0) != y)
+            continue;
+
+          function(itemIndex);
+        }
+      }
+    }
+  }
+
+private:
+  // Each cell covers 64x64 samples
+  static constexpr int CELL_SIZE_LOG2 = 6;
+
+  // The first and last (inclusive) cell in each direction
+  struct CellRange
+  {
+    int x0{};
+    int y0{};
+    int x1{};
+    int y1{};
+  };
+
+  // Items without a size are treated like items with a size of 1 so that they can be found.
+  static SampleRect normalized(SampleRect rect)
+  {
+    rect.right  = std::max(rect.right, rect.left + 1);
+    rect.bottom = std::max(rect.bottom, rect.top + 1);
+    return rect;
+  }
+
+  std::optional<CellRange> getCellRange(const SampleRect &rect) const
+  {
+    const auto toCell = [](int pos, int origin, int nrCells)
+    { return std::clamp((std::max(pos - origin, 0)) >> CELL_SIZE_LOG2, 0, nrCells - 1); };
+
+    const auto gridRight  = this->originX + (this->nrCellsX << CELL_SIZE_LOG2);
+    const auto gridBottom = this->originY + (this->nrCellsY << CELL_SIZE_LOG2);
+    if (rect.right <= this->originX || rect.left >= gridRight || rect.bottom <= this->originY ||
+        rect.top >= gridBottom)
+      return {};
+
+    CellRange cells;
+    cells.x0 = toCell(rect.left, this->originX, this->nrCellsX);
+    cells.y0 = toCell(rect.top, this->originY, this->nrCellsY);
+    cells.x1 = toCell(rect.right - 1, this->originX, this->nrCellsX);
+    cells.y1 = toCell(rect.bottom - 1, this->originY, this->nrCellsY);
+    return cells;
+  }
+
+  size_t getCellIndex(int x, int y) const { return size_t(y) * size_t(this->nrCellsX) + size_t(x); }
+
+  bool   built{};
+  size_t nrItems{};
+
+  int originX{};
+  int originY{};
+  int nrCellsX{};
+  int nrCellsY{};
+
+  // The items of cell c are cellItems[cellStart[c]] to cellItems[cellStart[c + 1] - 1]
+  std::vector<uint32_t> cellStart;
+  std::vector<uint32_t> cellItems;
+};
+
+} // namespace stats
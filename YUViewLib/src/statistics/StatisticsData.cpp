@@ -198,6 +198,9 @@ QStringPairList StatisticsData::getValuesAt(const QPoint &pos) const
 {
   QStringPairList valueList;
 
+  // Only the items at the position are looked up in the spatial index of the data
+  const auto area = SampleRect{pos.x(), pos.y(), pos.x() + 1, pos.y() + 1};
+
   std::unique_lock<std::mutex> lock(this->accessMutex);
 
   for (auto it = this->statsTypes.rbegin(); it != this->statsTypes.rend(); it++)
@@ -210,97 +213,109 @@ QStringPairList StatisticsData::getValuesAt(const QPoint &pos) const
       continue;
 
     // Get all value data entries
-    bool foundStats = false;
-    for (const auto &valueItem : this->frameCache.at(it->typeID).valueData)
-    {
-      auto rect = QRect(valueItem.pos[0], valueItem.pos[1], valueItem.size[0], valueItem.size[1]);
-      if (rect.contains(pos))
-      {
-        int  value  = valueItem.value;
-        auto valTxt = it->getValueTxt(value);
-        if (valTxt.isEmpty() && it->scaleValueToBlockSize)
-          valTxt = QString("%1").arg(float(value) / (valueItem.size[0] * valueItem.size[1]));
-
-        valueList.append(QStringPair(it->typeName, valTxt));
-        foundStats = true;
-      }
-    }
-
-    for (const auto &vectorItem : this->frameCache.at(it->typeID).vectorData)
-    {
-      auto rect =
-          QRect(vectorItem.pos[0], vectorItem.pos[1], vectorItem.size[0], vectorItem.size[1]);
-      if (rect.contains(pos))
-      {
-        double x{};
-        double y{};
-        if (vectorItem.isLine)
+    const auto &typeData   = this->frameCache.at(it->typeID);
+    bool        foundStats = false;
+    typeData.forEachValueIn(
+        area,
+        [&](const StatsItemValue &valueItem)
         {
-          x = double(vectorItem.point[1].x - vectorItem.point[0].x) / it->vectorScale;
-          y = double(vectorItem.point[1].y - vectorItem.point[0].y) / it->vectorScale;
-        }
-        else
+          auto rect =
+              QRect(valueItem.pos[0], valueItem.pos[1], valueItem.size[0], valueItem.size[1]);
+          if (rect.contains(pos))
+          {
+            int  value  = valueItem.value;
+            auto valTxt = it->getValueTxt(value);
+            if (valTxt.isEmpty() && it->scaleValueToBlockSize)
+              valTxt = QString("%1").arg(float(value) / (valueItem.size[0] * valueItem.size[1]));
+
+            valueList.append(QStringPair(it->typeName, valTxt));
+            foundStats = true;
+          }
+        });
+
+    typeData.forEachVectorIn(
+        area,
+        [&](const StatsItemVector &vectorItem)
         {
-          x = double(vectorItem.point[0].x) / it->vectorScale;
-          y = double(vectorItem.point[0].y) / it->vectorScale;
-        }
-        valueList.append(
-            QStringPair(QString("%1").arg(it->typeName), QString("(%1,%2)").arg(x).arg(y)));
-        foundStats = true;
-      }
-    }
-
-    for (const auto &affineTFItem : this->frameCache.at(it->typeID).affineTFData)
-    {
-      const auto rect = QRect(
-          affineTFItem.pos[0], affineTFItem.pos[1], affineTFItem.size[0], affineTFItem.size[1]);
-      if (rect.contains(pos))
-      {
-        for (unsigned i = 0; i < 3; i++)
+          auto rect =
+              QRect(vectorItem.pos[0], vectorItem.pos[1], vectorItem.size[0], vectorItem.size[1]);
+          if (rect.contains(pos))
+          {
+            double x{};
+            double y{};
+            if (vectorItem.isLine)
+            {
+              x = double(vectorItem.point[1].x - vectorItem.point[0].x) / it->vectorScale;
+              y = double(vectorItem.point[1].y - vectorItem.point[0].y) / it->vectorScale;
+            }
+            else
+            {
+              x = double(vectorItem.point[0].x) / it->vectorScale;
+              y = double(vectorItem.point[0].y) / it->vectorScale;
+            }
+            valueList.append(
+                QStringPair(QString("%1").arg(it->typeName), QString("(%1,%2)").arg(x).arg(y)));
+            foundStats = true;
+          }
+        });
+
+    typeData.forEachAffineTFIn(
+        area,
+        [&](const StatsItemAffineTF &affineTFItem)
         {
-          auto xScaled = float(affineTFItem.point[i].x / it->vectorScale);
-          auto yScaled = float(affineTFItem.point[i].y / it->vectorScale);
-          valueList.append(
-              QStringPair(QString("%1_%2[x]").arg(it->typeName).arg(i), QString::number(xScaled)));
-          valueList.append(
-              QStringPair(QString("%1_%2[y]").arg(it->typeName).arg(i), QString::number(yScaled)));
-        }
-        foundStats = true;
-      }
-    }
-
-    for (const auto &valueItem : this->frameCache.at(it->typeID).polygonValueData)
-    {
-      if (valueItem.corners.size() < 3)
-        continue; // need at least triangle -- or more corners
-      if (stats::polygonContainsPoint(valueItem.corners, Point(pos.x(), pos.y())))
-      {
-        int  value  = valueItem.value;
-        auto valTxt = it->getValueTxt(value);
-        valueList.append(QStringPair(it->typeName, valTxt));
-        foundStats = true;
-      }
-    }
-
-    for (const auto &polygonVectorItem : this->frameCache.at(it->typeID).polygonVectorData)
-    {
-      if (polygonVectorItem.corners.size() < 3)
-        continue; // need at least triangle -- or more corners
-      if (stats::polygonContainsPoint(polygonVectorItem.corners, Point(pos.x(), pos.y())))
-      {
-        if (it->renderVectorData)
+          const auto rect = QRect(
+              affineTFItem.pos[0], affineTFItem.pos[1], affineTFItem.size[0], affineTFItem.size[1]);
+          if (rect.contains(pos))
+          {
+            for (unsigned i = 0; i < 3; i++)
+            {
+              auto xScaled = float(affineTFItem.point[i].x / it->vectorScale);
+              auto yScaled = float(affineTFItem.point[i].y / it->vectorScale);
+              valueList.append(QStringPair(QString("%1_%2[x]").arg(it->typeName).arg(i),
+                                           QString::number(xScaled)));
+              valueList.append(QStringPair(QString("%1_%2[y]").arg(it->typeName).arg(i),
+                                           QString::number(yScaled)));
+            }
+            foundStats = true;
+          }
+        });
+
+    typeData.forEachPolygonValueIn(
+        area,
+        [&](const StatsItemPolygonValue &valueItem)
         {
-          // The length of the vector
-          auto xScaled = (float)polygonVectorItem.point.x / it->vectorScale;
-          auto yScaled = (float)polygonVectorItem.point.y / it->vectorScale;
-          valueList.append(
-              QStringPair(QString("%1[x]").arg(it->typeName), QString::number(xScaled)));
-          valueList.append(
-              QStringPair(QString("%1[y]").arg(it->typeName), QString::number(yScaled)));
-          foundStats = true;
-        }
-      }
-    }
+          if (valueItem.corners.size() < 3)
+            return; // need at least triangle -- or more corners
+          if (stats::polygonContainsPoint(valueItem.corners, Point(pos.x(), pos.y())))
+          {
+            int  value  = valueItem.value;
+            auto valTxt = it->getValueTxt(value);
+            valueList.append(QStringPair(it->typeName, valTxt));
+            foundStats = true;
+          }
+        });
+
+    typeData.forEachPolygonVectorIn(
+        area,
+        [&](const StatsItemPolygonVector &polygonVectorItem)
+        {
+          if (polygonVectorItem.corners.size() < 3)
+            return; // need at least triangle -- or more corners
+          if (stats::polygonContainsPoint(polygonVectorItem.corners, Point(pos.x(), pos.y())))
+          {
+            if (it->renderVectorData)
+            {
+              // The length of the vector
+              auto xScaled = (float)polygonVectorItem.point.x / it->vectorScale;
+              auto yScaled = (float)polygonVectorItem.point.y / it->vectorScale;
+              valueList.append(
+                  QStringPair(QString("%1[x]").arg(it->typeName), QString::number(xScaled)));
+              valueList.append(
+                  QStringPair(QString("%1[y]").arg(it->typeName), QString::number(yScaled)));
+              foundStats = true;
+            }
+          }
+        });
 
     if (!foundStats)
       valueList.append(QStringPair(it->typeName, "-"));
@@ -40,6 +40,7 @@
 #include <QtGui/QPolygon>
 #include <QtMath>
 #include <cmath>
+#include <map>
 
 namespace
 {
@@ -92,6 +93,21 @@ QPen styleToPen(stats::LineDrawStyle &style)
   return QPen(functionsGui::toQColor(style.color), style.width, patternToQPenStyle(style.pattern));
 }
 
+// Vectors and lines can reach outside of their block. Get the area in which the vectors must be to
+// be (possibly) visible in the visible area.
+stats::SampleRect getVectorArea(const stats::SampleRect     &visibleArea,
+                                const stats::FrameTypeData  &typeData,
+                                const stats::StatisticsType &statisticsType)
+{
+  const auto vectorScale = std::max(statisticsType.vectorScale, 1);
+  const auto reach =
+      std::max(typeData.maxAbsVectorValue / vectorScale + 1, typeData.maxAbsLinePoint + 1);
+  return {visibleArea.left - reach,
+          visibleArea.top - reach,
+          visibleArea.right + reach,
+          visibleArea.bottom + reach};
+}
+
 void paintVector(QPainter *                   painter,
                  const stats::StatisticsType &statisticsType,
                  const double &               zoomFactor,
@@ -286,6 +302,12 @@ void stats::paintStatisticsData(QPainter *             painter,
 
   painter->translate(statRect.topLeft());
 
+  // The visible area in samples. Only the items in this area are touched.
+  const auto visibleArea = stats::SampleRect{int(std::floor(xMin / zoomFactor)) - 1,
+                                             int(std::floor(yMin / zoomFactor)) - 1,
+                                             int(std::ceil(xMax / zoomFactor)) + 1,
+                                             int(std::ceil(yMax / zoomFactor)) + 1};
+
   auto &statsTypes = statisticsData.getStatisticsTypes();
 
   // First, get if more than one statistic that has block values is rendered.
@@ -310,96 +332,89 @@ void stats::paintStatisticsData(QPainter *             painter,
   // Draw all the block types. Also, if the zoom factor is larger than STATISTICS_DRAW_VALUES_ZOOM,
   // also save a list of all the values of the blocks and their position in order to draw the values
   // in the next step.
-  QList<QPoint>      drawStatPoints; // The positions of each value
-  QList<QStringList> drawStatTexts;  // For each point: The values to draw
-  double             maxLineWidth =
-      0.0; // The maximum width of the lines that is drawn. This will be used as an offset.
+  // For each position: The values to draw
+  std::map<std::pair<int, int>, QStringList> drawStatTexts;
+  // The maximum width of the lines that is drawn. This will be used as an offset.
+  double maxLineWidth = 0.0;
 
   for (auto it = statsTypes.rbegin(); it != statsTypes.rend(); it++)
   {
     if (!it->render || !statisticsData.hasDataForTypeID(it->typeID))
       continue;
 
-    for (const auto &valueItem : statisticsData[it->typeID].valueData)
-    {
-      // Calculate the size and position of the rectangle to draw (zoomed in)
-      auto rect = QRect(valueItem.pos[0], valueItem.pos[1], valueItem.size[0], valueItem.size[1]);
-      auto displayRect = QRect(rect.left() * zoomFactor,
-                               rect.top() * zoomFactor,
-                               rect.width() * zoomFactor,
-                               rect.height() * zoomFactor);
-
-      // Check if the rectangle of the statistics item is even visible
-      bool rectVisible = (!(displayRect.left() > xMax || displayRect.right() < xMin ||
-                            displayRect.top() > yMax || displayRect.bottom() < yMin));
-      if (!rectVisible)
-        continue;
-
-      int value = valueItem.value; // This value determines the color for this item
-      if (it->renderValueData)
-      {
-        // Get the right color for the item and draw it.
-        Color rectColor;
-        if (it->scaleValueToBlockSize)
-          rectColor =
-              it->colorMapper.getColor(float(value) / (valueItem.size[0] * valueItem.size[1]));
-        else
-          rectColor = it->colorMapper.getColor(value);
-        rectColor.setAlpha(rectColor.alpha() * ((float)it->alphaFactor / 100.0));
-
-        auto rectQColor = functionsGui::toQColor(rectColor);
-        painter->setBrush(rectQColor);
-        painter->fillRect(displayRect, rectQColor);
-      }
+    const auto &typeData = statisticsData[it->typeID];
+    typeData.forEachValueIn(
+        visibleArea,
+        [&](const StatsItemValue &valueItem)
+        {
+          // Calculate the size and position of the rectangle to draw (zoomed in)
+          auto rect =
+              QRect(valueItem.pos[0], valueItem.pos[1], valueItem.size[0], valueItem.size[1]);
+          auto displayRect = QRect(rect.left() * zoomFactor,
+                                   rect.top() * zoomFactor,
+                                   rect.width() * zoomFactor,
+                                   rect.height() * zoomFactor);
+
+          // Check if the rectangle of the statistics item is even visible
+          bool rectVisible = (!(displayRect.left() > xMax || displayRect.right() < xMin ||
+                                displayRect.top() > yMax || displayRect.bottom() < yMin));
+          if (!rectVisible)
+            return;
+
+          int value = valueItem.value; // This value determines the color for this item
+          if (it->renderValueData)
+          {
+            // Get the right color for the item and draw it.
+            Color rectColor;
+            if (it->scaleValueToBlockSize)
+              rectColor =
+                  it->colorMapper.getColor(float(value) / (valueItem.size[0] * valueItem.size[1]));
+            else
+              rectColor = it->colorMapper.getColor(value);
+            rectColor.setAlpha(rectColor.alpha() * ((float)it->alphaFactor / 100.0));
+
+            auto rectQColor = functionsGui::toQColor(rectColor);
+            painter->setBrush(rectQColor);
+            painter->fillRect(displayRect, rectQColor);
+          }
 
-      // optionally, draw a grid around the region
-      if (it->renderGrid)
-      {
-        // Set the grid color (no fill)
-        auto gridStyle = it->gridStyle;
-        if (it->scaleGridToZoom)
-          gridStyle.width = gridStyle.width * zoomFactor;
+          // optionally, draw a grid around the region
+          if (it->renderGrid)
+          {
+            // Set the grid color (no fill)
+            auto gridStyle = it->gridStyle;
+            if (it->scaleGridToZoom)
+              gridStyle.width = gridStyle.width * zoomFactor;
 
-        painter->setPen(styleToPen(gridStyle));
-        painter->setBrush(QBrush(QColor(Qt::color0), Qt::NoBrush)); // no fill color
+            painter->setPen(styleToPen(gridStyle));
+            painter->setBrush(QBrush(QColor(Qt::color0), Qt::NoBrush)); // no fill color
 
-        // Save the line width (if thicker)
-        if (gridStyle.width > maxLineWidth)
-          maxLineWidth = gridStyle.width;
+            // Save the line width (if thicker)
+            if (gridStyle.width > maxLineWidth)
+              maxLineWidth = gridStyle.width;
 
-        painter->drawRect(displayRect);
-      }
+            painter->drawRect(displayRect);
+          }
 
-      // Save the position/text in order to draw the values later
-      if (zoomFactor >= STATISTICS_DRAW_VALUES_ZOOM)
-      {
-        auto valTxt = it->getValueTxt(value);
-        if (valTxt.isEmpty() && it->scaleValueToBlockSize)
-          valTxt = QString("%1").arg(float(value) / (valueItem.size[0] * valueItem.size[1]));
+          // Save the position/text in order to draw the values later
+          if (zoomFactor >= STATISTICS_DRAW_VALUES_ZOOM)
+          {
+            auto valTxt = it->getValueTxt(value);
+            if (valTxt.isEmpty() && it->scaleValueToBlockSize)
+              valTxt = QString("%1").arg(float(value) / (valueItem.size[0] * valueItem.size[1]));
 
-        auto typeTxt = it->typeName;
-        auto statTxt = moreThanOneBlockStatRendered ? typeTxt + ":" + valTxt : valTxt;
+            auto typeTxt = it->typeName;
+            auto statTxt = moreThanOneBlockStatRendered ? typeTxt + ":" + valTxt : valTxt;
 
-        int i = drawStatPoints.indexOf(displayRect.topLeft());
-        if (i == -1)
-        {
-          // No value for this point yet. Append it and start a new QStringList
-          drawStatPoints.append(displayRect.topLeft());
-          drawStatTexts.append(QStringList(statTxt));
-        }
-        else
-          // There is already a value for this point. Just append the text.
-          drawStatTexts[i].append(statTxt);
-      }
-    }
+            const auto point = displayRect.topLeft();
+            drawStatTexts[{point.x(), point.y()}].append(statTxt);
+          }
+        });
   }
 
   // Draw all the polygon value types. Also, if the zoom factor is larger than
   // STATISTICS_DRAW_VALUES_ZOOM, also save a list of all the values of the blocks and their
-  // position in order to draw the values in the next step. QList<QPoint> drawStatPoints;       //
-  // The positions of each value QList<QStringList> drawStatTexts;   // For each point: The values
-  // to draw double maxLineWidth = 0.0;          // Also get the maximum width of the lines that is
-  // drawn. This will be used as an offset.
+  // position in order to draw the values in the next step.
   for (auto it = statsTypes.rbegin(); it != statsTypes.rend(); it++)
   {
     if (!it->render || !statisticsData.hasDataForTypeID(it->typeID))
@@ -407,81 +422,77 @@ void stats::paintStatisticsData(QPainter *             painter,
       continue;
 
     // Go through all the value data
-    for (const auto &valueItem : statisticsData[it->typeID].polygonValueData)
-    {
-      // Calculate the size and position of the rectangle to draw (zoomed in)
-      auto valuePoly           = convertToQPolygon(valueItem.corners);
-      auto boundingRect        = valuePoly.boundingRect();
-      auto trans               = QTransform().scale(zoomFactor, zoomFactor);
-      auto displayPolygon      = trans.map(valuePoly);
-      auto displayBoundingRect = displayPolygon.boundingRect();
-
-      // Check if the rectangle of the statistics item is even visible
-      bool isVisible = (!(displayBoundingRect.left() > xMax || displayBoundingRect.right() < xMin ||
-                          displayBoundingRect.top() > yMax || displayBoundingRect.bottom() < yMin));
-
-      if (isVisible)
-      {
-        int value = valueItem.value; // This value determines the color for this item
-        if (it->renderValueData)
+    const auto &typeData = statisticsData[it->typeID];
+    typeData.forEachPolygonValueIn(
+        visibleArea,
+        [&](const StatsItemPolygonValue &valueItem)
         {
-          // Get the right color for the item and draw it.
-          Color color;
-          if (it->scaleValueToBlockSize)
-            color = it->colorMapper.getColor(
-                float(value) / (boundingRect.size().width() * boundingRect.size().height()));
-          else
-            color = it->colorMapper.getColor(value);
-          color.setAlpha(color.alpha() * ((float)it->alphaFactor / 100.0));
+          // Calculate the size and position of the rectangle to draw (zoomed in)
+          auto valuePoly           = convertToQPolygon(valueItem.corners);
+          auto boundingRect        = valuePoly.boundingRect();
+          auto trans               = QTransform().scale(zoomFactor, zoomFactor);
+          auto displayPolygon      = trans.map(valuePoly);
+          auto displayBoundingRect = displayPolygon.boundingRect();
+
+          // Check if the rectangle of the statistics item is even visible
+          bool isVisible =
+              (!(displayBoundingRect.left() > xMax || displayBoundingRect.right() < xMin ||
+                 displayBoundingRect.top() > yMax || displayBoundingRect.bottom() < yMin));
+
+          if (isVisible)
+          {
+            int value = valueItem.value; // This value determines the color for this item
+            if (it->renderValueData)
+            {
+              // Get the right color for the item and draw it.
+              Color color;
+              if (it->scaleValueToBlockSize)
+                color = it->colorMapper.getColor(
+                    float(value) / (boundingRect.size().width() * boundingRect.size().height()));
+              else
+                color = it->colorMapper.getColor(value);
+              color.setAlpha(color.alpha() * ((float)it->alphaFactor / 100.0));
 
-          // Fill polygon
-          QPainterPath path;
-          path.addPolygon(displayPolygon);
+              // Fill polygon
+              QPainterPath path;
+              path.addPolygon(displayPolygon);
 
-          auto qColor = functionsGui::toQColor(color);
-          painter->setBrush(qColor);
-          painter->fillPath(path, qColor);
-        }
+              auto qColor = functionsGui::toQColor(color);
+              painter->setBrush(qColor);
+              painter->fillPath(path, qColor);
+            }
 
-        // optionally, draw a grid around the region
-        if (it->renderGrid)
-        {
-          // Set the grid color (no fill)
-          auto gridStyle = it->gridStyle;
-          if (it->scaleGridToZoom)
-            gridStyle.width = gridStyle.width * zoomFactor;
+            // optionally, draw a grid around the region
+            if (it->renderGrid)
+            {
+              // Set the grid color (no fill)
+              auto gridStyle = it->gridStyle;
+              if (it->scaleGridToZoom)
+                gridStyle.width = gridStyle.width * zoomFactor;
 
-          painter->setPen(styleToPen(gridStyle));
-          painter->setBrush(QBrush(QColor(Qt::color0), Qt::NoBrush)); // no fill color
+              painter->setPen(styleToPen(gridStyle));
+              painter->setBrush(QBrush(QColor(Qt::color0), Qt::NoBrush)); // no fill color
 
-          // Save the line width (if thicker)
-          if (gridStyle.width > maxLineWidth)
-            maxLineWidth = gridStyle.width;
+              // Save the line width (if thicker)
+              if (gridStyle.width > maxLineWidth)
+                maxLineWidth = gridStyle.width;
 
-          painter->drawPolygon(displayPolygon);
-        }
+              painter->drawPolygon(displayPolygon);
+            }
 
-        // Todo: draw text for polygon statistics
-        // // Save the position/text in order to draw the values later
-        if (zoomFactor >= STATISTICS_DRAW_VALUES_ZOOM)
-        {
-          auto valTxt  = it->getValueTxt(value);
-          auto typeTxt = it->typeName;
-          auto statTxt = moreThanOneBlockStatRendered ? typeTxt + ":" + valTxt : valTxt;
+            // Todo: draw text for polygon statistics
+            // // Save the position/text in order to draw the values later
+            if (zoomFactor >= STATISTICS_DRAW_VALUES_ZOOM)
+            {
+              auto valTxt  = it->getValueTxt(value);
+              auto typeTxt = it->typeName;
+              auto statTxt = moreThanOneBlockStatRendered ? typeTxt + ":" + valTxt : valTxt;
 
-          int i = drawStatPoints.indexOf(getPolygonCenter(displayPolygon));
-          if (i == -1)
-          {
-            // No value for this point yet. Append it and start a new QStringList
-            drawStatPoints.append(getPolygonCenter(displayPolygon));
-            drawStatTexts.append(QStringList(statTxt));
+              const auto point = getPolygonCenter(displayPolygon);
+              drawStatTexts[{point.x(), point.y()}].append(statTxt);
+            }
           }
-          else
-            // There is already a value for this point. Just append the text.
-            drawStatTexts[i].append(statTxt);
-        }
-      }
-    }
+        });
   }
 
   // Step three: Draw the values of the block types
@@ -490,11 +501,11 @@ void stats::paintStatisticsData(QPainter *             painter,
     // For every point, draw only one block of values. So for every point, we check if there are
     // also other text entries for the same point and then we draw all of them
     auto lineOffset = QPoint(int(maxLineWidth / 2), int(maxLineWidth / 2));
-    for (int i = 0; i < drawStatPoints.count(); i++)
+    for (const auto &[point, texts] : drawStatTexts)
     {
-      auto txt      = drawStatTexts[i].join("\n");
+      auto txt      = texts.join("\n");
       auto textRect = painter->boundingRect(QRect(), Qt::AlignLeft, txt);
-      textRect.moveTopLeft(drawStatPoints[i] + QPoint(3, 1) + lineOffset);
+      textRect.moveTopLeft(QPoint(point.first, point.second) + QPoint(3, 1) + lineOffset);
       painter->drawText(textRect, Qt::AlignLeft, txt);
     }
   }
@@ -506,317 +517,325 @@ void stats::paintStatisticsData(QPainter *             painter,
       // This statistics type is not rendered or could not be loaded.
       continue;
 
-    // Go through all the vector data
-    for (const auto &vectorItem : statisticsData[it->typeID].vectorData)
-    {
-      // Calculate the size and position of the rectangle to draw (zoomed in)
-      const auto rect =
-          QRect(vectorItem.pos[0], vectorItem.pos[1], vectorItem.size[0], vectorItem.size[1]);
-      const auto displayRect = QRect(rect.left() * zoomFactor,
-                                     rect.top() * zoomFactor,
-                                     rect.width() * zoomFactor,
-                                     rect.height() * zoomFactor);
-
-      if (it->renderVectorData)
-      {
-        // Calculate the start and end point of the arrow. The vector starts at center of the block.
-        int   x1, y1, x2, y2;
-        float vx, vy;
-        if (vectorItem.isLine)
-        {
-          x1 = displayRect.left() + zoomFactor * vectorItem.point[0].x;
-          y1 = displayRect.top() + zoomFactor * vectorItem.point[0].y;
-          x2 = displayRect.left() + zoomFactor * vectorItem.point[1].x;
-          y2 = displayRect.top() + zoomFactor * vectorItem.point[1].y;
-          vx = (float)(x2 - x1) / it->vectorScale;
-          vy = (float)(y2 - y1) / it->vectorScale;
-        }
-        else
-        {
-          x1 = displayRect.left() + displayRect.width() / 2;
-          y1 = displayRect.top() + displayRect.height() / 2;
-
-          // The length of the vector
-          vx = (float)vectorItem.point[0].x / it->vectorScale;
-          vy = (float)vectorItem.point[0].y / it->vectorScale;
+    const auto &typeData   = statisticsData[it->typeID];
+    const auto  vectorArea = getVectorArea(visibleArea, typeData, *it);
 
-          // The end point of the vector
-          x2 = x1 + zoomFactor * vx;
-          y2 = y1 + zoomFactor * vy;
-        }
-
-        // Check if the arrow is even visible. The arrow can be visible even though the stat
-        // rectangle is not
-        const bool arrowVisible = !(x1 < xMin && x2 < xMin) && !(x1 > xMax && x2 > xMax) &&
-                                  !(y1 < yMin && y2 < yMin) && !(y1 > yMax && y2 > yMax);
-        if (arrowVisible)
+    // Go through all the vector data
+    typeData.forEachVectorIn(
+        vectorArea,
+        [&](const StatsItemVector &vectorItem)
         {
-          // Set the pen for drawing
-          auto vectorStyle = it->vectorStyle;
-          auto arrowColor  = functionsGui::toQColor(vectorStyle.color);
-          if (it->mapVectorToColor)
-            arrowColor.setHsvF(
-                functions::clip((std::atan2(vy, vx) + M_PI) / (2 * M_PI), 0.0, 1.0), 1.0, 1.0);
-          arrowColor.setAlpha(arrowColor.alpha() * ((float)it->alphaFactor / 100.0));
-          if (it->scaleVectorToZoom)
-            vectorStyle.width = vectorStyle.width * zoomFactor / 8;
-
-          painter->setPen(
-              QPen(arrowColor, vectorStyle.width, patternToQPenStyle(vectorStyle.pattern)));
-          painter->setBrush(arrowColor);
-
-          // Draw the arrow tip, or a circle if the vector is (0,0) if the zoom factor is not 1 or
-          // smaller.
-          if (zoomFactor > 1)
+          // Calculate the size and position of the rectangle to draw (zoomed in)
+          const auto rect =
+              QRect(vectorItem.pos[0], vectorItem.pos[1], vectorItem.size[0], vectorItem.size[1]);
+          const auto displayRect = QRect(rect.left() * zoomFactor,
+                                         rect.top() * zoomFactor,
+                                         rect.width() * zoomFactor,
+                                         rect.height() * zoomFactor);
+
+          if (it->renderVectorData)
           {
-            // At which angle do we draw the triangle?
-            // A vector to the right (1,  0) -> 0°
-            // A vector to the top   (0, -1) -> 90°
-            const auto angle = std::atan2(vy, vx);
-
-            // Draw the vector head if the vector is not 0,0
-            if ((vx != 0 || vy != 0))
+            // Calculate the start and end point of the arrow. The vector starts at center of the
+            // block.
+            int   x1, y1, x2, y2;
+            float vx, vy;
+            if (vectorItem.isLine)
             {
-              // The size of the arrow head
-              const int headSize =
-                  (zoomFactor >= STATISTICS_DRAW_VALUES_ZOOM && !it->scaleVectorToZoom)
-                      ? 8
-                      : zoomFactor / 2;
+              x1 = displayRect.left() + zoomFactor * vectorItem.point[0].x;
+              y1 = displayRect.top() + zoomFactor * vectorItem.point[0].y;
+              x2 = displayRect.left() + zoomFactor * vectorItem.point[1].x;
+              y2 = displayRect.top() + zoomFactor * vectorItem.point[1].y;
+              vx = (float)(x2 - x1) / it->vectorScale;
+              vy = (float)(y2 - y1) / it->vectorScale;
+            }
+            else
+            {
+              x1 = displayRect.left() + displayRect.width() / 2;
+              y1 = displayRect.top() + displayRect.height() / 2;
 
-              if (it->arrowHead != StatisticsType::ArrowHead::none)
-              {
-                // We draw an arrow head. This means that we will have to draw a shortened line
-                const int shorten = (it->arrowHead == StatisticsType::ArrowHead::arrow)
-                                        ? headSize * 2
-                                        : headSize * 0.5;
-                if (std::sqrt(vx * vx * zoomFactor * zoomFactor +
-                              vy * vy * zoomFactor * zoomFactor) > shorten)
-                {
-                  // Shorten the line and draw it
-                  QLineF vectorLine = QLineF(x1,
-                                             y1,
-                                             double(x2) - std::cos(angle) * shorten,
-                                             double(y2) - std::sin(angle) * shorten);
-                  painter->drawLine(vectorLine);
-                }
-              }
-              else
-                // Draw the not shortened line
-                painter->drawLine(x1, y1, x2, y2);
+              // The length of the vector
+              vx = (float)vectorItem.point[0].x / it->vectorScale;
+              vy = (float)vectorItem.point[0].y / it->vectorScale;
 
-              if (it->arrowHead == StatisticsType::ArrowHead::arrow)
-              {
-                // Save the painter state, translate to the arrow tip, rotate the painter and draw
-                // the normal triangle.
-                painter->save();
-
-                // Draw the arrow tip with fixed size
-                painter->translate(QPoint(x2, y2));
-                painter->rotate(qRadiansToDegrees(angle));
-                const QPoint points[3] = {QPoint(0, 0),
-                                          QPoint(-headSize * 2, -headSize),
-                                          QPoint(-headSize * 2, headSize)};
-                painter->drawPolygon(points, 3);
-
-                // Restore. Revert translation/rotation of the painter.
-                painter->restore();
-              }
-              else if (it->arrowHead == StatisticsType::ArrowHead::circle)
-                painter->drawEllipse(x2 - headSize / 2, y2 - headSize / 2, headSize, headSize);
+              // The end point of the vector
+              x2 = x1 + zoomFactor * vx;
+              y2 = y1 + zoomFactor * vy;
             }
 
-            if (zoomFactor >= STATISTICS_DRAW_VALUES_ZOOM && it->renderVectorDataValues)
+            // Check if the arrow is even visible. The arrow can be visible even though the stat
+            // rectangle is not
+            const bool arrowVisible = !(x1 < xMin && x2 < xMin) && !(x1 > xMax && x2 > xMax) &&
+                                      !(y1 < yMin && y2 < yMin) && !(y1 > yMax && y2 > yMax);
+            if (arrowVisible)
             {
-              if (vectorItem.isLine)
+              // Set the pen for drawing
+              auto vectorStyle = it->vectorStyle;
+              auto arrowColor  = functionsGui::toQColor(vectorStyle.color);
+              if (it->mapVectorToColor)
+                arrowColor.setHsvF(
+                    functions::clip((std::atan2(vy, vx) + M_PI) / (2 * M_PI), 0.0, 1.0), 1.0, 1.0);
+              arrowColor.setAlpha(arrowColor.alpha() * ((float)it->alphaFactor / 100.0));
+              if (it->scaleVectorToZoom)
+                vectorStyle.width = vectorStyle.width * zoomFactor / 8;
+
+              painter->setPen(
+                  QPen(arrowColor, vectorStyle.width, patternToQPenStyle(vectorStyle.pattern)));
+              painter->setBrush(arrowColor);
+
+              // Draw the arrow tip, or a circle if the vector is (0,0) if the zoom factor is not 1
+              // or smaller.
+              if (zoomFactor > 1)
               {
-                // if we just draw a line, we want to simply see the coordinate pairs
-                auto txt1 = QString("(%1, %2)").arg(x1 / zoomFactor).arg(y1 / zoomFactor);
-                auto txt2 = QString("(%1, %2)").arg(x2 / zoomFactor).arg(y2 / zoomFactor);
-
-                auto textRect1 = painter->boundingRect(QRect(), Qt::AlignLeft, txt1);
-                auto textRect2 = painter->boundingRect(QRect(), Qt::AlignLeft, txt2);
-
-                textRect1.moveCenter(QPoint(x1, y1));
-                textRect2.moveCenter(QPoint(x2, y2));
+                // At which angle do we draw the triangle?
+                // A vector to the right (1,  0) -> 0°
+                // A vector to the top   (0, -1) -> 90°
+                const auto angle = std::atan2(vy, vx);
 
-                // as angle = atan2(y2-y1, x2-x1) move txt accordingly
-
-                int a = qRadiansToDegrees(angle);
-                if (a < 45 && a > -45)
-                {
-                  textRect1.moveRight(x1);
-                  textRect2.moveLeft(x2);
-                }
-                else if (a <= -45 && a > -135)
-                {
-                  textRect1.moveTop(y1);
-                  textRect2.moveBottom(y2);
-                }
-                else if (a >= 45 && a < 135)
+                // Draw the vector head if the vector is not 0,0
+                if ((vx != 0 || vy != 0))
                 {
-                  textRect1.moveBottom(y1);
-                  textRect2.moveTop(y2);
+                  // The size of the arrow head
+                  const int headSize =
+                      (zoomFactor >= STATISTICS_DRAW_VALUES_ZOOM && !it->scaleVectorToZoom)
+                          ? 8
+                          : zoomFactor / 2;
+
+                  if (it->arrowHead != StatisticsType::ArrowHead::none)
+                  {
+                    // We draw an arrow head. This means that we will have to draw a shortened line
+                    const int shorten = (it->arrowHead == StatisticsType::ArrowHead::arrow)
+                                            ? headSize * 2
+                                            : headSize * 0.5;
+                    if (std::sqrt(vx * vx * zoomFactor * zoomFactor +
+                                  vy * vy * zoomFactor * zoomFactor) > shorten)
+                    {
+                      // Shorten the line and draw it
+                      QLineF vectorLine = QLineF(x1,
+                                                 y1,
+                                                 double(x2) - std::cos(angle) * shorten,
+                                                 double(y2) - std::sin(angle) * shorten);
+                      painter->drawLine(vectorLine);
+                    }
+                  }
+                  else
+                    // Draw the not shortened line
+                    painter->drawLine(x1, y1, x2, y2);
+
+                  if (it->arrowHead == StatisticsType::ArrowHead::arrow)
+                  {
+                    // Save the painter state, translate to the arrow tip, rotate the painter and
+                    // draw the normal triangle.
+                    painter->save();
+
+                    // Draw the arrow tip with fixed size
+                    painter->translate(QPoint(x2, y2));
+                    painter->rotate(qRadiansToDegrees(angle));
+                    const QPoint points[3] = {QPoint(0, 0),
+                                              QPoint(-headSize * 2, -headSize),
+                                              QPoint(-headSize * 2, headSize)};
+                    painter->drawPolygon(points, 3);
+
+                    // Restore. Revert translation/rotation of the painter.
+                    painter->restore();
+                  }
+                  else if (it->arrowHead == StatisticsType::ArrowHead::circle)
+                    painter->drawEllipse(x2 - headSize / 2, y2 - headSize / 2, headSize, headSize);
                 }
-                else
+
+                if (zoomFactor >= STATISTICS_DRAW_VALUES_ZOOM && it->renderVectorDataValues)
                 {
-                  textRect1.moveLeft(x1);
-                  textRect2.moveRight(x2);
+                  if (vectorItem.isLine)
+                  {
+                    // if we just draw a line, we want to simply see the coordinate pairs
+                    auto txt1 = QString("(%1, %2)").arg(x1 / zoomFactor).arg(y1 / zoomFactor);
+                    auto txt2 = QString("(%1, %2)").arg(x2 / zoomFactor).arg(y2 / zoomFactor);
+
+                    auto textRect1 = painter->boundingRect(QRect(), Qt::AlignLeft, txt1);
+                    auto textRect2 = painter->boundingRect(QRect(), Qt::AlignLeft, txt2);
+
+                    textRect1.moveCenter(QPoint(x1, y1));
+                    textRect2.moveCenter(QPoint(x2, y2));
+
+                    // as angle = atan2(y2-y1, x2-x1) move txt accordingly
+
+                    int a = qRadiansToDegrees(angle);
+                    if (a < 45 && a > -45)
+                    {
+                      textRect1.moveRight(x1);
+                      textRect2.moveLeft(x2);
+                    }
+                    else if (a <= -45 && a > -135)
+                    {
+                      textRect1.moveTop(y1);
+                      textRect2.moveBottom(y2);
+                    }
+                    else if (a >= 45 && a < 135)
+                    {
+                      textRect1.moveBottom(y1);
+                      textRect2.moveTop(y2);
+                    }
+                    else
+                    {
+                      textRect1.moveLeft(x1);
+                      textRect2.moveRight(x2);
+                    }
+
+                    painter->drawText(textRect1, Qt::AlignLeft, txt1);
+                    painter->drawText(textRect2, Qt::AlignLeft, txt2);
+                  }
+                  else
+                  {
+                    // Also draw the vector value next to the arrow head
+                    auto txt      = QString("x %1\ny %2").arg(vx).arg(vy);
+                    auto textRect = painter->boundingRect(QRect(), Qt::AlignLeft, txt);
+                    textRect.moveCenter(QPoint(x2, y2));
+                    int a = qRadiansToDegrees(angle);
+                    if (a < 45 && a > -45)
+                      textRect.moveLeft(x2);
+                    else if (a <= -45 && a > -135)
+                      textRect.moveBottom(y2);
+                    else if (a >= 45 && a < 135)
+                      textRect.moveTop(y2);
+                    else
+                      textRect.moveRight(x2);
+                    painter->drawText(textRect, Qt::AlignLeft, txt);
+                  }
                 }
-
-                painter->drawText(textRect1, Qt::AlignLeft, txt1);
-                painter->drawText(textRect2, Qt::AlignLeft, txt2);
               }
               else
               {
-                // Also draw the vector value next to the arrow head
-                auto txt      = QString("x %1\ny %2").arg(vx).arg(vy);
-                auto textRect = painter->boundingRect(QRect(), Qt::AlignLeft, txt);
-                textRect.moveCenter(QPoint(x2, y2));
-                int a = qRadiansToDegrees(angle);
-                if (a < 45 && a > -45)
-                  textRect.moveLeft(x2);
-                else if (a <= -45 && a > -135)
-                  textRect.moveBottom(y2);
-                else if (a >= 45 && a < 135)
-                  textRect.moveTop(y2);
-                else
-                  textRect.moveRight(x2);
-                painter->drawText(textRect, Qt::AlignLeft, txt);
+                // No arrow head is drawn. Only draw a line.
+                painter->drawLine(x1, y1, x2, y2);
               }
             }
           }
-          else
-          {
-            // No arrow head is drawn. Only draw a line.
-            painter->drawLine(x1, y1, x2, y2);
-          }
-        }
-      }
 
-      // Check if the rectangle of the statistics item is even visible
-      const bool rectVisible = (!(displayRect.left() > xMax || displayRect.right() < xMin ||
-                                  displayRect.top() > yMax || displayRect.bottom() < yMin));
-      if (rectVisible)
-      {
-        // optionally, draw a grid around the region that the arrow is defined for
-        if (it->renderGrid && rectVisible)
-        {
-          auto gridStyle = it->gridStyle;
-          if (it->scaleGridToZoom)
-            gridStyle.width = gridStyle.width * zoomFactor;
+          // Check if the rectangle of the statistics item is even visible
+          const bool rectVisible = (!(displayRect.left() > xMax || displayRect.right() < xMin ||
+                                      displayRect.top() > yMax || displayRect.bottom() < yMin));
+          if (rectVisible)
+          {
+            // optionally, draw a grid around the region that the arrow is defined for
+            if (it->renderGrid && rectVisible)
+            {
+              auto gridStyle = it->gridStyle;
+              if (it->scaleGridToZoom)
+                gridStyle.width = gridStyle.width * zoomFactor;
 
-          painter->setPen(styleToPen(gridStyle));
-          painter->setBrush(QBrush(QColor(Qt::color0), Qt::NoBrush)); // no fill color
+              painter->setPen(styleToPen(gridStyle));
+              painter->setBrush(QBrush(QColor(Qt::color0), Qt::NoBrush)); // no fill color
 
-          painter->drawRect(displayRect);
-        }
-      }
-    }
+              painter->drawRect(displayRect);
+            }
+          }
+        });
 
     // Go through all the affine transform data
-    for (const auto &affineTFItem : statisticsData[it->typeID].affineTFData)
-    {
-      // Calculate the size and position of the rectangle to draw (zoomed in)
-      const auto rect = QRect(
-          affineTFItem.pos[0], affineTFItem.pos[1], affineTFItem.size[0], affineTFItem.size[1]);
-      const auto displayRect = QRect(rect.left() * zoomFactor,
-                                     rect.top() * zoomFactor,
-                                     rect.width() * zoomFactor,
-                                     rect.height() * zoomFactor);
-      // Check if the rectangle of the statistics item is even visible
-      const bool rectVisible = (!(displayRect.left() > xMax || displayRect.right() < xMin ||
-                                  displayRect.top() > yMax || displayRect.bottom() < yMin));
-      if (!rectVisible)
-        continue;
-
-      if (it->renderVectorData)
-      {
-        // affine vectors start at bottom left, top left and top right of the block
-        // mv0: LT, mv1: RT, mv2: LB
-        int   xLTstart, yLTstart, xRTstart, yRTstart, xLBstart, yLBstart;
-        int   xLTend, yLTend, xRTend, yRTend, xLBend, yLBend;
-        float vxLT, vyLT, vxRT, vyRT, vxLB, vyLB;
-
-        xLTstart = displayRect.left();
-        yLTstart = displayRect.top();
-        xRTstart = displayRect.right();
-        yRTstart = displayRect.top();
-        xLBstart = displayRect.left();
-        yLBstart = displayRect.bottom();
-
-        // The length of the vectors
-        vxLT = (float)affineTFItem.point[0].x / it->vectorScale;
-        vyLT = (float)affineTFItem.point[0].y / it->vectorScale;
-        vxRT = (float)affineTFItem.point[1].x / it->vectorScale;
-        vyRT = (float)affineTFItem.point[1].y / it->vectorScale;
-        vxLB = (float)affineTFItem.point[2].x / it->vectorScale;
-        vyLB = (float)affineTFItem.point[2].y / it->vectorScale;
-
-        // The end point of the vectors
-        xLTend = xLTstart + zoomFactor * vxLT;
-        yLTend = yLTstart + zoomFactor * vyLT;
-        xRTend = xRTstart + zoomFactor * vxRT;
-        yRTend = yRTstart + zoomFactor * vyRT;
-        xLBend = xLBstart + zoomFactor * vxLB;
-        yLBend = yLBstart + zoomFactor * vyLB;
-
-        paintVector(painter,
-                    *it,
-                    zoomFactor,
-                    xLTstart,
-                    yLTstart,
-                    xLTend,
-                    yLTend,
-                    vxLT,
-                    vyLT,
-                    false,
-                    xMin,
-                    xMax,
-                    yMin,
-                    yMax);
-        paintVector(painter,
-                    *it,
-                    zoomFactor,
-                    xRTstart,
-                    yRTstart,
-                    xRTend,
-                    yRTend,
-                    vxRT,
-                    vyRT,
-                    false,
-                    xMin,
-                    xMax,
-                    yMin,
-                    yMax);
-        paintVector(painter,
-                    *it,
-                    zoomFactor,
-                    xLBstart,
-                    yLBstart,
-                    xLBend,
-                    yLBend,
-                    vxLB,
-                    vyLB,
-                    false,
-                    xMin,
-                    xMax,
-                    yMin,
-                    yMax);
-      }
+    typeData.forEachAffineTFIn(
+        vectorArea,
+        [&](const StatsItemAffineTF &affineTFItem)
+        {
+          // Calculate the size and position of the rectangle to draw (zoomed in)
+          const auto rect = QRect(
+              affineTFItem.pos[0], affineTFItem.pos[1], affineTFItem.size[0], affineTFItem.size[1]);
+          const auto displayRect = QRect(rect.left() * zoomFactor,
+                                         rect.top() * zoomFactor,
+                                         rect.width() * zoomFactor,
+                                         rect.height() * zoomFactor);
+          // Check if the rectangle of the statistics item is even visible
+          const bool rectVisible = (!(displayRect.left() > xMax || displayRect.right() < xMin ||
+                                      displayRect.top() > yMax || displayRect.bottom() < yMin));
+          if (!rectVisible)
+            return;
+
+          if (it->renderVectorData)
+          {
+            // affine vectors start at bottom left, top left and top right of the block
+            // mv0: LT, mv1: RT, mv2: LB
+            int   xLTstart, yLTstart, xRTstart, yRTstart, xLBstart, yLBstart;
+            int   xLTend, yLTend, xRTend, yRTend, xLBend, yLBend;
+            float vxLT, vyLT, vxRT, vyRT, vxLB, vyLB;
+
+            xLTstart = displayRect.left();
+            yLTstart = displayRect.top();
+            xRTstart = displayRect.right();
+            yRTstart = displayRect.top();
+            xLBstart = displayRect.left();
+            yLBstart = displayRect.bottom();
+
+            // The length of the vectors
+            vxLT = (float)affineTFItem.point[0].x / it->vectorScale;
+            vyLT = (float)affineTFItem.point[0].y / it->vectorScale;
+            vxRT = (float)affineTFItem.point[1].x / it->vectorScale;
+            vyRT = (float)affineTFItem.point[1].y / it->vectorScale;
+            vxLB = (float)affineTFItem.point[2].x / it->vectorScale;
+            vyLB = (float)affineTFItem.point[2].y / it->vectorScale;
+
+            // The end point of the vectors
+            xLTend = xLTstart + zoomFactor * vxLT;
+            yLTend = yLTstart + zoomFactor * vyLT;
+            xRTend = xRTstart + zoomFactor * vxRT;
+            yRTend = yRTstart + zoomFactor * vyRT;
+            xLBend = xLBstart + zoomFactor * vxLB;
+            yLBend = yLBstart + zoomFactor * vyLB;
+
+            paintVector(painter,
+                        *it,
+                        zoomFactor,
+                        xLTstart,
+                        yLTstart,
+                        xLTend,
+                        yLTend,
+                        vxLT,
+                        vyLT,
+                        false,
+                        xMin,
+                        xMax,
+                        yMin,
+                        yMax);
+            paintVector(painter,
+                        *it,
+                        zoomFactor,
+                        xRTstart,
+                        yRTstart,
+                        xRTend,
+                        yRTend,
+                        vxRT,
+                        vyRT,
+                        false,
+                        xMin,
+                        xMax,
+                        yMin,
+                        yMax);
+            paintVector(painter,
+                        *it,
+                        zoomFactor,
+                        xLBstart,
+                        yLBstart,
+                        xLBend,
+                        yLBend,
+                        vxLB,
+                        vyLB,
+                        false,
+                        xMin,
+                        xMax,
+                        yMin,
+                        yMax);
+          }
 
-      // optionally, draw a grid around the region that the arrow is defined for
-      if (it->renderGrid && rectVisible)
-      {
-        auto gridStyle = it->gridStyle;
-        if (it->scaleGridToZoom)
-          gridStyle.width = gridStyle.width * zoomFactor;
+          // optionally, draw a grid around the region that the arrow is defined for
+          if (it->renderGrid && rectVisible)
+          {
+            auto gridStyle = it->gridStyle;
+            if (it->scaleGridToZoom)
+              gridStyle.width = gridStyle.width * zoomFactor;
 
-        painter->setPen(styleToPen(gridStyle));
-        painter->setBrush(QBrush(QColor(Qt::color0), Qt::NoBrush)); // no fill color
+            painter->setPen(styleToPen(gridStyle));
+            painter->setBrush(QBrush(QColor(Qt::color0), Qt::NoBrush)); // no fill color
 
-        painter->drawRect(displayRect);
-      }
-    }
+            painter->drawRect(displayRect);
+          }
+        });
   }
 
   // Draw all polygon vector data
@@ -826,168 +845,174 @@ void stats::paintStatisticsData(QPainter *             painter,
       // This statistics type is not rendered or could not be loaded.
       continue;
 
-    // Go through all the vector data
-    for (const auto &vectorItem : statisticsData[it->typeID].polygonVectorData)
-    {
-      if (vectorItem.corners.size() < 3)
-        continue; // need at least triangle -- or more corners
-
-      // Calculate the size and position of the rectangle to draw (zoomed in)
-      auto vectorPoly          = convertToQPolygon(vectorItem.corners);
-      auto trans               = QTransform().scale(zoomFactor, zoomFactor);
-      auto displayPolygon      = trans.map(vectorPoly);
-      auto displayBoundingRect = displayPolygon.boundingRect();
-
-      // Check if the rectangle of the statistics item is even visible
-      bool isVisible = (!(displayBoundingRect.left() > xMax || displayBoundingRect.right() < xMin ||
-                          displayBoundingRect.top() > yMax || displayBoundingRect.bottom() < yMin));
-      if (!isVisible)
-        continue;
-
-      if (it->renderVectorData)
-      {
-        // start vector at center of the block
-        int   center_x, center_y, head_x, head_y;
-        float vx, vy;
+    const auto &typeData   = statisticsData[it->typeID];
+    const auto  vectorArea = getVectorArea(visibleArea, typeData, *it);
 
-        center_x = 0;
-        center_y = 0;
-        for (const QPoint &point : displayPolygon)
+    // Go through all the vector data
+    typeData.forEachPolygonVectorIn(
+        vectorArea,
+        [&](const StatsItemPolygonVector &vectorItem)
         {
-          center_x += point.x();
-          center_y += point.y();
-        }
-        center_x /= displayPolygon.size();
-        center_y /= displayPolygon.size();
+          if (vectorItem.corners.size() < 3)
+            return; // need at least triangle -- or more corners
+
+          // Calculate the size and position of the rectangle to draw (zoomed in)
+          auto vectorPoly          = convertToQPolygon(vectorItem.corners);
+          auto trans               = QTransform().scale(zoomFactor, zoomFactor);
+          auto displayPolygon      = trans.map(vectorPoly);
+          auto displayBoundingRect = displayPolygon.boundingRect();
+
+          // Check if the rectangle of the statistics item is even visible
+          bool isVisible =
+              (!(displayBoundingRect.left() > xMax || displayBoundingRect.right() < xMin ||
+                 displayBoundingRect.top() > yMax || displayBoundingRect.bottom() < yMin));
+          if (!isVisible)
+            return;
+
+          if (it->renderVectorData)
+          {
+            // start vector at center of the block
+            int   center_x, center_y, head_x, head_y;
+            float vx, vy;
 
-        // The length of the vector
-        vx = (float)vectorItem.point.x / it->vectorScale;
-        vy = (float)vectorItem.point.y / it->vectorScale;
+            center_x = 0;
+            center_y = 0;
+            for (const QPoint &point : displayPolygon)
+            {
+              center_x += point.x();
+              center_y += point.y();
+            }
+            center_x /= displayPolygon.size();
+            center_y /= displayPolygon.size();
 
-        // The end point of the vector
-        head_x = center_x + zoomFactor * vx;
-        head_y = center_y + zoomFactor * vy;
+            // The length of the vector
+            vx = (float)vectorItem.point.x / it->vectorScale;
+            vy = (float)vectorItem.point.y / it->vectorScale;
 
-        // Is the arrow (possibly) visible?
-        if (!(center_x < xMin && head_x < xMin) && !(center_x > xMax && head_x > xMax) &&
-            !(center_y < yMin && head_y < yMin) && !(center_y > yMax && head_y > yMax))
-        {
-          // Set the pen for drawing
-          auto vectorStyle = it->vectorStyle;
-          auto arrowColor  = functionsGui::toQColor(vectorStyle.color);
-          if (it->mapVectorToColor)
-            arrowColor.setHsvF(
-                functions::clip((std::atan2(vy, vx) + M_PI) / (2 * M_PI), 0.0, 1.0), 1.0, 1.0);
-          arrowColor.setAlpha(arrowColor.alpha() * ((float)it->alphaFactor / 100.0));
-          if (it->scaleVectorToZoom)
-            vectorStyle.width = vectorStyle.width * zoomFactor / 8;
-
-          painter->setPen(
-              QPen(arrowColor, vectorStyle.width, patternToQPenStyle(vectorStyle.pattern)));
-          painter->setBrush(arrowColor);
-
-          // Draw the arrow tip, or a circle if the vector is (0,0) if the zoom factor is not 1 or
-          // smaller.
-          if (zoomFactor > 1)
-          {
-            // At which angle do we draw the triangle?
-            // A vector to the right (1,  0) -> 0°
-            // A vector to the top   (0, -1) -> 90°
-            const auto angle = std::atan2(vy, vx);
+            // The end point of the vector
+            head_x = center_x + zoomFactor * vx;
+            head_y = center_y + zoomFactor * vy;
 
-            // Draw the vector head if the vector is not 0,0
-            if ((vx != 0 || vy != 0))
+            // Is the arrow (possibly) visible?
+            if (!(center_x < xMin && head_x < xMin) && !(center_x > xMax && head_x > xMax) &&
+                !(center_y < yMin && head_y < yMin) && !(center_y > yMax && head_y > yMax))
             {
-              // The size of the arrow head
-              const int headSize =
-                  (zoomFactor >= STATISTICS_DRAW_VALUES_ZOOM && !it->scaleVectorToZoom)
-                      ? 8
-                      : zoomFactor / 2;
-              if (it->arrowHead != StatisticsType::ArrowHead::none)
+              // Set the pen for drawing
+              auto vectorStyle = it->vectorStyle;
+              auto arrowColor  = functionsGui::toQColor(vectorStyle.color);
+              if (it->mapVectorToColor)
+                arrowColor.setHsvF(
+                    functions::clip((std::atan2(vy, vx) + M_PI) / (2 * M_PI), 0.0, 1.0), 1.0, 1.0);
+              arrowColor.setAlpha(arrowColor.alpha() * ((float)it->alphaFactor / 100.0));
+              if (it->scaleVectorToZoom)
+                vectorStyle.width = vectorStyle.width * zoomFactor / 8;
+
+              painter->setPen(
+                  QPen(arrowColor, vectorStyle.width, patternToQPenStyle(vectorStyle.pattern)));
+              painter->setBrush(arrowColor);
+
+              // Draw the arrow tip, or a circle if the vector is (0,0) if the zoom factor is not 1
+              // or smaller.
+              if (zoomFactor > 1)
               {
-                // We draw an arrow head. This means that we will have to draw a shortened line
-                const int shorten = (it->arrowHead == StatisticsType::ArrowHead::arrow)
-                                        ? headSize * 2
-                                        : headSize * 0.5;
-                if (std::sqrt(vx * vx * zoomFactor * zoomFactor +
-                              vy * vy * zoomFactor * zoomFactor) > shorten)
+                // At which angle do we draw the triangle?
+                // A vector to the right (1,  0) -> 0°
+                // A vector to the top   (0, -1) -> 90°
+                const auto angle = std::atan2(vy, vx);
+
+                // Draw the vector head if the vector is not 0,0
+                if ((vx != 0 || vy != 0))
                 {
-                  // Shorten the line and draw it
-                  auto vectorLine = QLineF(center_x,
-                                           center_y,
-                                           double(head_x) - std::cos(angle) * shorten,
-                                           double(head_y) - std::sin(angle) * shorten);
-                  painter->drawLine(vectorLine);
+                  // The size of the arrow head
+                  const int headSize =
+                      (zoomFactor >= STATISTICS_DRAW_VALUES_ZOOM && !it->scaleVectorToZoom)
+                          ? 8
+                          : zoomFactor / 2;
+                  if (it->arrowHead != StatisticsType::ArrowHead::none)
+                  {
+                    // We draw an arrow head. This means that we will have to draw a shortened line
+                    const int shorten = (it->arrowHead == StatisticsType::ArrowHead::arrow)
+                                            ? headSize * 2
+                                            : headSize * 0.5;
+                    if (std::sqrt(vx * vx * zoomFactor * zoomFactor +
+                                  vy * vy * zoomFactor * zoomFactor) > shorten)
+                    {
+                      // Shorten the line and draw it
+                      auto vectorLine = QLineF(center_x,
+                                               center_y,
+                                               double(head_x) - std::cos(angle) * shorten,
+                                               double(head_y) - std::sin(angle) * shorten);
+                      painter->drawLine(vectorLine);
+                    }
+                  }
+                  else
+                    // Draw the not shortened line
+                    painter->drawLine(center_x, center_y, head_x, head_y);
+
+                  if (it->arrowHead == StatisticsType::ArrowHead::arrow)
+                  {
+                    // Save the painter state, translate to the arrow tip, rotate the painter and
+                    // draw the normal triangle.
+                    painter->save();
+
+                    // Draw the arrow tip with fixed size
+                    painter->translate(QPoint(head_x, head_y));
+                    painter->rotate(qRadiansToDegrees(angle));
+                    const QPoint points[3] = {QPoint(0, 0),
+                                              QPoint(-headSize * 2, -headSize),
+                                              QPoint(-headSize * 2, headSize)};
+                    painter->drawPolygon(points, 3);
+
+                    // Restore. Revert translation/rotation of the painter.
+                    painter->restore();
+                  }
+                  else if (it->arrowHead == StatisticsType::ArrowHead::circle)
+                    painter->drawEllipse(
+                        head_x - headSize / 2, head_y - headSize / 2, headSize, headSize);
                 }
+
+                // Todo
+                // if (zoomFactor >= STATISTICS_DRAW_VALUES_ZOOM &&
+                // it->renderVectorDataValues)
+                // {
+                //   // Also draw the vector value next to the arrow head
+                //     QString txt = QString("x %1\ny %2").arg(vx).arg(vy);
+                //     QRect textRect = painter->boundingRect(QRect(), Qt::AlignLeft, txt);
+                //     textRect.moveCenter(QPoint(head_x,head_y));
+                //     int a = qRadiansToDegrees(angle);
+                //     if (a < 45 && a > -45)
+                //       textRect.moveLeft(head_x);
+                //     else if (a <= -45 && a > -135)
+                //       textRect.moveBottom(head_y);
+                //     else if (a >= 45 && a < 135)
+                //       textRect.moveTop(head_y);
+                //     else
+                //       textRect.moveRight(head_x);
+                //     painter->drawText(textRect, Qt::AlignLeft, txt);
+
+                // }
               }
               else
-                // Draw the not shortened line
-                painter->drawLine(center_x, center_y, head_x, head_y);
-
-              if (it->arrowHead == StatisticsType::ArrowHead::arrow)
               {
-                // Save the painter state, translate to the arrow tip, rotate the painter and draw
-                // the normal triangle.
-                painter->save();
-
-                // Draw the arrow tip with fixed size
-                painter->translate(QPoint(head_x, head_y));
-                painter->rotate(qRadiansToDegrees(angle));
-                const QPoint points[3] = {QPoint(0, 0),
-                                          QPoint(-headSize * 2, -headSize),
-                                          QPoint(-headSize * 2, headSize)};
-                painter->drawPolygon(points, 3);
-
-                // Restore. Revert translation/rotation of the painter.
-                painter->restore();
+                // No arrow head is drawn. Only draw a line.
+                painter->drawLine(center_x, center_y, head_x, head_y);
               }
-              else if (it->arrowHead == StatisticsType::ArrowHead::circle)
-                painter->drawEllipse(
-                    head_x - headSize / 2, head_y - headSize / 2, headSize, headSize);
             }
-
-            // Todo
-            // if (zoomFactor >= STATISTICS_DRAW_VALUES_ZOOM &&
-            // it->renderVectorDataValues)
-            // {
-            //   // Also draw the vector value next to the arrow head
-            //     QString txt = QString("x %1\ny %2").arg(vx).arg(vy);
-            //     QRect textRect = painter->boundingRect(QRect(), Qt::AlignLeft, txt);
-            //     textRect.moveCenter(QPoint(head_x,head_y));
-            //     int a = qRadiansToDegrees(angle);
-            //     if (a < 45 && a > -45)
-            //       textRect.moveLeft(head_x);
-            //     else if (a <= -45 && a > -135)
-            //       textRect.moveBottom(head_y);
-            //     else if (a >= 45 && a < 135)
-            //       textRect.moveTop(head_y);
-            //     else
-            //       textRect.moveRight(head_x);
-            //     painter->drawText(textRect, Qt::AlignLeft, txt);
-
-            // }
-          }
-          else
-          {
-            // No arrow head is drawn. Only draw a line.
-            painter->drawLine(center_x, center_y, head_x, head_y);
           }
-        }
-      }
 
-      // optionally, draw the polygon outline
-      if (it->renderGrid && isVisible)
-      {
-        auto gridStyle = it->gridStyle;
-        if (it->scaleGridToZoom)
-          gridStyle.width = gridStyle.width * zoomFactor;
+          // optionally, draw the polygon outline
+          if (it->renderGrid && isVisible)
+          {
+            auto gridStyle = it->gridStyle;
+            if (it->scaleGridToZoom)
+              gridStyle.width = gridStyle.width * zoomFactor;
 
-        painter->setPen(styleToPen(gridStyle));
-        painter->setBrush(QBrush(QColor(Qt::color0), Qt::NoBrush)); // no fill color
+            painter->setPen(styleToPen(gridStyle));
+            painter->setBrush(QBrush(QColor(Qt::color0), Qt::NoBrush)); // no fill color
 
-        painter->drawPolygon(displayPolygon);
-      }
-    }
+            painter->drawPolygon(displayPolygon);
+          }
+        });
   }
 
   // Restore the state the state of the painter from before this function was called.
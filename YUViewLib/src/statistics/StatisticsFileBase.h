@@ -37,6 +37,9 @@
 
 #include <QObject>
 
+#include <string>
+#include <string_view>
+
 namespace stats
 {
 
@@ -77,6 +80,73 @@ signals:
   void readPOC(int newPoc);
 
 protected:
+  // A corrupted file may contain an arbitrary amount of non-\n symbols. Longer lines are dropped.
+  static constexpr unsigned MAX_LINE_SIZE = 1u << 28;
+
+  /* Read the file line by line starting at startPos using a fixed size buffer. The function is
+   * called with every line (without the newline) and the file position where the line starts. If
+   * the function returns false, reading is stopped. Only lines which cross the boundary of the
+   * buffer are copied. Returns true if the end of the file was reached without an error.
+   */
+  template <typename LineFunction>
+  static bool forEachLineInFile(FileSource   &file,
+                                uint64_t      startPos,
+                                unsigned      bufferSize,
+                                LineFunction &&lineFunction)
+  {
+    QByteArray  inputBuffer;
+    std::string partialLine;
+    uint64_t    bufferStartPos      = startPos;
+    uint64_t    partialLineStartPos = startPos;
+
+    while (true)
+    {
+      const auto nrBytesRead = file.readBytes(inputBuffer, int64_t(bufferStartPos), bufferSize);
+      if (nrBytesRead < 0)
+        return false; // Error reading bytes from file
+      if (nrBytesRead == 0)
+        break;
+
+      const std::string_view buffer(inputBuffer.constData(), size_t(nrBytesRead));
+      size_t                 lineStart = 0;
+      while (true)
+      {
+        const auto lineEnd = buffer.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos)
+        {
+          if (partialLine.empty())
+            partialLineStartPos = bufferStartPos + lineStart;
+          if (partialLine.size() > MAX_LINE_SIZE)
+            partialLine.clear();
+          partialLine.append(buffer.substr(lineStart));
+          break;
+        }
+
+        auto line         = buffer.substr(lineStart, lineEnd - lineStart);
+        auto lineStartPos = bufferStartPos + lineStart;
+        if (!partialLine.empty())
+        {
+          partialLine.append(line);
+          line         = partialLine;
+          lineStartPos = partialLineStartPos;
+        }
+        if (!lineFunction(line, lineStartPos))
+          return false;
+
+        partialLine.clear();
+        lineStart = lineEnd + 1;
+      }
+
+      bufferStartPos += uint64_t(nrBytesRead);
+      if (nrBytesRead < int64_t(bufferSize))
+        break;
+    }
+
+    if (!partialLine.empty())
+      lineFunction(std::string_view(partialLine), partialLineStartPos);
+    return true;
+  }
+
   FileSource file;
 
   // Set if the file is sorted by POC and the types are 'random' within this POC (true)
@@ -32,7 +32,10 @@
 
 #include "StatisticsFileCSV.h"
 
-#include <QTextStream>
+#include <filesource/FileIndexCache.h>
+
+#include <algorithm>
+#include <charconv>
 #include <iostream>
 
 namespace stats
@@ -45,7 +48,11 @@ namespace
 // so that we can address all the positions in it with int (using such a large buffer is not a good
 // idea anyways)
 constexpr unsigned STAT_PARSING_BUFFER_SIZE = 1048576u;
-constexpr unsigned STAT_MAX_STRING_SIZE     = 1u << 28;
+constexpr unsigned STAT_LOADING_BUFFER_SIZE = 65536u;
+
+// The index consists of the sorting and the file positions of all POC/type combinations. Increase
+// the version if this changes.
+constexpr auto CSV_INDEX_TYPE = "StatisticsCSV-v1";
 
 QStringList parseCSVLine(const QString &srcLine, char delimiter)
 {
@@ -55,8 +62,129 @@ QStringList parseCSVLine(const QString &srcLine, char delimiter)
   return line.split(delimiter);
 }
 
+bool isWhitespace(const char c)
+{
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+std::string_view trimmed(std::string_view str)
+{
+  while (!str.empty() && isWhitespace(str.front()))
+    str.remove_prefix(1);
+  while (!str.empty() && isWhitespace(str.back()))
+    str.remove_suffix(1);
+  return str;
+}
+
+// Same as QString::toInt: 0 if the field is not a valid integer.
+int parseIntField(std::string_view field)
+{
+  field = trimmed(field);
+  if (field.size() > 1 && field.front() == '+')
+    field.remove_prefix(1);
+
+  int        value{};
+  const auto end            = field.data() + field.size();
+  const auto [ptr, errCode] = std::from_chars(field.data(), end, value);
+  if (errCode != std::errc() || ptr != end)
+    return 0;
+  return value;
+}
+
+/* Lookup from the typeID to the statistics type and the data of the type. The type IDs are usually
+ * small numbers so a table is used. The data is only created in the StatisticsData once it is
+ * accessed.
+ */
+class StatisticsTypeLookup
+{
+public:
+  explicit StatisticsTypeLookup(StatisticsData &statisticsData) : statisticsData(statisticsData)
+  {
+    for (auto &type : statisticsData.getStatisticsTypes())
+    {
+      if (type.typeID < 0 || type.typeID > MAX_TABLE_TYPE_ID)
+        continue;
+      if (size_t(type.typeID) >= this->table.size())
+        this->table.resize(size_t(type.typeID) + 1);
+      this->table[size_t(type.typeID)].type = &type;
+    }
+  }
+
+  // Returns nullptr for an unknown type
+  StatisticsType *getType(const int typeID)
+  {
+    if (auto entry = this->getEntry(typeID))
+      return entry->type;
+
+    auto &statTypes = this->statisticsData.getStatisticsTypes();
+    auto  statIt    = std::find_if(statTypes.begin(),
+                               statTypes.end(),
+                               [typeID](StatisticsType &t) { return t.typeID == typeID; });
+    return statIt == statTypes.end() ? nullptr : &(*statIt);
+  }
+
+  FrameTypeData &getData(const int typeID)
+  {
+    auto entry = this->getEntry(typeID);
+    if (entry == nullptr)
+      return this->statisticsData[typeID];
+    if (entry->data == nullptr)
+      entry->data = &this->statisticsData[typeID];
+    return *entry->data;
+  }
+
+private:
+  static constexpr int MAX_TABLE_TYPE_ID = 65535;
+
+  struct Entry
+  {
+    StatisticsType *type{};
+    FrameTypeData  *data{};
+  };
+
+  Entry *getEntry(const int typeID)
+  {
+    if (typeID < 0 || size_t(typeID) >= this->table.size() || this->table[typeID].type == nullptr)
+      return nullptr;
+    return &this->table[typeID];
+  }
+
+  StatisticsData    &statisticsData;
+  std::vector<Entry> table;
+};
+
 } // namespace
 
+std::optional<CSVDataLine> parseCSVDataLine(std::string_view line)
+{
+  line = trimmed(line);
+
+  CSVDataLine dataLine;
+  size_t      fieldStart = 0;
+  while (true)
+  {
+    const auto fieldEnd = line.find(';', fieldStart);
+    const auto field    = line.substr(fieldStart, fieldEnd - fieldStart);
+
+    if (dataLine.nrFields == 0)
+    {
+      const auto firstField = trimmed(field);
+      if (firstField.empty() || firstField.front() == '%')
+        return {};
+    }
+
+    if (dataLine.nrFields < CSVDataLine::MAX_NR_FIELDS)
+      dataLine.fields[dataLine.nrFields] = parseIntField(field);
+    dataLine.nrFields++;
+
+    if (fieldEnd == std::string_view::npos)
+      break;
+    fieldStart = fieldEnd + 1;
+  }
+
+  return dataLine;
+}
+
 StatisticsFileCSV::StatisticsFileCSV(const QString &filename, StatisticsData &statisticsData)
     : StatisticsFileBase(filename)
 {
@@ -73,6 +201,12 @@ StatisticsFileCSV::StatisticsFileCSV(const QString &filename, StatisticsData &st
  */
 void StatisticsFileCSV::readFrameAndTypePositionsFromFile(std::atomic_bool &breakFunction)
 {
+  if (this->readIndexFromCache())
+  {
+    this->parsingProgress = 100.0;
+    return;
+  }
+
   try
   {
     // Open the file (again). Since this is a background process, we open the file again to
@@ -81,140 +215,107 @@ void StatisticsFileCSV::readFrameAndTypePositionsFromFile(std::atomic_bool &brea
     if (!inputFile.openFile(this->file.getAbsoluteFilePath()))
       return;
 
-    // We perform reading using an input buffer
-    QByteArray inputBuffer;
-    bool       fileAtEnd      = false;
-    uint64_t   bufferStartPos = 0;
-
-    QString  lineBuffer;
-    uint64_t lineBufferStartPos = 0;
-    int      lastPOC            = INT_INVALID;
-    int      lastType           = INT_INVALID;
-    bool     sortingFixed       = false;
+    int  lastPOC      = INT_INVALID;
+    int  lastType     = INT_INVALID;
+    bool sortingFixed = false;
 
     this->parsingProgress = 0;
 
-    while (!fileAtEnd && !breakFunction.load() && !this->abortParsingDestroy)
-    {
-      // Fill the buffer
-      auto bufferSize = inputFile.readBytes(inputBuffer, bufferStartPos, STAT_PARSING_BUFFER_SIZE);
-      if (bufferSize < 0)
-        return; // Error reading bytes from file
-      if (bufferSize < STAT_PARSING_BUFFER_SIZE)
-        // Less bytes than the maximum buffer size were read. The file is at the end.
-        // This is the last run of the loop.
-        fileAtEnd = true;
-      // a corrupted file may contain an arbitrary amount of non-\n symbols
-      // prevent lineBuffer overflow by dumping it for such cases
-      if (unsigned(lineBuffer.size()) > STAT_MAX_STRING_SIZE)
-        lineBuffer.clear(); // prevent an overflow here
-      for (size_t i = 0; i < size_t(bufferSize); i++)
-      {
-        // Search for '\n' newline characters
-        if (inputBuffer.at(int(i)) == 10)
+    const auto fileAtEnd = forEachLineInFile(
+        inputFile,
+        0,
+        STAT_PARSING_BUFFER_SIZE,
+        [&](std::string_view line, uint64_t lineStartPos)
         {
-          // We found a newline character
-          if (lineBuffer.size() > 0)
+          if (breakFunction.load() || this->abortParsingDestroy)
+            return false;
+
+          // ignore empty entries and headers
+          const auto dataLine = parseCSVDataLine(line);
+          if (!dataLine)
+            return true;
+
+          // check for POC/type information
+          const auto poc    = dataLine->poc();
+          const auto typeID = dataLine->typeID();
+
+          if (lastType == -1 && lastPOC == -1)
           {
-            // Parse the previous line
-            // get components of this line
-            auto rowItemList = parseCSVLine(lineBuffer, ';');
+            // First POC/type line
+            this->pocTypeFileposMap[poc][typeID] = lineStartPos;
+            emit readPOCType(poc, typeID);
 
-            // ignore empty entries and headers
-            if (!rowItemList[0].isEmpty() && rowItemList[0][0] != '%')
+            lastType = typeID;
+            lastPOC  = poc;
+
+            // update number of frames
+            if (poc > this->maxPOC)
+              this->maxPOC = poc;
+          }
+          else if (typeID != lastType && poc == lastPOC)
+          {
+            // we found a new type but the POC stayed the same.
+            // This seems to be an interleaved file
+            // Check if we already collected a start position for this type
+            if (!sortingFixed)
             {
-              // check for POC/type information
-              auto poc    = rowItemList[0].toInt();
-              auto typeID = rowItemList[5].toInt();
-
-              if (lastType == -1 && lastPOC == -1)
-              {
-                // First POC/type line
-                this->pocTypeFileposMap[poc][typeID] = lineBufferStartPos;
-                emit readPOCType(poc, typeID);
-
-                lastType = typeID;
-                lastPOC  = poc;
-
-                // update number of frames
-                if (poc > this->maxPOC)
-                  this->maxPOC = poc;
-              }
-              else if (typeID != lastType && poc == lastPOC)
-              {
-                // we found a new type but the POC stayed the same.
-                // This seems to be an interleaved file
-                // Check if we already collected a start position for this type
-                if (!sortingFixed)
-                {
-                  // we only check the first occurence of this, in a non-interleaved file
-                  // the above condition can be met and will reset fileSortedByPOC
-
-                  this->fileSortedByPOC = true;
-                  sortingFixed          = true;
-                }
-                lastType = typeID;
-                if (this->pocTypeFileposMap[poc].count(typeID) == 0)
-                {
-                  this->pocTypeFileposMap[poc][typeID] = lineBufferStartPos;
-                  emit readPOCType(poc, typeID);
-                }
-              }
-              else if (poc != lastPOC)
-              {
-                // this is apparently not sorted by POCs and we will not check it further
-                if (!sortingFixed)
-                  sortingFixed = true;
-
-                // We found a new POC
-                if (this->fileSortedByPOC)
-                {
-                  // There must not be a start position for any type with this POC already.
-                  if (this->pocTypeFileposMap.count(poc) > 0)
-                    throw "The data for each POC must be continuous in an interleaved statistics "
-                          "file";
-                }
-                else
-                {
-                  // There must not be a start position for this POC/type already.
-                  if (this->pocTypeFileposMap.count(poc) > 0 &&
-                      this->pocTypeFileposMap[poc].count(typeID) > 0)
-                    throw "The data for each typeID must be continuous in an non interleaved "
-                          "statistics file";
-                }
-
-                lastPOC  = poc;
-                lastType = typeID;
-
-                this->pocTypeFileposMap[poc][typeID] = lineBufferStartPos;
-                emit readPOCType(poc, typeID);
-
-                // update number of frames
-                if (poc > this->maxPOC)
-                  this->maxPOC = poc;
-
-                // Update percent of file parsed
-                if (const auto fileSize = inputFile.getFileSize())
-                  this->parsingProgress = (static_cast<double>(lineBufferStartPos) * 100 /
-                                           static_cast<double>(*fileSize));
-              }
+              // we only check the first occurence of this, in a non-interleaved file
+              // the above condition can be met and will reset fileSortedByPOC
+
+              this->fileSortedByPOC = true;
+              sortingFixed          = true;
+            }
+            lastType = typeID;
+            if (this->pocTypeFileposMap[poc].count(typeID) == 0)
+            {
+              this->pocTypeFileposMap[poc][typeID] = lineStartPos;
+              emit readPOCType(poc, typeID);
             }
           }
+          else if (poc != lastPOC)
+          {
+            // this is apparently not sorted by POCs and we will not check it further
+            if (!sortingFixed)
+              sortingFixed = true;
 
-          lineBuffer.clear();
-          lineBufferStartPos = bufferStartPos + i + 1;
-        }
-        else
-        {
-          // No newline character found
-          lineBuffer.append(inputBuffer.at(int(i)));
-        }
-      }
+            // We found a new POC
+            if (this->fileSortedByPOC)
+            {
+              // There must not be a start position for any type with this POC already.
+              if (this->pocTypeFileposMap.count(poc) > 0)
+                throw "The data for each POC must be continuous in an interleaved statistics "
+                      "file";
+            }
+            else
+            {
+              // There must not be a start position for this POC/type already.
+              if (this->pocTypeFileposMap.count(poc) > 0 &&
+                  this->pocTypeFileposMap[poc].count(typeID) > 0)
+                throw "The data for each typeID must be continuous in an non interleaved "
+                      "statistics file";
+            }
 
-      bufferStartPos += bufferSize;
-    }
+            lastPOC  = poc;
+            lastType = typeID;
+
+            this->pocTypeFileposMap[poc][typeID] = lineStartPos;
+            emit readPOCType(poc, typeID);
+
+            // update number of frames
+            if (poc > this->maxPOC)
+              this->maxPOC = poc;
+
+            // Update percent of file parsed
+            if (const auto fileSize = inputFile.getFileSize())
+              this->parsingProgress =
+                  (static_cast<double>(lineStartPos) * 100 / static_cast<double>(*fileSize));
+          }
+          return true;
+        });
 
     this->parsingProgress = 100.0;
+    if (fileAtEnd)
+      this->writeIndexToCache();
   }
   catch (const char *str)
   {
@@ -230,6 +331,61 @@ void StatisticsFileCSV::readFrameAndTypePositionsFromFile(std::atomic_bool &brea
   }
 }
 
+bool StatisticsFileCSV::readIndexFromCache()
+{
+  filesource::FileIndexCache cache(this->file.getAbsoluteFilePath(), CSV_INDEX_TYPE);
+  return cache.read(
+      [this](QDataStream &stream)
+      {
+        bool    sortedByPOC{};
+        qint32  maxPOC{};
+        quint32 nrPOCs{};
+        stream >> sortedByPOC >> maxPOC >> nrPOCs;
+
+        std::map<int, TypeFileposMap> fileposMap;
+        for (quint32 i = 0; i < nrPOCs && stream.status() == QDataStream::Ok; i++)
+        {
+          qint32  poc{};
+          quint32 nrTypes{};
+          stream >> poc >> nrTypes;
+          for (quint32 j = 0; j < nrTypes && stream.status() == QDataStream::Ok; j++)
+          {
+            qint32  typeID{};
+            quint64 filePos{};
+            stream >> typeID >> filePos;
+            fileposMap[poc][typeID] = filePos;
+          }
+        }
+        if (stream.status() != QDataStream::Ok)
+          return false;
+
+        this->fileSortedByPOC   = sortedByPOC;
+        this->maxPOC            = maxPOC;
+        this->pocTypeFileposMap = std::move(fileposMap);
+        for (const auto &pocEntry : this->pocTypeFileposMap)
+          for (const auto &typeEntry : pocEntry.second)
+            emit readPOCType(pocEntry.first, typeEntry.first);
+        return true;
+      });
+}
+
+void StatisticsFileCSV::writeIndexToCache() const
+{
+  filesource::FileIndexCache cache(this->file.getAbsoluteFilePath(), CSV_INDEX_TYPE);
+  cache.write(
+      [this](QDataStream &stream)
+      {
+        stream << this->fileSortedByPOC << qint32(this->maxPOC)
+               << quint32(this->pocTypeFileposMap.size());
+        for (const auto &pocEntry : this->pocTypeFileposMap)
+        {
+          stream << qint32(pocEntry.first) << quint32(pocEntry.second.size());
+          for (const auto &typeEntry : pocEntry.second)
+            stream << qint32(typeEntry.first) << quint64(typeEntry.second);
+        }
+      });
+}
+
 void StatisticsFileCSV::loadStatisticData(StatisticsData &statisticsData, int poc, int typeID)
 {
   if (!this->file.isOk())
@@ -260,74 +416,61 @@ void StatisticsFileCSV::loadStatisticData(StatisticsData &statisticsData, int po
           startPos = typeEntry.second;
     }
 
-    QTextStream in(this->file.getQFile());
-    in.seek(startPos);
+    StatisticsTypeLookup typeLookup(statisticsData);
+    const auto           frameSize = statisticsData.getFrameSize();
 
-    while (!in.atEnd())
-    {
-      // read one line
-      auto aLine       = in.readLine();
-      auto rowItemList = parseCSVLine(aLine, ';');
-
-      if (rowItemList[0].isEmpty())
-        continue;
-
-      auto pocRow = rowItemList[0].toInt();
-      auto type   = rowItemList[5].toInt();
-
-      // if there is a new POC, we are done here!
-      if (pocRow != poc)
-        break;
-      // if there is a new type and this is a non interleaved file, we are done here.
-      if (!this->fileSortedByPOC && type != typeID)
-        break;
-
-      int values[4] = {0};
-
-      values[0] = rowItemList[6].toInt();
-
-      bool vectorData = false;
-      bool lineData   = false; // or a vector specified by 2 points
-
-      if (rowItemList.count() > 7)
-      {
-        values[1]  = rowItemList[7].toInt();
-        vectorData = true;
-      }
-      if (rowItemList.count() > 8)
-      {
-        values[2]  = rowItemList[8].toInt();
-        values[3]  = rowItemList[9].toInt();
-        lineData   = true;
-        vectorData = false;
-      }
-
-      auto posX   = rowItemList[1].toInt();
-      auto posY   = rowItemList[2].toInt();
-      auto width  = rowItemList[3].toUInt();
-      auto height = rowItemList[4].toUInt();
-
-      // Check if block is within the image range
-      if (this->blockOutsideOfFramePOC == -1 &&
-          (posX + int(width) > int(statisticsData.getFrameSize().width) ||
-           posY + int(height) > int(statisticsData.getFrameSize().height)))
-        // Block not in image. Warn about this.
-        this->blockOutsideOfFramePOC = poc;
-
-      auto &statTypes = statisticsData.getStatisticsTypes();
-      auto  statIt    = std::find_if(statTypes.begin(),
-                                 statTypes.end(),
-                                 [type](StatisticsType &t) { return t.typeID == type; });
-      Q_ASSERT_X(statIt != statTypes.end(), Q_FUNC_INFO, "Stat type not found.");
-
-      if (vectorData && statIt->hasVectorData)
-        statisticsData[type].addBlockVector(posX, posY, width, height, values[0], values[1]);
-      else if (lineData && statIt->hasVectorData)
-        statisticsData[type].addLine(
-            posX, posY, width, height, values[0], values[1], values[2], values[3]);
-      else
-        statisticsData[type].addBlockValue(posX, posY, width, height, values[0]);
-    }
+    forEachLineInFile(
+        this->file,
+        startPos,
+        STAT_LOADING_BUFFER_SIZE,
+        [&](std::string_view line, uint64_t)
+        {
+          const auto dataLine = parseCSVDataLine(line);
+          if (!dataLine)
+            return true;
+
+          const auto &fields = dataLine->fields;
+          const auto  pocRow = dataLine->poc();
+          const auto  type   = dataLine->typeID();
+
+          // if there is a new POC, we are done here!
+          if (pocRow != poc)
+            return false;
+          // if there is a new type and this is a non interleaved file, we are done here.
+          if (!this->fileSortedByPOC && type != typeID)
+            return false;
+
+          // A vector has 8 fields. A line (a vector specified by 2 points) has 10 fields.
+          const bool lineData   = dataLine->nrFields > 8;
+          const bool vectorData = dataLine->nrFields > 7 && !lineData;
+
+          const auto posX   = fields[1];
+          const auto posY   = fields[2];
+          const auto width  = unsigned(std::max(fields[3], 0));
+          const auto height = unsigned(std::max(fields[4], 0));
+
+          // Check if block is within the image range
+          if (this->blockOutsideOfFramePOC == -1 &&
+              (posX + int(width) > int(frameSize.width) ||
+               posY + int(height) > int(frameSize.height)))
+            // Block not in image. Warn about this.
+            this->blockOutsideOfFramePOC = poc;
+
+          const auto statType = typeLookup.getType(type);
+          Q_ASSERT_X(statType != nullptr, Q_FUNC_INFO, "Stat type not found.");
+          if (statType == nullptr)
+            return true;
+
+          auto &frameTypeData = typeLookup.getData(type);
+          if (vectorData && statType->hasVectorData)
+            frameTypeData.addBlockVector(posX, posY, width, height, fields[6], fields[7]);
+          else if (lineData && statType->hasVectorData)
+            frameTypeData.addLine(
+                posX, posY, width, height, fields[6], fields[7], fields[8], fields[9]);
+          else
+            frameTypeData.addBlockValue(posX, posY, width, height, fields[6]);
+          return true;
+        });
   }
   catch (const char *str)
   {
@@ -34,9 +34,32 @@
 
 #include "StatisticsFileBase.h"
 
+#include <array>
+#include <optional>
+#include <string_view>
+
 namespace stats
 {
 
+/* One data line of a CSV statistics file:
+ * POC;posX;posY;width;height;typeID;value[;value1[;value2;value3]]
+ * Fields that are not present or that are not a valid integer are 0.
+ */
+struct CSVDataLine
+{
+  static constexpr unsigned MAX_NR_FIELDS = 10;
+
+  int poc() const { return this->fields[0]; }
+  int typeID() const { return this->fields[5]; }
+
+  std::array<int, MAX_NR_FIELDS> fields{};
+  unsigned                       nrFields{};
+};
+
+// Parse one data line (without the newline) in place. No memory is allocated. Returns {} for empty
+// lines and header lines (starting with '%').
+std::optional<CSVDataLine> parseCSVDataLine(std::string_view line);
+
 /* Abstract base class that prvides features which are common to all parsers
  */
 class StatisticsFileCSV : public StatisticsFileBase
@@ -61,6 +84,11 @@ protected:
   //! Scan the header: What types are saved in this file?
   void readHeaderFromFile(StatisticsData &statisticsData);
 
+  // The file positions are saved in the FileIndexCache so that we don't have to parse the file
+  // again when it is opened the next time.
+  bool readIndexFromCache();
+  void writeIndexToCache() const;
+
   double framerate{-1};
 
   // File positions pocTypeFileposMap[poc][typeID]
@@ -32,19 +32,201 @@
 
 #include "StatisticsFileVTMBMS.h"
 
+#include <filesource/FileIndexCache.h>
+
 #include <QRegularExpression>
-#include <QTextStream>
 
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
 #include <iostream>
 
 namespace stats
 {
 
+namespace
+{
+
 // The internal buffer for parsing the starting positions. The buffer must not be larger than 2GB
 // so that we can address all the positions in it with int (using such a large buffer is not a good
 // idea anyways)
 constexpr unsigned STAT_PARSING_BUFFER_SIZE = 1048576u;
-constexpr unsigned STAT_MAX_STRING_SIZE     = 1u << 28;
+constexpr unsigned STAT_LOADING_BUFFER_SIZE = 65536u;
+
+// The index consists of the file positions of all POCs. Increase the version if this changes.
+constexpr auto VTMBMS_INDEX_TYPE = "StatisticsVTMBMS-v1";
+
+constexpr std::string_view POC_TAG = "BlockStat: POC ";
+
+/* Reads the tokens of a line of a VTM BMS file from left to right. Spaces before a token are
+ * skipped. If a token can not be read, the parser is not advanced. Nothing is allocated.
+ */
+class LineParser
+{
+public:
+  explicit LineParser(std::string_view line) : line(line) {}
+
+  bool readChar(const char c)
+  {
+    this->skipSpaces();
+    if (this->line.empty() || this->line.front() != c)
+      return false;
+    this->line.remove_prefix(1);
+    return true;
+  }
+
+  std::optional<int> readInt()
+  {
+    this->skipSpaces();
+    int        value{};
+    const auto end            = this->line.data() + this->line.size();
+    const auto [ptr, errCode] = std::from_chars(this->line.data(), end, value);
+    if (errCode != std::errc())
+      return {};
+    this->line.remove_prefix(size_t(ptr - this->line.data()));
+    return value;
+  }
+
+  // Skip a word (\w+) which is the name of the statistic
+  bool skipWord()
+  {
+    this->skipSpaces();
+    const auto isWordChar = [](const char c)
+    { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; };
+
+    size_t length = 0;
+    while (length < this->line.size() && isWordChar(this->line[length]))
+      length++;
+    this->line.remove_prefix(length);
+    return length > 0;
+  }
+
+private:
+  void skipSpaces()
+  {
+    while (!this->line.empty() && this->line.front() == ' ')
+      this->line.remove_prefix(1);
+  }
+
+  std::string_view line;
+};
+
+// Get the POC from a line like "BlockStat: POC 1 @( 120,  80) [ 8x 8] MVL0={ -24,  -2}". The
+// parser is advanced to the position after the POC.
+std::optional<int> parsePOC(std::string_view line, LineParser *parserAfterPOC = nullptr)
+{
+  const auto tagPos = line.find(POC_TAG);
+  if (tagPos == std::string_view::npos)
+    return {};
+
+  LineParser parser(line.substr(tagPos + POC_TAG.size()));
+  const auto poc = parser.readInt();
+  if (!poc || *poc < 0)
+    return {};
+  if (parserAfterPOC != nullptr)
+    *parserAfterPOC = parser;
+  return poc;
+}
+
+/* One statistic from a line after the POC. Either a block "@( 120,  80) [ 8x 8]" or a polygon
+ * "@[(505, 384)--(511, 384)--(511, 415)--]" followed by the name and a value "PredMode=0" or a
+ * list of values in braces "MVL0={ -24,  -2}".
+ */
+struct BlockStatistic
+{
+  static constexpr unsigned MAX_NR_VALUES  = 6;
+  static constexpr unsigned MAX_NR_CORNERS = 5;
+
+  bool     isPolygon{};
+  int      posX{};
+  int      posY{};
+  unsigned width{};
+  unsigned height{};
+
+  std::array<Point, MAX_NR_CORNERS> corners{};
+  unsigned                          nrCorners{};
+
+  std::array<int, MAX_NR_VALUES> values{};
+  unsigned                       nrValues{};
+  bool                           valuesInBraces{};
+};
+
+std::optional<BlockStatistic> parseBlockStatistic(LineParser &parser)
+{
+  BlockStatistic statistic;
+  if (!parser.readChar('@'))
+    return {};
+
+  if (parser.readChar('('))
+  {
+    const auto posX = parser.readInt();
+    if (!posX || !parser.readChar(','))
+      return {};
+    const auto posY = parser.readInt();
+    if (!posY || !parser.readChar(')') || !parser.readChar('['))
+      return {};
+    const auto width = parser.readInt();
+    if (!width || !parser.readChar('x'))
+      return {};
+    const auto height = parser.readInt();
+    if (!height || !parser.readChar(']'))
+      return {};
+    statistic.posX   = *posX;
+    statistic.posY   = *posY;
+    statistic.width  = unsigned(std::max(*width, 0));
+    statistic.height = unsigned(std::max(*height, 0));
+  }
+  else if (parser.readChar('['))
+  {
+    statistic.isPolygon = true;
+    while (parser.readChar('('))
+    {
+      const auto x = parser.readInt();
+      if (!x || !parser.readChar(','))
+        return {};
+      const auto y = parser.readInt();
+      if (!y || !parser.readChar(')') || !parser.readChar('-') || !parser.readChar('-'))
+        return {};
+      if (statistic.nrCorners == BlockStatistic::MAX_NR_CORNERS)
+        return {};
+      statistic.corners[statistic.nrCorners++] = Point(*x, *y);
+    }
+    if (statistic.nrCorners < 3 || !parser.readChar(']'))
+      return {};
+  }
+  else
+    return {};
+
+  if (!parser.skipWord() || !parser.readChar('='))
+    return {};
+
+  if (parser.readChar('{'))
+  {
+    statistic.valuesInBraces = true;
+    do
+    {
+      const auto value = parser.readInt();
+      if (!value || statistic.nrValues == BlockStatistic::MAX_NR_VALUES)
+        return {};
+      statistic.values[statistic.nrValues++] = *value;
+    } while (parser.readChar(','));
+    if (!parser.readChar('}'))
+      return {};
+  }
+  else
+  {
+    const auto value = parser.readInt();
+    if (!value)
+      return {};
+    statistic.values[0] = *value;
+    statistic.nrValues  = 1;
+  }
+
+  return statistic;
+}
+
+} // namespace
 
 StatisticsFileVTMBMS::StatisticsFileVTMBMS(const QString &filename, StatisticsData &statisticsData)
     : StatisticsFileBase(filename)
@@ -62,6 +244,12 @@ StatisticsFileVTMBMS::StatisticsFileVTMBMS(const QString &filename, StatisticsDa
  */
 void StatisticsFileVTMBMS::readFrameAndTypePositionsFromFile(std::atomic_bool &breakFunction)
 {
+  if (this->readIndexFromCache())
+  {
+    this->parsingProgress = 100.0;
+    return;
+  }
+
   try
   {
     // Open the file (again). Since this is a background process, we open the file again to
@@ -70,100 +258,64 @@ void StatisticsFileVTMBMS::readFrameAndTypePositionsFromFile(std::atomic_bool &b
     if (!inputFile.openFile(this->file.getAbsoluteFilePath()))
       return;
 
-    // We perform reading using an input buffer
-    QByteArray inputBuffer;
-    bool       fileAtEnd      = false;
-    uint64_t   bufferStartPos = 0;
+    int  lastPOC      = INT_INVALID;
+    bool sortingFixed = false;
 
-    QString  lineBuffer;
-    uint64_t lineBufferStartPos = 0;
-    int      lastPOC            = INT_INVALID;
-    bool     sortingFixed       = false;
-
-    while (!fileAtEnd && !breakFunction.load() && !this->abortParsingDestroy)
-    {
-      // Fill the buffer
-      auto bufferSize = inputFile.readBytes(inputBuffer, bufferStartPos, STAT_PARSING_BUFFER_SIZE);
-      if (bufferSize < 0)
-        throw "Error reading bytes";
-      if (bufferSize < STAT_PARSING_BUFFER_SIZE)
-        // Less bytes than the maximum buffer size were read. The file is at the end.
-        // This is the last run of the loop.
-        fileAtEnd = true;
-      // a corrupted file may contain an arbitrary amount of non-\n symbols
-      // prevent lineBuffer overflow by dumping it for such cases
-      if (unsigned(lineBuffer.size()) > STAT_MAX_STRING_SIZE)
-        lineBuffer.clear(); // prevent an overflow here
-      for (size_t i = 0; i < size_t(bufferSize); i++)
-      {
-        // Search for '\n' newline characters
-        if (inputBuffer.at(int(i)) == 10)
+    const auto fileAtEnd = forEachLineInFile(
+        inputFile,
+        0,
+        STAT_PARSING_BUFFER_SIZE,
+        [&](std::string_view line, uint64_t lineStartPos)
         {
-          // We found a newline character
-          if (lineBuffer.size() > 0)
+          if (breakFunction.load() || this->abortParsingDestroy)
+            return false;
+
+          // need to match this:
+          // BlockStat: POC 1 @( 120,  80) [ 8x 8] MVL0={ -24,  -2}
+          // BlockStat: POC 1 @( 112,  88) [ 8x 8] PredMode=0
+          // ignore not matching lines
+          const auto poc = parsePOC(line);
+          if (!poc)
+            return true;
+
+          if (lastPOC == -1)
           {
-            // Parse the previous line
-            // get components of this line
-            // get poc using regular expression
-            // need to match this:
-            // BlockStat: POC 1 @( 120,  80) [ 8x 8] MVL0={ -24,  -2}
-            // BlockStat: POC 1 @( 112,  88) [ 8x 8] PredMode=0
-            QRegularExpression pocRegex("BlockStat: POC ([0-9]+)");
-            auto               match = pocRegex.match(lineBuffer);
-            // ignore not matching lines
-            if (match.hasMatch())
-            {
-              auto poc = match.captured(1).toInt();
-
-              if (lastPOC == -1)
-              {
-                // First POC
-                this->pocStartList[poc] = lineBufferStartPos;
-                emit readPOC(poc);
-
-                lastPOC = poc;
-
-                // update number of frames
-                if (poc > this->maxPOC)
-                  this->maxPOC = poc;
-              }
-              else if (poc != lastPOC)
-              {
-                // this is apparently not sorted by POCs and we will not check it further
-                if (!sortingFixed)
-                  sortingFixed = true;
-
-                lastPOC                 = poc;
-                this->pocStartList[poc] = lineBufferStartPos;
-                emit readPOC(poc);
-
-                // update number of frames
-                if (poc > this->maxPOC)
-                  this->maxPOC = poc;
-
-                // Update percent of file parsed
-                if (const auto fileSize = inputFile.getFileSize())
-                  this->parsingProgress = (static_cast<double>(lineBufferStartPos) * 100 /
-                                           static_cast<double>(*fileSize));
-              }
-            }
-          }
+            // First POC
+            this->pocStartList[*poc] = lineStartPos;
+            emit readPOC(*poc);
 
-          lineBuffer.clear();
-          lineBufferStartPos = bufferStartPos + i + 1;
-        }
-        else
-        {
-          // No newline character found
-          lineBuffer.append(inputBuffer.at(int(i)));
-        }
-      }
+            lastPOC = *poc;
 
-      bufferStartPos += bufferSize;
-    }
+            // update number of frames
+            if (*poc > this->maxPOC)
+              this->maxPOC = *poc;
+          }
+          else if (*poc != lastPOC)
+          {
+            // this is apparently not sorted by POCs and we will not check it further
+            if (!sortingFixed)
+              sortingFixed = true;
+
+            lastPOC                  = *poc;
+            this->pocStartList[*poc] = lineStartPos;
+            emit readPOC(*poc);
+
+            // update number of frames
+            if (*poc > this->maxPOC)
+              this->maxPOC = *poc;
+
+            // Update percent of file parsed
+            if (const auto fileSize = inputFile.getFileSize())
+              this->parsingProgress =
+                  (static_cast<double>(lineStartPos) * 100 / static_cast<double>(*fileSize));
+          }
+          return true;
+        });
 
     // Parsing complete
     this->parsingProgress = 100.0;
+    if (fileAtEnd)
+      this->writeIndexToCache();
   }
   catch (const char *str)
   {
@@ -183,6 +335,47 @@ void StatisticsFileVTMBMS::readFrameAndTypePositionsFromFile(std::atomic_bool &b
   return;
 }
 
+bool StatisticsFileVTMBMS::readIndexFromCache()
+{
+  filesource::FileIndexCache cache(this->file.getAbsoluteFilePath(), VTMBMS_INDEX_TYPE);
+  return cache.read(
+      [this](QDataStream &stream)
+      {
+        qint32  maxPOC{};
+        quint32 nrPOCs{};
+        stream >> maxPOC >> nrPOCs;
+
+        std::map<int, uint64_t> startList;
+        for (quint32 i = 0; i < nrPOCs && stream.status() == QDataStream::Ok; i++)
+        {
+          qint32  poc{};
+          quint64 filePos{};
+          stream >> poc >> filePos;
+          startList[poc] = filePos;
+        }
+        if (stream.status() != QDataStream::Ok)
+          return false;
+
+        this->maxPOC       = maxPOC;
+        this->pocStartList = std::move(startList);
+        for (const auto &pocEntry : this->pocStartList)
+          emit readPOC(pocEntry.first);
+        return true;
+      });
+}
+
+void StatisticsFileVTMBMS::writeIndexToCache() const
+{
+  filesource::FileIndexCache cache(this->file.getAbsoluteFilePath(), VTMBMS_INDEX_TYPE);
+  cache.write(
+      [this](QDataStream &stream)
+      {
+        stream << qint32(this->maxPOC) << quint32(this->pocStartList.size());
+        for (const auto &pocEntry : this->pocStartList)
+          stream << qint32(pocEntry.first) << quint64(pocEntry.second);
+      });
+}
+
 void StatisticsFileVTMBMS::loadStatisticData(StatisticsData &statisticsData, int poc, int typeID)
 {
   if (!this->file.isOk())
@@ -203,200 +396,134 @@ void StatisticsFileVTMBMS::loadStatisticData(StatisticsData &statisticsData, int
 
     auto startPos = this->pocStartList[poc];
 
-    QTextStream in(this->file.getQFile());
-    in.seek(startPos);
-
-    QRegularExpression pocRegex("BlockStat: POC ([0-9]+)");
-
-    // prepare regex for selected type
     auto &statTypes = statisticsData.getStatisticsTypes();
     auto  statIt    = std::find_if(statTypes.begin(),
                                statTypes.end(),
                                [typeID](StatisticsType &t) { return t.typeID == typeID; });
     Q_ASSERT_X(statIt != statTypes.end(), Q_FUNC_INFO, "Stat type not found.");
-    QRegularExpression typeRegex(" " + statIt->typeName + "="); // for catching lines of the type
-
-    // for extracting scalar value statistics, need to match:
-    // BlockStat: POC 1 @( 112,  88) [ 8x 8] PredMode=0
-    QRegularExpression scalarRegex(
-        "POC ([0-9]+) @\\( *([0-9]+), *([0-9]+)\\) *\\[ *([0-9]+)x *([0-9]+)\\] *\\w+=([0-9\\-]+)");
-    // for extracting vector value statistics, need to match:
-    // BlockStat: POC 1 @( 120,  80) [ 8x 8] MVL0={ -24,  -2}
-    QRegularExpression vectorRegex("POC ([0-9]+) @\\( *([0-9]+), *([0-9]+)\\) *\\[ *([0-9]+)x "
-                                   "*([0-9]+)\\] *\\w+={ *([0-9\\-]+), *([0-9\\-]+)}");
-    // for extracting affine transform value statistics, need to match:
-    // BlockStat: POC 2 @( 192,  96) [64x32] AffineMVL0={-324,-116,-276,-116,-324, -92}
-    QRegularExpression affineTFRegex(
-        "POC ([0-9]+) @\\( *([0-9]+), *([0-9]+)\\) *\\[ *([0-9]+)x *([0-9]+)\\] *\\w+={ "
-        "*([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+)}");
-    // for extracting scalar polygon  statistics, need to match:
-    // BlockStat: POC 2 @[(505, 384)--(511, 384)--(511, 415)--] GeoPUInterIntraFlag=0
-    // BlockStat: POC 2 @[(416, 448)--(447, 448)--(447, 478)--(416, 463)--] GeoPUInterIntraFlag=0
-    // will capture 3-5 points. other polygons are not supported
-    QRegularExpression scalarPolygonRegex(
-        "POC ([0-9]+) @\\[((?:\\( *[0-9]+, *[0-9]+\\)--){3,5})\\] *\\w+=([0-9\\-]+)");
-    // for extracting vector polygon statistics:
-    QRegularExpression vectorPolygonRegex(
-        "POC ([0-9]+) @\\[((?:\\( *[0-9]+, *[0-9]+\\)--){3,5})\\] *\\w+={ *([0-9\\-]+), "
-        "*([0-9\\-]+)}");
-    // for extracting the partitioning line, we extract
-    // BlockStat: POC 2 @( 192,  96) [64x32] Line={0,0,31,31}
-    QRegularExpression lineRegex(
-        "POC ([0-9]+) @\\( *([0-9]+), *([0-9]+)\\) *\\[ *([0-9]+)x *([0-9]+)\\] *\\w+={ "
-        "*([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+)}");
-
-    while (!in.atEnd())
-    {
-      // read one line
-      auto aLine    = in.readLine();
-      auto pocMatch = pocRegex.match(aLine);
-      // ignore not matching lines
-      if (pocMatch.hasMatch())
-      {
-        auto pocRow = pocMatch.captured(1).toInt();
-        if (poc != pocRow)
-          break;
+    if (statIt == statTypes.end())
+      return;
 
-        // filter lines of different types
-        auto typeMatch = typeRegex.match(aLine);
-        if (typeMatch.hasMatch())
+    // for catching lines of the type
+    const auto typeTag   = " " + statIt->typeName.toStdString() + "=";
+    const auto frameSize = statisticsData.getFrameSize();
+    auto      &typeData  = statisticsData[typeID];
+    Polygon    points;
+
+    forEachLineInFile(
+        this->file,
+        startPos,
+        STAT_LOADING_BUFFER_SIZE,
+        [&](std::string_view line, uint64_t)
         {
-          int      posX, posY, scalar, vecX, vecY;
-          unsigned width, height;
-
-          QRegularExpressionMatch statisitcMatch;
-          // extract statistics info
-          // try block types
-          if (statIt->isPolygon == false)
+          // ignore not matching lines
+          LineParser parser(line);
+          const auto pocRow = parsePOC(line, &parser);
+          if (!pocRow)
+            return true;
+          // if there is a new POC, we are done here!
+          if (*pocRow != poc)
+            return false;
+
+          // filter lines of different types
+          if (line.find(typeTag) == std::string_view::npos)
+            return true;
+
+          // extract statistics info. Need to match one of:
+          // BlockStat: POC 1 @( 112,  88) [ 8x 8] PredMode=0
+          // BlockStat: POC 1 @( 120,  80) [ 8x 8] MVL0={ -24,  -2}
+          // BlockStat: POC 2 @( 192,  96) [64x32] AffineMVL0={-324,-116,-276,-116,-324, -92}
+          // BlockStat: POC 2 @( 192,  96) [64x32] Line={0,0,31,31}
+          // BlockStat: POC 2 @[(505, 384)--(511, 384)--(511, 415)--] GeoPUInterIntraFlag=0
+          // BlockStat: POC 2 @[(416, 448)--(447, 448)--(447, 478)--] GeoMVL0={ 291, 233}
+          // Polygons with 3-5 points are supported.
+          const auto statistic = parseBlockStatistic(parser);
+
+          const auto nrValues = statistic ? statistic->nrValues : 0;
+          const auto isScalar = statistic && !statistic->valuesInBraces;
+          bool       matches  = false;
+          if (statistic && !statistic->isPolygon)
           {
             if (statIt->hasValueData)
-              statisitcMatch = scalarRegex.match(aLine);
+              matches = isScalar;
             else if (statIt->hasVectorData)
-            {
-              statisitcMatch = vectorRegex.match(aLine);
-              if (!statisitcMatch.hasMatch())
-                statisitcMatch = lineRegex.match(aLine);
-            }
+              matches = !isScalar && (nrValues == 2 || nrValues == 4);
             else if (statIt->hasAffineTFData)
-              statisitcMatch = affineTFRegex.match(aLine);
+              matches = !isScalar && nrValues == 6;
           }
-          else
-          // try polygons
+          else if (statistic)
           {
             if (statIt->hasValueData)
-              statisitcMatch = scalarPolygonRegex.match(aLine);
+              matches = isScalar;
             else if (statIt->hasVectorData)
-              statisitcMatch = vectorPolygonRegex.match(aLine);
+              matches = !isScalar && nrValues == 2;
           }
-          if (!statisitcMatch.hasMatch())
+          if (!matches)
           {
-            this->errorMessage = QString("Error while parsing statistic: ") + QString(aLine);
-            continue;
+            this->errorMessage = QString("Error while parsing statistic: ") +
+                                 QString::fromUtf8(line.data(), int(line.size()));
+            return true;
           }
 
-          // useful for debugging:
-          //        QStringList all_captured = statisitcMatch.capturedTexts();
-
-          pocRow = statisitcMatch.captured(1).toInt();
-          width  = statisitcMatch.captured(4).toUInt();
-          height = statisitcMatch.captured(5).toUInt();
-          // if there is a new POC, we are done here!
-          if (poc != pocRow)
-            break;
+          const auto &values = statistic->values;
 
           // process block statistics
-          if (statIt->isPolygon == false)
+          if (!statistic->isPolygon)
           {
-            posX = statisitcMatch.captured(2).toInt();
-            posY = statisitcMatch.captured(3).toInt();
+            const auto posX   = statistic->posX;
+            const auto posY   = statistic->posY;
+            const auto width  = statistic->width;
+            const auto height = statistic->height;
 
             // Check if block is within the image range
-            if (blockOutsideOfFramePOC == -1 &&
-                (posX + int(width) > int(statisticsData.getFrameSize().width) ||
-                 posY + int(height) > int(statisticsData.getFrameSize().height)))
+            if (this->blockOutsideOfFramePOC == -1 &&
+                (posX + int(width) > int(frameSize.width) ||
+                 posY + int(height) > int(frameSize.height)))
               // Block not in image. Warn about this.
-              blockOutsideOfFramePOC = poc;
+              this->blockOutsideOfFramePOC = poc;
 
-            if (statIt->hasVectorData)
-            {
-              vecX = statisitcMatch.captured(6).toInt();
-              vecY = statisitcMatch.captured(7).toInt();
-              if (statisitcMatch.lastCapturedIndex() > 7)
-              {
-                auto vecX1 = statisitcMatch.captured(8).toInt();
-                auto vecY1 = statisitcMatch.captured(9).toInt();
-                statisticsData[typeID].addLine(posX, posY, width, height, vecX, vecY, vecX1, vecY1);
-              }
-              else
-              {
-                statisticsData[typeID].addBlockVector(posX, posY, width, height, vecX, vecY);
-              }
-            }
+            if (statIt->hasVectorData && nrValues == 4)
+              typeData.addLine(
+                  posX, posY, width, height, values[0], values[1], values[2], values[3]);
+            else if (statIt->hasVectorData)
+              typeData.addBlockVector(posX, posY, width, height, values[0], values[1]);
             else if (statIt->hasAffineTFData)
-            {
-              auto vecX0 = statisitcMatch.captured(6).toInt();
-              auto vecY0 = statisitcMatch.captured(7).toInt();
-              auto vecX1 = statisitcMatch.captured(8).toInt();
-              auto vecY1 = statisitcMatch.captured(9).toInt();
-              auto vecX2 = statisitcMatch.captured(10).toInt();
-              auto vecY2 = statisitcMatch.captured(11).toInt();
-              statisticsData[typeID].addBlockAffineTF(
-                  posX, posY, width, height, vecX0, vecY0, vecX1, vecY1, vecX2, vecY2);
-            }
+              typeData.addBlockAffineTF(posX,
+                                        posY,
+                                        width,
+                                        height,
+                                        values[0],
+                                        values[1],
+                                        values[2],
+                                        values[3],
+                                        values[4],
+                                        values[5]);
             else
-            {
-              scalar = statisitcMatch.captured(6).toInt();
-              statisticsData[typeID].addBlockValue(posX, posY, width, height, scalar);
-            }
+              typeData.addBlockValue(posX, posY, width, height, values[0]);
           }
           else
           // process polygon statistics
           {
-            auto               corners    = statisitcMatch.captured(2);
-            auto               cornerList = corners.split("--");
-            QRegularExpression cornerRegex("\\( *([0-9]+), *([0-9]+)\\)");
-            stats::Polygon     points;
-            for (const auto &corner : cornerList)
+            points.clear();
+            for (unsigned i = 0; i < statistic->nrCorners; i++)
             {
-              auto cornerMatch = cornerRegex.match(corner);
-              if (cornerMatch.hasMatch())
-              {
-                auto x = cornerMatch.captured(1).toInt();
-                auto y = cornerMatch.captured(2).toInt();
-                points.push_back({x, y});
-
-                // Check if polygon is within the image range
-                if (this->blockOutsideOfFramePOC == -1 &&
-                    (x + width > statisticsData.getFrameSize().width ||
-                     y + height > statisticsData.getFrameSize().height))
-                  // Block not in image. Warn about this.
-                  this->blockOutsideOfFramePOC = poc;
-              }
+              const auto &corner = statistic->corners[i];
+              points.push_back(corner);
+
+              // Check if polygon is within the image range
+              if (this->blockOutsideOfFramePOC == -1 &&
+                  (corner.x > int(frameSize.width) || corner.y > int(frameSize.height)))
+                // Block not in image. Warn about this.
+                this->blockOutsideOfFramePOC = poc;
             }
 
             if (statIt->hasVectorData)
-            {
-              vecX = statisitcMatch.captured(3).toInt();
-              vecY = statisitcMatch.captured(4).toInt();
-              statisticsData[typeID].addPolygonVector(points, vecX, vecY);
-            }
+              typeData.addPolygonVector(points, values[0], values[1]);
             else if (statIt->hasValueData)
-            {
-              scalar = statisitcMatch.captured(3).toInt();
-              statisticsData[typeID].addPolygonValue(points, scalar);
-            }
+              typeData.addPolygonValue(points, values[0]);
           }
-        }
-      }
-    }
-
-    if (!statisticsData.hasDataForTypeID(typeID))
-    {
-      // There are no statistics in the file for the given frame and index.
-      statisticsData[typeID] = {};
-      return;
-    }
-
+          return true;
+        });
   } // try
   catch (const char *str)
   {
@@ -55,7 +55,12 @@ public:
 private:
   //! Scan the header: What types are saved in this file?
   void readHeaderFromFile(StatisticsData &statisticsData);
-  
+
+  // The file positions are saved in the FileIndexCache so that we don't have to parse the file
+  // again when it is opened the next time.
+  bool readIndexFromCache();
+  void writeIndexToCache() const;
+
   std::map<int, uint64_t> pocStartList;
 };
 
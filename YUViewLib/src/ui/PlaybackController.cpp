@@ -34,6 +34,8 @@
 
 #include <QSettings>
 
+#include <algorithm>
+
 #include <common/FunctionsGui.h>
 #include <common/EnumMapper.h>
 #include <common/Typedef.h>
@@ -104,6 +106,7 @@ PlaybackController::PlaybackController()
 
   this->ui.fpsLabel->setText("0");
   this->ui.fpsLabel->setStyleSheet("");
+  this->ui.droppedFramesLabel->setText("");
 
   QSettings  settings;
   const auto repeatModeOffIndex = static_cast<int>(RepeatModeMapper.indexOf(RepeatMode::Off));
@@ -185,6 +188,7 @@ void PlaybackController::on_playPauseButton_clicked()
     emit(waitForItemCaching(nullptr));
     this->ui.fpsLabel->setText("0");
     this->ui.fpsLabel->setStyleSheet("");
+    this->ui.droppedFramesLabel->setText("");
     this->splitViewPrimary->freezeView(false);
 
     this->splitViewPrimary->update(false, true);
@@ -201,6 +205,7 @@ void PlaybackController::on_playPauseButton_clicked()
     }
 
     emit(signalPlaybackStarting());
+    this->framePacer.resetStatistics();
 
     if (this->waitForCachingOfItem)
     {
@@ -251,9 +256,8 @@ void PlaybackController::startOrUpdateTimer()
   if (this->anyItemIndexedByFrame())
   {
     const auto frameRate = this->getCurrentItemsFrameRate();
-    this->timerInterval = std::chrono::duration_cast<std::chrono::milliseconds>(1000ms / frameRate);
-    const auto ticksToUpdateEachSecond = static_cast<int>(frameRate);
-    this->countdownForFPSUpdate        = CountDown(ticksToUpdateEachSecond);
+    this->framePacer.start(video::FramePacer::Clock::now(), frameRate);
+    this->startTimerForNextFrame();
     DEBUG_PLAYBACK("PlaybackController::startOrUpdateTimer framerate %f", frameRate);
   }
   else
@@ -262,14 +266,44 @@ void PlaybackController::startOrUpdateTimer()
     const auto ticksForStaticItem =
         static_cast<int>(this->currentItem[0]->properties().duration * 10);
     this->countDownForStaticItem = CountDown(ticksForStaticItem);
+    this->timer.start(this->timerInterval.count(), Qt::PreciseTimer, this);
     DEBUG_PLAYBACK("PlaybackController::startOrUpdateTimer duration %d", this->timerInterval);
   }
 
-  this->timer.start(this->timerInterval.count(), Qt::PreciseTimer, this);
   this->playbackMode       = PlaybackMode::Running;
   this->fpsUpdateStopWatch = StopWatch();
 }
 
+void PlaybackController::startTimerForNextFrame()
+{
+  // The timer only has a resolution of milliseconds. Round up so that the frame is due when the
+  // timer fires. The pacer calculates the time of each frame from the start so this does not add
+  // up.
+  const auto now                = video::FramePacer::Clock::now();
+  const auto timeUntilNextFrame = this->framePacer.getTimeUntilNextFrame(now);
+  this->timerInterval = std::chrono::ceil<std::chrono::milliseconds>(timeUntilNextFrame);
+  this->timer.start(int(this->timerInterval.count()), Qt::PreciseTimer, this);
+}
+
+void PlaybackController::updatePlaybackStatisticsLabels()
+{
+  // Print the frames per second as float with one digit after the decimal dot.
+  const auto actualFramesPerSec = this->framePacer.getAchievedFramesPerSecond();
+  if (actualFramesPerSec > 0)
+    this->ui.fpsLabel->setText(QString::number(actualFramesPerSec, 'f', 1));
+  if (this->playbackWasStalled)
+    this->ui.fpsLabel->setStyleSheet("QLabel { background-color: yellow }");
+  else
+    this->ui.fpsLabel->setStyleSheet("");
+  this->playbackWasStalled = false;
+
+  const auto nrDroppedFrames = this->framePacer.getNrDroppedFrames();
+  if (nrDroppedFrames > 0)
+    this->ui.droppedFramesLabel->setText(QString("%1 dropped").arg(nrDroppedFrames));
+  else
+    this->ui.droppedFramesLabel->setText("");
+}
+
 void PlaybackController::nextFrame()
 {
   this->pausePlayback();
@@ -310,6 +344,10 @@ void PlaybackController::currentSelectedItemsChanged(playlistItem *item1,
   if (this->playing() && !chageByPlayback && !continuePlayback)
     this->pausePlayback();
 
+  if (!chageByPlayback)
+    // The motion in the previous item does not tell us anything about the new one
+    this->frameMotionTracker.clear();
+
   this->currentItem[0] = item1;
   this->currentItem[1] = item2;
 
@@ -438,6 +476,10 @@ void PlaybackController::selectionPropertiesChanged(bool redraw)
 void PlaybackController::updateSettings()
 {
   QSettings settings;
+  this->lateFramePolicy = settings.value("PlaybackDropLateFrames", false).toBool()
+                              ? video::LateFramePolicy::DropFrames
+                              : video::LateFramePolicy::SlowDown;
+
   settings.beginGroup("VideoCache");
   auto caching               = settings.value("Enabled", true).toBool();
   auto wait                  = settings.value("PlaybackPauseCaching", false).toBool();
@@ -527,7 +569,7 @@ void PlaybackController::goToNextItem()
   }
 }
 
-void PlaybackController::goToNextFrame(const int nextFrameIndex)
+void PlaybackController::goToNextFrame(const int nextFrameIndex, const int64_t nrFramesDue)
 {
   this->waitingForItem[0] =
       this->currentItem[0]->isLoading() || this->currentItem[0]->isLoadingDoubleBuffer();
@@ -546,37 +588,67 @@ void PlaybackController::goToNextFrame(const int nextFrameIndex)
     return;
   }
 
-  DEBUG_PLAYBACK("PlaybackController::goToNextFrame next frame %d", nextFrameIndex);
-  this->setCurrentFrameAndUpdate(nextFrameIndex);
-
-  if (this->countdownForFPSUpdate.tickAndGetIsExpired())
+  // If we are late, skip to the last due frame that can be shown right away. The frames that are
+  // not cached are not loaded just to be skipped. If no later frame is ready, the next frame is
+  // shown late and playback slows down.
+  auto frameIndex       = nextFrameIndex;
+  auto nrFramesAdvanced = int64_t(1);
+  if (nrFramesDue > 1 && this->lateFramePolicy == video::LateFramePolicy::DropFrames)
   {
-    const auto msecsSinceLastUpdate = this->fpsUpdateStopWatch.getMsSinceCreation();
-
-    // Print the frames per second as float with one digit after the decimal dot.
-    const auto actualFramesPerSec = (static_cast<double>(this->countdownForFPSUpdate.getTicks()) /
-                                     (msecsSinceLastUpdate / 1000.0));
-    if (actualFramesPerSec > 0)
-      this->ui.fpsLabel->setText(QString::number(actualFramesPerSec, 'f', 1));
-    if (this->playbackWasStalled)
-      this->ui.fpsLabel->setStyleSheet("QLabel { background-color: yellow }");
-    else
-      this->ui.fpsLabel->setStyleSheet("");
-    this->playbackWasStalled = false;
+    const auto lastDueFrame = int(std::min(int64_t(this->ui.frameSlider->maximum()),
+                                           int64_t(nextFrameIndex) + nrFramesDue - 1));
+    if (auto readyFrame = this->getLastReadyFrame(nextFrameIndex + 1, lastDueFrame))
+    {
+      frameIndex       = *readyFrame;
+      nrFramesAdvanced = *readyFrame - nextFrameIndex + 1;
+    }
+  }
 
+  DEBUG_PLAYBACK("PlaybackController::goToNextFrame next frame %d (%d dropped)",
+                 frameIndex,
+                 int(nrFramesAdvanced - 1));
+  this->setCurrentFrameAndUpdate(frameIndex);
+  this->framePacer.framesPresented(video::FramePacer::Clock::now(), nrFramesAdvanced);
+
+  if (this->fpsUpdateStopWatch.getMsSinceCreation() >= 1000)
+  {
+    this->updatePlaybackStatisticsLabels();
     this->fpsUpdateStopWatch = StopWatch();
   }
 
-  // Check if the time interval changed (the user changed the rate of the item)
-  if (this->anyItemIndexedByFrame())
+  if (this->playbackMode != PlaybackMode::Running || !this->anyItemIndexedByFrame())
+    return;
+
+  // Check if the frame rate changed (the user changed the rate of the item)
+  const auto frameRate = this->getCurrentItemsFrameRate();
+  if (this->framePacer.getFramesPerSecond() != frameRate)
+    this->framePacer.setFramesPerSecond(video::FramePacer::Clock::now(), frameRate);
+  this->startTimerForNextFrame();
+}
+
+std::optional<int> PlaybackController::getLastReadyFrame(const int firstFrameIndex,
+                                                         const int lastFrameIndex) const
+{
+  const auto isSplitting = this->splitViewPrimary->isSplitting();
+
+  std::vector<QList<int>> cachedFramesPerItem;
+  for (int i = 0; i < 2; i++)
   {
-    const auto frameRate = this->getCurrentItemsFrameRate();
+    const auto item = this->currentItem[i];
+    if (item && (i == 0 || isSplitting) && item->properties().isIndexedByFrame())
+      cachedFramesPerItem.push_back(item->getCachedFrames());
+  }
+  if (cachedFramesPerItem.empty())
+    return {};
 
-    const auto newtimerInterval =
-        std::chrono::duration_cast<std::chrono::milliseconds>(1000ms / frameRate);
-    if (this->timerInterval != newtimerInterval)
-      this->startOrUpdateTimer();
+  for (int frame = lastFrameIndex; frame >= firstFrameIndex; frame--)
+  {
+    const auto isCached = [frame](const QList<int> &cachedFrames)
+    { return cachedFrames.contains(frame); };
+    if (std::all_of(cachedFramesPerItem.begin(), cachedFramesPerItem.end(), isCached))
+      return frame;
   }
+  return {};
 }
 
 void PlaybackController::enableControls(bool enable)
@@ -591,6 +663,7 @@ void PlaybackController::enableControls(bool enable)
     const QSignalBlocker blocker(this->ui.frameSlider);
     this->ui.fpsLabel->setText("0");
     this->ui.fpsLabel->setStyleSheet("");
+    this->ui.droppedFramesLabel->setText("");
     this->playbackWasStalled = false;
   }
 
@@ -635,8 +708,16 @@ void PlaybackController::timerEvent(QTimerEvent *event)
     return;
   }
 
+  const auto nrFramesDue = this->framePacer.getNrFramesDue(video::FramePacer::Clock::now());
+  if (nrFramesDue == 0)
+  {
+    // The timer fired before the next frame is due
+    this->startTimerForNextFrame();
+    return;
+  }
+
   if (auto nextFrameIdx = this->getNextFrameIndexInCurrentItem())
-    this->goToNextFrame(*nextFrameIdx);
+    this->goToNextFrame(*nextFrameIdx, nrFramesDue);
   else
     this->goToNextItem();
 }
@@ -649,12 +730,10 @@ void PlaybackController::currentSelectedItemsDoubleBufferLoad(int itemID)
     this->waitingForItem[itemID] = false;
     if (!this->waitingForItem[0] && !this->waitingForItem[1])
     {
-      DEBUG_PLAYBACK(
-          "PlaybackController::currentSelectedItemsDoubleBufferLoad - timer interval %dms",
-          this->timerInterval.count());
-      this->timer.start(this->timerInterval.count(), Qt::PreciseTimer, this);
-      this->timerEvent(nullptr);
+      DEBUG_PLAYBACK("PlaybackController::currentSelectedItemsDoubleBufferLoad - continue");
+      // The frames that became due while waiting are dropped or shown late (see goToNextFrame)
       this->playbackMode = PlaybackMode::Running;
+      this->timerEvent(nullptr);
     }
   }
 }
@@ -671,6 +750,13 @@ bool PlaybackController::setCurrentFrameAndUpdate(int frame, bool updateView)
   this->updateFrameSliderAndSpinBoxWithoutSignals(frame);
   this->currentFrameIdx = frame;
 
+  if (frame >= 0)
+  {
+    this->frameMotionTracker.addFrameChange(frame,
+                                            this->frameMotionStopWatch.getMsSinceCreation());
+    emit signalCurrentFrameChanged(frame);
+  }
+
   if (updateView)
   {
     // Also update the view to display the new frame
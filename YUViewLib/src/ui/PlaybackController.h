@@ -37,6 +37,8 @@
 #include <common/Typedef.h>
 #include <ui/views/SplitViewWidget.h>
 #include <ui/widgets/PlaylistTreeWidget.h>
+#include <video/FramePacer.h>
+#include <video/FramePrefetch.h>
 
 #include <QBasicTimer>
 #include <QPointer>
@@ -90,6 +92,13 @@ public:
 
   bool setCurrentFrameAndUpdate(int frame, bool updateView = true);
 
+  // How the user moved through the frames of the current item recently (stepping, scrubbing,
+  // playback). The video cache uses this to cache the frames that are shown next first.
+  video::prefetch::FrameMotion getFrameMotion() const
+  {
+    return this->frameMotionTracker.getMotion();
+  }
+
   enum class RepeatMode
   {
     Off,
@@ -131,6 +140,7 @@ signals:
   void waitForItemCaching(playlistItem *item);
 
   void signalPlaybackStarting();
+  void signalCurrentFrameChanged(int frameIndex);
 
 public slots:
   void itemCachingFinished(playlistItem *item);
@@ -147,13 +157,19 @@ private:
 
   void updateFrameRange();
   void goToNextItem();
-  void goToNextFrame(const int nextFrameIndex);
+  void goToNextFrame(const int nextFrameIndex, const int64_t nrFramesDue);
+  // Get the last frame in the given range that can be shown without loading it first (it is
+  // cached in all visible items)
+  std::optional<int> getLastReadyFrame(const int firstFrameIndex, const int lastFrameIndex) const;
 
   // The current frame index. -1 means the frame index is invalid. In this case, lastValidFrameIdx
   // contains the last valid frame index which will be restored if a valid indexed item is selected.
   int currentFrameIdx{-1};
   int lastValidFrameIdx{-1};
 
+  video::prefetch::FrameMotionTracker frameMotionTracker;
+  StopWatch                           frameMotionStopWatch;
+
   void startOrUpdateTimer();
   void startPlayback();
 
@@ -186,9 +202,16 @@ private:
 
   QBasicTimer               timer;
   std::chrono::milliseconds timerInterval{};
-  CountDown                 countdownForFPSUpdate;
   StopWatch                 fpsUpdateStopWatch;
   CountDown                 countDownForStaticItem;
+
+  // For indexed items, the timer is started for every frame at the time that the pacer calculates
+  // from the frame rate
+  video::FramePacer      framePacer;
+  video::LateFramePolicy lateFramePolicy{video::LateFramePolicy::SlowDown};
+  void                   startTimerForNextFrame();
+  void                   updatePlaybackStatisticsLabels();
+
   virtual void
   timerEvent(QTimerEvent *event) override; // Overloaded from QObject. Called when the timer fires.
 
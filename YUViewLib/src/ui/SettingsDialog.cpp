@@ -65,6 +65,7 @@ SettingsDialog::SettingsDialog(QWidget *parent) : QDialog(parent)
   ui.checkBoxAskToSave->setChecked(settings.value("AskToSaveOnExit", true).toBool());
   ui.checkBoxContinuePlaybackNewSelection->setChecked(
       settings.value("ContinuePlaybackOnSequenceSelection", false).toBool());
+  ui.checkBoxDropLateFrames->setChecked(settings.value("PlaybackDropLateFrames", false).toBool());
   ui.checkBoxSavePositionPerItem->setChecked(
       settings.value("SavePositionAndZoomPerItem", false).toBool());
   ui.checkBoxAutodetectFileType->setChecked(settings.value("AutodetectFileType", true).toBool());
@@ -431,6 +432,7 @@ void SettingsDialog::on_pushButtonSave_clicked()
   settings.setValue("AskToSaveOnExit", ui.checkBoxAskToSave->isChecked());
   settings.setValue("ContinuePlaybackOnSequenceSelection",
                     ui.checkBoxContinuePlaybackNewSelection->isChecked());
+  settings.setValue("PlaybackDropLateFrames", ui.checkBoxDropLateFrames->isChecked());
   settings.setValue("SavePositionAndZoomPerItem", ui.checkBoxSavePositionPerItem->isChecked());
   settings.setValue("AutodetectFileType", ui.checkBoxAutodetectFileType->isChecked());
 
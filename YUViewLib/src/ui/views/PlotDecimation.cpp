@@ -0,0 +1,160 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut f�r Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "PlotDecimation.h"
+
+#include <algorithm>
+
+namespace
+{
+
+void addToBucket(PlotModel::DecimatedPoint &bucket, const PlotModel::DecimatedPoint &other)
+{
+  if (bucket.nrPoints == 0)
+  {
+    bucket = other;
+    return;
+  }
+
+  const auto nrPoints = bucket.nrPoints + other.nrPoints;
+  bucket.yAverage =
+      (bucket.yAverage * bucket.nrPoints + other.yAverage * other.nrPoints) / nrPoints;
+  bucket.nrPoints = nrPoints;
+
+  bucket.xMin = std::min(bucket.xMin, other.xMin);
+  bucket.xMax = std::max(bucket.xMax, other.xMax);
+  bucket.yMin = std::min(bucket.yMin, other.yMin);
+  bucket.yMax = std::max(bucket.yMax, other.yMax);
+  if (other.intra)
+  {
+    bucket.yMaxIntra = bucket.intra ? std::max(bucket.yMaxIntra, other.yMaxIntra) : other.yMaxIntra;
+    bucket.intra     = true;
+  }
+}
+
+PlotModel::DecimatedPoint toDecimatedPoint(const PlotModel::Point &point)
+{
+  PlotModel::DecimatedPoint decimatedPoint;
+  decimatedPoint.xMin      = point.x - point.width / 2;
+  decimatedPoint.xMax      = point.x + point.width / 2;
+  decimatedPoint.yMin      = point.y;
+  decimatedPoint.yMax      = point.y;
+  decimatedPoint.yAverage  = point.y;
+  decimatedPoint.yMaxIntra = point.y;
+  decimatedPoint.intra     = point.intra;
+  decimatedPoint.nrPoints  = 1;
+  return decimatedPoint;
+}
+
+} // namespace
+
+void PlotDecimation::update(unsigned                nrPoints,
+                            unsigned                firstChangedPoint,
+                            const GetPointFunction &getPoint)
+{
+  auto     nrElementsBelow   = nrPoints;
+  auto     firstChangedBelow = firstChangedPoint;
+  unsigned level             = 0;
+  while (nrElementsBelow > DECIMATION_FACTOR)
+  {
+    if (level == this->levels.size())
+      this->levels.emplace_back();
+
+    // Buckets that did not exist before (e.g. on a new level) must be calculated as well
+    auto      &buckets      = this->levels[level];
+    const auto nrBuckets    = (nrElementsBelow + DECIMATION_FACTOR - 1) / DECIMATION_FACTOR;
+    const auto nrOldBuckets = unsigned(buckets.size());
+    const auto firstBucket  = std::min(firstChangedBelow / DECIMATION_FACTOR, nrOldBuckets);
+    buckets.resize(nrBuckets);
+
+    for (auto bucketIndex = firstBucket; bucketIndex < nrBuckets; bucketIndex++)
+    {
+      PlotModel::DecimatedPoint bucket;
+      const auto                start = bucketIndex * DECIMATION_FACTOR;
+      const auto                end   = std::min(start + DECIMATION_FACTOR, nrElementsBelow);
+      for (auto i = start; i < end; i++)
+      {
+        if (level == 0)
+          addToBucket(bucket, toDecimatedPoint(getPoint(i)));
+        else
+          addToBucket(bucket, this->levels[level - 1][i]);
+      }
+      buckets[bucketIndex] = bucket;
+    }
+
+    nrElementsBelow   = nrBuckets;
+    firstChangedBelow = firstBucket;
+    level++;
+  }
+  this->levels.resize(level);
+}
+
+void PlotDecimation::clear()
+{
+  this->levels.clear();
+}
+
+std::optional<std::vector<PlotModel::DecimatedPoint>>
+PlotDecimation::getDecimatedPoints(Range<double> xRange, unsigned maxNrPoints) const
+{
+  for (unsigned level = 0; level < this->levels.size(); level++)
+  {
+    const auto &buckets = this->levels[level];
+
+    auto begin = std::partition_point(buckets.begin(),
+                                      buckets.end(),
+                                      [&xRange](const PlotModel::DecimatedPoint &bucket)
+                                      { return bucket.xMax < xRange.min; });
+    auto end   = std::partition_point(begin,
+                                    buckets.end(),
+                                    [&xRange](const PlotModel::DecimatedPoint &bucket)
+                                    { return bucket.xMin <= xRange.max; });
+    const auto nrVisibleBuckets = unsigned(std::distance(begin, end));
+
+    if (level == 0 && nrVisibleBuckets * DECIMATION_FACTOR <= maxNrPoints)
+      return {};
+
+    const auto isLastLevel = (level + 1 == this->levels.size());
+    if (nrVisibleBuckets <= maxNrPoints || isLastLevel)
+    {
+      // Also return the neighbors of the visible buckets so that lines can be drawn up to the
+      // border of the range.
+      if (begin != buckets.begin())
+        begin--;
+      if (end != buckets.end())
+        end++;
+      return std::vector<PlotModel::DecimatedPoint>(begin, end);
+    }
+  }
+  return {};
+}
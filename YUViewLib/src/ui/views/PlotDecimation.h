@@ -0,0 +1,66 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut f�r Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "PlotModel.h"
+
+#include <functional>
+#include <optional>
+#include <vector>
+
+// A min/max/average pyramid over the points of one plot. On level 0, each bucket summarizes
+// DECIMATION_FACTOR points of the plot. On every further level, each bucket summarizes
+// DECIMATION_FACTOR buckets of the level below. When drawing, only the level where the visible
+// buckets are about one pixel wide has to be visited.
+// The points of the plot must be sorted by their x position.
+class PlotDecimation
+{
+public:
+  static constexpr unsigned DECIMATION_FACTOR = 4;
+
+  using GetPointFunction = std::function<PlotModel::Point(unsigned pointIndex)>;
+
+  // Update all buckets from the bucket that contains firstChangedPoint on. When points are only
+  // appended to the plot, this only touches the last bucket of every level.
+  void update(unsigned nrPoints, unsigned firstChangedPoint, const GetPointFunction &getPoint);
+  void clear();
+
+  // Get the buckets of the finest level that has at most maxNrPoints buckets in the x range. If
+  // even the points of the plot in the range are not more than maxNrPoints, no value is returned.
+  std::optional<std::vector<PlotModel::DecimatedPoint>>
+  getDecimatedPoints(Range<double> xRange, unsigned maxNrPoints) const;
+
+private:
+  std::vector<std::vector<PlotModel::DecimatedPoint>> levels;
+};
@@ -38,6 +38,7 @@
 #include <QObject>
 #include <QTimer>
 #include <optional>
+#include <vector>
 
 enum class Axis
 {
@@ -88,8 +89,22 @@ public:
 
   struct Point
   {
-    double x, y, width;
-    bool   intra;
+    double x{}, y{}, width{};
+    bool   intra{};
+  };
+
+  // One point of a decimated plot. It summarizes all points of the plot from xMin to xMax.
+  struct DecimatedPoint
+  {
+    double   xMin{};
+    double   xMax{};
+    double   yMin{};
+    double   yMax{};
+    double   yAverage{};
+    // The maximum of all intra points. Only valid if intra is set.
+    double   yMaxIntra{};
+    bool     intra{};
+    unsigned nrPoints{};
   };
 
   virtual unsigned        getNrStreams() const                           = 0;
@@ -101,6 +116,16 @@ public:
   virtual std::optional<unsigned> getReasonabelRangeToShowOnXAxisPer100Pixels() const = 0;
   virtual QString                 formatValue(Axis axis, double value) const          = 0;
   virtual Range<double>           getYRange() const                                   = 0;
+
+  // Get a decimated version of a plot (streamIndex, plotIndex) with at most maxNrPoints points
+  // in the given x range. If no value is returned, the points of the plot are few enough to be
+  // drawn directly.
+  virtual std::optional<std::vector<DecimatedPoint>>
+  getDecimatedPoints(unsigned, unsigned, Range<double>, unsigned) const
+  {
+    return {};
+  }
+
   std::optional<unsigned>
   getPointIndex(unsigned streamIndex, unsigned plotIndex, QPointF point) const;
 
@@ -58,6 +58,10 @@ const int fadeBoxThickness   = 10;
 const QColor gridLineMajor(180, 180, 180);
 const QColor gridLineMinor(230, 230, 230);
 
+const QColor barColorNormal(0, 0, 200, 100);
+const QColor barColorIntra(200, 100, 0, 100);
+const QColor lineColor(255, 200, 30);
+
 PlotViewWidget::PlotViewWidget(QWidget *parent) : MoveAndZoomableView(parent)
 {
   paletteBackgroundColorSettingsTag = "Plot/BackgroundColor";
@@ -621,13 +625,48 @@ void PlotViewWidget::drawPlot(QPainter &painter) const
   const auto plotXMax = this->convertPixelPosToPlotPos(this->plotRect.bottomRight()).x() + 0.5;
 
   DEBUG_PLOT("PlotViewWidget::drawPlot start");
+
+  // We can assume that the points are sorted (i.e. there is not graph that suddenly goes
+  // back)
+  auto getStartIndexBinarySearch = [](unsigned   nrpoints,
+                                      PlotModel *model,
+                                      unsigned   streamIndex,
+                                      unsigned   plotIndex,
+                                      double     plotXMin) {
+    unsigned intervalLeft  = 0;
+    unsigned intervalRight = nrpoints;
+    if (nrpoints == 0)
+      return intervalLeft;
+    while (true)
+    {
+      unsigned pointToCheck = intervalLeft + (intervalRight - intervalLeft) / 2;
+      auto     valuePoint   = model->getPlotPoint(streamIndex, plotIndex, pointToCheck);
+      if (valuePoint.x < plotXMin) // Choose right interval
+        intervalLeft = pointToCheck;
+      else // Left interval
+        intervalRight = pointToCheck;
+      if (intervalLeft + 1 == intervalRight)
+        return intervalLeft;
+    }
+  };
+
   for (auto streamIndex : this->showStreamList)
   {
     const auto param = this->model->getStreamParameter(streamIndex);
     for (unsigned int plotIndex = 0; plotIndex < param.getNrPlots(); plotIndex++)
     {
-      const auto plotParam        = param.plotParameters[plotIndex];
-      bool       detailedPainting = false;
+      const auto plotParam = param.plotParameters[plotIndex];
+
+      // Only visit the level of the decimation that has about one point per pixel
+      const auto decimatedPoints = this->model->getDecimatedPoints(
+          streamIndex, plotIndex, {plotXMin, plotXMax}, unsigned(this->plotRect.width()));
+      if (decimatedPoints)
+      {
+        this->drawDecimatedPlot(painter, plotParam.type, *decimatedPoints);
+        continue;
+      }
+
+      bool detailedPainting = false;
       if (plotParam.nrpoints > 0)
       {
         const auto firstPoint = model->getPlotPoint(streamIndex, plotIndex, 0);
@@ -638,7 +677,7 @@ void PlotViewWidget::drawPlot(QPainter &painter) const
       if (plotParam.type == PlotModel::PlotType::Bar)
       {
         auto setPainterColor = [&painter, &detailedPainting](bool isIntra, bool isHighlight) {
-          QColor color = isIntra ? QColor(200, 100, 0, 100) : QColor(0, 0, 200, 100);
+          QColor color = isIntra ? barColorIntra : barColorNormal;
           if (isHighlight)
             color = color.lighter(150);
           if (detailedPainting)
@@ -650,12 +689,16 @@ void PlotViewWidget::drawPlot(QPainter &painter) const
 
         QVector<QRectF> normalBars;
         QVector<QRectF> intraBars;
-        for (unsigned int i = 0; i < plotParam.nrpoints; i++)
+        const auto      startIndex = getStartIndexBinarySearch(
+            plotParam.nrpoints, this->model, streamIndex, plotIndex, plotXMin);
+        for (unsigned int i = startIndex; i < plotParam.nrpoints; i++)
         {
           const auto value = model->getPlotPoint(streamIndex, plotIndex, i);
 
-          if (value.x < plotXMin || value.x > plotXMax)
+          if (value.x < plotXMin)
             continue;
+          if (value.x > plotXMax)
+            break;
 
           const auto halfWidth = value.width / 2;
           const auto barTopLeft =
@@ -693,30 +736,6 @@ void PlotViewWidget::drawPlot(QPainter &painter) const
       }
       else if (plotParam.type == PlotModel::PlotType::Line)
       {
-        // We can assume that the points are sorted (i.e. there is not graph that suddenly goes
-        // back)
-        auto getStartIndexBinarySearch = [](unsigned   nrpoints,
-                                            PlotModel *model,
-                                            unsigned   streamIndex,
-                                            unsigned   plotIndex,
-                                            double     plotXMin) {
-          unsigned intervalLeft  = 0;
-          unsigned intervalRight = nrpoints;
-          if (nrpoints == 0)
-            return intervalLeft;
-          while (true)
-          {
-            unsigned pointToCheck = intervalLeft + (intervalRight - intervalLeft) / 2;
-            auto     valuePoint   = model->getPlotPoint(streamIndex, plotIndex, pointToCheck);
-            if (valuePoint.x < plotXMin) // Choose right interval
-              intervalLeft = pointToCheck;
-            else // Left interval
-              intervalRight = pointToCheck;
-            if (intervalLeft + 1 == intervalRight)
-              return intervalLeft;
-          }
-        };
-
         QPolygonF  linePoints;
         QPointF    lastPoint;
         const auto startIndex = getStartIndexBinarySearch(
@@ -747,7 +766,7 @@ void PlotViewWidget::drawPlot(QPainter &painter) const
 
         DEBUG_PLOT("PlotViewWidget::drawPlot Start drawing line with " << linePoints.size()
                                                                        << " points");
-        QPen linePen(QColor(255, 200, 30));
+        QPen linePen(lineColor);
         linePen.setWidthF(detailedPainting ? 2.0 : 1.0);
         painter.setPen(linePen);
         painter.drawPolyline(linePoints);
@@ -781,6 +800,61 @@ void PlotViewWidget::drawPlot(QPainter &painter) const
   }
 }
 
+void PlotViewWidget::drawDecimatedPlot(QPainter                                     &painter,
+                                       PlotModel::PlotType                           type,
+                                       const std::vector<PlotModel::DecimatedPoint> &points) const
+{
+  if (type == PlotModel::PlotType::Bar)
+  {
+    // Each decimated point is drawn as one bar up to the highest bar that it summarizes. The
+    // highest intra bar is drawn on top of it.
+    QVector<QRectF> normalBars;
+    QVector<QRectF> intraBars;
+    for (const auto &point : points)
+    {
+      const auto barBottomRight = this->convertPlotPosToPixelPos(QPointF(point.xMax, 0));
+      const auto barTopLeft     = this->convertPlotPosToPixelPos(QPointF(point.xMin, point.yMax));
+      normalBars.append(QRectF(barTopLeft, barBottomRight));
+      if (point.intra)
+      {
+        const auto intraTopLeft =
+            this->convertPlotPosToPixelPos(QPointF(point.xMin, point.yMaxIntra));
+        intraBars.append(QRectF(intraTopLeft, barBottomRight));
+      }
+    }
+
+    DEBUG_PLOT("PlotViewWidget::drawDecimatedPlot Start drawing " << normalBars.size()
+                                                                  << " bars");
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(barColorNormal);
+    painter.drawRects(normalBars);
+    painter.setBrush(barColorIntra);
+    painter.drawRects(intraBars);
+  }
+  else if (type == PlotModel::PlotType::Line)
+  {
+    // Connect the averages of the decimated points and draw a vertical line from the minimum to
+    // the maximum of each one so that no peak of the plot gets lost.
+    QPolygonF       averageLine;
+    QVector<QLineF> minMaxLines;
+    for (const auto &point : points)
+    {
+      const auto x = (point.xMin + point.xMax) / 2;
+      averageLine.append(this->convertPlotPosToPixelPos(QPointF(x, point.yAverage)));
+      minMaxLines.append(QLineF(this->convertPlotPosToPixelPos(QPointF(x, point.yMin)),
+                                this->convertPlotPosToPixelPos(QPointF(x, point.yMax))));
+    }
+
+    DEBUG_PLOT("PlotViewWidget::drawDecimatedPlot Start drawing line with "
+               << averageLine.size() << " points");
+    QPen linePen(lineColor);
+    linePen.setWidthF(1.0);
+    painter.setPen(linePen);
+    painter.drawPolyline(averageLine);
+    painter.drawLines(minMaxLines);
+  }
+}
+
 void PlotViewWidget::drawInfoBox(QPainter &painter) const
 {
   if (!this->model)
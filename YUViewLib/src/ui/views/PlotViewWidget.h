@@ -98,6 +98,7 @@ private:
 
   void drawLimits(QPainter &painter) const;
   void drawPlot(QPainter &painter) const;
+  void drawDecimatedPlot(QPainter &painter, PlotModel::PlotType type, const std::vector<PlotModel::DecimatedPoint> &points) const;
   void drawInfoBox(QPainter &painter) const;
   void drawDebugBox(QPainter &painter) const;
   void drawZoomRect(QPainter &painter) const;
@@ -34,6 +34,7 @@
 
 #include <playlistitem/playlistItem.h>
 #include <ui/PlaybackController.h>
+#include <video/CacheStatistics.h>
 #include <video/FrameHandler.h>
 #include <video/VideoCache.h>
 
@@ -1473,6 +1474,16 @@ QImage splitViewWidget::getScreenshot(bool fullItem)
   }
 }
 
+void splitViewWidget::recordFrameDraw(playlistItem    *item,
+                                      bool             newFrame,
+                                      ItemLoadingState state) const
+{
+  if (!this->isMasterView || !newFrame)
+    return;
+  if (auto statistics = item->getCacheStatistics())
+    statistics->recordDraw(state != ItemLoadingState::LoadingNeeded);
+}
+
 void splitViewWidget::playbackStarted(int nextFrameIdx)
 {
   if (!this->isMasterView)
@@ -1525,6 +1536,7 @@ void splitViewWidget::update(bool newFrame, bool itemRedraw)
     if (item[0])
     {
       auto state = item[0]->needsLoading(frameIdx, loadRawData);
+      this->recordFrameDraw(item[0], newFrame, state);
       if (state == ItemLoadingState::LoadingNeeded)
       {
         // The frame needs to be loaded first.
@@ -1545,6 +1557,7 @@ void splitViewWidget::update(bool newFrame, bool itemRedraw)
     if (isSplitting() && item[1])
     {
       auto state = item[1]->needsLoading(frameIdx, loadRawData);
+      this->recordFrameDraw(item[1], newFrame, state);
       if (state == ItemLoadingState::LoadingNeeded)
       {
         // The frame needs to be loaded first.
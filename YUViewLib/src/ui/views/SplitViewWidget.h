@@ -284,6 +284,10 @@ protected:
   // True if the "Loading..." message is currently being drawn for one of the two items
   bool drawingLoadingMessage[2]{false, false};
 
+  // Record in the cache statistics of the item if a new frame could be drawn right away or if it
+  // had to be loaded first. Only the master view records this so that every frame counts once.
+  void recordFrameDraw(playlistItem *item, bool newFrame, ItemLoadingState state) const;
+
   // Draw a ruler at the top and left that indicate the x and y position of the visible pixels
   void paintPixelRulersX(QPainter &    painter,
                          playlistItem *item,
@@ -32,8 +32,13 @@
 
 #include "VideoCacheInfoWidget.h"
 
+#include <QFile>
+#include <QFileDialog>
 #include <QGroupBox>
+#include <QJsonDocument>
+#include <QMessageBox>
 #include <QPainter>
+#include <QPushButton>
 #include <QSettings>
 
 #define VIDEOCACHEINFOWIDGET_DEBUG_OUTPUT 0
@@ -147,7 +152,13 @@ VideoCacheInfoWidget::VideoCacheInfoWidget(QWidget *parent) : QWidget(parent)
   QVBoxLayout *vbox = new QVBoxLayout;
   cachingInfoLabel  = new QLabel("", this);
   cachingInfoLabel->setAlignment(Qt::AlignTop);
-  vbox->addWidget(cachingInfoLabel);
+  vbox->addWidget(cachingInfoLabel, 1);
+  auto saveStatisticsButton  = new QPushButton("Save Statistics...", this);
+  auto resetStatisticsButton = new QPushButton("Reset Statistics", this);
+  auto buttonLayout          = new QHBoxLayout;
+  buttonLayout->addWidget(saveStatisticsButton);
+  buttonLayout->addWidget(resetStatisticsButton);
+  vbox->addLayout(buttonLayout);
   groupBox->setLayout(vbox);
 
   // Add everything to a vertical layout
@@ -158,6 +169,14 @@ VideoCacheInfoWidget::VideoCacheInfoWidget(QWidget *parent) : QWidget(parent)
   setLayout(mainLayout);
 
   connect(groupBox, &QGroupBox::toggled, this, &VideoCacheInfoWidget::onGroupBoxToggled);
+  connect(saveStatisticsButton,
+          &QPushButton::clicked,
+          this,
+          &VideoCacheInfoWidget::onSaveStatistics);
+  connect(resetStatisticsButton,
+          &QPushButton::clicked,
+          this,
+          &VideoCacheInfoWidget::onResetStatistics);
 }
 
 void VideoCacheInfoWidget::onGroupBoxToggled(bool on)
@@ -183,3 +202,32 @@ void VideoCacheInfoWidget::onUpdateCacheStatus()
   QStringList statusText = cache->getCacheStatusText();
   cachingInfoLabel->setText(statusText.join("\n"));
 }
+
+void VideoCacheInfoWidget::onSaveStatistics()
+{
+  if (cache == nullptr)
+    return;
+
+  // Get the statistics before the dialog is shown so that they match the time of the click
+  const auto json = cache->getCacheStatisticsJson();
+
+  const auto fileName = QFileDialog::getSaveFileName(
+      this, "Save Cache Statistics", "cacheStatistics.json", "JSON files (*.json)");
+  if (fileName.isEmpty())
+    return;
+
+  QFile file(fileName);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+      file.write(QJsonDocument(json).toJson()) < 0)
+    QMessageBox::critical(
+        this, "Error saving statistics", "The file " + fileName + " could not be written.");
+}
+
+void VideoCacheInfoWidget::onResetStatistics()
+{
+  if (cache == nullptr)
+    return;
+
+  cache->resetCacheStatistics();
+  this->onUpdateCacheStatus();
+}
@@ -79,6 +79,9 @@ public slots:
 
 private slots:
   void onGroupBoxToggled(bool on);
+  // Save the caching statistics of all items as a JSON file
+  void onSaveStatistics();
+  void onResetStatistics();
 
 private:
   VideoCacheStatusWidgetNamespace::VideoCacheStatusWidget *statusWidget{nullptr};
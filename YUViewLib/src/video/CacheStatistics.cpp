@@ -0,0 +1,191 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "CacheStatistics.h"
+
+#include <QJsonArray>
+
+#include <algorithm>
+#include <cmath>
+
+namespace video
+{
+
+void LatencyHistogram::add(std::chrono::microseconds latency)
+{
+  const auto latencyUs = std::max(int64_t(latency.count()), int64_t(0));
+  const auto it =
+      std::lower_bound(BUCKET_LIMITS_US.begin(), BUCKET_LIMITS_US.end(), latencyUs);
+  this->buckets[std::distance(BUCKET_LIMITS_US.begin(), it)]++;
+  this->count++;
+  this->totalUs += latencyUs;
+  this->maxUs = std::max(this->maxUs, latencyUs);
+}
+
+std::chrono::microseconds LatencyHistogram::getMean() const
+{
+  if (this->count == 0)
+    return {};
+  return std::chrono::microseconds(this->totalUs / int64_t(this->count));
+}
+
+std::chrono::microseconds LatencyHistogram::getPercentile(double percentile) const
+{
+  if (this->count == 0)
+    return {};
+
+  const auto rank = std::max(
+      uint64_t(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * double(this->count))),
+      uint64_t(1));
+  uint64_t nrValues = 0;
+  for (std::size_t i = 0; i < BUCKET_LIMITS_US.size(); i++)
+  {
+    nrValues += this->buckets[i];
+    if (nrValues >= rank)
+      return std::chrono::microseconds(std::min(BUCKET_LIMITS_US[i], this->maxUs));
+  }
+  return this->getMax();
+}
+
+QJsonObject LatencyHistogram::toJson() const
+{
+  QJsonArray bucketArray;
+  for (std::size_t i = 0; i < NR_BUCKETS; i++)
+  {
+    QJsonObject bucket;
+    if (i < BUCKET_LIMITS_US.size())
+      bucket["upperLimitUs"] = qint64(BUCKET_LIMITS_US[i]);
+    bucket["count"] = qint64(this->buckets[i]);
+    bucketArray.append(bucket);
+  }
+
+  QJsonObject json;
+  json["count"]   = qint64(this->count);
+  json["meanUs"]  = qint64(this->getMean().count());
+  json["p50Us"]   = qint64(this->getPercentile(50).count());
+  json["p95Us"]   = qint64(this->getPercentile(95).count());
+  json["maxUs"]   = qint64(this->maxUs);
+  json["buckets"] = bucketArray;
+  return json;
+}
+
+double ItemCacheStatistics::getHitRate() const
+{
+  const auto nrDraws = this->drawHits + this->drawMisses;
+  if (nrDraws == 0)
+    return 0.0;
+  return double(this->drawHits) / double(nrDraws);
+}
+
+QJsonObject ItemCacheStatistics::toJson() const
+{
+  QJsonObject latencyJson;
+  for (const auto stage : LoadingStageMapper.getValues())
+  {
+    const auto name = LoadingStageMapper.getName(stage);
+    latencyJson[QString::fromUtf8(name.data(), int(name.size()))] =
+        this->getLatency(stage).toJson();
+  }
+
+  QJsonObject json;
+  json["drawHits"]         = qint64(this->drawHits);
+  json["drawMisses"]       = qint64(this->drawMisses);
+  json["hitRate"]          = this->getHitRate();
+  json["interactiveLoads"] = qint64(this->interactiveLoads);
+  json["cachedFrames"]     = qint64(this->cachedFrames);
+  json["evictions"]        = qint64(this->evictions);
+  json["bytesResident"]    = qint64(this->bytesResident);
+  json["latencies"]        = latencyJson;
+  return json;
+}
+
+void CacheStatistics::recordDraw(bool hit)
+{
+  QMutexLocker lock(&this->mutex);
+  if (hit)
+    this->statistics.drawHits++;
+  else
+    this->statistics.drawMisses++;
+}
+
+void CacheStatistics::recordInteractiveLoad()
+{
+  QMutexLocker lock(&this->mutex);
+  this->statistics.interactiveLoads++;
+}
+
+void CacheStatistics::recordCachedFrame()
+{
+  QMutexLocker lock(&this->mutex);
+  this->statistics.cachedFrames++;
+}
+
+void CacheStatistics::recordEviction()
+{
+  QMutexLocker lock(&this->mutex);
+  this->statistics.evictions++;
+}
+
+void CacheStatistics::recordLatency(LoadingStage stage, std::chrono::microseconds latency)
+{
+  QMutexLocker lock(&this->mutex);
+  this->statistics.latencies.at(LoadingStageMapper.indexOf(stage)).add(latency);
+}
+
+ItemCacheStatistics CacheStatistics::getStatistics() const
+{
+  QMutexLocker lock(&this->mutex);
+  return this->statistics;
+}
+
+void CacheStatistics::reset()
+{
+  QMutexLocker lock(&this->mutex);
+  this->statistics = {};
+}
+
+ScopedLatencyTimer::ScopedLatencyTimer(CacheStatistics *statistics, LoadingStage stage)
+    : statistics(statistics), stage(stage), start(std::chrono::steady_clock::now())
+{
+}
+
+ScopedLatencyTimer::~ScopedLatencyTimer()
+{
+  if (this->statistics == nullptr)
+    return;
+  const auto duration = std::chrono::steady_clock::now() - this->start;
+  this->statistics->recordLatency(
+      this->stage, std::chrono::duration_cast<std::chrono::microseconds>(duration));
+}
+
+} // namespace video
@@ -0,0 +1,159 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <common/EnumMapper.h>
+
+#include <QJsonObject>
+#include <QMutex>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace video
+{
+
+// The stages of loading a frame that are timed separately
+enum class LoadingStage
+{
+  Read,
+  Decode,
+  Convert
+};
+
+constexpr EnumMapper<LoadingStage, 3>
+    LoadingStageMapper(std::make_pair(LoadingStage::Read, "Read"sv),
+                       std::make_pair(LoadingStage::Decode, "Decode"sv),
+                       std::make_pair(LoadingStage::Convert, "Convert"sv));
+
+/* A histogram of latencies. The latencies are counted in buckets with exponentially growing upper
+ * limits so that the distribution can be shown without storing every single value.
+ */
+class LatencyHistogram
+{
+public:
+  // The upper limits of the buckets in microseconds. One more bucket counts all longer latencies.
+  static constexpr std::array<int64_t, 12> BUCKET_LIMITS_US = {
+      250, 500, 1000, 2000, 4000, 8000, 16000, 32000, 64000, 128000, 256000, 512000};
+  static constexpr std::size_t NR_BUCKETS = BUCKET_LIMITS_US.size() + 1;
+
+  void add(std::chrono::microseconds latency);
+
+  uint64_t                  getCount() const { return this->count; }
+  std::chrono::microseconds getMean() const;
+  std::chrono::microseconds getMax() const { return std::chrono::microseconds(this->maxUs); }
+  // Get the upper limit of the bucket that contains the given percentile (0 to 100). For the last
+  // bucket, the maximum latency is returned.
+  std::chrono::microseconds getPercentile(double percentile) const;
+
+  const std::array<uint64_t, NR_BUCKETS> &getBuckets() const { return this->buckets; }
+
+  QJsonObject toJson() const;
+
+private:
+  std::array<uint64_t, NR_BUCKETS> buckets{};
+  uint64_t                         count{};
+  int64_t                          totalUs{};
+  int64_t                          maxUs{};
+};
+
+// The caching statistics of one item
+struct ItemCacheStatistics
+{
+  // New frames that were drawn. A hit means that the frame was ready (in the cache or in the double
+  // buffer). A miss means that it had to be loaded interactively first.
+  uint64_t drawHits{};
+  uint64_t drawMisses{};
+  // All frames that were loaded by the interactive loading threads (misses and double buffer)
+  uint64_t interactiveLoads{};
+  uint64_t cachedFrames{};
+  uint64_t evictions{};
+  // The memory that the cached frames of the item use (as accounted by the video cache)
+  int64_t bytesResident{};
+
+  std::array<LatencyHistogram, LoadingStageMapper.size()> latencies{};
+
+  // The ratio of draw hits to all drawn frames (0 if no frame was drawn yet)
+  double getHitRate() const;
+
+  const LatencyHistogram &getLatency(LoadingStage stage) const
+  {
+    return this->latencies.at(LoadingStageMapper.indexOf(stage));
+  }
+
+  QJsonObject toJson() const;
+};
+
+/* Collects the caching statistics of one item. The counters are updated from the caching and
+ * loading threads and from the main thread, so all functions are thread-safe.
+ */
+class CacheStatistics
+{
+public:
+  CacheStatistics() = default;
+
+  void recordDraw(bool hit);
+  void recordInteractiveLoad();
+  void recordCachedFrame();
+  void recordEviction();
+  void recordLatency(LoadingStage stage, std::chrono::microseconds latency);
+
+  ItemCacheStatistics getStatistics() const;
+  void                reset();
+
+private:
+  mutable QMutex      mutex;
+  ItemCacheStatistics statistics;
+};
+
+/* Measures the time from construction to destruction and records it as the latency of the given
+ * stage. Does nothing if no statistics are given.
+ */
+class ScopedLatencyTimer
+{
+public:
+  ScopedLatencyTimer(CacheStatistics *statistics, LoadingStage stage);
+  ~ScopedLatencyTimer();
+
+  ScopedLatencyTimer(const ScopedLatencyTimer &) = delete;
+  ScopedLatencyTimer &operator=(const ScopedLatencyTimer &) = delete;
+
+private:
+  CacheStatistics                      *statistics{};
+  LoadingStage                          stage{};
+  std::chrono::steady_clock::time_point start;
+};
+
+} // namespace video
@@ -0,0 +1,265 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FrameBufferPool.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtGlobal>
+
+#include <algorithm>
+#include <new>
+#include <vector>
+
+#ifdef Q_OS_LINUX
+#include <sys/mman.h>
+#endif
+
+namespace video
+{
+
+namespace
+{
+
+size_t roundUp(size_t value, size_t multiple)
+{
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+std::align_val_t getAlignment(size_t sizeClass)
+{
+  if (sizeClass >= FrameBufferPool::HUGE_PAGE_SIZE)
+    return std::align_val_t(FrameBufferPool::HUGE_PAGE_SIZE);
+  return std::align_val_t(FrameBufferPool::ALIGNMENT);
+}
+
+// Returns nullptr if the allocation failed
+unsigned char *allocateBuffer(size_t sizeClass)
+{
+  auto data = static_cast<unsigned char *>(
+      ::operator new(sizeClass, getAlignment(sizeClass), std::nothrow));
+  if (data == nullptr)
+    return nullptr;
+#ifdef Q_OS_LINUX
+  // This is only a hint. Transparent huge pages may not be available.
+  if (sizeClass >= FrameBufferPool::HUGE_PAGE_SIZE)
+    madvise(data, sizeClass, MADV_HUGEPAGE);
+#endif
+  return data;
+}
+
+void freeBuffer(unsigned char *data, size_t sizeClass)
+{
+  ::operator delete(data, getAlignment(sizeClass));
+}
+
+void releaseImageBuffer(void *buffer)
+{
+  delete static_cast<std::shared_ptr<unsigned char> *>(buffer);
+}
+
+} // namespace
+
+struct FrameBufferPool::Buffers
+{
+  struct FreeBuffer
+  {
+    unsigned char *data{};
+    size_t         sizeClass{};
+  };
+
+  ~Buffers()
+  {
+    for (const auto &buffer : this->freeBuffers)
+      freeBuffer(buffer.data, buffer.sizeClass);
+  }
+
+  // Put the buffer back into the pool (or free it if there are enough unused buffers)
+  void release(unsigned char *data, size_t sizeClass)
+  {
+    std::vector<FreeBuffer> buffersToFree;
+    {
+      QMutexLocker lock(&this->mutex);
+      this->statistics.bytesInUse -= int64_t(sizeClass);
+      this->freeBuffers.push_back({data, sizeClass});
+      this->statistics.bytesFree += int64_t(sizeClass);
+      buffersToFree = this->removeOldestFreeBuffers(this->maxFreeBytes);
+    }
+    for (const auto &buffer : buffersToFree)
+      freeBuffer(buffer.data, buffer.sizeClass);
+  }
+
+  // Remove the least recently released buffers until at most maxBytes are left. The mutex must be
+  // locked. The removed buffers must be freed (preferably after unlocking the mutex).
+  std::vector<FreeBuffer> removeOldestFreeBuffers(int64_t maxBytes)
+  {
+    std::vector<FreeBuffer> removedBuffers;
+    auto                    it = this->freeBuffers.begin();
+    while (this->statistics.bytesFree > maxBytes && it != this->freeBuffers.end())
+    {
+      this->statistics.bytesFree -= int64_t(it->sizeClass);
+      removedBuffers.push_back(*it);
+      it++;
+    }
+    this->freeBuffers.erase(this->freeBuffers.begin(), it);
+    return removedBuffers;
+  }
+
+  QMutex mutex;
+  // Ordered by the time of release (the most recently released buffer is last)
+  std::vector<FreeBuffer> freeBuffers;
+  int64_t                 maxFreeBytes{DEFAULT_MAX_FREE_BYTES};
+  Statistics              statistics;
+};
+
+FrameBufferPool::FrameBufferPool() : buffers(std::make_shared<Buffers>())
+{
+}
+
+FrameBufferPool &FrameBufferPool::shared()
+{
+  static FrameBufferPool pool;
+  return pool;
+}
+
+std::shared_ptr<unsigned char> FrameBufferPool::allocate(size_t nrBytes)
+{
+  const auto     sizeClass = getSizeClass(nrBytes);
+  unsigned char *data      = nullptr;
+  {
+    QMutexLocker lock(&this->buffers->mutex);
+    auto        &freeBuffers = this->buffers->freeBuffers;
+    auto        &statistics  = this->buffers->statistics;
+    statistics.nrAllocations++;
+
+    // Reuse the most recently released buffer of the size class. Its memory is most likely still
+    // resident.
+    auto it = std::find_if(freeBuffers.rbegin(), freeBuffers.rend(), [sizeClass](const auto &b) {
+      return b.sizeClass == sizeClass;
+    });
+    if (it != freeBuffers.rend())
+    {
+      data = it->data;
+      freeBuffers.erase(std::next(it).base());
+      statistics.bytesFree -= int64_t(sizeClass);
+      statistics.bytesInUse += int64_t(sizeClass);
+      statistics.nrReused++;
+    }
+  }
+
+  if (data == nullptr)
+  {
+    data = allocateBuffer(sizeClass);
+    if (data == nullptr)
+    {
+      // Free all unused buffers and try again
+      this->releaseFreeBuffers();
+      data = allocateBuffer(sizeClass);
+      if (data == nullptr)
+        throw std::bad_alloc();
+    }
+    QMutexLocker lock(&this->buffers->mutex);
+    this->buffers->statistics.bytesInUse += int64_t(sizeClass);
+  }
+
+  auto buffers = this->buffers;
+  return std::shared_ptr<unsigned char>(data, [buffers, sizeClass](unsigned char *bufferData) {
+    buffers->release(bufferData, sizeClass);
+  });
+}
+
+QImage FrameBufferPool::allocateImage(const QSize &size, QImage::Format format)
+{
+  const auto bitsPerPixel = QImage::toPixelFormat(format).bitsPerPixel();
+  if (size.isEmpty() || bitsPerPixel <= 0)
+    return {};
+
+  // The same as QImage does: Every line is a multiple of 4 bytes
+  const auto bytesPerLine = ((size_t(size.width()) * bitsPerPixel + 31) >> 5) << 2;
+  auto       buffer =
+      new std::shared_ptr<unsigned char>(this->allocate(bytesPerLine * size_t(size.height())));
+  QImage image(buffer->get(),
+               size.width(),
+               size.height(),
+               int(bytesPerLine),
+               format,
+               releaseImageBuffer,
+               buffer);
+  if (image.isNull())
+    // The cleanup function is not called for an invalid image
+    delete buffer;
+  return image;
+}
+
+void FrameBufferPool::setMaxFreeBytes(int64_t maxFreeBytes)
+{
+  std::vector<Buffers::FreeBuffer> buffersToFree;
+  {
+    QMutexLocker lock(&this->buffers->mutex);
+    this->buffers->maxFreeBytes = std::max(maxFreeBytes, int64_t(0));
+    buffersToFree = this->buffers->removeOldestFreeBuffers(this->buffers->maxFreeBytes);
+  }
+  for (const auto &buffer : buffersToFree)
+    freeBuffer(buffer.data, buffer.sizeClass);
+}
+
+void FrameBufferPool::releaseFreeBuffers()
+{
+  std::vector<Buffers::FreeBuffer> buffersToFree;
+  {
+    QMutexLocker lock(&this->buffers->mutex);
+    buffersToFree = this->buffers->removeOldestFreeBuffers(0);
+  }
+  for (const auto &buffer : buffersToFree)
+    freeBuffer(buffer.data, buffer.sizeClass);
+}
+
+FrameBufferPool::Statistics FrameBufferPool::getStatistics() const
+{
+  QMutexLocker lock(&this->buffers->mutex);
+  return this->buffers->statistics;
+}
+
+size_t FrameBufferPool::getSizeClass(size_t nrBytes)
+{
+  if (nrBytes <= 8 * ALIGNMENT)
+    return std::max(roundUp(nrBytes, ALIGNMENT), ALIGNMENT);
+
+  // The size classes between the powers of two lowerPower and 2 * lowerPower are 1/8 of
+  // lowerPower apart.
+  size_t lowerPower = 8 * ALIGNMENT;
+  while (lowerPower * 2 < nrBytes)
+    lowerPower *= 2;
+  return roundUp(nrBytes, lowerPower / 8);
+}
+
+} // namespace video
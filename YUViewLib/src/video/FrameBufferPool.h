@@ -0,0 +1,103 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QImage>
+#include <QSize>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace video
+{
+
+/* A pool of the large buffers that are needed for frames (raw frames, copies of decoded pictures
+ * and converted images). With large frames (e.g. 8K), allocating a new buffer for every frame is
+ * slow because the memory of every new buffer has to be mapped and page faulted in again. So a
+ * buffer is not freed when it is not used anymore (e.g. when its frame is evicted from the cache).
+ * It goes back into the pool and is reused for the next buffer of the same size class. Only up to
+ * maxFreeBytes are kept in unused buffers. Large buffers are aligned to the huge page size so that
+ * the system can back them with huge pages. All functions are thread-safe.
+ */
+class FrameBufferPool
+{
+public:
+  FrameBufferPool();
+
+  // The pool that is shared by the video cache, the video handlers and the decoders
+  static FrameBufferPool &shared();
+
+  // Get a buffer of at least nrBytes. When the last copy of the returned pointer is destroyed, the
+  // buffer goes back into the pool. A buffer may outlive the pool.
+  std::shared_ptr<unsigned char> allocate(size_t nrBytes);
+
+  // Get an uninitialized image whose pixel data is in a buffer from the pool. The buffer goes back
+  // into the pool when the image and all copies of it are destroyed.
+  QImage allocateImage(const QSize &size, QImage::Format format);
+
+  // Keep at most this many bytes in unused buffers. Unused buffers above the limit are freed.
+  void setMaxFreeBytes(int64_t maxFreeBytes);
+  // Free all unused buffers
+  void releaseFreeBuffers();
+
+  struct Statistics
+  {
+    int64_t  bytesInUse{};
+    int64_t  bytesFree{};
+    uint64_t nrAllocations{};
+    // The number of allocations that got an unused buffer from the pool
+    uint64_t nrReused{};
+
+    int64_t getBytesResident() const { return this->bytesInUse + this->bytesFree; }
+  };
+  Statistics getStatistics() const;
+
+  // The size of the buffer that is allocated for nrBytes. There are 8 size classes per power of
+  // two, so at most 1/8 of a buffer is wasted. From 8 * HUGE_PAGE_SIZE on, the size classes are
+  // multiples of HUGE_PAGE_SIZE. Smaller buffers are not rounded up to it (that would waste more
+  // than 1/8). They are only aligned to it.
+  static size_t getSizeClass(size_t nrBytes);
+
+  static constexpr size_t  ALIGNMENT              = 64;
+  static constexpr size_t  HUGE_PAGE_SIZE         = size_t(2) * 1024 * 1024;
+  static constexpr int64_t DEFAULT_MAX_FREE_BYTES = int64_t(512) * 1024 * 1024;
+
+private:
+  // The unused buffers and the statistics. They are shared with the buffers that are in use so
+  // that these can go back into the pool even if the pool was destroyed.
+  struct Buffers;
+  std::shared_ptr<Buffers> buffers;
+};
+
+} // namespace video
@@ -268,7 +268,7 @@ void FrameHandler::drawFrame(QPainter *painter, double zoomFactor, bool drawRawV
   videoRect.moveCenter(QPoint(0, 0));
 
   // Draw the current image (currentFrame)
-  painter->drawImage(videoRect, this->currentImage);
+  this->drawCurrentImage(painter, videoRect);
 
   if (drawRawValues && zoomFactor >= SPLITVIEW_DRAW_VALUES_ZOOMFACTOR)
   {
@@ -277,6 +277,18 @@ void FrameHandler::drawFrame(QPainter *painter, double zoomFactor, bool drawRawV
   }
 }
 
+void FrameHandler::drawCurrentImage(QPainter *painter, const QRect &videoRect)
+{
+  const auto targetSize = painter->transform().mapRect(QRectF(videoRect)).size() *
+                          painter->device()->devicePixelRatioF();
+  if (this->currentImage.width() > 0)
+    this->lastDrawnImageScale.store(targetSize.width() / this->currentImage.width());
+
+  const auto &image =
+      this->currentImagePyramid.getImageForTargetSize(this->currentImage, targetSize);
+  painter->drawImage(videoRect, image);
+}
+
 void FrameHandler::drawPixelValues(QPainter *painter,
                                    const int,
                                    const QRect  &videoRect,
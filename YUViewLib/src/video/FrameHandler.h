@@ -36,11 +36,14 @@
 #include <common/SaveUi.h>
 #include <common/Typedef.h>
 #include <common/YUViewDomElement.h>
+#include <video/ImagePyramid.h>
 
 #include <QImage>
 #include <QObject>
 #include <QSettings>
 
+#include <atomic>
+
 #include "ui_FrameHandler.h"
 
 namespace video
@@ -140,6 +143,28 @@ protected:
   QImage currentImage;
   Size   frameSize;
 
+  // The downscaled levels of the current image. This is only used if it was created from the
+  // current image (see ImagePyramid::getImageForTargetSize).
+  ImagePyramid currentImagePyramid;
+  void         setCurrentImage(const ImagePyramid &image)
+  {
+    this->currentImage        = image.getImage();
+    this->currentImagePyramid = image;
+  }
+
+  // Draw the current image into the given rect. When zoomed out, a downscaled level of the image
+  // with at least the resolution of the rect on screen is drawn (if it was created).
+  void drawCurrentImage(QPainter *painter, const QRect &videoRect);
+
+  // The scale at which the current image was last drawn (size on screen in device pixels / size of
+  // the image). It is set when drawing and read in the loading and caching threads, which only
+  // create the downscaled levels of new images if the frames are drawn zoomed out.
+  std::atomic<double> lastDrawnImageScale{1.0};
+  bool                isDrawnZoomedOut() const
+  {
+    return this->lastDrawnImageScale.load() < ImagePyramid::MAX_SCALE_FOR_DOWNSCALED_LEVELS;
+  }
+
   // Get the pixel value from currentImage. Make sure that currentImage is the correct image.
   QRgb         getPixelVal(const QPoint &pos) { return getPixelVal(pos.x(), pos.y()); }
   virtual QRgb getPixelVal(int x, int y) { return currentImage.pixel(x, y); }
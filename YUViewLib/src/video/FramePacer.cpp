@@ -0,0 +1,127 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "FramePacer.h"
+
+#include <algorithm>
+
+namespace video
+{
+
+namespace
+{
+
+constexpr auto LOWEST_FRAMES_PER_SECOND = 0.01;
+
+} // namespace
+
+void FramePacer::start(Clock::time_point now, double framesPerSecond)
+{
+  this->framesPerSecond = std::max(framesPerSecond, LOWEST_FRAMES_PER_SECOND);
+  this->frameInterval   = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(1.0 / this->framesPerSecond));
+  this->startTime       = now;
+  this->framePosition   = 0;
+}
+
+void FramePacer::resetStatistics()
+{
+  this->nrPresentedFrames = 0;
+  this->nrDroppedFrames   = 0;
+  this->nrSlowDowns       = 0;
+  this->presentationTimes.clear();
+}
+
+void FramePacer::setFramesPerSecond(Clock::time_point now, double framesPerSecond)
+{
+  // Restart the clock at the last presented frame (or now if that was too long ago)
+  const auto lastFrameTime = this->getFrameTime(this->framePosition);
+  this->start(lastFrameTime, framesPerSecond);
+  this->startTime = std::max(this->startTime, now - this->frameInterval);
+}
+
+FramePacer::Clock::time_point FramePacer::getFrameTime(int64_t framePosition) const
+{
+  return this->startTime + this->frameInterval * framePosition;
+}
+
+int64_t FramePacer::getNrFramesDue(Clock::time_point now) const
+{
+  if (this->frameInterval <= Clock::duration::zero())
+    return 0;
+
+  const auto timeSinceStart     = now + EARLY_TOLERANCE - this->startTime;
+  const auto nrFramesSinceStart = timeSinceStart / this->frameInterval;
+  return std::max(int64_t(nrFramesSinceStart) - this->framePosition, int64_t(0));
+}
+
+FramePacer::Clock::duration FramePacer::getTimeUntilNextFrame(Clock::time_point now) const
+{
+  const auto nextFrameTime = this->getFrameTime(this->framePosition + 1);
+  return std::max(nextFrameTime - now, Clock::duration::zero());
+}
+
+void FramePacer::framesPresented(Clock::time_point now, int64_t nrFrames)
+{
+  if (nrFrames <= 0)
+    return;
+
+  this->framePosition += nrFrames;
+  this->nrPresentedFrames++;
+  this->nrDroppedFrames += uint64_t(nrFrames - 1);
+
+  if (this->getNrFramesDue(now) > 0)
+  {
+    // Still late. Move the clock so that the next frame is due one interval from now.
+    this->startTime = now - this->frameInterval * this->framePosition;
+    this->nrSlowDowns++;
+  }
+
+  this->presentationTimes.push_back(now);
+  while (this->presentationTimes.front() < now - FRAME_RATE_MEASUREMENT_DURATION)
+    this->presentationTimes.pop_front();
+}
+
+double FramePacer::getAchievedFramesPerSecond() const
+{
+  if (this->presentationTimes.size() < 2)
+    return 0.0;
+
+  const auto duration = std::chrono::duration<double>(this->presentationTimes.back() -
+                                                      this->presentationTimes.front());
+  if (duration.count() <= 0.0)
+    return 0.0;
+  return double(this->presentationTimes.size() - 1) / duration.count();
+}
+
+} // namespace video
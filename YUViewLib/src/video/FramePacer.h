@@ -0,0 +1,111 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+
+namespace video
+{
+
+// What to do if frames can not be presented at the frame rate (e.g. because loading is too slow)
+enum class LateFramePolicy
+{
+  // Present every frame. Playback slows down and the presentation clock is moved.
+  SlowDown,
+  // Skip frames to keep up with the clock
+  DropFrames
+};
+
+/* Paces the presentation of frames to a frame rate using a monotonic clock. The time of every
+ * frame is calculated from the start of playback, so the rounding of the timer interval to
+ * milliseconds does not accumulate and the achieved frame rate matches the requested one. The
+ * pacer also keeps track of the achieved frame rate and the number of dropped frames.
+ */
+class FramePacer
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  FramePacer() = default;
+
+  // Start (or restart) presenting at the given time. The first frame is due one frame interval
+  // after now. The statistics are kept.
+  void start(Clock::time_point now, double framesPerSecond);
+  void resetStatistics();
+  // Change the frame rate without resetting the statistics. The next frame is due one (new) frame
+  // interval after the last presented frame.
+  void setFramesPerSecond(Clock::time_point now, double framesPerSecond);
+  double getFramesPerSecond() const { return this->framesPerSecond; }
+
+  // How many frames are due at the given time. 0 if the next frame is not due yet. If more than
+  // one frame is due, presentation is late.
+  int64_t getNrFramesDue(Clock::time_point now) const;
+  // The time until the next frame is due (zero if it is due already)
+  Clock::duration getTimeUntilNextFrame(Clock::time_point now) const;
+
+  // Frames were presented at the given time. All but the last of the presented frames were dropped
+  // (skipped). If presentation is still late after this, the clock is moved so that the next frame
+  // is due one frame interval after now (the playback slows down).
+  void framesPresented(Clock::time_point now, int64_t nrFrames);
+
+  // The frame rate that was achieved within the last second
+  double   getAchievedFramesPerSecond() const;
+  uint64_t getNrPresentedFrames() const { return this->nrPresentedFrames; }
+  uint64_t getNrDroppedFrames() const { return this->nrDroppedFrames; }
+  // How often the clock had to be moved because presentation was late
+  uint64_t getNrSlowDowns() const { return this->nrSlowDowns; }
+
+  // A frame is due if the timer fires up to this much before the exact time of the frame
+  static constexpr auto EARLY_TOLERANCE = std::chrono::milliseconds(1);
+  // The achieved frame rate is measured over this duration
+  static constexpr auto FRAME_RATE_MEASUREMENT_DURATION = std::chrono::seconds(1);
+
+private:
+  Clock::time_point getFrameTime(int64_t framePosition) const;
+
+  double            framesPerSecond{};
+  Clock::duration   frameInterval{};
+  Clock::time_point startTime{};
+  // The number of frames that were advanced since startTime
+  int64_t framePosition{};
+
+  uint64_t                      nrPresentedFrames{};
+  uint64_t                      nrDroppedFrames{};
+  uint64_t                      nrSlowDowns{};
+  std::deque<Clock::time_point> presentationTimes;
+};
+
+} // namespace video
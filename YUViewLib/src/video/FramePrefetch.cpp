@@ -0,0 +1,242 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "FramePrefetch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace video::prefetch
+{
+
+namespace
+{
+
+void addWindowsAroundPosition(std::vector<PrefetchWindow> &windows,
+                              const int                    position,
+                              const int64_t                nrFrames,
+                              const FrameMotion           &motion,
+                              const int                    step,
+                              const int                    firstFrame,
+                              const int                    lastFrame)
+{
+  // Without a known direction, the frames after the position are cached first
+  const auto aheadDirection = (motion.direction < 0) ? -1 : 1;
+  auto       aheadShare     = 0.5;
+  if (motion.direction != 0)
+    aheadShare = (motion.framesPerSecond >= FAST_MOTION_FRAMES_PER_SECOND) ? 0.875 : 0.75;
+
+  const auto availableAhead =
+      int64_t((aheadDirection > 0 ? lastFrame - position : position - firstFrame) / step + 1);
+  const auto availableBehind =
+      int64_t((aheadDirection > 0 ? position - firstFrame : lastFrame - position) / step);
+
+  const auto nrAheadWanted = int64_t(std::llround(double(nrFrames) * aheadShare));
+  auto       nrAhead       = std::min(availableAhead, std::max(int64_t(1), nrAheadWanted));
+  const auto nrBehind = std::min(availableBehind, std::max(nrFrames - nrAhead, int64_t(0)));
+  // If there are not enough frames behind the position, use the rest of the frames ahead of it
+  nrAhead = std::min(availableAhead, nrFrames - nrBehind);
+
+  const auto aheadStep = aheadDirection * step;
+  if (nrAhead > 0)
+    windows.push_back({position, position + aheadStep * int(nrAhead - 1), aheadStep});
+  if (nrBehind > 0)
+    windows.push_back({position - aheadStep, position - aheadStep * int(nrBehind), -aheadStep});
+}
+
+} // namespace
+
+void FrameMotionTracker::addFrameChange(int frameIndex, int64_t timeMs)
+{
+  if (!this->history.empty() && this->history.back().frameIndex == frameIndex)
+    return;
+
+  this->history.push_back({frameIndex, timeMs});
+  while (this->history.size() > HISTORY_SIZE ||
+         timeMs - this->history.front().timeMs > HISTORY_DURATION_MS)
+    this->history.pop_front();
+}
+
+FrameMotion FrameMotionTracker::getMotion() const
+{
+  FrameMotion motion;
+  if (this->history.size() < 2)
+    return motion;
+
+  // Only the most recent steps are considered
+  constexpr std::size_t NR_RECENT_STEPS = 4;
+  const auto            nrSteps         = std::min(this->history.size() - 1, NR_RECENT_STEPS);
+  const auto            firstRecent     = this->history.size() - 1 - nrSteps;
+
+  std::vector<int> stepSizes;
+  int64_t          distance = 0;
+  for (auto i = firstRecent + 1; i < this->history.size(); i++)
+  {
+    const auto step = this->history[i].frameIndex - this->history[i - 1].frameIndex;
+    stepSizes.push_back(std::abs(step));
+    distance += std::abs(step);
+  }
+
+  // The last step tells us best where the user goes next
+  const auto n        = this->history.size();
+  const auto lastStep = this->history[n - 1].frameIndex - this->history[n - 2].frameIndex;
+  motion.direction    = (lastStep > 0) ? 1 : -1;
+
+  std::nth_element(
+      stepSizes.begin(), stepSizes.begin() + stepSizes.size() / 2, stepSizes.end());
+  motion.stepSize = std::max(stepSizes[stepSizes.size() / 2], 1);
+
+  const auto durationMs =
+      std::max(this->history.back().timeMs - this->history[firstRecent].timeMs, int64_t(1));
+  motion.framesPerSecond = double(distance) * 1000.0 / double(durationMs);
+
+  // Jumping back and forth between two positions A and B (A, B, A, B)?
+  if (n >= 4)
+  {
+    const auto a0 = this->history[n - 4].frameIndex;
+    const auto b0 = this->history[n - 3].frameIndex;
+    const auto a1 = this->history[n - 2].frameIndex;
+    const auto b1 = this->history[n - 1].frameIndex;
+    if (std::abs(a1 - a0) <= 1 && std::abs(b1 - b0) <= 1 &&
+        std::abs(b1 - a1) >= MIN_ALTERNATE_DISTANCE)
+    {
+      motion.direction         = 0;
+      motion.stepSize          = 1;
+      motion.alternatePosition = a1;
+    }
+  }
+
+  return motion;
+}
+
+bool PrefetchWindow::contains(int frameIndex) const
+{
+  const auto first = std::min(this->start, this->end);
+  const auto last  = std::max(this->start, this->end);
+  if (frameIndex < first || frameIndex > last)
+    return false;
+  return (frameIndex - this->start) % this->step == 0;
+}
+
+std::vector<PrefetchWindow> getPrefetchWindows(int                currentFrame,
+                                               int                firstFrame,
+                                               int                lastFrame,
+                                               const FrameMotion &motion,
+                                               int64_t            maxNrFrames,
+                                               bool               randomAccess)
+{
+  if (lastFrame < firstFrame || maxNrFrames <= 0)
+    return {};
+
+  const auto position  = std::clamp(currentFrame, firstFrame, lastFrame);
+  const auto rangeSize = int64_t(lastFrame) - firstFrame + 1;
+  const auto nrFrames  = std::min(maxNrFrames, rangeSize);
+
+  // If not all frames fit, skip the frames that the user steps over
+  const auto allFramesFit = maxNrFrames >= rangeSize;
+  const auto step         = (randomAccess && !allFramesFit) ? std::max(motion.stepSize, 1) : 1;
+
+  std::vector<int> positions = {position};
+  if (motion.alternatePosition && *motion.alternatePosition >= firstFrame &&
+      *motion.alternatePosition <= lastFrame &&
+      std::abs(*motion.alternatePosition - position) > nrFrames / 2)
+    positions.push_back(*motion.alternatePosition);
+
+  std::vector<PrefetchWindow> windows;
+  const auto                  nrFramesPerPosition = nrFrames / int64_t(positions.size());
+  for (const auto p : positions)
+    addWindowsAroundPosition(
+        windows, p, nrFramesPerPosition, motion, step, firstFrame, lastFrame);
+
+  if (!randomAccess)
+    for (auto &window : windows)
+      window = {std::min(window.start, window.end), std::max(window.start, window.end), 1};
+
+  return windows;
+}
+
+std::vector<int>
+getEvictionOrder(std::vector<int> frames, int currentFrame, const FrameMotion &motion)
+{
+  auto getDistance = [&](const int frame) {
+    auto distance = std::abs(frame - currentFrame);
+    if (motion.alternatePosition)
+      distance = std::min(distance, std::abs(frame - *motion.alternatePosition));
+    return distance;
+  };
+  auto isBehind = [&](const int frame) {
+    return motion.direction != 0 && (frame - currentFrame) * motion.direction < 0;
+  };
+
+  std::stable_sort(frames.begin(), frames.end(), [&](const int frame0, const int frame1) {
+    const auto behind0 = isBehind(frame0);
+    const auto behind1 = isBehind(frame1);
+    if (behind0 != behind1)
+      return behind0;
+    return getDistance(frame0) > getDistance(frame1);
+  });
+  return frames;
+}
+
+std::vector<PrefetchWindow> getCachingSegments(int                     firstFrame,
+                                               int                     lastFrame,
+                                               const std::vector<int> &segmentStarts,
+                                               const std::vector<int> &cachedFrames)
+{
+  std::vector<PrefetchWindow> segments;
+  for (const auto segmentStart : segmentStarts)
+  {
+    if (segmentStart <= firstFrame + 1 || segmentStart >= lastFrame)
+      continue;
+    segments.push_back({firstFrame, segmentStart - 1});
+    firstFrame = segmentStart;
+  }
+  segments.push_back({firstFrame, lastFrame});
+
+  auto isCached = [&cachedFrames](int frame) {
+    return std::find(cachedFrames.begin(), cachedFrames.end(), frame) != cachedFrames.end();
+  };
+
+  std::vector<PrefetchWindow> uncachedSegments;
+  for (auto segment : segments)
+  {
+    while (isCached(segment.start) && segment.start < segment.end)
+      segment.start++;
+    if (segment.start != segment.end)
+      uncachedSegments.push_back(segment);
+  }
+  return uncachedSegments;
+}
+
+} // namespace video::prefetch
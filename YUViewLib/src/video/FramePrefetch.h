@@ -0,0 +1,131 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+namespace video::prefetch
+{
+
+// How the user moves through the frames of the current item
+struct FrameMotion
+{
+  // 1 forward, -1 backward or 0 if the direction is not known
+  int direction{};
+  // The typical distance between two frames that are shown one after the other
+  int stepSize{1};
+  // How many frames per second the position moves
+  double framesPerSecond{};
+  // If the user jumps back and forth between two positions (e.g. to compare them), this is the
+  // other position
+  std::optional<int> alternatePosition;
+};
+
+/* Records the recent changes of the current frame (stepping, scrubbing, playback) and derives the
+ * motion from it. Only the last few changes are considered so that the motion follows changes of
+ * the direction quickly.
+ */
+class FrameMotionTracker
+{
+public:
+  FrameMotionTracker() = default;
+
+  void addFrameChange(int frameIndex, int64_t timeMs);
+  void clear() { this->history.clear(); }
+
+  FrameMotion getMotion() const;
+
+  static constexpr std::size_t HISTORY_SIZE        = 8;
+  static constexpr int64_t     HISTORY_DURATION_MS = 3000;
+  // Jumps of at least this many frames between two positions are an A/B comparison
+  static constexpr int MIN_ALTERNATE_DISTANCE = 8;
+
+private:
+  struct FrameChange
+  {
+    int     frameIndex{};
+    int64_t timeMs{};
+  };
+  std::deque<FrameChange> history;
+};
+
+// A window of frames to cache. The frames start, start + step, ... up to end are cached in this
+// order. For a backward window, step is negative.
+struct PrefetchWindow
+{
+  int start{};
+  int end{};
+  int step{1};
+
+  bool operator==(const PrefetchWindow &other) const
+  {
+    return this->start == other.start && this->end == other.end && this->step == other.step;
+  }
+  int  getNrFrames() const { return (this->end - this->start) / this->step + 1; }
+  bool contains(int frameIndex) const;
+};
+
+// With at least this speed, almost all frames are cached in the direction of the motion
+constexpr double FAST_MOTION_FRAMES_PER_SECOND = 10.0;
+
+// Get the windows of frames to cache (in this order) for an item with the frames firstFrame to
+// lastFrame. At most maxNrFrames frames are cached. Most of them are ahead of the current frame in
+// the direction of the motion, the rest behind it. If the user compares two positions, both get
+// a window. If the frames can not be accessed randomly (e.g. because they are decoded), all
+// windows are cached forward with a step of 1.
+std::vector<PrefetchWindow> getPrefetchWindows(int                currentFrame,
+                                               int                firstFrame,
+                                               int                lastFrame,
+                                               const FrameMotion &motion,
+                                               int64_t            maxNrFrames,
+                                               bool               randomAccess);
+
+// Sort the frames in the order in which they should be removed from the cache. Frames behind the
+// motion are removed before the frames ahead of it and far frames before near ones.
+std::vector<int>
+getEvictionOrder(std::vector<int> frames, int currentFrame, const FrameMotion &motion);
+
+// Split the frames firstFrame to lastFrame at the given segment starts (e.g. the random access
+// points of a bitstream) into forward windows which can be cached independently. Each window has at
+// least two frames. The frames at the start of a window that are already cached are skipped. A
+// window of which only the last frame is left after this is dropped.
+std::vector<PrefetchWindow> getCachingSegments(int                     firstFrame,
+                                               int                     lastFrame,
+                                               const std::vector<int> &segmentStarts,
+                                               const std::vector<int> &cachedFrames);
+
+} // namespace video::prefetch
@@ -0,0 +1,124 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "ImagePyramid.h"
+
+namespace video
+{
+
+namespace
+{
+
+bool is32BitRGBFormat(const QImage::Format format)
+{
+  return format == QImage::Format_RGB32 || format == QImage::Format_ARGB32 ||
+         format == QImage::Format_ARGB32_Premultiplied;
+}
+
+// Average each 2x2 block of pixels. For the 32 bit formats, all four 8 bit channels of a pixel are
+// averaged at once by splitting the channels into two 16 bit lanes of a 32 bit value.
+QImage downscaleByTwo(const QImage &image)
+{
+  const auto width  = image.width() / 2;
+  const auto height = image.height() / 2;
+
+  if (!is32BitRGBFormat(image.format()))
+    return image.scaled(width, height, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+  QImage downscaled(width, height, image.format());
+  if (downscaled.isNull())
+    return {};
+
+  constexpr uint32_t LANE_MASK = 0x00ff00ff;
+  constexpr uint32_t ROUNDING  = 0x00020002;
+
+  for (int y = 0; y < height; y++)
+  {
+    auto line0 = reinterpret_cast<const uint32_t *>(image.constScanLine(y * 2));
+    auto line1 = reinterpret_cast<const uint32_t *>(image.constScanLine(y * 2 + 1));
+    auto dst   = reinterpret_cast<uint32_t *>(downscaled.scanLine(y));
+
+    for (int x = 0; x < width; x++)
+    {
+      const auto p0 = line0[x * 2];
+      const auto p1 = line0[x * 2 + 1];
+      const auto p2 = line1[x * 2];
+      const auto p3 = line1[x * 2 + 1];
+
+      const auto sumBR = (p0 & LANE_MASK) + (p1 & LANE_MASK) + (p2 & LANE_MASK) + (p3 & LANE_MASK);
+      const auto sumAG = ((p0 >> 8) & LANE_MASK) + ((p1 >> 8) & LANE_MASK) +
+                         ((p2 >> 8) & LANE_MASK) + ((p3 >> 8) & LANE_MASK);
+
+      dst[x] = (((sumBR + ROUNDING) >> 2) & LANE_MASK) |
+               ((((sumAG + ROUNDING) >> 2) & LANE_MASK) << 8);
+    }
+  }
+
+  return downscaled;
+}
+
+} // namespace
+
+ImagePyramid::ImagePyramid(const QImage &image, bool createDownscaledLevels)
+{
+  this->levels[0] = image;
+  if (!createDownscaledLevels)
+    return;
+
+  for (unsigned level = 1; level <= NR_DOWNSCALED_LEVELS; level++)
+  {
+    const auto &previous = this->levels[level - 1];
+    if (previous.isNull() || previous.width() / 2 < MIN_LEVEL_SIZE ||
+        previous.height() / 2 < MIN_LEVEL_SIZE)
+      break;
+    this->levels[level] = downscaleByTwo(previous);
+  }
+}
+
+const QImage &ImagePyramid::getImageForTargetSize(const QImage  &image,
+                                                  const QSizeF &targetSize) const
+{
+  if (image.isNull() || image.cacheKey() != this->levels[0].cacheKey())
+    return image;
+
+  // The smallest level that is not smaller than the target
+  auto level = 0u;
+  while (level < NR_DOWNSCALED_LEVELS && !this->levels[level + 1].isNull() &&
+         this->levels[level + 1].width() >= targetSize.width() &&
+         this->levels[level + 1].height() >= targetSize.height())
+    level++;
+
+  return this->levels[level];
+}
+
+} // namespace video
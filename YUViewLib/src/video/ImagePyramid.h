@@ -0,0 +1,76 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <QImage>
+
+#include <array>
+
+namespace video
+{
+
+/* A frame image together with downscaled versions of it (1/2, 1/4 and 1/8 of the size). The
+ * levels are created in the loading and caching threads, and only if the frames are drawn at less
+ * than half of their size. When the frame is drawn zoomed out, the smallest level that still has
+ * at least the resolution on screen is drawn. So QPainter does not have to resample the full
+ * resolution image in the GUI thread on every repaint.
+ */
+class ImagePyramid
+{
+public:
+  ImagePyramid() = default;
+  // Create the downscaled levels of the image only if createDownscaledLevels is set
+  ImagePyramid(const QImage &image, bool createDownscaledLevels);
+
+  const QImage &getImage() const { return this->levels[0]; }
+  bool          isNull() const { return this->levels[0].isNull(); }
+
+  // Get the level to draw the given image with the given size (in device pixels). If this is not
+  // the pyramid of the given image (the image changed since the pyramid was created) or it has no
+  // downscaled levels, the image itself is returned. Nothing is created here.
+  const QImage &getImageForTargetSize(const QImage &image, const QSizeF &targetSize) const;
+
+  static constexpr unsigned NR_DOWNSCALED_LEVELS = 3;
+
+  // The levels are only worth creating if the image is drawn at less than this scale
+  static constexpr double MAX_SCALE_FOR_DOWNSCALED_LEVELS = 0.5;
+
+  // Smaller levels are not created. Downscaling small images is not worth it.
+  static constexpr int MIN_LEVEL_SIZE = 256;
+
+private:
+  std::array<QImage, NR_DOWNSCALED_LEVELS + 1> levels;
+};
+
+} // namespace video
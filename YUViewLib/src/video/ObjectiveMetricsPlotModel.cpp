@@ -0,0 +1,314 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "ObjectiveMetricsPlotModel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace video
+{
+
+namespace
+{
+
+bool isPSNR(const ObjectiveMetric metric)
+{
+  return metric != ObjectiveMetric::SSIM && metric != ObjectiveMetric::MSSSIM;
+}
+
+} // namespace
+
+PlotModel::StreamParameter ObjectiveMetricsPlotModel::getStreamParameter(unsigned streamIndex) const
+{
+  if (streamIndex > 0)
+    return {};
+
+  PlotModel::StreamParameter streamParameter;
+  streamParameter.yRange = this->getYRange();
+
+  QMutexLocker locker(&this->dataMutex);
+  if (!this->entries.empty())
+    streamParameter.xRange = {double(this->entries.front().frameIndex),
+                              double(this->entries.back().frameIndex)};
+  streamParameter.plotParameters.append({PlotType::Line, unsigned(this->entries.size())});
+  return streamParameter;
+}
+
+PlotModel::Point ObjectiveMetricsPlotModel::getPlotPoint(unsigned streamIndex,
+                                                         unsigned,
+                                                         unsigned pointIndex) const
+{
+  PlotModel::Point point;
+  {
+    QMutexLocker locker(&this->dataMutex);
+    if (streamIndex > 0 || pointIndex >= this->entries.size())
+      return {};
+
+    const auto &entry = this->entries[pointIndex];
+    point.x           = entry.frameIndex;
+    point.y           = getMetricValue(entry.metrics, this->shownMetric);
+    point.width       = 1.0;
+    point.intra       = false;
+  }
+
+  // Identical frames (infinite PSNR) are drawn at the top of the plot
+  if (std::isinf(point.y))
+    point.y = this->getYRange().max;
+  else if (std::isnan(point.y))
+    point.y = this->getYRange().min;
+  return point;
+}
+
+QString ObjectiveMetricsPlotModel::getPointInfo(unsigned streamIndex,
+                                                unsigned,
+                                                unsigned pointIndex) const
+{
+  QMutexLocker locker(&this->dataMutex);
+  if (streamIndex > 0 || pointIndex >= this->entries.size())
+    return {};
+
+  const auto &entry   = this->entries[pointIndex];
+  const auto &metrics = entry.metrics;
+  return QString("<h4>Frame %1</h4>"
+                 "<table width=\"100%\">"
+                 "<tr><td>PSNR Y:</td><td align=\"right\">%2</td></tr>"
+                 "<tr><td>PSNR U:</td><td align=\"right\">%3</td></tr>"
+                 "<tr><td>PSNR V:</td><td align=\"right\">%4</td></tr>"
+                 "<tr><td>PSNR YUV:</td><td align=\"right\">%5</td></tr>"
+                 "<tr><td>SSIM Y:</td><td align=\"right\">%6</td></tr>"
+                 "<tr><td>MS-SSIM Y:</td><td align=\"right\">%7</td></tr>"
+                 "</table>")
+      .arg(entry.frameIndex)
+      .arg(metrics.psnr[0], 0, 'f', 2)
+      .arg(metrics.psnr[1], 0, 'f', 2)
+      .arg(metrics.psnr[2], 0, 'f', 2)
+      .arg(metrics.weightedPSNR, 0, 'f', 2)
+      .arg(metrics.ssim, 0, 'f', 4)
+      .arg(metrics.msssim, 0, 'f', 4);
+}
+
+std::optional<unsigned>
+ObjectiveMetricsPlotModel::getReasonabelRangeToShowOnXAxisPer100Pixels() const
+{
+  // There is one point per frame. Show 10 frames per 100 pixels.
+  return 10;
+}
+
+QString ObjectiveMetricsPlotModel::formatValue(Axis axis, double value) const
+{
+  if (axis == Axis::X)
+    return QString("%1").arg(value);
+  if (isPSNR(this->shownMetric))
+    return QString("%1 dB").arg(value, 0, 'f', 1);
+  return QString("%1").arg(value, 0, 'f', 3);
+}
+
+Range<double> ObjectiveMetricsPlotModel::getYRange() const
+{
+  QMutexLocker locker(&this->dataMutex);
+
+  const auto valueRange = this->valueRangePerMetric.find(this->shownMetric);
+  if (valueRange == this->valueRangePerMetric.end())
+    return isPSNR(this->shownMetric) ? Range<double>({0.0, 100.0}) : Range<double>({0.0, 1.0});
+
+  const auto [min, max] = valueRange->second;
+
+  // Leave some space above and below the line
+  const auto minimumMargin = isPSNR(this->shownMetric) ? 0.5 : 0.005;
+  const auto margin        = std::max((max - min) * 0.1, minimumMargin);
+  return {min - margin, max + margin};
+}
+
+void ObjectiveMetricsPlotModel::clear()
+{
+  {
+    QMutexLocker locker(&this->dataMutex);
+    this->entries.clear();
+    this->valueRangePerMetric.clear();
+  }
+  this->eventSubsampler.postEvent();
+}
+
+void ObjectiveMetricsPlotModel::addFrameMetrics(int                               frameIndex,
+                                                const yuv::metrics::FrameMetrics &metrics)
+{
+  {
+    QMutexLocker locker(&this->dataMutex);
+
+    // Keep the list sorted. The frames are calculated in parallel so they may arrive in any order.
+    auto insertIterator = std::upper_bound(
+        this->entries.begin(),
+        this->entries.end(),
+        frameIndex,
+        [](const int index, const Entry &entry) { return index < entry.frameIndex; });
+    this->entries.insert(insertIterator, {frameIndex, metrics});
+
+    for (auto metric : ObjectiveMetricMapper.getValues())
+    {
+      const auto value = getMetricValue(metrics, metric);
+      if (!std::isfinite(value))
+        continue;
+      auto range = this->valueRangePerMetric.find(metric);
+      if (range == this->valueRangePerMetric.end())
+        this->valueRangePerMetric[metric] = {value, value};
+      else
+      {
+        range->second.min = std::min(range->second.min, value);
+        range->second.max = std::max(range->second.max, value);
+      }
+    }
+  }
+
+  // The models are updated from a background thread. The event subsampler lives in the main thread.
+  QMetaObject::invokeMethod(&this->eventSubsampler, "postEvent", Qt::QueuedConnection);
+}
+
+void ObjectiveMetricsPlotModel::setShownMetric(ObjectiveMetric metric)
+{
+  if (this->shownMetric == metric)
+    return;
+  this->shownMetric = metric;
+  this->eventSubsampler.postEvent();
+}
+
+unsigned ObjectiveMetricsPlotModel::getNrFrames() const
+{
+  QMutexLocker locker(&this->dataMutex);
+  return unsigned(this->entries.size());
+}
+
+std::optional<yuv::metrics::FrameMetrics> ObjectiveMetricsPlotModel::getMeanMetrics() const
+{
+  QMutexLocker locker(&this->dataMutex);
+  if (this->entries.empty())
+    return {};
+
+  yuv::metrics::FrameMetrics mean;
+  for (auto metric : ObjectiveMetricMapper.getValues())
+  {
+    double   sum     = 0.0;
+    unsigned nrValid = 0;
+    for (const auto &entry : this->entries)
+    {
+      const auto value = getMetricValue(entry.metrics, metric);
+      if (std::isfinite(value))
+      {
+        sum += value;
+        nrValid++;
+      }
+    }
+
+    auto meanValue = (nrValid > 0) ? sum / nrValid : std::numeric_limits<double>::infinity();
+    if (!isPSNR(metric) && nrValid == 0)
+      meanValue = std::numeric_limits<double>::quiet_NaN();
+
+    switch (metric)
+    {
+    case ObjectiveMetric::PSNRY:
+      mean.psnr[0] = meanValue;
+      break;
+    case ObjectiveMetric::PSNRU:
+      mean.psnr[1] = meanValue;
+      break;
+    case ObjectiveMetric::PSNRV:
+      mean.psnr[2] = meanValue;
+      break;
+    case ObjectiveMetric::WeightedPSNR:
+      mean.weightedPSNR = meanValue;
+      break;
+    case ObjectiveMetric::SSIM:
+      mean.ssim = meanValue;
+      break;
+    case ObjectiveMetric::MSSSIM:
+      mean.msssim = meanValue;
+      break;
+    }
+  }
+
+  for (unsigned c = 0; c < 3; c++)
+  {
+    double sum = 0.0;
+    for (const auto &entry : this->entries)
+      sum += entry.metrics.mse[c];
+    mean.mse[c] = sum / double(this->entries.size());
+  }
+  return mean;
+}
+
+std::string ObjectiveMetricsPlotModel::getCSV() const
+{
+  std::ostringstream stream;
+  stream << "Frame,MSE Y,MSE U,MSE V,PSNR Y,PSNR U,PSNR V,PSNR YUV,SSIM Y,MS-SSIM Y\n";
+
+  QMutexLocker locker(&this->dataMutex);
+  stream << std::fixed;
+  for (const auto &entry : this->entries)
+  {
+    const auto &metrics = entry.metrics;
+    stream << entry.frameIndex << std::setprecision(4);
+    for (const auto mse : metrics.mse)
+      stream << "," << mse;
+    for (const auto psnr : metrics.psnr)
+      stream << "," << psnr;
+    stream << "," << metrics.weightedPSNR << std::setprecision(6) << "," << metrics.ssim << ","
+           << metrics.msssim << "\n";
+  }
+  return stream.str();
+}
+
+double ObjectiveMetricsPlotModel::getMetricValue(const yuv::metrics::FrameMetrics &metrics,
+                                                 ObjectiveMetric                   metric)
+{
+  switch (metric)
+  {
+  case ObjectiveMetric::PSNRY:
+    return metrics.psnr[0];
+  case ObjectiveMetric::PSNRU:
+    return metrics.psnr[1];
+  case ObjectiveMetric::PSNRV:
+    return metrics.psnr[2];
+  case ObjectiveMetric::WeightedPSNR:
+    return metrics.weightedPSNR;
+  case ObjectiveMetric::SSIM:
+    return metrics.ssim;
+  case ObjectiveMetric::MSSSIM:
+    return metrics.msssim;
+  }
+  return 0.0;
+}
+
+} // namespace video
@@ -0,0 +1,118 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <common/EnumMapper.h>
+#include <ui/views/PlotModel.h>
+#include <video/yuv/ObjectiveMetrics.h>
+
+#include <QMutex>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace video
+{
+
+enum class ObjectiveMetric
+{
+  PSNRY,
+  PSNRU,
+  PSNRV,
+  WeightedPSNR,
+  SSIM,
+  MSSSIM
+};
+
+constexpr EnumMapper<ObjectiveMetric, 6>
+    ObjectiveMetricMapper(std::make_pair(ObjectiveMetric::PSNRY, "PSNR Y"sv),
+                          std::make_pair(ObjectiveMetric::PSNRU, "PSNR U"sv),
+                          std::make_pair(ObjectiveMetric::PSNRV, "PSNR V"sv),
+                          std::make_pair(ObjectiveMetric::WeightedPSNR, "PSNR YUV (6:1:1)"sv),
+                          std::make_pair(ObjectiveMetric::SSIM, "SSIM Y"sv),
+                          std::make_pair(ObjectiveMetric::MSSSIM, "MS-SSIM Y"sv));
+
+// The objective metrics of all frames of a difference item. The frames can be added in any order
+// from multiple threads. One of the metrics is shown as a line over the frame index.
+class ObjectiveMetricsPlotModel : public PlotModel
+{
+public:
+  ObjectiveMetricsPlotModel()          = default;
+  virtual ~ObjectiveMetricsPlotModel() = default;
+
+  unsigned                   getNrStreams() const override { return 1; }
+  PlotModel::StreamParameter getStreamParameter(unsigned streamIndex) const override;
+  PlotModel::Point
+  getPlotPoint(unsigned streamIndex, unsigned plotIndex, unsigned pointIndex) const override;
+  QString getPointInfo(unsigned streamIndex,
+                       unsigned plotIndex,
+                       unsigned pointIndex) const override;
+  std::optional<unsigned> getReasonabelRangeToShowOnXAxisPer100Pixels() const override;
+  QString                 formatValue(Axis axis, double value) const override;
+  Range<double>           getYRange() const override;
+
+  void clear();
+  void addFrameMetrics(int frameIndex, const yuv::metrics::FrameMetrics &metrics);
+
+  void            setShownMetric(ObjectiveMetric metric);
+  ObjectiveMetric getShownMetric() const { return this->shownMetric; }
+
+  unsigned getNrFrames() const;
+
+  // The mean of every metric over all frames. Identical frames (infinite PSNR) are not included in
+  // the mean PSNR.
+  std::optional<yuv::metrics::FrameMetrics> getMeanMetrics() const;
+
+  // All frames as comma separated values with a header line
+  std::string getCSV() const;
+
+private:
+  struct Entry
+  {
+    int                        frameIndex{};
+    yuv::metrics::FrameMetrics metrics;
+  };
+
+  static double getMetricValue(const yuv::metrics::FrameMetrics &metrics, ObjectiveMetric metric);
+
+  // Sorted by the frame index
+  std::vector<Entry>                       entries;
+  std::map<ObjectiveMetric, Range<double>> valueRangePerMetric;
+  mutable QMutex                           dataMutex;
+
+  ObjectiveMetric shownMetric{ObjectiveMetric::PSNRY};
+};
+
+} // namespace video
@@ -0,0 +1,146 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RawFrameView.h"
+
+#include "FrameBufferPool.h"
+
+#include <cstring>
+
+namespace video
+{
+
+RawFrameView::RawFrameView(const QByteArray &packedData) : packedData(packedData)
+{
+}
+
+RawFrameView::RawFrameView(const std::vector<Plane> &planes,
+                           std::shared_ptr<const void> lifetimeHandle)
+    : planes(planes), lifetimeHandle(std::move(lifetimeHandle))
+{
+}
+
+RawFrameView::RawFrameView(const unsigned char        *data,
+                           size_t                      nrBytes,
+                           std::shared_ptr<const void> lifetimeHandle)
+    : planes({{data, nrBytes, nrBytes, 1}}), lifetimeHandle(std::move(lifetimeHandle))
+{
+}
+
+bool RawFrameView::isEmpty() const
+{
+  return this->packedData.isEmpty() && this->getNrBytes() == 0;
+}
+
+size_t RawFrameView::getNrBytes() const
+{
+  if (this->isPacked())
+    return size_t(this->packedData.size());
+
+  size_t nrBytes = 0;
+  for (const auto &plane : this->planes)
+    nrBytes += plane.widthInBytes * plane.height;
+  return nrBytes;
+}
+
+bool RawFrameView::isContiguous() const
+{
+  if (this->isPacked())
+    return true;
+  if (this->planes.empty())
+    return false;
+
+  for (size_t i = 0; i < this->planes.size(); i++)
+  {
+    const auto &plane = this->planes[i];
+    if (plane.stride != plane.widthInBytes)
+      return false;
+    if (i > 0)
+    {
+      const auto &previous = this->planes[i - 1];
+      if (previous.data + previous.widthInBytes * previous.height != plane.data)
+        return false;
+    }
+  }
+  return true;
+}
+
+QByteArray RawFrameView::toPackedData() const
+{
+  if (this->isPacked() || this->planes.empty())
+    return this->packedData;
+
+  QByteArray packed;
+  packed.resize(int(this->getNrBytes()));
+  this->packPlanes((unsigned char *)packed.data());
+  return packed;
+}
+
+QByteArray RawFrameView::getContiguousData() const
+{
+  if (this->isPacked() || !this->isContiguous())
+    return this->toPackedData();
+  return QByteArray::fromRawData((const char *)this->planes.front().data,
+                                 int(this->getNrBytes()));
+}
+
+RawFrameView RawFrameView::toOwned() const
+{
+  if (!this->isBorrowed())
+    return *this;
+
+  const auto nrBytes = this->getNrBytes();
+  auto       buffer  = FrameBufferPool::shared().allocate(nrBytes);
+  this->packPlanes(buffer.get());
+  return RawFrameView(buffer.get(), nrBytes, buffer);
+}
+
+void RawFrameView::packPlanes(unsigned char *dst) const
+{
+  for (const auto &plane : this->planes)
+  {
+    if (plane.stride == plane.widthInBytes)
+    {
+      // No padding. Copy the whole plane at once.
+      std::memcpy(dst, plane.data, plane.widthInBytes * plane.height);
+      dst += plane.widthInBytes * plane.height;
+      continue;
+    }
+    for (unsigned y = 0; y < plane.height; y++)
+    {
+      std::memcpy(dst, plane.data + y * plane.stride, plane.widthInBytes);
+      dst += plane.widthInBytes;
+    }
+  }
+}
+
+} // namespace video
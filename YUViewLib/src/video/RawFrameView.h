@@ -0,0 +1,107 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace video
+{
+
+/* A view onto the planes of one raw (YUV or RGB) frame. The frame is either packed into one
+ * QByteArray (the planes one after the other without padding, like a frame from a raw file) or the
+ * planes can be anywhere in memory with padding at the end of each line (like the picture buffers
+ * of a decoder). In the latter case, a lifetime handle keeps the memory of the planes alive for as
+ * long as the view (or a copy of it) exists. A view without such a handle is borrowed. It is only
+ * valid until the source of the frame reuses the memory (e.g. with the next call to the decoder).
+ */
+class RawFrameView
+{
+public:
+  struct Plane
+  {
+    const unsigned char *data{};
+    // The distance in bytes from the start of one line to the start of the next line
+    size_t   stride{};
+    size_t   widthInBytes{};
+    unsigned height{};
+  };
+
+  RawFrameView() = default;
+  // A view onto a packed frame. Only a shallow copy of the array is made.
+  explicit RawFrameView(const QByteArray &packedData);
+  // A view onto the given planes. The planes must be in the order of the pixel format (as they
+  // would be in a packed frame). If no lifetimeHandle is given, the view is borrowed.
+  RawFrameView(const std::vector<Plane> &planes, std::shared_ptr<const void> lifetimeHandle = {});
+  // A view onto a packed frame in the given buffer (e.g. from the FrameBufferPool)
+  RawFrameView(const unsigned char        *data,
+               size_t                      nrBytes,
+               std::shared_ptr<const void> lifetimeHandle);
+
+  bool isEmpty() const;
+  bool isPacked() const { return !this->packedData.isEmpty(); }
+  bool isBorrowed() const { return !this->planes.empty() && !this->lifetimeHandle; }
+  // Are all planes one after the other in memory without padding (like in a packed frame)?
+  bool isContiguous() const;
+
+  // The planes of a view that is not packed
+  const std::vector<Plane> &getPlanes() const { return this->planes; }
+
+  // The number of bytes of the frame without any padding
+  size_t getNrBytes() const;
+
+  // Get the frame with all planes packed one after the other without padding. The data is only
+  // copied if the view is not packed already.
+  QByteArray toPackedData() const;
+
+  // Like toPackedData, but if the planes are contiguous, the data is not copied. Then the returned
+  // array does not own the data. It must not be used after this view (and all copies of it) are
+  // destroyed.
+  QByteArray getContiguousData() const;
+
+  // Get a view that stays valid no matter what the source of the frame does. Only a borrowed view
+  // has to be copied for this (into a buffer from the FrameBufferPool).
+  RawFrameView toOwned() const;
+
+private:
+  void packPlanes(unsigned char *dst) const;
+
+  QByteArray                  packedData;
+  std::vector<Plane>          planes;
+  std::shared_ptr<const void> lifetimeHandle;
+};
+
+} // namespace video
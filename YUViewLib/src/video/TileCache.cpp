@@ -0,0 +1,170 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "TileCache.h"
+
+#include <QPainter>
+
+#include <vector>
+
+namespace video
+{
+
+namespace
+{
+
+int64_t getImageSizeInBytes(const QImage &image)
+{
+  return int64_t(image.bytesPerLine()) * image.height();
+}
+
+} // namespace
+
+QRect TileCache::getTileRange(const QRect &region)
+{
+  if (region.isEmpty())
+    return {};
+  return QRect(QPoint(region.left() / TILE_SIZE, region.top() / TILE_SIZE),
+               QPoint(region.right() / TILE_SIZE, region.bottom() / TILE_SIZE));
+}
+
+QRect TileCache::getTileRangeRect(const QRect &tileRange, const Size frameSize)
+{
+  const auto rect = QRect(tileRange.left() * TILE_SIZE,
+                          tileRange.top() * TILE_SIZE,
+                          tileRange.width() * TILE_SIZE,
+                          tileRange.height() * TILE_SIZE);
+  return rect & QRect(0, 0, int(frameSize.width), int(frameSize.height));
+}
+
+QRect TileCache::getMissingTiles(int frameIndex, const QRect &tileRange) const
+{
+  QMutexLocker lock(&this->mutex);
+  QRect        missingTiles;
+  for (int y = tileRange.top(); y <= tileRange.bottom(); y++)
+    for (int x = tileRange.left(); x <= tileRange.right(); x++)
+      if (this->tiles.count({frameIndex, x, y}) == 0)
+        missingTiles |= QRect(x, y, 1, 1);
+  return missingTiles;
+}
+
+bool TileCache::containsAllTiles(int frameIndex, const QRect &tileRange) const
+{
+  return this->getMissingTiles(frameIndex, tileRange).isEmpty();
+}
+
+void TileCache::insertTiles(int           frameIndex,
+                            const QRect  &tileRange,
+                            const Size    frameSize,
+                            const QImage &image,
+                            const QRect  &imageRect)
+{
+  if (image.isNull())
+    return;
+
+  // Copy the tiles out of the image before locking the cache
+  std::vector<std::pair<TileKey, QImage>> newTiles;
+  for (int y = tileRange.top(); y <= tileRange.bottom(); y++)
+    for (int x = tileRange.left(); x <= tileRange.right(); x++)
+    {
+      const auto tileRect = getTileRangeRect(QRect(x, y, 1, 1), frameSize);
+      if (tileRect.isEmpty() || !imageRect.contains(tileRect))
+        continue;
+      newTiles.push_back(
+          {TileKey({frameIndex, x, y}), image.copy(tileRect.translated(-imageRect.topLeft()))});
+    }
+
+  QMutexLocker lock(&this->mutex);
+  for (auto &newTile : newTiles)
+  {
+    auto &tile = this->tiles[newTile.first];
+    this->sizeInBytes -= getImageSizeInBytes(tile.image);
+    tile.image    = std::move(newTile.second);
+    tile.lastUsed = ++this->useCounter;
+    this->sizeInBytes += getImageSizeInBytes(tile.image);
+  }
+  this->removeLeastRecentlyUsedTiles();
+}
+
+void TileCache::drawTiles(QPainter    *painter,
+                          int          frameIndex,
+                          const QRect &tileRange,
+                          const Size   frameSize,
+                          const QRect &videoRect,
+                          double       zoomFactor) const
+{
+  QMutexLocker lock(&this->mutex);
+  for (int y = tileRange.top(); y <= tileRange.bottom(); y++)
+    for (int x = tileRange.left(); x <= tileRange.right(); x++)
+    {
+      auto it = this->tiles.find({frameIndex, x, y});
+      if (it == this->tiles.end())
+        continue;
+      it->second.lastUsed = ++this->useCounter;
+
+      const auto tileRect   = getTileRangeRect(QRect(x, y, 1, 1), frameSize);
+      const auto targetRect = QRectF(QPointF(videoRect.topLeft()) +
+                                         QPointF(tileRect.topLeft()) * zoomFactor,
+                                     QSizeF(tileRect.size()) * zoomFactor);
+      painter->drawImage(targetRect, it->second.image);
+    }
+}
+
+void TileCache::clear()
+{
+  QMutexLocker lock(&this->mutex);
+  this->tiles.clear();
+  this->sizeInBytes = 0;
+}
+
+int64_t TileCache::getSizeInBytes() const
+{
+  QMutexLocker lock(&this->mutex);
+  return this->sizeInBytes;
+}
+
+void TileCache::removeLeastRecentlyUsedTiles()
+{
+  while (this->sizeInBytes > MAX_SIZE_IN_BYTES && !this->tiles.empty())
+  {
+    auto leastRecentlyUsed = this->tiles.begin();
+    for (auto it = this->tiles.begin(); it != this->tiles.end(); it++)
+      if (it->second.lastUsed < leastRecentlyUsed->second.lastUsed)
+        leastRecentlyUsed = it;
+
+    this->sizeInBytes -= getImageSizeInBytes(leastRecentlyUsed->second.image);
+    this->tiles.erase(leastRecentlyUsed);
+  }
+}
+
+} // namespace video
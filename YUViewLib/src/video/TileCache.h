@@ -0,0 +1,126 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <common/Typedef.h>
+
+#include <QImage>
+#include <QMutex>
+#include <QPoint>
+#include <QRect>
+
+#include <cstdint>
+#include <map>
+#include <tuple>
+
+class QPainter;
+
+namespace video
+{
+
+/* Converted tiles of frames for drawing very large frames when only a small part of them is
+ * visible. Instead of the full frame, only the visible tiles are loaded and converted. The tiles
+ * are kept until the cache is full. Then the least recently used tiles are removed. All functions
+ * are thread-safe.
+ */
+class TileCache
+{
+public:
+  TileCache() = default;
+
+  static constexpr int TILE_SIZE = 256;
+
+  // Get the range of tiles (in tile coordinates) that cover the given region of the frame
+  static QRect getTileRange(const QRect &region);
+  // Get the area of the frame that is covered by the tiles in the given range (clipped to the
+  // frame)
+  static QRect getTileRangeRect(const QRect &tileRange, const Size frameSize);
+
+  // Get the range of all tiles in tileRange that are not in the cache. An empty range is returned
+  // if all tiles are in the cache.
+  QRect getMissingTiles(int frameIndex, const QRect &tileRange) const;
+  bool  containsAllTiles(int frameIndex, const QRect &tileRange) const;
+
+  // Insert the tiles of the given range. The image covers the region given by imageRect (in frame
+  // coordinates) which must contain all of the tiles.
+  void insertTiles(int           frameIndex,
+                   const QRect  &tileRange,
+                   const Size    frameSize,
+                   const QImage &image,
+                   const QRect  &imageRect);
+
+  // Draw all tiles of the frame in the given range that are in the cache. The frame is drawn in
+  // videoRect (which is the frame scaled with the zoom factor).
+  void drawTiles(QPainter    *painter,
+                 int          frameIndex,
+                 const QRect &tileRange,
+                 const Size   frameSize,
+                 const QRect &videoRect,
+                 double       zoomFactor) const;
+
+  void    clear();
+  int64_t getSizeInBytes() const;
+
+  // Use at most this much memory for the tiles
+  static constexpr int64_t MAX_SIZE_IN_BYTES = int64_t(256) * 1024 * 1024;
+
+private:
+  struct TileKey
+  {
+    int frameIndex{};
+    int x{};
+    int y{};
+
+    bool operator<(const TileKey &other) const
+    {
+      return std::tie(this->frameIndex, this->y, this->x) <
+             std::tie(other.frameIndex, other.y, other.x);
+    }
+  };
+
+  struct Tile
+  {
+    QImage   image;
+    uint64_t lastUsed{};
+  };
+
+  void removeLeastRecentlyUsedTiles();
+
+  mutable QMutex                  mutex;
+  mutable std::map<TileKey, Tile> tiles;
+  mutable uint64_t                useCounter{};
+  int64_t                         sizeInBytes{};
+};
+
+} // namespace video
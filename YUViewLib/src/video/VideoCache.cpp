@@ -32,6 +32,7 @@
 
 #include "VideoCache.h"
 
+#include <QJsonArray>
 #include <QMessageBox>
 #include <QPainter>
 #include <QScrollArea>
@@ -42,6 +43,7 @@
 #include <common/Functions.h>
 #include <playlistitem/playlistItem.h>
 #include <ui/PlaybackController.h>
+#include <video/FrameBufferPool.h>
 
 namespace video
 {
@@ -169,6 +171,8 @@ void loadingWorker::processLoadingJobInternal(bool playing, bool loadRawData)
 
   // Load the frame of the item that was given to us.
   // This is performed in the thread (the loading thread with higher priority.
+  if (auto statistics = currentCacheItem->getCacheStatistics())
+    statistics->recordInteractiveLoad();
   currentCacheItem->loadFrame(currentFrame, playing, loadRawData);
 
   currentCacheItem = nullptr;
@@ -264,6 +268,10 @@ VideoCache::VideoCache(PlaylistTreeWidget *playlistTreeWidget,
           &PlaybackController::signalPlaybackStarting,
           this,
           &VideoCache::updateCacheQueue);
+  connect(playback.data(),
+          &PlaybackController::signalCurrentFrameChanged,
+          this,
+          &VideoCache::currentFrameChanged);
   connect(&statusUpdateTimer, &QTimer::timeout, this, [=] { emit updateCacheStatus(); });
   connect(&testProgrssUpdateTimer, &QTimer::timeout, this, [=] { updateTestProgress(); });
 }
@@ -333,6 +341,11 @@ void VideoCache::updateSettings()
   cachingEnabled = settings.value("Enabled", true).toBool();
   cacheLevelMax  = (int64_t)settings.value("ThresholdValueMB", 49).toUInt() * 1000 * 1000;
 
+  // Frames that are evicted from the cache give their buffers back to the pool. Keep enough of
+  // them to refill a quarter of the cache without allocating, but not more than the default.
+  FrameBufferPool::shared().setMaxFreeBytes(
+      std::min(cacheLevelMax / 4, FrameBufferPool::DEFAULT_MAX_FREE_BYTES));
+
   // See if the user changed the number of threads
   int targetNrThreads = functions::getOptimalThreadCount();
   if (settings.value("SetNrThreads", false).toBool())
@@ -526,6 +539,7 @@ void VideoCache::updateCacheQueue()
   // Firstly clear the old cache queues
   cacheQueue.clear();
   cacheDeQueue.clear();
+  this->plannedFrame = -1;
 
   // Get all items from the playlist. There are two lists. For the caching status (how full is the
   // cache) we have to consider all items in the playlist. However, we only cache top level items
@@ -645,6 +659,8 @@ void VideoCache::updateCacheQueue()
     // "deleting" mode where all frames of all items are removed. This is done for all items in the
     // playlist.
     bool adding = true;
+    // The frames of the current item that can be removed. These are removed last.
+    QList<plItemFrame> selectedItemDeQueue;
     do
     {
       if (allItems[i]->properties().isIndexedByFrame())
@@ -659,9 +675,21 @@ void VideoCache::updateCacheQueue()
           if (newCacheLevel + itemCacheSize <= cacheLevelMax)
           {
             // All frames of the item fit and there is even more space. We remain in "adding" mode.
-            enqueueCacheJob(allItems[i], itemRange);
+            if (i == itemPos)
+              this->enqueuePrefetchJobs(allItems[i], itemRange.second - itemRange.first + 1);
+            else
+              enqueueCacheJob(allItems[i], itemRange);
             newCacheLevel += itemCacheSize;
           }
+          else if (i == itemPos)
+          {
+            // Not all frames of the current item fit. Cache the frames ahead of the current frame
+            // and remove the other frames (the ones that were played already first).
+            int64_t nrFramesCachable = cacheLevelMax / allItems[i]->getCachingFrameSize();
+            selectedItemDeQueue      = this->enqueuePrefetchJobs(allItems[i], nrFramesCachable);
+            newCacheLevel += nrFramesCachable * allItems[i]->getCachingFrameSize();
+            adding = false;
+          }
           else
           {
             // Not all frames fit. Enqueue the ones that fit and set the ones that don't as "can be
@@ -702,6 +730,7 @@ void VideoCache::updateCacheQueue()
     // Done. However, the list of frames that can be deleted is sorted the wrong way around. Reverse
     // it.
     std::reverse(cacheDeQueue.begin(), cacheDeQueue.end());
+    cacheDeQueue.append(selectedItemDeQueue);
   }
   else // playback is not running
   {
@@ -723,11 +752,10 @@ void VideoCache::updateCacheQueue()
         }
       }
 
-      // Adjust the range so that only the number of frames are cached that will fit
+      // Only cache as many frames around the current frame as will fit. The other frames of the
+      // item can be removed after the frames of all other items.
       int64_t nrFramesCachable = cacheLevelMax / selection[0]->getCachingFrameSize();
-      range.second             = range.first + nrFramesCachable - 1;
-
-      enqueueCacheJob(selection[0], range);
+      cacheDeQueue.append(this->enqueuePrefetchJobs(selection[0], nrFramesCachable));
     }
     else if (selection[0]->isCachable() &&
              additionalItemSpaceNeeded > (cacheLevelMax - cacheLevel) &&
@@ -833,7 +861,7 @@ void VideoCache::updateCacheQueue()
 
       // Enqueue the job. This is the only job.
       // We will not delete any frames from any other items to cache frames from other items.
-      enqueueCacheJob(selection[0], range);
+      this->enqueuePrefetchJobs(selection[0], range.second - range.first + 1);
     }
     else
     {
@@ -845,7 +873,7 @@ void VideoCache::updateCacheQueue()
         // items. In case of playback, we will continue with the next items and delete all frames
         // that were already played out. Otherwise, we don't delete any frames from the cache but we
         // will cache as many items as possible.
-        enqueueCacheJob(selection[0], range);
+        this->enqueuePrefetchJobs(selection[0], range.second - range.first + 1);
         cacheLevel = cacheLevel + additionalItemSpaceNeeded;
       }
 
@@ -957,13 +985,91 @@ void VideoCache::updateCacheQueue()
 
 void VideoCache::enqueueCacheJob(playlistItem *item, indexRange range)
 {
-  // Only schedule frames for caching that were not yet cached.
+  // Split the range into the segments that the item can cache independently. Only schedule frames
+  // for caching that were not yet cached.
+  const auto cachedFrames = item->getCachedFrames();
+  const auto segments =
+      prefetch::getCachingSegments(range.first,
+                                   range.second,
+                                   item->getCachingSegmentStarts(),
+                                   std::vector<int>(cachedFrames.begin(), cachedFrames.end()));
+  for (const auto &segment : segments)
+    cacheQueue.append(cacheJob(item, indexRange(segment.start, segment.end)));
+}
+
+void VideoCache::enqueueCacheJob(playlistItem *item, const prefetch::PrefetchWindow &window)
+{
+  if (window.step == 1)
+  {
+    enqueueCacheJob(item, indexRange(window.start, window.end));
+    return;
+  }
+
+  // Skip the frames at the start of the window that are already cached
   QList<int> cachedFrames = item->getCachedFrames();
-  int        i            = range.first;
-  while (cachedFrames.contains(i) && i < range.second)
-    range.first = ++i;
-  if (range.first != range.second)
-    cacheQueue.append(cacheJob(item, range));
+  int        start        = window.start;
+  while (cachedFrames.contains(start) && start != window.end)
+    start += window.step;
+  if (!cachedFrames.contains(start))
+    cacheQueue.append(cacheJob(item, indexRange(start, window.end), window.step));
+}
+
+QList<VideoCache::plItemFrame> VideoCache::enqueuePrefetchJobs(playlistItem *item,
+                                                               int64_t       nrFramesCachable)
+{
+  const auto range        = item->properties().startEndRange;
+  const auto currentFrame = playback->getCurrentFrame();
+  const auto motion       = playback->getFrameMotion();
+  // Frames of items with a limited number of caching threads (e.g. decoders) must be cached in
+  // order
+  const auto randomAccess = item->cachingThreadLimit() == -1;
+
+  const auto windows = prefetch::getPrefetchWindows(
+      currentFrame, range.first, range.second, motion, nrFramesCachable, randomAccess);
+  for (const auto &window : windows)
+    enqueueCacheJob(item, window);
+
+  // If the user moves differently, the queue has to be updated
+  const auto rangeSize = int64_t(range.second) - range.first + 1;
+  this->plannedFrame   = currentFrame;
+  this->plannedMotion  = motion;
+  this->replanDistance =
+      (nrFramesCachable >= rangeSize) ? 0 : std::max(nrFramesCachable / 4, int64_t(1));
+
+  std::vector<int> framesNotNeeded;
+  for (const auto frame : item->getCachedFrames())
+    if (std::none_of(windows.begin(), windows.end(), [frame](const prefetch::PrefetchWindow &w) {
+          return w.contains(frame);
+        }))
+      framesNotNeeded.push_back(frame);
+
+  QList<plItemFrame> deQueue;
+  for (const auto frame : prefetch::getEvictionOrder(framesNotNeeded, currentFrame, motion))
+    deQueue.append(plItemFrame(item, frame));
+
+  DEBUG_CACHING("VideoCache::enqueuePrefetchJobs %d windows around frame %d direction %d",
+                int(windows.size()),
+                currentFrame,
+                motion.direction);
+  return deQueue;
+}
+
+void VideoCache::currentFrameChanged(int frameIndex)
+{
+  if (this->plannedFrame == -1)
+    return;
+
+  const auto motion           = playback->getFrameMotion();
+  const auto directionChanged = motion.direction != this->plannedMotion.direction ||
+                                motion.alternatePosition != this->plannedMotion.alternatePosition;
+  const auto movedAway = this->replanDistance > 0 &&
+                         std::abs(int64_t(frameIndex) - this->plannedFrame) >= this->replanDistance;
+
+  if ((directionChanged && (this->replanDistance > 0 || !cacheQueue.isEmpty())) || movedAway)
+  {
+    DEBUG_CACHING("VideoCache::currentFrameChanged %d - update the cache queue", frameIndex);
+    scheduleCachingListUpdate();
+  }
 }
 
 void VideoCache::startCaching()
@@ -1294,12 +1400,19 @@ bool VideoCache::pushNextJobToCachingThread(loadingThread *thread)
       int threadLimit = job.plItem->cachingThreadLimit();
       if (threadLimit != -1)
       {
-        // How many threads are currently caching the given item?
-        int nrThreadsForItem = 0;
+        // How many threads are currently caching the given item? Is one of them caching the
+        // previous frame of this job? The frames of one job must be cached in order, so in this
+        // case we try the next job.
+        int  nrThreadsForItem     = 0;
+        bool previousFrameRunning = false;
         for (loadingThread *t : cachingThreadList)
           if (t->worker()->isWorking() && t->worker()->getCacheItem() == job.plItem)
+          {
             nrThreadsForItem++;
-        if (nrThreadsForItem >= threadLimit)
+            if (t->worker()->getCacheFrame() == job.frameRange.first - job.frameStep)
+              previousFrameRunning = true;
+          }
+        if (nrThreadsForItem >= threadLimit || previousFrameRunning)
           // Go to the next item. We can not add another thread to this one.
           continue;
       }
@@ -1313,7 +1426,7 @@ bool VideoCache::pushNextJobToCachingThread(loadingThread *thread)
         j.remove();
       else
         // Update the frame range of the head item in the cache queue
-        job.frameRange.first = range.first + 1;
+        job.frameRange.first = range.first + job.frameStep;
 
       break;
     }
@@ -1503,9 +1616,106 @@ QStringList VideoCache::getCacheStatusText()
   txt.append("Caching:");
   for (loadingThread *t : cachingThreadList)
     txt.append(t->worker()->getStatus());
+
+  const auto itemStatistics = this->getCacheStatistics();
+  if (!itemStatistics.empty())
+    txt.append("Items:");
+  for (const auto &item : itemStatistics)
+  {
+    const auto &statistics = item.statistics;
+    txt.append(QString("%1: %2% hits, %3 misses, %4 evicted, %5 MB")
+                   .arg(item.name)
+                   .arg(statistics.getHitRate() * 100, 0, 'f', 1)
+                   .arg(statistics.drawMisses)
+                   .arg(statistics.evictions)
+                   .arg(statistics.bytesResident / 1000000));
+    QStringList latencies;
+    for (const auto stage : LoadingStageMapper.getValues())
+    {
+      const auto &latency = statistics.getLatency(stage);
+      const auto  name    = LoadingStageMapper.getName(stage);
+      if (latency.getCount() > 0)
+        latencies.append(QString("%1 %2/%3 ms")
+                             .arg(QString::fromUtf8(name.data(), int(name.size())))
+                             .arg(latency.getMean().count() / 1000.0, 0, 'f', 1)
+                             .arg(latency.getPercentile(95).count() / 1000.0, 0, 'f', 1));
+    }
+    if (!latencies.isEmpty())
+      txt.append("  " + latencies.join(", ") + " (mean/p95)");
+  }
+
+  const auto poolStatistics = FrameBufferPool::shared().getStatistics();
+  const auto reuseRate      = poolStatistics.nrAllocations == 0
+                                  ? 0.0
+                                  : double(poolStatistics.nrReused) / poolStatistics.nrAllocations;
+  txt.append("Frame buffers:");
+  txt.append(QString("%1 MB resident (%2 MB in use, %3 MB free), %4% reused")
+                 .arg(poolStatistics.getBytesResident() / 1000000)
+                 .arg(poolStatistics.bytesInUse / 1000000)
+                 .arg(poolStatistics.bytesFree / 1000000)
+                 .arg(reuseRate * 100, 0, 'f', 1));
   return txt;
 }
 
+std::vector<VideoCache::ItemStatistics> VideoCache::getCacheStatistics() const
+{
+  std::vector<ItemStatistics> itemStatistics;
+  if (playlist.isNull())
+    return itemStatistics;
+
+  for (auto item : playlist->getAllPlaylistItems())
+  {
+    const auto statistics = item->getCacheStatistics();
+    if (statistics == nullptr)
+      continue;
+
+    ItemStatistics itemStatistic;
+    itemStatistic.name       = item->properties().name;
+    itemStatistic.statistics = statistics->getStatistics();
+    itemStatistic.statistics.bytesResident =
+        int64_t(item->getNumberCachedFrames()) * item->getCachingFrameSize();
+    itemStatistics.push_back(itemStatistic);
+  }
+  return itemStatistics;
+}
+
+QJsonObject VideoCache::getCacheStatisticsJson() const
+{
+  QJsonArray itemArray;
+  for (const auto &item : this->getCacheStatistics())
+  {
+    auto itemJson    = item.statistics.toJson();
+    itemJson["name"] = item.name;
+    itemArray.append(itemJson);
+  }
+
+  const auto  poolStatistics = FrameBufferPool::shared().getStatistics();
+  QJsonObject poolJson;
+  poolJson["bytesInUse"]    = qint64(poolStatistics.bytesInUse);
+  poolJson["bytesFree"]     = qint64(poolStatistics.bytesFree);
+  poolJson["nrAllocations"] = qint64(poolStatistics.nrAllocations);
+  poolJson["nrReused"]      = qint64(poolStatistics.nrReused);
+
+  QJsonObject json;
+  json["cachingEnabled"]     = cachingEnabled;
+  json["cacheLevelMaxBytes"] = qint64(cacheLevelMax);
+  json["cacheLevelBytes"]    = qint64(cacheLevelCurrent);
+  json["nrCachingThreads"]   = cachingThreadList.count();
+  json["nrThreadsPlayback"]  = nrThreadsPlayback;
+  json["items"]              = itemArray;
+  json["frameBufferPool"]    = poolJson;
+  return json;
+}
+
+void VideoCache::resetCacheStatistics()
+{
+  if (playlist.isNull())
+    return;
+  for (auto item : playlist->getAllPlaylistItems())
+    if (auto statistics = item->getCacheStatistics())
+      statistics->reset();
+}
+
 void VideoCache::updateTestProgress()
 {
   if (testProgressDialog.isNull())
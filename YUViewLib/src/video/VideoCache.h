@@ -42,6 +42,8 @@
 #include <QWidget>
 
 #include "ui/widgets/PlaylistTreeWidget.h"
+#include "video/CacheStatistics.h"
+#include "video/FramePrefetch.h"
 
 namespace video
 {
@@ -74,6 +76,18 @@ public:
 
   QStringList getCacheStatusText();
 
+  // The caching statistics of all items in the playlist. The memory that the cached frames of an
+  // item use is the same value that is compared to the cache size limit.
+  struct ItemStatistics
+  {
+    QString             name;
+    ItemCacheStatistics statistics;
+  };
+  std::vector<ItemStatistics> getCacheStatistics() const;
+  // All statistics together with the cache settings that they depend on
+  QJsonObject getCacheStatisticsJson() const;
+  void        resetCacheStatistics();
+
 signals:
   // This will be emitted on a regular basis to update the VideoCacheInfoWidget
   void updateCacheStatus();
@@ -108,18 +122,26 @@ private slots:
   // which frames can be removed from the cache.
   void updateCacheQueue();
 
+  // The current frame changed. If the user moves differently than assumed when the cache queue was
+  // updated, update it again.
+  void currentFrameChanged(int frameIndex);
+
 private:
-  // A cache job. Has a pointer to a playlist item and a range of frames to be cached.
+  // A cache job. Has a pointer to a playlist item and a range of frames to be cached. The frames
+  // are cached from frameRange.first to frameRange.second with the given step (which is negative
+  // if the frames are cached backwards).
   struct cacheJob
   {
     cacheJob() {}
-    cacheJob(playlistItem *item, indexRange range)
+    cacheJob(playlistItem *item, indexRange range, int step = 1)
     {
       plItem     = item;
       frameRange = range;
+      frameStep  = step;
     }
     QPointer<playlistItem> plItem;
     indexRange             frameRange;
+    int                    frameStep{1};
   };
   typedef QPair<QPointer<playlistItem>, int> plItemFrame;
 
@@ -144,6 +166,20 @@ private:
   // Enqueue the job in the queue. If all frames within the range are already cached in the item, do
   // nothing.
   void enqueueCacheJob(playlistItem *item, indexRange range);
+  void enqueueCacheJob(playlistItem *item, const prefetch::PrefetchWindow &window);
+
+  // Enqueue the jobs to cache at most nrFramesCachable frames of the selected item. The frames
+  // around the current frame are cached in the order in which they will probably be shown (see
+  // prefetch::getPrefetchWindows). Returns the cached frames of the item that are not needed
+  // anymore in the order in which they should be removed from the cache.
+  QList<plItemFrame> enqueuePrefetchJobs(playlistItem *item, int64_t nrFramesCachable);
+  // The current frame and motion when the jobs were enqueued. plannedFrame is -1 if the queue does
+  // not depend on the current frame.
+  int                   plannedFrame{-1};
+  prefetch::FrameMotion plannedMotion;
+  // If not all frames of the selected item fit into the cache, the queue is updated if the current
+  // frame moves this far
+  int64_t replanDistance{};
 
   // Start the given number of worker threads (if caching is running, also new jobs will be pushed
   // to the workers)
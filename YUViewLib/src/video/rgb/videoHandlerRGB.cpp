@@ -32,11 +32,14 @@
 
 #include "videoHandlerRGB.h"
 
+#include <algorithm>
+
 #include <common/EnumMapper.h>
 #include <common/Formatting.h>
 #include <common/Functions.h>
 #include <common/FunctionsGui.h>
 #include <common/InfoItemAndData.h>
+#include <video/FrameBufferPool.h>
 #include <video/rgb/ConversionRGB.h>
 #include <video/rgb/PixelFormatRGBGuess.h>
 #include <video/rgb/videoHandlerRGBCustomFormatDialog.h>
@@ -137,9 +140,8 @@ videoHandlerRGB::~videoHandlerRGB()
 
 unsigned videoHandlerRGB::getCachingFrameSize() const
 {
-  auto hasAlpha = this->srcPixelFormat.hasAlpha();
-  auto bytes    = functionsGui::bytesPerPixel(functionsGui::platformImageFormat(hasAlpha));
-  return this->frameSize.width * this->frameSize.height * bytes;
+  // Only the raw RGB data is cached (see isRawFrameCachingSupported)
+  return unsigned(std::max(this->getBytesPerFrame(), int64_t(0)));
 }
 
 QStringPairList videoHandlerRGB::getPixelValues(const QPoint &pixelPos,
@@ -157,6 +159,7 @@ QStringPairList videoHandlerRGB::getPixelValues(const QPoint &pixelPos,
       // The second item is not a videoHandlerRGB. Get the values from the FrameHandler.
       return FrameHandler::getPixelValues(pixelPos, frameIdx, item2, frameIdx1);
 
+    CurrentFrameLocker lock(this, rgbItem2);
     if (currentFrameRawData_frameIndex != frameIdx ||
         rgbItem2->currentFrameRawData_frameIndex != frameIdx1)
       return {};
@@ -193,6 +196,7 @@ QStringPairList videoHandlerRGB::getPixelValues(const QPoint &pixelPos,
     int width  = frameSize.width;
     int height = frameSize.height;
 
+    QMutexLocker lock(&this->currentFrameMutex);
     if (currentFrameRawData_frameIndex != frameIdx)
       return QStringPairList();
 
@@ -339,11 +343,10 @@ void videoHandlerRGB::slotDisplayOptionsChanged()
   componentInvert[3] = ui.AInvertCheckBox->isChecked();
   limitedRange       = ui.limitedRangeCheckBox->isChecked();
 
-  // Set the current frame in the buffer to be invalid and clear the cache.
-  // Emit that this item needs redraw and the cache needs updating.
-  currentImageIndex = -1;
-  setCacheInvalid();
-  emit signalHandlerChanged(true, RECACHE_CLEAR);
+  // Only the conversion to RGB changed. The cached raw frames are still valid, so there is
+  // nothing to recache. The frames are converted with the new settings when they are drawn.
+  this->invalidateConvertedImages();
+  emit signalHandlerChanged(true, RECACHE_NONE);
 }
 
 void videoHandlerRGB::updateControlsForNewPixelFormat()
@@ -455,7 +458,9 @@ void videoHandlerRGB::loadFrame(int frameIndex, bool loadToDoubleBuffer)
   }
 
   // Does the data in currentFrameRawData need to be updated?
-  if (!loadRawRGBData(frameIndex) || currentFrameRawData.isEmpty())
+  const auto   loaded = loadRawRGBData(frameIndex);
+  QMutexLocker rawDataLock(&this->currentFrameMutex);
+  if (!loaded || currentFrameRawData.isEmpty())
   {
     DEBUG_RGB("videoHandlerRGB::loadFrame Loading failed or is still running in the background");
     return;
@@ -467,15 +472,16 @@ void videoHandlerRGB::loadFrame(int frameIndex, bool loadToDoubleBuffer)
   {
     QImage newImage;
     convertRGBToImage(currentFrameRawData, newImage);
-    doubleBufferImage           = newImage;
+    doubleBufferImage           = ImagePyramid(newImage, this->isDrawnZoomedOut());
     doubleBufferImageFrameIndex = frameIndex;
   }
   else if (currentImageIndex != frameIndex)
   {
     QImage newImage;
     convertRGBToImage(currentFrameRawData, newImage);
-    QMutexLocker writeLock(&currentImageSetMutex);
-    currentImage      = newImage;
+    const ImagePyramid newImagePyramid(newImage, this->isDrawnZoomedOut());
+    QMutexLocker       writeLock(&currentImageSetMutex);
+    this->setCurrentImage(newImagePyramid);
     currentImageIndex = frameIndex;
   }
 }
@@ -541,8 +547,8 @@ void videoHandlerRGB::loadFrameForCaching(int frameIndex, QImage &frameToCache)
   rgbFormatMutex.lock();
 
   requestDataMutex.lock();
-  emit signalRequestRawData(frameIndex, true);
-  tmpBufferRawRGBDataCaching = rawData;
+  emit       signalRequestRawData(frameIndex, true);
+  const auto rawFrame = this->getRequestedRawFrame();
   requestDataMutex.unlock();
 
   if (frameIndex != rawData_frameIndex)
@@ -554,7 +560,7 @@ void videoHandlerRGB::loadFrameForCaching(int frameIndex, QImage &frameToCache)
   }
 
   // Convert RGB to image. This can then be cached.
-  convertRGBToImage(tmpBufferRawRGBDataCaching, frameToCache);
+  convertRGBToImage(rawFrame.getContiguousData(), frameToCache);
 
   rgbFormatMutex.unlock();
 }
@@ -571,13 +577,25 @@ bool videoHandlerRGB::loadRawRGBData(int frameIndex)
     return true;
   }
 
+  RawFrameView cachedFrame;
+  if (this->getRawFrameFromCache(frameIndex, cachedFrame))
+  {
+    DEBUG_RGB("videoHandlerRGB::loadRawRGBData frame %d found in cache", frameIndex);
+    this->setCurrentFrame(cachedFrame, frameIndex);
+    QMutexLocker lock(&this->currentFrameMutex);
+    this->loadCurrentFrameRawData();
+    return true;
+  }
+
   if (frameIndex == rawData_frameIndex)
   {
     // The raw data was loaded in the background. Now we just have to move it to the current
     // buffer. No actual loading is needed.
     requestDataMutex.lock();
-    currentFrameRawData            = rawData;
-    currentFrameRawData_frameIndex = frameIndex;
+    this->setCurrentFrame(this->getRequestedRawFrame(), frameIndex);
+    currentFrameMutex.lock();
+    this->loadCurrentFrameRawData();
+    currentFrameMutex.unlock();
     requestDataMutex.unlock();
     return true;
   }
@@ -590,8 +608,9 @@ bool videoHandlerRGB::loadRawRGBData(int frameIndex)
   emit signalRequestRawData(frameIndex, false);
   if (frameIndex == rawData_frameIndex)
   {
-    currentFrameRawData            = rawData;
-    currentFrameRawData_frameIndex = frameIndex;
+    this->setCurrentFrame(this->getRequestedRawFrame(), frameIndex);
+    QMutexLocker lock(&this->currentFrameMutex);
+    this->loadCurrentFrameRawData();
   }
   requestDataMutex.unlock();
 
@@ -606,6 +625,7 @@ bool videoHandlerRGB::loadRawRGBData(int frameIndex)
 void videoHandlerRGB::convertRGBToImage(const QByteArray &sourceBuffer, QImage &outputImage)
 {
   DEBUG_RGB("videoHandlerRGB::convertRGBToImage");
+  ScopedLatencyTimer convertTimer(&this->cacheStatistics, LoadingStage::Convert);
   auto curFrameSize = QSize(this->frameSize.width, this->frameSize.height);
 
   // Create the output image in the right format.
@@ -630,7 +650,7 @@ void videoHandlerRGB::convertRGBToImage(const QByteArray &sourceBuffer, QImage &
     return;
   }
 
-  outputImage = QImage(curFrameSize, format);
+  outputImage = FrameBufferPool::shared().allocateImage(curFrameSize, format);
 
   // Check the image buffer size before we write to it
 #if QT_VERSION < QT_VERSION_CHECK(5, 10, 0)
@@ -762,6 +782,7 @@ void videoHandlerRGB::drawPixelValues(QPainter     *painter,
   // Check if the raw RGB values are up to date. If not, do not draw them. Do not trigger loading of
   // data here. The needsLoadingRawValues function will return that loading is needed. The caching
   // in the background should then trigger loading of them.
+  CurrentFrameLocker lock(this, rgbItem2);
   if (currentFrameRawData_frameIndex != frameIdx)
     return;
   if (rgbItem2 && rgbItem2->currentFrameRawData_frameIndex != frameIdxItem1)
@@ -878,6 +899,7 @@ QImage videoHandlerRGB::calculateDifference(FrameHandler    *item2,
     return QImage(); // Loading failed
   if (!rgbItem2->loadRawRGBData(frameIdxItem1))
     return QImage(); // Loading failed
+  CurrentFrameLocker lock(this, rgbItem2);
 
   // Also calculate the MSE while we're at it (R,G,B)
   int64_t mseAdd[3] = {0, 0, 0};
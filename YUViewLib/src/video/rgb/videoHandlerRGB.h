@@ -178,6 +178,9 @@ protected:
   // currentFrame) will not be modified.
   virtual void loadFrameForCaching(int frameIndex, QImage &frameToCache) override;
 
+  // Cache the raw RGB frames and convert them when they are drawn.
+  bool isRawFrameCachingSupported() const override { return true; }
+
 private:
   // Load the raw RGB data for the given frame index into currentFrameRawRGBData.
   // Return false is loading failed.
@@ -191,10 +194,9 @@ private:
   void setSrcPixelFormat(const rgb::PixelFormatRGB &newFormat);
 
   // Convert one frame from the current pixel format to RGB888
-  void       convertSourceToRGBA32Bit(const QByteArray &sourceBuffer,
-                                      unsigned char *   targetBuffer,
-                                      QImage::Format    imageFormat);
-  QByteArray tmpBufferRawRGBDataCaching;
+  void convertSourceToRGBA32Bit(const QByteArray &sourceBuffer,
+                                unsigned char *   targetBuffer,
+                                QImage::Format    imageFormat);
 
   // When a caching job is running in the background it will lock this mutex, so that
   // the main thread does not change the RGB format while this is happening.
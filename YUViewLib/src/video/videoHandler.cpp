@@ -33,9 +33,12 @@
 #include "videoHandler.h"
 
 #include <QPainter>
+#include <QTimer>
 
 #include <common/FunctionsGui.h>
 
+#include <mutex>
+
 namespace video
 {
 
@@ -47,6 +50,26 @@ namespace video
 #define DEBUG_VIDEO(fmt, ...) ((void)0)
 #endif
 
+namespace
+{
+
+// Get the part of the frame (in frame coordinates) that the painter draws to
+QRect getVisibleFrameRegion(QPainter    *painter,
+                            const QRect &videoRect,
+                            const double zoomFactor,
+                            const Size   frameSize)
+{
+  auto visibleArea = painter->worldTransform().inverted().mapRect(QRectF(painter->viewport()));
+  if (painter->hasClipping())
+    visibleArea &= painter->clipBoundingRect();
+
+  const auto topLeft = (visibleArea.topLeft() - QPointF(videoRect.topLeft())) / zoomFactor;
+  const auto region  = QRectF(topLeft, visibleArea.size() / zoomFactor).toAlignedRect();
+  return region & QRect(0, 0, int(frameSize.width), int(frameSize.height));
+}
+
+} // namespace
+
 videoHandler::videoHandler()
 {
 }
@@ -78,6 +101,7 @@ void videoHandler::setFrameSize(Size size)
     this->currentFrameRawData_frameIndex = -1;
     this->currentImageIndex              = -1;
     this->rawData_frameIndex             = -1;
+    this->tileCache.clear();
   }
 
   FrameHandler::setFrameSize(size);
@@ -85,6 +109,16 @@ void videoHandler::setFrameSize(Size size)
 
 ItemLoadingState videoHandler::needsLoading(int frameIdx, bool loadRawValues)
 {
+  // Decide if only the visible tiles of the frame (and of the next frame for the double buffer) are
+  // loaded in loadFrame()
+  const auto tileRange = this->getVisibleTileRange(loadRawValues);
+  {
+    QMutexLocker regionLock(&this->regionLoadingMutex);
+    this->regionLoadingTileRange  = tileRange;
+    this->regionLoadingFrameIndex = tileRange.isEmpty() ? -1 : frameIdx;
+  }
+  this->regionLoadingRequested = false;
+
   if (loadRawValues)
   {
     // First, let's check the raw values buffer.
@@ -170,6 +204,26 @@ ItemLoadingState videoHandler::needsLoading(int frameIdx, bool loadRawValues)
     }
   }
 
+  if (!tileRange.isEmpty())
+  {
+    if (!this->tileCache.containsAllTiles(frameIdx, tileRange))
+    {
+      DEBUG_VIDEO("videoHandler::needsLoading %d visible tiles not found - request load", frameIdx);
+      return ItemLoadingState::LoadingNeeded;
+    }
+    if (this->tileCache.containsAllTiles(frameIdx + 1, tileRange))
+    {
+      DEBUG_VIDEO("videoHandler::needsLoading %d and %d visible tiles found in tile cache",
+                  frameIdx,
+                  frameIdx + 1);
+      return ItemLoadingState::LoadingNotNeeded;
+    }
+    DEBUG_VIDEO("videoHandler::needsLoading %d visible tiles found but not the tiles of %d",
+                frameIdx,
+                frameIdx + 1);
+    return ItemLoadingState::LoadingNeededDoubleBuffer;
+  }
+
   // Frame not in buffer. Return false and request the background loading thread to load the frame.
   DEBUG_VIDEO("videoHandler::needsLoading %d not found in cache - request load", frameIdx);
   return ItemLoadingState::LoadingNeeded;
@@ -185,7 +239,7 @@ void videoHandler::drawFrame(QPainter *painter, int frameIdx, double zoomFactor,
     // Check the double buffer
     if (frameIdx == doubleBufferImageFrameIndex)
     {
-      currentImage      = doubleBufferImage;
+      this->setCurrentImage(doubleBufferImage);
       currentImageIndex = frameIdx;
       DEBUG_VIDEO("videoHandler::drawFrame %d loaded from double buffer", frameIdx);
     }
@@ -194,7 +248,7 @@ void videoHandler::drawFrame(QPainter *painter, int frameIdx, double zoomFactor,
       QMutexLocker lock(&imageCacheAccess);
       if (cacheValid && imageCache.contains(frameIdx))
       {
-        currentImage      = imageCache[frameIdx];
+        this->setCurrentImage(imageCache[frameIdx]);
         currentImageIndex = frameIdx;
         DEBUG_VIDEO("videoHandler::drawFrame %d loaded from cache", frameIdx);
       }
@@ -211,9 +265,33 @@ void videoHandler::drawFrame(QPainter *painter, int frameIdx, double zoomFactor,
 
   // Draw the current image (currentImage)
   currentImageSetMutex.lock();
-  painter->drawImage(videoRect, currentImage);
+  this->drawCurrentImage(painter, videoRect);
   currentImageSetMutex.unlock();
 
+  const auto drawnRegion = getVisibleFrameRegion(painter, videoRect, zoomFactor, frameSize);
+  {
+    QMutexLocker regionLock(&this->regionLoadingMutex);
+    if (this->visibleRegionFrameIndex != frameIdx)
+      this->visibleRegion = drawnRegion;
+    else
+      this->visibleRegion |= drawnRegion;
+    this->visibleRegionFrameIndex = frameIdx;
+  }
+
+  if (frameIdx != currentImageIndex)
+  {
+    // The current image is not the requested frame. Draw the tiles of the requested frame that
+    // were loaded on top of it.
+    const auto tileRange = TileCache::getTileRange(drawnRegion);
+    this->tileCache.drawTiles(painter, frameIdx, tileRange, frameSize, videoRect, zoomFactor);
+
+    // The view may have been moved so that other tiles became visible. Request them to be loaded.
+    if (!this->getVisibleTileRange(drawRawValues).isEmpty() &&
+        !this->tileCache.containsAllTiles(frameIdx, tileRange) &&
+        !this->regionLoadingRequested.exchange(true))
+      QTimer::singleShot(0, this, [this]() { emit signalHandlerChanged(true, RECACHE_NONE); });
+  }
+
   if (drawRawValues && zoomFactor >= SPLITVIEW_DRAW_VALUES_ZOOMFACTOR)
   {
     // Draw the pixel values onto the pixels
@@ -262,7 +340,7 @@ QRgb videoHandler::getPixelVal(int x, int y)
 int videoHandler::getNrFramesCached() const
 {
   QMutexLocker lock(&imageCacheAccess);
-  return imageCache.size();
+  return imageCache.size() + rawFrameCache.size();
 }
 
 // Put the frame into the cache (if it is not already in there)
@@ -277,6 +355,27 @@ void videoHandler::cacheFrame(int frameIdx, bool testMode)
     return;
   }
 
+  if (this->isRawFrameCachingSupported())
+  {
+    // Only cache the raw data. It is converted when the frame is drawn.
+    RawFrameView rawFrame;
+    this->loadRawFrameForCaching(frameIdx, rawFrame);
+
+    if (!rawFrame.isEmpty())
+    {
+      DEBUG_VIDEO("videoHandler::cacheFrame insert raw frame %i into cache", frameIdx);
+      QMutexLocker imageCacheLock(&imageCacheAccess);
+      if (cacheValid && !testMode)
+      {
+        rawFrameCache.insert(frameIdx, rawFrame);
+        this->cacheStatistics.recordCachedFrame();
+      }
+    }
+    else
+      DEBUG_VIDEO("videoHandler::cacheFrame loading raw frame %i for caching failed", frameIdx);
+    return;
+  }
+
   // Load the frame. While this is happening in the background the frame size must not change.
   QImage cacheImage;
   loadFrameForCaching(frameIdx, cacheImage);
@@ -285,45 +384,71 @@ void videoHandler::cacheFrame(int frameIdx, bool testMode)
   if (!cacheImage.isNull())
   {
     DEBUG_VIDEO("videoHandler::cacheFrame insert frame %i into cache", frameIdx);
-    QMutexLocker imageCacheLock(&imageCacheAccess);
+    // Create the downscaled levels in the caching thread
+    const ImagePyramid cacheImagePyramid(cacheImage, this->isDrawnZoomedOut());
+    QMutexLocker       imageCacheLock(&imageCacheAccess);
     if (cacheValid && !testMode)
-      imageCache.insert(frameIdx, cacheImage);
+    {
+      imageCache.insert(frameIdx, cacheImagePyramid);
+      this->cacheStatistics.recordCachedFrame();
+    }
   }
   else
     DEBUG_VIDEO("videoHandler::cacheFrame loading frame %i for caching failed", frameIdx);
 }
 
+void videoHandler::cacheRawFrame(int frameIdx, const RawFrameView &rawFrame)
+{
+  Q_ASSERT_X(this->isRawFrameCachingSupported(), Q_FUNC_INFO, "Raw frame caching not supported");
+  if (rawFrame.isEmpty())
+    return;
+
+  DEBUG_VIDEO("videoHandler::cacheRawFrame insert raw frame %i into cache", frameIdx);
+  const auto   ownedFrame = rawFrame.toOwned();
+  QMutexLocker imageCacheLock(&imageCacheAccess);
+  if (cacheValid)
+  {
+    rawFrameCache.insert(frameIdx, ownedFrame);
+    this->cacheStatistics.recordCachedFrame();
+  }
+}
+
 unsigned videoHandler::getCachingFrameSize() const
 {
   const auto hasAlpha = false;
   auto       bytes    = functionsGui::bytesPerPixel(functionsGui::platformImageFormat(hasAlpha));
+  // The downscaled levels of a cached image add up to less than a third of the image
+  if (this->isDrawnZoomedOut())
+    return this->frameSize.width * this->frameSize.height * bytes * 4 / 3;
   return this->frameSize.width * this->frameSize.height * bytes;
 }
 
 QList<int> videoHandler::getCachedFrames() const
 {
   QMutexLocker lock(&imageCacheAccess);
-  return imageCache.keys();
+  return imageCache.keys() + rawFrameCache.keys();
 }
 
 int videoHandler::getNumberCachedFrames() const
 {
   QMutexLocker lock(&imageCacheAccess);
-  return imageCache.size();
+  return imageCache.size() + rawFrameCache.size();
 }
 
 bool videoHandler::isInCache(int idx) const
 {
   QMutexLocker lock(&imageCacheAccess);
-  return imageCache.contains(idx);
+  return imageCache.contains(idx) || rawFrameCache.contains(idx);
 }
 
 void videoHandler::removeFrameFromCache(int frameIdx)
 {
   DEBUG_VIDEO("removeFrameFromCache %d", frameIdx);
   QMutexLocker lock(&imageCacheAccess);
-  imageCache.remove(frameIdx);
+  const auto   nrRemoved = imageCache.remove(frameIdx) + rawFrameCache.remove(frameIdx);
   lock.unlock();
+  if (nrRemoved > 0)
+    this->cacheStatistics.recordEviction();
 }
 
 void videoHandler::removeAllFrameFromCache()
@@ -331,8 +456,96 @@ void videoHandler::removeAllFrameFromCache()
   DEBUG_VIDEO("removeAllFrameFromCache");
   QMutexLocker lock(&imageCacheAccess);
   imageCache.clear();
+  rawFrameCache.clear();
   cacheValid = true;
   lock.unlock();
+  this->tileCache.clear();
+}
+
+void videoHandler::loadRawFrameForCaching(int frameIndex, RawFrameView &rawFrameToCache)
+{
+  DEBUG_VIDEO("videoHandler::loadRawFrameForCaching %d", frameIndex);
+
+  QMutexLocker lock(&requestDataMutex);
+  emit signalRequestRawData(frameIndex, true);
+
+  if (frameIndex != rawData_frameIndex)
+    // Loading failed
+    return;
+
+  rawFrameToCache = this->getRequestedRawFrame();
+}
+
+bool videoHandler::getRawFrameFromCache(int frameIndex, RawFrameView &rawFrame) const
+{
+  QMutexLocker lock(&imageCacheAccess);
+  if (!cacheValid || !rawFrameCache.contains(frameIndex))
+    return false;
+  rawFrame = rawFrameCache[frameIndex];
+  return true;
+}
+
+RawFrameView videoHandler::getRequestedRawFrame() const
+{
+  if (this->rawFrameView.isEmpty())
+    return RawFrameView(this->rawData);
+  return this->rawFrameView.toOwned();
+}
+
+bool videoHandler::loadRawFrame(int frameIndex, RawFrameView &rawFrame)
+{
+  if (this->getRawFrameFromCache(frameIndex, rawFrame))
+    return true;
+
+  rawFrame = {};
+  this->loadRawFrameForCaching(frameIndex, rawFrame);
+  return !rawFrame.isEmpty();
+}
+
+void videoHandler::setCurrentFrame(const RawFrameView &rawFrame, int frameIndex)
+{
+  // currentFrameRawData may point into the buffers of the current view
+  QMutexLocker lock(&this->currentFrameMutex);
+  this->currentFrameRawData.clear();
+  this->currentFrameView               = rawFrame;
+  this->currentFrameRawData_frameIndex = frameIndex;
+}
+
+videoHandler::CurrentFrameLocker::CurrentFrameLocker(videoHandler *handler,
+                                                     videoHandler *otherHandler)
+    : mutex(&handler->currentFrameMutex)
+{
+  if (otherHandler == nullptr || otherHandler == handler)
+  {
+    this->mutex->lock();
+    return;
+  }
+  this->otherMutex = &otherHandler->currentFrameMutex;
+  std::lock(*this->mutex, *this->otherMutex);
+}
+
+videoHandler::CurrentFrameLocker::~CurrentFrameLocker()
+{
+  this->mutex->unlock();
+  if (this->otherMutex != nullptr)
+    this->otherMutex->unlock();
+}
+
+void videoHandler::loadCurrentFrameRawData()
+{
+  if (this->currentFrameRawData.isEmpty())
+    this->currentFrameRawData = this->currentFrameView.getContiguousData();
+}
+
+void videoHandler::invalidateConvertedImages()
+{
+  QMutexLocker lock(&imageCacheAccess);
+  imageCache.clear();
+  this->currentImageIndex           = -1;
+  this->currentImage_frameIndex     = -1;
+  this->doubleBufferImageFrameIndex = -1;
+  lock.unlock();
+  this->tileCache.clear();
 }
 
 void videoHandler::loadFrame(int frameIndex, bool loadToDoubleBuffer)
@@ -357,14 +570,15 @@ void videoHandler::loadFrame(int frameIndex, bool loadToDoubleBuffer)
   if (loadToDoubleBuffer)
   {
     // Save the requested frame in the double buffer
-    doubleBufferImage           = requestedFrame;
+    doubleBufferImage           = ImagePyramid(requestedFrame, this->isDrawnZoomedOut());
     doubleBufferImageFrameIndex = frameIndex;
   }
   else
   {
     // Set the requested frame as the current frame
-    QMutexLocker imageLock(&currentImageSetMutex);
-    currentImage      = requestedFrame;
+    const ImagePyramid newImage(requestedFrame, this->isDrawnZoomedOut());
+    QMutexLocker       imageLock(&currentImageSetMutex);
+    this->setCurrentImage(newImage);
     currentImageIndex = frameIndex;
   }
 }
@@ -389,6 +603,12 @@ void videoHandler::invalidateAllBuffers()
 {
   currentFrameRawData_frameIndex = -1;
   rawData_frameIndex             = -1;
+  rawFrameView                   = {};
+  // Drop all references to the frames of the source (e.g. into a mapped file that was reloaded)
+  QMutexLocker lock(&this->currentFrameMutex);
+  currentFrameRawData.clear();
+  currentFrameView = {};
+  lock.unlock();
 
   // Set the current frame in the buffer to be invalid
   currentImageIndex       = -1;
@@ -399,14 +619,16 @@ void videoHandler::invalidateAllBuffers()
   requestedFrame_idx = -1;
 
   imageCache.clear();
+  rawFrameCache.clear();
   cacheValid = true;
+  this->tileCache.clear();
 }
 
 void videoHandler::activateDoubleBuffer()
 {
   if (doubleBufferImageFrameIndex != -1)
   {
-    currentImage      = doubleBufferImage;
+    this->setCurrentImage(doubleBufferImage);
     currentImageIndex = doubleBufferImageFrameIndex;
     DEBUG_VIDEO("videoHandler::drawFrame %d loaded from double buffer", currentImageIndex);
   }
@@ -417,6 +639,41 @@ QLayout *videoHandler::createVideoHandlerControls(bool)
   return nullptr;
 }
 
+QRect videoHandler::getRegionLoadingTileRange(int frameIndex, bool loadToDoubleBuffer) const
+{
+  QMutexLocker regionLock(&this->regionLoadingMutex);
+  if (this->regionLoadingFrameIndex == -1)
+    return {};
+  const auto regionFrameIndex = this->regionLoadingFrameIndex + (loadToDoubleBuffer ? 1 : 0);
+  return (frameIndex == regionFrameIndex) ? this->regionLoadingTileRange : QRect();
+}
+
+QRect videoHandler::getVisibleTileRange(bool loadRawValues) const
+{
+  if (loadRawValues || !this->isRegionLoadingSupported())
+    return {};
+
+  const auto framePixels = int64_t(this->frameSize.width) * this->frameSize.height;
+  if (framePixels < REGION_LOADING_MIN_FRAME_PIXELS)
+    return {};
+
+  QRect region;
+  {
+    QMutexLocker regionLock(&this->regionLoadingMutex);
+    region = this->visibleRegion;
+  }
+  if (region.isEmpty())
+    return {};
+
+  // If more than a quarter of the frame is visible, the whole frame is loaded
+  const auto tileRange     = TileCache::getTileRange(region);
+  const auto tileRangeRect = TileCache::getTileRangeRect(tileRange, this->frameSize);
+  if (int64_t(tileRangeRect.width()) * tileRangeRect.height() > framePixels / 4)
+    return {};
+
+  return tileRange;
+}
+
 ItemLoadingState videoHandler::needsLoadingRawValues(int frameIndex)
 {
   return (this->currentFrameRawData_frameIndex == frameIndex) ? ItemLoadingState::LoadingNotNeeded
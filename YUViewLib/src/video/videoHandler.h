@@ -33,12 +33,17 @@
 #pragma once
 
 #include "PixelFormat.h"
+#include "CacheStatistics.h"
 #include "FrameHandler.h"
+#include "RawFrameView.h"
+#include "TileCache.h"
 
 #include <QBasicTimer>
 #include <QFileInfo>
 #include <QMutex>
 
+#include <atomic>
+
 namespace video
 {
 
@@ -56,9 +61,15 @@ public:
   virtual void drawFrame(QPainter *painter, int frameIndex, double zoomFactor, bool drawRawValues);
 
   // --- Caching ----
-  // These methods are all thread-safe and can be invoked from any thread.
+  // These methods are all thread-safe and can be invoked from any thread. cacheRawFrame puts an
+  // already loaded raw frame into the cache. This is for items that decode the frames for caching
+  // themselves (e.g. with multiple decoders in parallel) instead of providing them through
+  // signalRequestRawData. It requires raw frame caching support (isRawFrameCachingSupported). A
+  // view onto the buffers of a decoder is kept as it is (without copying the frame) if it keeps the
+  // buffers alive. Only a borrowed view is copied.
   int              getNrFramesCached() const;
   void             cacheFrame(int frameIndex, bool testMode);
+  void             cacheRawFrame(int frameIndex, const RawFrameView &rawFrame);
   virtual unsigned getCachingFrameSize() const;
   QList<int>       getCachedFrames() const;
   int              getNumberCachedFrames() const;
@@ -66,6 +77,10 @@ public:
   virtual void     removeFrameFromCache(int frameIndex);
   virtual void     removeAllFrameFromCache();
 
+  // Get the raw data of the given frame for an analysis of the whole sequence (thread-safe). A
+  // frame that is in the raw frame cache is not loaded again. Returns false if loading failed.
+  bool loadRawFrame(int frameIndex, RawFrameView &rawFrame);
+
   // Get the number of bytes for one frame (RGB or YUV) with the current format (if this video
   // handler uses raw data)
   virtual int64_t getBytesPerFrame() const { return -1; }
@@ -136,6 +151,14 @@ public:
   // A buffer with the raw RGB data (this is filled if signalRequestRawData() is emitted)
   QByteArray rawData;
   int        rawData_frameIndex{-1};
+  // Instead of filling rawData, a source can also provide the raw frame as a view onto its own
+  // buffers (e.g. the picture buffers of a decoder). This saves copying the frame into rawData.
+  // Only one of the two is set. See getRequestedRawFrame().
+  RawFrameView rawFrameView;
+
+  // Statistics on caching, interactive loading and the latencies of loading the frames. The item
+  // that provides the data records the read/decode latencies.
+  CacheStatistics cacheStatistics;
 
   // Do we need to load the raw values (because they are drawn on screen?)
   // The videoHandler will draw the pixel values (drawPixelValues()) using the 8bit QImage
@@ -183,8 +206,8 @@ protected:
   QMutex currentImageSetMutex;
 
   // Double buffering
-  QImage doubleBufferImage;
-  int    doubleBufferImageFrameIndex{-1};
+  ImagePyramid doubleBufferImage;
+  int          doubleBufferImageFrameIndex{-1};
 
   // The buffer of the raw data (RGB or YUV) of the current frame (and its frame index)
   // Before using the currentFrameRawData, you have to check if the currentFrameRawData_frameIndex
@@ -192,12 +215,72 @@ protected:
   QByteArray currentFrameRawData;
   int        currentFrameRawData_frameIndex{-1};
 
+  // The raw data of the current frame as it was loaded. This may be a view onto the buffers of a
+  // decoder which is converted without copying it. currentFrameRawData is only set from it
+  // (loadCurrentFrameRawData) if the raw values are needed in one array (e.g. to draw them). If
+  // the view is contiguous, currentFrameRawData then only points into the buffers of the view.
+  RawFrameView currentFrameView;
+  void         setCurrentFrame(const RawFrameView &rawFrame, int frameIndex);
+
+  // The loading thread sets the current frame while the GUI thread may read the raw values of it.
+  // setCurrentFrame waits for currentFrameMutex. Keep it locked while calling
+  // loadCurrentFrameRawData and for as long as currentFrameRawData is used.
+  QMutex currentFrameMutex;
+  void   loadCurrentFrameRawData();
+
+  // Locks the currentFrameMutex of the handler and of the other handler (if given) without the
+  // risk of a deadlock. If both are the same handler, its mutex is only locked once.
+  class CurrentFrameLocker
+  {
+  public:
+    CurrentFrameLocker(videoHandler *handler, videoHandler *otherHandler);
+    ~CurrentFrameLocker();
+
+    CurrentFrameLocker(const CurrentFrameLocker &)            = delete;
+    CurrentFrameLocker &operator=(const CurrentFrameLocker &) = delete;
+
+  private:
+    QMutex *mutex{};
+    QMutex *otherMutex{};
+  };
+
   // Set the cache to be invalid until a call to removefromCache(-1) clears it.
-  void setCacheInvalid() { cacheValid = false; }
+  void setCacheInvalid()
+  {
+    cacheValid = false;
+    this->tileCache.clear();
+  }
+
+  // Only the conversion to RGB changed (e.g. the color conversion matrix). All converted images
+  // (current image, double buffer and cached images) are outdated but the cached raw frames are
+  // still valid. They will be converted again when they are drawn.
+  void invalidateConvertedImages();
+
+  // --- Raw frame caching
+  // A handler that converts raw data (YUV or RGB) can cache the raw frames instead of the converted
+  // images. A raw frame is usually much smaller than the converted image (e.g. 1.5 instead of 4
+  // bytes per pixel for 8 bit 4:2:0) and it is still valid if only the conversion settings change.
+  // The cached raw frames are converted when they are loaded for drawing (loadFrame). If a handler
+  // overrides this, it should also return the raw frame size from getCachingFrameSize().
+  virtual bool isRawFrameCachingSupported() const { return false; }
+
+  // Load the raw data of the given frame for caching. This is called from a background thread.
+  // Like loadFrameForCaching, no other internal state of the handler is changed.
+  void loadRawFrameForCaching(int frameIndex, RawFrameView &rawFrameToCache);
+
+  // Get the raw data of the given frame from the cache (thread-safe). Returns false if the frame is
+  // not in the raw frame cache.
+  bool getRawFrameFromCache(int frameIndex, RawFrameView &rawFrame) const;
+
+  // Get the raw frame that the source provided after signalRequestRawData was emitted (rawData or
+  // rawFrameView). A borrowed view is copied so that the frame stays valid when the source goes on.
+  // Must be called with the requestDataMutex locked.
+  RawFrameView getRequestedRawFrame() const;
 
   // --- Caching
   QMutex mutable imageCacheAccess;
-  QMap<int, QImage> imageCache;
+  QMap<int, ImagePyramid> imageCache;
+  QMap<int, RawFrameView> rawFrameCache;
   // Is the cache valid? The cache can be ivalid in the following scenario:
   // Somethign about how an item is shown changes (e.g. the resolution) but caching of the item is
   // currently performed. If we just cleared the cache, the wrong (currently being cached) frames
@@ -207,6 +290,39 @@ protected:
   // threads) are invalid.
   bool cacheValid{true};
 
+  // --- Loading of the visible region of very large frames
+  // If only a small part of a very large frame is visible (e.g. a 16K frame at a high zoom factor),
+  // a handler can load and convert only the visible tiles of the frame instead of the whole frame.
+  // The tiles are drawn on top of the current image. A handler that overrides this must load the
+  // tiles given by getRegionLoadingTileRange() into the tileCache in loadFrame().
+  virtual bool isRegionLoadingSupported() const { return false; }
+
+  // Get the range of tiles to load if loadFrame() is called with these arguments. The range is
+  // empty if the whole frame has to be loaded.
+  QRect getRegionLoadingTileRange(int frameIndex, bool loadToDoubleBuffer) const;
+
+  TileCache tileCache;
+
+  // Only frames with at least this many pixels (4K UHD) are loaded partially
+  static constexpr int64_t REGION_LOADING_MIN_FRAME_PIXELS = int64_t(3840) * 2160;
+
+private:
+  // Get the range of tiles that cover the visible region. The range is empty if region loading is
+  // not used because it is not supported, the frame is not large enough, the raw values are needed
+  // or a too large part of the frame is visible.
+  QRect getVisibleTileRange(bool loadRawValues) const;
+
+  // The visible part of the frame (in frame coordinates). If the frame is drawn more than once
+  // (e.g. in the separate view or the zoom box), this is the union of all the drawn parts.
+  QRect visibleRegion;
+  int   visibleRegionFrameIndex{-1};
+  // The tiles that loadFrame() should load (as determined by the last call to needsLoading)
+  QRect          regionLoadingTileRange;
+  int            regionLoadingFrameIndex{-1};
+  mutable QMutex regionLoadingMutex;
+  // Drawing requested the missing tiles to be loaded
+  std::atomic_bool regionLoadingRequested{false};
+
 private slots:
   // Override the slotVideoControlChanged slot. For a videoHandler, also the number of frames might
   // have changed.
@@ -33,6 +33,9 @@
 #include "videoHandlerDifference.h"
 
 #include <QPainter>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
 #include <algorithm>
 
 #include <common/Formatting.h>
@@ -50,6 +53,24 @@ namespace video
 #define DEBUG_VIDEO(fmt, ...) ((void)0)
 #endif
 
+namespace
+{
+
+// The calculation of the objective metrics of a sequence can run for minutes. It has its own
+// thread pool so that it does not block the short tasks in the shared thread pool (e.g. the
+// conversion of the frame that is drawn). Its threads run with a low priority.
+QThreadPool *getObjectiveMetricsThreadPool()
+{
+  static QThreadPool *threadPool = []() {
+    auto pool = new QThreadPool();
+    pool->setMaxThreadCount(int(functions::getOptimalThreadCount()));
+    return pool;
+  }();
+  return threadPool;
+}
+
+} // namespace
+
 videoHandlerDifference::videoHandlerDifference() : videoHandler()
 {
 }
@@ -70,7 +91,7 @@ void videoHandlerDifference::drawDifferenceFrame(QPainter *painter,
     // Check the double buffer
     if (frameIdx == doubleBufferImageFrameIndex)
     {
-      currentImage      = doubleBufferImage;
+      this->setCurrentImage(doubleBufferImage);
       currentImageIndex = frameIdx;
       DEBUG_VIDEO("videoHandler::drawFrame %d loaded from double buffer", frameIdx);
     }
@@ -79,8 +100,20 @@ void videoHandlerDifference::drawDifferenceFrame(QPainter *painter,
       QMutexLocker lock(&imageCacheAccess);
       if (cacheValid && imageCache.contains(frameIdx))
       {
-        currentImage      = imageCache[frameIdx];
+        this->setCurrentImage(imageCache[frameIdx]);
         currentImageIndex = frameIdx;
+        if (this->differenceInfoCache.contains(frameIdx))
+        {
+          const auto cachedInfo            = this->differenceInfoCache.value(frameIdx);
+          this->differenceInfoList         = cachedInfo.differenceInfo;
+          this->currentFirstDifferenceInfo = cachedInfo.firstDifferenceInfo;
+        }
+        else
+        {
+          // Do not show the info of the previous frame
+          this->differenceInfoList.clear();
+          this->currentFirstDifferenceInfo.reset();
+        }
         DEBUG_VIDEO("videoHandler::drawFrame %d loaded from cache", frameIdx);
       }
     }
@@ -93,7 +126,7 @@ void videoHandlerDifference::drawDifferenceFrame(QPainter *painter,
 
   // Draw the current image (currentImage)
   currentImageSetMutex.lock();
-  painter->drawImage(videoRect, currentImage);
+  this->drawCurrentImage(painter, videoRect);
   currentImageSetMutex.unlock();
 
   if (drawRawValues && zoomFactor >= SPLITVIEW_DRAW_VALUES_ZOOMFACTOR)
@@ -111,6 +144,7 @@ void videoHandlerDifference::loadFrameDifference(int frameIndex, bool)
     return;
 
   differenceInfoList.clear();
+  this->currentFirstDifferenceInfo.reset();
 
   // Check if the second item is a video and the first one is not. In that case,
   // make sure that the right frame is loaded for the video item.
@@ -130,9 +164,10 @@ void videoHandlerDifference::loadFrameDifference(int frameIndex, bool)
   if (!newFrame.isNull())
   {
     // The new difference frame is ready
+    const ImagePyramid newImage(newFrame, this->isDrawnZoomedOut());
     currentImageIndex = frameIndex;
     currentImageSetMutex.lock();
-    currentImage = newFrame;
+    this->setCurrentImage(newImage);
     currentImageSetMutex.unlock();
   }
 }
@@ -148,6 +183,92 @@ bool videoHandlerDifference::inputsValid() const
   return true;
 }
 
+bool videoHandlerDifference::isCachingSupported() const
+{
+  if (!this->inputsValid())
+    return false;
+
+  auto yuvVideo0 = dynamic_cast<const yuv::videoHandlerYUV *>(inputVideo[0].data());
+  auto yuvVideo1 = dynamic_cast<const yuv::videoHandlerYUV *>(inputVideo[1].data());
+  if (yuvVideo0 == nullptr || yuvVideo1 == nullptr)
+    return false;
+
+  return yuvVideo0->getPixelFormatYUV().getSubsampling() ==
+         yuvVideo1->getPixelFormatYUV().getSubsampling();
+}
+
+void videoHandlerDifference::inputChanged(recacheIndicator recache)
+{
+  if (recache != RECACHE_CLEAR)
+  {
+    // The cached frames are calculated from the raw values of the inputs and are still valid
+    this->currentImageIndex = -1;
+    this->currentFirstDifferenceInfo.reset();
+    return;
+  }
+
+  // The cache is invalid until the item is recached
+  this->invalidateAllBuffers();
+  this->setCacheInvalid();
+}
+
+void videoHandlerDifference::removeFrameFromCache(int frameIndex)
+{
+  videoHandler::removeFrameFromCache(frameIndex);
+  QMutexLocker lock(&this->imageCacheAccess);
+  this->differenceInfoCache.remove(frameIndex);
+}
+
+void videoHandlerDifference::removeAllFrameFromCache()
+{
+  videoHandler::removeAllFrameFromCache();
+  QMutexLocker lock(&this->imageCacheAccess);
+  this->differenceInfoCache.clear();
+}
+
+void videoHandlerDifference::loadFrameForCaching(int frameIndex, QImage &frameToCache)
+{
+  DEBUG_VIDEO("videoHandlerDifference::loadFrameForCaching %d", frameIndex);
+
+  if (!this->isCachingSupported())
+    return;
+
+  auto yuvVideo0 = dynamic_cast<yuv::videoHandlerYUV *>(inputVideo[0].data());
+  auto yuvVideo1 = dynamic_cast<yuv::videoHandlerYUV *>(inputVideo[1].data());
+
+  RawFrameView rawFrame0;
+  RawFrameView rawFrame1;
+  if (!yuvVideo0->loadRawFrame(frameIndex, rawFrame0) ||
+      !yuvVideo1->loadRawFrame(frameIndex, rawFrame1))
+    return;
+
+  CachedDifferenceInfo cachedInfo;
+  QByteArray           diffYUV;
+  yuv::PixelFormatYUV  diffYUVFormat;
+  auto differenceImage =
+      yuv::videoHandlerYUV::calculateDifferenceOfRawFrames(rawFrame0.getContiguousData(),
+                                                           yuvVideo0->getPixelFormatYUV(),
+                                                           yuvVideo0->getFrameSize(),
+                                                           rawFrame1.getContiguousData(),
+                                                           yuvVideo1->getPixelFormatYUV(),
+                                                           yuvVideo1->getFrameSize(),
+                                                           cachedInfo.differenceInfo,
+                                                           this->amplificationFactor,
+                                                           this->markDifference,
+                                                           diffYUV,
+                                                           diffYUVFormat);
+  if (differenceImage.isNull())
+    return;
+
+  cachedInfo.firstDifferenceInfo =
+      this->findFirstDifferencePosition(differenceImage, diffYUV, diffYUVFormat);
+
+  QMutexLocker lock(&this->imageCacheAccess);
+  if (this->cacheValid)
+    this->differenceInfoCache.insert(frameIndex, cachedInfo);
+  frameToCache = differenceImage;
+}
+
 void videoHandlerDifference::setInputVideos(FrameHandler *childVideo0, FrameHandler *childVideo1)
 {
   if (inputVideo[0] != childVideo0 || inputVideo[1] != childVideo1)
@@ -168,8 +289,9 @@ void videoHandlerDifference::setInputVideos(FrameHandler *childVideo0, FrameHand
       setFrameSize(diffSize);
     }
 
-    // If something changed, we might need a redraw
-    emit signalHandlerChanged(true, RECACHE_NONE);
+    // If something changed, we might need a redraw. All cached difference frames are outdated.
+    this->setCacheInvalid();
+    emit signalHandlerChanged(true, RECACHE_CLEAR);
   }
 }
 
@@ -228,29 +350,42 @@ void videoHandlerDifference::slotDifferenceControlChanged()
   {
     markDifference = ui.markDifferenceCheckBox->isChecked();
 
-    // Set the current frame in the buffer to be invalid and emit the signal that something has
-    // changed
+    // Set the current frame in the buffer and the cache to be invalid and emit the signal that
+    // something has changed
     currentImageIndex = -1;
-    emit signalHandlerChanged(true, RECACHE_NONE);
+    this->setCacheInvalid();
+    emit signalHandlerChanged(true, RECACHE_CLEAR);
   }
   else if (sender == ui.codingOrderComboBox)
   {
-    codingOrder = (CodingOrder)ui.codingOrderComboBox->currentIndex();
-
-    // The calculation of the first difference in coding order changed but no redraw is necessary
-    emit signalHandlerChanged(false, RECACHE_NONE);
+    this->setCodingOrder((CodingOrder)ui.codingOrderComboBox->currentIndex());
   }
   else if (sender == ui.amplificationFactorSpinBox)
   {
     amplificationFactor = ui.amplificationFactorSpinBox->value();
 
-    // Set the current frame in the buffer to be invalid and emit the signal that something has
-    // changed
+    // Set the current frame in the buffer and the cache to be invalid and emit the signal that
+    // something has changed
     currentImageIndex = -1;
-    emit signalHandlerChanged(true, RECACHE_NONE);
+    this->setCacheInvalid();
+    emit signalHandlerChanged(true, RECACHE_CLEAR);
   }
 }
 
+void videoHandlerDifference::setCodingOrder(CodingOrder codingOrder)
+{
+  this->codingOrder = codingOrder;
+
+  // The first difference of the current and the cached frames has to be found again
+  QMutexLocker lock(&this->imageCacheAccess);
+  this->differenceInfoCache.clear();
+  lock.unlock();
+  this->currentFirstDifferenceInfo.reset();
+  currentImageIndex = -1;
+  this->setCacheInvalid();
+  emit signalHandlerChanged(true, RECACHE_CLEAR);
+}
+
 void videoHandlerDifference::reportFirstDifferencePosition(QList<InfoItem> &infoList) const
 {
   if (!inputsValid())
@@ -260,6 +395,29 @@ void videoHandlerDifference::reportFirstDifferencePosition(QList<InfoItem> &info
       functions::clipToUnsigned(currentImage.height()) != frameSize.height)
     return;
 
+  if (this->currentFirstDifferenceInfo)
+  {
+    // The current frame was taken from the cache
+    infoList.append(*this->currentFirstDifferenceInfo);
+    return;
+  }
+
+  // find first difference using YUV instead of QImage. The latter does not work for 10bit videos
+  // and very small differences, since it only supports 8bit
+  auto videoYUV0 = dynamic_cast<yuv::videoHandlerYUV *>(inputVideo[0].data());
+  if (videoYUV0 != NULL && videoYUV0->isDiffReady())
+    infoList.append(this->findFirstDifferencePosition(
+        currentImage, videoYUV0->getDiffYUV(), videoYUV0->getDiffYUVFormat()));
+  else
+    infoList.append(this->findFirstDifferencePosition(currentImage, {}, {}));
+}
+
+QList<InfoItem>
+videoHandlerDifference::findFirstDifferencePosition(const QImage              &diffImg,
+                                                    const QByteArray          &diffYUV,
+                                                    const yuv::PixelFormatYUV &diffYUVFormat) const
+{
+  QList<InfoItem> infoList;
   if (codingOrder == CodingOrder::HEVC)
   {
     // Assume the following:
@@ -277,39 +435,19 @@ void videoHandlerDifference::reportFirstDifferencePosition(QList<InfoItem> &info
         // Now take the tree approach
         int firstX, firstY, partIndex = 0;
 
-        auto videoYUV0 = dynamic_cast<yuv::videoHandlerYUV *>(inputVideo[0].data());
-        if (videoYUV0 != NULL && videoYUV0->isDiffReady())
-        {
-          // find first difference using YUV instead of QImage. The latter does not work for 10bit
-          // videos and very small differences, since it only supports 8bit
-          if (hierarchicalPositionYUV(x * 64,
-                                      y * 64,
-                                      64,
-                                      firstX,
-                                      firstY,
-                                      partIndex,
-                                      videoYUV0->getDiffYUV(),
-                                      videoYUV0->getDiffYUVFormat()))
-          {
-            // We found a difference in this block
-            infoList.append(InfoItem("First diff LCU", std::to_string(y * widthLCU + x)));
-            infoList.append(
-                InfoItem("First diff X,Y", std::to_string(firstX) + "," + std::to_string(firstY)));
-            infoList.append(InfoItem("First diff partIndex", std::to_string(partIndex)));
-            return;
-          }
-        }
-        else
+        const auto foundDifference =
+            diffYUV.isEmpty()
+                ? hierarchicalPosition(x * 64, y * 64, 64, firstX, firstY, partIndex, diffImg)
+                : hierarchicalPositionYUV(
+                      x * 64, y * 64, 64, firstX, firstY, partIndex, diffYUV, diffYUVFormat);
+        if (foundDifference)
         {
-          if (hierarchicalPosition(x * 64, y * 64, 64, firstX, firstY, partIndex, currentImage))
-          {
-            // We found a difference in this block
-            infoList.append(InfoItem("First diff LCU", std::to_string(y * widthLCU + x)));
-            infoList.append(
-                InfoItem("First diff X,Y", std::to_string(firstX) + "," + std::to_string(firstY)));
-            infoList.append(InfoItem("First diff partIndex", std::to_string(partIndex)));
-            return;
-          }
+          // We found a difference in this block
+          infoList.append(InfoItem("First diff LCU", std::to_string(y * widthLCU + x)));
+          infoList.append(
+              InfoItem("First diff X,Y", std::to_string(firstX) + "," + std::to_string(firstY)));
+          infoList.append(InfoItem("First diff partIndex", std::to_string(partIndex)));
+          return infoList;
         }
       }
     }
@@ -317,6 +455,7 @@ void videoHandlerDifference::reportFirstDifferencePosition(QList<InfoItem> &info
 
   // No difference was found
   infoList.append(InfoItem("Difference"sv, "Frames are identical"));
+  return infoList;
 }
 
 void videoHandlerDifference::savePlaylist(YUViewDomElement &element) const
@@ -341,6 +480,81 @@ void videoHandlerDifference::loadPlaylist(const YUViewDomElement &element)
     this->markDifference = true;
 }
 
+bool videoHandlerDifference::calculateObjectiveMetrics(const indexRange        range,
+                                                       const std::atomic_bool &abort,
+                                                       std::string            &errorMessage)
+{
+  auto yuvVideo0 = dynamic_cast<yuv::videoHandlerYUV *>(inputVideo[0].data());
+  auto yuvVideo1 = dynamic_cast<yuv::videoHandlerYUV *>(inputVideo[1].data());
+  if (!this->inputsValid() || yuvVideo0 == nullptr || yuvVideo1 == nullptr)
+  {
+    errorMessage = "Objective metrics can only be calculated for two YUV items.";
+    return false;
+  }
+
+  // Changing the format of an input aborts the calculation
+  const auto format0    = yuvVideo0->getPixelFormatYUV();
+  const auto format1    = yuvVideo1->getPixelFormatYUV();
+  const auto frameSize0 = yuvVideo0->getFrameSize();
+  const auto frameSize1 = yuvVideo1->getFrameSize();
+
+  // This also limits the number of raw frames that are held in memory at a time
+  auto       threadPool          = getObjectiveMetricsThreadPool();
+  const auto maxFramesInParallel = threadPool->maxThreadCount() + 1;
+
+  QMutex           metricsErrorMutex;
+  std::string      metricsError;
+  std::atomic_bool metricsFailed{false};
+
+  QList<QFuture<void>> runningFrames;
+  for (auto frameIndex = range.first; frameIndex <= range.second; frameIndex++)
+  {
+    if (abort.load() || metricsFailed.load())
+      break;
+
+    // The views are copied into the task. They keep the raw frames alive until it is done.
+    RawFrameView rawFrame0;
+    RawFrameView rawFrame1;
+    if (!yuvVideo0->loadRawFrame(frameIndex, rawFrame0) ||
+        !yuvVideo1->loadRawFrame(frameIndex, rawFrame1))
+    {
+      errorMessage = "Loading frame " + std::to_string(frameIndex) + " failed.";
+      break;
+    }
+
+    if (runningFrames.size() >= maxFramesInParallel)
+      runningFrames.takeFirst().waitForFinished();
+
+    auto calculateMetricsOfFrame = [=, &metricsErrorMutex, &metricsError, &metricsFailed]() {
+      QThread::currentThread()->setPriority(QThread::LowPriority);
+
+      std::string frameError;
+      if (auto metrics = yuv::metrics::calculateFrameMetrics(rawFrame0.getContiguousData(),
+                                                             format0,
+                                                             frameSize0,
+                                                             rawFrame1.getContiguousData(),
+                                                             format1,
+                                                             frameSize1,
+                                                             &frameError))
+        this->metricsPlotModel.addFrameMetrics(frameIndex, *metrics);
+      else
+      {
+        QMutexLocker locker(&metricsErrorMutex);
+        if (!metricsFailed.exchange(true))
+          metricsError = frameError;
+      }
+    };
+    runningFrames.append(QtConcurrent::run(threadPool, calculateMetricsOfFrame));
+  }
+
+  for (auto &frame : runningFrames)
+    frame.waitForFinished();
+
+  if (errorMessage.empty() && metricsFailed.load())
+    errorMessage = metricsError;
+  return errorMessage.empty();
+}
+
 ItemLoadingState videoHandlerDifference::needsLoadingRawValues(int frameIndex)
 {
   if (auto video = dynamic_cast<videoHandler *>(inputVideo[0].data()))
@@ -33,11 +33,15 @@
 #pragma once
 
 #include <common/InfoItemAndData.h>
+#include <video/ObjectiveMetricsPlotModel.h>
 #include <video/videoHandler.h>
 #include <video/yuv/videoHandlerYUV.h>
 
 #include <QPointer>
 
+#include <atomic>
+#include <optional>
+
 #include "ui_videoHandlerDifference.h"
 
 namespace video
@@ -50,6 +54,11 @@ class videoHandlerDifference : public videoHandler
 public:
   explicit videoHandlerDifference();
 
+  enum class CodingOrder
+  {
+    HEVC
+  };
+
   // Draw the frame with the given frame index and zoom factor. If onLoadShowLasFrame is set, show
   // the last frame if the frame with the current frame index is loaded in the background.
   void drawDifferenceFrame(QPainter *painter, int frameIdx, double zoomFactor, bool drawRawValues);
@@ -59,6 +68,18 @@ public:
   // Are both inputs valid and can be used?
   bool inputsValid() const;
 
+  // The difference frames can be cached if both inputs are YUV with the same subsampling. The
+  // difference is then calculated from the raw YUV frames which can be loaded from any thread.
+  bool isCachingSupported() const;
+
+  // One of the inputs changed. The cached difference frames are only outdated if the cache of the
+  // input was cleared (RECACHE_CLEAR). Other changes only require the current frame to update.
+  void inputChanged(recacheIndicator recache);
+
+  // Also remove the info (MSE, first difference) of the cached difference frames
+  void removeFrameFromCache(int frameIndex) override;
+  void removeAllFrameFromCache() override;
+
   // Create the YUV controls and return a pointer to the layout.
   virtual QLayout *createDifferenceHandlerControls();
 
@@ -80,31 +101,69 @@ public:
                                         int64_t          fileSize,
                                         const QFileInfo &fileInfo) override;
 
+  // The first difference of the cached frames was found in the old coding order. Changing it
+  // invalidates the cache.
+  void setCodingOrder(CodingOrder codingOrder);
+
   // Calculate the position of the first difference and add the info to the list
   void reportFirstDifferencePosition(QList<InfoItem> &infoList) const;
 
   virtual void savePlaylist(YUViewDomElement &root) const override;
   virtual void loadPlaylist(const YUViewDomElement &root) override;
 
+  // Calculate the objective metrics (PSNR, SSIM, MS-SSIM) of all frames in the given range and add
+  // them to the objective metrics plot model. This blocks until all frames are done (or abort is
+  // set) and is meant to be called from a background thread. The frames are loaded in order while
+  // the metrics of the previous frames are calculated in parallel in the shared thread pool. Frames
+  // that are in the raw frame cache of the inputs are not loaded again. Only YUV inputs are
+  // supported. Returns false and sets errorMessage if the calculation failed.
+  bool calculateObjectiveMetrics(const indexRange        range,
+                                 const std::atomic_bool &abort,
+                                 std::string            &errorMessage);
+
+  ObjectiveMetricsPlotModel *getObjectiveMetricsPlotModel() { return &this->metricsPlotModel; }
+  const ObjectiveMetricsPlotModel *getObjectiveMetricsPlotModel() const
+  {
+    return &this->metricsPlotModel;
+  }
+
 private slots:
   void slotDifferenceControlChanged();
 
 protected:
   ItemLoadingState needsLoadingRawValues(int frameIndex) override;
 
+  // Calculate the difference of the given frame without changing the current buffers. This is
+  // called from the caching threads.
+  void loadFrameForCaching(int frameIndex, QImage &frameToCache) override;
+
   bool markDifference{}; // Mark differences?
   int  amplificationFactor{1};
 
 private:
-  enum class CodingOrder
-  {
-    HEVC
-  };
   CodingOrder codingOrder{CodingOrder::HEVC};
 
   // The two videos that the difference will be calculated from
   QPointer<FrameHandler> inputVideo[2];
 
+  // The info of a difference frame in the cache. When a cached frame is shown, this info is shown
+  // instead of recalculating the difference. Access is protected by imageCacheAccess.
+  struct CachedDifferenceInfo
+  {
+    QList<InfoItem> differenceInfo;
+    QList<InfoItem> firstDifferenceInfo;
+  };
+  QMap<int, CachedDifferenceInfo> differenceInfoCache;
+
+  // Set if the current frame was taken from the cache
+  std::optional<QList<InfoItem>> currentFirstDifferenceInfo;
+
+  // Find the position of the first difference in coding order. If the YUV difference is given, it
+  // is used instead of the difference image (which only has 8 bit).
+  QList<InfoItem> findFirstDifferencePosition(const QImage              &diffImg,
+                                              const QByteArray          &diffYUV,
+                                              const yuv::PixelFormatYUV &diffYUVFormat) const;
+
   // Recursively scan the LCU
   bool hierarchicalPosition(int           x,
                             int           y,
@@ -123,6 +182,8 @@ private:
                                const yuv::PixelFormatYUV &diffYUVFormat) const;
 
   SafeUi<Ui::videoHandlerDifference> ui;
+
+  ObjectiveMetricsPlotModel metricsPlotModel;
 };
 
 } // namespace video
@@ -108,7 +108,7 @@ void videoHandlerResample::loadResampledFrame(int frameIndex, bool loadToDoubleB
 
   if (loadToDoubleBuffer)
   {
-    doubleBufferImage           = newFrame;
+    doubleBufferImage           = ImagePyramid(newFrame, this->isDrawnZoomedOut());
     doubleBufferImageFrameIndex = mappedIndex;
     DEBUG_RESAMPLE("videoHandlerResample::loadResampledFrame Loaded frame %d to double buffer",
                    mappedIndex);
@@ -116,8 +116,9 @@ void videoHandlerResample::loadResampledFrame(int frameIndex, bool loadToDoubleB
   else
   {
     // The new difference frame is ready
-    QMutexLocker lock(&this->currentImageSetMutex);
-    currentImage      = newFrame;
+    const ImagePyramid newImage(newFrame, this->isDrawnZoomedOut());
+    QMutexLocker       lock(&this->currentImageSetMutex);
+    this->setCurrentImage(newImage);
     currentImageIndex = mappedIndex;
     DEBUG_RESAMPLE("videoHandlerResample::loadResampledFrame Loaded frame %d to current buffer",
                    mappedIndex);
@@ -0,0 +1,635 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ConversionYUVSIMD.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CONVERSION_YUV_SIMD_X86 1
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSE4_1 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE4_1
+#define TARGET_AVX2
+#endif
+#else
+#define CONVERSION_YUV_SIMD_X86 0
+#endif
+
+namespace video::yuv::simd
+{
+
+namespace
+{
+
+using functions::InstructionSet;
+
+// The constants of the fixed point YUV -> RGB transformation. See convertYUVToRGB8Bit in
+// videoHandlerYUV.cpp for the scalar version which these values are derived from.
+struct MatrixCoefficients
+{
+  int preShift{};
+  int yOffset{};
+  int cZero{};
+  int shift{};
+  int RGBConv[5]{};
+};
+
+MatrixCoefficients getMatrixCoefficients(const ConversionParameters &parameters)
+{
+  const auto bps       = int(parameters.bitsPerSample);
+  const bool fullRange = parameters.colorConversion == ColorConversion::BT709_FullRange ||
+                         parameters.colorConversion == ColorConversion::BT601_FullRange ||
+                         parameters.colorConversion == ColorConversion::BT2020_FullRange;
+
+  MatrixCoefficients coefficients;
+  if (parameters.reduceTo8Bit)
+    coefficients.preShift = bps - 8;
+  else if (bps > 14)
+    // 32 bit are not enough for more than 14 bit. The lowest 2 bit are dropped.
+    coefficients.preShift = 2;
+
+  const auto matrixBitDepth = bps - coefficients.preShift;
+  coefficients.yOffset      = fullRange ? 0 : 16 << (matrixBitDepth - 8);
+  coefficients.cZero        = 128 << (matrixBitDepth - 8);
+  coefficients.shift        = 16 + matrixBitDepth - 8;
+  getColorConversionCoefficients(parameters.colorConversion, coefficients.RGBConv);
+  return coefficients;
+}
+
+inline int clipToByte(const int value)
+{
+  return (value < 0) ? 0 : (value > 255) ? 255 : value;
+}
+
+// ------------------ Scalar kernels ------------------
+
+void readSamplesScalar(const unsigned char *src,
+                       const int            valueSkip,
+                       const int            nrValues,
+                       const bool           twoBytes,
+                       const bool           bigEndian,
+                       int32_t             *dst)
+{
+  if (!twoBytes)
+  {
+    for (int i = 0; i < nrValues; i++)
+      dst[i] = src[i * valueSkip];
+  }
+  else if (bigEndian)
+  {
+    for (int i = 0; i < nrValues; i++)
+      dst[i] = src[i * valueSkip * 2] << 8 | src[i * valueSkip * 2 + 1];
+  }
+  else
+  {
+    for (int i = 0; i < nrValues; i++)
+      dst[i] = src[i * valueSkip * 2] | src[i * valueSkip * 2 + 1] << 8;
+  }
+}
+
+void applyMathScalar(int32_t              *values,
+                     const int             nrValues,
+                     const MathParameters &math,
+                     const int             inMax)
+{
+  const int scale = math.invert ? -math.scale : math.scale;
+  for (int i = 0; i < nrValues; i++)
+  {
+    const int newValue = (values[i] - math.offset) * scale + math.offset;
+    values[i]          = (newValue < 0) ? 0 : (newValue > inMax) ? inMax : newValue;
+  }
+}
+
+void convertRowScalar(const int32_t            *srcY,
+                      const int32_t            *srcU,
+                      const int32_t            *srcV,
+                      const int                 nrValues,
+                      const MatrixCoefficients &c,
+                      unsigned char            *dst)
+{
+  for (int i = 0; i < nrValues; i++)
+  {
+    // Use unsigned arithmetic so that an overflow wraps like it does in the vector units
+    const auto Y_tmp = uint32_t((srcY[i] >> c.preShift) - c.yOffset) * uint32_t(c.RGBConv[0]);
+    const auto U_tmp = uint32_t((srcU[i] >> c.preShift) - c.cZero);
+    const auto V_tmp = uint32_t((srcV[i] >> c.preShift) - c.cZero);
+
+    const auto R_tmp = int32_t(Y_tmp + V_tmp * uint32_t(c.RGBConv[1])) >> c.shift;
+    const auto G_tmp =
+        int32_t(Y_tmp + U_tmp * uint32_t(c.RGBConv[2]) + V_tmp * uint32_t(c.RGBConv[3])) >>
+        c.shift;
+    const auto B_tmp = int32_t(Y_tmp + U_tmp * uint32_t(c.RGBConv[4])) >> c.shift;
+
+    dst[i * 4]     = (unsigned char)clipToByte(B_tmp);
+    dst[i * 4 + 1] = (unsigned char)clipToByte(G_tmp);
+    dst[i * 4 + 2] = (unsigned char)clipToByte(R_tmp);
+    dst[i * 4 + 3] = 255;
+  }
+}
+
+#if CONVERSION_YUV_SIMD_X86
+
+// ------------------ SSE4.1 kernels ------------------
+
+TARGET_SSE4_1 void readSamplesSSE4_1(const unsigned char *src,
+                                     const int            valueSkip,
+                                     const int            nrValues,
+                                     const bool           twoBytes,
+                                     const bool           bigEndian,
+                                     int32_t             *dst)
+{
+  if (valueSkip != 1)
+  {
+    readSamplesScalar(src, valueSkip, nrValues, twoBytes, bigEndian, dst);
+    return;
+  }
+
+  int i = 0;
+  if (!twoBytes)
+  {
+    for (; i + 16 <= nrValues; i += 16)
+    {
+      const auto in = _mm_loadu_si128((const __m128i *)(src + i));
+      _mm_storeu_si128((__m128i *)(dst + i), _mm_cvtepu8_epi32(in));
+      _mm_storeu_si128((__m128i *)(dst + i + 4), _mm_cvtepu8_epi32(_mm_srli_si128(in, 4)));
+      _mm_storeu_si128((__m128i *)(dst + i + 8), _mm_cvtepu8_epi32(_mm_srli_si128(in, 8)));
+      _mm_storeu_si128((__m128i *)(dst + i + 12), _mm_cvtepu8_epi32(_mm_srli_si128(in, 12)));
+    }
+  }
+  else
+  {
+    const auto swapBytes = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    for (; i + 8 <= nrValues; i += 8)
+    {
+      auto in = _mm_loadu_si128((const __m128i *)(src + i * 2));
+      if (bigEndian)
+        in = _mm_shuffle_epi8(in, swapBytes);
+      _mm_storeu_si128((__m128i *)(dst + i), _mm_cvtepu16_epi32(in));
+      _mm_storeu_si128((__m128i *)(dst + i + 4), _mm_cvtepu16_epi32(_mm_srli_si128(in, 8)));
+    }
+  }
+  readSamplesScalar(src + (twoBytes ? i * 2 : i), 1, nrValues - i, twoBytes, bigEndian, dst + i);
+}
+
+TARGET_SSE4_1 void
+applyMathSSE4_1(int32_t *values, const int nrValues, const MathParameters &math, const int inMax)
+{
+  const auto offset = _mm_set1_epi32(math.offset);
+  const auto scale  = _mm_set1_epi32(math.invert ? -math.scale : math.scale);
+  const auto zero   = _mm_setzero_si128();
+  const auto max    = _mm_set1_epi32(inMax);
+
+  int i = 0;
+  for (; i + 4 <= nrValues; i += 4)
+  {
+    auto v = _mm_loadu_si128((const __m128i *)(values + i));
+    v      = _mm_add_epi32(_mm_mullo_epi32(_mm_sub_epi32(v, offset), scale), offset);
+    v      = _mm_min_epi32(_mm_max_epi32(v, zero), max);
+    _mm_storeu_si128((__m128i *)(values + i), v);
+  }
+  applyMathScalar(values + i, nrValues - i, math, inMax);
+}
+
+TARGET_SSE4_1 void convertRowSSE4_1(const int32_t            *srcY,
+                                    const int32_t            *srcU,
+                                    const int32_t            *srcV,
+                                    const int                 nrValues,
+                                    const MatrixCoefficients &c,
+                                    unsigned char            *dst)
+{
+  const auto preShift = _mm_cvtsi32_si128(c.preShift);
+  const auto shift    = _mm_cvtsi32_si128(c.shift);
+  const auto yOffset  = _mm_set1_epi32(c.yOffset);
+  const auto cZero    = _mm_set1_epi32(c.cZero);
+  const auto c0       = _mm_set1_epi32(c.RGBConv[0]);
+  const auto c1       = _mm_set1_epi32(c.RGBConv[1]);
+  const auto c2       = _mm_set1_epi32(c.RGBConv[2]);
+  const auto c3       = _mm_set1_epi32(c.RGBConv[3]);
+  const auto c4       = _mm_set1_epi32(c.RGBConv[4]);
+  const auto zero     = _mm_setzero_si128();
+  const auto max      = _mm_set1_epi32(255);
+  const auto alpha    = _mm_set1_epi32(int32_t(0xff000000));
+
+  int i = 0;
+  for (; i + 4 <= nrValues; i += 4)
+  {
+    auto y = _mm_sra_epi32(_mm_loadu_si128((const __m128i *)(srcY + i)), preShift);
+    auto u = _mm_sra_epi32(_mm_loadu_si128((const __m128i *)(srcU + i)), preShift);
+    auto v = _mm_sra_epi32(_mm_loadu_si128((const __m128i *)(srcV + i)), preShift);
+
+    y = _mm_mullo_epi32(_mm_sub_epi32(y, yOffset), c0);
+    u = _mm_sub_epi32(u, cZero);
+    v = _mm_sub_epi32(v, cZero);
+
+    auto r = _mm_sra_epi32(_mm_add_epi32(y, _mm_mullo_epi32(v, c1)), shift);
+    auto g = _mm_sra_epi32(
+        _mm_add_epi32(_mm_add_epi32(y, _mm_mullo_epi32(u, c2)), _mm_mullo_epi32(v, c3)), shift);
+    auto b = _mm_sra_epi32(_mm_add_epi32(y, _mm_mullo_epi32(u, c4)), shift);
+
+    r = _mm_min_epi32(_mm_max_epi32(r, zero), max);
+    g = _mm_min_epi32(_mm_max_epi32(g, zero), max);
+    b = _mm_min_epi32(_mm_max_epi32(b, zero), max);
+
+    // Little endian BGRA
+    const auto bgra = _mm_or_si128(_mm_or_si128(b, _mm_slli_epi32(g, 8)),
+                                   _mm_or_si128(_mm_slli_epi32(r, 16), alpha));
+    _mm_storeu_si128((__m128i *)(dst + i * 4), bgra);
+  }
+  convertRowScalar(srcY + i, srcU + i, srcV + i, nrValues - i, c, dst + i * 4);
+}
+
+// ------------------ AVX2 kernels ------------------
+
+TARGET_AVX2 void readSamplesAVX2(const unsigned char *src,
+                                 const int            valueSkip,
+                                 const int            nrValues,
+                                 const bool           twoBytes,
+                                 const bool           bigEndian,
+                                 int32_t             *dst)
+{
+  if (valueSkip != 1)
+  {
+    readSamplesScalar(src, valueSkip, nrValues, twoBytes, bigEndian, dst);
+    return;
+  }
+
+  int i = 0;
+  if (!twoBytes)
+  {
+    for (; i + 16 <= nrValues; i += 16)
+    {
+      const auto in = _mm_loadu_si128((const __m128i *)(src + i));
+      _mm256_storeu_si256((__m256i *)(dst + i), _mm256_cvtepu8_epi32(in));
+      _mm256_storeu_si256((__m256i *)(dst + i + 8), _mm256_cvtepu8_epi32(_mm_srli_si128(in, 8)));
+    }
+  }
+  else
+  {
+    const auto swapBytes = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    for (; i + 8 <= nrValues; i += 8)
+    {
+      auto in = _mm_loadu_si128((const __m128i *)(src + i * 2));
+      if (bigEndian)
+        in = _mm_shuffle_epi8(in, swapBytes);
+      _mm256_storeu_si256((__m256i *)(dst + i), _mm256_cvtepu16_epi32(in));
+    }
+  }
+  readSamplesScalar(src + (twoBytes ? i * 2 : i), 1, nrValues - i, twoBytes, bigEndian, dst + i);
+}
+
+TARGET_AVX2 void
+applyMathAVX2(int32_t *values, const int nrValues, const MathParameters &math, const int inMax)
+{
+  const auto offset = _mm256_set1_epi32(math.offset);
+  const auto scale  = _mm256_set1_epi32(math.invert ? -math.scale : math.scale);
+  const auto zero   = _mm256_setzero_si256();
+  const auto max    = _mm256_set1_epi32(inMax);
+
+  int i = 0;
+  for (; i + 8 <= nrValues; i += 8)
+  {
+    auto v = _mm256_loadu_si256((const __m256i *)(values + i));
+    v      = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(v, offset), scale), offset);
+    v      = _mm256_min_epi32(_mm256_max_epi32(v, zero), max);
+    _mm256_storeu_si256((__m256i *)(values + i), v);
+  }
+  applyMathScalar(values + i, nrValues - i, math, inMax);
+}
+
+TARGET_AVX2 void convertRowAVX2(const int32_t            *srcY,
+                                const int32_t            *srcU,
+                                const int32_t            *srcV,
+                                const int                 nrValues,
+                                const MatrixCoefficients &c,
+                                unsigned char            *dst)
+{
+  const auto preShift = _mm_cvtsi32_si128(c.preShift);
+  const auto shift    = _mm_cvtsi32_si128(c.shift);
+  const auto yOffset  = _mm256_set1_epi32(c.yOffset);
+  const auto cZero    = _mm256_set1_epi32(c.cZero);
+  const auto c0       = _mm256_set1_epi32(c.RGBConv[0]);
+  const auto c1       = _mm256_set1_epi32(c.RGBConv[1]);
+  const auto c2       = _mm256_set1_epi32(c.RGBConv[2]);
+  const auto c3       = _mm256_set1_epi32(c.RGBConv[3]);
+  const auto c4       = _mm256_set1_epi32(c.RGBConv[4]);
+  const auto zero     = _mm256_setzero_si256();
+  const auto max      = _mm256_set1_epi32(255);
+  const auto alpha    = _mm256_set1_epi32(int32_t(0xff000000));
+
+  int i = 0;
+  for (; i + 8 <= nrValues; i += 8)
+  {
+    auto y = _mm256_sra_epi32(_mm256_loadu_si256((const __m256i *)(srcY + i)), preShift);
+    auto u = _mm256_sra_epi32(_mm256_loadu_si256((const __m256i *)(srcU + i)), preShift);
+    auto v = _mm256_sra_epi32(_mm256_loadu_si256((const __m256i *)(srcV + i)), preShift);
+
+    y = _mm256_mullo_epi32(_mm256_sub_epi32(y, yOffset), c0);
+    u = _mm256_sub_epi32(u, cZero);
+    v = _mm256_sub_epi32(v, cZero);
+
+    auto r = _mm256_sra_epi32(_mm256_add_epi32(y, _mm256_mullo_epi32(v, c1)), shift);
+    auto g = _mm256_sra_epi32(
+        _mm256_add_epi32(_mm256_add_epi32(y, _mm256_mullo_epi32(u, c2)), _mm256_mullo_epi32(v, c3)),
+        shift);
+    auto b = _mm256_sra_epi32(_mm256_add_epi32(y, _mm256_mullo_epi32(u, c4)), shift);
+
+    r = _mm256_min_epi32(_mm256_max_epi32(r, zero), max);
+    g = _mm256_min_epi32(_mm256_max_epi32(g, zero), max);
+    b = _mm256_min_epi32(_mm256_max_epi32(b, zero), max);
+
+    const auto bgra = _mm256_or_si256(_mm256_or_si256(b, _mm256_slli_epi32(g, 8)),
+                                      _mm256_or_si256(_mm256_slli_epi32(r, 16), alpha));
+    _mm256_storeu_si256((__m256i *)(dst + i * 4), bgra);
+  }
+  convertRowScalar(srcY + i, srcU + i, srcV + i, nrValues - i, c, dst + i * 4);
+}
+
+#endif // CONVERSION_YUV_SIMD_X86
+
+struct Kernels
+{
+  void (*readSamples)(const unsigned char *, int, int, bool, bool, int32_t *);
+  void (*applyMath)(int32_t *, int, const MathParameters &, int);
+  void (*convertRow)(const int32_t *,
+                     const int32_t *,
+                     const int32_t *,
+                     int,
+                     const MatrixCoefficients &,
+                     unsigned char *);
+};
+
+Kernels getKernels(const InstructionSet instructionSet)
+{
+#if CONVERSION_YUV_SIMD_X86
+  // Never use an instruction set that the CPU does not support
+  const auto supported = functions::getSupportedInstructionSet();
+  const auto selected  = std::min(instructionSet, supported);
+  if (selected == InstructionSet::AVX2)
+    return {readSamplesAVX2, applyMathAVX2, convertRowAVX2};
+  if (selected == InstructionSet::SSE4_1)
+    return {readSamplesSSE4_1, applyMathSSE4_1, convertRowSSE4_1};
+#else
+  (void)instructionSet;
+#endif
+  return {readSamplesScalar, applyMathScalar, convertRowScalar};
+}
+
+// ------------------ Chroma upsampling ------------------
+
+inline int interpolate(const bool bilinear, const int sample1, const int sample2)
+{
+  return bilinear ? ((sample1 + sample2 + 1) >> 1) : sample1;
+}
+
+// Upsample one line of chroma values to the luma width. rowA is the chroma line at (or above) the
+// luma line, rowB is the chroma line that it is interpolated with vertically. For lines that need
+// no vertical interpolation, rowA and rowB are identical. This way, the interpolation of all lines
+// (including the last line and the last column) matches the scalar YUVPlaneToRGB_* functions.
+void upsampleChromaRow(const int32_t *rowA,
+                       const int32_t *rowB,
+                       const int      chromaWidth,
+                       const int      subsamplingHor,
+                       const bool     bilinear,
+                       int32_t       *dst)
+{
+  if (subsamplingHor == 1)
+  {
+    for (int x = 0; x < chromaWidth; x++)
+      dst[x] = interpolate(bilinear, rowA[x], rowB[x]);
+  }
+  else if (subsamplingHor == 2)
+  {
+    for (int x = 0; x < chromaWidth - 1; x++)
+    {
+      dst[x * 2] = interpolate(bilinear, rowA[x], rowB[x]);
+      dst[x * 2 + 1] =
+          bilinear ? ((rowA[x] + rowA[x + 1] + rowB[x] + rowB[x + 1] + 2) >> 2) : rowA[x];
+    }
+    // The right border. There is no next value. Only vertical interpolation is possible.
+    const auto last                   = chromaWidth - 1;
+    dst[last * 2]     = interpolate(bilinear, rowA[last], rowB[last]);
+    dst[last * 2 + 1] = dst[last * 2];
+  }
+  else if (subsamplingHor == 4)
+  {
+    // Only horizontal interpolation (4:1:1)
+    for (int x = 0; x < chromaWidth - 1; x++)
+    {
+      const auto cur  = rowA[x];
+      const auto next = rowA[x + 1];
+      dst[x * 4]      = cur;
+      dst[x * 4 + 1]  = bilinear ? ((cur * 3 + next + 1) >> 2) : cur;
+      dst[x * 4 + 2]  = bilinear ? ((cur + next + 1) >> 1) : cur;
+      dst[x * 4 + 3]  = bilinear ? ((cur + next * 3 + 1) >> 2) : cur;
+    }
+    const auto last = chromaWidth - 1;
+    for (int i = 0; i < 4; i++)
+      dst[last * 4 + i] = rowA[last];
+  }
+}
+
+// Get the chroma lines (A and B) that are needed to reconstruct the chroma values for the given
+// luma line.
+std::pair<int, int>
+getChromaRowsForLumaRow(const Subsampling subsampling, const int lumaRow, const int chromaHeight)
+{
+  if (subsampling == Subsampling::YUV_420)
+  {
+    const auto chromaRow = lumaRow / 2;
+    const auto isOddRow  = (lumaRow % 2) == 1;
+    if (isOddRow && chromaRow < chromaHeight - 1)
+      return {chromaRow, chromaRow + 1};
+    return {chromaRow, chromaRow};
+  }
+  if (subsampling == Subsampling::YUV_440)
+  {
+    // The scalar 4:4:0 conversion interpolates the lower line of each pair between the previous
+    // and the current chroma line. We do the same here to stay bit-exact.
+    const auto chromaRow = lumaRow / 2;
+    const auto isOddRow  = (lumaRow % 2) == 1;
+    const auto curRow    = std::max(chromaRow - 1, 0);
+    if (isOddRow && chromaRow < chromaHeight - 1)
+      return {curRow, chromaRow};
+    return {curRow, curRow};
+  }
+  return {lumaRow, lumaRow};
+}
+
+// Keeps the last two chroma lines (U and V, already unpacked and with YUV math applied) so that
+// every chroma line is only read once even if it is needed for multiple luma lines.
+class ChromaRowCache
+{
+public:
+  ChromaRowCache(const int chromaWidth)
+  {
+    for (auto &slot : this->rowSlots)
+    {
+      slot.u.resize(chromaWidth);
+      slot.v.resize(chromaWidth);
+    }
+  }
+
+  struct Slot
+  {
+    int                  row{-1};
+    std::vector<int32_t> u;
+    std::vector<int32_t> v;
+  };
+
+  template <typename LoadFunction>
+  const Slot &getRow(const int row, const int keepRow, LoadFunction loadRow)
+  {
+    for (auto &slot : this->rowSlots)
+      if (slot.row == row)
+        return slot;
+
+    auto &slot = (this->rowSlots[0].row == keepRow) ? this->rowSlots[1] : this->rowSlots[0];
+    loadRow(row, slot.u.data(), slot.v.data());
+    slot.row = row;
+    return slot;
+  }
+
+private:
+  Slot rowSlots[2];
+};
+
+} // namespace
+
+bool supportsConversion(const ConversionParameters &parameters)
+{
+  const auto subsampling = parameters.subsampling;
+  if (subsampling != Subsampling::YUV_444 && subsampling != Subsampling::YUV_422 &&
+      subsampling != Subsampling::YUV_420 && subsampling != Subsampling::YUV_440 &&
+      subsampling != Subsampling::YUV_411)
+    return false;
+  if (parameters.bitsPerSample < 8 || parameters.bitsPerSample > 16)
+    return false;
+  if (parameters.reduceTo8Bit &&
+      (parameters.mathY.mathRequired() || parameters.mathC.mathRequired()))
+    return false;
+  return parameters.frameSize.isValid();
+}
+
+void convertPlanarYUVToARGB(const PlanarSource             &source,
+                            const ConversionParameters     &parameters,
+                            unsigned char                  *targetBuffer,
+                            const functions::InstructionSet instructionSet)
+{
+  convertPlanarYUVToARGB(
+      source, parameters, targetBuffer, {0, parameters.frameSize.height}, instructionSet);
+}
+
+void convertPlanarYUVToARGB(const PlanarSource             &source,
+                            const ConversionParameters     &parameters,
+                            unsigned char                  *targetBuffer,
+                            const Range<unsigned>           lines,
+                            const functions::InstructionSet instructionSet)
+{
+  const auto kernels      = getKernels(instructionSet);
+  const auto coefficients = getMatrixCoefficients(parameters);
+
+  const auto subsampling    = parameters.subsampling;
+  const auto subsamplingHor =
+      (subsampling == Subsampling::YUV_422 || subsampling == Subsampling::YUV_420) ? 2
+      : (subsampling == Subsampling::YUV_411)                                      ? 4
+                                                                                    : 1;
+  const auto subsamplingVer =
+      (subsampling == Subsampling::YUV_420 || subsampling == Subsampling::YUV_440) ? 2 : 1;
+
+  const auto w            = int(parameters.frameSize.width);
+  const auto h            = int(parameters.frameSize.height);
+  const auto chromaWidth  = w / subsamplingHor;
+  const auto chromaHeight = h / subsamplingVer;
+
+  const auto twoBytes        = parameters.bitsPerSample > 8;
+  const auto bytesPerSample  = twoBytes ? 2 : 1;
+  const auto bigEndian       = parameters.bigEndian;
+  const auto inMax           = (1 << parameters.bitsPerSample) - 1;
+  const auto bilinear        = parameters.chromaInterpolation == ChromaInterpolation::Bilinear;
+  const auto applyMathLuma   = parameters.mathY.mathRequired();
+  const auto applyMathChroma = parameters.mathC.mathRequired();
+  const auto skip            = source.chromaValueSkip;
+
+  // Without a stride, the lines of the planes follow each other without padding
+  const auto strideY = source.strideY > 0 ? source.strideY : size_t(w) * bytesPerSample;
+  const auto strideC =
+      source.strideC > 0 ? source.strideC : size_t(chromaWidth) * skip * bytesPerSample;
+
+  std::vector<int32_t> lineY(w);
+  std::vector<int32_t> lineU(w);
+  std::vector<int32_t> lineV(w);
+  ChromaRowCache       chromaRows(chromaWidth);
+
+  auto loadChromaRow = [&](const int row, int32_t *dstU, int32_t *dstV) {
+    const auto offset = size_t(row) * strideC;
+    kernels.readSamples(source.planeU + offset, skip, chromaWidth, twoBytes, bigEndian, dstU);
+    kernels.readSamples(source.planeV + offset, skip, chromaWidth, twoBytes, bigEndian, dstV);
+    if (applyMathChroma)
+    {
+      kernels.applyMath(dstU, chromaWidth, parameters.mathC, inMax);
+      kernels.applyMath(dstV, chromaWidth, parameters.mathC, inMax);
+    }
+  };
+
+  const auto lastLine = std::min(int(lines.max), h);
+  for (int y = int(lines.min); y < lastLine; y++)
+  {
+    const auto srcY = source.planeY + size_t(y) * strideY;
+    kernels.readSamples(srcY, 1, w, twoBytes, bigEndian, lineY.data());
+    if (applyMathLuma)
+      kernels.applyMath(lineY.data(), w, parameters.mathY, inMax);
+
+    const auto [rowA, rowB] = getChromaRowsForLumaRow(subsampling, y, chromaHeight);
+    const auto &chromaA     = chromaRows.getRow(rowA, rowB, loadChromaRow);
+    const auto &chromaB     = chromaRows.getRow(rowB, rowA, loadChromaRow);
+
+    upsampleChromaRow(
+        chromaA.u.data(), chromaB.u.data(), chromaWidth, subsamplingHor, bilinear, lineU.data());
+    upsampleChromaRow(
+        chromaA.v.data(), chromaB.v.data(), chromaWidth, subsamplingHor, bilinear, lineV.data());
+
+    kernels.convertRow(lineY.data(),
+                       lineU.data(),
+                       lineV.data(),
+                       w,
+                       coefficients,
+                       targetBuffer + size_t(y) * w * 4);
+  }
+}
+
+} // namespace video::yuv::simd
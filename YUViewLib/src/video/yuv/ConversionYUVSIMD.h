@@ -0,0 +1,99 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/CpuFeatures.h>
+#include <video/yuv/PixelFormatYUV.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace video::yuv::simd
+{
+
+// Pointers to the first sample of the Y, U and V plane of a planar YUV frame. If the chroma planes
+// are interleaved, planeU and planeV point to the first U and V value and chromaValueSkip is the
+// distance (in samples) from one U (or V) value to the next. strideY and strideC are the distances
+// (in bytes) from one line of the luma and chroma planes to the next. If they are 0, the lines
+// follow each other without padding (like in a raw YUV file).
+struct PlanarSource
+{
+  const unsigned char *planeY{};
+  const unsigned char *planeU{};
+  const unsigned char *planeV{};
+  int                  chromaValueSkip{1};
+  size_t               strideY{};
+  size_t               strideC{};
+};
+
+struct ConversionParameters
+{
+  Size                frameSize;
+  Subsampling         subsampling{Subsampling::YUV_420};
+  unsigned            bitsPerSample{8};
+  bool                bigEndian{};
+  ChromaInterpolation chromaInterpolation{ChromaInterpolation::NearestNeighbor};
+  ColorConversion     colorConversion{ColorConversion::BT709_LimitedRange};
+  MathParameters      mathY;
+  MathParameters      mathC;
+  // Drop the lowest bits of each sample and perform the conversion with 8 bit precision. This is
+  // what the specialized 4:2:0 path in convertYUVToImage does for 10 bit input.
+  bool reduceTo8Bit{};
+};
+
+// Returns true if convertPlanarYUVToARGB can convert a frame with the given parameters. The
+// kernels reproduce the scalar YUVPlaneToRGB_* functions exactly (bit-exact) for 4:4:4, 4:2:2,
+// 4:2:0, 4:4:0 and 4:1:1 with 8 to 16 bit per sample in both endiannesses and all chroma
+// interpolation modes.
+bool supportsConversion(const ConversionParameters &parameters);
+
+// Convert the planar YUV source to 8 bit BGRA (little endian ARGB32) in targetBuffer. The frame
+// is processed line by line. Unpacking of the samples, YUV math and the color transformation use
+// the given instruction set; the chroma upsampling is shared by all instruction sets.
+void convertPlanarYUVToARGB(
+    const PlanarSource             &source,
+    const ConversionParameters     &parameters,
+    unsigned char                  *targetBuffer,
+    const functions::InstructionSet instructionSet = functions::getSupportedInstructionSet());
+
+// Only convert the output lines [lines.min, lines.max). targetBuffer points to the first line of
+// the full frame. Every line only depends on the source, so the frame can be split into stripes
+// that are converted in parallel. The output is identical to a conversion of the whole frame.
+void convertPlanarYUVToARGB(
+    const PlanarSource             &source,
+    const ConversionParameters     &parameters,
+    unsigned char                  *targetBuffer,
+    const Range<unsigned>           lines,
+    const functions::InstructionSet instructionSet = functions::getSupportedInstructionSet());
+
+} // namespace video::yuv::simd
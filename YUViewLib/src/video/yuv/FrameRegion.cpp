@@ -0,0 +1,206 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "FrameRegion.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace video::yuv
+{
+
+namespace
+{
+
+struct PlaneLayout
+{
+  unsigned subsamplingHor{1};
+  unsigned subsamplingVer{1};
+  // 2 for the plane with the interleaved U and V samples
+  unsigned valuesPerSample{1};
+};
+
+// The planes in the order in which they are stored in the raw frame. This must match the layout
+// that bytesPerFrame() and the conversion functions assume.
+std::vector<PlaneLayout> getPlaneLayouts(const PixelFormatYUV &format)
+{
+  const auto subsamplingHor = unsigned(format.getSubsamplingHor());
+  const auto subsamplingVer = unsigned(format.getSubsamplingVer());
+
+  std::vector<PlaneLayout> planes;
+  planes.push_back({1, 1, 1});
+  if (format.getSubsampling() != Subsampling::YUV_400)
+  {
+    if (format.isUVInterleaved())
+      planes.push_back({subsamplingHor, subsamplingVer, 2});
+    else
+    {
+      planes.push_back({subsamplingHor, subsamplingVer, 1});
+      planes.push_back({subsamplingHor, subsamplingVer, 1});
+    }
+  }
+  if (format.hasAlpha())
+    planes.push_back({1, 1, 1});
+  return planes;
+}
+
+int64_t getBytesPerSample(const PixelFormatYUV &format)
+{
+  return (format.getBitsPerSample() > 8) ? 2 : 1;
+}
+
+int64_t getLineBytes(const PlaneLayout &plane, const unsigned width, const int64_t bytesPerSample)
+{
+  return int64_t(width / plane.subsamplingHor) * plane.valuesPerSample * bytesPerSample;
+}
+
+} // namespace
+
+bool isRegionLoadingSupported(const PixelFormatYUV &format)
+{
+  if (!format.isValid() || format.getPredefinedFormat() || !format.isPlanar())
+    return false;
+  if (format.isUVInterleaved() && format.hasAlpha())
+    return false;
+  const auto bitsPerSample = format.getBitsPerSample();
+  return bitsPerSample >= 8 && bitsPerSample <= 16;
+}
+
+FrameRegion getRegionForConversion(const FrameRegion    &region,
+                                   const PixelFormatYUV &format,
+                                   const Size            frameSize)
+{
+  const auto subsamplingHor = int64_t(format.getSubsamplingHor());
+  const auto subsamplingVer = int64_t(format.getSubsamplingVer());
+  const auto marginHor      = 2 * subsamplingHor;
+  const auto marginVer      = 2 * subsamplingVer;
+
+  auto alignDown = [](int64_t value, int64_t alignment) { return value / alignment * alignment; };
+  auto alignUp   = [](int64_t value, int64_t alignment)
+  { return (value + alignment - 1) / alignment * alignment; };
+
+  const auto regionLeft   = int64_t(region.x);
+  const auto regionTop    = int64_t(region.y);
+  const auto regionRight  = regionLeft + region.width;
+  const auto regionBottom = regionTop + region.height;
+
+  // The frame size is a multiple of the subsampling (see canConvertToRGB).
+  const auto left   = alignDown(std::max(regionLeft - marginHor, int64_t(0)), subsamplingHor);
+  const auto top    = alignDown(std::max(regionTop - marginVer, int64_t(0)), subsamplingVer);
+  const auto right  = std::min(alignUp(regionRight + marginHor, subsamplingHor),
+                              alignDown(frameSize.width, subsamplingHor));
+  const auto bottom = std::min(alignUp(regionBottom + marginVer, subsamplingVer),
+                               alignDown(frameSize.height, subsamplingVer));
+
+  if (right <= left || bottom <= top)
+    return {};
+  return {unsigned(left), unsigned(top), unsigned(right - left), unsigned(bottom - top)};
+}
+
+std::vector<ByteRange> getRegionByteRanges(const PixelFormatYUV &format,
+                                           const Size            frameSize,
+                                           const FrameRegion    &region)
+{
+  const auto bytesPerSample = getBytesPerSample(format);
+
+  std::vector<ByteRange> ranges;
+  int64_t                planeOffset = 0;
+  for (const auto &plane : getPlaneLayouts(format))
+  {
+    const auto lineBytes = getLineBytes(plane, frameSize.width, bytesPerSample);
+    const auto firstRow  = int64_t(region.y / plane.subsamplingVer);
+    const auto nrRows    = int64_t(region.height / plane.subsamplingVer);
+    ranges.push_back({planeOffset + firstRow * lineBytes, nrRows * lineBytes});
+    planeOffset += lineBytes * (frameSize.height / plane.subsamplingVer);
+  }
+  return ranges;
+}
+
+std::vector<ByteRange> getConcatenatedByteRanges(const std::vector<ByteRange> &ranges)
+{
+  std::vector<ByteRange> concatenatedRanges;
+  int64_t                offset = 0;
+  for (const auto &range : ranges)
+  {
+    concatenatedRanges.push_back({offset, range.size});
+    offset += range.size;
+  }
+  return concatenatedRanges;
+}
+
+QByteArray copyRegion(const QByteArray             &data,
+                      const std::vector<ByteRange> &planeRows,
+                      const PixelFormatYUV         &format,
+                      const Size                    frameSize,
+                      const FrameRegion            &region)
+{
+  const auto planes = getPlaneLayouts(format);
+  if (planeRows.size() != planes.size() || region.isEmpty())
+    return {};
+
+  const auto bytesPerSample = getBytesPerSample(format);
+
+  int64_t regionBytes = 0;
+  for (const auto &plane : planes)
+    regionBytes += getLineBytes(plane, region.width, bytesPerSample) *
+                   (region.height / plane.subsamplingVer);
+
+  QByteArray regionData;
+  regionData.resize(int(regionBytes));
+  auto dst = regionData.data();
+
+  for (size_t i = 0; i < planes.size(); i++)
+  {
+    const auto &plane           = planes[i];
+    const auto  lineBytes       = getLineBytes(plane, frameSize.width, bytesPerSample);
+    const auto  regionLineBytes = getLineBytes(plane, region.width, bytesPerSample);
+    const auto  nrRows          = int64_t(region.height / plane.subsamplingVer);
+    const auto  xOffset = int64_t(region.x / plane.subsamplingHor) * plane.valuesPerSample *
+                         bytesPerSample;
+
+    if (planeRows[i].offset < 0 || planeRows[i].offset + nrRows * lineBytes > data.size())
+      return {};
+
+    auto src = data.constData() + planeRows[i].offset + xOffset;
+    for (int64_t row = 0; row < nrRows; row++)
+    {
+      std::memcpy(dst, src, size_t(regionLineBytes));
+      src += lineBytes;
+      dst += regionLineBytes;
+    }
+  }
+
+  return regionData;
+}
+
+} // namespace video::yuv
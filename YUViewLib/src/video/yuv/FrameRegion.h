@@ -0,0 +1,107 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <video/yuv/PixelFormatYUV.h>
+
+#include <QByteArray>
+
+#include <cstdint>
+#include <vector>
+
+namespace video::yuv
+{
+
+// A rectangular region of a frame in luma samples
+struct FrameRegion
+{
+  unsigned x{};
+  unsigned y{};
+  unsigned width{};
+  unsigned height{};
+
+  bool operator==(const FrameRegion &other) const
+  {
+    return this->x == other.x && this->y == other.y && this->width == other.width &&
+           this->height == other.height;
+  }
+  bool isEmpty() const { return this->width == 0 || this->height == 0; }
+  Size size() const { return Size(this->width, this->height); }
+};
+
+// A range of bytes in a raw frame
+struct ByteRange
+{
+  int64_t offset{};
+  int64_t size{};
+
+  bool operator==(const ByteRange &other) const
+  {
+    return this->offset == other.offset && this->size == other.size;
+  }
+};
+
+// Loading of a region of a frame is supported for planar formats (also with interleaved U and V
+// planes). Packed formats and planar formats with interleaved U, V and alpha planes are not
+// supported.
+bool isRegionLoadingSupported(const PixelFormatYUV &format);
+
+// Get the region that has to be loaded and converted so that the given region is converted
+// correctly. The region is extended by 2 chroma samples in every direction (the chroma
+// interpolation at the border of the region uses the neighboring chroma samples), aligned to the
+// chroma subsampling and clipped to the frame.
+FrameRegion getRegionForConversion(const FrameRegion    &region,
+                                   const PixelFormatYUV &format,
+                                   const Size            frameSize);
+
+// Get the ranges of bytes in the raw frame that contain the rows of the (aligned) region. There is
+// one range per plane. The rows are not cropped horizontally because reading full rows is just
+// as fast as reading parts of the rows.
+std::vector<ByteRange> getRegionByteRanges(const PixelFormatYUV &format,
+                                           const Size            frameSize,
+                                           const FrameRegion    &region);
+
+// If the byte ranges are read one after the other into one buffer, this is where they end up.
+std::vector<ByteRange> getConcatenatedByteRanges(const std::vector<ByteRange> &ranges);
+
+// Copy the (aligned) region out of the given data. planeRows must contain the position of the rows
+// of every plane in data (in the order of getRegionByteRanges). The result is a raw frame of the
+// size of the region in the same format. Returns an empty buffer if data is too small.
+QByteArray copyRegion(const QByteArray             &data,
+                      const std::vector<ByteRange> &planeRows,
+                      const PixelFormatYUV         &format,
+                      const Size                    frameSize,
+                      const FrameRegion            &region);
+
+} // namespace video::yuv
@@ -0,0 +1,596 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "ObjectiveMetrics.h"
+
+#include <video/yuv/videoHandlerYUV.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define OBJECTIVE_METRICS_X86 1
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSE4_1 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE4_1
+#define TARGET_AVX2
+#endif
+#else
+#define OBJECTIVE_METRICS_X86 0
+#endif
+
+namespace video::yuv::metrics
+{
+
+namespace
+{
+
+using functions::InstructionSet;
+
+constexpr auto SSIM_BLOCK_SIZE  = 4u;
+constexpr auto SSIM_WINDOW_SIZE = 2 * SSIM_BLOCK_SIZE;
+
+constexpr std::array<double, 5> MSSSIM_WEIGHTS = {0.0448, 0.2856, 0.3001, 0.2363, 0.1333};
+
+Size getOverlappingSize(const Plane &plane0, const Plane &plane1)
+{
+  return Size(std::min(plane0.size.width, plane1.size.width),
+              std::min(plane0.size.height, plane1.size.height));
+}
+
+const unsigned char *getLineStart(const Plane &plane, const unsigned y)
+{
+  const auto bytesPerSample = (plane.bitsPerSample > 8) ? 2u : 1u;
+  return plane.data + size_t(y) * plane.size.width * plane.valueSkip * bytesPerSample;
+}
+
+// Read the first nrValues samples of line y and scale them up by shift bits
+void readLine(const Plane &plane,
+              const unsigned y,
+              const unsigned nrValues,
+              const unsigned shift,
+              int32_t       *dst)
+{
+  const auto src  = getLineStart(plane, y);
+  const auto skip = plane.valueSkip;
+  if (plane.bitsPerSample <= 8)
+  {
+    for (unsigned i = 0; i < nrValues; i++)
+      dst[i] = src[i * skip] << shift;
+  }
+  else if (plane.bigEndian)
+  {
+    for (unsigned i = 0; i < nrValues; i++)
+      dst[i] = (src[i * skip * 2] << 8 | src[i * skip * 2 + 1]) << shift;
+  }
+  else
+  {
+    for (unsigned i = 0; i < nrValues; i++)
+      dst[i] = (src[i * skip * 2] | src[i * skip * 2 + 1] << 8) << shift;
+  }
+}
+
+// Create a function that reads the overlapping part of a line of both planes (scaled to bitDepth)
+auto createLinesReader(const Plane &plane0, const Plane &plane1, const unsigned bitDepth)
+{
+  const auto width  = getOverlappingSize(plane0, plane1).width;
+  const auto shift0 = bitDepth - plane0.bitsPerSample;
+  const auto shift1 = bitDepth - plane1.bitsPerSample;
+  return [&plane0, &plane1, width, shift0, shift1](
+             const unsigned y, int32_t *line0, int32_t *line1) {
+    readLine(plane0, y, width, shift0, line0);
+    readLine(plane1, y, width, shift1, line1);
+  };
+}
+
+// ------------------ Sum of squared errors ------------------
+
+uint64_t sumOfSquaredErrorsLineScalar(const int32_t *line0,
+                                      const int32_t *line1,
+                                      const unsigned nrValues)
+{
+  uint64_t sum = 0;
+  for (unsigned i = 0; i < nrValues; i++)
+  {
+    const int64_t diff = line0[i] - line1[i];
+    sum += uint64_t(diff * diff);
+  }
+  return sum;
+}
+
+#if OBJECTIVE_METRICS_X86
+
+// The vectorized kernels calculate the differences in 16 bit. This is possible for 8 bit samples
+// and for little endian samples with up to 15 bit (the difference of two 15 bit values fits into
+// a signed 16 bit value). The squares are summed up in pairs to 32 bit and accumulated in 64 bit.
+
+template <bool TwoBytes>
+TARGET_SSE4_1 uint64_t sumOfSquaredErrorsLineSSE41(const unsigned char *src0,
+                                                   const unsigned char *src1,
+                                                   const unsigned       nrValues)
+{
+  auto     accumulator = _mm_setzero_si128();
+  unsigned i           = 0;
+  for (; i + 8 <= nrValues; i += 8)
+  {
+    __m128i values0, values1;
+    if constexpr (TwoBytes)
+    {
+      values0 = _mm_loadu_si128((const __m128i *)(src0 + i * 2));
+      values1 = _mm_loadu_si128((const __m128i *)(src1 + i * 2));
+    }
+    else
+    {
+      values0 = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)(src0 + i)));
+      values1 = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)(src1 + i)));
+    }
+    const auto diff    = _mm_sub_epi16(values0, values1);
+    const auto squares = _mm_madd_epi16(diff, diff);
+    accumulator        = _mm_add_epi64(accumulator, _mm_cvtepu32_epi64(squares));
+    accumulator = _mm_add_epi64(accumulator, _mm_cvtepu32_epi64(_mm_srli_si128(squares, 8)));
+  }
+
+  uint64_t partialSums[2];
+  _mm_storeu_si128((__m128i *)partialSums, accumulator);
+  auto sum = partialSums[0] + partialSums[1];
+
+  for (; i < nrValues; i++)
+  {
+    const int value0 = TwoBytes ? (src0[i * 2] | src0[i * 2 + 1] << 8) : src0[i];
+    const int value1 = TwoBytes ? (src1[i * 2] | src1[i * 2 + 1] << 8) : src1[i];
+    sum += uint64_t((value0 - value1) * (value0 - value1));
+  }
+  return sum;
+}
+
+template <bool TwoBytes>
+TARGET_AVX2 uint64_t sumOfSquaredErrorsLineAVX2(const unsigned char *src0,
+                                                const unsigned char *src1,
+                                                const unsigned       nrValues)
+{
+  auto     accumulator = _mm256_setzero_si256();
+  unsigned i           = 0;
+  for (; i + 16 <= nrValues; i += 16)
+  {
+    __m256i values0, values1;
+    if constexpr (TwoBytes)
+    {
+      values0 = _mm256_loadu_si256((const __m256i *)(src0 + i * 2));
+      values1 = _mm256_loadu_si256((const __m256i *)(src1 + i * 2));
+    }
+    else
+    {
+      values0 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(src0 + i)));
+      values1 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(src1 + i)));
+    }
+    const auto diff    = _mm256_sub_epi16(values0, values1);
+    const auto squares = _mm256_madd_epi16(diff, diff);
+    accumulator =
+        _mm256_add_epi64(accumulator, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(squares)));
+    accumulator =
+        _mm256_add_epi64(accumulator, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(squares, 1)));
+  }
+
+  uint64_t partialSums[4];
+  _mm256_storeu_si256((__m256i *)partialSums, accumulator);
+  auto sum = partialSums[0] + partialSums[1] + partialSums[2] + partialSums[3];
+
+  for (; i < nrValues; i++)
+  {
+    const int value0 = TwoBytes ? (src0[i * 2] | src0[i * 2 + 1] << 8) : src0[i];
+    const int value1 = TwoBytes ? (src1[i * 2] | src1[i * 2 + 1] << 8) : src1[i];
+    sum += uint64_t((value0 - value1) * (value0 - value1));
+  }
+  return sum;
+}
+
+#endif
+
+bool canUseVectorizedKernels(const Plane &plane0, const Plane &plane1)
+{
+  if (plane0.bitsPerSample != plane1.bitsPerSample || plane0.valueSkip != 1 ||
+      plane1.valueSkip != 1)
+    return false;
+  if (plane0.bitsPerSample <= 8)
+    return true;
+  return plane0.bitsPerSample <= 15 && !plane0.bigEndian && !plane1.bigEndian;
+}
+
+// ------------------ SSIM ------------------
+
+struct BlockSums
+{
+  int64_t sum0{};
+  int64_t sum1{};
+  int64_t sumSquares{};
+  int64_t sumProducts{};
+};
+
+// Calculate the SSIM of two sources with the given size. readLines(y, line0, line1) must fill
+// line0 and line1 with the first size.width values of line y of the two sources.
+template <typename ReadLinesFunction>
+SSIMResult
+calculateSSIMOfSources(const Size size, const unsigned bitDepth, ReadLinesFunction readLines)
+{
+  const auto blocksX = size.width / SSIM_BLOCK_SIZE;
+  const auto blocksY = size.height / SSIM_BLOCK_SIZE;
+  if (size.width < SSIM_WINDOW_SIZE || size.height < SSIM_WINDOW_SIZE)
+    return {std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN()};
+
+  const auto maxValue = double((1 << bitDepth) - 1);
+  const auto c1       = (0.01 * maxValue) * (0.01 * maxValue);
+  const auto c2       = (0.03 * maxValue) * (0.03 * maxValue);
+
+  std::vector<int32_t>   line0(size.width);
+  std::vector<int32_t>   line1(size.width);
+  std::vector<BlockSums> previousBlockRow(blocksX);
+  std::vector<BlockSums> currentBlockRow(blocksX);
+
+  double ssimSum              = 0.0;
+  double contrastStructureSum = 0.0;
+  for (unsigned blockY = 0; blockY < blocksY; blockY++)
+  {
+    std::fill(currentBlockRow.begin(), currentBlockRow.end(), BlockSums());
+    for (unsigned lineInBlock = 0; lineInBlock < SSIM_BLOCK_SIZE; lineInBlock++)
+    {
+      readLines(blockY * SSIM_BLOCK_SIZE + lineInBlock, line0.data(), line1.data());
+      for (unsigned blockX = 0; blockX < blocksX; blockX++)
+      {
+        auto &sums = currentBlockRow[blockX];
+        for (unsigned i = blockX * SSIM_BLOCK_SIZE; i < (blockX + 1) * SSIM_BLOCK_SIZE; i++)
+        {
+          const int64_t value0 = line0[i];
+          const int64_t value1 = line1[i];
+          sums.sum0 += value0;
+          sums.sum1 += value1;
+          sums.sumSquares += value0 * value0 + value1 * value1;
+          sums.sumProducts += value0 * value1;
+        }
+      }
+    }
+
+    if (blockY > 0)
+    {
+      // Every window consists of 2x2 blocks
+      for (unsigned blockX = 1; blockX < blocksX; blockX++)
+      {
+        BlockSums window;
+        for (const auto &blockSums : {previousBlockRow[blockX - 1],
+                                      previousBlockRow[blockX],
+                                      currentBlockRow[blockX - 1],
+                                      currentBlockRow[blockX]})
+        {
+          window.sum0 += blockSums.sum0;
+          window.sum1 += blockSums.sum1;
+          window.sumSquares += blockSums.sumSquares;
+          window.sumProducts += blockSums.sumProducts;
+        }
+
+        constexpr auto nrSamples  = double(SSIM_WINDOW_SIZE * SSIM_WINDOW_SIZE);
+        const auto     mean0      = double(window.sum0) / nrSamples;
+        const auto     mean1      = double(window.sum1) / nrSamples;
+        const auto     covariance = double(window.sumProducts) / nrSamples - mean0 * mean1;
+        // The sum of the variances of both windows
+        const auto variances =
+            double(window.sumSquares) / nrSamples - mean0 * mean0 - mean1 * mean1;
+
+        const auto luminance = (2.0 * mean0 * mean1 + c1) / (mean0 * mean0 + mean1 * mean1 + c1);
+        const auto contrastStructure = (2.0 * covariance + c2) / (variances + c2);
+        ssimSum += luminance * contrastStructure;
+        contrastStructureSum += contrastStructure;
+      }
+    }
+
+    std::swap(previousBlockRow, currentBlockRow);
+  }
+
+  const auto nrWindows = double(blocksX - 1) * double(blocksY - 1);
+  return {ssimSum / nrWindows, contrastStructureSum / nrWindows};
+}
+
+// Two sources that were downsampled for the MS-SSIM
+struct DownsampledSources
+{
+  Size                  size;
+  std::vector<uint16_t> samples[2];
+
+  void readLines(const unsigned y, int32_t *line0, int32_t *line1) const
+  {
+    const auto offset = size_t(y) * this->size.width;
+    std::copy_n(this->samples[0].begin() + offset, this->size.width, line0);
+    std::copy_n(this->samples[1].begin() + offset, this->size.width, line1);
+  }
+};
+
+// Downsample the two sources by averaging 2x2 samples
+template <typename ReadLinesFunction>
+DownsampledSources downsampleSources(const Size size, ReadLinesFunction readLines)
+{
+  DownsampledSources downsampled;
+  downsampled.size = Size(size.width / 2, size.height / 2);
+  for (auto &samples : downsampled.samples)
+    samples.resize(size_t(downsampled.size.width) * downsampled.size.height);
+
+  std::vector<int32_t> lines[2][2];
+  for (auto &linePair : lines)
+    for (auto &line : linePair)
+      line.resize(size.width);
+
+  for (unsigned y = 0; y < downsampled.size.height; y++)
+  {
+    readLines(2 * y, lines[0][0].data(), lines[1][0].data());
+    readLines(2 * y + 1, lines[0][1].data(), lines[1][1].data());
+    for (unsigned source = 0; source < 2; source++)
+    {
+      auto dst = downsampled.samples[source].begin() + size_t(y) * downsampled.size.width;
+      for (unsigned x = 0; x < downsampled.size.width; x++)
+      {
+        const auto &top    = lines[source][0];
+        const auto &bottom = lines[source][1];
+        const auto  sum    = top[2 * x] + top[2 * x + 1] + bottom[2 * x] + bottom[2 * x + 1];
+        dst[x]             = uint16_t((sum + 2) >> 2);
+      }
+    }
+  }
+  return downsampled;
+}
+
+// ------------------ Frames ------------------
+
+// Get the frame data in a planar format. Packed formats are converted.
+bool getPlanarFrame(const QByteArray     &frame,
+                    const PixelFormatYUV &format,
+                    const Size            frameSize,
+                    QByteArray           &planarFrame,
+                    PixelFormatYUV       &planarFormat)
+{
+  if (format.isPlanar())
+  {
+    planarFrame  = frame;
+    planarFormat = format;
+    return true;
+  }
+
+  bool conversionOK = false;
+  if (auto predefinedFormat = format.getPredefinedFormat())
+  {
+    if (*predefinedFormat == PredefinedPixelFormat::V210)
+      std::tie(conversionOK, planarFormat) =
+          convertV210PackedToPlanar(frame, planarFrame, frameSize);
+  }
+  else
+    std::tie(conversionOK, planarFormat) =
+        convertYUVPackedToPlanar(frame, planarFrame, frameSize, format);
+  return conversionOK;
+}
+
+std::array<Plane, 3>
+getPlanes(const QByteArray &planarFrame, const PixelFormatYUV &format, const Size frameSize)
+{
+  const auto bitsPerSample  = format.getBitsPerSample();
+  const auto bytesPerSample = (bitsPerSample > 8) ? 2u : 1u;
+  const auto chromaSize     = Size(frameSize.width / format.getSubsamplingHor(),
+                               frameSize.height / format.getSubsamplingVer());
+  const auto nrBytesLuma    = size_t(frameSize.width) * frameSize.height * bytesPerSample;
+  const auto nrBytesChroma  = size_t(chromaSize.width) * chromaSize.height * bytesPerSample;
+
+  // See convertYUVPlanarToRGB for the layout of the planes
+  const auto planeOrder  = format.getPlaneOrder();
+  const auto uPlaneFirst = (planeOrder == PlaneOrder::YUV || planeOrder == PlaneOrder::YUVA);
+  const auto hasAlpha    = (planeOrder == PlaneOrder::YUVA || planeOrder == PlaneOrder::YVUA);
+
+  auto valueSkip               = 1;
+  auto offsetToNextChromaPlane = nrBytesChroma;
+  if (format.isUVInterleaved())
+  {
+    valueSkip               = hasAlpha ? 3 : 2;
+    offsetToNextChromaPlane = bytesPerSample;
+  }
+
+  const auto bigEndian = format.isBigEndian();
+  const auto srcY      = reinterpret_cast<const unsigned char *>(planarFrame.constData());
+  const auto srcU      = srcY + nrBytesLuma + (uPlaneFirst ? 0 : offsetToNextChromaPlane);
+  const auto srcV      = srcY + nrBytesLuma + (uPlaneFirst ? offsetToNextChromaPlane : 0);
+
+  return {Plane({srcY, frameSize, bitsPerSample, bigEndian, 1}),
+          Plane({srcU, chromaSize, bitsPerSample, bigEndian, valueSkip}),
+          Plane({srcV, chromaSize, bitsPerSample, bigEndian, valueSkip})};
+}
+
+} // namespace
+
+uint64_t sumOfSquaredErrors(const Plane                    &plane0,
+                            const Plane                    &plane1,
+                            const unsigned                  bitDepth,
+                            const functions::InstructionSet instructionSet)
+{
+  const auto size = getOverlappingSize(plane0, plane1);
+
+#if OBJECTIVE_METRICS_X86
+  if (instructionSet != InstructionSet::Scalar && canUseVectorizedKernels(plane0, plane1))
+  {
+    const auto twoBytes = plane0.bitsPerSample > 8;
+    using LineFunction = uint64_t (*)(const unsigned char *, const unsigned char *, unsigned);
+    LineFunction sumLine;
+    if (instructionSet == InstructionSet::AVX2)
+      sumLine = twoBytes ? sumOfSquaredErrorsLineAVX2<true> : sumOfSquaredErrorsLineAVX2<false>;
+    else
+      sumLine = twoBytes ? sumOfSquaredErrorsLineSSE41<true> : sumOfSquaredErrorsLineSSE41<false>;
+
+    uint64_t sum = 0;
+    for (unsigned y = 0; y < size.height; y++)
+      sum += sumLine(getLineStart(plane0, y), getLineStart(plane1, y), size.width);
+    return sum;
+  }
+#else
+  (void)instructionSet;
+#endif
+
+  const auto           shift0 = bitDepth - plane0.bitsPerSample;
+  const auto           shift1 = bitDepth - plane1.bitsPerSample;
+  std::vector<int32_t> line0(size.width);
+  std::vector<int32_t> line1(size.width);
+
+  uint64_t sum = 0;
+  for (unsigned y = 0; y < size.height; y++)
+  {
+    readLine(plane0, y, size.width, shift0, line0.data());
+    readLine(plane1, y, size.width, shift1, line1.data());
+    sum += sumOfSquaredErrorsLineScalar(line0.data(), line1.data(), size.width);
+  }
+  return sum;
+}
+
+double calculatePSNR(const double mse, const unsigned bitDepth)
+{
+  if (mse <= 0.0)
+    return std::numeric_limits<double>::infinity();
+  const auto maxValue = double((1 << bitDepth) - 1);
+  return 10.0 * std::log10(maxValue * maxValue / mse);
+}
+
+SSIMResult calculateSSIM(const Plane &plane0, const Plane &plane1, const unsigned bitDepth)
+{
+  const auto size = getOverlappingSize(plane0, plane1);
+  return calculateSSIMOfSources(size, bitDepth, createLinesReader(plane0, plane1, bitDepth));
+}
+
+double calculateMSSSIM(const Plane &plane0, const Plane &plane1, const unsigned bitDepth)
+{
+  const auto size = getOverlappingSize(plane0, plane1);
+
+  unsigned nrScales  = 0;
+  double   weightSum = 0.0;
+  auto     scaleSize = size;
+  while (nrScales < MSSSIM_WEIGHTS.size() && scaleSize.width >= SSIM_WINDOW_SIZE &&
+         scaleSize.height >= SSIM_WINDOW_SIZE)
+  {
+    weightSum += MSSSIM_WEIGHTS[nrScales];
+    scaleSize = Size(scaleSize.width / 2, scaleSize.height / 2);
+    nrScales++;
+  }
+  if (nrScales == 0)
+    return std::numeric_limits<double>::quiet_NaN();
+
+  // Negative contrast/structure values (anti correlated content) are clipped to 0
+  auto weightedTerm = [&](const double value, const unsigned scale) {
+    return std::pow(std::max(value, 0.0), MSSSIM_WEIGHTS[scale] / weightSum);
+  };
+
+  const auto readPlanes = createLinesReader(plane0, plane1, bitDepth);
+  const auto firstScale = calculateSSIMOfSources(size, bitDepth, readPlanes);
+  if (nrScales == 1)
+    return firstScale.ssim;
+
+  auto msssim      = weightedTerm(firstScale.contrastStructure, 0);
+  auto downsampled = downsampleSources(size, readPlanes);
+  for (unsigned scale = 1; scale < nrScales; scale++)
+  {
+    auto readDownsampled = [&downsampled](const unsigned y, int32_t *line0, int32_t *line1) {
+      downsampled.readLines(y, line0, line1);
+    };
+    const auto result      = calculateSSIMOfSources(downsampled.size, bitDepth, readDownsampled);
+    const auto isLastScale = (scale == nrScales - 1);
+    if (isLastScale)
+      msssim *= weightedTerm(result.ssim, scale);
+    else
+    {
+      msssim *= weightedTerm(result.contrastStructure, scale);
+      downsampled = downsampleSources(downsampled.size, readDownsampled);
+    }
+  }
+  return msssim;
+}
+
+std::optional<FrameMetrics> calculateFrameMetrics(const QByteArray     &frame0,
+                                                  const PixelFormatYUV &format0,
+                                                  const Size            frameSize0,
+                                                  const QByteArray     &frame1,
+                                                  const PixelFormatYUV &format1,
+                                                  const Size            frameSize1,
+                                                  std::string          *errorMessage)
+{
+  auto setError = [errorMessage](const std::string &message) {
+    if (errorMessage)
+      *errorMessage = message;
+    return std::nullopt;
+  };
+
+  if (!format0.canConvertToRGB(frameSize0) || !format1.canConvertToRGB(frameSize1))
+    return setError("The pixel format of an input is not supported.");
+  if (format0.getSubsampling() != format1.getSubsampling())
+    return setError("The chroma subsampling of the inputs differs.");
+  if (frame0.size() < format0.bytesPerFrame(frameSize0) ||
+      frame1.size() < format1.bytesPerFrame(frameSize1))
+    return setError("The frame data of an input is incomplete.");
+
+  QByteArray     planarFrames[2];
+  PixelFormatYUV planarFormats[2];
+  if (!getPlanarFrame(frame0, format0, frameSize0, planarFrames[0], planarFormats[0]) ||
+      !getPlanarFrame(frame1, format1, frameSize1, planarFrames[1], planarFormats[1]))
+    return setError("Converting a packed input to planar failed.");
+
+  const auto planes0  = getPlanes(planarFrames[0], planarFormats[0], frameSize0);
+  const auto planes1  = getPlanes(planarFrames[1], planarFormats[1], frameSize1);
+  const auto bitDepth = std::max(planarFormats[0].getBitsPerSample(),
+                                 planarFormats[1].getBitsPerSample());
+
+  const auto nrComponents = (format0.getSubsampling() == Subsampling::YUV_400) ? 1u : 3u;
+
+  FrameMetrics metrics;
+  for (unsigned c = 0; c < nrComponents; c++)
+  {
+    const auto size      = getOverlappingSize(planes0[c], planes1[c]);
+    const auto nrSamples = double(size.width) * double(size.height);
+    const auto sse       = sumOfSquaredErrors(planes0[c], planes1[c], bitDepth);
+    metrics.mse[c]       = double(sse) / nrSamples;
+    metrics.psnr[c]      = calculatePSNR(metrics.mse[c], bitDepth);
+  }
+
+  if (nrComponents == 1)
+    metrics.weightedPSNR = metrics.psnr[0];
+  else
+    metrics.weightedPSNR = (6.0 * metrics.psnr[0] + metrics.psnr[1] + metrics.psnr[2]) / 8.0;
+
+  metrics.ssim   = calculateSSIM(planes0[0], planes1[0], bitDepth).ssim;
+  metrics.msssim = calculateMSSSIM(planes0[0], planes1[0], bitDepth);
+  return metrics;
+}
+
+} // namespace video::yuv::metrics
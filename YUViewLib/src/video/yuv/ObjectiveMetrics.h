@@ -0,0 +1,114 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <common/CpuFeatures.h>
+#include <video/yuv/PixelFormatYUV.h>
+
+#include <QByteArray>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace video::yuv::metrics
+{
+
+// One plane of a planar YUV frame. Samples with more than 8 bit are stored in two bytes. If the
+// chroma planes are interleaved, valueSkip is the distance (in samples) from one value to the next.
+struct Plane
+{
+  const unsigned char *data{};
+  Size                 size;
+  unsigned             bitsPerSample{8};
+  bool                 bigEndian{};
+  int                  valueSkip{1};
+};
+
+// All functions compare the top left aligned part of the two planes that overlaps. If the bit
+// depth of the two planes differs, the plane with the lower bit depth is scaled up to bitDepth
+// (which must be the maximum of the two bit depths).
+
+// The sum of the squared differences of all samples.
+uint64_t sumOfSquaredErrors(
+    const Plane                    &plane0,
+    const Plane                    &plane1,
+    const unsigned                  bitDepth,
+    const functions::InstructionSet instructionSet = functions::getSupportedInstructionSet());
+
+// Identical planes have an infinite PSNR.
+double calculatePSNR(const double mse, const unsigned bitDepth);
+
+struct SSIMResult
+{
+  double ssim{};
+  // The mean of the contrast and structure term only (without the luminance term). This is used
+  // for the lower scales of the MS-SSIM.
+  double contrastStructure{};
+};
+
+// The SSIM is calculated in 8x8 windows that overlap by 4 samples in each direction (like x264
+// and libvpx do it) and averaged over all windows. The planes must be at least 8x8 samples large.
+SSIMResult calculateSSIM(const Plane &plane0, const Plane &plane1, const unsigned bitDepth);
+
+// The multi scale SSIM with the 5 scales and weights from Wang et al. Every scale is downsampled
+// from the previous one by averaging 2x2 samples. If the planes are too small for all 5 scales,
+// only the scales that are at least 8x8 samples large are used and the weights are renormalized.
+double calculateMSSSIM(const Plane &plane0, const Plane &plane1, const unsigned bitDepth);
+
+struct FrameMetrics
+{
+  // For Y, U and V. The chroma values are 0 for 4:0:0 content.
+  double mse[3]{};
+  double psnr[3]{};
+  // The PSNR of the three components weighted 6:1:1 (Y:U:V) as it is used in the common test
+  // conditions of JVET.
+  double weightedPSNR{};
+  // The structural similarity of the luma component
+  double ssim{};
+  double msssim{};
+};
+
+// Calculate all metrics for the two raw frames. Packed formats are converted to planar first. The
+// frames must have the same chroma subsampling. If the metrics can not be calculated, the reason
+// is returned in errorMessage (if given).
+std::optional<FrameMetrics> calculateFrameMetrics(const QByteArray     &frame0,
+                                                  const PixelFormatYUV &format0,
+                                                  const Size            frameSize0,
+                                                  const QByteArray     &frame1,
+                                                  const PixelFormatYUV &format1,
+                                                  const Size            frameSize1,
+                                                  std::string          *errorMessage = nullptr);
+
+} // namespace video::yuv::metrics
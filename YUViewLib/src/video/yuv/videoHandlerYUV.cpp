@@ -44,13 +44,17 @@
 #include <xmmintrin.h>
 #endif
 #include <QDir>
+#include <QMetaMethod>
 #include <QPainter>
+#include <QtConcurrent>
 
 #include <common/Formatting.h>
 #include <common/Functions.h>
 #include <common/FunctionsGui.h>
 #include <common/InfoItemAndData.h>
+#include <video/FrameBufferPool.h>
 #include <video/LimitedRangeToFullRange.h>
+#include <video/yuv/ConversionYUVSIMD.h>
 #include <video/yuv/PixelFormatYUVGuess.h>
 #include <video/yuv/videoHandlerYUVCustomFormatDialog.h>
 
@@ -133,6 +137,8 @@ bool isFullRange(const ColorConversion colorConversion)
          colorConversion == ColorConversion::BT2020_FullRange;
 }
 
+} // namespace
+
 std::pair<bool, PixelFormatYUV> convertYUVPackedToPlanar(const QByteArray     &sourceBuffer,
                                                          QByteArray           &targetBuffer,
                                                          const Size            curFrameSize,
@@ -382,6 +388,9 @@ std::pair<bool, PixelFormatYUV> convertV210PackedToPlanar(const QByteArray &sour
   return {true, newFormat};
 }
 
+namespace
+{
+
 yuv_t getPixelValueV210(const QByteArray &sourceBuffer,
                         const Size       &curFrameSize,
                         const QPoint     &pixelPos)
@@ -1988,11 +1997,188 @@ inline void YUVPlaneToRGB_411(const int            w,
   }
 }
 
+// When converting a frame in parallel, each stripe has at least this many lines. For smaller
+// stripes the overhead of starting the tasks is larger than the gain.
+constexpr unsigned MIN_LINES_PER_STRIPE = 64;
+
+// Split the frame into horizontal stripes and convert them in parallel in the shared thread pool.
+// Every output line is calculated independently (including the chroma interpolation from the
+// lines above and below), so the output is identical to the serial conversion.
+void convertPlanarYUVToARGBInStripes(const simd::PlanarSource         &source,
+                                     const simd::ConversionParameters &parameters,
+                                     unsigned char                    *targetBuffer)
+{
+  auto       threadPool = functions::getSharedThreadPool();
+  const auto height     = parameters.frameSize.height;
+  const auto maxStripes = unsigned(threadPool->maxThreadCount()) + 1;
+  const auto nrStripes  = std::clamp(height / MIN_LINES_PER_STRIPE, 1u, maxStripes);
+  const auto linesPerStripe = (height + nrStripes - 1) / nrStripes;
+
+  QList<QFuture<void>> stripeFutures;
+  for (unsigned stripe = 1; stripe < nrStripes; stripe++)
+  {
+    const auto lines = Range<unsigned>({std::min(stripe * linesPerStripe, height),
+                                        std::min((stripe + 1) * linesPerStripe, height)});
+    stripeFutures.append(QtConcurrent::run(threadPool, [source, parameters, targetBuffer, lines]() {
+      simd::convertPlanarYUVToARGB(source, parameters, targetBuffer, lines);
+    }));
+  }
+
+  // The calling thread converts the first stripe
+  simd::convertPlanarYUVToARGB(
+      source, parameters, targetBuffer, Range<unsigned>({0, std::min(linesPerStripe, height)}));
+
+  for (auto &future : stripeFutures)
+    future.waitForFinished();
+}
+
+// Convert the planar YUV data using the line based kernels from ConversionYUVSIMD. Returns false if
+// the kernels do not support the format or if they would not be faster than the scalar conversion
+// functions (no supported vector instruction set and no parallel conversion). In this case, the
+// scalar conversion functions must be used.
+bool convertYUVPlanarToRGBSIMD(const simd::PlanarSource &source,
+                               unsigned char            *targetBuffer,
+                               const Size                frameSize,
+                               const PixelFormatYUV     &format,
+                               const ConversionSettings &conversionSettings,
+                               const bool                reduceTo8Bit,
+                               const bool                convertInParallel)
+{
+  if (functions::getSupportedInstructionSet() == functions::InstructionSet::Scalar &&
+      !convertInParallel)
+    return false;
+
+  simd::ConversionParameters parameters;
+  parameters.frameSize           = frameSize;
+  parameters.subsampling         = format.getSubsampling();
+  parameters.bitsPerSample       = format.getBitsPerSample();
+  parameters.bigEndian           = format.isBigEndian();
+  parameters.chromaInterpolation = conversionSettings.chromaInterpolation;
+  parameters.colorConversion     = conversionSettings.colorConversion;
+  parameters.mathY               = conversionSettings.mathParameters.at(Component::Luma);
+  parameters.mathC               = conversionSettings.mathParameters.at(Component::Chroma);
+  parameters.reduceTo8Bit        = reduceTo8Bit;
+  if (!simd::supportsConversion(parameters))
+    return false;
+
+  if (convertInParallel)
+    convertPlanarYUVToARGBInStripes(source, parameters, targetBuffer);
+  else
+    simd::convertPlanarYUVToARGB(source, parameters, targetBuffer);
+  return true;
+}
+
+// 8/10 bit 4:2:0, nearest neighbor, chroma offset (0,1) (the default for 4:2:0), all components
+// displayed and no yuv math. We can use a specialized function for this.
+bool useSpecializedYUV420Conversion(const PixelFormatYUV     &format,
+                                    const ConversionSettings &conversionSettings)
+{
+  return (format.getBitsPerSample() == 8 || format.getBitsPerSample() == 10) &&
+         format.getSubsampling() == Subsampling::YUV_420 &&
+         conversionSettings.chromaInterpolation == ChromaInterpolation::NearestNeighbor &&
+         format.getChromaOffset().x == 0 && format.getChromaOffset().y == 1 &&
+         conversionSettings.componentDisplayMode == ComponentDisplayMode::DisplayAll &&
+         !format.isUVInterleaved() &&
+         !conversionSettings.mathParameters.at(Component::Luma).mathRequired() &&
+         !conversionSettings.mathParameters.at(Component::Chroma).mathRequired();
+}
+
+// Create the output image in the right format. The pixel data is in a buffer from the
+// FrameBufferPool.
+// In both cases, we will set the alpha channel to 255. The format of the raw buffer is: BGRA
+// (each 8 bit). Internally, this is how QImage allocates the number of bytes per line (with depth
+// = 32): const int bytes_per_line = ((width * depth + 31) >> 5) << 2; // bytes per scanline (must
+// be multiple of 4)
+QImage createOutputImage(const Size &curFrameSize, const bool hasAlpha)
+{
+  QImage     outputImage;
+  auto      &pool                = FrameBufferPool::shared();
+  const auto qFrameSize          = QSize(int(curFrameSize.width), int(curFrameSize.height));
+  const auto platformImageFormat = functionsGui::platformImageFormat(hasAlpha);
+  if (is_Q_OS_WIN || is_Q_OS_MAC)
+    outputImage = pool.allocateImage(qFrameSize, platformImageFormat);
+  else if (is_Q_OS_LINUX)
+  {
+    if (platformImageFormat == QImage::Format_ARGB32_Premultiplied ||
+        platformImageFormat == QImage::Format_ARGB32)
+      outputImage = pool.allocateImage(qFrameSize, platformImageFormat);
+    else
+      outputImage = pool.allocateImage(qFrameSize, QImage::Format_RGB32);
+  }
+
+  // Check the image buffer size before we write to it
+#if QT_VERSION < QT_VERSION_CHECK(5, 10, 0)
+  assert(functions::clipToUnsigned(outputImage.byteCount()) >=
+         curFrameSize.width * curFrameSize.height * 4);
+#else
+  assert(functions::clipToUnsigned(outputImage.sizeInBytes()) >=
+         curFrameSize.width * curFrameSize.height * 4);
+#endif
+  return outputImage;
+}
+
+void convertToPlatformImageFormat(QImage &outputImage, const bool hasAlpha)
+{
+  if (is_Q_OS_LINUX)
+  {
+    // On linux, we may have to convert the image to the platform image format if it is not one of
+    // the RGBA formats.
+    auto format = functionsGui::platformImageFormat(hasAlpha);
+    if (format != QImage::Format_ARGB32_Premultiplied && format != QImage::Format_ARGB32 &&
+        format != QImage::Format_RGB32)
+      outputImage = outputImage.convertToFormat(format);
+  }
+}
+
+// Convert the planes of the view directly (without packing them first) using the vectorized
+// kernels. Returns false if this is not possible. The result is identical to the conversion of the
+// packed frame.
+bool convertYUVPlanesToRGBSIMD(const RawFrameView       &rawFrame,
+                               unsigned char            *targetBuffer,
+                               const Size                curFrameSize,
+                               const PixelFormatYUV     &format,
+                               const ConversionSettings &conversionSettings,
+                               const bool                convertInParallel)
+{
+  const auto &planes = rawFrame.getPlanes();
+  if (!format.isPlanar() || format.isUVInterleaved() || format.hasAlpha() || planes.size() < 3 ||
+      format.getSubsampling() == Subsampling::YUV_400 ||
+      conversionSettings.componentDisplayMode != ComponentDisplayMode::DisplayAll)
+    return false;
+
+  // Same as in convertYUVToImage and convertYUVPlanarToRGB
+  const auto reduceTo8Bit = useSpecializedYUV420Conversion(format, conversionSettings);
+  if (reduceTo8Bit && format.getBitsPerSample() == 10 && format.isBigEndian())
+    return false;
+  if (!reduceTo8Bit && (format.getChromaOffset().x != 0 || format.getChromaOffset().y != 0) &&
+      conversionSettings.chromaInterpolation != ChromaInterpolation::NearestNeighbor)
+    return false;
+
+  const auto uPlaneFirst =
+      (format.getPlaneOrder() == PlaneOrder::YUV || format.getPlaneOrder() == PlaneOrder::YUVA);
+  const auto &planeU = uPlaneFirst ? planes[1] : planes[2];
+  const auto &planeV = uPlaneFirst ? planes[2] : planes[1];
+  if (planeU.stride != planeV.stride)
+    return false;
+
+  return convertYUVPlanarToRGBSIMD(
+      {planes[0].data, planeU.data, planeV.data, 1, planes[0].stride, planeU.stride},
+      targetBuffer,
+      curFrameSize,
+      format,
+      conversionSettings,
+      reduceTo8Bit,
+      convertInParallel);
+}
+
+} // namespace
+
 bool convertYUVPlanarToRGB(const QByteArray         &sourceBuffer,
                            uchar                    *targetBuffer,
                            const Size                curFrameSize,
                            const PixelFormatYUV     &sourceBufferFormat,
-                           const ConversionSettings &conversionSettings)
+                           const ConversionSettings &conversionSettings,
+                           const bool                convertInParallel)
 {
   // These are constant for the runtime of this function. This way, the compiler can optimize the
   // hell out of this function.
@@ -2163,6 +2349,15 @@ bool convertYUVPlanarToRGB(const QByteArray         &sourceBuffer,
                                     dstU,
                                     dstV);
 
+      if (convertYUVPlanarToRGBSIMD({srcY, dstU, dstV, 1},
+                                    dst,
+                                    curFrameSize,
+                                    format,
+                                    conversionSettings,
+                                    false,
+                                    convertInParallel))
+        return true;
+
       if (format.getSubsampling() == Subsampling::YUV_444)
         YUVPlaneToRGB_444(componentSizeLuma,
                           mathY,
@@ -2271,6 +2466,15 @@ bool convertYUVPlanarToRGB(const QByteArray         &sourceBuffer,
                                                ? srcY + nrBytesLumaPlane + nrBytesToNextChromaPlane
                                                : srcY + nrBytesLumaPlane;
 
+      if (convertYUVPlanarToRGBSIMD({srcY, srcU, srcV, inputValSkip},
+                                    dst,
+                                    curFrameSize,
+                                    format,
+                                    conversionSettings,
+                                    false,
+                                    convertInParallel))
+        return true;
+
       if (format.getSubsampling() == Subsampling::YUV_444)
         YUVPlaneToRGB_444(componentSizeLuma,
                           mathY,
@@ -2376,13 +2580,12 @@ bool convertYUVPlanarToRGB(const QByteArray         &sourceBuffer,
   return true;
 }
 
-// Convert the given raw YUV data in sourceBuffer (using srcPixelFormat) to image (RGB-888), using
-// the buffer tmpRGBBuffer for intermediate RGB values.
 void convertYUVToImage(const QByteArray         &sourceBuffer,
                        QImage                   &outputImage,
                        const PixelFormatYUV     &yuvFormat,
                        const Size               &curFrameSize,
-                       const ConversionSettings &conversionSettings)
+                       const ConversionSettings &conversionSettings,
+                       const bool                convertInParallel)
 {
   if (!yuvFormat.canConvertToRGB(curFrameSize) || sourceBuffer.isEmpty())
   {
@@ -2392,48 +2595,34 @@ void convertYUVToImage(const QByteArray         &sourceBuffer,
 
   DEBUG_YUV("videoHandlerYUV::convertYUVToImage");
 
-  // Create the output image in the right format.
-  // In both cases, we will set the alpha channel to 255. The format of the raw buffer is: BGRA
-  // (each 8 bit). Internally, this is how QImage allocates the number of bytes per line (with depth
-  // = 32): const int bytes_per_line = ((width * depth + 31) >> 5) << 2; // bytes per scanline (must
-  // be multiple of 4)
-  auto qFrameSize          = QSize(int(curFrameSize.width), int(curFrameSize.height));
-  auto platformImageFormat = functionsGui::platformImageFormat(yuvFormat.hasAlpha());
-  if (is_Q_OS_WIN || is_Q_OS_MAC)
-    outputImage = QImage(qFrameSize, platformImageFormat);
-  else if (is_Q_OS_LINUX)
-  {
-    if (platformImageFormat == QImage::Format_ARGB32_Premultiplied ||
-        platformImageFormat == QImage::Format_ARGB32)
-      outputImage = QImage(qFrameSize, platformImageFormat);
-    else
-      outputImage = QImage(qFrameSize, QImage::Format_RGB32);
-  }
-
-  // Check the image buffer size before we write to it
-#if QT_VERSION < QT_VERSION_CHECK(5, 10, 0)
-  assert(functions::clipToUnsigned(outputImage.byteCount()) >=
-         curFrameSize.width * curFrameSize.height * 4);
-#else
-  assert(functions::clipToUnsigned(outputImage.sizeInBytes()) >=
-         curFrameSize.width * curFrameSize.height * 4);
-#endif
+  outputImage = createOutputImage(curFrameSize, yuvFormat.hasAlpha());
 
   auto convOK = false;
   if (yuvFormat.isPlanar())
   {
-    if ((yuvFormat.getBitsPerSample() == 8 || yuvFormat.getBitsPerSample() == 10) &&
-        yuvFormat.getSubsampling() == Subsampling::YUV_420 &&
-        conversionSettings.chromaInterpolation == ChromaInterpolation::NearestNeighbor &&
-        yuvFormat.getChromaOffset().x == 0 && yuvFormat.getChromaOffset().y == 1 &&
-        conversionSettings.componentDisplayMode == ComponentDisplayMode::DisplayAll &&
-        !yuvFormat.isUVInterleaved() &&
-        !conversionSettings.mathParameters.at(Component::Luma).mathRequired() &&
-        !conversionSettings.mathParameters.at(Component::Chroma).mathRequired())
-    // 8/10 bit 4:2:0, nearest neighbor, chroma offset (0,1) (the default for 4:2:0), all components
-    // displayed and no yuv math. We can use a specialized function for this.
+    if (useSpecializedYUV420Conversion(yuvFormat, conversionSettings))
     {
-      if (yuvFormat.getBitsPerSample() == 8)
+      const auto bitsPerSample  = yuvFormat.getBitsPerSample();
+      const auto bytesPerSample = (bitsPerSample > 8) ? 2u : 1u;
+      const auto lumaBytes      = curFrameSize.width * curFrameSize.height * bytesPerSample;
+      const auto srcY           = (const unsigned char *)sourceBuffer.constData();
+      const auto uPlaneFirst    = yuvFormat.getPlaneOrder() == PlaneOrder::YUV ||
+                               yuvFormat.getPlaneOrder() == PlaneOrder::YUVA;
+      const auto srcU = srcY + lumaBytes + (uPlaneFirst ? 0 : lumaBytes / 4);
+      const auto srcV = srcY + lumaBytes + (uPlaneFirst ? lumaBytes / 4 : 0);
+
+      // The specialized function reads 10 bit values in native byte order. Only reproduce this
+      // with the vectorized kernels for little endian data.
+      if ((bitsPerSample == 8 || !yuvFormat.isBigEndian()) &&
+          convertYUVPlanarToRGBSIMD({srcY, srcU, srcV, 1},
+                                    outputImage.bits(),
+                                    curFrameSize,
+                                    yuvFormat,
+                                    conversionSettings,
+                                    true,
+                                    convertInParallel))
+        convOK = true;
+      else if (yuvFormat.getBitsPerSample() == 8)
         convOK = convertYUV420ToRGB<8>(
             sourceBuffer, outputImage.bits(), curFrameSize, yuvFormat, conversionSettings);
       else if (yuvFormat.getBitsPerSample() == 10)
@@ -2441,8 +2630,12 @@ void convertYUVToImage(const QByteArray         &sourceBuffer,
             sourceBuffer, outputImage.bits(), curFrameSize, yuvFormat, conversionSettings);
     }
     else
-      convOK = convertYUVPlanarToRGB(
-          sourceBuffer, outputImage.bits(), curFrameSize, yuvFormat, conversionSettings);
+      convOK = convertYUVPlanarToRGB(sourceBuffer,
+                                     outputImage.bits(),
+                                     curFrameSize,
+                                     yuvFormat,
+                                     conversionSettings,
+                                     convertInParallel);
   }
   else
   {
@@ -2464,26 +2657,53 @@ void convertYUVToImage(const QByteArray         &sourceBuffer,
           convertYUVPackedToPlanar(sourceBuffer, tmpPlanarYUVSource, curFrameSize, yuvFormat);
 
     if (convOK)
-      convOK &= convertYUVPlanarToRGB(
-          tmpPlanarYUVSource, outputImage.bits(), curFrameSize, newPixelFormat, conversionSettings);
+      convOK &= convertYUVPlanarToRGB(tmpPlanarYUVSource,
+                                      outputImage.bits(),
+                                      curFrameSize,
+                                      newPixelFormat,
+                                      conversionSettings,
+                                      convertInParallel);
   }
 
   assert(convOK);
 
-  if (is_Q_OS_LINUX)
-  {
-    // On linux, we may have to convert the image to the platform image format if it is not one of
-    // the RGBA formats.
-    auto format = functionsGui::platformImageFormat(yuvFormat.hasAlpha());
-    if (format != QImage::Format_ARGB32_Premultiplied && format != QImage::Format_ARGB32 &&
-        format != QImage::Format_RGB32)
-      outputImage = outputImage.convertToFormat(format);
-  }
+  convertToPlatformImageFormat(outputImage, yuvFormat.hasAlpha());
 
   DEBUG_YUV("videoHandlerYUV::convertYUVToImage Done");
 }
 
-} // namespace
+void convertYUVToImage(const RawFrameView       &rawFrame,
+                       QImage                   &outputImage,
+                       const PixelFormatYUV     &yuvFormat,
+                       const Size               &curFrameSize,
+                       const ConversionSettings &conversionSettings,
+                       const bool                convertInParallel)
+{
+  if (!rawFrame.isContiguous() && !rawFrame.isEmpty() && yuvFormat.canConvertToRGB(curFrameSize))
+  {
+    auto image = createOutputImage(curFrameSize, yuvFormat.hasAlpha());
+    if (convertYUVPlanesToRGBSIMD(rawFrame,
+                                  image.bits(),
+                                  curFrameSize,
+                                  yuvFormat,
+                                  conversionSettings,
+                                  convertInParallel))
+    {
+      DEBUG_YUV("videoHandlerYUV::convertYUVToImage converted planes of the view");
+      convertToPlatformImageFormat(image, yuvFormat.hasAlpha());
+      outputImage = image;
+      return;
+    }
+  }
+
+  // Only copies the planes if they are not contiguous already
+  convertYUVToImage(rawFrame.getContiguousData(),
+                    outputImage,
+                    yuvFormat,
+                    curFrameSize,
+                    conversionSettings,
+                    convertInParallel);
+}
 
 std::vector<PixelFormatYUV> videoHandlerYUV::formatPresetList = {
     PixelFormatYUV(Subsampling::YUV_420, 8, PlaneOrder::YUV),
@@ -2510,9 +2730,8 @@ videoHandlerYUV::~videoHandlerYUV()
 
 unsigned videoHandlerYUV::getCachingFrameSize() const
 {
-  auto hasAlpha = this->srcPixelFormat.hasAlpha();
-  auto bytes    = functionsGui::bytesPerPixel(functionsGui::platformImageFormat(hasAlpha));
-  return this->frameSize.width * this->frameSize.height * bytes;
+  // Only the raw YUV data is cached (see isRawFrameCachingSupported)
+  return unsigned(std::max(this->getBytesPerFrame(), int64_t(0)));
 }
 
 void videoHandlerYUV::loadValues(Size newFramesize, const QString &)
@@ -2930,12 +3149,10 @@ void videoHandlerYUV::slotYUVControlChanged()
     this->conversionSettings.mathParameters[Component::Chroma].invert =
         ui.chromaInvertCheckBox->isChecked();
 
-    // Set the current frame in the buffer to be invalid and clear the cache.
-    // Emit that this item needs redraw and the cache needs updating.
-    this->currentImageIndex       = -1;
-    this->currentImage_frameIndex = -1;
-    this->setCacheInvalid();
-    emit signalHandlerChanged(true, RECACHE_CLEAR);
+    // Only the conversion to RGB changed. The cached raw frames are still valid, so there is
+    // nothing to recache. The frames are converted with the new settings when they are drawn.
+    this->invalidateConvertedImages();
+    emit signalHandlerChanged(true, RECACHE_NONE);
   }
   else if (sender == ui.yuvFormatComboBox)
   {
@@ -2976,9 +3193,12 @@ QStringPairList videoHandlerYUV::getPixelValues(const QPoint &pixelPos,
       return FrameHandler::getPixelValues(pixelPos, frameIdx, item2, frameIdx1);
 
     // Do not get the pixel values if the buffer for the raw YUV values is out of date.
+    CurrentFrameLocker lock(this, yuvItem2);
     if (currentFrameRawData_frameIndex != frameIdx ||
         yuvItem2->currentFrameRawData_frameIndex != frameIdx1)
       return QStringPairList();
+    this->loadCurrentFrameRawData();
+    yuvItem2->loadCurrentFrameRawData();
 
     int width  = std::min(frameSize.width, yuvItem2->frameSize.width);
     int height = std::min(frameSize.height, yuvItem2->frameSize.height);
@@ -3033,8 +3253,10 @@ QStringPairList videoHandlerYUV::getPixelValues(const QPoint &pixelPos,
     int height = frameSize.height;
 
     // Do not get the pixel values if the buffer for the raw YUV values is out of date.
+    QMutexLocker lock(&this->currentFrameMutex);
     if (currentFrameRawData_frameIndex != frameIdx)
       return QStringPairList();
+    this->loadCurrentFrameRawData();
 
     if (pixelPos.x() < 0 || pixelPos.x() >= width || pixelPos.y() < 0 || pixelPos.y() >= height)
       return QStringPairList();
@@ -3106,10 +3328,14 @@ void videoHandlerYUV::drawPixelValues(QPainter     *painter,
   // Check if the raw YUV values are up to date. If not, do not draw them. Do not trigger loading of
   // data here. The needsLoadingRawValues function will return that loading is needed. The caching
   // in the background should then trigger loading of them.
+  CurrentFrameLocker lock(this, yuvItem2);
   if (currentFrameRawData_frameIndex != frameIdx)
     return;
   if (yuvItem2 && yuvItem2->currentFrameRawData_frameIndex != frameIdxItem1)
     return;
+  this->loadCurrentFrameRawData();
+  if (yuvItem2)
+    yuvItem2->loadCurrentFrameRawData();
 
   // For difference items, we support difference bit depths for the two items.
   // If the bit depth is different, we scale to value with the lower bit depth to the higher bit
@@ -3451,34 +3677,58 @@ void videoHandlerYUV::loadFrame(int frameIndex, bool loadToDoubleBuffer)
     // We cannot load a frame if the format is not known
     return;
 
-  // Does the data in currentFrameRawData need to be updated?
+  const auto tileRange = this->getRegionLoadingTileRange(frameIndex, loadToDoubleBuffer);
+  if (!tileRange.isEmpty())
+  {
+    // Only a small part of a very large frame is visible
+    this->loadFrameRegion(frameIndex, tileRange);
+    return;
+  }
+
+  // Does the data in currentFrameView need to be updated?
   if (!loadRawYUVData(frameIndex))
     // Loading failed or it is still being performed in the background
     return;
 
-  // The data in currentFrameRawData is now up to date. If necessary
+  // The current frame stays alive while it is converted, also if another thread sets a new one
+  currentFrameMutex.lock();
+  const auto currentFrame = this->currentFrameView;
+  currentFrameMutex.unlock();
+
+  // The data in currentFrameView is now up to date. If necessary
   // convert the data to RGB.
+  // This is the interactive loading path. Only one frame is converted at a time here, so we use
+  // all cores for the conversion.
   if (loadToDoubleBuffer)
   {
     QImage newImage;
-    convertYUVToImage(this->currentFrameRawData,
-                      newImage,
-                      this->srcPixelFormat,
-                      this->frameSize,
-                      this->conversionSettings);
-    doubleBufferImage           = newImage;
+    {
+      ScopedLatencyTimer convertTimer(&this->cacheStatistics, LoadingStage::Convert);
+      convertYUVToImage(currentFrame,
+                        newImage,
+                        this->srcPixelFormat,
+                        this->frameSize,
+                        this->conversionSettings,
+                        true);
+    }
+    doubleBufferImage           = ImagePyramid(newImage, this->isDrawnZoomedOut());
     doubleBufferImageFrameIndex = frameIndex;
   }
   else if (currentImageIndex != frameIndex)
   {
     QImage newImage;
-    convertYUVToImage(this->currentFrameRawData,
-                      newImage,
-                      this->srcPixelFormat,
-                      this->frameSize,
-                      this->conversionSettings);
-    QMutexLocker setLock(&currentImageSetMutex);
-    currentImage      = newImage;
+    {
+      ScopedLatencyTimer convertTimer(&this->cacheStatistics, LoadingStage::Convert);
+      convertYUVToImage(currentFrame,
+                        newImage,
+                        this->srcPixelFormat,
+                        this->frameSize,
+                        this->conversionSettings,
+                        true);
+    }
+    const ImagePyramid newImagePyramid(newImage, this->isDrawnZoomedOut());
+    QMutexLocker       setLock(&currentImageSetMutex);
+    this->setCurrentImage(newImagePyramid);
     currentImageIndex = frameIndex;
   }
 }
@@ -3495,7 +3745,7 @@ void videoHandlerYUV::loadFrameForCaching(int frameIndex, QImage &frameToCache)
 
   requestDataMutex.lock();
   emit       signalRequestRawData(frameIndex, true);
-  QByteArray tmpBufferRawYUVDataCaching = rawData;
+  const auto rawFrame = this->getRequestedRawFrame();
   requestDataMutex.unlock();
 
   if (frameIndex != rawData_frameIndex)
@@ -3506,17 +3756,94 @@ void videoHandlerYUV::loadFrameForCaching(int frameIndex, QImage &frameToCache)
   }
 
   // Convert YUV to image. This can then be cached.
-  convertYUVToImage(
-      tmpBufferRawYUVDataCaching, frameToCache, yuvFormat, curFrameSize, conversionSettings);
+  ScopedLatencyTimer convertTimer(&this->cacheStatistics, LoadingStage::Convert);
+  convertYUVToImage(rawFrame, frameToCache, yuvFormat, curFrameSize, conversionSettings);
 }
 
-// Load the raw YUV data for the given frame index into currentFrameRawData.
+void videoHandlerYUV::loadFrameRegion(int frameIndex, const QRect &tileRange)
+{
+  const auto missingTiles = this->tileCache.getMissingTiles(frameIndex, tileRange);
+  if (missingTiles.isEmpty())
+    return;
+
+  DEBUG_YUV("videoHandlerYUV::loadFrameRegion " << frameIndex);
+
+  const auto format       = this->srcPixelFormat;
+  const auto curFrameSize = this->frameSize;
+
+  // Extend the tiles by the chroma margin so that the border of the tiles is converted correctly
+  const auto tilesRect = TileCache::getTileRangeRect(missingTiles, curFrameSize);
+  const auto region    = getRegionForConversion({unsigned(tilesRect.x()),
+                                                 unsigned(tilesRect.y()),
+                                                 unsigned(tilesRect.width()),
+                                                 unsigned(tilesRect.height())},
+                                                format,
+                                                curFrameSize);
+  if (region.isEmpty())
+    return;
+  const auto ranges = getRegionByteRanges(format, curFrameSize, region);
+
+  QByteArray   regionData;
+  RawFrameView rawFrame;
+  if (this->getRawFrameFromCache(frameIndex, rawFrame))
+    regionData =
+        copyRegion(rawFrame.getContiguousData(), ranges, format, curFrameSize, region);
+  else if (this->currentFrameRawData_frameIndex == frameIndex)
+  {
+    QMutexLocker lock(&this->currentFrameMutex);
+    this->loadCurrentFrameRawData();
+    regionData = copyRegion(this->currentFrameRawData, ranges, format, curFrameSize, region);
+  }
+  else if (this->isSignalConnected(
+               QMetaMethod::fromSignal(&videoHandlerYUV::signalRequestRawDataRanges)))
+  {
+    QMutexLocker lock(&this->requestDataMutex);
+    emit signalRequestRawDataRanges(frameIndex, ranges);
+    if (this->rawData_frameIndex == frameIndex)
+      regionData = copyRegion(
+          this->rawData, getConcatenatedByteRanges(ranges), format, curFrameSize, region);
+    // rawData does not contain the whole frame
+    this->rawData_frameIndex = -1;
+  }
+  else if (this->loadRawYUVData(frameIndex))
+  {
+    QMutexLocker lock(&this->currentFrameMutex);
+    this->loadCurrentFrameRawData();
+    regionData = copyRegion(this->currentFrameRawData, ranges, format, curFrameSize, region);
+  }
+
+  if (regionData.isEmpty())
+  {
+    DEBUG_YUV("videoHandlerYUV::loadFrameRegion Loading failed");
+    return;
+  }
+
+  QImage regionImage;
+  {
+    ScopedLatencyTimer convertTimer(&this->cacheStatistics, LoadingStage::Convert);
+    convertYUVToImage(
+        regionData, regionImage, format, region.size(), this->conversionSettings, true);
+  }
+  const auto regionRect =
+      QRect(int(region.x), int(region.y), int(region.width), int(region.height));
+  this->tileCache.insertTiles(frameIndex, missingTiles, curFrameSize, regionImage, regionRect);
+}
+
+// Load the raw YUV data for the given frame index into currentFrameView.
 bool videoHandlerYUV::loadRawYUVData(int frameIndex)
 {
   if (currentFrameRawData_frameIndex == frameIndex && cacheValid)
     // Buffer already up to date
     return true;
 
+  RawFrameView cachedFrame;
+  if (this->getRawFrameFromCache(frameIndex, cachedFrame))
+  {
+    DEBUG_YUV("videoHandlerYUV::loadRawYUVData " << frameIndex << " found in cache");
+    this->setCurrentFrame(cachedFrame, frameIndex);
+    return true;
+  }
+
   DEBUG_YUV("videoHandlerYUV::loadRawYUVData " << frameIndex);
 
   // The function loadFrameForCaching also uses the signalRequesRawYUVData to request raw data.
@@ -3524,7 +3851,7 @@ bool videoHandlerYUV::loadRawYUVData(int frameIndex)
   requestDataMutex.lock();
   emit signalRequestRawData(frameIndex, false);
 
-  if (frameIndex != rawData_frameIndex || rawData.isEmpty())
+  if (frameIndex != rawData_frameIndex || (rawData.isEmpty() && rawFrameView.isEmpty()))
   {
     // Loading failed
     DEBUG_YUV("videoHandlerYUV::loadRawYUVData Loading failed");
@@ -3532,8 +3859,7 @@ bool videoHandlerYUV::loadRawYUVData(int frameIndex)
     return false;
   }
 
-  currentFrameRawData            = rawData;
-  currentFrameRawData_frameIndex = frameIndex;
+  this->setCurrentFrame(this->getRequestedRawFrame(), frameIndex);
   requestDataMutex.unlock();
 
   DEBUG_YUV("videoHandlerYUV::loadRawYUVData " << frameIndex << " Done");
@@ -3704,7 +4030,7 @@ yuv_t videoHandlerYUV::getPixelValue(const QPoint &pixelPos) const
 bool videoHandlerYUV::markDifferencesYUVPlanarToRGB(const QByteArray     &sourceBuffer,
                                                     unsigned char        *targetBuffer,
                                                     const Size            curFrameSize,
-                                                    const PixelFormatYUV &sourceBufferFormat) const
+                                                    const PixelFormatYUV &sourceBufferFormat)
 {
   // These are constant for the runtime of this function. This way, the compiler can optimize the
   // hell out of this function.
@@ -3829,11 +4155,61 @@ QImage videoHandlerYUV::calculateDifference(FrameHandler    *item2,
                                              amplificationFactor,
                                              markDifference);
 
+  // Load the right raw YUV data (if not already loaded).
+  // This will just update the raw YUV data. No conversion to image (RGB) is performed. This is
+  // either done on request if the frame is actually shown or has already been done by the caching
+  // process.
+  if (!loadRawYUVData(frameIdxItem0))
+    return QImage(); // Loading failed
+  if (!yuvItem2->loadRawYUVData(frameIdxItem1))
+    return QImage(); // Loading failed
+  CurrentFrameLocker lock(this, yuvItem2);
+  this->loadCurrentFrameRawData();
+  yuvItem2->loadCurrentFrameRawData();
+
+  // Both YUV buffers are up to date. Really calculate the difference.
+  DEBUG_YUV("videoHandlerYUV::calculateDifference frame idx item 0 "
+            << frameIdxItem0 << " - item 1 " << frameIdxItem1);
+
+  auto outputImage = calculateDifferenceOfRawFrames(this->currentFrameRawData,
+                                                    this->srcPixelFormat,
+                                                    this->frameSize,
+                                                    yuvItem2->currentFrameRawData,
+                                                    yuvItem2->srcPixelFormat,
+                                                    yuvItem2->frameSize,
+                                                    differenceInfoList,
+                                                    amplificationFactor,
+                                                    markDifference,
+                                                    this->diffYUV,
+                                                    this->diffYUVFormat);
+
+  // we have a yuv differance available
+  this->diffReady = !outputImage.isNull();
+  return outputImage;
+}
+
+QImage videoHandlerYUV::calculateDifferenceOfRawFrames(const QByteArray     &rawFrame0,
+                                                       const PixelFormatYUV &format0,
+                                                       const Size            frameSize0,
+                                                       const QByteArray     &rawFrame1,
+                                                       const PixelFormatYUV &format1,
+                                                       const Size            frameSize1,
+                                                       QList<InfoItem>      &differenceInfoList,
+                                                       const int             amplificationFactor,
+                                                       const bool            markDifference,
+                                                       QByteArray           &diffYUV,
+                                                       PixelFormatYUV       &diffYUVFormat)
+{
+  if (format0.getSubsampling() != format1.getSubsampling())
+    return QImage();
+  if (rawFrame0.size() < format0.bytesPerFrame(frameSize0) ||
+      rawFrame1.size() < format1.bytesPerFrame(frameSize1))
+    return QImage();
+
   // Get/Set the bit depth of the input and output
   // If the bit depth of the two items is different, we will scale the item with the lower bit depth
   // up.
-  const unsigned bps_in[2] = {srcPixelFormat.getBitsPerSample(),
-                              yuvItem2->srcPixelFormat.getBitsPerSample()};
+  const unsigned bps_in[2] = {format0.getBitsPerSample(), format1.getBitsPerSample()};
   const auto     bps_out   = std::max(bps_in[0], bps_in[1]);
 
   const unsigned bitDepthScale[2] = {bps_out - bps_in[0], bps_out - bps_in[1]};
@@ -3851,45 +4227,32 @@ QImage videoHandlerYUV::calculateDifference(FrameHandler    *item2,
   // Do we amplify the values?
   const bool amplification = (amplificationFactor != 1 && !markDifference);
 
-  // Load the right raw YUV data (if not already loaded).
-  // This will just update the raw YUV data. No conversion to image (RGB) is performed. This is
-  // either done on request if the frame is actually shown or has already been done by the caching
-  // process.
-  if (!loadRawYUVData(frameIdxItem0))
-    return QImage(); // Loading failed
-  if (!yuvItem2->loadRawYUVData(frameIdxItem1))
-    return QImage(); // Loading failed
-
-  // Both YUV buffers are up to date. Really calculate the difference.
-  DEBUG_YUV("videoHandlerYUV::calculateDifference frame idx item 0 "
-            << frameIdxItem0 << " - item 1 " << frameIdxItem1);
-
   // The items can be of different size (we then calculate the difference of the top left aligned
   // part)
-  const unsigned w_in[] = {frameSize.width, yuvItem2->frameSize.width};
-  const unsigned h_in[] = {frameSize.height, yuvItem2->frameSize.height};
+  const unsigned w_in[] = {frameSize0.width, frameSize1.width};
+  const unsigned h_in[] = {frameSize0.height, frameSize1.height};
   const auto     w_out  = std::min(w_in[0], w_in[1]);
   const auto     h_out  = std::min(h_in[0], h_in[1]);
   // Append a warning if the frame sizes are different
-  if (frameSize != yuvItem2->frameSize)
+  if (frameSize0 != frameSize1)
     differenceInfoList.append(
         InfoItem("Warning"sv,
                  "The size of the two items differs.",
                  "The size of the two input items is different. The difference of the top left "
                  "aligned part that overlaps will be calculated."));
 
-  PixelFormatYUV tmpDiffYUVFormat(srcPixelFormat.getSubsampling(), bps_out, PlaneOrder::YUV, true);
+  PixelFormatYUV tmpDiffYUVFormat(format0.getSubsampling(), bps_out, PlaneOrder::YUV, true);
   diffYUVFormat = tmpDiffYUVFormat;
 
   if (!tmpDiffYUVFormat.canConvertToRGB(Size(w_out, h_out)))
     return QImage();
 
   // Get subsampling modes (they are identical for both inputs and the output)
-  const auto subH = srcPixelFormat.getSubsamplingHor();
-  const auto subV = srcPixelFormat.getSubsamplingVer();
+  const auto subH = format0.getSubsamplingHor();
+  const auto subV = format0.getSubsamplingVer();
 
   // Get the endianness of the inputs
-  const bool bigEndian[2] = {srcPixelFormat.isBigEndian(), yuvItem2->srcPixelFormat.isBigEndian()};
+  const bool bigEndian[2] = {format0.isBigEndian(), format1.isBigEndian()};
 
   // Get pointers to the inputs
   const unsigned componentSizeLuma_In[2]   = {w_in[0] * h_in[0], w_in[1] * h_in[1]};
@@ -3902,27 +4265,23 @@ QImage videoHandlerYUV::calculateDifference(FrameHandler    *item2,
       bps_in[0] > 8 ? 2 * componentSizeChroma_In[0] : componentSizeChroma_In[0],
       bps_in[1] > 8 ? 2 * componentSizeChroma_In[1] : componentSizeChroma_In[1]};
   // Current item
-  const unsigned char *restrict srcY1 = (unsigned char *)currentFrameRawData.data();
+  const unsigned char *restrict srcY1 = (unsigned char *)rawFrame0.data();
   const unsigned char *restrict srcU1 =
-      (srcPixelFormat.getPlaneOrder() == PlaneOrder::YUV ||
-       srcPixelFormat.getPlaneOrder() == PlaneOrder::YUVA)
+      (format0.getPlaneOrder() == PlaneOrder::YUV || format0.getPlaneOrder() == PlaneOrder::YUVA)
           ? srcY1 + nrBytesLumaPlane_In[0]
           : srcY1 + nrBytesLumaPlane_In[0] + nrBytesChromaPlane_In[0];
   const unsigned char *restrict srcV1 =
-      (srcPixelFormat.getPlaneOrder() == PlaneOrder::YUV ||
-       srcPixelFormat.getPlaneOrder() == PlaneOrder::YUVA)
+      (format0.getPlaneOrder() == PlaneOrder::YUV || format0.getPlaneOrder() == PlaneOrder::YUVA)
           ? srcY1 + nrBytesLumaPlane_In[0] + nrBytesChromaPlane_In[0]
           : srcY1 + nrBytesLumaPlane_In[0];
   // The other item
-  const unsigned char *restrict srcY2 = (unsigned char *)yuvItem2->currentFrameRawData.data();
+  const unsigned char *restrict srcY2 = (unsigned char *)rawFrame1.data();
   const unsigned char *restrict srcU2 =
-      (yuvItem2->srcPixelFormat.getPlaneOrder() == PlaneOrder::YUV ||
-       yuvItem2->srcPixelFormat.getPlaneOrder() == PlaneOrder::YUVA)
+      (format1.getPlaneOrder() == PlaneOrder::YUV || format1.getPlaneOrder() == PlaneOrder::YUVA)
           ? srcY2 + nrBytesLumaPlane_In[1]
           : srcY2 + nrBytesLumaPlane_In[1] + nrBytesChromaPlane_In[1];
   const unsigned char *restrict srcV2 =
-      (yuvItem2->srcPixelFormat.getPlaneOrder() == PlaneOrder::YUV ||
-       yuvItem2->srcPixelFormat.getPlaneOrder() == PlaneOrder::YUVA)
+      (format1.getPlaneOrder() == PlaneOrder::YUV || format1.getPlaneOrder() == PlaneOrder::YUVA)
           ? srcY2 + nrBytesLumaPlane_In[1] + nrBytesChromaPlane_In[1]
           : srcY2 + nrBytesLumaPlane_In[1];
 
@@ -4052,7 +4411,7 @@ QImage videoHandlerYUV::calculateDifference(FrameHandler    *item2,
   }
 
   differenceInfoList.append(InfoItem(
-      "Difference Type", "YUV " + formatSubsamplingWithColons(srcPixelFormat.getSubsampling())));
+      "Difference Type", "YUV " + formatSubsamplingWithColons(format0.getSubsampling())));
 
   {
     const auto nrPixelsLuma = w_out * h_out;
@@ -4060,7 +4419,7 @@ QImage videoHandlerYUV::calculateDifference(FrameHandler    *item2,
     const auto mseY = double(mseAdd[0]) / nrPixelsLuma;
     differenceInfoList.append(InfoItem("MSE/PSNR Y", formatMSEandPSNR(mseY, bps_out)));
 
-    if (srcPixelFormat.getSubsampling() != Subsampling::YUV_400)
+    if (format0.getSubsampling() != Subsampling::YUV_400)
     {
       auto nrPixelsChroma = w_out / subH * h_out / subV;
 
@@ -4085,8 +4444,6 @@ QImage videoHandlerYUV::calculateDifference(FrameHandler    *item2,
       return outputImage.convertToFormat(format);
   }
 
-  // we have a yuv differance available
-  this->diffReady = true;
   return outputImage;
 }
 
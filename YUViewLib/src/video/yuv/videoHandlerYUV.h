@@ -34,6 +34,7 @@
 
 #include <common/EnumMapper.h>
 #include <video/videoHandler.h>
+#include <video/yuv/FrameRegion.h>
 #include <video/yuv/PixelFormatYUV.h>
 
 #include "ui_videoHandlerYUV.h"
@@ -72,6 +73,47 @@ struct ConversionSettings
   std::map<Component, MathParameters> mathParameters;
 };
 
+// Convert the given raw YUV data in sourceBuffer (using yuvFormat) to outputImage (RGB-888). If
+// convertInParallel is set, the frame is split into stripes which are converted in the shared
+// thread pool. Only do this if the caller is not one of many threads that already convert frames
+// in parallel (like the caching threads).
+void convertYUVToImage(const QByteArray         &sourceBuffer,
+                       QImage                   &outputImage,
+                       const PixelFormatYUV     &yuvFormat,
+                       const Size               &curFrameSize,
+                       const ConversionSettings &conversionSettings,
+                       const bool                convertInParallel = false);
+
+// Same as above for the raw frame in the given view. If the planes of the view are not packed (like
+// the picture buffers of a decoder), they are converted in place if the vectorized kernels support
+// the conversion. Only otherwise, the planes are packed into one buffer first.
+void convertYUVToImage(const RawFrameView       &rawFrame,
+                       QImage                   &outputImage,
+                       const PixelFormatYUV     &yuvFormat,
+                       const Size               &curFrameSize,
+                       const ConversionSettings &conversionSettings,
+                       const bool                convertInParallel = false);
+
+// Convert planar YUV data to 8 bit BGRA in targetBuffer (which must hold width * height * 4
+// bytes). Returns false if the format is not supported.
+bool convertYUVPlanarToRGB(const QByteArray         &sourceBuffer,
+                           uchar                    *targetBuffer,
+                           const Size                curFrameSize,
+                           const PixelFormatYUV     &sourceBufferFormat,
+                           const ConversionSettings &conversionSettings,
+                           const bool                convertInParallel = false);
+
+// Convert packed YUV data to a planar format. Returns the planar format of targetBuffer.
+std::pair<bool, PixelFormatYUV> convertYUVPackedToPlanar(const QByteArray     &sourceBuffer,
+                                                         QByteArray           &targetBuffer,
+                                                         const Size            curFrameSize,
+                                                         const PixelFormatYUV &format);
+
+// Convert V210 data to a planar 4:2:2 10 bit format. Returns the planar format of targetBuffer.
+std::pair<bool, PixelFormatYUV> convertV210PackedToPlanar(const QByteArray &sourceBuffer,
+                                                          QByteArray       &targetBuffer,
+                                                          const Size        curFrameSize);
+
 /** The videoHandlerYUV can be used in any playlistItem to read/display YUV data. A playlistItem
  * could even provide multiple YUV videos. A videoHandlerYUV supports handling of YUV data and can
  * return a specific frame as a image by calling getOneFrame. All conversions from the various YUV
@@ -118,6 +160,22 @@ public:
                                      const int        amplificationFactor,
                                      const bool       markDifference) override;
 
+  // Calculate the difference of two raw YUV frames with the same subsampling. This does not use
+  // the buffers of a handler so it can be called from any thread (e.g. to cache difference frames).
+  // The planar difference frame and its format are returned in diffYUV and diffYUVFormat. Returns a
+  // null image if the difference can not be calculated in the YUV domain.
+  static QImage calculateDifferenceOfRawFrames(const QByteArray     &rawFrame0,
+                                               const PixelFormatYUV &format0,
+                                               const Size            frameSize0,
+                                               const QByteArray     &rawFrame1,
+                                               const PixelFormatYUV &format1,
+                                               const Size            frameSize1,
+                                               QList<InfoItem>      &differenceInfoList,
+                                               const int             amplificationFactor,
+                                               const bool            markDifference,
+                                               QByteArray           &diffYUV,
+                                               PixelFormatYUV       &diffYUVFormat);
+
   // Get the number of bytes for one YUV frame with the current format
   virtual int64_t getBytesPerFrame() const override
   {
@@ -149,6 +207,8 @@ public:
   // other sources might provide a fixed format which the user cannot change (HEVC file, ...)
   virtual QLayout *createVideoHandlerControls(bool isSizeAndFormatFixed = false) override;
 
+  PixelFormatYUV getPixelFormatYUV() const { return this->srcPixelFormat; }
+
   // Get the name of the currently selected YUV pixel format
   virtual QString getRawPixelFormatYUVName() const
   {
@@ -195,23 +255,44 @@ public:
   virtual void savePlaylist(YUViewDomElement &root) const override;
   virtual void loadPlaylist(const YUViewDomElement &root) override;
 
+signals:
+  // Request only the given byte ranges of the raw data of the frame (relative to the start of the
+  // frame). After the signal is emitted, rawData should contain the ranges one after the other and
+  // rawData_frameIndex should be identical to frameIndex. A source that can read parts of a frame
+  // (e.g. a raw file) can connect to this. Otherwise the whole frame is requested.
+  void signalRequestRawDataRanges(int frameIndex, const std::vector<ByteRange> &ranges);
+
 protected:
   ConversionSettings conversionSettings{};
 
   // The currently selected YUV format
   PixelFormatYUV srcPixelFormat;
 
+  // Get the value of the pixel from currentFrameRawData. loadCurrentFrameRawData() must have been
+  // called for the current frame and currentFrameMutex must still be locked.
   virtual yuv_t getPixelValue(const QPoint &pixelPos) const;
 
   // Load the given frame and return it for caching. The current buffers (currentFrameRawYUVData and
   // currentFrame) will not be modified.
   virtual void loadFrameForCaching(int frameIndex, QImage &frameToCache) override;
 
+  // Cache the raw YUV frames and convert them when they are drawn.
+  bool isRawFrameCachingSupported() const override { return true; }
+
+  bool isRegionLoadingSupported() const override
+  {
+    return yuv::isRegionLoadingSupported(this->srcPixelFormat);
+  }
+
 private:
-  // Load the raw YUV data for the given frame index into currentFrameRawYUVData.
+  // Load the raw YUV data for the given frame index into currentFrameView.
   // Return false is loading failed.
   bool loadRawYUVData(int frameIndex);
 
+  // Load and convert only the given tiles of the frame (if they are not in the tile cache yet).
+  // Only the rows of the frame that are needed are read (if the source supports this).
+  void loadFrameRegion(int frameIndex, const QRect &tileRange);
+
   // Set the new pixel format thread save (lock the mutex). We should also emit that something
   // changed (can be disabled).
   void setSrcPixelFormat(PixelFormatYUV newFormat, bool emitChangedSignal = true);
@@ -223,10 +304,10 @@ private:
   bool setFormatFromSizeAndNamePacked(
       QString name, const Size size, int bitDepth, Subsampling subsampling, int64_t fileSize);
 
-  bool markDifferencesYUVPlanarToRGB(const QByteArray     &sourceBuffer,
-                                     unsigned char        *targetBuffer,
-                                     const Size            frameSize,
-                                     const PixelFormatYUV &sourceBufferFormat) const;
+  static bool markDifferencesYUVPlanarToRGB(const QByteArray     &sourceBuffer,
+                                            unsigned char        *targetBuffer,
+                                            const Size            frameSize,
+                                            const PixelFormatYUV &sourceBufferFormat);
 
 #if SSE_CONVERSION_420_ALT
   void yuv420_to_argb8888(quint8 *yp,
@@ -0,0 +1,26 @@
+QT += core gui widgets opengl xml concurrent network
+
+TARGET = YUViewMicroBenchmark
+TEMPLATE = app
+
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG -= debug_and_release
+CONFIG += c++17
+
+SOURCES += $$files(*.cpp, true)
+HEADERS += $$files(*.h, true)
+
+# The helpers for the creation of test names and temporary files are shared with the unit tests
+SOURCES += $$top_srcdir/YUViewUnitTest/common/Testing.cpp \
+           $$top_srcdir/YUViewUnitTest/common/TemporaryFile.cpp
+
+INCLUDEPATH += $$top_srcdir/submodules/googletest/googletest/include \
+               $$top_srcdir/submodules/googletest/googlemock/include \
+               $$top_srcdir/YUViewLib/src \
+               $$top_srcdir/YUViewUnitTest
+# The generated ui_*.h headers of the library (included by the video handlers)
+INCLUDEPATH += $$top_builddir/YUViewLib
+LIBS += -L$$top_builddir/submodules/googletest-qmake/gtest -lgtest
+LIBS += -L$$top_builddir/submodules/googletest-qmake/gtest_main -lgtest_main
+LIBS += -L$$top_builddir/YUViewLib -lYUViewLib
@@ -0,0 +1,118 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+*   <https://github.com/IENT/YUView>
+*   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   In addition, as a special exception, the copyright holders give
+*   permission to link the code of portions of this program with the
+*   OpenSSL library under certain conditions as described in each
+*   individual source file, and distribute linked combinations including
+*   the two.
+*   
+*   You must obey the GNU General Public License in all respects for all
+*   of the code used other than OpenSSL. If you modify file(s) with this
+*   exception, you may extend this exception to your version of the
+*   file(s), but you are not obligated to do so. If you do not wish to do
+*   so, delete this exception statement from your version. If you delete
+*   this exception statement from all source files in the program, then
+*   also delete it here.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "MicroBenchmark.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+namespace yuviewBenchmark
+{
+
+namespace
+{
+
+volatile uint64_t optimizationSink;
+
+double toMicroseconds(Clock::duration duration)
+{
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+} // namespace
+
+double reportMeasurement(const std::string                  &name,
+                         const std::vector<Clock::duration> &runDurations,
+                         uint64_t                            nrBytesPerRun)
+{
+  auto sortedDurations = runDurations;
+  std::sort(sortedDurations.begin(), sortedDurations.end());
+
+  const auto medianUs = toMicroseconds(sortedDurations.at(sortedDurations.size() / 2));
+  const auto minUs    = toMicroseconds(sortedDurations.front());
+  const auto maxUs    = toMicroseconds(sortedDurations.back());
+
+  std::cout << std::left << std::setw(48) << name << std::right << std::fixed
+            << std::setprecision(1) << " median " << std::setw(10) << medianUs << "us  min "
+            << std::setw(10) << minUs << "us  max " << std::setw(10) << maxUs << "us";
+  if (nrBytesPerRun > 0 && medianUs > 0)
+    std::cout << "  " << std::setw(8) << double(nrBytesPerRun) / medianUs << " MB/s";
+  std::cout << "\n";
+
+  ::testing::Test::RecordProperty(name + "_medianUs", std::to_string(medianUs));
+  return medianUs;
+}
+
+double reportSpeedup(const std::string &name, double referenceMedianUs, double medianUs)
+{
+  const auto speedup = medianUs > 0 ? referenceMedianUs / medianUs : 0.0;
+
+  std::cout << std::left << std::setw(48) << name << std::right << std::fixed
+            << std::setprecision(1) << " speedup " << std::setw(8) << speedup << "x\n";
+
+  ::testing::Test::RecordProperty(name + "_speedup", std::to_string(speedup));
+  return speedup;
+}
+
+void doNotOptimizeAway(uint64_t value)
+{
+  optimizationSink = optimizationSink + value;
+}
+
+QByteArray createRandomSamples(size_t nrSamples, unsigned bitsPerSample)
+{
+  std::mt19937 generator(RANDOM_SEED);
+  const auto   twoBytes = bitsPerSample > 8;
+  const auto   maxValue = (1u << bitsPerSample) - 1;
+
+  QByteArray data(int(nrSamples * (twoBytes ? 2 : 1)), 0);
+  auto       dst = reinterpret_cast<unsigned char *>(data.data());
+  for (size_t i = 0; i < nrSamples; i++)
+  {
+    const auto value = generator() & maxValue;
+    if (twoBytes)
+    {
+      *dst++ = static_cast<unsigned char>(value & 0xff);
+      *dst++ = static_cast<unsigned char>(value >> 8);
+    }
+    else
+      *dst++ = static_cast<unsigned char>(value);
+  }
+  return data;
+}
+
+} // namespace yuviewBenchmark
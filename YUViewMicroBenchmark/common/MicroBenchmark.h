@@ -0,0 +1,95 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+*   <https://github.com/IENT/YUView>
+*   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   In addition, as a special exception, the copyright holders give
+*   permission to link the code of portions of this program with the
+*   OpenSSL library under certain conditions as described in each
+*   individual source file, and distribute linked combinations including
+*   the two.
+*   
+*   You must obey the GNU General Public License in all respects for all
+*   of the code used other than OpenSSL. If you modify file(s) with this
+*   exception, you may extend this exception to your version of the
+*   file(s), but you are not obligated to do so. If you do not wish to do
+*   so, delete this exception statement from your version. If you delete
+*   this exception statement from all source files in the program, then
+*   also delete it here.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <QByteArray>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace yuviewBenchmark
+{
+
+// All kernels are measured with the same pinned settings so that the results of different builds
+// (and machines) can be compared. The warmup runs are not measured.
+constexpr unsigned NR_WARMUP_RUNS   = 2;
+constexpr unsigned NR_MEASURED_RUNS = 10;
+
+// The seed for all synthetic input data. Every run of a benchmark processes the same data.
+constexpr unsigned RANDOM_SEED = 42;
+
+using Clock = std::chrono::steady_clock;
+
+// Print the median, minimum and maximum duration of the measured runs (and the throughput if the
+// number of bytes per run is known). The median is also recorded as a property of the current
+// test, so it is part of the report that is written with --gtest_output=json:<file>. Returns the
+// median in microseconds.
+double reportMeasurement(const std::string                  &name,
+                         const std::vector<Clock::duration> &runDurations,
+                         uint64_t                            nrBytesPerRun);
+
+// Print and record the speedup of a measurement over a reference measurement (both given as the
+// median in microseconds as returned by runBenchmark). Returns the speedup.
+double reportSpeedup(const std::string &name, double referenceMedianUs, double medianUs);
+
+// Keep the compiler from removing a calculation whose result is otherwise unused
+void doNotOptimizeAway(uint64_t value);
+
+// Random samples with the given bit depth in little endian byte order (2 bytes for more than 8
+// bit). The values never exceed the bit depth.
+QByteArray createRandomSamples(size_t nrSamples, unsigned bitsPerSample);
+
+// Run the function NR_WARMUP_RUNS + NR_MEASURED_RUNS times and report the measured runs.
+// nrBytesPerRun is the amount of input data that one run processes (0 if this is not meaningful).
+// Returns the median duration of the measured runs in microseconds.
+template <typename Function>
+double runBenchmark(const std::string &name, uint64_t nrBytesPerRun, Function &&function)
+{
+  for (unsigned i = 0; i < NR_WARMUP_RUNS; i++)
+    function();
+
+  std::vector<Clock::duration> runDurations;
+  for (unsigned i = 0; i < NR_MEASURED_RUNS; i++)
+  {
+    const auto start = Clock::now();
+    function();
+    runDurations.push_back(Clock::now() - start);
+  }
+
+  return reportMeasurement(name, runDurations, nrBytesPerRun);
+}
+
+} // namespace yuviewBenchmark
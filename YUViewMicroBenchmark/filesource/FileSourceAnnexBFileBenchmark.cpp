@@ -0,0 +1,92 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+*   <https://github.com/IENT/YUView>
+*   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   In addition, as a special exception, the copyright holders give
+*   permission to link the code of portions of this program with the
+*   OpenSSL library under certain conditions as described in each
+*   individual source file, and distribute linked combinations including
+*   the two.
+*   
+*   You must obey the GNU General Public License in all respects for all
+*   of the code used other than OpenSSL. If you modify file(s) with this
+*   exception, you may extend this exception to your version of the
+*   file(s), but you are not obligated to do so. If you do not wish to do
+*   so, delete this exception statement from your version. If you delete
+*   this exception statement from all source files in the program, then
+*   also delete it here.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <common/MicroBenchmark.h>
+#include <common/TemporaryFile.h>
+#include <common/Testing.h>
+
+#include <filesource/FileSourceAnnexBFile.h>
+
+#include <random>
+
+namespace filesource::benchmark
+{
+
+namespace
+{
+
+constexpr size_t FILE_SIZE         = 32 << 20;
+constexpr size_t MAX_NAL_UNIT_SIZE = 20000;
+
+// NAL units with a random size and 3 or 4 byte start codes. The payload never contains a zero
+// byte so that there are no start codes in it.
+ByteVector createAnnexBData(size_t &nrNalUnits)
+{
+  std::mt19937                          generator(yuviewBenchmark::RANDOM_SEED);
+  std::uniform_int_distribution<size_t> sizeDistribution(10, MAX_NAL_UNIT_SIZE);
+
+  ByteVector data;
+  data.reserve(FILE_SIZE + MAX_NAL_UNIT_SIZE);
+  nrNalUnits = 0;
+  while (data.size() < FILE_SIZE)
+  {
+    if (generator() % 2 == 0)
+      data.push_back(0);
+    data.insert(data.end(), {0, 0, 1});
+
+    const auto nalUnitSize = sizeDistribution(generator);
+    for (size_t i = 0; i < nalUnitSize; i++)
+      data.push_back(static_cast<unsigned char>(generator() % 255 + 1));
+    nrNalUnits++;
+  }
+  return data;
+}
+
+} // namespace
+
+TEST(FileSourceAnnexBFileBenchmark, GetNextNALUnit)
+{
+  size_t                    nrNalUnits{};
+  const auto                data = createAnnexBData(nrNalUnits);
+  yuviewTest::TemporaryFile annexBFile(data);
+
+  yuviewBenchmark::runBenchmark("GetNextNALUnit", data.size(), [&]() {
+    FileSourceAnnexBFile file(annexBFile.getFilePath());
+    size_t               counter = 0;
+    while (file.getNextNALUnit().size() > 0)
+      counter++;
+    EXPECT_EQ(counter, nrNalUnits);
+  });
+}
+
+} // namespace filesource::benchmark
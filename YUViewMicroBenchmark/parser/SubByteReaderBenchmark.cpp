@@ -0,0 +1,228 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+*   <https://github.com/IENT/YUView>
+*   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   In addition, as a special exception, the copyright holders give
+*   permission to link the code of portions of this program with the
+*   OpenSSL library under certain conditions as described in each
+*   individual source file, and distribute linked combinations including
+*   the two.
+*   
+*   You must obey the GNU General Public License in all respects for all
+*   of the code used other than OpenSSL. If you modify file(s) with this
+*   exception, you may extend this exception to your version of the
+*   file(s), but you are not obligated to do so. If you do not wish to do
+*   so, delete this exception statement from your version. If you delete
+*   this exception statement from all source files in the program, then
+*   also delete it here.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <common/MicroBenchmark.h>
+#include <common/Testing.h>
+
+#include <parser/common/SubByteReader.h>
+#include <parser/common/SubByteReaderLogging.h>
+
+#include <random>
+
+namespace parser::benchmark
+{
+
+namespace
+{
+
+using yuviewBenchmark::doNotOptimizeAway;
+using yuviewBenchmark::RANDOM_SEED;
+using yuviewBenchmark::runBenchmark;
+
+constexpr size_t NR_BYTES         = 1 << 20;
+constexpr size_t NR_UEV_SYMBOLS   = 1 << 18;
+constexpr size_t NR_PADDING_BYTES = 8;
+constexpr size_t NR_SLICE_HEADERS = 1 << 16;
+
+// Makes the protected reading functions accessible
+class AccessibleSubByteReader : public SubByteReader
+{
+public:
+  using SubByteReader::readBits;
+  using SubByteReader::readUE_V;
+  using SubByteReader::SubByteReader;
+};
+
+class BitWriter
+{
+public:
+  void writeBits(uint64_t value, unsigned nrBits)
+  {
+    for (unsigned i = nrBits; i > 0; i--)
+    {
+      if (this->bitPos == 0)
+        this->data.push_back(0);
+      if ((value >> (i - 1)) & 1)
+        this->data.back() |= static_cast<unsigned char>(0x80 >> this->bitPos);
+      this->bitPos = (this->bitPos + 1) % 8;
+    }
+  }
+
+  void writeUE_V(uint64_t value)
+  {
+    const auto codeNum = value + 1;
+    unsigned   nrBits  = 0;
+    while ((codeNum >> nrBits) > 1)
+      nrBits++;
+    this->writeBits(0, nrBits);
+    this->writeBits(codeNum, nrBits + 1);
+  }
+
+  ByteVector data;
+
+private:
+  unsigned bitPos{};
+};
+
+// Random data that contains emulation prevention bytes like a real bitstream (a 0x03 is inserted
+// after every two zero bytes). The reader removes these while reading.
+ByteVector createRandomBitstream()
+{
+  std::mt19937 generator(RANDOM_SEED);
+  ByteVector   data;
+  data.reserve(NR_BYTES + NR_BYTES / 100);
+  unsigned nrZeroBytes = 0;
+  while (data.size() < NR_BYTES)
+  {
+    // Make zero bytes more likely than in uniformly distributed data
+    const auto value = (generator() % 8 == 0) ? 0 : static_cast<unsigned char>(generator());
+    if (nrZeroBytes == 2 && value <= 3)
+    {
+      data.push_back(3);
+      nrZeroBytes = 0;
+    }
+    data.push_back(value);
+    nrZeroBytes = (value == 0) ? nrZeroBytes + 1 : 0;
+  }
+  data.insert(data.end(), NR_PADDING_BYTES, 0xff);
+  return data;
+}
+
+// A syntax structure like a (shortened) HEVC slice segment header. The symbols are read with names
+// and options exactly like in the parsers.
+void parseSliceHeaderLikeStructure(reader::SubByteReaderLogging &reader)
+{
+  using reader::Options;
+
+  reader::SubByteReaderLoggingSubLevel subLevel(reader, "slice_segment_header()");
+  reader.readFlag("first_slice_segment_in_pic_flag");
+  reader.readUEV("slice_pic_parameter_set_id", Options().withCheckRange({0, 63}));
+  reader.readUEV("slice_type",
+                 Options()
+                     .withMeaningVector({"B-Slice", "P-Slice", "I-Slice"})
+                     .withCheckRange({0, 2}));
+  reader.readBits("slice_pic_order_cnt_lsb", 8);
+  reader.readFlag("short_term_ref_pic_set_sps_flag");
+  reader.readFlag("slice_temporal_mvp_enabled_flag");
+  reader.readFlag("slice_sao_luma_flag");
+  reader.readFlag("slice_sao_chroma_flag");
+  reader.readFlag("num_ref_idx_active_override_flag");
+  reader.readUEV("five_minus_max_num_merge_cand", Options().withCheckRange({0, 4}));
+  reader.readSEV("slice_qp_delta");
+  reader.readSEV("slice_cb_qp_offset", Options().withCheckRange({-12, 12}));
+  reader.readSEV("slice_cr_qp_offset", Options().withCheckRange({-12, 12}));
+  reader.readFlag("slice_loop_filter_across_slices_enabled_flag");
+}
+
+ByteVector createSliceHeaderLikeStructure()
+{
+  BitWriter writer;
+  writer.writeBits(1, 1);
+  writer.writeUE_V(0);
+  writer.writeUE_V(1);
+  writer.writeBits(0x4a, 8);
+  writer.writeBits(0b10110, 5);
+  writer.writeUE_V(2);
+  writer.writeUE_V(5);
+  writer.writeUE_V(3);
+  writer.writeUE_V(4);
+  writer.writeBits(1, 1);
+  writer.data.insert(writer.data.end(), NR_PADDING_BYTES, 0xff);
+  return writer.data;
+}
+
+} // namespace
+
+TEST(SubByteReaderBenchmark, ReadBits)
+{
+  const auto data = createRandomBitstream();
+
+  // The parsers mostly read flags and short fixed length values
+  for (const auto nrBits : {1u, 3u, 8u, 16u, 32u})
+  {
+    const auto nrReads = (NR_BYTES * 8 / 2) / nrBits;
+    runBenchmark(yuviewTest::formatTestName("ReadBits", nrBits), NR_BYTES / 2, [&]() {
+      AccessibleSubByteReader reader(data);
+      uint64_t                sum = 0;
+      for (size_t i = 0; i < nrReads; i++)
+        sum += reader.readBits(nrBits);
+      doNotOptimizeAway(sum);
+    });
+  }
+}
+
+TEST(SubByteReaderBenchmark, ReadUE_V)
+{
+  // Small values are much more likely than big values (like in a real bitstream)
+  std::mt19937                          generator(RANDOM_SEED);
+  std::geometric_distribution<uint64_t> distribution(0.2);
+
+  BitWriter writer;
+  for (size_t i = 0; i < NR_UEV_SYMBOLS; i++)
+    writer.writeUE_V(distribution(generator));
+  writer.data.insert(writer.data.end(), NR_PADDING_BYTES, 0xff);
+
+  runBenchmark("ReadUE_V", writer.data.size(), [&]() {
+    AccessibleSubByteReader reader(writer.data);
+    reader.disableEmulationPrevention();
+    uint64_t sum = 0;
+    for (size_t i = 0; i < NR_UEV_SYMBOLS; i++)
+      sum += reader.readUE_V();
+    doNotOptimizeAway(sum);
+  });
+}
+
+TEST(SubByteReaderBenchmark, ParseSymbols)
+{
+  // Opening a file, seeking and building the frame index parse without a TreeItem. Only the
+  // packet view parses with logging.
+  const auto data = createSliceHeaderLikeStructure();
+
+  for (const auto logging : {false, true})
+  {
+    const auto name = std::string("ParseSymbols") + (logging ? "WithLogging" : "WithoutLogging");
+    runBenchmark(name, NR_SLICE_HEADERS * data.size(), [&]() {
+      uint64_t nrBitsRead = 0;
+      for (size_t i = 0; i < NR_SLICE_HEADERS; i++)
+      {
+        auto root = logging ? std::make_shared<TreeItem>() : nullptr;
+        reader::SubByteReaderLogging reader(data, root);
+        parseSliceHeaderLikeStructure(reader);
+        nrBitsRead += reader.nrBitsRead();
+      }
+      doNotOptimizeAway(nrBitsRead);
+    });
+  }
+}
+
+} // namespace parser::benchmark
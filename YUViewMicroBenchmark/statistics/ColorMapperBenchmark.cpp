@@ -0,0 +1,87 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+*   <https://github.com/IENT/YUView>
+*   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   In addition, as a special exception, the copyright holders give
+*   permission to link the code of portions of this program with the
+*   OpenSSL library under certain conditions as described in each
+*   individual source file, and distribute linked combinations including
+*   the two.
+*   
+*   You must obey the GNU General Public License in all respects for all
+*   of the code used other than OpenSSL. If you modify file(s) with this
+*   exception, you may extend this exception to your version of the
+*   file(s), but you are not obligated to do so. If you do not wish to do
+*   so, delete this exception statement from your version. If you delete
+*   this exception statement from all source files in the program, then
+*   also delete it here.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <common/MicroBenchmark.h>
+#include <common/Testing.h>
+
+#include <statistics/ColorMapper.h>
+
+#include <random>
+
+namespace stats::color::benchmark
+{
+
+namespace
+{
+
+constexpr size_t NR_VALUES = 1 << 20;
+
+void runGetColorBenchmark(const std::string &name, const ColorMapper &colorMapper)
+{
+  std::mt19937                       generator(yuviewBenchmark::RANDOM_SEED);
+  std::uniform_int_distribution<int> distribution(-16, 272);
+  std::vector<int>                   values(NR_VALUES);
+  for (auto &value : values)
+    value = distribution(generator);
+
+  yuviewBenchmark::runBenchmark(name, 0, [&]() {
+    uint64_t sum = 0;
+    for (const auto value : values)
+    {
+      const auto color = colorMapper.getColor(value);
+      sum += color.R() + color.G() + color.B() + color.A();
+    }
+    yuviewBenchmark::doNotOptimizeAway(sum);
+  });
+}
+
+} // namespace
+
+TEST(ColorMapperBenchmark, GetColor)
+{
+  const auto valueRange = Range<int>{0, 255};
+
+  runGetColorBenchmark("Gradient", ColorMapper(valueRange, Color(0, 0, 0), Color(0, 0, 255)));
+
+  for (const auto predefinedType : {PredefinedType::Jet, PredefinedType::Hsv})
+    runGetColorBenchmark(
+        yuviewTest::formatTestName("Predefined", PredefinedTypeMapper.getName(predefinedType)),
+        ColorMapper(valueRange, predefinedType));
+
+  ColorMap colorMap;
+  for (int value = 0; value < 256; value += 8)
+    colorMap[value] = Color(value, 255 - value, value / 2);
+  runGetColorBenchmark("Map", ColorMapper(colorMap, Color(255, 255, 255)));
+}
+
+} // namespace stats::color::benchmark
@@ -0,0 +1,162 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+*   <https://github.com/IENT/YUView>
+*   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   In addition, as a special exception, the copyright holders give
+*   permission to link the code of portions of this program with the
+*   OpenSSL library under certain conditions as described in each
+*   individual source file, and distribute linked combinations including
+*   the two.
+*   
+*   You must obey the GNU General Public License in all respects for all
+*   of the code used other than OpenSSL. If you modify file(s) with this
+*   exception, you may extend this exception to your version of the
+*   file(s), but you are not obligated to do so. If you do not wish to do
+*   so, delete this exception statement from your version. If you delete
+*   this exception statement from all source files in the program, then
+*   also delete it here.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <common/MicroBenchmark.h>
+#include <common/TemporaryFile.h>
+#include <common/Testing.h>
+
+#include <statistics/StatisticsFileCSV.h>
+
+#include <QFile>
+#include <QTextStream>
+
+#include <algorithm>
+
+namespace stats::benchmark
+{
+
+namespace
+{
+
+constexpr auto FRAME_SIZE = Size(1920, 1080);
+constexpr auto BLOCK_SIZE = 4u;
+
+// A dense statistics file with a value (type 0) and a vector (type 1) for every 4x4 block of the
+// first frame
+std::string createDenseStatisticsFile()
+{
+  std::string stats = "%;syntax-version;v1.2\n"
+                      "%;seq-specs;benchmark;0;1920;1080;50;\n"
+                      "%;type;0;Value;range;\n"
+                      "%;defaultRange;0;255;jet\n"
+                      "%;type;1;Vector;vector;\n"
+                      "%;scaleFactor;4\n";
+  for (unsigned y = 0; y < FRAME_SIZE.height; y += BLOCK_SIZE)
+    for (unsigned x = 0; x < FRAME_SIZE.width; x += BLOCK_SIZE)
+      stats += "0;" + std::to_string(x) + ";" + std::to_string(y) + ";4;4;0;" +
+               std::to_string((x + y) % 256) + "\n";
+  for (unsigned y = 0; y < FRAME_SIZE.height; y += BLOCK_SIZE)
+    for (unsigned x = 0; x < FRAME_SIZE.width; x += BLOCK_SIZE)
+      stats += "0;" + std::to_string(x) + ";" + std::to_string(y) + ";4;4;1;" +
+               std::to_string(int(x % 64) - 32) + ";" + std::to_string(int(y % 64) - 32) + "\n";
+  return stats;
+}
+
+// The previous implementation of StatisticsFileCSV::loadStatisticData which parses every line
+// using QStrings. It is the reference for the throughput of the parser.
+void loadStatisticDataUsingQStrings(const QString  &filePath,
+                                    StatisticsData &statisticsData,
+                                    const int       poc)
+{
+  QFile file(filePath);
+  file.open(QIODevice::ReadOnly);
+  QTextStream in(&file);
+
+  while (!in.atEnd())
+  {
+    auto rowItemList = in.readLine().trimmed().remove(' ').split(';');
+    if (rowItemList[0].isEmpty() || rowItemList[0][0] == '%')
+      continue;
+
+    if (rowItemList[0].toInt() != poc)
+      break;
+    const auto type = rowItemList[5].toInt();
+
+    auto &statTypes = statisticsData.getStatisticsTypes();
+    auto  statIt    = std::find_if(statTypes.begin(),
+                               statTypes.end(),
+                               [type](StatisticsType &t) { return t.typeID == type; });
+    if (rowItemList.count() > 7 && statIt->hasVectorData)
+      statisticsData[type].addBlockVector(rowItemList[1].toInt(),
+                                          rowItemList[2].toInt(),
+                                          rowItemList[3].toUInt(),
+                                          rowItemList[4].toUInt(),
+                                          rowItemList[6].toInt(),
+                                          rowItemList[7].toInt());
+    else
+      statisticsData[type].addBlockValue(rowItemList[1].toInt(),
+                                         rowItemList[2].toInt(),
+                                         rowItemList[3].toUInt(),
+                                         rowItemList[4].toUInt(),
+                                         rowItemList[6].toInt());
+  }
+}
+
+} // namespace
+
+TEST(StatisticsFileCSVBenchmark, LoadStatisticData)
+{
+  const auto                stats = createDenseStatisticsFile();
+  yuviewTest::TemporaryFile csvFile(ByteVector(stats.begin(), stats.end()));
+  const auto                filePath = QString::fromStdString(csvFile.getFilePathString());
+
+  const auto nrBlocks = size_t(FRAME_SIZE.width / BLOCK_SIZE) * (FRAME_SIZE.height / BLOCK_SIZE);
+
+  StatisticsData    statisticsData;
+  StatisticsFileCSV statisticsFile(filePath, statisticsData);
+  std::atomic_bool  breakAtomic(false);
+  statisticsFile.readFrameAndTypePositionsFromFile(breakAtomic);
+
+  // The parser loads one type at a time. The sum of both types is compared to the reference.
+  double medianUs{};
+  for (const auto typeID : {0, 1})
+  {
+    medianUs += yuviewBenchmark::runBenchmark(
+        yuviewTest::formatTestName("LoadType", typeID), stats.size() / 2, [&]() {
+          statisticsData.eraseDataForTypeID(typeID);
+          statisticsFile.loadStatisticData(statisticsData, 0, typeID);
+        });
+  }
+
+  EXPECT_EQ(statisticsData[0].valueData.size(), nrBlocks);
+  EXPECT_EQ(statisticsData[1].vectorData.size(), nrBlocks);
+
+  // The reference loads all types of the frame at once. The types are read from the header of the
+  // file.
+  StatisticsData    referenceData;
+  StatisticsFileCSV referenceFile(filePath, referenceData);
+
+  const auto referenceMedianUs =
+      yuviewBenchmark::runBenchmark("LoadAllTypesUsingQStrings", stats.size(), [&]() {
+        referenceData.eraseDataForTypeID(0);
+        referenceData.eraseDataForTypeID(1);
+        loadStatisticDataUsingQStrings(filePath, referenceData, 0);
+      });
+
+  EXPECT_EQ(referenceData[0].valueData.size(), nrBlocks);
+  EXPECT_EQ(referenceData[1].vectorData.size(), nrBlocks);
+
+  yuviewBenchmark::reportSpeedup("LoadAllTypes", referenceMedianUs, medianUs);
+}
+
+} // namespace stats::benchmark
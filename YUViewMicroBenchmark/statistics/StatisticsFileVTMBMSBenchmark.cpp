@@ -0,0 +1,172 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+*   <https://github.com/IENT/YUView>
+*   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   In addition, as a special exception, the copyright holders give
+*   permission to link the code of portions of this program with the
+*   OpenSSL library under certain conditions as described in each
+*   individual source file, and distribute linked combinations including
+*   the two.
+*   
+*   You must obey the GNU General Public License in all respects for all
+*   of the code used other than OpenSSL. If you modify file(s) with this
+*   exception, you may extend this exception to your version of the
+*   file(s), but you are not obligated to do so. If you do not wish to do
+*   so, delete this exception statement from your version. If you delete
+*   this exception statement from all source files in the program, then
+*   also delete it here.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <common/MicroBenchmark.h>
+#include <common/TemporaryFile.h>
+#include <common/Testing.h>
+
+#include <filesource/FileIndexCache.h>
+#include <filesource/FileSource.h>
+#include <statistics/StatisticsFileVTMBMS.h>
+
+#include <QRegularExpression>
+#include <QStandardPaths>
+
+#include <map>
+
+namespace stats::benchmark
+{
+
+namespace
+{
+
+constexpr auto NR_POCS          = 16;
+constexpr auto FRAME_SIZE       = Size(1920, 1080);
+constexpr auto READ_BUFFER_SIZE = 1048576;
+constexpr auto BLOCK_STAT_REGEX = "BlockStat: POC ([0-9]+)";
+
+// A file with NR_POCS frames. Every frame contains a PredMode value and a MVL0 vector for every
+// 8x8 block.
+std::string createVTMBMSFile()
+{
+  std::string stats = "# VTMBMS Block Statistics\n"
+                      "# Sequence size: [" +
+                      std::to_string(FRAME_SIZE.width) + "x " +
+                      std::to_string(FRAME_SIZE.height) +
+                      "]\n"
+                      "# Block Statistic Type: PredMode; Integer; [0, 4]\n"
+                      "# Block Statistic Type: MVL0; Vector; Scale: 4\n";
+  for (int poc = 0; poc < NR_POCS; poc++)
+  {
+    for (unsigned y = 0; y < FRAME_SIZE.height; y += 8)
+    {
+      for (unsigned x = 0; x < FRAME_SIZE.width; x += 8)
+      {
+        const auto blockStat = "BlockStat: POC " + std::to_string(poc) + " @(" +
+                               std::to_string(x) + ", " + std::to_string(y) + ") [ 8x 8] ";
+        stats += blockStat + "PredMode=" + std::to_string((x + y + poc) % 5) + "\n";
+        stats += blockStat + "MVL0={ " + std::to_string(int(x % 32) - 16) + ", " +
+                 std::to_string(poc) + "}\n";
+      }
+    }
+  }
+  return stats;
+}
+
+// The previous implementation of StatisticsFileVTMBMS::readFrameAndTypePositionsFromFile which
+// reads the file in blocks and matches a regular expression on every line. It is the reference
+// for the throughput of the indexing.
+std::map<int, uint64_t> indexVTMBMSFileUsingRegex(const std::filesystem::path &filePath)
+{
+  FileSource inputFile;
+  if (!inputFile.openFile(filePath))
+    return {};
+
+  std::map<int, uint64_t> pocStartList;
+  QByteArray              inputBuffer;
+  int64_t                 bufferStartPos     = 0;
+  QString                 lineBuffer;
+  uint64_t                lineBufferStartPos = 0;
+  int                     lastPOC            = -1;
+
+  while (true)
+  {
+    const auto bufferSize = inputFile.readBytes(inputBuffer, bufferStartPos, READ_BUFFER_SIZE);
+    for (int64_t i = 0; i < bufferSize; i++)
+    {
+      if (inputBuffer.at(int(i)) != '\n')
+      {
+        lineBuffer.append(inputBuffer.at(int(i)));
+        continue;
+      }
+
+      QRegularExpression pocRegex(BLOCK_STAT_REGEX);
+      auto               match = pocRegex.match(lineBuffer);
+      if (match.hasMatch())
+      {
+        const auto poc = match.captured(1).toInt();
+        if (poc != lastPOC)
+        {
+          pocStartList[poc] = lineBufferStartPos;
+          lastPOC           = poc;
+        }
+      }
+
+      lineBuffer.clear();
+      lineBufferStartPos = uint64_t(bufferStartPos + i + 1);
+    }
+
+    if (bufferSize < READ_BUFFER_SIZE)
+      break;
+    bufferStartPos += bufferSize;
+  }
+  return pocStartList;
+}
+
+} // namespace
+
+TEST(StatisticsFileVTMBMSBenchmark, IndexLargeFile)
+{
+  // The index cache is only used in the test location. It is cleared before every run so that
+  // the file is indexed every time.
+  QStandardPaths::setTestModeEnabled(true);
+
+  const auto                stats = createVTMBMSFile();
+  yuviewTest::TemporaryFile vtmbmsFile(ByteVector(stats.begin(), stats.end()));
+  const auto                filePath = QString::fromStdString(vtmbmsFile.getFilePathString());
+
+  int        maxPoc{};
+  const auto medianUs = yuviewBenchmark::runBenchmark("Index", stats.size(), [&]() {
+    filesource::FileIndexCache::removeLeastRecentlyUsed(0);
+
+    StatisticsData       statisticsData;
+    StatisticsFileVTMBMS statisticsFile(filePath, statisticsData);
+    std::atomic_bool     breakAtomic(false);
+    statisticsFile.readFrameAndTypePositionsFromFile(breakAtomic);
+    maxPoc = statisticsFile.getMaxPoc();
+  });
+  filesource::FileIndexCache::removeLeastRecentlyUsed(0);
+
+  EXPECT_EQ(maxPoc, NR_POCS - 1);
+
+  std::map<int, uint64_t> pocStartList;
+  const auto              referenceMedianUs =
+      yuviewBenchmark::runBenchmark("IndexUsingRegex", stats.size(), [&]() {
+        pocStartList = indexVTMBMSFileUsingRegex(vtmbmsFile.getFilePath());
+      });
+
+  EXPECT_EQ(pocStartList.size(), size_t(NR_POCS));
+
+  yuviewBenchmark::reportSpeedup("Index", referenceMedianUs, medianUs);
+}
+
+} // namespace stats::benchmark
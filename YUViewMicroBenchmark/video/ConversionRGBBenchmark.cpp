@@ -0,0 +1,88 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+*   <https://github.com/IENT/YUView>
+*   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   In addition, as a special exception, the copyright holders give
+*   permission to link the code of portions of this program with the
+*   OpenSSL library under certain conditions as described in each
+*   individual source file, and distribute linked combinations including
+*   the two.
+*   
+*   You must obey the GNU General Public License in all respects for all
+*   of the code used other than OpenSSL. If you modify file(s) with this
+*   exception, you may extend this exception to your version of the
+*   file(s), but you are not obligated to do so. If you do not wish to do
+*   so, delete this exception statement from your version. If you delete
+*   this exception statement from all source files in the program, then
+*   also delete it here.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <common/MicroBenchmark.h>
+#include <common/Testing.h>
+
+#include <video/rgb/ConversionRGB.h>
+
+namespace video::rgb::benchmark
+{
+
+namespace
+{
+
+constexpr auto FRAME_SIZE = Size(1920, 1080);
+
+} // namespace
+
+TEST(ConversionRGBBenchmark, ConvertInputRGBToARGB)
+{
+  constexpr bool componentInvert[4] = {false, false, false, false};
+  constexpr int  componentScale[4]  = {1, 1, 1, 1};
+
+  std::vector<unsigned char> outputBuffer(FRAME_SIZE.width * FRAME_SIZE.height * 4);
+  for (const auto dataLayout : DataLayoutMapper.getValues())
+  {
+    for (const auto alphaMode : {AlphaMode::None, AlphaMode::Last})
+    {
+      for (const auto bitsPerSample : {8u, 10u, 16u})
+      {
+        const PixelFormatRGB format(bitsPerSample, dataLayout, ChannelOrder::RGB, alphaMode);
+
+        const auto nrSamples = size_t(FRAME_SIZE.width) * FRAME_SIZE.height * format.nrChannels();
+        const auto frame     = yuviewBenchmark::createRandomSamples(nrSamples, bitsPerSample);
+        yuviewBenchmark::runBenchmark(
+            yuviewTest::formatTestName(DataLayoutMapper.getName(dataLayout),
+                                       "Alpha",
+                                       AlphaModeMapper.getName(alphaMode),
+                                       bitsPerSample,
+                                       "bit"),
+            frame.size(),
+            [&]() {
+              convertInputRGBToARGB(frame,
+                                    format,
+                                    outputBuffer.data(),
+                                    FRAME_SIZE,
+                                    componentInvert,
+                                    componentScale,
+                                    false,
+                                    alphaMode != AlphaMode::None,
+                                    false);
+            });
+      }
+    }
+  }
+}
+
+} // namespace video::rgb::benchmark
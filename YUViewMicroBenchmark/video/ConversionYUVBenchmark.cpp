@@ -0,0 +1,133 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+*   <https://github.com/IENT/YUView>
+*   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   In addition, as a special exception, the copyright holders give
+*   permission to link the code of portions of this program with the
+*   OpenSSL library under certain conditions as described in each
+*   individual source file, and distribute linked combinations including
+*   the two.
+*   
+*   You must obey the GNU General Public License in all respects for all
+*   of the code used other than OpenSSL. If you modify file(s) with this
+*   exception, you may extend this exception to your version of the
+*   file(s), but you are not obligated to do so. If you do not wish to do
+*   so, delete this exception statement from your version. If you delete
+*   this exception statement from all source files in the program, then
+*   also delete it here.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <common/MicroBenchmark.h>
+#include <common/Testing.h>
+
+#include <video/yuv/videoHandlerYUV.h>
+
+namespace video::yuv::benchmark
+{
+
+namespace
+{
+
+using yuviewBenchmark::runBenchmark;
+
+constexpr auto FRAME_SIZE = Size(1920, 1080);
+
+// The default conversion settings of the videoHandlerYUV
+ConversionSettings getDefaultConversionSettings()
+{
+  ConversionSettings conversionSettings;
+  conversionSettings.mathParameters[Component::Luma]   = MathParameters(1, 125, false);
+  conversionSettings.mathParameters[Component::Chroma] = MathParameters(1, 128, false);
+  return conversionSettings;
+}
+
+QByteArray createRandomFrame(const PixelFormatYUV &format)
+{
+  const auto bitsPerSample  = format.getBitsPerSample();
+  const auto bytesPerSample = bitsPerSample > 8 ? 2 : 1;
+  const auto nrSamples      = size_t(format.bytesPerFrame(FRAME_SIZE)) / bytesPerSample;
+  return yuviewBenchmark::createRandomSamples(nrSamples, bitsPerSample);
+}
+
+} // namespace
+
+TEST(ConversionYUVBenchmark, ConvertYUVPlanarToRGB)
+{
+  const auto conversionSettings = getDefaultConversionSettings();
+
+  std::vector<unsigned char> outputBuffer(FRAME_SIZE.width * FRAME_SIZE.height * 4);
+  for (const auto subsampling : SubsamplingMapper.getValues())
+  {
+    for (const auto bitsPerSample : BitDepthList)
+    {
+      const auto format = PixelFormatYUV(subsampling, bitsPerSample);
+      if (!format.canConvertToRGB(FRAME_SIZE))
+        continue;
+
+      const auto frame = createRandomFrame(format);
+      runBenchmark(yuviewTest::formatTestName("Planar",
+                                              SubsamplingMapper.getName(subsampling),
+                                              bitsPerSample,
+                                              "bit"),
+                   frame.size(),
+                   [&]() {
+                     EXPECT_TRUE(convertYUVPlanarToRGB(
+                         frame, outputBuffer.data(), FRAME_SIZE, format, conversionSettings));
+                   });
+    }
+  }
+}
+
+TEST(ConversionYUVBenchmark, ConvertYUVPackedToPlanar)
+{
+  QByteArray planarFrame;
+  for (const auto subsampling : {Subsampling::YUV_444, Subsampling::YUV_422})
+  {
+    for (const auto packing : getSupportedPackingFormats(subsampling))
+    {
+      for (const auto bitsPerSample : {8u, 10u})
+      {
+        const auto format = PixelFormatYUV(subsampling, bitsPerSample, packing);
+        const auto frame  = createRandomFrame(format);
+        runBenchmark(yuviewTest::formatTestName("Packed",
+                                                SubsamplingMapper.getName(subsampling),
+                                                PackingOrderMapper.getName(packing),
+                                                bitsPerSample,
+                                                "bit"),
+                     frame.size(),
+                     [&]() {
+                       EXPECT_TRUE(
+                           convertYUVPackedToPlanar(frame, planarFrame, FRAME_SIZE, format).first);
+                     });
+      }
+    }
+  }
+}
+
+TEST(ConversionYUVBenchmark, ConvertV210PackedToPlanar)
+{
+  // Every bit pattern is a valid V210 frame
+  const auto format = PixelFormatYUV(PredefinedPixelFormat::V210);
+  const auto frame  = yuviewBenchmark::createRandomSamples(format.bytesPerFrame(FRAME_SIZE), 8);
+
+  QByteArray planarFrame;
+  runBenchmark("V210", frame.size(), [&]() {
+    EXPECT_TRUE(convertV210PackedToPlanar(frame, planarFrame, FRAME_SIZE).first);
+  });
+}
+
+} // namespace video::yuv::benchmark
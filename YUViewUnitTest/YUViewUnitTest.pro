@@ -1,4 +1,4 @@
-QT += core xml 
+QT += core gui widgets opengl xml concurrent network
 
 TARGET = YUViewUnitTest
 TEMPLATE = app
@@ -15,6 +15,8 @@ INCLUDEPATH += $$top_srcdir/submodules/googletest/googletest/include \
                $$top_srcdir/submodules/googletest/googlemock/include \
                $$top_srcdir/YUViewLib/src \
                $$top_srcdir/YUViewUnitTest/common
+# The generated ui_*.h headers of the library (included by the video handlers)
+INCLUDEPATH += $$top_builddir/YUViewLib
 LIBS += -L$$top_builddir/submodules/googletest-qmake/gtest -lgtest
 LIBS += -L$$top_builddir/submodules/googletest-qmake/gtest_main -lgtest_main
 LIBS += -L$$top_builddir/YUViewLib -lYUViewLib
@@ -0,0 +1,204 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common/Testing.h>
+
+#include <TemporaryFile.h>
+#include <filesource/FileIndexCache.h>
+
+#include <QStandardPaths>
+
+#include <chrono>
+#include <fstream>
+#include <optional>
+#include <vector>
+
+namespace
+{
+
+const ByteVector DUMMY_DATA = {'t', 'e', 's', 't', 'd', 'a', 't', 'a'};
+
+class FileIndexCacheTest : public testing::Test
+{
+protected:
+  void SetUp() override { QStandardPaths::setTestModeEnabled(true); }
+};
+
+bool writeTestIndex(const filesource::FileIndexCache &cache)
+{
+  return cache.write([](QDataStream &stream) { stream << quint32(42) << QString("index"); });
+}
+
+std::optional<quint32> readTestIndex(const filesource::FileIndexCache &cache)
+{
+  quint32 value{};
+  if (!cache.read(
+          [&value](QDataStream &stream)
+          {
+            QString name;
+            stream >> value >> name;
+            return name == "index";
+          }))
+    return {};
+  return value;
+}
+
+TEST_F(FileIndexCacheTest, ReadWithoutWrittenIndexFails)
+{
+  yuviewTest::TemporaryFile tempFile(DUMMY_DATA);
+
+  filesource::FileIndexCache cache(tempFile.getFilePath(), "Test-NotWritten");
+  std::filesystem::remove(cache.getIndexFilePath());
+  EXPECT_FALSE(readTestIndex(cache));
+}
+
+TEST_F(FileIndexCacheTest, WriteAndReadIndex)
+{
+  yuviewTest::TemporaryFile tempFile(DUMMY_DATA);
+
+  filesource::FileIndexCache cache(tempFile.getFilePath(), "Test");
+  EXPECT_TRUE(writeTestIndex(cache));
+  EXPECT_TRUE(std::filesystem::exists(cache.getIndexFilePath()));
+
+  const auto value = readTestIndex(cache);
+  ASSERT_TRUE(value);
+  EXPECT_EQ(*value, 42u);
+
+  std::filesystem::remove(cache.getIndexFilePath());
+}
+
+TEST_F(FileIndexCacheTest, WriteAndReadIndexOfFileWithNonAsciiName)
+{
+  const auto filePath = std::filesystem::temp_directory_path() /
+                        std::filesystem::u8path("YUViewTest-\xc3\x9c" "nic\xc3\xb6" "de.bin");
+  {
+    std::ofstream file(filePath, std::ios::binary);
+    file << "testdata";
+  }
+
+  filesource::FileIndexCache cache(filePath, "Test");
+  EXPECT_TRUE(writeTestIndex(cache));
+
+  const auto value = readTestIndex(cache);
+  ASSERT_TRUE(value);
+  EXPECT_EQ(*value, 42u);
+
+  std::filesystem::remove(cache.getIndexFilePath());
+  std::filesystem::remove(filePath);
+}
+
+TEST_F(FileIndexCacheTest, IndexOfDifferentTypeIsNotRead)
+{
+  yuviewTest::TemporaryFile tempFile(DUMMY_DATA);
+
+  filesource::FileIndexCache cache(tempFile.getFilePath(), "Test");
+  EXPECT_TRUE(writeTestIndex(cache));
+
+  filesource::FileIndexCache otherCache(tempFile.getFilePath(), "Test-Other");
+  EXPECT_NE(cache.getIndexFilePath(), otherCache.getIndexFilePath());
+  EXPECT_FALSE(readTestIndex(otherCache));
+
+  std::filesystem::remove(cache.getIndexFilePath());
+}
+
+TEST_F(FileIndexCacheTest, IndexIsInvalidatedIfFileChanges)
+{
+  yuviewTest::TemporaryFile tempFile(DUMMY_DATA);
+
+  filesource::FileIndexCache cache(tempFile.getFilePath(), "Test");
+  EXPECT_TRUE(writeTestIndex(cache));
+
+  {
+    std::ofstream file(tempFile.getFilePath(), std::ios::binary | std::ios::app);
+    file << "moredata";
+  }
+
+  EXPECT_FALSE(readTestIndex(cache));
+
+  std::filesystem::remove(cache.getIndexFilePath());
+}
+
+TEST_F(FileIndexCacheTest, InvalidIndexContentIsNotRead)
+{
+  yuviewTest::TemporaryFile tempFile(DUMMY_DATA);
+
+  filesource::FileIndexCache cache(tempFile.getFilePath(), "Test");
+  EXPECT_TRUE(cache.write([](QDataStream &stream) { stream << quint32(42); }));
+  EXPECT_FALSE(readTestIndex(cache));
+
+  std::filesystem::remove(cache.getIndexFilePath());
+}
+
+TEST_F(FileIndexCacheTest, LeastRecentlyUsedIndexFilesAreRemoved)
+{
+  using namespace std::chrono_literals;
+
+  filesource::FileIndexCache::removeLeastRecentlyUsed(0);
+
+  yuviewTest::TemporaryFile tempFile(DUMMY_DATA);
+
+  std::vector<filesource::FileIndexCache> caches;
+  for (const auto &indexType : {"Test-Used", "Test-Old", "Test-New"})
+    caches.emplace_back(tempFile.getFilePath(), indexType);
+
+  // Write the indices as if they were written 3, 2 and 1 hours ago
+  std::uintmax_t cacheSize{};
+  auto           writeTime = std::filesystem::file_time_type::clock::now() - 3h;
+  for (const auto &cache : caches)
+  {
+    EXPECT_TRUE(writeTestIndex(cache));
+    std::filesystem::last_write_time(cache.getIndexFilePath(), writeTime);
+    cacheSize += std::filesystem::file_size(cache.getIndexFilePath());
+    writeTime += 1h;
+  }
+
+  // Reading the oldest index makes it the most recently used one
+  EXPECT_TRUE(readTestIndex(caches[0]));
+
+  filesource::FileIndexCache::removeLeastRecentlyUsed(cacheSize);
+  for (const auto &cache : caches)
+    EXPECT_TRUE(std::filesystem::exists(cache.getIndexFilePath()));
+
+  filesource::FileIndexCache::removeLeastRecentlyUsed(cacheSize - 1);
+  EXPECT_TRUE(std::filesystem::exists(caches[0].getIndexFilePath()));
+  EXPECT_FALSE(std::filesystem::exists(caches[1].getIndexFilePath()));
+  EXPECT_TRUE(std::filesystem::exists(caches[2].getIndexFilePath()));
+
+  filesource::FileIndexCache::removeLeastRecentlyUsed(0, caches[0].getIndexFilePath());
+  EXPECT_TRUE(std::filesystem::exists(caches[0].getIndexFilePath()));
+  EXPECT_FALSE(std::filesystem::exists(caches[2].getIndexFilePath()));
+
+  std::filesystem::remove(caches[0].getIndexFilePath());
+}
+
+} // namespace
@@ -0,0 +1,142 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common/Testing.h>
+
+#include <parser/common/PacketItemModel.h>
+
+namespace parser::test
+{
+
+namespace
+{
+
+constexpr size_t NR_PACKETS = 100;
+
+class PacketItemModelTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    this->model.rootItem = std::make_shared<TreeItem>();
+    this->model.rootItem->setProperties("Name", "Value", "Coding", "Code", "Meaning");
+
+    for (size_t i = 0; i < NR_PACKETS; i++)
+    {
+      PacketItemModel::Packet packet;
+      packet.fileOffset = i * 10;
+      packet.size       = 10;
+      packet.summary    = "Packet " + std::to_string(i);
+      this->model.addPacket(std::move(packet));
+    }
+    this->model.updateNumberModelItems();
+
+    this->model.setReparseFunction(
+        [this](size_t packetIndex, const PacketItemModel::Packet &packet)
+        {
+          this->reparsedPackets.push_back(packetIndex);
+          EXPECT_EQ(packet.fileOffset, packetIndex * 10);
+
+          auto root = std::make_shared<TreeItem>();
+          root->setProperties(packet.summary);
+          auto child = root->createChildItem("first_element", packetIndex);
+          child->createChildItem("sub_element", 7);
+          root->createChildItem("second_element", 1);
+          return root;
+        });
+  }
+
+  PacketItemModel     model{nullptr};
+  std::vector<size_t> reparsedPackets;
+};
+
+TEST_F(PacketItemModelTest, PacketsAreShownWithoutCreatingItems)
+{
+  EXPECT_EQ(this->model.rowCount(), int(NR_PACKETS));
+
+  const auto packetIndex = this->model.index(5, 0);
+  ASSERT_TRUE(packetIndex.isValid());
+  EXPECT_EQ(this->model.data(packetIndex).toString().toStdString(), "Packet 5");
+  EXPECT_FALSE(this->model.parent(packetIndex).isValid());
+  EXPECT_TRUE(this->model.hasChildren(packetIndex));
+  EXPECT_TRUE(this->model.canFetchMore(packetIndex));
+  EXPECT_EQ(this->model.rowCount(packetIndex), 0);
+  EXPECT_TRUE(this->reparsedPackets.empty());
+}
+
+TEST_F(PacketItemModelTest, ExpandingAPacketReparsesIt)
+{
+  const auto packetIndex = this->model.index(5, 0);
+  this->model.fetchMore(packetIndex);
+
+  EXPECT_EQ(this->reparsedPackets, std::vector<size_t>({5}));
+  EXPECT_FALSE(this->model.canFetchMore(packetIndex));
+  ASSERT_EQ(this->model.rowCount(packetIndex), 2);
+
+  const auto firstElement = this->model.index(0, 0, packetIndex);
+  EXPECT_EQ(this->model.data(firstElement).toString().toStdString(), "first_element");
+  EXPECT_EQ(this->model.data(this->model.index(0, 1, packetIndex)).toString().toStdString(), "5");
+  EXPECT_EQ(this->model.parent(firstElement), packetIndex);
+  ASSERT_EQ(this->model.rowCount(firstElement), 1);
+
+  const auto subElement = this->model.index(0, 0, firstElement);
+  EXPECT_EQ(this->model.data(subElement).toString().toStdString(), "sub_element");
+  EXPECT_EQ(this->model.parent(subElement).row(), 0);
+  EXPECT_EQ(this->model.parent(subElement).internalPointer(), firstElement.internalPointer());
+
+  // Expanding again does not reparse the packet
+  this->model.fetchMore(packetIndex);
+  EXPECT_EQ(this->reparsedPackets.size(), 1u);
+}
+
+TEST_F(PacketItemModelTest, LeastRecentlyExpandedPacketsAreDropped)
+{
+  for (size_t i = 0; i < NR_PACKETS; i++)
+    this->model.fetchMore(this->model.index(int(i), 0));
+  EXPECT_EQ(this->reparsedPackets.size(), NR_PACKETS);
+
+  const auto firstPacket = this->model.index(0, 0);
+  const auto lastPacket  = this->model.index(int(NR_PACKETS - 1), 0);
+  EXPECT_TRUE(this->model.canFetchMore(firstPacket));
+  EXPECT_EQ(this->model.rowCount(firstPacket), 0);
+  EXPECT_FALSE(this->model.canFetchMore(lastPacket));
+  EXPECT_EQ(this->model.rowCount(lastPacket), 2);
+
+  this->model.fetchMore(firstPacket);
+  EXPECT_EQ(this->reparsedPackets.back(), 0u);
+  EXPECT_EQ(this->model.rowCount(firstPacket), 2);
+}
+
+} // namespace
+
+} // namespace parser::test
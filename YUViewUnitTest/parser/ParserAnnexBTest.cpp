@@ -0,0 +1,121 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common/Testing.h>
+
+#include <parser/ParserAnnexB.h>
+
+namespace parser::test
+{
+
+namespace
+{
+
+struct Frame
+{
+  int  poc{};
+  bool randomAccessPoint{};
+};
+
+// A parser that only has a list of frames (without parsing anything)
+class ParserAnnexBWithFrames : public ParserAnnexB
+{
+public:
+  explicit ParserAnnexBWithFrames(const std::vector<Frame> &framesInCodingOrder)
+  {
+    for (const auto &frame : framesInCodingOrder)
+      this->addFrameToList(frame.poc, {}, frame.randomAccessPoint, 0);
+  }
+
+  ParseResult parseAndAddNALUnit(int,
+                                 const ByteVector &,
+                                 std::optional<BitratePlotModel::BitrateEntry>,
+                                 std::optional<pairUint64>,
+                                 std::shared_ptr<TreeItem>) override
+  {
+    return {};
+  }
+  double                     getFramerate() const override { return 25.0; }
+  Size                       getSequenceSizeSamples() const override { return {}; }
+  video::yuv::PixelFormatYUV getPixelFormat() const override { return {}; }
+  QByteArray                 getExtradata() override { return {}; }
+  IntPair                    getProfileLevel() override { return {}; }
+  Ratio                      getSampleAspectRatio() override { return {}; }
+
+protected:
+  std::optional<SeekData>       collectSeekData(int) override { return {}; }
+  std::unique_ptr<ParserAnnexB> createParserForReparsing() const override { return {}; }
+};
+
+// Two GOPs of 8 frames with hierarchical B frames. The second GOP starts with a CRA with leading
+// pictures (POC 5 to 7).
+const std::vector<Frame> TWO_GOPS = {{0, true},
+                                     {4, false},
+                                     {2, false},
+                                     {1, false},
+                                     {3, false},
+                                     {8, true},
+                                     {6, false},
+                                     {5, false},
+                                     {7, false},
+                                     {12, false},
+                                     {10, false},
+                                     {9, false},
+                                     {11, false}};
+
+} // namespace
+
+TEST(ParserAnnexBTest, SeekToTheRandomAccessPointBeforeTheFrame)
+{
+  ParserAnnexBWithFrames parser(TWO_GOPS);
+
+  EXPECT_EQ(parser.getClosestSeekPoint(3, 0).frameIndex, 0u);
+  EXPECT_EQ(parser.getClosestSeekPoint(11, 0).frameIndex, 8u);
+  EXPECT_EQ(parser.getClosestSeekPoint(12, 0).frameIndex, 8u);
+  // The leading pictures of the CRA can only be decoded from the previous random access point
+  EXPECT_EQ(parser.getClosestSeekPoint(6, 0).frameIndex, 0u);
+}
+
+TEST(ParserAnnexBTest, SeekDirectlyToARandomAccessPoint)
+{
+  ParserAnnexBWithFrames parser(TWO_GOPS);
+
+  EXPECT_EQ(parser.getClosestSeekPoint(0, 0).frameIndex, 0u);
+
+  // Seeking to the CRA must not decode the first GOP
+  const auto seekPoint = parser.getClosestSeekPoint(8, 2);
+  EXPECT_EQ(seekPoint.frameIndex, 8u);
+  EXPECT_EQ(seekPoint.frameDistanceInCodingOrder, 3u);
+}
+
+} // namespace parser::test
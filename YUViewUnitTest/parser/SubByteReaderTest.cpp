@@ -0,0 +1,229 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common/Testing.h>
+
+#include <parser/common/SubByteReader.h>
+#include <parser/common/SubByteReaderLogging.h>
+
+#include <random>
+
+namespace parser::test
+{
+
+namespace
+{
+
+// Makes the protected reading functions accessible
+class AccessibleSubByteReader : public SubByteReader
+{
+public:
+  using SubByteReader::readBits;
+  using SubByteReader::readBytes;
+  using SubByteReader::readSE_V;
+  using SubByteReader::readUE_V;
+  using SubByteReader::readUVLC;
+  using SubByteReader::SubByteReader;
+};
+
+class BitWriter
+{
+public:
+  void writeBits(uint64_t value, unsigned nrBits)
+  {
+    for (unsigned i = nrBits; i > 0; i--)
+    {
+      if (this->bitPos == 0)
+        this->data.push_back(0);
+      if ((value >> (i - 1)) & 1)
+        this->data.back() |= static_cast<unsigned char>(0x80 >> this->bitPos);
+      this->bitPos = (this->bitPos + 1) % 8;
+    }
+  }
+
+  void writeUE_V(uint64_t value)
+  {
+    const auto codeNum = value + 1;
+    unsigned   nrBits  = 0;
+    while ((codeNum >> nrBits) > 1)
+      nrBits++;
+    this->writeBits(0, nrBits);
+    this->writeBits(codeNum, nrBits + 1);
+  }
+
+  ByteVector data;
+
+private:
+  unsigned bitPos{};
+};
+
+} // namespace
+
+TEST(SubByteReaderTest, EmulationPreventionBytesAreRemoved)
+{
+  const ByteVector data = {0x00, 0x00, 0x03, 0x01, 0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0xff};
+
+  AccessibleSubByteReader reader(data);
+  EXPECT_EQ(reader.readBits(24), 0x000001u);
+  EXPECT_EQ(reader.nrBytesRead(), 4u);
+  EXPECT_EQ(reader.readBytes(5), ByteVector({0x00, 0x00, 0x00, 0x00, 0xff}));
+  EXPECT_EQ(reader.nrBytesRead(), data.size());
+  EXPECT_FALSE(reader.canReadBits(1));
+  EXPECT_THROW(reader.readBits(1), std::logic_error);
+}
+
+TEST(SubByteReaderTest, EmulationPreventionCanBeDisabled)
+{
+  const ByteVector data = {0x00, 0x00, 0x03, 0x01};
+
+  AccessibleSubByteReader reader(data);
+  reader.disableEmulationPrevention();
+  EXPECT_EQ(reader.readBits(32), 0x00000301u);
+  EXPECT_EQ(reader.nrBitsRead(), 32u);
+}
+
+TEST(SubByteReaderTest, ReadBitsOfAllLengths)
+{
+  std::mt19937          generator(42);
+  std::vector<uint64_t> values;
+  std::vector<unsigned> lengths;
+  BitWriter             writer;
+  for (unsigned i = 0; i < 1000; i++)
+  {
+    const auto nrBits = unsigned(generator() % 64) + 1;
+    const auto value  = (uint64_t(generator()) << 32 | generator()) >> (64 - nrBits);
+    writer.writeBits(value, nrBits);
+    values.push_back(value);
+    lengths.push_back(nrBits);
+  }
+
+  AccessibleSubByteReader reader(writer.data);
+  reader.disableEmulationPrevention();
+  for (size_t i = 0; i < values.size(); i++)
+    ASSERT_EQ(reader.readBits(lengths[i]), values[i]) << "Symbol " << i;
+}
+
+TEST(SubByteReaderTest, ReadExpGolombCodes)
+{
+  const std::vector<uint64_t> values = {
+      0, 1, 2, 3, 7, 8, 255, 1000, (uint64_t(1) << 31) - 1, uint64_t(1) << 40, 5};
+
+  BitWriter writer;
+  writer.writeBits(1, 3);
+  for (const auto value : values)
+    writer.writeUE_V(value);
+  writer.writeUE_V(4);
+  writer.writeUE_V(3);
+
+  AccessibleSubByteReader reader(writer.data);
+  reader.disableEmulationPrevention();
+  EXPECT_EQ(reader.readBits(3), 1u);
+  for (const auto value : values)
+    EXPECT_EQ(reader.readUE_V(), value);
+  EXPECT_EQ(reader.readSE_V(), -2);
+  EXPECT_EQ(reader.readSE_V(), 2);
+}
+
+TEST(SubByteReaderTest, ReadUVLCWithTooManyLeadingZeros)
+{
+  BitWriter writer;
+  writer.writeUE_V(6);
+  writer.writeBits(0, 40);
+  writer.writeBits(1, 1);
+  writer.writeBits(0x5, 3);
+
+  AccessibleSubByteReader reader(writer.data);
+  reader.disableEmulationPrevention();
+  EXPECT_EQ(reader.readUVLC(), 6u);
+  EXPECT_EQ(reader.readUVLC(), (uint64_t(1) << 32) - 1);
+  EXPECT_EQ(reader.readBits(3), 0x5u);
+}
+
+TEST(SubByteReaderTest, MoreRBSPDataStopsAtTheTrailingBits)
+{
+  const ByteVector data = {0xa0, 0x00};
+
+  AccessibleSubByteReader reader(data);
+  EXPECT_TRUE(reader.more_rbsp_data());
+  reader.readBits(2);
+  EXPECT_FALSE(reader.more_rbsp_data());
+}
+
+TEST(SubByteReaderTest, CodeIsOnlyLoggedIfLoggingIsEnabled)
+{
+  const ByteVector data = {0x00, 0x00, 0x03, 0x2a, 0xc0};
+
+  auto                         root = std::make_shared<TreeItem>();
+  reader::SubByteReaderLogging reader(data, root);
+  EXPECT_EQ(reader.readBits("a", 20), 0x2u);
+  EXPECT_EQ(reader.readBits("b", 4), 0xau);
+  EXPECT_EQ(reader.readUEV("c", reader::Options().withLoggingDisabled()), 0u);
+
+  ASSERT_EQ(root->getNrChildItems(), 2u);
+  EXPECT_EQ(root->getChild(0)->getData(3), "00000000000000000010");
+  EXPECT_EQ(root->getChild(1)->getData(3), "1010");
+}
+
+TEST(SubByteReaderTest, ArrayElementNamesContainTheIndices)
+{
+  const ByteVector data = {0xb4, 0x80};
+
+  for (const auto logging : {false, true})
+  {
+    auto                         root = logging ? std::make_shared<TreeItem>() : nullptr;
+    reader::SubByteReaderLogging reader(data, root);
+    EXPECT_TRUE(reader.readFlag("a", {3}));
+    EXPECT_EQ(reader.readBits("b", {1, 2}, 3), 0x3u);
+    EXPECT_EQ(reader.readUEV("c", {0}), 1u);
+    EXPECT_EQ(reader.readSEV("d", {7}), 1);
+    {
+      reader::SubByteReaderLoggingSubLevel subLevel(reader, "e", {4, 5});
+      reader.logCalculatedValue("f", {6}, -2);
+    }
+
+    if (logging)
+    {
+      ASSERT_EQ(root->getNrChildItems(), 5u);
+      EXPECT_EQ(root->getChild(0)->getData(0), "a[3]");
+      EXPECT_EQ(root->getChild(1)->getData(0), "b[1][2]");
+      EXPECT_EQ(root->getChild(2)->getData(0), "c[0]");
+      EXPECT_EQ(root->getChild(3)->getData(0), "d[7]");
+      EXPECT_EQ(root->getChild(4)->getData(0), "e[4][5]");
+      ASSERT_EQ(root->getChild(4)->getNrChildItems(), 1u);
+      EXPECT_EQ(root->getChild(4)->getChild(0)->getData(0), "f[6]");
+      EXPECT_EQ(root->getChild(4)->getChild(0)->getData(1), "-2");
+    }
+  }
+}
+
+} // namespace parser::test
@@ -0,0 +1,115 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <statistics/FrameTypeData.h>
+
+#include <algorithm>
+
+namespace
+{
+
+std::vector<std::pair<int, int>> getValuePositionsIn(const stats::FrameTypeData &data,
+                                                     const stats::SampleRect    &area)
+{
+  std::vector<std::pair<int, int>> positions;
+  data.forEachValueIn(area,
+                      [&positions](const stats::StatsItemValue &item)
+                      { positions.push_back({item.pos[0], item.pos[1]}); });
+  std::sort(positions.begin(), positions.end());
+  return positions;
+}
+
+TEST(SpatialIndex, FindBlocksInArea)
+{
+  stats::FrameTypeData data;
+  for (unsigned short y = 0; y < 1024; y += 4)
+    for (unsigned short x = 0; x < 1024; x += 4)
+      data.addBlockValue(x, y, 4, 4, x + y);
+
+  EXPECT_THAT(getValuePositionsIn(data, {6, 6, 10, 9}),
+              ElementsAre(std::pair(4, 4), std::pair(4, 8), std::pair(8, 4), std::pair(8, 8)));
+  EXPECT_EQ(getValuePositionsIn(data, {0, 0, 1024, 1024}).size(), size_t(256 * 256));
+  EXPECT_EQ(getValuePositionsIn(data, {-100, -100, 1, 1}).size(), size_t(1));
+  EXPECT_TRUE(getValuePositionsIn(data, {1024, 0, 2000, 2000}).empty());
+  EXPECT_TRUE(getValuePositionsIn(data, {5, 5, 5, 100}).empty());
+}
+
+TEST(SpatialIndex, BlocksCoveringMultipleCellsAreReportedOnce)
+{
+  stats::FrameTypeData data;
+  data.addBlockValue(0, 0, 256, 256, 1);
+  data.addBlockValue(300, 10, 8, 8, 2);
+
+  EXPECT_THAT(getValuePositionsIn(data, {0, 0, 512, 512}),
+              ElementsAre(std::pair(0, 0), std::pair(300, 10)));
+  EXPECT_THAT(getValuePositionsIn(data, {100, 100, 200, 200}), ElementsAre(std::pair(0, 0)));
+}
+
+TEST(SpatialIndex, IndexIsUpdatedWhenBlocksAreAdded)
+{
+  stats::FrameTypeData data;
+  data.addBlockValue(0, 0, 8, 8, 1);
+  EXPECT_THAT(getValuePositionsIn(data, {0, 0, 2000, 2000}), ElementsAre(std::pair(0, 0)));
+
+  data.addBlockValue(1000, 1000, 8, 8, 2);
+  EXPECT_THAT(getValuePositionsIn(data, {0, 0, 2000, 2000}),
+              ElementsAre(std::pair(0, 0), std::pair(1000, 1000)));
+}
+
+TEST(SpatialIndex, FindPolygonsAndVectorsInArea)
+{
+  stats::FrameTypeData data;
+  data.addPolygonValue({{100, 100}, {200, 100}, {150, 180}}, 1);
+  data.addPolygonVector({{500, 500}, {520, 500}, {520, 530}}, 3, 4);
+  data.addBlockVector(16, 16, 8, 8, -40, 12);
+  data.addLine(32, 32, 16, 16, 0, 0, 15, 15);
+
+  const stats::SampleRect polygonArea{140, 170, 141, 171};
+
+  unsigned nrPolygons = 0;
+  data.forEachPolygonValueIn(polygonArea,
+                             [&](const stats::StatsItemPolygonValue &) { nrPolygons++; });
+  data.forEachPolygonVectorIn(polygonArea,
+                              [&](const stats::StatsItemPolygonVector &) { nrPolygons++; });
+  EXPECT_EQ(nrPolygons, 1u);
+
+  unsigned nrVectors = 0;
+  data.forEachVectorIn({0, 0, 64, 64}, [&](const stats::StatsItemVector &) { nrVectors++; });
+  EXPECT_EQ(nrVectors, 2u);
+
+  EXPECT_EQ(data.maxAbsVectorValue, 40);
+  EXPECT_EQ(data.maxAbsLinePoint, 15);
+}
+
+} // namespace
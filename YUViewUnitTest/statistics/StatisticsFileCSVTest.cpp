@@ -265,4 +265,34 @@ TEST(StatisticsFileCSV, testCSVFileParsing)
                                           {576, 40, 32, 24, 0}});
 }
 
-} // namespace
\ No newline at end of file
+TEST(StatisticsFileCSV, testParseCSVDataLine)
+{
+  {
+    const auto dataLine = stats::parseCSVDataLine("1;8;32;8;16;9;-33;0");
+    ASSERT_TRUE(dataLine);
+    EXPECT_EQ(dataLine->nrFields, 8u);
+    EXPECT_EQ(dataLine->poc(), 1);
+    EXPECT_EQ(dataLine->typeID(), 9);
+    EXPECT_THAT(dataLine->fields, ElementsAre(1, 8, 32, 8, 16, 9, -33, 0, 0, 0));
+  }
+  {
+    const auto dataLine = stats::parseCSVDataLine(" 7; 576 ;40;32;24;3;+1\r");
+    ASSERT_TRUE(dataLine);
+    EXPECT_EQ(dataLine->nrFields, 7u);
+    EXPECT_THAT(dataLine->fields, ElementsAre(7, 576, 40, 32, 24, 3, 1, 0, 0, 0));
+  }
+  {
+    // Like QString::toInt, fields which are not valid integers are 0
+    const auto dataLine = stats::parseCSVDataLine("2;1.5;abc;;4;5;6;7;8;9;10;11");
+    ASSERT_TRUE(dataLine);
+    EXPECT_EQ(dataLine->nrFields, 12u);
+    EXPECT_THAT(dataLine->fields, ElementsAre(2, 0, 0, 0, 4, 5, 6, 7, 8, 9));
+  }
+
+  EXPECT_FALSE(stats::parseCSVDataLine(""));
+  EXPECT_FALSE(stats::parseCSVDataLine("  \r"));
+  EXPECT_FALSE(stats::parseCSVDataLine(";1;2"));
+  EXPECT_FALSE(stats::parseCSVDataLine("%;type;9;MVDL0;vector;"));
+}
+
+} // namespace
@@ -217,4 +217,70 @@ TEST(StatisticsFileCSV, testCSVFileParsing)
       });
 }
 
+// A file with nrPOCs frames. Every frame contains a PredMode value and a MVL0 vector for every
+// 8x8 block of a frame of the given size.
+std::string generateVTMBMSFile(int nrPOCs, Size frameSize)
+{
+  std::string stats_str = "# VTMBMS Block Statistics\n"
+                          "# Sequence size: [" +
+                          std::to_string(frameSize.width) + "x " +
+                          std::to_string(frameSize.height) +
+                          "]\n"
+                          "# Block Statistic Type: PredMode; Integer; [0, 4]\n"
+                          "# Block Statistic Type: MVL0; Vector; Scale: 4\n";
+  for (int poc = 0; poc < nrPOCs; poc++)
+  {
+    for (unsigned y = 0; y < frameSize.height; y += 8)
+    {
+      for (unsigned x = 0; x < frameSize.width; x += 8)
+      {
+        const auto blockStat = "BlockStat: POC " + std::to_string(poc) + " @(" +
+                               std::to_string(x) + ", " + std::to_string(y) + ") [ 8x 8] ";
+        stats_str += blockStat + "PredMode=" + std::to_string((x + y + poc) % 5) + "\n";
+        stats_str += blockStat + "MVL0={ " + std::to_string(int(x % 32) - 16) + ", " +
+                     std::to_string(poc) + "}\n";
+      }
+    }
+  }
+  return stats_str;
+}
+
+TEST(StatisticsFileVTMBMS, testIndexingAndLoadingOfGeneratedFile)
+{
+  const auto stats_str = generateVTMBMSFile(4, Size(128, 64));
+  yuviewTest::TemporaryFile vtmbmsFile(ByteVector(stats_str.begin(), stats_str.end()));
+
+  stats::StatisticsData       statData;
+  stats::StatisticsFileVTMBMS statFile(QString::fromStdString(vtmbmsFile.getFilePathString()),
+                                       statData);
+
+  std::atomic_bool breakAtomic(false);
+  statFile.readFrameAndTypePositionsFromFile(breakAtomic);
+  EXPECT_EQ(statFile.getMaxPoc(), 3);
+
+  for (int poc = 0; poc < 4; poc++)
+  {
+    statFile.loadStatisticData(statData, poc, 1);
+    statFile.loadStatisticData(statData, poc, 2);
+
+    const auto &values  = statData[1].valueData;
+    const auto &vectors = statData[2].vectorData;
+    ASSERT_EQ(values.size(), size_t(16 * 8));
+    ASSERT_EQ(vectors.size(), size_t(16 * 8));
+
+    const auto &lastValue = values.back();
+    EXPECT_EQ(lastValue.pos[0], 120);
+    EXPECT_EQ(lastValue.pos[1], 56);
+    EXPECT_EQ(lastValue.size[0], 8);
+    EXPECT_EQ(lastValue.size[1], 8);
+    EXPECT_EQ(lastValue.value, (120 + 56 + poc) % 5);
+
+    const auto &lastVector = vectors.back();
+    EXPECT_EQ(lastVector.pos[0], 120);
+    EXPECT_EQ(lastVector.pos[1], 56);
+    EXPECT_EQ(lastVector.point[0].x, 120 % 32 - 16);
+    EXPECT_EQ(lastVector.point[0].y, poc);
+  }
+}
+
 } // namespace
@@ -0,0 +1,136 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut f�r Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common/Testing.h>
+
+#include <ui/views/PlotDecimation.h>
+
+namespace
+{
+
+PlotModel::Point getTestPoint(unsigned pointIndex)
+{
+  PlotModel::Point point;
+  point.x     = pointIndex;
+  point.y     = (pointIndex * 37) % 101;
+  point.width = 1;
+  point.intra = (pointIndex % 8 == 0);
+  return point;
+}
+
+void expectEqual(const std::vector<PlotModel::DecimatedPoint> &actual,
+                 const std::vector<PlotModel::DecimatedPoint> &expected)
+{
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); i++)
+  {
+    EXPECT_EQ(actual[i].xMin, expected[i].xMin);
+    EXPECT_EQ(actual[i].xMax, expected[i].xMax);
+    EXPECT_EQ(actual[i].yMin, expected[i].yMin);
+    EXPECT_EQ(actual[i].yMax, expected[i].yMax);
+    EXPECT_DOUBLE_EQ(actual[i].yAverage, expected[i].yAverage);
+    EXPECT_EQ(actual[i].yMaxIntra, expected[i].yMaxIntra);
+    EXPECT_EQ(actual[i].intra, expected[i].intra);
+    EXPECT_EQ(actual[i].nrPoints, expected[i].nrPoints);
+  }
+}
+
+TEST(PlotDecimationTest, FewVisiblePointsAreNotDecimated)
+{
+  PlotDecimation decimation;
+  decimation.update(10000, 0, getTestPoint);
+
+  EXPECT_FALSE(decimation.getDecimatedPoints({100, 200}, 500));
+  EXPECT_TRUE(decimation.getDecimatedPoints({0, 10000}, 500));
+}
+
+TEST(PlotDecimationTest, DecimatedPointsSummarizeThePlot)
+{
+  const unsigned nrPoints = 10000;
+
+  PlotDecimation decimation;
+  decimation.update(nrPoints, 0, getTestPoint);
+
+  const auto points = decimation.getDecimatedPoints({0, nrPoints}, 200);
+  ASSERT_TRUE(points);
+  EXPECT_LE(points->size(), 200u);
+
+  unsigned pointIndex = 0;
+  for (const auto &decimatedPoint : *points)
+  {
+    double   yMin             = 1000;
+    double   yMax             = 0;
+    double   ySum             = 0;
+    double   yMaxIntra        = 0;
+    unsigned nrPointsInBucket = 0;
+    while (pointIndex < nrPoints && getTestPoint(pointIndex).x < decimatedPoint.xMax)
+    {
+      const auto point = getTestPoint(pointIndex++);
+      yMin             = std::min(yMin, point.y);
+      yMax             = std::max(yMax, point.y);
+      ySum += point.y;
+      if (point.intra)
+        yMaxIntra = std::max(yMaxIntra, point.y);
+      nrPointsInBucket++;
+    }
+
+    EXPECT_EQ(decimatedPoint.nrPoints, nrPointsInBucket);
+    EXPECT_EQ(decimatedPoint.yMin, yMin);
+    EXPECT_EQ(decimatedPoint.yMax, yMax);
+    EXPECT_DOUBLE_EQ(decimatedPoint.yAverage, ySum / nrPointsInBucket);
+    EXPECT_TRUE(decimatedPoint.intra);
+    EXPECT_EQ(decimatedPoint.yMaxIntra, yMaxIntra);
+  }
+  EXPECT_EQ(pointIndex, nrPoints);
+}
+
+TEST(PlotDecimationTest, AppendingPointsGivesTheSameResultAsRebuilding)
+{
+  PlotDecimation appended;
+  for (unsigned nrPoints = 1; nrPoints <= 5000; nrPoints++)
+    appended.update(nrPoints, nrPoints - 1, getTestPoint);
+
+  PlotDecimation rebuilt;
+  rebuilt.update(5000, 0, getTestPoint);
+
+  for (const auto maxNrPoints : {10u, 100u, 1000u})
+  {
+    const auto appendedPoints = appended.getDecimatedPoints({1000, 4000}, maxNrPoints);
+    const auto rebuiltPoints  = rebuilt.getDecimatedPoints({1000, 4000}, maxNrPoints);
+    ASSERT_TRUE(appendedPoints);
+    ASSERT_TRUE(rebuiltPoints);
+    expectEqual(*appendedPoints, *rebuiltPoints);
+  }
+}
+
+} // namespace
@@ -0,0 +1,155 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common/Testing.h>
+
+#include <video/CacheStatistics.h>
+
+#include <QJsonArray>
+
+namespace video::test
+{
+
+using namespace std::chrono_literals;
+
+TEST(CacheStatisticsTest, EmptyHistogram)
+{
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.getCount(), 0u);
+  EXPECT_EQ(histogram.getMean(), 0us);
+  EXPECT_EQ(histogram.getMax(), 0us);
+  EXPECT_EQ(histogram.getPercentile(50), 0us);
+}
+
+TEST(CacheStatisticsTest, HistogramBucketsAndPercentiles)
+{
+  LatencyHistogram histogram;
+  for (int i = 0; i < 8; i++)
+    histogram.add(100us);
+  histogram.add(3ms);
+  histogram.add(2s);
+
+  EXPECT_EQ(histogram.getCount(), 10u);
+  EXPECT_EQ(histogram.getMean(), 200380us);
+  EXPECT_EQ(histogram.getMax(), 2s);
+
+  const auto &buckets = histogram.getBuckets();
+  EXPECT_EQ(buckets.at(0), 8u);
+  EXPECT_EQ(buckets.at(4), 1u);
+  EXPECT_EQ(buckets.back(), 1u);
+
+  EXPECT_EQ(histogram.getPercentile(50), 250us);
+  EXPECT_EQ(histogram.getPercentile(90), 4ms);
+  EXPECT_EQ(histogram.getPercentile(100), 2s);
+}
+
+TEST(CacheStatisticsTest, PercentileIsLimitedToMaximum)
+{
+  LatencyHistogram histogram;
+  histogram.add(1100us);
+  EXPECT_EQ(histogram.getPercentile(50), 1100us);
+}
+
+TEST(CacheStatisticsTest, CountersAndHitRate)
+{
+  CacheStatistics statistics;
+  EXPECT_DOUBLE_EQ(statistics.getStatistics().getHitRate(), 0.0);
+
+  statistics.recordDraw(true);
+  statistics.recordDraw(true);
+  statistics.recordDraw(true);
+  statistics.recordDraw(false);
+  statistics.recordInteractiveLoad();
+  statistics.recordCachedFrame();
+  statistics.recordCachedFrame();
+  statistics.recordEviction();
+  statistics.recordLatency(LoadingStage::Decode, 5ms);
+
+  const auto itemStatistics = statistics.getStatistics();
+  EXPECT_EQ(itemStatistics.drawHits, 3u);
+  EXPECT_EQ(itemStatistics.drawMisses, 1u);
+  EXPECT_DOUBLE_EQ(itemStatistics.getHitRate(), 0.75);
+  EXPECT_EQ(itemStatistics.interactiveLoads, 1u);
+  EXPECT_EQ(itemStatistics.cachedFrames, 2u);
+  EXPECT_EQ(itemStatistics.evictions, 1u);
+  EXPECT_EQ(itemStatistics.getLatency(LoadingStage::Read).getCount(), 0u);
+  EXPECT_EQ(itemStatistics.getLatency(LoadingStage::Decode).getCount(), 1u);
+
+  statistics.reset();
+  EXPECT_EQ(statistics.getStatistics().drawHits, 0u);
+  EXPECT_EQ(statistics.getStatistics().getLatency(LoadingStage::Decode).getCount(), 0u);
+}
+
+TEST(CacheStatisticsTest, ScopedLatencyTimer)
+{
+  CacheStatistics statistics;
+  {
+    ScopedLatencyTimer timer(&statistics, LoadingStage::Convert);
+  }
+  {
+    ScopedLatencyTimer timer(nullptr, LoadingStage::Convert);
+  }
+  EXPECT_EQ(statistics.getStatistics().getLatency(LoadingStage::Convert).getCount(), 1u);
+}
+
+TEST(CacheStatisticsTest, Json)
+{
+  CacheStatistics statistics;
+  statistics.recordDraw(true);
+  statistics.recordDraw(false);
+  statistics.recordLatency(LoadingStage::Read, 300us);
+  auto itemStatistics          = statistics.getStatistics();
+  itemStatistics.bytesResident = 1000;
+
+  const auto json = itemStatistics.toJson();
+  EXPECT_EQ(json["drawHits"].toInt(), 1);
+  EXPECT_EQ(json["drawMisses"].toInt(), 1);
+  EXPECT_DOUBLE_EQ(json["hitRate"].toDouble(), 0.5);
+  EXPECT_EQ(json["bytesResident"].toInt(), 1000);
+
+  const auto latencies = json["latencies"].toObject();
+  EXPECT_TRUE(latencies.contains("Read"));
+  EXPECT_TRUE(latencies.contains("Decode"));
+  EXPECT_TRUE(latencies.contains("Convert"));
+
+  const auto read = latencies["Read"].toObject();
+  EXPECT_EQ(read["count"].toInt(), 1);
+  EXPECT_EQ(read["maxUs"].toInt(), 300);
+  const auto buckets = read["buckets"].toArray();
+  ASSERT_EQ(buckets.size(), int(LatencyHistogram::NR_BUCKETS));
+  EXPECT_EQ(buckets[1].toObject()["count"].toInt(), 1);
+  EXPECT_EQ(buckets[1].toObject()["upperLimitUs"].toInt(), 500);
+  EXPECT_FALSE(buckets.last().toObject().contains("upperLimitUs"));
+}
+
+} // namespace video::test
@@ -0,0 +1,154 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <video/FrameBufferPool.h>
+
+#include <cstdint>
+
+namespace video::test
+{
+
+TEST(FrameBufferPoolTest, SizeClassesWasteAtMostAnEighth)
+{
+  for (size_t nrBytes = 1; nrBytes < size_t(512) * 1024 * 1024; nrBytes = nrBytes * 5 / 4 + 1)
+  {
+    const auto sizeClass = FrameBufferPool::getSizeClass(nrBytes);
+    EXPECT_GE(sizeClass, nrBytes);
+    EXPECT_EQ(sizeClass % FrameBufferPool::ALIGNMENT, 0u);
+    if (nrBytes > 8 * FrameBufferPool::ALIGNMENT)
+    {
+      EXPECT_LE(sizeClass - nrBytes, nrBytes / 8);
+    }
+    if (sizeClass >= 8 * FrameBufferPool::HUGE_PAGE_SIZE)
+    {
+      EXPECT_EQ(sizeClass % FrameBufferPool::HUGE_PAGE_SIZE, 0u);
+    }
+  }
+}
+
+TEST(FrameBufferPoolTest, FramesOfTheSameSizeShareASizeClass)
+{
+  // A 1920x1080 YUV 4:2:0 8 bit frame
+  const auto sizeClass = FrameBufferPool::getSizeClass(1920 * 1080 * 3 / 2);
+  EXPECT_EQ(FrameBufferPool::getSizeClass(1920 * 1080 * 3 / 2 - 100), sizeClass);
+  EXPECT_EQ(sizeClass, size_t(3) * 1024 * 1024);
+}
+
+TEST(FrameBufferPoolTest, HugeFramesAreMultiplesOfTheHugePageSize)
+{
+  // A 7680x4320 YUV 4:2:0 8 bit frame
+  const auto nrBytes   = size_t(7680) * 4320 * 3 / 2;
+  const auto sizeClass = FrameBufferPool::getSizeClass(nrBytes);
+  EXPECT_EQ(sizeClass % FrameBufferPool::HUGE_PAGE_SIZE, 0u);
+  EXPECT_LE(sizeClass - nrBytes, nrBytes / 8);
+}
+
+TEST(FrameBufferPoolTest, ReleasedBufferIsReused)
+{
+  FrameBufferPool pool;
+
+  auto       buffer = pool.allocate(100000);
+  const auto data   = buffer.get();
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(data) % FrameBufferPool::ALIGNMENT, 0u);
+  EXPECT_EQ(pool.getStatistics().bytesInUse, int64_t(FrameBufferPool::getSizeClass(100000)));
+
+  buffer.reset();
+  EXPECT_EQ(pool.getStatistics().bytesInUse, 0);
+  EXPECT_EQ(pool.getStatistics().bytesFree, int64_t(FrameBufferPool::getSizeClass(100000)));
+
+  buffer = pool.allocate(99000);
+  EXPECT_EQ(buffer.get(), data);
+
+  const auto statistics = pool.getStatistics();
+  EXPECT_EQ(statistics.nrAllocations, 2u);
+  EXPECT_EQ(statistics.nrReused, 1u);
+  EXPECT_EQ(statistics.bytesFree, 0);
+}
+
+TEST(FrameBufferPoolTest, LargeBuffersAreAlignedToHugePages)
+{
+  FrameBufferPool pool;
+
+  const auto buffer = pool.allocate(3 * FrameBufferPool::HUGE_PAGE_SIZE + 1);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer.get()) % FrameBufferPool::HUGE_PAGE_SIZE, 0u);
+}
+
+TEST(FrameBufferPoolTest, FreeBuffersAreLimited)
+{
+  FrameBufferPool pool;
+  const auto      sizeClass = int64_t(FrameBufferPool::getSizeClass(4096));
+  pool.setMaxFreeBytes(2 * sizeClass);
+
+  {
+    auto buffer1 = pool.allocate(4096);
+    auto buffer2 = pool.allocate(4096);
+    auto buffer3 = pool.allocate(4096);
+  }
+  EXPECT_EQ(pool.getStatistics().bytesFree, 2 * sizeClass);
+
+  pool.setMaxFreeBytes(sizeClass);
+  EXPECT_EQ(pool.getStatistics().bytesFree, sizeClass);
+
+  pool.releaseFreeBuffers();
+  EXPECT_EQ(pool.getStatistics().bytesFree, 0);
+}
+
+TEST(FrameBufferPoolTest, BufferMayOutliveThePool)
+{
+  std::shared_ptr<unsigned char> buffer;
+  {
+    FrameBufferPool pool;
+    buffer = pool.allocate(1000);
+  }
+  buffer.get()[999] = 1;
+  buffer.reset();
+}
+
+TEST(FrameBufferPoolTest, ImageBufferGoesBackIntoThePool)
+{
+  FrameBufferPool pool;
+
+  auto image = pool.allocateImage(QSize(101, 10), QImage::Format_RGB888);
+  ASSERT_FALSE(image.isNull());
+  EXPECT_EQ(image.bytesPerLine(), 304);
+  EXPECT_EQ(pool.getStatistics().bytesInUse, int64_t(FrameBufferPool::getSizeClass(3040)));
+
+  image = {};
+  EXPECT_EQ(pool.getStatistics().bytesInUse, 0);
+  EXPECT_GT(pool.getStatistics().bytesFree, 0);
+
+  EXPECT_TRUE(pool.allocateImage(QSize(0, 10), QImage::Format_RGB888).isNull());
+}
+
+} // namespace video::test
@@ -0,0 +1,154 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common/Testing.h>
+
+#include <video/FramePacer.h>
+
+namespace video::test
+{
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+const auto START_TIME = FramePacer::Clock::time_point() + 10s;
+
+} // namespace
+
+TEST(FramePacerTest, FramesAreDueAtTheFrameRate)
+{
+  FramePacer pacer;
+  pacer.start(START_TIME, 50.0);
+
+  EXPECT_EQ(pacer.getNrFramesDue(START_TIME), 0);
+  EXPECT_EQ(pacer.getTimeUntilNextFrame(START_TIME), 20ms);
+  EXPECT_EQ(pacer.getNrFramesDue(START_TIME + 15ms), 0);
+  EXPECT_EQ(pacer.getTimeUntilNextFrame(START_TIME + 15ms), 5ms);
+  EXPECT_EQ(pacer.getNrFramesDue(START_TIME + 19500us), 1);
+  EXPECT_EQ(pacer.getNrFramesDue(START_TIME + 20ms), 1);
+  EXPECT_EQ(pacer.getNrFramesDue(START_TIME + 61ms), 3);
+}
+
+TEST(FramePacerTest, RoundingOfTheTimerDoesNotAccumulate)
+{
+  // At 60 fps a frame interval is 16.67 ms. A timer with millisecond resolution must not drift.
+  FramePacer pacer;
+  pacer.start(START_TIME, 60.0);
+
+  auto now = START_TIME;
+  for (int i = 0; i < 600; i++)
+  {
+    const auto wait = pacer.getTimeUntilNextFrame(now);
+    now += std::chrono::ceil<std::chrono::milliseconds>(wait);
+    ASSERT_EQ(pacer.getNrFramesDue(now), 1);
+    pacer.framesPresented(now, 1);
+  }
+
+  EXPECT_LE(now - START_TIME, 10s + 1ms);
+  EXPECT_EQ(pacer.getNrDroppedFrames(), 0u);
+  EXPECT_EQ(pacer.getNrSlowDowns(), 0u);
+  EXPECT_NEAR(pacer.getAchievedFramesPerSecond(), 60.0, 0.5);
+}
+
+TEST(FramePacerTest, DroppingFramesKeepsTheClock)
+{
+  FramePacer pacer;
+  pacer.start(START_TIME, 25.0);
+
+  // Presentation is 3 intervals late. All due frames are advanced and 2 of them dropped.
+  const auto now = START_TIME + 121ms;
+  EXPECT_EQ(pacer.getNrFramesDue(now), 3);
+  pacer.framesPresented(now, 3);
+
+  EXPECT_EQ(pacer.getNrPresentedFrames(), 1u);
+  EXPECT_EQ(pacer.getNrDroppedFrames(), 2u);
+  EXPECT_EQ(pacer.getNrSlowDowns(), 0u);
+  EXPECT_EQ(pacer.getTimeUntilNextFrame(now), 39ms);
+
+  pacer.resetStatistics();
+  EXPECT_EQ(pacer.getNrPresentedFrames(), 0u);
+  EXPECT_EQ(pacer.getNrDroppedFrames(), 0u);
+}
+
+TEST(FramePacerTest, PresentingLateSlowsDown)
+{
+  FramePacer pacer;
+  pacer.start(START_TIME, 25.0);
+
+  // Only one frame is presented although 3 are due. The next frame is due one interval later.
+  const auto now = START_TIME + 121ms;
+  pacer.framesPresented(now, 1);
+
+  EXPECT_EQ(pacer.getNrDroppedFrames(), 0u);
+  EXPECT_EQ(pacer.getNrSlowDowns(), 1u);
+  EXPECT_EQ(pacer.getNrFramesDue(now), 0);
+  EXPECT_EQ(pacer.getTimeUntilNextFrame(now), 40ms);
+}
+
+TEST(FramePacerTest, ChangeOfTheFrameRate)
+{
+  FramePacer pacer;
+  pacer.start(START_TIME, 10.0);
+
+  pacer.framesPresented(START_TIME + 100ms, 1);
+  pacer.setFramesPerSecond(START_TIME + 130ms, 20.0);
+
+  EXPECT_DOUBLE_EQ(pacer.getFramesPerSecond(), 20.0);
+  // The next frame is due one new interval after the last presented frame
+  EXPECT_EQ(pacer.getTimeUntilNextFrame(START_TIME + 130ms), 20ms);
+  EXPECT_EQ(pacer.getNrPresentedFrames(), 1u);
+}
+
+TEST(FramePacerTest, AchievedFrameRateIsMeasuredOverTheLastSecond)
+{
+  FramePacer pacer;
+  pacer.start(START_TIME, 10.0);
+  EXPECT_DOUBLE_EQ(pacer.getAchievedFramesPerSecond(), 0.0);
+
+  auto now = START_TIME;
+  for (int i = 0; i < 20; i++)
+  {
+    now += 100ms;
+    pacer.framesPresented(now, 1);
+  }
+  for (int i = 0; i < 10; i++)
+  {
+    now += 200ms;
+    pacer.framesPresented(now, 1);
+  }
+  EXPECT_DOUBLE_EQ(pacer.getAchievedFramesPerSecond(), 5.0);
+}
+
+} // namespace video::test
@@ -0,0 +1,201 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common/Testing.h>
+
+#include <video/FramePrefetch.h>
+
+namespace video::prefetch::test
+{
+
+namespace
+{
+
+FrameMotion getMotionOfFrameChanges(const std::vector<int> &frames, const int64_t msPerChange)
+{
+  FrameMotionTracker tracker;
+  int64_t            timeMs = 0;
+  for (const auto frame : frames)
+  {
+    tracker.addFrameChange(frame, timeMs);
+    timeMs += msPerChange;
+  }
+  return tracker.getMotion();
+}
+
+FrameMotion createMotion(int direction, int stepSize, double framesPerSecond)
+{
+  FrameMotion motion;
+  motion.direction       = direction;
+  motion.stepSize        = stepSize;
+  motion.framesPerSecond = framesPerSecond;
+  return motion;
+}
+
+} // namespace
+
+TEST(FramePrefetchTest, MotionOfSteppingForward)
+{
+  const auto motion = getMotionOfFrameChanges({10, 11, 12, 13}, 200);
+  EXPECT_EQ(motion.direction, 1);
+  EXPECT_EQ(motion.stepSize, 1);
+  EXPECT_DOUBLE_EQ(motion.framesPerSecond, 5.0);
+  EXPECT_FALSE(motion.alternatePosition);
+}
+
+TEST(FramePrefetchTest, MotionOfScrubbingBackward)
+{
+  const auto motion = getMotionOfFrameChanges({100, 95, 90, 85, 80}, 10);
+  EXPECT_EQ(motion.direction, -1);
+  EXPECT_EQ(motion.stepSize, 5);
+  EXPECT_DOUBLE_EQ(motion.framesPerSecond, 500.0);
+}
+
+TEST(FramePrefetchTest, MotionFollowsAChangeOfTheDirection)
+{
+  const auto motion = getMotionOfFrameChanges({10, 11, 12, 13, 12}, 100);
+  EXPECT_EQ(motion.direction, -1);
+}
+
+TEST(FramePrefetchTest, MotionOfJumpingBetweenTwoPositions)
+{
+  const auto motion = getMotionOfFrameChanges({20, 300, 20, 300}, 500);
+  EXPECT_EQ(motion.direction, 0);
+  EXPECT_EQ(motion.alternatePosition, 20);
+}
+
+TEST(FramePrefetchTest, OldFrameChangesAreForgotten)
+{
+  FrameMotionTracker tracker;
+  tracker.addFrameChange(10, 0);
+  tracker.addFrameChange(9, 100);
+  tracker.addFrameChange(10, FrameMotionTracker::HISTORY_DURATION_MS + 1000);
+  EXPECT_EQ(tracker.getMotion().direction, 0);
+  tracker.addFrameChange(11, FrameMotionTracker::HISTORY_DURATION_MS + 1100);
+  EXPECT_EQ(tracker.getMotion().direction, 1);
+}
+
+TEST(FramePrefetchTest, AllFramesFitAndAreCachedInTheDirectionOfTheMotionFirst)
+{
+  EXPECT_EQ(getPrefetchWindows(10, 0, 99, createMotion(1, 1, 1.0), 1000, true),
+            std::vector<PrefetchWindow>({{10, 99, 1}, {9, 0, -1}}));
+  EXPECT_EQ(getPrefetchWindows(10, 0, 99, createMotion(-1, 3, 1.0), 1000, true),
+            std::vector<PrefetchWindow>({{10, 0, -1}, {11, 99, 1}}));
+}
+
+TEST(FramePrefetchTest, WindowsAroundTheCurrentFrame)
+{
+  // Three quarters ahead of the motion, the rest behind it
+  EXPECT_EQ(getPrefetchWindows(50, 0, 99, createMotion(1, 1, 2.0), 20, true),
+            std::vector<PrefetchWindow>({{50, 64, 1}, {49, 45, -1}}));
+  EXPECT_EQ(getPrefetchWindows(50, 0, 99, createMotion(-1, 1, 2.0), 20, true),
+            std::vector<PrefetchWindow>({{50, 36, -1}, {51, 55, 1}}));
+
+  // Fast motion
+  EXPECT_EQ(getPrefetchWindows(50, 0, 99, createMotion(1, 1, 30.0), 16, true),
+            std::vector<PrefetchWindow>({{50, 63, 1}, {49, 48, -1}}));
+
+  // Unknown direction
+  EXPECT_EQ(getPrefetchWindows(50, 0, 99, FrameMotion(), 20, true),
+            std::vector<PrefetchWindow>({{50, 59, 1}, {49, 40, -1}}));
+
+  // At the end of the item, the remaining frames are cached behind the current frame
+  EXPECT_EQ(getPrefetchWindows(95, 0, 99, createMotion(1, 1, 2.0), 20, true),
+            std::vector<PrefetchWindow>({{95, 99, 1}, {94, 80, -1}}));
+}
+
+TEST(FramePrefetchTest, WindowsSkipTheFramesThatAreSteppedOver)
+{
+  const auto windows = getPrefetchWindows(50, 0, 99, createMotion(-1, 5, 2.0), 8, true);
+  EXPECT_EQ(windows, std::vector<PrefetchWindow>({{50, 25, -5}, {55, 60, 5}}));
+  EXPECT_EQ(windows[0].getNrFrames(), 6);
+  EXPECT_TRUE(windows[0].contains(30));
+  EXPECT_FALSE(windows[0].contains(31));
+}
+
+TEST(FramePrefetchTest, WindowsAreCachedForwardWithoutRandomAccess)
+{
+  EXPECT_EQ(getPrefetchWindows(50, 0, 99, createMotion(-1, 5, 2.0), 20, false),
+            std::vector<PrefetchWindow>({{36, 50, 1}, {51, 55, 1}}));
+}
+
+TEST(FramePrefetchTest, WindowsAroundBothComparedPositions)
+{
+  FrameMotion motion;
+  motion.alternatePosition = 300;
+  EXPECT_EQ(getPrefetchWindows(20, 0, 399, motion, 40, true),
+            std::vector<PrefetchWindow>(
+                {{20, 29, 1}, {19, 10, -1}, {300, 309, 1}, {299, 290, -1}}));
+}
+
+TEST(FramePrefetchTest, FramesBehindTheMotionAreEvictedFirst)
+{
+  const auto frames = std::vector<int>({0, 10, 40, 45, 60, 90});
+  EXPECT_EQ(getEvictionOrder(frames, 50, createMotion(1, 1, 1.0)),
+            std::vector<int>({0, 10, 40, 45, 90, 60}));
+  EXPECT_EQ(getEvictionOrder(frames, 50, createMotion(-1, 1, 1.0)),
+            std::vector<int>({90, 60, 0, 10, 40, 45}));
+
+  FrameMotion motion;
+  motion.alternatePosition = 5;
+  EXPECT_EQ(getEvictionOrder(frames, 50, motion), std::vector<int>({90, 40, 60, 0, 10, 45}));
+}
+
+TEST(FramePrefetchTest, FramesAreSplitIntoCachingSegments)
+{
+  EXPECT_EQ(getCachingSegments(0, 29, {}, {}), std::vector<PrefetchWindow>({{0, 29, 1}}));
+  EXPECT_EQ(getCachingSegments(0, 29, {0, 8, 16, 24}, {}),
+            std::vector<PrefetchWindow>({{0, 7, 1}, {8, 15, 1}, {16, 23, 1}, {24, 29, 1}}));
+  // Only the segment starts within the range split it
+  EXPECT_EQ(getCachingSegments(10, 20, {0, 8, 16, 24}, {}),
+            std::vector<PrefetchWindow>({{10, 15, 1}, {16, 20, 1}}));
+}
+
+TEST(FramePrefetchTest, CachingSegmentsHaveAtLeastTwoFrames)
+{
+  EXPECT_EQ(getCachingSegments(0, 29, {1, 8, 9, 29}, {}),
+            std::vector<PrefetchWindow>({{0, 7, 1}, {8, 29, 1}}));
+}
+
+TEST(FramePrefetchTest, CachedFramesAtTheStartOfCachingSegmentsAreSkipped)
+{
+  EXPECT_EQ(getCachingSegments(0, 29, {8, 16, 24}, {0, 1, 2, 16, 20}),
+            std::vector<PrefetchWindow>({{3, 7, 1}, {8, 15, 1}, {17, 23, 1}, {24, 29, 1}}));
+  // Segments that are cached up to the last frame are dropped
+  EXPECT_EQ(getCachingSegments(0, 15, {8}, {0, 1, 2, 3, 4, 5, 6, 7}),
+            std::vector<PrefetchWindow>({{8, 15, 1}}));
+  EXPECT_EQ(getCachingSegments(0, 15, {8}, {8, 9, 10, 11, 12, 13, 14}),
+            std::vector<PrefetchWindow>({{0, 7, 1}}));
+}
+
+} // namespace video::prefetch::test
@@ -0,0 +1,121 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common/Testing.h>
+
+#include <video/ImagePyramid.h>
+
+#include <array>
+#include <utility>
+
+namespace video::test
+{
+
+namespace
+{
+
+// Each 2x2 block of the image contains the four given gray values
+QImage createImageWithBlocks(const int width, const int height, const std::array<int, 4> &values)
+{
+  QImage image(width, height, QImage::Format_RGB32);
+  for (int y = 0; y < height; y++)
+    for (int x = 0; x < width; x++)
+    {
+      const auto value = values[(y % 2) * 2 + x % 2];
+      image.setPixel(x, y, qRgb(value, value, value));
+    }
+  return image;
+}
+
+} // namespace
+
+TEST(ImagePyramidTest, TheSmallestLevelThatIsNotSmallerThanTheTargetIsUsed)
+{
+  const auto         image = createImageWithBlocks(2048, 1024, {0, 0, 0, 0});
+  const ImagePyramid pyramid(image, true);
+
+  const auto expectSizeForTarget = [&](const QSizeF &targetSize, int width, int height) {
+    const auto &level = pyramid.getImageForTargetSize(image, targetSize);
+    EXPECT_EQ(level.width(), width);
+    EXPECT_EQ(level.height(), height);
+  };
+
+  expectSizeForTarget(QSizeF(2048, 1024), 2048, 1024);
+  expectSizeForTarget(QSizeF(1025, 400), 2048, 1024);
+  expectSizeForTarget(QSizeF(1024, 512), 1024, 512);
+  expectSizeForTarget(QSizeF(1000, 300), 1024, 512);
+  expectSizeForTarget(QSizeF(512, 256), 512, 256);
+
+  // Levels smaller than MIN_LEVEL_SIZE are not created
+  expectSizeForTarget(QSizeF(100, 50), 512, 256);
+}
+
+TEST(ImagePyramidTest, SmallImagesAreNotDownscaled)
+{
+  const auto         image = createImageWithBlocks(400, 400, {0, 0, 0, 0});
+  const ImagePyramid pyramid(image, true);
+
+  EXPECT_EQ(pyramid.getImageForTargetSize(image, QSizeF(100, 100)).width(), 400);
+}
+
+TEST(ImagePyramidTest, EachLevelIsTheAverageOfTheBlocksOfTheLevelAbove)
+{
+  const auto         image = createImageWithBlocks(1024, 1024, {10, 20, 30, 42});
+  const ImagePyramid pyramid(image, true);
+
+  // The average of 25.5 is rounded up
+  const auto &level = pyramid.getImageForTargetSize(image, QSizeF(512, 512));
+  ASSERT_EQ(level.width(), 512);
+  for (const auto &[x, y] : {std::pair(0, 0), std::pair(1, 0), std::pair(511, 511)})
+    EXPECT_EQ(level.pixel(x, y), qRgb(26, 26, 26));
+}
+
+TEST(ImagePyramidTest, NoLevelsAreCreatedIfNotRequested)
+{
+  const auto         image = createImageWithBlocks(1024, 1024, {10, 10, 10, 10});
+  const ImagePyramid pyramid(image, false);
+
+  EXPECT_EQ(pyramid.getImageForTargetSize(image, QSizeF(128, 128)).width(), 1024);
+}
+
+TEST(ImagePyramidTest, TheImageItselfIsUsedIfThePyramidIsOfAnotherImage)
+{
+  const auto         darkImage   = createImageWithBlocks(1024, 1024, {10, 10, 10, 10});
+  const auto         brightImage = createImageWithBlocks(1024, 1024, {200, 200, 200, 200});
+  const ImagePyramid pyramid(darkImage, true);
+
+  EXPECT_EQ(&pyramid.getImageForTargetSize(brightImage, QSizeF(512, 512)), &brightImage);
+  EXPECT_EQ(&ImagePyramid().getImageForTargetSize(brightImage, QSizeF(512, 512)), &brightImage);
+}
+
+} // namespace video::test
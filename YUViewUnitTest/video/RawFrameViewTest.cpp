@@ -0,0 +1,145 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <video/RawFrameView.h>
+
+#include <cstring>
+
+namespace video::test
+{
+
+namespace
+{
+
+// Two planes of a 4x2 and a 2x1 frame with 3 bytes of padding at the end of each line
+constexpr auto Stride = 7u;
+
+std::vector<unsigned char> createPaddedPlaneData()
+{
+  std::vector<unsigned char> data(Stride * 3, 0xff);
+  const unsigned char        lines[3][4] = {{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10}};
+  std::memcpy(data.data(), lines[0], 4);
+  std::memcpy(data.data() + Stride, lines[1], 4);
+  std::memcpy(data.data() + 2 * Stride, lines[2], 2);
+  return data;
+}
+
+std::vector<RawFrameView::Plane> getPlanes(const std::vector<unsigned char> &data)
+{
+  return {{data.data(), Stride, 4, 2}, {data.data() + 2 * Stride, Stride, 2, 1}};
+}
+
+const QByteArray ExpectedPackedData("\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a", 10);
+
+} // namespace
+
+TEST(RawFrameViewTest, DefaultViewIsEmpty)
+{
+  RawFrameView view;
+  EXPECT_TRUE(view.isEmpty());
+  EXPECT_EQ(view.getNrBytes(), 0u);
+  EXPECT_TRUE(view.toPackedData().isEmpty());
+}
+
+TEST(RawFrameViewTest, PackedViewIsNotCopied)
+{
+  const QByteArray data(16, 'a');
+  RawFrameView     view(data);
+
+  EXPECT_TRUE(view.isPacked());
+  EXPECT_FALSE(view.isBorrowed());
+  EXPECT_EQ(view.getNrBytes(), 16u);
+  EXPECT_EQ(view.toPackedData().constData(), data.constData());
+  EXPECT_EQ(view.toOwned().toPackedData().constData(), data.constData());
+}
+
+TEST(RawFrameViewTest, PaddedPlanesArePackedWithoutPadding)
+{
+  const auto   data = createPaddedPlaneData();
+  RawFrameView view(getPlanes(data));
+
+  EXPECT_FALSE(view.isPacked());
+  EXPECT_FALSE(view.isContiguous());
+  EXPECT_TRUE(view.isBorrowed());
+  EXPECT_EQ(view.getNrBytes(), 10u);
+  EXPECT_EQ(view.toPackedData(), ExpectedPackedData);
+  EXPECT_EQ(view.getContiguousData(), ExpectedPackedData);
+}
+
+TEST(RawFrameViewTest, BorrowedViewIsCopiedWhenOwned)
+{
+  auto data  = createPaddedPlaneData();
+  auto owned = RawFrameView(getPlanes(data)).toOwned();
+
+  // The owned view must not be affected if the source reuses its memory
+  std::fill(data.begin(), data.end(), 0);
+
+  EXPECT_TRUE(owned.isContiguous());
+  EXPECT_FALSE(owned.isBorrowed());
+  EXPECT_EQ(owned.toPackedData(), ExpectedPackedData);
+}
+
+TEST(RawFrameViewTest, ContiguousPlanesAreNotCopied)
+{
+  auto         data = std::make_shared<std::vector<unsigned char>>(ExpectedPackedData.begin(),
+                                                          ExpectedPackedData.end());
+  RawFrameView view(data->data(), data->size(), data);
+
+  EXPECT_FALSE(view.isPacked());
+  EXPECT_TRUE(view.isContiguous());
+  EXPECT_EQ(view.getNrBytes(), 10u);
+
+  const auto contiguousData = view.getContiguousData();
+  EXPECT_EQ(contiguousData.constData(), reinterpret_cast<const char *>(data->data()));
+  EXPECT_EQ(contiguousData, ExpectedPackedData);
+}
+
+TEST(RawFrameViewTest, LifetimeHandleKeepsPlanesAlive)
+{
+  auto data  = std::make_shared<std::vector<unsigned char>>(createPaddedPlaneData());
+  auto owned = RawFrameView(getPlanes(*data), data).toOwned();
+
+  std::weak_ptr<std::vector<unsigned char>> weakData = data;
+  data.reset();
+
+  EXPECT_FALSE(weakData.expired());
+  EXPECT_FALSE(owned.isPacked());
+  EXPECT_FALSE(owned.isBorrowed());
+  EXPECT_EQ(owned.toPackedData(), ExpectedPackedData);
+
+  owned = {};
+  EXPECT_TRUE(weakData.expired());
+}
+
+} // namespace video::test
@@ -0,0 +1,100 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common/Testing.h>
+
+#include <video/videoHandlerDifference.h>
+#include <video/yuv/videoHandlerYUV.h>
+
+#include <optional>
+
+namespace video::test
+{
+
+namespace
+{
+
+constexpr auto TEST_FRAME_SIZE = Size(16, 16);
+
+// Answer the raw data requests of the video with a 4:2:0 8 bit frame where all samples have the
+// given value
+void provideFrames(yuv::videoHandlerYUV &video, const char sampleValue)
+{
+  video.setFrameSize(TEST_FRAME_SIZE);
+  const auto bytesPerFrame = TEST_FRAME_SIZE.width * TEST_FRAME_SIZE.height * 3 / 2;
+  const auto frame         = QByteArray(int(bytesPerFrame), sampleValue);
+  QObject::connect(
+      &video, &videoHandler::signalRequestRawData, [&video, frame](int frameIndex, bool) {
+        video.rawData            = frame;
+        video.rawData_frameIndex = frameIndex;
+      });
+}
+
+} // namespace
+
+TEST(videoHandlerDifferenceTest, CodingOrderChangeInvalidatesTheCachedFrames)
+{
+  yuv::videoHandlerYUV video0;
+  yuv::videoHandlerYUV video1;
+  provideFrames(video0, 100);
+  provideFrames(video1, 110);
+
+  videoHandlerDifference difference;
+  difference.setInputVideos(&video0, &video1);
+  ASSERT_TRUE(difference.isCachingSupported());
+
+  // Clearing the cache for recaching makes it valid again
+  difference.removeAllFrameFromCache();
+  difference.cacheFrame(0, false);
+  difference.cacheFrame(1, false);
+  ASSERT_TRUE(difference.isInCache(0));
+  EXPECT_EQ(difference.needsLoading(0, false), ItemLoadingState::LoadingNotNeeded);
+
+  std::optional<recacheIndicator> recache;
+  QObject::connect(&difference,
+                   &FrameHandler::signalHandlerChanged,
+                   [&recache](bool, recacheIndicator newRecache) { recache = newRecache; });
+
+  // The first difference of the cached frames was found in the old coding order
+  difference.setCodingOrder(videoHandlerDifference::CodingOrder::HEVC);
+  EXPECT_EQ(recache, RECACHE_CLEAR);
+  EXPECT_EQ(difference.needsLoading(0, false), ItemLoadingState::LoadingNeeded);
+
+  difference.removeAllFrameFromCache();
+  EXPECT_FALSE(difference.isInCache(0));
+  difference.cacheFrame(0, false);
+  difference.cacheFrame(1, false);
+  EXPECT_EQ(difference.needsLoading(0, false), ItemLoadingState::LoadingNotNeeded);
+}
+
+} // namespace video::test
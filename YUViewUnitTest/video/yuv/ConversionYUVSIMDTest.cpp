@@ -0,0 +1,402 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <video/yuv/ConversionYUVSIMD.h>
+#include <video/yuv/videoHandlerYUV.h>
+
+#include <algorithm>
+#include <random>
+
+namespace video::yuv::test
+{
+
+namespace
+{
+
+using functions::InstructionSet;
+using functions::InstructionSetMapper;
+
+constexpr auto SubsamplingsToTest = {Subsampling::YUV_444,
+                                     Subsampling::YUV_422,
+                                     Subsampling::YUV_420,
+                                     Subsampling::YUV_440,
+                                     Subsampling::YUV_411};
+
+// Odd multiples of the vector width so that the scalar tail code is always used as well
+constexpr auto TEST_FRAME_SIZE = Size(52, 12);
+
+std::vector<unsigned char> createRandomPlanarData(const Size     frameSize,
+                                                  const unsigned bitsPerSample,
+                                                  const bool     bigEndian)
+{
+  const auto nrSamples = frameSize.width * frameSize.height * 3;
+  const auto twoBytes  = bitsPerSample > 8;
+
+  std::mt19937               generator(bitsPerSample);
+  std::vector<unsigned char> data(nrSamples * (twoBytes ? 2 : 1));
+  for (unsigned i = 0; i < nrSamples; i++)
+  {
+    const auto value = generator() & ((1u << bitsPerSample) - 1);
+    if (!twoBytes)
+      data[i] = static_cast<unsigned char>(value);
+    else
+    {
+      data[i * 2]     = static_cast<unsigned char>(bigEndian ? value >> 8 : value & 0xff);
+      data[i * 2 + 1] = static_cast<unsigned char>(bigEndian ? value & 0xff : value >> 8);
+    }
+  }
+  return data;
+}
+
+std::vector<unsigned char> convert(const std::vector<unsigned char> &data,
+                                   const simd::ConversionParameters &parameters,
+                                   const InstructionSet              instructionSet)
+{
+  const auto lumaBytes = parameters.frameSize.width * parameters.frameSize.height *
+                         (parameters.bitsPerSample > 8 ? 2 : 1);
+  // The chroma planes are always big enough for 4:4:4. Lower subsamplings just ignore the rest.
+  const auto planeY = data.data();
+  const auto planeU = planeY + lumaBytes;
+  const auto planeV = planeU + lumaBytes;
+
+  std::vector<unsigned char> output(parameters.frameSize.width * parameters.frameSize.height * 4);
+  simd::convertPlanarYUVToARGB(
+      {planeY, planeU, planeV, 1}, parameters, output.data(), instructionSet);
+  return output;
+}
+
+// Convert the packed frame with the functions of the videoHandlerYUV. With the instruction set
+// limited to Scalar (and no parallel conversion), these use the conversion code that existed before
+// the vectorized kernels.
+std::vector<unsigned char> convertUsingVideoHandler(const std::vector<unsigned char> &data,
+                                                    const PixelFormatYUV             &format,
+                                                    const ConversionSettings &conversionSettings,
+                                                    const InstructionSet      maxInstructionSet,
+                                                    const bool                convertInParallel)
+{
+  const auto sourceBuffer =
+      QByteArray(reinterpret_cast<const char *>(data.data()), int(data.size()));
+  std::vector<unsigned char> output(TEST_FRAME_SIZE.width * TEST_FRAME_SIZE.height * 4);
+
+  functions::setMaxInstructionSet(maxInstructionSet);
+  const auto success = convertYUVPlanarToRGB(sourceBuffer,
+                                             output.data(),
+                                             TEST_FRAME_SIZE,
+                                             format,
+                                             conversionSettings,
+                                             convertInParallel);
+  functions::setMaxInstructionSet(InstructionSet::AVX2);
+
+  EXPECT_TRUE(success);
+  return output;
+}
+
+std::vector<InstructionSet> getSupportedInstructionSets()
+{
+  std::vector<InstructionSet> instructionSets;
+  for (const auto instructionSet : InstructionSetMapper.getValues())
+    if (instructionSet <= functions::getSupportedInstructionSet())
+      instructionSets.push_back(instructionSet);
+  return instructionSets;
+}
+
+} // namespace
+
+TEST(ConversionYUVSIMDTest, TestAllInstructionSetsAreBitExact)
+{
+  for (const auto subsampling : SubsamplingsToTest)
+  {
+    for (const auto bitsPerSample : BitDepthList)
+    {
+      for (const auto bigEndian : {false, true})
+      {
+        const auto data = createRandomPlanarData(TEST_FRAME_SIZE, bitsPerSample, bigEndian);
+
+        for (const auto interpolation : ChromaInterpolationMapper.getValues())
+        {
+          for (const auto mathRequired : {false, true})
+          {
+            simd::ConversionParameters parameters;
+            parameters.frameSize           = TEST_FRAME_SIZE;
+            parameters.subsampling         = subsampling;
+            parameters.bitsPerSample       = bitsPerSample;
+            parameters.bigEndian           = bigEndian;
+            parameters.chromaInterpolation = interpolation;
+            if (mathRequired)
+            {
+              parameters.mathY = MathParameters(3, 100, true);
+              parameters.mathC = MathParameters(2, 128, false);
+            }
+
+            EXPECT_TRUE(simd::supportsConversion(parameters));
+
+            const auto scalarOutput = convert(data, parameters, InstructionSet::Scalar);
+            for (const auto instructionSet : {InstructionSet::SSE4_1, InstructionSet::AVX2})
+            {
+              const auto output = convert(data, parameters, instructionSet);
+              EXPECT_EQ(output, scalarOutput) << yuviewTest::formatTestName(
+                  "Subsampling",
+                  SubsamplingMapper.getName(subsampling),
+                  "BitsPerSample",
+                  bitsPerSample,
+                  "BigEndian",
+                  bigEndian,
+                  "Interpolation",
+                  ChromaInterpolationMapper.getName(interpolation),
+                  "Math",
+                  mathRequired,
+                  "InstructionSet",
+                  InstructionSetMapper.getName(instructionSet));
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(ConversionYUVSIMDTest, TestKernelsMatchLegacyConversion)
+{
+  for (const auto subsampling : SubsamplingsToTest)
+  {
+    for (const auto bitsPerSample : BitDepthList)
+    {
+      for (const auto bigEndian : {false, true})
+      {
+        const auto data = createRandomPlanarData(TEST_FRAME_SIZE, bitsPerSample, bigEndian);
+
+        for (const auto chromaOffset : {Offset(0, 0), Offset(0, 1)})
+        {
+          for (const auto interpolation : ChromaInterpolationMapper.getValues())
+          {
+            for (const auto colorConversion : ColorConversionMapper.getValues())
+            {
+              for (const auto mathRequired : {false, true})
+              {
+                const auto format = PixelFormatYUV(
+                    subsampling, bitsPerSample, PlaneOrder::YUV, bigEndian, chromaOffset);
+
+                ConversionSettings conversionSettings;
+                conversionSettings.chromaInterpolation = interpolation;
+                conversionSettings.colorConversion     = colorConversion;
+                conversionSettings.mathParameters[Component::Luma] =
+                    mathRequired ? MathParameters(3, 100, true) : MathParameters();
+                conversionSettings.mathParameters[Component::Chroma] =
+                    mathRequired ? MathParameters(2, 128, false) : MathParameters();
+
+                const auto testName = yuviewTest::formatTestName(
+                    "Subsampling",
+                    SubsamplingMapper.getName(subsampling),
+                    "BitsPerSample",
+                    bitsPerSample,
+                    "BigEndian",
+                    bigEndian,
+                    "ChromaOffsetY",
+                    chromaOffset.y,
+                    "Interpolation",
+                    ChromaInterpolationMapper.getName(interpolation),
+                    "ColorConversion",
+                    ColorConversionMapper.getName(colorConversion),
+                    "Math",
+                    mathRequired);
+
+                const auto legacyOutput = convertUsingVideoHandler(
+                    data, format, conversionSettings, InstructionSet::Scalar, false);
+
+                // The scalar kernels are used for the parallel conversion in stripes
+                EXPECT_EQ(convertUsingVideoHandler(
+                              data, format, conversionSettings, InstructionSet::Scalar, true),
+                          legacyOutput)
+                    << testName << " Parallel";
+
+                for (const auto instructionSet : getSupportedInstructionSets())
+                {
+                  if (instructionSet == InstructionSet::Scalar)
+                    continue;
+                  EXPECT_EQ(convertUsingVideoHandler(
+                                data, format, conversionSettings, instructionSet, false),
+                            legacyOutput)
+                      << testName << " " << InstructionSetMapper.getName(instructionSet);
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(ConversionYUVSIMDTest, TestImageMatchesLegacyConversion)
+{
+  // 8 and 10 bit 4:2:0 with the default chroma offset use the specialized conversion in
+  // convertYUVToImage
+  for (const auto bitsPerSample : {8u, 10u})
+  {
+    const auto data   = createRandomPlanarData(TEST_FRAME_SIZE, bitsPerSample, false);
+    const auto format = PixelFormatYUV(
+        Subsampling::YUV_420, bitsPerSample, PlaneOrder::YUV, false, Offset(0, 1));
+    const auto sourceBuffer =
+        QByteArray(reinterpret_cast<const char *>(data.data()), int(data.size()));
+
+    ConversionSettings conversionSettings;
+    conversionSettings.mathParameters[Component::Luma]   = MathParameters();
+    conversionSettings.mathParameters[Component::Chroma] = MathParameters();
+
+    functions::setMaxInstructionSet(InstructionSet::Scalar);
+    QImage legacyImage;
+    convertYUVToImage(sourceBuffer, legacyImage, format, TEST_FRAME_SIZE, conversionSettings);
+    functions::setMaxInstructionSet(InstructionSet::AVX2);
+
+    for (const auto convertInParallel : {false, true})
+    {
+      QImage image;
+      convertYUVToImage(
+          sourceBuffer, image, format, TEST_FRAME_SIZE, conversionSettings, convertInParallel);
+      EXPECT_TRUE(image == legacyImage) << yuviewTest::formatTestName(
+          "BitsPerSample", bitsPerSample, "Parallel", convertInParallel);
+    }
+  }
+}
+
+TEST(ConversionYUVSIMDTest, TestBlackAndWhiteFullRange)
+{
+  simd::ConversionParameters parameters;
+  parameters.frameSize       = Size(16, 2);
+  parameters.subsampling     = Subsampling::YUV_444;
+  parameters.colorConversion = ColorConversion::BT709_FullRange;
+
+  std::vector<unsigned char> data(16 * 2 * 3, 128);
+  for (unsigned i = 0; i < 16; i++)
+    data[i] = 0;
+  for (unsigned i = 16; i < 32; i++)
+    data[i] = 255;
+
+  for (const auto instructionSet : InstructionSetMapper.getValues())
+  {
+    const auto output = convert(data, parameters, instructionSet);
+    for (unsigned i = 0; i < 16; i++)
+      EXPECT_THAT(std::vector<unsigned char>(output.begin() + i * 4, output.begin() + i * 4 + 4),
+                  ElementsAre(0, 0, 0, 255));
+    for (unsigned i = 16; i < 32; i++)
+      EXPECT_THAT(std::vector<unsigned char>(output.begin() + i * 4, output.begin() + i * 4 + 4),
+                  ElementsAre(255, 255, 255, 255));
+  }
+}
+
+TEST(ConversionYUVSIMDTest, TestStripesMatchFullFrameConversion)
+{
+  // Stripe borders that do not fall on chroma lines must still interpolate from the correct lines
+  constexpr auto StripeBorder = 5u;
+
+  for (const auto subsampling : SubsamplingsToTest)
+  {
+    const auto data = createRandomPlanarData(TEST_FRAME_SIZE, 8, false);
+
+    simd::ConversionParameters parameters;
+    parameters.frameSize           = TEST_FRAME_SIZE;
+    parameters.subsampling         = subsampling;
+    parameters.chromaInterpolation = ChromaInterpolation::Bilinear;
+
+    const auto fullFrameOutput = convert(data, parameters, functions::getSupportedInstructionSet());
+
+    const auto                 planeY = data.data();
+    const auto                 planeU = planeY + TEST_FRAME_SIZE.width * TEST_FRAME_SIZE.height;
+    const auto                 planeV = planeU + TEST_FRAME_SIZE.width * TEST_FRAME_SIZE.height;
+    std::vector<unsigned char> stripeOutput(fullFrameOutput.size());
+    simd::convertPlanarYUVToARGB(
+        {planeY, planeU, planeV, 1}, parameters, stripeOutput.data(), {StripeBorder, 12});
+    simd::convertPlanarYUVToARGB(
+        {planeY, planeU, planeV, 1}, parameters, stripeOutput.data(), {0, StripeBorder});
+
+    EXPECT_EQ(stripeOutput, fullFrameOutput)
+        << yuviewTest::formatTestName("Subsampling", SubsamplingMapper.getName(subsampling));
+  }
+}
+
+TEST(ConversionYUVSIMDTest, TestPaddedLinesMatchPackedConversion)
+{
+  // Like the picture buffers of a decoder, every line is followed by some padding
+  constexpr auto Padding = 24u;
+
+  for (const auto subsampling : SubsamplingsToTest)
+  {
+    const auto data = createRandomPlanarData(TEST_FRAME_SIZE, 10, false);
+
+    simd::ConversionParameters parameters;
+    parameters.frameSize     = TEST_FRAME_SIZE;
+    parameters.subsampling   = subsampling;
+    parameters.bitsPerSample = 10;
+
+    const auto packedOutput = convert(data, parameters, functions::getSupportedInstructionSet());
+
+    const auto subsamplingHor =
+        (subsampling == Subsampling::YUV_422 || subsampling == Subsampling::YUV_420) ? 2u
+        : (subsampling == Subsampling::YUV_411)                                      ? 4u
+                                                                                      : 1u;
+    const auto subsamplingVer =
+        (subsampling == Subsampling::YUV_420 || subsampling == Subsampling::YUV_440) ? 2u : 1u;
+    const auto lumaLineBytes   = TEST_FRAME_SIZE.width * 2;
+    const auto chromaLineBytes = lumaLineBytes / subsamplingHor;
+    const auto chromaHeight    = TEST_FRAME_SIZE.height / subsamplingVer;
+    const auto strideY         = lumaLineBytes + Padding;
+    const auto strideC         = chromaLineBytes + Padding;
+
+    // Copy the lines of the packed planes into the padded planes
+    std::vector<unsigned char> paddedY(strideY * TEST_FRAME_SIZE.height, 0xff);
+    std::vector<unsigned char> paddedU(strideC * chromaHeight, 0xff);
+    std::vector<unsigned char> paddedV(strideC * chromaHeight, 0xff);
+    const auto                 packedY = data.data();
+    const auto                 packedU = packedY + lumaLineBytes * TEST_FRAME_SIZE.height;
+    const auto                 packedV = packedU + lumaLineBytes * TEST_FRAME_SIZE.height;
+    for (unsigned y = 0; y < TEST_FRAME_SIZE.height; y++)
+      std::copy_n(packedY + y * lumaLineBytes, lumaLineBytes, paddedY.begin() + y * strideY);
+    for (unsigned y = 0; y < chromaHeight; y++)
+    {
+      std::copy_n(packedU + y * chromaLineBytes, chromaLineBytes, paddedU.begin() + y * strideC);
+      std::copy_n(packedV + y * chromaLineBytes, chromaLineBytes, paddedV.begin() + y * strideC);
+    }
+
+    std::vector<unsigned char> paddedOutput(packedOutput.size());
+    simd::convertPlanarYUVToARGB(
+        {paddedY.data(), paddedU.data(), paddedV.data(), 1, strideY, strideC},
+        parameters,
+        paddedOutput.data());
+
+    EXPECT_EQ(paddedOutput, packedOutput)
+        << yuviewTest::formatTestName("Subsampling", SubsamplingMapper.getName(subsampling));
+  }
+}
+
+} // namespace video::yuv::test
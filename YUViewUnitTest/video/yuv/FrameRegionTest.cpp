@@ -0,0 +1,221 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common/Testing.h>
+
+#include <video/yuv/FrameRegion.h>
+
+namespace video::yuv::test
+{
+
+namespace
+{
+
+constexpr auto TEST_FRAME_SIZE = Size(64, 32);
+
+struct TestPlane
+{
+  unsigned subsamplingHor{1};
+  unsigned subsamplingVer{1};
+  unsigned valuesPerSample{1};
+};
+
+std::vector<TestPlane> getTestPlanes(const PixelFormatYUV &format)
+{
+  const auto subsamplingHor = unsigned(format.getSubsamplingHor());
+  const auto subsamplingVer = unsigned(format.getSubsamplingVer());
+
+  std::vector<TestPlane> planes = {{1, 1, 1}};
+  if (format.getSubsampling() != Subsampling::YUV_400)
+  {
+    if (format.isUVInterleaved())
+      planes.push_back({subsamplingHor, subsamplingVer, 2});
+    else
+    {
+      planes.push_back({subsamplingHor, subsamplingVer, 1});
+      planes.push_back({subsamplingHor, subsamplingVer, 1});
+    }
+  }
+  if (format.hasAlpha())
+    planes.push_back({1, 1, 1});
+  return planes;
+}
+
+unsigned getTestValue(const unsigned plane, const unsigned x, const unsigned y, const bool twoBytes)
+{
+  return (plane * 97 + x * 3 + y * 11) % (twoBytes ? 1024 : 256);
+}
+
+// Every sample has a value that depends on its plane and position
+QByteArray createTestFrame(const PixelFormatYUV &format, const Size frameSize)
+{
+  const auto twoBytes = format.getBitsPerSample() > 8;
+
+  QByteArray frame;
+  const auto planes = getTestPlanes(format);
+  for (unsigned p = 0; p < planes.size(); p++)
+  {
+    const auto width  = frameSize.width / planes[p].subsamplingHor * planes[p].valuesPerSample;
+    const auto height = frameSize.height / planes[p].subsamplingVer;
+    for (unsigned y = 0; y < height; y++)
+      for (unsigned x = 0; x < width; x++)
+      {
+        const auto value = getTestValue(p, x, y, twoBytes);
+        frame.append(char(value & 0xff));
+        if (twoBytes)
+          frame.append(char(value >> 8));
+      }
+  }
+  return frame;
+}
+
+void checkRegionData(const QByteArray     &regionData,
+                     const PixelFormatYUV &format,
+                     const FrameRegion    &region)
+{
+  const auto twoBytes       = format.getBitsPerSample() > 8;
+  const auto bytesPerSample = twoBytes ? 2 : 1;
+
+  auto       data   = reinterpret_cast<const unsigned char *>(regionData.constData());
+  const auto planes = getTestPlanes(format);
+  for (unsigned p = 0; p < planes.size(); p++)
+  {
+    const auto &plane  = planes[p];
+    const auto  width  = region.width / plane.subsamplingHor * plane.valuesPerSample;
+    const auto  height = region.height / plane.subsamplingVer;
+    const auto  xStart = region.x / plane.subsamplingHor * plane.valuesPerSample;
+    const auto  yStart = region.y / plane.subsamplingVer;
+    for (unsigned y = 0; y < height; y++)
+      for (unsigned x = 0; x < width; x++)
+      {
+        auto value = unsigned(data[0]);
+        if (twoBytes)
+          value += unsigned(data[1]) << 8;
+        EXPECT_EQ(value, getTestValue(p, xStart + x, yStart + y, twoBytes))
+            << "plane " << p << " x " << x << " y " << y;
+        data += bytesPerSample;
+      }
+  }
+  EXPECT_EQ(data, reinterpret_cast<const unsigned char *>(regionData.constData()) +
+                      regionData.size());
+}
+
+} // namespace
+
+TEST(FrameRegionTest, RegionLoadingIsOnlySupportedForPlanarFormats)
+{
+  EXPECT_TRUE(isRegionLoadingSupported(PixelFormatYUV(Subsampling::YUV_420, 8)));
+  EXPECT_TRUE(isRegionLoadingSupported(PixelFormatYUV(Subsampling::YUV_444, 10, PlaneOrder::YUVA)));
+  EXPECT_TRUE(isRegionLoadingSupported(
+      PixelFormatYUV(Subsampling::YUV_420, 8, PlaneOrder::YUV, false, {}, true)));
+  EXPECT_FALSE(isRegionLoadingSupported(
+      PixelFormatYUV(Subsampling::YUV_420, 8, PlaneOrder::YUVA, false, {}, true)));
+  EXPECT_FALSE(
+      isRegionLoadingSupported(PixelFormatYUV(Subsampling::YUV_422, 8, PackingOrder::UYVY)));
+  EXPECT_FALSE(isRegionLoadingSupported(PixelFormatYUV(PredefinedPixelFormat::V210)));
+}
+
+TEST(FrameRegionTest, RegionForConversionIsExtendedAlignedAndClipped)
+{
+  const auto format420 = PixelFormatYUV(Subsampling::YUV_420, 8);
+  const auto format444 = PixelFormatYUV(Subsampling::YUV_444, 8);
+
+  // 2 chroma samples in every direction and aligned to the subsampling
+  EXPECT_EQ(getRegionForConversion({9, 7, 10, 10}, format420, TEST_FRAME_SIZE),
+            (FrameRegion{4, 2, 20, 20}));
+  EXPECT_EQ(getRegionForConversion({9, 7, 10, 10}, format444, TEST_FRAME_SIZE),
+            (FrameRegion{7, 5, 14, 14}));
+
+  // Clipped to the frame
+  EXPECT_EQ(getRegionForConversion({1, 1, 63, 31}, format420, TEST_FRAME_SIZE),
+            (FrameRegion{0, 0, 64, 32}));
+  EXPECT_TRUE(getRegionForConversion({100, 0, 10, 10}, format420, TEST_FRAME_SIZE).isEmpty());
+}
+
+TEST(FrameRegionTest, ByteRangesContainTheRowsOfEveryPlane)
+{
+  const auto format = PixelFormatYUV(Subsampling::YUV_420, 10);
+  const auto region = FrameRegion{8, 4, 16, 8};
+
+  // Luma rows 4 to 11 and chroma rows 2 to 5 with 2 bytes per sample
+  const auto lumaBytes   = int64_t(64 * 32 * 2);
+  const auto chromaBytes = int64_t(32 * 16 * 2);
+  const auto expected    = std::vector<ByteRange>({{4 * 128, 8 * 128},
+                                                   {lumaBytes + 2 * 64, 4 * 64},
+                                                   {lumaBytes + chromaBytes + 2 * 64, 4 * 64}});
+  EXPECT_EQ(getRegionByteRanges(format, TEST_FRAME_SIZE, region), expected);
+
+  const auto expectedConcatenated =
+      std::vector<ByteRange>({{0, 8 * 128}, {8 * 128, 4 * 64}, {8 * 128 + 4 * 64, 4 * 64}});
+  EXPECT_EQ(getConcatenatedByteRanges(expected), expectedConcatenated);
+}
+
+TEST(FrameRegionTest, CopyRegionFromFullFrameAndFromRows)
+{
+  const auto formats = {PixelFormatYUV(Subsampling::YUV_420, 8),
+                        PixelFormatYUV(Subsampling::YUV_422, 10, PlaneOrder::YVU),
+                        PixelFormatYUV(Subsampling::YUV_420, 8, PlaneOrder::YUV, false, {}, true),
+                        PixelFormatYUV(Subsampling::YUV_444, 8, PlaneOrder::YUVA),
+                        PixelFormatYUV(Subsampling::YUV_400, 16)};
+
+  for (const auto &format : formats)
+  {
+    SCOPED_TRACE(format.getName());
+
+    const auto frame = createTestFrame(format, TEST_FRAME_SIZE);
+    ASSERT_EQ(frame.size(), format.bytesPerFrame(TEST_FRAME_SIZE));
+
+    const auto region = getRegionForConversion({21, 9, 13, 6}, format, TEST_FRAME_SIZE);
+    const auto ranges = getRegionByteRanges(format, TEST_FRAME_SIZE, region);
+
+    const auto regionFromFrame = copyRegion(frame, ranges, format, TEST_FRAME_SIZE, region);
+    ASSERT_EQ(regionFromFrame.size(), format.bytesPerFrame(region.size()));
+    checkRegionData(regionFromFrame, format, region);
+
+    // Read only the rows of the region like a file source would do it
+    QByteArray rows;
+    for (const auto &range : ranges)
+      rows.append(frame.mid(int(range.offset), int(range.size)));
+    const auto regionFromRows = copyRegion(
+        rows, getConcatenatedByteRanges(ranges), format, TEST_FRAME_SIZE, region);
+    EXPECT_EQ(regionFromRows, regionFromFrame);
+
+    // Too little data
+    rows.chop(1);
+    EXPECT_TRUE(
+        copyRegion(rows, getConcatenatedByteRanges(ranges), format, TEST_FRAME_SIZE, region)
+            .isEmpty());
+  }
+}
+
+} // namespace video::yuv::test
@@ -0,0 +1,252 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common/Testing.h>
+
+#include <video/yuv/ObjectiveMetrics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+
+namespace video::yuv::test
+{
+
+namespace
+{
+
+using functions::InstructionSet;
+using functions::InstructionSetMapper;
+using metrics::Plane;
+
+// Not a multiple of the vector width so that the scalar tail code is always used as well
+constexpr auto TEST_PLANE_SIZE = Size(53, 24);
+
+std::vector<unsigned char> createPlaneData(const Size                    size,
+                                           const unsigned                bitsPerSample,
+                                           std::function<unsigned(unsigned)> getValue)
+{
+  const auto                 twoBytes  = bitsPerSample > 8;
+  const auto                 nrSamples = size.width * size.height;
+  std::vector<unsigned char> data(nrSamples * (twoBytes ? 2 : 1));
+  for (unsigned i = 0; i < nrSamples; i++)
+  {
+    const auto value = getValue(i);
+    if (!twoBytes)
+      data[i] = static_cast<unsigned char>(value);
+    else
+    {
+      data[i * 2]     = static_cast<unsigned char>(value & 0xff);
+      data[i * 2 + 1] = static_cast<unsigned char>(value >> 8);
+    }
+  }
+  return data;
+}
+
+std::vector<unsigned char> createRandomPlaneData(const unsigned bitsPerSample, const unsigned seed)
+{
+  std::mt19937 generator(seed);
+  return createPlaneData(TEST_PLANE_SIZE, bitsPerSample, [&](unsigned) {
+    return generator() & ((1u << bitsPerSample) - 1);
+  });
+}
+
+Plane toPlane(const std::vector<unsigned char> &data, const unsigned bitsPerSample)
+{
+  return Plane({data.data(), TEST_PLANE_SIZE, bitsPerSample, false, 1});
+}
+
+QByteArray toByteArray(const std::vector<unsigned char> &data)
+{
+  return QByteArray(reinterpret_cast<const char *>(data.data()), int(data.size()));
+}
+
+} // namespace
+
+TEST(ObjectiveMetricsTest, TestAllInstructionSetsCalculateTheSameSumOfSquaredErrors)
+{
+  for (const auto bitsPerSample : {8u, 10u, 12u, 15u, 16u})
+  {
+    const auto data0 = createRandomPlaneData(bitsPerSample, 1);
+    const auto data1 = createRandomPlaneData(bitsPerSample, 2);
+    const auto plane0 = toPlane(data0, bitsPerSample);
+    const auto plane1 = toPlane(data1, bitsPerSample);
+
+    const auto scalarSum =
+        metrics::sumOfSquaredErrors(plane0, plane1, bitsPerSample, InstructionSet::Scalar);
+    EXPECT_GT(scalarSum, 0u);
+
+    for (const auto instructionSet : InstructionSetMapper.getValues())
+    {
+      if (instructionSet > functions::getSupportedInstructionSet())
+        continue;
+      EXPECT_EQ(metrics::sumOfSquaredErrors(plane0, plane1, bitsPerSample, instructionSet),
+                scalarSum)
+          << yuviewTest::formatTestName("BitsPerSample",
+                                        bitsPerSample,
+                                        "InstructionSet",
+                                        InstructionSetMapper.getName(instructionSet));
+    }
+  }
+}
+
+TEST(ObjectiveMetricsTest, TestConstantOffset)
+{
+  const auto data0  = createPlaneData(TEST_PLANE_SIZE, 8, [](unsigned) { return 100u; });
+  const auto data1  = createPlaneData(TEST_PLANE_SIZE, 8, [](unsigned) { return 110u; });
+  const auto plane0 = toPlane(data0, 8);
+  const auto plane1 = toPlane(data1, 8);
+
+  const auto nrSamples = TEST_PLANE_SIZE.width * TEST_PLANE_SIZE.height;
+  EXPECT_EQ(metrics::sumOfSquaredErrors(plane0, plane1, 8), uint64_t(nrSamples) * 100);
+  EXPECT_NEAR(metrics::calculatePSNR(100.0, 8), 28.1308, 0.0001);
+
+  // No structure in the planes. Only the luminance term reduces the SSIM.
+  const auto ssim = metrics::calculateSSIM(plane0, plane1, 8);
+  EXPECT_NEAR(ssim.contrastStructure, 1.0, 1e-9);
+  EXPECT_LT(ssim.ssim, 1.0);
+}
+
+TEST(ObjectiveMetricsTest, TestIdenticalPlanes)
+{
+  for (const auto bitsPerSample : {8u, 10u})
+  {
+    const auto data  = createRandomPlaneData(bitsPerSample, 3);
+    const auto plane = toPlane(data, bitsPerSample);
+
+    EXPECT_EQ(metrics::sumOfSquaredErrors(plane, plane, bitsPerSample), 0u);
+    EXPECT_TRUE(std::isinf(metrics::calculatePSNR(0.0, bitsPerSample)));
+    EXPECT_DOUBLE_EQ(metrics::calculateSSIM(plane, plane, bitsPerSample).ssim, 1.0);
+    EXPECT_DOUBLE_EQ(metrics::calculateMSSSIM(plane, plane, bitsPerSample), 1.0);
+  }
+}
+
+TEST(ObjectiveMetricsTest, TestDifferentBitDepthsAreScaled)
+{
+  const auto data8  = createPlaneData(TEST_PLANE_SIZE, 8, [](unsigned i) { return i % 256; });
+  const auto data10 =
+      createPlaneData(TEST_PLANE_SIZE, 10, [](unsigned i) { return (i % 256) << 2; });
+
+  const auto plane8  = toPlane(data8, 8);
+  const auto plane10 = toPlane(data10, 10);
+  EXPECT_EQ(metrics::sumOfSquaredErrors(plane8, plane10, 10), 0u);
+  EXPECT_DOUBLE_EQ(metrics::calculateSSIM(plane8, plane10, 10).ssim, 1.0);
+}
+
+TEST(ObjectiveMetricsTest, TestSSIMDecreasesWithNoise)
+{
+  const auto reference =
+      createPlaneData(TEST_PLANE_SIZE, 8, [](unsigned i) { return (i * 7) % 200 + 20; });
+
+  std::mt19937 generator(4);
+  double       lastSSIM = 1.0;
+  for (const auto noiseAmplitude : {2, 8, 32})
+  {
+    std::uniform_int_distribution<int> noise(-noiseAmplitude, noiseAmplitude);
+    const auto                         distorted =
+        createPlaneData(TEST_PLANE_SIZE, 8, [&](unsigned i) {
+          return unsigned(std::clamp(int(reference[i]) + noise(generator), 0, 255));
+        });
+
+    const auto ssim = metrics::calculateSSIM(toPlane(reference, 8), toPlane(distorted, 8), 8).ssim;
+    EXPECT_LT(ssim, lastSSIM);
+    lastSSIM = ssim;
+  }
+}
+
+TEST(ObjectiveMetricsTest, TestFrameMetricsOfPlanarAndInterleavedFormat)
+{
+  constexpr auto frameSize  = Size(64, 32);
+  const auto     lumaSize   = frameSize.width * frameSize.height;
+  const auto     chromaSize = lumaSize / 4;
+
+  // The same frame in 4:2:0 with separate chroma planes and with interleaved chroma (NV12)
+  std::vector<unsigned char> planar(lumaSize + 2 * chromaSize);
+  std::vector<unsigned char> interleaved(planar.size());
+  for (unsigned i = 0; i < lumaSize; i++)
+    planar[i] = interleaved[i] = static_cast<unsigned char>(i % 251);
+  for (unsigned i = 0; i < chromaSize; i++)
+  {
+    planar[lumaSize + i] = interleaved[lumaSize + i * 2] = static_cast<unsigned char>(i % 7);
+    planar[lumaSize + chromaSize + i] = interleaved[lumaSize + i * 2 + 1] =
+        static_cast<unsigned char>(i % 13);
+  }
+
+  const auto formatPlanar = PixelFormatYUV(Subsampling::YUV_420, 8);
+  const auto formatInterleaved =
+      PixelFormatYUV(Subsampling::YUV_420, 8, PlaneOrder::YUV, false, {}, true);
+
+  const auto identical = metrics::calculateFrameMetrics(toByteArray(planar),
+                                                        formatPlanar,
+                                                        frameSize,
+                                                        toByteArray(interleaved),
+                                                        formatInterleaved,
+                                                        frameSize);
+  ASSERT_TRUE(identical);
+  for (unsigned c = 0; c < 3; c++)
+  {
+    EXPECT_EQ(identical->mse[c], 0.0);
+    EXPECT_TRUE(std::isinf(identical->psnr[c]));
+  }
+  EXPECT_DOUBLE_EQ(identical->ssim, 1.0);
+
+  // Change only the U plane
+  auto changedU = planar;
+  for (unsigned i = 0; i < chromaSize; i++)
+    changedU[lumaSize + i] += 4;
+  const auto changedMetrics = metrics::calculateFrameMetrics(
+      toByteArray(planar), formatPlanar, frameSize, toByteArray(changedU), formatPlanar, frameSize);
+  ASSERT_TRUE(changedMetrics);
+  EXPECT_EQ(changedMetrics->mse[0], 0.0);
+  EXPECT_EQ(changedMetrics->mse[1], 16.0);
+  EXPECT_EQ(changedMetrics->mse[2], 0.0);
+  EXPECT_NEAR(changedMetrics->psnr[1], metrics::calculatePSNR(16.0, 8), 1e-9);
+}
+
+TEST(ObjectiveMetricsTest, TestDifferentSubsamplingIsNotSupported)
+{
+  constexpr auto frameSize = Size(16, 16);
+  const auto     format420 = PixelFormatYUV(Subsampling::YUV_420, 8);
+  const auto     format444 = PixelFormatYUV(Subsampling::YUV_444, 8);
+
+  const auto frame420 = QByteArray(int(format420.bytesPerFrame(frameSize)), 0);
+  const auto frame444 = QByteArray(int(format444.bytesPerFrame(frameSize)), 0);
+
+  std::string errorMessage;
+  EXPECT_FALSE(metrics::calculateFrameMetrics(
+      frame420, format420, frameSize, frame444, format444, frameSize, &errorMessage));
+  EXPECT_FALSE(errorMessage.empty());
+}
+
+} // namespace video::yuv::test